@@ -1,5 +1,7 @@
 #include "Hepch.h"
 #include "EngineCore/Core/Application.h"
+
+#include <cstring>
 #include "EngineCore/Core/FileSystem.h"
 #include "EngineCore/Core/Input.h"
 #include "EngineCore/Core/JobSystem.h"
@@ -7,12 +9,55 @@
 #include "EngineCore/Utils/PlatformUtils.h"
 #include "Module/Audio/AudioModule.h"
 #include "Module/Render/Renderer/RenderModule.h"
+#include "Module/Render/Renderer/Renderer.h"
+#include "Module/Render/Shader/ShaderWarmup.h"
 #include "Module/Resource/ResourceModule.h"
 #include "Module/Script/ScriptModule.h"
 #include "World/World.h"
 
 namespace Himii
 {
+    namespace
+    {
+        constexpr const char *PrimeShaderCacheArgument = "--prime-shader-cache";
+
+        bool HasCommandLineArgument(ApplicationCommandLineArgs args, const char *argument)
+        {
+            for (int argumentIndex = 1; argumentIndex < args.Count; ++argumentIndex)
+            {
+                if (std::strcmp(args[argumentIndex], argument) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        /// 打包游戏常被从其它工作目录启动；强制 cwd=exe 目录，确保能找到 Game.hproj / assets。
+        void SetWorkingDirectoryToExecutableDir(const std::filesystem::path &executableDir)
+        {
+            std::error_code currentPathError;
+            std::filesystem::current_path(executableDir, currentPathError);
+            if (currentPathError)
+            {
+                HIMII_CORE_WARNING("Failed to set working directory to executable dir '{0}': {1}",
+                                   executableDir.string(), currentPathError.message());
+            }
+        }
+
+        /// 按构建配置挂载引擎文件系统，返回引擎目录。
+        std::filesystem::path InitializeEngineFileSystem(const std::filesystem::path &executableDir)
+        {
+#if defined(HIMII_DEBUG)
+            FileSystem::Init(executableDir, executableDir, true);
+            return executableDir;
+#else
+            const std::filesystem::path engineDir = executableDir / "HimiiEngine";
+            PlatformProcess::SetDynamicLibrarySearchDirectory(engineDir);
+            FileSystem::Init(engineDir, executableDir, false);
+            return engineDir;
+#endif
+        }
+    }
+
     Application *Application::s_Instance = nullptr;
 
     Application::Application(const std::string &name, ApplicationCommandLineArgs args,
@@ -30,6 +75,9 @@ namespace Himii
         m_Window = Window::Create(initial_props);
         m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
 
+        // 需早于模块初始化：Renderer::Init 的着色器预热在工作线程上编译。
+        JobSystem::Initialize();
+
         // Resource 需尽早注册：Shutdown 时 Unbind；AssetManager 仍由 Project Bind。
         m_ModuleRegistry.RegisterModule(CreateScope<ResourceModule>());
         // Render 需在 Audio 前注册：窗口已创建，InitializeAll 时完成图形初始化。
@@ -39,8 +87,6 @@ namespace Himii
         m_ModuleRegistry.InitializeAll();
         RenderModule::OnWindowResize(m_Window->GetFramebufferWidth(), m_Window->GetFramebufferHeight());
 
-        JobSystem::Initialize();
-
         m_ImGuiLayer = new ImGuiLayer();
         PushOverlay(m_ImGuiLayer);
     }
@@ -109,32 +155,65 @@ namespace Himii
     void Application::SetEnvironmentVariables()
     {
         m_ExecutableDir = PlatformProcess::GetExecutableDirectory();
+        SetWorkingDirectoryToExecutableDir(m_ExecutableDir);
+        m_EngineDir = InitializeEngineFileSystem(m_ExecutableDir);
 
-        // 打包游戏常被从其它工作目录启动；强制 cwd=exe 目录，确保能找到 Game.hproj / assets。
+        const std::string engineDirectoryString = m_EngineDir.string();
+        if (PlatformProcess::SetEnvironmentVariableValue("HIMII_DIR", engineDirectoryString))
+            HIMII_CORE_INFO("Set environment variable HIMII_DIR = {0}", engineDirectoryString);
+        else
+            HIMII_CORE_ERROR("Failed to set HIMII_DIR environment variable!");
+    }
+
+    bool Application::IsShaderCachePrimeRequested(ApplicationCommandLineArgs args)
+    {
+        return HasCommandLineArgument(args, PrimeShaderCacheArgument);
+    }
+
+    int Application::RunShaderCachePrime(ApplicationCommandLineArgs args)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 工程路径须在切换工作目录前解析，命令行可能传入相对路径。
+        std::filesystem::path projectDirectory;
+        for (int argumentIndex = 1; argumentIndex < args.Count; ++argumentIndex)
         {
-            std::error_code currentPathError;
-            std::filesystem::current_path(m_ExecutableDir, currentPathError);
-            if (currentPathError)
+            if (std::strcmp(args[argumentIndex], PrimeShaderCacheArgument) != 0 || argumentIndex + 1 >= args.Count)
+                continue;
+
+            std::error_code pathError;
+            const std::filesystem::path projectFile =
+                    std::filesystem::absolute(args[argumentIndex + 1], pathError);
+            if (!pathError)
+                projectDirectory = projectFile.parent_path();
+        }
+
+        const std::filesystem::path executableDir = PlatformProcess::GetExecutableDirectory();
+        SetWorkingDirectoryToExecutableDir(executableDir);
+        InitializeEngineFileSystem(executableDir);
+        JobSystem::Initialize();
+
+        std::vector<std::filesystem::path> projectShaderFiles;
+        if (!projectDirectory.empty())
+        {
+            std::error_code iterateError;
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(
+                         projectDirectory, std::filesystem::directory_options::skip_permission_denied, iterateError))
             {
-                HIMII_CORE_WARNING("Failed to set working directory to executable dir '{0}': {1}",
-                                   m_ExecutableDir.string(), currentPathError.message());
+                if (entry.is_regular_file() && entry.path().extension() == ".hshader")
+                    projectShaderFiles.push_back(entry.path());
             }
+            if (iterateError)
+                HIMII_CORE_WARNING("Failed to scan project shaders in {0}: {1}", projectDirectory.string(),
+                                   iterateError.message());
         }
 
-#if defined(HIMII_DEBUG)
-        m_EngineDir = m_ExecutableDir;
-        FileSystem::Init(m_ExecutableDir, m_ExecutableDir, true);
-#else
-        m_EngineDir = m_ExecutableDir / "HimiiEngine";
-        PlatformProcess::SetDynamicLibrarySearchDirectory(m_EngineDir);
-        FileSystem::Init(m_EngineDir, m_ExecutableDir, false);
-#endif
+        const ShaderWarmupReport report =
+                ShaderWarmup::PrimeShaderCache(Renderer::GetEngineShaderPaths(), projectShaderFiles);
 
-        const std::string engineDirectoryString = m_EngineDir.string();
-        if (PlatformProcess::SetEnvironmentVariableValue("HIMII_DIR", engineDirectoryString))
-            HIMII_CORE_INFO("Set environment variable HIMII_DIR = {0}", engineDirectoryString);
-        else
-            HIMII_CORE_ERROR("Failed to set HIMII_DIR environment variable!");
+        JobSystem::Shutdown();
+        FileSystem::Shutdown();
+        return report.FailedCount == 0 ? 0 : 1;
     }
 
     bool Application::OnWindowClosed(WindowCloseEvent &e)
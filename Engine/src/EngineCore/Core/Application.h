@@ -78,6 +78,11 @@ namespace Himii
             return s_Instance->m_EngineDir;
         }
 
+        /// 命令行含 --prime-shader-cache [Game.hproj] 时不创建窗口，只预热着色器磁盘缓存。
+        static bool IsShaderCachePrimeRequested(ApplicationCommandLineArgs args);
+        /// 编译引擎与工程着色器写入缓存，返回进程退出码（有失败时为 1）。
+        static int RunShaderCachePrime(ApplicationCommandLineArgs args);
+
     private:
         void SetEnvironmentVariables();
         bool OnWindowClosed(WindowCloseEvent &e);
@@ -11,6 +11,9 @@ int main(int argc, char** argv)
 {
     Himii::Log::Init();
 
+    if (Himii::Application::IsShaderCachePrimeRequested({ argc, argv }))
+        return Himii::Application::RunShaderCachePrime({ argc, argv });
+
     HIMII_PROFILE_BEGIN_SESSION("Startup", "HimiiProfile-Startup.json");
     auto app = Himii::CreateApplication({ argc, argv });
     HIMII_PROFILE_END_SESSION();
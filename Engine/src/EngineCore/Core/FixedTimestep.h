@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Himii
+{
+    /// 固定步长累加器：把可变帧时间折算成若干个等长步，剩余不足一步的时间作为渲染插值系数。
+    /// 单帧步数达到上限时丢弃积压时间，避免一次卡顿后连续多帧追赶（死亡螺旋）。
+    class FixedTimestepAccumulator {
+    public:
+        FixedTimestepAccumulator(double stepSeconds = 1.0 / 60.0, uint32_t maxStepsPerFrame = 8)
+        {
+            Configure(stepSeconds, maxStepsPerFrame);
+        }
+
+        void Configure(double stepSeconds, uint32_t maxStepsPerFrame)
+        {
+            m_StepSeconds = std::max(stepSeconds, 1.0e-4);
+            m_MaxStepsPerFrame = std::max<uint32_t>(maxStepsPerFrame, 1);
+            m_AccumulatedSeconds = std::min(m_AccumulatedSeconds, m_StepSeconds);
+        }
+
+        void Reset()
+        {
+            m_AccumulatedSeconds = 0.0;
+        }
+
+        /// 累加一帧时间，返回本帧应执行的固定步数。
+        uint32_t Advance(double frameSeconds)
+        {
+            m_AccumulatedSeconds += std::max(frameSeconds, 0.0);
+
+            uint32_t stepCount = 0;
+            while (m_AccumulatedSeconds >= m_StepSeconds && stepCount < m_MaxStepsPerFrame)
+            {
+                m_AccumulatedSeconds -= m_StepSeconds;
+                ++stepCount;
+            }
+
+            if (stepCount == m_MaxStepsPerFrame && m_AccumulatedSeconds >= m_StepSeconds)
+                m_AccumulatedSeconds = std::fmod(m_AccumulatedSeconds, m_StepSeconds);
+
+            return stepCount;
+        }
+
+        /// 上一个物理状态到当前物理状态之间的插值系数，范围 [0, 1)。
+        float GetInterpolationAlpha() const
+        {
+            return static_cast<float>(m_AccumulatedSeconds / m_StepSeconds);
+        }
+
+        float GetStepSeconds() const
+        {
+            return static_cast<float>(m_StepSeconds);
+        }
+        uint32_t GetMaxStepsPerFrame() const
+        {
+            return m_MaxStepsPerFrame;
+        }
+
+    private:
+        double m_StepSeconds = 1.0 / 60.0;
+        double m_AccumulatedSeconds = 0.0;
+        uint32_t m_MaxStepsPerFrame = 8;
+    };
+}
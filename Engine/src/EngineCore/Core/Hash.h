@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace Himii
+{
+    /// FNV-1a 64 位：着色器缓存、纹理烘焙、字体与环境光缓存的键和校验和共用这一份实现，非加密用途。
+    constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    inline uint64_t HashBytes(const void *data, size_t size, uint64_t hash = FnvOffsetBasis)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (size_t index = 0; index < size; ++index)
+        {
+            hash ^= bytes[index];
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    inline uint64_t HashString(std::string_view text, uint64_t hash = FnvOffsetBasis)
+    {
+        return HashBytes(text.data(), text.size(), hash);
+    }
+
+    /// 按对象表示逐字节哈希；带填充的结构体请逐字段调用。
+    template<typename T>
+    inline uint64_t HashValue(const T &value, uint64_t hash = FnvOffsetBasis)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "HashValue requires a trivially copyable type");
+        return HashBytes(&value, sizeof(T), hash);
+    }
+
+    /// 大块文件内容的指纹：按 8 字节一组做 FNV-1a，末尾再混入长度；比逐字节快数倍，
+    /// 结果与 HashBytes 不同，只用于判断内容是否变化，不要和其它哈希混用。
+    inline uint64_t HashContent(const void *data, size_t size)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        uint64_t hash = FnvOffsetBasis;
+        const size_t wordCount = size / sizeof(uint64_t);
+        for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + wordIndex * sizeof(uint64_t), sizeof(uint64_t));
+            hash ^= word;
+            hash *= FnvPrime;
+        }
+        hash = HashBytes(bytes + wordCount * sizeof(uint64_t), size % sizeof(uint64_t), hash);
+        hash ^= static_cast<uint64_t>(size);
+        hash *= FnvPrime;
+        return hash;
+    }
+}
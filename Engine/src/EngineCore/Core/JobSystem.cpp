@@ -129,6 +129,57 @@ namespace Himii
         }
     }
 
+    void JobSystem::ParallelFor(uint32_t itemCount, uint32_t batchSize,
+                                const std::function<void(uint32_t, uint32_t)> &batchFunction)
+    {
+        if (itemCount == 0 || !batchFunction)
+            return;
+
+        batchSize = std::max(1u, batchSize);
+        const uint32_t batchCount = (itemCount + batchSize - 1) / batchSize;
+        if (!s_Running.load() || batchCount == 1)
+        {
+            batchFunction(0, itemCount);
+            return;
+        }
+
+        // 共享状态由 shared_ptr 持有：迟到的工作线程领不到批次时直接退出，不再访问 batchFunction。
+        struct ParallelForState
+        {
+            std::atomic<uint32_t> NextBatch{0};
+            std::atomic<uint32_t> CompletedBatches{0};
+        };
+        auto state = std::make_shared<ParallelForState>();
+        const std::function<void(uint32_t, uint32_t)> *function = &batchFunction;
+
+        auto runBatches = [state, function, itemCount, batchSize, batchCount]()
+        {
+            for (;;)
+            {
+                const uint32_t batchIndex = state->NextBatch.fetch_add(1);
+                if (batchIndex >= batchCount)
+                    return;
+                const uint32_t beginIndex = batchIndex * batchSize;
+                const uint32_t endIndex = std::min(itemCount, beginIndex + batchSize);
+                (*function)(beginIndex, endIndex);
+                state->CompletedBatches.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        const uint32_t helperCount = std::min(static_cast<uint32_t>(s_Workers.size()), batchCount - 1);
+        for (uint32_t helperIndex = 0; helperIndex < helperCount; ++helperIndex)
+            Submit(runBatches);
+
+        runBatches();
+        while (state->CompletedBatches.load(std::memory_order_acquire) < batchCount)
+            std::this_thread::yield();
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return static_cast<uint32_t>(s_Workers.size());
+    }
+
     uint32_t JobSystem::GetPendingWorkerTaskCount()
     {
         return s_PendingWorkerTasks.load();
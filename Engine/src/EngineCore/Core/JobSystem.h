@@ -27,6 +27,12 @@ namespace Himii
         // 必须在主线程每帧调用，处理完成回调（含 OpenGL 上传）。
         static void PumpMainThreadCompletions();
 
+        // 将 [0, itemCount) 按 batchSize 切块分发到工作线程；调用线程同样领取批次，返回前全部完成。
+        // 未初始化时在调用线程顺序执行。batchFunction 参数为 [beginIndex, endIndex)。
+        static void ParallelFor(uint32_t itemCount, uint32_t batchSize,
+                                const std::function<void(uint32_t, uint32_t)> &batchFunction);
+
+        static uint32_t GetWorkerCount();
         static uint32_t GetPendingWorkerTaskCount();
         static uint32_t GetPendingMainThreadCompletionCount();
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <string>
 
@@ -25,4 +27,53 @@ namespace Himii
         static void SetDynamicLibrarySearchDirectory(const std::filesystem::path &directory);
         static bool SetEnvironmentVariableValue(const std::string &name, const std::string &value);
     };
+
+    /// 一次 stat 取得的文件指纹，查询代价与文件大小无关。
+    struct PlatformFileFingerprint
+    {
+        bool Exists = false;
+        uint64_t Size = 0;
+        /// 平台原生时间单位，仅用于比较。
+        int64_t ModifiedTime = 0;
+        /// inode / NTFS 文件索引：以临时文件 + 重命名方式替换时即使大小与时间相同也会变化。
+        uint64_t FileId = 0;
+
+        bool operator==(const PlatformFileFingerprint &other) const
+        {
+            return Exists == other.Exists && Size == other.Size && ModifiedTime == other.ModifiedTime
+                   && FileId == other.FileId;
+        }
+        bool operator!=(const PlatformFileFingerprint &other) const { return !(*this == other); }
+    };
+
+    /// 文件系统相关的平台能力（实现位于 Platform/**）。
+    class PlatformFileSystem
+    {
+    public:
+        /// 文件不存在或无法访问时返回 Exists = false 的指纹。
+        static PlatformFileFingerprint QueryFileFingerprint(const std::filesystem::path &filepath);
+    };
+
+    /// 只读文件映射（实现位于 Platform/**）。映射页由操作系统按需换入，析构时解除映射。
+    class PlatformMappedFile
+    {
+    public:
+        PlatformMappedFile() = default;
+        ~PlatformMappedFile();
+
+        PlatformMappedFile(const PlatformMappedFile &) = delete;
+        PlatformMappedFile &operator=(const PlatformMappedFile &) = delete;
+
+        bool Open(const std::filesystem::path &filepath);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const uint8_t *GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        const uint8_t *m_Data = nullptr;
+        size_t m_Size = 0;
+        void *m_NativeMappingHandle = nullptr;
+    };
 }
@@ -0,0 +1,227 @@
+#include "Hepch.h"
+#include "Module/Audio/AudioBusNode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 连续时间常数换算为逐帧一阶平滑系数；时间为 0 时立即到达目标。
+        float EvaluateSmoothingCoefficient(float seconds, uint32_t sampleRate)
+        {
+            if (seconds <= 0.0f || sampleRate == 0)
+                return 1.0f;
+            return 1.0f - std::exp(-1.0f / (seconds * static_cast<float>(sampleRate)));
+        }
+
+        ma_node_vtable s_AudioBusNodeVTable = {
+            &AudioBusNode::OnProcess, nullptr, 1, 1,
+            // 没有输入时仍要推进闪避与限幅的包络，否则键控总线静音后被闪避的总线不会恢复。
+            MA_NODE_FLAG_CONTINUOUS_PROCESSING};
+    }
+
+    AudioBusNode::~AudioBusNode()
+    {
+        Uninit();
+    }
+
+    bool AudioBusNode::Init(ma_node_graph *nodeGraph, uint32_t channelCount, uint32_t sampleRate)
+    {
+        Uninit();
+        if (!nodeGraph || channelCount == 0 || channelCount > MaximumChannelCount)
+            return false;
+
+        ma_node_config nodeConfig = ma_node_config_init();
+        nodeConfig.vtable = &s_AudioBusNodeVTable;
+        nodeConfig.pInputChannels = &channelCount;
+        nodeConfig.pOutputChannels = &channelCount;
+        m_Node.Owner = this;
+        if (ma_node_init(nodeGraph, &nodeConfig, nullptr, &m_Node.Base) != MA_SUCCESS)
+            return false;
+
+        m_ChannelCount = channelCount;
+        m_SampleRate = sampleRate;
+        m_AppliedParameterVersion = 0;
+        m_FilterState = {};
+        m_LimiterEnvelope = 1.0f;
+        m_DuckEnvelope = 1.0f;
+        m_BlockStartFrame = 0;
+        m_PeakLevel.store(0.0f);
+        m_PeakBlockEndFrame.store(0);
+        m_PreviousPeakLevel.store(0.0f);
+        m_ProcessNanoseconds.store(0);
+        m_ProcessedBlockCount.store(0);
+        m_ProcessedFrameCount.store(0);
+        m_Initialized = true;
+        return true;
+    }
+
+    void AudioBusNode::Uninit()
+    {
+        if (!m_Initialized)
+            return;
+        ma_node_uninit(&m_Node.Base, nullptr);
+        m_SidechainSource.store(nullptr);
+        m_Initialized = false;
+    }
+
+    bool AudioBusNode::AttachTo(ma_node *outputNode)
+    {
+        return m_Initialized && ma_node_attach_output_bus(&m_Node.Base, 0, outputNode, 0) == MA_SUCCESS;
+    }
+
+    void AudioBusNode::SetSettings(const AudioBusSettings &settings, const AudioBusNode *sidechainSource)
+    {
+        m_Gain.store(std::max(settings.Gain, 0.0f));
+        m_FilterType.store(static_cast<int>(settings.FilterType));
+        m_FilterCutoffHz.store(settings.FilterCutoffHz);
+        m_FilterQ.store(settings.FilterQ);
+        m_LimiterEnabled.store(settings.LimiterEnabled);
+        m_LimiterThreshold.store(std::max(settings.LimiterThreshold, 1.0e-4f));
+        m_LimiterReleaseSeconds.store(settings.LimiterReleaseSeconds);
+        m_SidechainSource.store(settings.DuckingEnabled && sidechainSource != this ? sidechainSource : nullptr);
+        m_DuckThreshold.store(settings.DuckThreshold);
+        m_DuckGain.store(std::clamp(settings.DuckGain, 0.0f, 1.0f));
+        m_DuckAttackSeconds.store(settings.DuckAttackSeconds);
+        m_DuckReleaseSeconds.store(settings.DuckReleaseSeconds);
+        m_ParameterVersion.fetch_add(1);
+    }
+
+    AudioBusStatistics AudioBusNode::GetStatistics() const
+    {
+        AudioBusStatistics statistics;
+        statistics.PeakLevel = m_PeakLevel.load();
+        statistics.DuckGain = m_CurrentDuckGain.load();
+        statistics.LimiterGain = m_CurrentLimiterGain.load();
+        statistics.ProcessMicroseconds = static_cast<double>(m_ProcessNanoseconds.load()) / 1000.0;
+        statistics.ProcessedBlockCount = m_ProcessedBlockCount.load();
+        statistics.ProcessedFrameCount = m_ProcessedFrameCount.load();
+        return statistics;
+    }
+
+    void AudioBusNode::OnProcess(ma_node *node, const float **framesIn, ma_uint32 *frameCountIn, float **framesOut,
+                                 ma_uint32 *frameCountOut)
+    {
+        (void)frameCountIn;
+        static_cast<NodeBase *>(node)->Owner->Process(framesIn[0], framesOut[0], *frameCountOut);
+    }
+
+    void AudioBusNode::RefreshParameters()
+    {
+        const uint32_t parameterVersion = m_ParameterVersion.load();
+        if (parameterVersion == m_AppliedParameterVersion)
+            return;
+        m_AppliedParameterVersion = parameterVersion;
+
+        const int filterType = m_FilterType.load();
+        if (filterType != m_ActiveFilterType)
+        {
+            m_FilterState = {};
+            m_ActiveFilterType = filterType;
+        }
+
+        // RBJ Audio EQ Cookbook 二阶低通 / 高通，系数按 a0 归一化为 b0 b1 b2 a1 a2。
+        const float sampleRate = static_cast<float>(m_SampleRate);
+        const float cutoffHz = std::clamp(m_FilterCutoffHz.load(), 10.0f, 0.45f * sampleRate);
+        const float quality = std::max(m_FilterQ.load(), 0.1f);
+        const float omega = 6.28318530718f * cutoffHz / sampleRate;
+        const float cosine = std::cos(omega);
+        const float alpha = std::sin(omega) / (2.0f * quality);
+        const float normalization = 1.0f / (1.0f + alpha);
+        const float sign = filterType == static_cast<int>(AudioBusFilterType::HighPass) ? -1.0f : 1.0f;
+        const float edge = (1.0f - sign * cosine) * 0.5f;
+        m_FilterCoefficients = {edge * normalization, sign * 2.0f * edge * normalization, edge * normalization,
+                                -2.0f * cosine * normalization, (1.0f - alpha) * normalization};
+
+        m_LimiterReleaseCoefficient = EvaluateSmoothingCoefficient(m_LimiterReleaseSeconds.load(), m_SampleRate);
+        m_DuckAttackCoefficient = EvaluateSmoothingCoefficient(m_DuckAttackSeconds.load(), m_SampleRate);
+        m_DuckReleaseCoefficient = EvaluateSmoothingCoefficient(m_DuckReleaseSeconds.load(), m_SampleRate);
+    }
+
+    void AudioBusNode::Process(const float *framesIn, float *framesOut, uint32_t frameCount)
+    {
+        const auto processStart = std::chrono::steady_clock::now();
+        RefreshParameters();
+
+        const uint32_t channelCount = m_ChannelCount;
+        const float gain = m_Gain.load();
+        const bool filterEnabled = m_ActiveFilterType != static_cast<int>(AudioBusFilterType::None);
+        const bool limiterEnabled = m_LimiterEnabled.load();
+        const float limiterThreshold = m_LimiterThreshold.load();
+
+        // 键控电平固定取键控总线上一块的峰值：节点图里键控总线可能先于或晚于本总线处理，
+        // 若它本块已处理过，就改读它锁存的前一块峰值。固定一块延迟，结果与处理顺序无关。
+        float duckTarget = 1.0f;
+        if (const AudioBusNode *sidechainSource = m_SidechainSource.load())
+        {
+            const bool sourceAlreadyProcessed = sidechainSource->m_PeakBlockEndFrame.load() > m_BlockStartFrame;
+            const float sidechainPeak = sourceAlreadyProcessed ? sidechainSource->m_PreviousPeakLevel.load()
+                                                               : sidechainSource->m_PeakLevel.load();
+            if (sidechainPeak > m_DuckThreshold.load())
+                duckTarget = m_DuckGain.load();
+        }
+        else
+        {
+            m_DuckEnvelope = 1.0f;
+        }
+        const float duckCoefficient = duckTarget < m_DuckEnvelope ? m_DuckAttackCoefficient : m_DuckReleaseCoefficient;
+
+        const auto &coefficients = m_FilterCoefficients;
+        float peakLevel = 0.0f;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            m_DuckEnvelope += (duckTarget - m_DuckEnvelope) * duckCoefficient;
+            const float frameGain = gain * m_DuckEnvelope;
+
+            const float *input = framesIn + static_cast<size_t>(frame) * channelCount;
+            float *output = framesOut + static_cast<size_t>(frame) * channelCount;
+            float framePeak = 0.0f;
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                float sample = input[channel] * frameGain;
+                if (filterEnabled)
+                {
+                    // Transposed Direct Form II，每声道两个状态量。
+                    auto &state = m_FilterState[channel];
+                    const float filtered = coefficients[0] * sample + state[0];
+                    state[0] = coefficients[1] * sample - coefficients[3] * filtered + state[1];
+                    state[1] = coefficients[2] * sample - coefficients[4] * filtered;
+                    sample = filtered;
+                }
+                output[channel] = sample;
+                framePeak = std::max(framePeak, std::abs(sample));
+            }
+
+            if (limiterEnabled)
+            {
+                // 立即压到阈值：包络只会慢慢回升，不会超过本帧允许的增益，输出峰值不超过阈值。
+                const float limiterTarget = framePeak > limiterThreshold ? limiterThreshold / framePeak : 1.0f;
+                if (limiterTarget < m_LimiterEnvelope)
+                    m_LimiterEnvelope = limiterTarget;
+                else
+                    m_LimiterEnvelope += (limiterTarget - m_LimiterEnvelope) * m_LimiterReleaseCoefficient;
+                for (uint32_t channel = 0; channel < channelCount; ++channel)
+                    output[channel] *= m_LimiterEnvelope;
+                framePeak *= m_LimiterEnvelope;
+            }
+            peakLevel = std::max(peakLevel, framePeak);
+        }
+        if (!limiterEnabled)
+            m_LimiterEnvelope = 1.0f;
+
+        m_PreviousPeakLevel.store(m_PeakLevel.load());
+        m_PeakLevel.store(peakLevel);
+        m_BlockStartFrame += frameCount;
+        m_PeakBlockEndFrame.store(m_BlockStartFrame);
+        m_CurrentDuckGain.store(m_DuckEnvelope);
+        m_CurrentLimiterGain.store(m_LimiterEnvelope);
+        m_ProcessNanoseconds.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart)
+                .count()));
+        m_ProcessedBlockCount.fetch_add(1);
+        m_ProcessedFrameCount.fetch_add(frameCount);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Module/Audio/AudioEngine.h"
+
+#include "miniaudio.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Himii
+{
+    /// 混音总线：挂在 miniaudio 节点图上的单输入单输出节点，依次执行闪避、增益、biquad 与限幅。
+    /// 参数由主线程写入原子量，音频线程在每块开头取用；节点回调持有 this，初始化后不能移动。
+    class AudioBusNode
+    {
+    public:
+        static constexpr uint32_t MaximumChannelCount = 8;
+
+        AudioBusNode() = default;
+        ~AudioBusNode();
+
+        AudioBusNode(const AudioBusNode &) = delete;
+        AudioBusNode &operator=(const AudioBusNode &) = delete;
+
+        bool Init(ma_node_graph *nodeGraph, uint32_t channelCount, uint32_t sampleRate);
+        void Uninit();
+        bool IsInitialized() const { return m_Initialized; }
+
+        ma_node *GetNode() { return &m_Node.Base; }
+        bool AttachTo(ma_node *outputNode);
+
+        /// sidechainSource 为闪避的键控总线，可为空；与本总线相同时忽略。
+        void SetSettings(const AudioBusSettings &settings, const AudioBusNode *sidechainSource);
+        AudioBusStatistics GetStatistics() const;
+
+        /// miniaudio 节点处理回调，在音频线程上调用。
+        static void OnProcess(ma_node *node, const float **framesIn, ma_uint32 *frameCountIn, float **framesOut,
+                              ma_uint32 *frameCountOut);
+
+    private:
+        struct NodeBase
+        {
+            ma_node_base Base;
+            AudioBusNode *Owner;
+        };
+
+        void Process(const float *framesIn, float *framesOut, uint32_t frameCount);
+        void RefreshParameters();
+
+        NodeBase m_Node{};
+        bool m_Initialized = false;
+        uint32_t m_ChannelCount = 0;
+        uint32_t m_SampleRate = 0;
+
+        // 主线程写入
+        std::atomic<float> m_Gain{1.0f};
+        std::atomic<int> m_FilterType{0};
+        std::atomic<float> m_FilterCutoffHz{1000.0f};
+        std::atomic<float> m_FilterQ{0.7071f};
+        std::atomic<bool> m_LimiterEnabled{false};
+        std::atomic<float> m_LimiterThreshold{1.0f};
+        std::atomic<float> m_LimiterReleaseSeconds{0.1f};
+        std::atomic<const AudioBusNode *> m_SidechainSource{nullptr};
+        std::atomic<float> m_DuckThreshold{0.02f};
+        std::atomic<float> m_DuckGain{0.3f};
+        std::atomic<float> m_DuckAttackSeconds{0.05f};
+        std::atomic<float> m_DuckReleaseSeconds{0.5f};
+        std::atomic<uint32_t> m_ParameterVersion{1};
+
+        // 音频线程独占
+        uint32_t m_AppliedParameterVersion = 0;
+        int m_ActiveFilterType = 0;
+        std::array<float, 5> m_FilterCoefficients{};
+        std::array<std::array<float, 2>, MaximumChannelCount> m_FilterState{};
+        float m_LimiterEnvelope = 1.0f;
+        float m_LimiterReleaseCoefficient = 0.0f;
+        float m_DuckEnvelope = 1.0f;
+        float m_DuckAttackCoefficient = 1.0f;
+        float m_DuckReleaseCoefficient = 1.0f;
+        /// 本块第一帧在总线时间线上的位置；所有总线一起初始化、每块都处理，位置彼此对齐。
+        uint64_t m_BlockStartFrame = 0;
+
+        // 音频线程写入，供侧链与统计读取
+        std::atomic<float> m_PeakLevel{0.0f};
+        /// m_PeakLevel 所属块结束处的帧位置，以及它之前那一块的峰值；侧链据此总是取上一块。
+        std::atomic<uint64_t> m_PeakBlockEndFrame{0};
+        std::atomic<float> m_PreviousPeakLevel{0.0f};
+        std::atomic<float> m_CurrentDuckGain{1.0f};
+        std::atomic<float> m_CurrentLimiterGain{1.0f};
+        std::atomic<uint64_t> m_ProcessNanoseconds{0};
+        std::atomic<uint64_t> m_ProcessedBlockCount{0};
+        std::atomic<uint64_t> m_ProcessedFrameCount{0};
+    };
+}
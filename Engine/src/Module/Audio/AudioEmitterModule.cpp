@@ -0,0 +1,47 @@
+#include "Hepch.h"
+#include "Module/Audio/AudioEmitterModule.h"
+#include "World/Scene/Components.h"
+#include "World/Scene/Entity.h"
+#include "World/Scene/Scene.h"
+
+namespace Himii
+{
+    void AudioEmitterModule::OnUpdate(Timestep timestep)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!m_Scene || !AudioEngine::IsInitialized())
+            return;
+
+        Entity cameraEntity = m_Scene->GetPrimaryCameraEntity();
+        if (cameraEntity)
+        {
+            const glm::mat4 cameraTransform = m_Scene->GetEntityWorldTransformMatrix(cameraEntity);
+            AudioListener listener;
+            listener.Position = glm::vec3(cameraTransform[3]);
+            listener.Forward = -glm::normalize(glm::vec3(cameraTransform[2]));
+            listener.Up = glm::normalize(glm::vec3(cameraTransform[1]));
+            // 正交相机的场景按 2D 处理，相机的 Z 不参与距离。
+            listener.Planar = cameraEntity.GetComponent<CameraComponent>().Camera.GetProjectionType()
+                              == SceneCamera::ProjectionType::Orthographic;
+            AudioEngine::SetListener(listener);
+        }
+
+        m_VoiceHandles.clear();
+        m_Positions.clear();
+        auto view = m_Scene->GetAllEntitiesWith<SoundPlayerComponent>();
+        for (auto entityHandle : view)
+        {
+            const auto &soundPlayer = view.get<SoundPlayerComponent>(entityHandle);
+            if (!soundPlayer.Spatial.Enabled || soundPlayer.RuntimeVoiceHandle == AudioEngine::InvalidVoiceHandle)
+                continue;
+
+            m_VoiceHandles.push_back(soundPlayer.RuntimeVoiceHandle);
+            m_Positions.emplace_back(m_Scene->GetEntityWorldTransformMatrix(Entity{entityHandle, m_Scene})[3]);
+        }
+
+        if (!m_VoiceHandles.empty())
+            AudioEngine::SetVoicePositions(m_VoiceHandles.data(), m_Positions.data(),
+                                           static_cast<uint32_t>(m_VoiceHandles.size()));
+    }
+}
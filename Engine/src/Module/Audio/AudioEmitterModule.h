@@ -0,0 +1,32 @@
+#pragma once
+
+#include "World/IWorldModule.h"
+#include "Module/Audio/AudioEngine.h"
+
+#include <vector>
+
+namespace Himii
+{
+    class Scene;
+
+    /// World 级声源模块：每帧从主相机更新听者，并把空间化 SoundPlayer 的世界位置一次性批量提交给 AudioEngine。
+    /// 注册时挂到 WorldUpdatePhase::Presentation，位于物理与脚本之后。
+    class AudioEmitterModule : public IWorldModule
+    {
+    public:
+        explicit AudioEmitterModule(Scene *scene) : m_Scene(scene) {}
+
+        const char *GetModuleName() const override { return "AudioEmitter"; }
+
+        void OnInitialize() override {}
+        void OnShutdown() override {}
+
+        void OnUpdate(Timestep timestep) override;
+
+    private:
+        Scene *m_Scene = nullptr;
+        // 每帧复用，避免重复分配
+        std::vector<AudioVoiceHandle> m_VoiceHandles;
+        std::vector<glm::vec3> m_Positions;
+    };
+}
@@ -1,32 +1,237 @@
 #include "Hepch.h"
 #include "Module/Audio/AudioEngine.h"
+#include "Module/Audio/AudioBusNode.h"
+#include "Module/Audio/AudioSpatialAttenuation.h"
+#include "Module/Audio/SoundStreamDecoder.h"
 #include "EngineCore/Core/Log.h"
 
 #include "miniaudio.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace Himii
 {
     namespace
     {
-        struct VoiceSlot
+        /// 音量低于此值的 voice 不占用真实 voice。
+        constexpr float MinimumAudibleVolume = 1.0e-4f;
+        /// 已在播放的真实 voice 比较时放大音量，避免音量相近的 voice 每帧来回切换。
+        constexpr float RealVoiceHysteresis = 1.1f;
+
+        /// 真实 voice 的数据源代理：ma_sound 按引擎输出格式只初始化一次，换声音时只切换 Target。
+        /// 对外始终报告引擎的 f32 声道数与采样率；Target 格式不同时经预分配的转换器转换，
+        /// 音频线程不会看到格式变化。游标、长度与 seek 始终以 Target 自身的帧为单位（源采样率），
+        /// 与虚拟 voice 的游标一致。
+        struct VoiceDataSource
+        {
+            ma_data_source_base Base{};
+            std::atomic<ma_data_source*> Target{nullptr};
+            /// 正在通过 Target 读取的线程数；解绑时等它归零后才释放解码器。
+            std::atomic<uint32_t> ReaderCount{0};
+            /// 引擎输出格式，初始化后不变。
+            uint32_t Channels = 0;
+            uint32_t SampleRate = 0;
+
+            // 以下只在 Target 为空时由主线程修改
+            ma_format TargetFormat = ma_format_f32;
+            uint32_t TargetChannels = 0;
+            bool ConversionEnabled = false;
+            ma_data_converter Converter{};
+            bool ConverterInitialized = false;
+            /// 按最坏情况预留，绑定时不分配；不够时扩容并计入统计。
+            std::vector<uint8_t> ConverterHeap;
+
+            // 以下由音频线程独占：从 Target 读出、尚未送进转换器的源数据
+            std::array<float, 2048> InputSamples{};
+            uint32_t InputFrameOffset = 0;
+            uint32_t InputFrameCount = 0;
+            /// 已从 Target 读出但还没转换的帧数，主线程读游标时从 Target 游标中减去。
+            std::atomic<uint32_t> PendingInputFrameCount{0};
+        };
+
+        template<typename Function>
+        ma_result AccessVoiceTarget(VoiceDataSource& source, ma_result detachedResult, const Function& function)
+        {
+            source.ReaderCount.fetch_add(1);
+            ma_data_source* target = source.Target.load();
+            const ma_result result = target ? function(target) : detachedResult;
+            source.ReaderCount.fetch_sub(1);
+            return result;
+        }
+
+        ma_result ReadVoiceDataSource(ma_data_source* dataSource, void* framesOut, ma_uint64 frameCount,
+                                      ma_uint64* framesRead)
+        {
+            VoiceDataSource& source = *static_cast<VoiceDataSource*>(dataSource);
+            ma_uint64 totalFramesRead = 0;
+            const ma_result result = AccessVoiceTarget(
+                source, MA_AT_END,
+                [&](ma_data_source* target)
+                {
+                    if (!source.ConversionEnabled)
+                        return ma_data_source_read_pcm_frames(target, framesOut, frameCount, &totalFramesRead);
+
+                    const uint32_t inputFrameSize = ma_get_bytes_per_frame(source.TargetFormat, source.TargetChannels);
+                    const uint32_t inputFrameCapacity =
+                        static_cast<uint32_t>(sizeof(source.InputSamples) / inputFrameSize);
+                    const uint8_t* inputBytes = reinterpret_cast<const uint8_t*>(source.InputSamples.data());
+                    float* output = static_cast<float*>(framesOut);
+                    ma_result readResult = MA_SUCCESS;
+                    while (totalFramesRead < frameCount)
+                    {
+                        if (source.InputFrameOffset == source.InputFrameCount)
+                        {
+                            if (readResult != MA_SUCCESS)
+                                break;
+                            ma_uint64 inputFramesRead = 0;
+                            readResult = ma_data_source_read_pcm_frames(target, source.InputSamples.data(),
+                                                                        inputFrameCapacity, &inputFramesRead);
+                            source.InputFrameOffset = 0;
+                            source.InputFrameCount = static_cast<uint32_t>(inputFramesRead);
+                            if (inputFramesRead == 0)
+                                break;
+                        }
+
+                        ma_uint64 inputFrameCount = source.InputFrameCount - source.InputFrameOffset;
+                        ma_uint64 outputFrameCount = frameCount - totalFramesRead;
+                        ma_data_converter_process_pcm_frames(
+                            &source.Converter, inputBytes + static_cast<size_t>(source.InputFrameOffset) * inputFrameSize,
+                            &inputFrameCount, output + totalFramesRead * source.Channels, &outputFrameCount);
+                        source.InputFrameOffset += static_cast<uint32_t>(inputFrameCount);
+                        totalFramesRead += outputFrameCount;
+                        if (inputFrameCount == 0 && outputFrameCount == 0)
+                            break;
+                    }
+                    source.PendingInputFrameCount.store(source.InputFrameCount - source.InputFrameOffset);
+                    if (totalFramesRead == frameCount)
+                        return MA_SUCCESS;
+                    // 没读满时必须报告结束，否则 ma_data_source_read_pcm_frames 会一直重试。
+                    return readResult == MA_SUCCESS ? MA_AT_END : readResult;
+                });
+
+            if (framesRead)
+                *framesRead = totalFramesRead;
+            return result;
+        }
+
+        ma_result SeekVoiceDataSource(ma_data_source* dataSource, ma_uint64 frameIndex)
+        {
+            VoiceDataSource& source = *static_cast<VoiceDataSource*>(dataSource);
+            return AccessVoiceTarget(source, MA_SUCCESS,
+                                     [&source, frameIndex](ma_data_source* target)
+                                     {
+                                         if (source.ConversionEnabled)
+                                         {
+                                             source.InputFrameOffset = 0;
+                                             source.InputFrameCount = 0;
+                                             source.PendingInputFrameCount.store(0);
+                                             ma_data_converter_reset(&source.Converter);
+                                         }
+                                         return ma_data_source_seek_to_pcm_frame(target, frameIndex);
+                                     });
+        }
+
+        ma_result GetVoiceDataSourceFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* channels,
+                                           ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCapacity)
+        {
+            const VoiceDataSource& source = *static_cast<const VoiceDataSource*>(dataSource);
+            *format = ma_format_f32;
+            *channels = source.Channels;
+            *sampleRate = source.SampleRate;
+            if (channelMap)
+                ma_channel_map_init_standard(ma_standard_channel_map_default, channelMap, channelMapCapacity,
+                                             source.Channels);
+            return MA_SUCCESS;
+        }
+
+        ma_result GetVoiceDataSourceCursor(ma_data_source* dataSource, ma_uint64* cursor)
+        {
+            VoiceDataSource& source = *static_cast<VoiceDataSource*>(dataSource);
+            *cursor = 0;
+            return AccessVoiceTarget(source, MA_SUCCESS,
+                                     [&source, cursor](ma_data_source* target)
+                                     {
+                                         const ma_result result = ma_data_source_get_cursor_in_pcm_frames(target, cursor);
+                                         const ma_uint64 pendingFrameCount = source.PendingInputFrameCount.load();
+                                         *cursor = *cursor > pendingFrameCount ? *cursor - pendingFrameCount : 0;
+                                         return result;
+                                     });
+        }
+
+        ma_result GetVoiceDataSourceLength(ma_data_source* dataSource, ma_uint64* length)
+        {
+            VoiceDataSource& source = *static_cast<VoiceDataSource*>(dataSource);
+            *length = 0;
+            return AccessVoiceTarget(source, MA_SUCCESS, [length](ma_data_source* target)
+                                     { return ma_data_source_get_length_in_pcm_frames(target, length); });
+        }
+
+        ma_data_source_vtable s_VoiceDataSourceVTable = {
+            ReadVoiceDataSource,      SeekVoiceDataSource, GetVoiceDataSourceFormat,
+            GetVoiceDataSourceCursor, GetVoiceDataSourceLength, nullptr, 0};
+
+        /// 预先初始化的混音器 voice；绑定声音只切换数据源，不分配内存也不打开文件。
+        struct RealVoice
+        {
+            VoiceDataSource DataSource;
+            bool DataSourceInitialized = false;
+            ma_audio_buffer_ref BufferReference{};
+            // 流式资产绑定期间独占一个从资产解码器池借来的解码器，由音频线程按需读文件解码；解绑时归还。
+            Scope<SoundStreamDecoder> StreamDecoder;
+            ma_sound Sound{};
+            bool SoundInitialized = false;
+            /// 当前连接的总线节点；为空表示 ma_sound 初始化时默认连接的 endpoint。
+            ma_node* AttachedOutput = nullptr;
+            Ref<SoundAsset> BoundSoundAsset; // 保持 PCM 内存存活
+            int32_t VirtualVoiceIndex = -1;
+        };
+
+        struct VirtualVoice
         {
             bool InUse = false;
             bool IsOneShot = false;
+            bool Loop = false;
+            bool Paused = false;
             bool ProtectFromEviction = false;
-            ma_audio_buffer AudioBuffer{};
-            ma_sound Sound{};
-            Ref<SoundAsset> OwningSoundAsset; // 保持 PCM 内存存活
+            /// 为 false 时不衰减不声像，SpatialEmitterArrays 中的结果被忽略。
+            bool Spatial = false;
+            AudioBus Bus = AudioBus::SFX;
+            uint16_t Generation = 1;
+            int32_t Priority = AudioEngine::DefaultVoicePriority;
+            float Volume = 1.0f;
+            /// Update 中计算的比较用音量（已含真实 voice 的滞回）。
+            float Audibility = 0.0f;
+            Ref<SoundAsset> Sound;
+            /// 源采样率下的播放位置；虚拟期间按时间推进，降级时从真实 voice 读回。
+            double CursorFrame = 0.0;
+            int32_t RealVoiceIndex = -1;
+            uint64_t StartSequence = 0;
         };
 
         struct AudioEngineState
         {
             bool Initialized = false;
+            /// 由 InitOffline 初始化：不打开设备，混音只经 ReadOfflineFrames 拉取。
+            bool Offline = false;
             ma_engine Engine{};
-            std::array<VoiceSlot, AudioEngine::MaximumVoiceCount> Voices{};
-            VoiceSlot PreviewVoice{};
+            std::array<RealVoice, AudioEngine::MaximumRealVoiceCount> RealVoices{};
+            std::vector<VirtualVoice> VirtualVoices;
+            std::vector<uint32_t> FreeVirtualVoiceIndices;
+            std::vector<uint32_t> Candidates;
+            SpatialEmitterArrays Emitters;
+            ListenerFrame Listener;
+            uint64_t NextStartSequence = 0;
+            AudioVoiceStatistics Statistics;
+            /// 总线节点随引擎初始化；设置独立保存，重新初始化后照常生效。
+            std::array<AudioBusNode, AudioBusCount> Buses;
+            AudioMixerSettings MixerSettings;
+            RealVoice PreviewVoice{};
             bool PreviewActive = false;
             std::mutex Mutex;
         };
@@ -37,106 +242,490 @@ namespace Himii
             return state;
         }
 
-        void UninitializeVoiceSlot(VoiceSlot& slot)
+        float ClampVolume(float volume)
+        {
+            return volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
+        }
+
+        /// 按引擎输出格式准备 ma_sound，每个 voice 只做一次；转换器的堆按最坏情况
+        /// （int16、8 声道、采样率不同）预留，之后绑定任何格式的声音都不再分配。
+        bool PrepareRealVoice(RealVoice& voice, ma_engine* engine)
+        {
+            if (voice.SoundInitialized)
+                return true;
+
+            if (!voice.DataSourceInitialized)
+            {
+                ma_data_source_config dataSourceConfig = ma_data_source_config_init();
+                dataSourceConfig.vtable = &s_VoiceDataSourceVTable;
+                if (ma_data_source_init(&dataSourceConfig, &voice.DataSource.Base) != MA_SUCCESS)
+                    return false;
+                voice.DataSourceInitialized = true;
+            }
+
+            VoiceDataSource& source = voice.DataSource;
+            source.Channels = ma_engine_get_channels(engine);
+            source.SampleRate = ma_engine_get_sample_rate(engine);
+            const ma_data_converter_config worstCaseConfig = ma_data_converter_config_init(
+                ma_format_s16, ma_format_f32, AudioBusNode::MaximumChannelCount, source.Channels,
+                source.SampleRate + 1, source.SampleRate);
+            size_t heapSize = 0;
+            if (ma_data_converter_get_heap_size(&worstCaseConfig, &heapSize) == MA_SUCCESS)
+                source.ConverterHeap.resize(heapSize);
+
+            if (ma_sound_init_from_data_source(engine, &voice.DataSource, MA_SOUND_FLAG_NO_SPATIALIZATION, nullptr,
+                                               &voice.Sound)
+                != MA_SUCCESS)
+                return false;
+
+            voice.SoundInitialized = true;
+            voice.AttachedOutput = nullptr;
+            return true;
+        }
+
+        void UninitVoiceConverter(VoiceDataSource& source)
         {
-            if (!slot.InUse)
+            if (!source.ConverterInitialized)
                 return;
+            ma_data_converter_uninit(&source.Converter, nullptr);
+            source.ConverterInitialized = false;
+        }
+
+        /// 只能在 Target 为空时调用；格式与引擎一致时直通，不经过转换器。
+        bool ConfigureVoiceConversion(VoiceDataSource& source, ma_format format, uint32_t channelCount,
+                                      uint32_t sampleRate, uint32_t& heapGrowthCount)
+        {
+            UninitVoiceConverter(source);
+            source.TargetFormat = format;
+            source.TargetChannels = channelCount;
+            source.InputFrameOffset = 0;
+            source.InputFrameCount = 0;
+            source.PendingInputFrameCount.store(0);
+            source.ConversionEnabled =
+                format != ma_format_f32 || channelCount != source.Channels || sampleRate != source.SampleRate;
+            if (!source.ConversionEnabled)
+                return true;
+
+            const ma_data_converter_config converterConfig = ma_data_converter_config_init(
+                format, ma_format_f32, channelCount, source.Channels, sampleRate, source.SampleRate);
+            size_t heapSize = 0;
+            if (ma_data_converter_get_heap_size(&converterConfig, &heapSize) != MA_SUCCESS)
+                return false;
+            if (heapSize > source.ConverterHeap.size())
+            {
+                source.ConverterHeap.resize(heapSize);
+                ++heapGrowthCount;
+            }
+            if (ma_data_converter_init_preallocated(&converterConfig, source.ConverterHeap.data(), &source.Converter)
+                != MA_SUCCESS)
+                return false;
+            source.ConverterInitialized = true;
+            return true;
+        }
+
+        void DetachRealVoice(RealVoice& voice)
+        {
+            if (voice.SoundInitialized)
+                ma_sound_stop(&voice.Sound);
 
-            ma_sound_uninit(&slot.Sound);
-            ma_audio_buffer_uninit(&slot.AudioBuffer);
-            slot.OwningSoundAsset.reset();
-            slot.InUse = false;
-            slot.IsOneShot = false;
-            slot.ProtectFromEviction = false;
+            voice.DataSource.Target.store(nullptr);
+            while (voice.DataSource.ReaderCount.load() > 0)
+                std::this_thread::yield();
+
+            // 读者已全部退出，解码器可以交还给资产复用。
+            if (voice.StreamDecoder && voice.BoundSoundAsset)
+                voice.BoundSoundAsset->ReleaseStreamDecoder(std::move(voice.StreamDecoder));
+            voice.StreamDecoder.reset();
+            voice.BoundSoundAsset.reset();
+            voice.VirtualVoiceIndex = -1;
+        }
+
+        void ReleaseRealVoice(RealVoice& voice)
+        {
+            DetachRealVoice(voice);
+            UninitVoiceConverter(voice.DataSource);
+            if (voice.SoundInitialized)
+            {
+                ma_sound_uninit(&voice.Sound);
+                voice.SoundInitialized = false;
+            }
+            if (voice.DataSourceInitialized)
+            {
+                ma_data_source_uninit(&voice.DataSource.Base);
+                voice.DataSourceInitialized = false;
+            }
         }
 
-        bool InitializeVoiceFromSoundAsset(VoiceSlot& slot, const Ref<SoundAsset>& soundAsset, float volume,
-                                           bool loop, ma_engine* engine)
+        /// outputNode 为空时保持连接 endpoint（离线渲染用）。
+        bool BindRealVoice(RealVoice& voice, const Ref<SoundAsset>& soundAsset, ma_engine* engine, ma_node* outputNode,
+                           float volume, bool loop, uint64_t startFrame, uint32_t& heapGrowthCount)
         {
             if (!soundAsset || !soundAsset->IsValid() || !engine)
                 return false;
 
-            ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(
-                ma_format_f32,
-                soundAsset->GetChannelCount(),
-                soundAsset->GetFrameCount(),
-                soundAsset->GetPulseCodeModulationSamples().data(),
-                nullptr);
-
-            if (ma_audio_buffer_init(&bufferConfig, &slot.AudioBuffer) != MA_SUCCESS)
+            DetachRealVoice(voice);
+            if (!PrepareRealVoice(voice, engine))
                 return false;
 
-            const ma_uint32 flags = MA_SOUND_FLAG_NO_SPATIALIZATION;
-            if (ma_sound_init_from_data_source(engine, &slot.AudioBuffer, flags, nullptr, &slot.Sound) != MA_SUCCESS)
+            if (outputNode && voice.AttachedOutput != outputNode)
             {
-                ma_audio_buffer_uninit(&slot.AudioBuffer);
-                return false;
+                if (ma_node_attach_output_bus(&voice.Sound, 0, outputNode, 0) != MA_SUCCESS)
+                    return false;
+                voice.AttachedOutput = outputNode;
             }
 
-            ma_sound_set_volume(&slot.Sound, volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume));
-            ma_sound_set_looping(&slot.Sound, loop ? MA_TRUE : MA_FALSE);
-            if (ma_sound_start(&slot.Sound) != MA_SUCCESS)
+            ma_data_source* target = nullptr;
+            ma_format targetFormat = ma_format_f32;
+            if (soundAsset->IsStreaming())
             {
-                ma_sound_uninit(&slot.Sound);
-                ma_audio_buffer_uninit(&slot.AudioBuffer);
+                voice.StreamDecoder = soundAsset->AcquireStreamDecoder();
+                if (!voice.StreamDecoder)
+                    return false;
+                target = voice.StreamDecoder->GetDataSource();
+            }
+            else
+            {
+                targetFormat =
+                    soundAsset->GetSampleFormat() == SoundSampleFormat::Int16 ? ma_format_s16 : ma_format_f32;
+                if (ma_audio_buffer_ref_init(targetFormat, soundAsset->GetChannelCount(),
+                                             soundAsset->GetResidentSampleData(), soundAsset->GetFrameCount(),
+                                             &voice.BufferReference)
+                    != MA_SUCCESS)
+                    return false;
+                target = &voice.BufferReference;
+            }
+
+            voice.BoundSoundAsset = soundAsset;
+            if (!ConfigureVoiceConversion(voice.DataSource, targetFormat, soundAsset->GetChannelCount(),
+                                          soundAsset->GetSampleRate(), heapGrowthCount))
+            {
+                DetachRealVoice(voice);
                 return false;
             }
+            voice.DataSource.Target.store(target);
 
-            slot.OwningSoundAsset = soundAsset;
-            slot.InUse = true;
+            ma_sound_set_volume(&voice.Sound, ClampVolume(volume));
+            ma_sound_set_pan(&voice.Sound, 0.0f);
+            ma_sound_set_looping(&voice.Sound, loop ? MA_TRUE : MA_FALSE);
+            // 先写 seek 目标再启动：音频线程处理这个 voice 前总会先执行 seek。
+            ma_sound_seek_to_pcm_frame(&voice.Sound, startFrame);
+            if (ma_sound_start(&voice.Sound) != MA_SUCCESS)
+            {
+                DetachRealVoice(voice);
+                return false;
+            }
             return true;
         }
 
-        void ReclaimFinishedOneShots(AudioEngineState& state)
+        ma_node* GetBusNode(AudioEngineState& state, AudioBus bus)
         {
-            for (auto& slot : state.Voices)
+            return state.Buses[static_cast<size_t>(bus)].GetNode();
+        }
+
+        void ApplyMixerSettings(AudioEngineState& state)
+        {
+            for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
             {
-                if (!slot.InUse || !slot.IsOneShot)
-                    continue;
-                if (!ma_sound_is_playing(&slot.Sound))
-                    UninitializeVoiceSlot(slot);
+                const AudioBusSettings& busSettings = state.MixerSettings.Buses[static_cast<size_t>(busIndex)];
+                state.Buses[static_cast<size_t>(busIndex)].SetSettings(
+                    busSettings, &state.Buses[static_cast<size_t>(busSettings.DuckSource)]);
             }
         }
 
-        int FindFreeVoiceIndex(AudioEngineState& state, bool allowEvictOneShot)
+        AudioVoiceHandle ToVoiceHandle(const AudioEngineState& state, uint32_t index)
+        {
+            return (static_cast<AudioVoiceHandle>(state.VirtualVoices[index].Generation) << 16) | index;
+        }
+
+        int32_t ResolveVoiceIndex(const AudioEngineState& state, AudioVoiceHandle handle)
+        {
+            if (handle == AudioEngine::InvalidVoiceHandle)
+                return -1;
+
+            const uint32_t index = handle & 0xFFFFu;
+            if (index >= state.VirtualVoices.size())
+                return -1;
+
+            const VirtualVoice& voice = state.VirtualVoices[index];
+            if (!voice.InUse || voice.Generation != static_cast<uint16_t>(handle >> 16))
+                return -1;
+            return static_cast<int32_t>(index);
+        }
+
+        /// 排序规则：优先级 → 主轨优先于 OneShot → 音量 → 先开始的优先。
+        bool IsMoreAudible(const VirtualVoice& left, const VirtualVoice& right)
+        {
+            if (left.Priority != right.Priority)
+                return left.Priority > right.Priority;
+            if (left.ProtectFromEviction != right.ProtectFromEviction)
+                return left.ProtectFromEviction;
+            if (left.Audibility != right.Audibility)
+                return left.Audibility > right.Audibility;
+            return left.StartSequence < right.StartSequence;
+        }
+
+        /// 音量乘以距离衰减，即混音器中这个 voice 的实际增益。
+        float EvaluateEffectiveVolume(const AudioEngineState& state, uint32_t index)
+        {
+            const VirtualVoice& voice = state.VirtualVoices[index];
+            return voice.Spatial ? voice.Volume * state.Emitters.Gain[index] : voice.Volume;
+        }
+
+        float EvaluateAudibility(const AudioEngineState& state, uint32_t index)
         {
-            ReclaimFinishedOneShots(state);
+            const float effectiveVolume = EvaluateEffectiveVolume(state, index);
+            return state.VirtualVoices[index].RealVoiceIndex >= 0 ? effectiveVolume * RealVoiceHysteresis
+                                                                 : effectiveVolume;
+        }
+
+        void ApplyRealVoiceMix(AudioEngineState& state, uint32_t index)
+        {
+            const VirtualVoice& voice = state.VirtualVoices[index];
+            ma_sound& sound = state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)].Sound;
+            ma_sound_set_volume(&sound, EvaluateEffectiveVolume(state, index));
+            ma_sound_set_pan(&sound, voice.Spatial ? state.Emitters.Pan[index] : 0.0f);
+        }
+
+        void WriteSpatialSettings(AudioEngineState& state, uint32_t index, const AudioSpatialSettings& settings)
+        {
+            // 保证 0 < MinDistance < MaxDistance，核内除法无需再判断。
+            const float minimumDistance = std::max(settings.MinDistance, 1.0e-3f);
+            state.VirtualVoices[index].Spatial = settings.Enabled;
+            state.Emitters.MinDistance[index] = minimumDistance;
+            state.Emitters.MaxDistance[index] = std::max(settings.MaxDistance, minimumDistance + 1.0e-3f);
+            state.Emitters.Rolloff[index] = std::max(settings.Rolloff, 0.0f);
+            state.Emitters.LinearBlend[index] =
+                settings.AttenuationModel == AudioAttenuationModel::Linear ? 1.0f : 0.0f;
+        }
+
+        void WriteEmitterPosition(AudioEngineState& state, uint32_t index, const glm::vec3& position)
+        {
+            state.Emitters.PositionX[index] = position.x;
+            state.Emitters.PositionY[index] = position.y;
+            state.Emitters.PositionZ[index] = position.z;
+        }
 
-            for (size_t index = 0; index < state.Voices.size(); ++index)
+        /// 把真实 voice 的播放位置写回虚拟 voice 并释放真实 voice。
+        void DemoteVoice(AudioEngineState& state, VirtualVoice& voice)
+        {
+            if (voice.RealVoiceIndex < 0)
+                return;
+
+            RealVoice& realVoice = state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)];
+            ma_uint64 cursorFrame = 0;
+            if (ma_sound_get_cursor_in_pcm_frames(&realVoice.Sound, &cursorFrame) == MA_SUCCESS)
+                voice.CursorFrame = static_cast<double>(cursorFrame);
+
+            DetachRealVoice(realVoice);
+            voice.RealVoiceIndex = -1;
+            ++state.Statistics.DemotionCount;
+        }
+
+        bool PromoteVoice(AudioEngineState& state, uint32_t virtualVoiceIndex, int32_t realVoiceIndex)
+        {
+            VirtualVoice& voice = state.VirtualVoices[virtualVoiceIndex];
+            RealVoice& realVoice = state.RealVoices[static_cast<size_t>(realVoiceIndex)];
+            if (!BindRealVoice(realVoice, voice.Sound, &state.Engine, GetBusNode(state, voice.Bus),
+                               EvaluateEffectiveVolume(state, virtualVoiceIndex), voice.Loop,
+                               static_cast<uint64_t>(voice.CursorFrame), state.Statistics.ConverterHeapGrowthCount))
+                return false;
+
+            realVoice.VirtualVoiceIndex = static_cast<int32_t>(virtualVoiceIndex);
+            voice.RealVoiceIndex = realVoiceIndex;
+            ApplyRealVoiceMix(state, virtualVoiceIndex);
+            ++state.Statistics.PromotionCount;
+            return true;
+        }
+
+        /// 真实 voice 都按引擎格式初始化，任意一个空闲的都能用。
+        int32_t FindFreeRealVoice(const AudioEngineState& state)
+        {
+            for (size_t index = 0; index < state.RealVoices.size(); ++index)
             {
-                if (!state.Voices[index].InUse)
-                    return static_cast<int>(index);
+                if (state.RealVoices[index].VirtualVoiceIndex < 0)
+                    return static_cast<int32_t>(index);
             }
+            return -1;
+        }
 
-            if (!allowEvictOneShot)
-                return -1;
+        /// 流式资产没有空闲解码器时先在后台打开一个，voice 保持虚拟，等之后的 Update 再提升，
+        /// 主线程上不打开文件。之前打开失败过则照常提升，由 PromoteVoice 报错。
+        bool IsReadyToPromote(AudioEngineState& state, const VirtualVoice& voice)
+        {
+            SoundAsset& soundAsset = *voice.Sound;
+            if (!soundAsset.IsStreaming() || soundAsset.GetIdleStreamDecoderCount() > 0)
+                return true;
+            if (!soundAsset.PrewarmStreamDecoders(1) || soundAsset.GetIdleStreamDecoderCount() > 0)
+                return true;
+            ++state.Statistics.StreamDecoderWaitCount;
+            return false;
+        }
+
+        void FreeVirtualVoice(AudioEngineState& state, uint32_t index)
+        {
+            VirtualVoice& voice = state.VirtualVoices[index];
+            if (!voice.InUse)
+                return;
+
+            if (voice.RealVoiceIndex >= 0)
+                DetachRealVoice(state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)]);
+
+            const uint16_t nextGeneration = static_cast<uint16_t>(voice.Generation + 1);
+            voice = VirtualVoice{};
+            voice.Generation = nextGeneration == 0 ? 1 : nextGeneration;
+            state.FreeVirtualVoiceIndices.push_back(index);
+        }
 
-            // 超限：挤掉最旧的未保护 OneShot（数组序近似）
-            for (size_t index = 0; index < state.Voices.size(); ++index)
+        /// 立即尝试给 voice 分配真实 voice：有空闲直接用，否则挤掉比它更不重要的一个。
+        bool TryAssignRealVoice(AudioEngineState& state, uint32_t virtualVoiceIndex)
+        {
+            VirtualVoice& voice = state.VirtualVoices[virtualVoiceIndex];
+            if (voice.Paused || voice.RealVoiceIndex >= 0)
+                return true;
+
+            // 单个声源的衰减只在这里现算一次，其余声源沿用上一次 Update 的整批结果。
+            EvaluateSpatialAttenuationScalar(state.Emitters, state.Listener, virtualVoiceIndex, virtualVoiceIndex + 1);
+            voice.Audibility = EvaluateAudibility(state, virtualVoiceIndex);
+            if (voice.Audibility <= MinimumAudibleVolume || !IsReadyToPromote(state, voice))
+                return true;
+
+            int32_t realVoiceIndex = FindFreeRealVoice(state);
+            if (realVoiceIndex < 0)
             {
-                auto& slot = state.Voices[index];
-                if (slot.InUse && slot.IsOneShot && !slot.ProtectFromEviction)
+                VirtualVoice* weakestVoice = nullptr;
+                for (RealVoice& realVoice : state.RealVoices)
                 {
-                    UninitializeVoiceSlot(slot);
-                    return static_cast<int>(index);
+                    const uint32_t candidateIndex = static_cast<uint32_t>(realVoice.VirtualVoiceIndex);
+                    VirtualVoice& candidate = state.VirtualVoices[candidateIndex];
+                    candidate.Audibility = EvaluateAudibility(state, candidateIndex);
+                    if (!weakestVoice || IsMoreAudible(*weakestVoice, candidate))
+                        weakestVoice = &candidate;
                 }
+                if (!weakestVoice || !IsMoreAudible(voice, *weakestVoice))
+                    return true;
+
+                realVoiceIndex = weakestVoice->RealVoiceIndex;
+                DemoteVoice(state, *weakestVoice);
             }
 
-            return -1;
+            return PromoteVoice(state, virtualVoiceIndex, realVoiceIndex);
         }
 
-        AudioVoiceHandle IndexToHandle(int index)
+        AudioVoiceHandle StartVoice(AudioEngineState& state, const Ref<SoundAsset>& soundAsset, float volume,
+                                    bool loop, bool isOneShot, bool protectFromEviction, int32_t priority,
+                                    const AudioSpatialSettings& spatialSettings, const glm::vec3& position,
+                                    AudioBus bus)
         {
-            if (index < 0)
+            if (!soundAsset || !soundAsset->IsValid())
                 return AudioEngine::InvalidVoiceHandle;
-            return static_cast<AudioVoiceHandle>(index + 1);
+
+            if (state.FreeVirtualVoiceIndices.empty())
+            {
+                HIMII_CORE_WARNING("AudioEngine: no free virtual voice (limit {0})",
+                                   AudioEngine::MaximumVirtualVoiceCount);
+                return AudioEngine::InvalidVoiceHandle;
+            }
+
+            const uint32_t index = state.FreeVirtualVoiceIndices.back();
+            state.FreeVirtualVoiceIndices.pop_back();
+
+            VirtualVoice& voice = state.VirtualVoices[index];
+            voice.InUse = true;
+            voice.IsOneShot = isOneShot;
+            voice.Loop = loop;
+            voice.ProtectFromEviction = protectFromEviction;
+            voice.Priority = priority;
+            voice.Volume = ClampVolume(volume);
+            voice.Sound = soundAsset;
+            voice.Bus = bus;
+            voice.StartSequence = state.NextStartSequence++;
+            WriteSpatialSettings(state, index, spatialSettings);
+            WriteEmitterPosition(state, index, position);
+
+            if (!TryAssignRealVoice(state, index))
+            {
+                HIMII_CORE_WARNING("AudioEngine: failed to start voice");
+                FreeVirtualVoice(state, index);
+                return AudioEngine::InvalidVoiceHandle;
+            }
+            return ToVoiceHandle(state, index);
         }
 
-        int HandleToIndex(AudioVoiceHandle handle)
+        /// 按经过的时间推进虚拟 voice 的游标；非循环 voice 播完返回 false。
+        bool AdvanceVirtualCursor(VirtualVoice& voice, float deltaSeconds)
         {
-            if (handle == AudioEngine::InvalidVoiceHandle)
-                return -1;
-            return static_cast<int>(handle) - 1;
+            const double frameCount = static_cast<double>(voice.Sound->GetFrameCount());
+            voice.CursorFrame += static_cast<double>(deltaSeconds) * voice.Sound->GetSampleRate();
+            if (voice.CursorFrame < frameCount)
+                return true;
+            if (!voice.Loop)
+                return false;
+            voice.CursorFrame = std::fmod(voice.CursorFrame, frameCount);
+            return true;
+        }
+
+        bool InitializeState(AudioEngineState& state, bool headless)
+        {
+            ma_engine_config engineConfig = ma_engine_config_init();
+            if (headless)
+            {
+                // 无设备：由调用方用 ma_engine_read_pcm_frames 拉取混音，输出只取决于输入。
+                engineConfig.noDevice = MA_TRUE;
+                engineConfig.channels = AudioEngine::OfflineChannelCount;
+                engineConfig.sampleRate = AudioEngine::OfflineSampleRate;
+            }
+            if (ma_engine_init(&engineConfig, &state.Engine) != MA_SUCCESS)
+            {
+                HIMII_CORE_ERROR("AudioEngine: failed to initialize miniaudio engine");
+                return false;
+            }
+
+            // Master 接 endpoint，其余总线汇入 Master。
+            const uint32_t engineChannelCount = ma_engine_get_channels(&state.Engine);
+            const uint32_t engineSampleRate = ma_engine_get_sample_rate(&state.Engine);
+            for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+            {
+                AudioBusNode& busNode = state.Buses[static_cast<size_t>(busIndex)];
+                ma_node* outputNode =
+                    busIndex == static_cast<int>(AudioBus::Master) ? ma_engine_get_endpoint(&state.Engine)
+                                                                   : GetBusNode(state, AudioBus::Master);
+                if (!busNode.Init(ma_engine_get_node_graph(&state.Engine), engineChannelCount, engineSampleRate)
+                    || !busNode.AttachTo(outputNode))
+                {
+                    HIMII_CORE_ERROR("AudioEngine: failed to create mixer bus '{0}'",
+                                     GetAudioBusName(static_cast<AudioBus>(busIndex)));
+                    for (AudioBusNode& createdBusNode : state.Buses)
+                        createdBusNode.Uninit();
+                    ma_engine_uninit(&state.Engine);
+                    return false;
+                }
+            }
+            ApplyMixerSettings(state);
+
+            state.VirtualVoices.assign(AudioEngine::MaximumVirtualVoiceCount, VirtualVoice{});
+            state.FreeVirtualVoiceIndices.clear();
+            state.FreeVirtualVoiceIndices.reserve(AudioEngine::MaximumVirtualVoiceCount);
+            for (uint32_t index = AudioEngine::MaximumVirtualVoiceCount; index > 0; --index)
+                state.FreeVirtualVoiceIndices.push_back(index - 1);
+            state.Candidates.clear();
+            state.Candidates.reserve(AudioEngine::MaximumVirtualVoiceCount);
+            state.Emitters.Resize(AudioEngine::MaximumVirtualVoiceCount);
+            state.Listener = ListenerFrame{};
+            state.Statistics = AudioVoiceStatistics{};
+
+            // 按引擎输出格式预热全部真实 voice，之后任何格式的声音播放时都不再初始化 ma_sound。
+            for (RealVoice& realVoice : state.RealVoices)
+            {
+                if (!PrepareRealVoice(realVoice, &state.Engine))
+                    HIMII_CORE_WARNING("AudioEngine: failed to prewarm a real voice");
+            }
+
+            state.Initialized = true;
+            state.Offline = headless;
+            HIMII_CORE_INFO("AudioEngine: initialized ({0} real / {1} virtual voices, {2} Hz)",
+                            AudioEngine::MaximumRealVoiceCount, AudioEngine::MaximumVirtualVoiceCount,
+                            engineSampleRate);
+            return true;
         }
     }
 
@@ -147,15 +736,7 @@ namespace Himii
         if (state.Initialized)
             return;
 
-        ma_engine_config engineConfig = ma_engine_config_init();
-        if (ma_engine_init(&engineConfig, &state.Engine) != MA_SUCCESS)
-        {
-            HIMII_CORE_ERROR("AudioEngine: failed to initialize miniaudio engine");
-            return;
-        }
-
-        state.Initialized = true;
-        HIMII_CORE_INFO("AudioEngine: initialized (max voices {0})", MaximumVoiceCount);
+        InitializeState(state, false);
     }
 
     void AudioEngine::Shutdown()
@@ -165,164 +746,367 @@ namespace Himii
         if (!state.Initialized)
             return;
 
-        if (state.PreviewActive)
-        {
-            UninitializeVoiceSlot(state.PreviewVoice);
-            state.PreviewActive = false;
-        }
+        ReleaseRealVoice(state.PreviewVoice);
+        state.PreviewActive = false;
 
-        for (auto& slot : state.Voices)
-            UninitializeVoiceSlot(slot);
+        for (uint32_t index = 0; index < state.VirtualVoices.size(); ++index)
+            FreeVirtualVoice(state, index);
+        for (RealVoice& realVoice : state.RealVoices)
+            ReleaseRealVoice(realVoice);
+        for (AudioBusNode& busNode : state.Buses)
+            busNode.Uninit();
 
         ma_engine_uninit(&state.Engine);
+        state.VirtualVoices.clear();
+        state.FreeVirtualVoiceIndices.clear();
         state.Initialized = false;
         HIMII_CORE_INFO("AudioEngine: shutdown");
     }
 
+    bool AudioEngine::InitOffline()
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        if (state.Initialized)
+        {
+            HIMII_CORE_ERROR("AudioEngine: offline mode must be initialized before AudioEngine::Init");
+            return false;
+        }
+        return InitializeState(state, true);
+    }
+
     bool AudioEngine::IsInitialized()
     {
         return GetState().Initialized;
     }
 
-    AudioVoiceHandle AudioEngine::Play(const Ref<SoundAsset>& soundAsset, float volume, bool loop,
-                                       bool protectFromEviction)
+    bool AudioEngine::ReadOfflineFrames(float* outSamples, uint32_t frameCount)
+    {
+        auto& state = GetState();
+        {
+            std::lock_guard<std::mutex> lock(state.Mutex);
+            if (!state.Initialized || !state.Offline)
+                return false;
+        }
+
+        // 与设备回调一样不持有 state.Mutex，混音期间主线程接口照常可用。
+        ma_uint64 framesRead = 0;
+        ma_engine_read_pcm_frames(&state.Engine, outSamples, frameCount, &framesRead);
+        return framesRead == frameCount;
+    }
+
+    void AudioEngine::Update(float deltaSeconds)
     {
+        HIMII_PROFILE_FUNCTION();
+
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
         if (!state.Initialized)
-            return InvalidVoiceHandle;
+            return;
 
-        const int voiceIndex = FindFreeVoiceIndex(state, true);
-        if (voiceIndex < 0)
+        state.Statistics.PromotionCount = 0;
+        state.Statistics.DemotionCount = 0;
+        state.Candidates.clear();
+
+        // 对全部槽位整批计算，空闲槽位的结果不会被读取；比逐个筛选空间化 voice 更利于向量化。
+        EvaluateSpatialAttenuation(state.Emitters, state.Listener, state.VirtualVoices.size());
+
+        for (uint32_t index = 0; index < state.VirtualVoices.size(); ++index)
         {
-            HIMII_CORE_WARNING("AudioEngine: no free voice for Play");
-            return InvalidVoiceHandle;
+            VirtualVoice& voice = state.VirtualVoices[index];
+            if (!voice.InUse)
+                continue;
+
+            if (voice.RealVoiceIndex >= 0)
+            {
+                RealVoice& realVoice = state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)];
+                if (!voice.Loop && ma_sound_at_end(&realVoice.Sound))
+                {
+                    FreeVirtualVoice(state, index);
+                    continue;
+                }
+            }
+            else if (!voice.Paused && !AdvanceVirtualCursor(voice, deltaSeconds))
+            {
+                FreeVirtualVoice(state, index);
+                continue;
+            }
+
+            if (voice.Paused)
+                continue;
+
+            voice.Audibility = EvaluateAudibility(state, index);
+            if (voice.Audibility > MinimumAudibleVolume)
+                state.Candidates.push_back(index);
+            else
+                DemoteVoice(state, voice);
         }
 
-        VoiceSlot& slot = state.Voices[static_cast<size_t>(voiceIndex)];
-        if (!InitializeVoiceFromSoundAsset(slot, soundAsset, volume, loop, &state.Engine))
+        // 只需要知道前 N 名是谁，不需要完整排序。
+        const size_t realVoiceCount = std::min<size_t>(state.Candidates.size(), MaximumRealVoiceCount);
+        const auto isMoreAudible = [&state](uint32_t left, uint32_t right)
+        { return IsMoreAudible(state.VirtualVoices[left], state.VirtualVoices[right]); };
+        if (state.Candidates.size() > realVoiceCount)
+            std::nth_element(state.Candidates.begin(), state.Candidates.begin() + realVoiceCount,
+                             state.Candidates.end(), isMoreAudible);
+
+        // 先降级再提升，保证提升时有空闲的真实 voice。
+        for (size_t rank = realVoiceCount; rank < state.Candidates.size(); ++rank)
+            DemoteVoice(state, state.VirtualVoices[state.Candidates[rank]]);
+
+        for (size_t rank = 0; rank < realVoiceCount; ++rank)
         {
-            HIMII_CORE_WARNING("AudioEngine: failed to start voice");
-            return InvalidVoiceHandle;
+            const uint32_t index = state.Candidates[rank];
+            VirtualVoice& voice = state.VirtualVoices[index];
+            if (voice.RealVoiceIndex >= 0 || !IsReadyToPromote(state, voice))
+                continue;
+
+            const int32_t realVoiceIndex = FindFreeRealVoice(state);
+            if (realVoiceIndex < 0 || !PromoteVoice(state, index, realVoiceIndex))
+            {
+                HIMII_CORE_WARNING("AudioEngine: failed to promote voice '{0}'",
+                                   voice.Sound->GetFilePath().filename().string());
+                FreeVirtualVoice(state, index);
+            }
         }
 
-        slot.IsOneShot = false;
-        slot.ProtectFromEviction = protectFromEviction || loop;
-        return IndexToHandle(voiceIndex);
+        for (const RealVoice& realVoice : state.RealVoices)
+        {
+            if (realVoice.VirtualVoiceIndex >= 0)
+                ApplyRealVoiceMix(state, static_cast<uint32_t>(realVoice.VirtualVoiceIndex));
+        }
     }
 
-    AudioVoiceHandle AudioEngine::PlayOneShot(const Ref<SoundAsset>& soundAsset, float volume)
+    AudioVoiceHandle AudioEngine::Play(const Ref<SoundAsset>& soundAsset, float volume, bool loop,
+                                       bool protectFromEviction, int32_t priority,
+                                       const AudioSpatialSettings& spatialSettings, const glm::vec3& position,
+                                       AudioBus bus)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
         if (!state.Initialized)
             return InvalidVoiceHandle;
 
-        const int voiceIndex = FindFreeVoiceIndex(state, true);
-        if (voiceIndex < 0)
-        {
-            HIMII_CORE_WARNING("AudioEngine: no free voice for PlayOneShot (limit {0})", MaximumVoiceCount);
-            return InvalidVoiceHandle;
-        }
+        return StartVoice(state, soundAsset, volume, loop, false, protectFromEviction || loop, priority,
+                          spatialSettings, position, bus);
+    }
 
-        VoiceSlot& slot = state.Voices[static_cast<size_t>(voiceIndex)];
-        if (!InitializeVoiceFromSoundAsset(slot, soundAsset, volume, false, &state.Engine))
+    AudioVoiceHandle AudioEngine::PlayOneShot(const Ref<SoundAsset>& soundAsset, float volume, int32_t priority,
+                                              const AudioSpatialSettings& spatialSettings, const glm::vec3& position,
+                                              AudioBus bus)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        if (!state.Initialized)
             return InvalidVoiceHandle;
 
-        slot.IsOneShot = true;
-        slot.ProtectFromEviction = false;
-        return IndexToHandle(voiceIndex);
+        return StartVoice(state, soundAsset, volume, false, true, false, priority, spatialSettings, position, bus);
     }
 
     void AudioEngine::Stop(AudioVoiceHandle voiceHandle)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        const int index = HandleToIndex(voiceHandle);
-        if (index < 0 || index >= static_cast<int>(state.Voices.size()))
-            return;
-        UninitializeVoiceSlot(state.Voices[static_cast<size_t>(index)]);
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index >= 0)
+            FreeVirtualVoice(state, static_cast<uint32_t>(index));
     }
 
     void AudioEngine::Pause(AudioVoiceHandle voiceHandle)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        const int index = HandleToIndex(voiceHandle);
-        if (index < 0 || index >= static_cast<int>(state.Voices.size()))
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index < 0)
             return;
-        auto& slot = state.Voices[static_cast<size_t>(index)];
-        if (slot.InUse)
-            ma_sound_stop(&slot.Sound);
+
+        // 暂停的 voice 只保留游标，把真实 voice 让给别人。
+        VirtualVoice& voice = state.VirtualVoices[static_cast<size_t>(index)];
+        voice.Paused = true;
+        DemoteVoice(state, voice);
     }
 
     void AudioEngine::Resume(AudioVoiceHandle voiceHandle)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        const int index = HandleToIndex(voiceHandle);
-        if (index < 0 || index >= static_cast<int>(state.Voices.size()))
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index < 0)
             return;
-        auto& slot = state.Voices[static_cast<size_t>(index)];
-        if (slot.InUse)
-            ma_sound_start(&slot.Sound);
+
+        state.VirtualVoices[static_cast<size_t>(index)].Paused = false;
+        if (!TryAssignRealVoice(state, static_cast<uint32_t>(index)))
+            FreeVirtualVoice(state, static_cast<uint32_t>(index));
     }
 
     void AudioEngine::SetVolume(AudioVoiceHandle voiceHandle, float volume)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        const int index = HandleToIndex(voiceHandle);
-        if (index < 0 || index >= static_cast<int>(state.Voices.size()))
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index < 0)
             return;
-        auto& slot = state.Voices[static_cast<size_t>(index)];
-        if (slot.InUse)
-            ma_sound_set_volume(&slot.Sound, volume);
+
+        VirtualVoice& voice = state.VirtualVoices[static_cast<size_t>(index)];
+        voice.Volume = ClampVolume(volume);
+        if (voice.RealVoiceIndex >= 0)
+            ApplyRealVoiceMix(state, static_cast<uint32_t>(index));
+    }
+
+    void AudioEngine::SetPriority(AudioVoiceHandle voiceHandle, int32_t priority)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index >= 0)
+            state.VirtualVoices[static_cast<size_t>(index)].Priority = priority;
+    }
+
+    void AudioEngine::SetSpatialSettings(AudioVoiceHandle voiceHandle, const AudioSpatialSettings& spatialSettings)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index >= 0)
+            WriteSpatialSettings(state, static_cast<uint32_t>(index), spatialSettings);
+    }
+
+    void AudioEngine::SetBus(AudioVoiceHandle voiceHandle, AudioBus bus)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index < 0)
+            return;
+
+        VirtualVoice& voice = state.VirtualVoices[static_cast<size_t>(index)];
+        voice.Bus = bus;
+        if (voice.RealVoiceIndex < 0)
+            return;
+
+        // 播放中直接改接，miniaudio 节点图允许在音频线程运行时重连。
+        RealVoice& realVoice = state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)];
+        ma_node* busNode = GetBusNode(state, bus);
+        if (realVoice.AttachedOutput != busNode
+            && ma_node_attach_output_bus(&realVoice.Sound, 0, busNode, 0) == MA_SUCCESS)
+            realVoice.AttachedOutput = busNode;
+    }
+
+    void AudioEngine::SetVoicePositions(const AudioVoiceHandle* voiceHandles, const glm::vec3* positions,
+                                        uint32_t count)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        for (uint32_t entryIndex = 0; entryIndex < count; ++entryIndex)
+        {
+            const int32_t index = ResolveVoiceIndex(state, voiceHandles[entryIndex]);
+            if (index >= 0)
+                WriteEmitterPosition(state, static_cast<uint32_t>(index), positions[entryIndex]);
+        }
+    }
+
+    void AudioEngine::SetListener(const AudioListener& listener)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        state.Listener = BuildListenerFrame(listener);
     }
 
     bool AudioEngine::IsPlaying(AudioVoiceHandle voiceHandle)
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        const int index = HandleToIndex(voiceHandle);
-        if (index < 0 || index >= static_cast<int>(state.Voices.size()))
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        return index >= 0 && !state.VirtualVoices[static_cast<size_t>(index)].Paused;
+    }
+
+    bool AudioEngine::GetVoiceInfo(AudioVoiceHandle voiceHandle, AudioVoiceInfo& outInfo)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        const int32_t index = ResolveVoiceIndex(state, voiceHandle);
+        if (index < 0)
             return false;
-        auto& slot = state.Voices[static_cast<size_t>(index)];
-        return slot.InUse && ma_sound_is_playing(&slot.Sound);
+
+        const VirtualVoice& voice = state.VirtualVoices[static_cast<size_t>(index)];
+        outInfo = AudioVoiceInfo{};
+        outInfo.Real = voice.RealVoiceIndex >= 0;
+        outInfo.CursorFrame = static_cast<uint64_t>(voice.CursorFrame);
+        outInfo.SpatialGain = state.Emitters.Gain[static_cast<size_t>(index)];
+        outInfo.SpatialPan = state.Emitters.Pan[static_cast<size_t>(index)];
+        if (outInfo.Real)
+        {
+            // 真实 voice 的游标由混音推进，比 Update 中记录的虚拟游标更新。
+            RealVoice& realVoice = state.RealVoices[static_cast<size_t>(voice.RealVoiceIndex)];
+            ma_uint64 cursorFrame = 0;
+            ma_sound_get_cursor_in_pcm_frames(&realVoice.Sound, &cursorFrame);
+            outInfo.CursorFrame = cursorFrame;
+            outInfo.RealVolume = ma_sound_get_volume(&realVoice.Sound);
+        }
+        return true;
     }
 
     void AudioEngine::StopAll()
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        for (auto& slot : state.Voices)
-            UninitializeVoiceSlot(slot);
+        for (uint32_t index = 0; index < state.VirtualVoices.size(); ++index)
+            FreeVirtualVoice(state, index);
         if (state.PreviewActive)
         {
-            UninitializeVoiceSlot(state.PreviewVoice);
+            DetachRealVoice(state.PreviewVoice);
             state.PreviewActive = false;
         }
     }
 
-    void AudioEngine::Preview(const Ref<SoundAsset>& soundAsset, float volume)
+    AudioVoiceStatistics AudioEngine::GetVoiceStatistics()
     {
         auto& state = GetState();
         std::lock_guard<std::mutex> lock(state.Mutex);
-        if (!state.Initialized)
-            return;
+        AudioVoiceStatistics statistics = state.Statistics;
+        statistics.ActiveVoiceCount =
+            static_cast<uint32_t>(state.VirtualVoices.size() - state.FreeVirtualVoiceIndices.size());
+        statistics.RealVoiceCount = static_cast<uint32_t>(
+            std::count_if(state.RealVoices.begin(), state.RealVoices.end(),
+                          [](const RealVoice& realVoice) { return realVoice.VirtualVoiceIndex >= 0; }));
+        return statistics;
+    }
 
-        if (state.PreviewActive)
-        {
-            UninitializeVoiceSlot(state.PreviewVoice);
-            state.PreviewActive = false;
-        }
+    void AudioEngine::SetMixerSettings(const AudioMixerSettings& mixerSettings)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        state.MixerSettings = mixerSettings;
+        if (state.Initialized)
+            ApplyMixerSettings(state);
+    }
+
+    AudioMixerSettings AudioEngine::GetMixerSettings()
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        return state.MixerSettings;
+    }
 
-        if (!InitializeVoiceFromSoundAsset(state.PreviewVoice, soundAsset, volume, false, &state.Engine))
+    AudioBusStatistics AudioEngine::GetBusStatistics(AudioBus bus)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        if (!state.Initialized)
+            return {};
+        return state.Buses[static_cast<size_t>(bus)].GetStatistics();
+    }
+
+    void AudioEngine::Preview(const Ref<SoundAsset>& soundAsset, float volume)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        if (!state.Initialized)
             return;
 
-        state.PreviewVoice.IsOneShot = true;
-        state.PreviewVoice.ProtectFromEviction = false;
-        state.PreviewActive = true;
+        state.PreviewActive =
+            BindRealVoice(state.PreviewVoice, soundAsset, &state.Engine, GetBusNode(state, AudioBus::Master), volume,
+                          false, 0, state.Statistics.ConverterHeapGrowthCount);
     }
 
     void AudioEngine::SetPreviewVolume(float volume)
@@ -340,7 +1124,37 @@ namespace Himii
         std::lock_guard<std::mutex> lock(state.Mutex);
         if (!state.PreviewActive)
             return;
-        UninitializeVoiceSlot(state.PreviewVoice);
+        DetachRealVoice(state.PreviewVoice);
         state.PreviewActive = false;
     }
+
+    bool AudioEngine::RenderSoundOffline(const Ref<SoundAsset>& soundAsset, bool loop, uint64_t startFrame,
+                                         uint64_t frameCount, std::vector<float>& outSamples)
+    {
+        ma_engine_config engineConfig = ma_engine_config_init();
+        engineConfig.noDevice = MA_TRUE;
+        engineConfig.channels = soundAsset->GetChannelCount();
+        engineConfig.sampleRate = soundAsset->GetSampleRate();
+
+        ma_engine engine;
+        if (ma_engine_init(&engineConfig, &engine) != MA_SUCCESS)
+            return false;
+
+        RealVoice voice;
+        uint32_t heapGrowthCount = 0;
+        if (!BindRealVoice(voice, soundAsset, &engine, nullptr, 1.0f, loop, startFrame, heapGrowthCount))
+        {
+            ReleaseRealVoice(voice);
+            ma_engine_uninit(&engine);
+            return false;
+        }
+
+        outSamples.assign(static_cast<size_t>(frameCount) * engineConfig.channels, 0.0f);
+        ma_uint64 framesRead = 0;
+        ma_engine_read_pcm_frames(&engine, outSamples.data(), frameCount, &framesRead);
+
+        ReleaseRealVoice(voice);
+        ma_engine_uninit(&engine);
+        return framesRead == frameCount;
+    }
 }
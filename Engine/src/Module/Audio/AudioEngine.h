@@ -2,42 +2,160 @@
 
 #include "EngineCore/Core/Core.h"
 #include "Module/Audio/SoundAsset.h"
+#include "Project/AudioMixerSettings.h"
+
+#include "glm/glm.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace Himii
 {
-    /// 运行时 voice 句柄；0 表示无效。
+    /// 运行时 voice 句柄；0 表示无效。高 16 位为代数，槽位复用后旧句柄自动失效。
     using AudioVoiceHandle = uint32_t;
 
+    enum class AudioAttenuationModel : uint8_t
+    {
+        /// MinDistance / (MinDistance + Rolloff * (d - MinDistance))。
+        Inverse = 0,
+        /// 从 MinDistance 到 MaxDistance 线性降到 1 - Rolloff。
+        Linear = 1
+    };
+
+    /// 声源的空间化参数；超出 MaxDistance 的声源视为听不到，不占用真实 voice。
+    struct AudioSpatialSettings
+    {
+        bool Enabled = false;
+        AudioAttenuationModel AttenuationModel = AudioAttenuationModel::Inverse;
+        float MinDistance = 1.0f;
+        float MaxDistance = 50.0f;
+        float Rolloff = 1.0f;
+    };
+
+    struct AudioListener
+    {
+        glm::vec3 Position{0.0f};
+        glm::vec3 Forward{0.0f, 0.0f, -1.0f};
+        glm::vec3 Up{0.0f, 1.0f, 0.0f};
+        /// 2D 场景只按 XY 平面距离衰减，忽略相机与声源的 Z 差。
+        bool Planar = false;
+    };
+
+    struct AudioVoiceStatistics
+    {
+        /// 正在播放（含虚拟）的 voice 数。
+        uint32_t ActiveVoiceCount = 0;
+        /// 当前映射到混音器真实 voice 的数量。
+        uint32_t RealVoiceCount = 0;
+        /// 上一次 Update 中提升 / 降级的次数。
+        uint32_t PromotionCount = 0;
+        uint32_t DemotionCount = 0;
+        /// 绑定时转换器预留的堆不够而扩容的累计次数。
+        uint32_t ConverterHeapGrowthCount = 0;
+        /// 流式 voice 因解码器尚在后台打开而推迟提升的累计次数。
+        uint32_t StreamDecoderWaitCount = 0;
+    };
+
+    /// 单个 voice 的调度与空间化状态，供调试与自检读取。
+    struct AudioVoiceInfo
+    {
+        /// 当前映射到混音器真实 voice。
+        bool Real = false;
+        /// 播放游标，以声音自身采样率下的帧计。
+        uint64_t CursorFrame = 0;
+        /// 真实 voice 上生效的音量（含距离衰减）；虚拟时为 0。
+        float RealVolume = 0.0f;
+        /// 最近一次 Update 算出的距离衰减与声像（-1 左、1 右）。
+        float SpatialGain = 1.0f;
+        float SpatialPan = 0.0f;
+    };
+
+    struct AudioBusStatistics
+    {
+        /// 最近一个混音块的输出峰值（线性）。
+        float PeakLevel = 0.0f;
+        /// 当前闪避增益与限幅增益，1 表示未压低。
+        float DuckGain = 1.0f;
+        float LimiterGain = 1.0f;
+        /// 本总线自身 DSP 的累计耗时，不含上游 voice 与子总线的混音。
+        double ProcessMicroseconds = 0.0;
+        uint64_t ProcessedBlockCount = 0;
+        uint64_t ProcessedFrameCount = 0;
+    };
+
+    /// 播放请求先落在虚拟 voice 上（只记录音量、优先级与播放游标），
+    /// 每帧 Update 把最值得听到的 MaximumRealVoiceCount 个映射到预先初始化的真实 voice，其余静默推进游标。
     class AudioEngine
     {
     public:
-        static constexpr uint32_t MaximumVoiceCount = 32;
+        static constexpr uint32_t MaximumRealVoiceCount = 32;
+        static constexpr uint32_t MaximumVirtualVoiceCount = 1024;
         static constexpr AudioVoiceHandle InvalidVoiceHandle = 0;
+        /// 优先级越高越先占用真实 voice；同优先级按音量比较。
+        static constexpr int32_t DefaultVoicePriority = 128;
+        /// 无设备模式的混音输出格式。
+        static constexpr uint32_t OfflineChannelCount = 2;
+        static constexpr uint32_t OfflineSampleRate = 48000;
 
         static void Init();
         static void Shutdown();
+        /// 以无设备模式初始化：不打开音频设备，混音由调用方经 ReadOfflineFrames 拉取，输出只取决于输入。
+        /// 引擎已初始化时返回 false；同样以 Shutdown 释放。
+        static bool InitOffline();
         static bool IsInitialized();
+        /// 无设备模式下混音 frameCount 帧交错 float（OfflineChannelCount 声道）；不推进 Update。
+        static bool ReadOfflineFrames(float* outSamples, uint32_t frameCount);
+
+        /// 每帧推进虚拟 voice 游标、回收播完的 voice，并重新分配真实 voice。
+        static void Update(float deltaSeconds);
 
         /// 绑定到 SoundPlayer 的主轨：可 Stop/Pause；Loop 的主轨尽量不被 OneShot 挤掉。
         static AudioVoiceHandle Play(const Ref<SoundAsset>& soundAsset, float volume, bool loop,
-                                     bool protectFromEviction = true);
-        static AudioVoiceHandle PlayOneShot(const Ref<SoundAsset>& soundAsset, float volume);
+                                     bool protectFromEviction = true, int32_t priority = DefaultVoicePriority,
+                                     const AudioSpatialSettings& spatialSettings = {},
+                                     const glm::vec3& position = glm::vec3(0.0f), AudioBus bus = AudioBus::SFX);
+        static AudioVoiceHandle PlayOneShot(const Ref<SoundAsset>& soundAsset, float volume,
+                                            int32_t priority = DefaultVoicePriority,
+                                            const AudioSpatialSettings& spatialSettings = {},
+                                            const glm::vec3& position = glm::vec3(0.0f), AudioBus bus = AudioBus::SFX);
 
         static void Stop(AudioVoiceHandle voiceHandle);
         static void Pause(AudioVoiceHandle voiceHandle);
         static void Resume(AudioVoiceHandle voiceHandle);
         static void SetVolume(AudioVoiceHandle voiceHandle, float volume);
+        static void SetPriority(AudioVoiceHandle voiceHandle, int32_t priority);
+        static void SetSpatialSettings(AudioVoiceHandle voiceHandle, const AudioSpatialSettings& spatialSettings);
+        static void SetBus(AudioVoiceHandle voiceHandle, AudioBus bus);
+
+        /// 每帧一次批量写入声源位置；衰减与声像在下一次 Update 中对全部声源整批计算。
+        static void SetVoicePositions(const AudioVoiceHandle* voiceHandles, const glm::vec3* positions,
+                                      uint32_t count);
+        static void SetListener(const AudioListener& listener);
+
+        /// 虚拟 voice 也算在播放。
         static bool IsPlaying(AudioVoiceHandle voiceHandle);
+        /// 句柄已失效时返回 false。
+        static bool GetVoiceInfo(AudioVoiceHandle voiceHandle, AudioVoiceInfo& outInfo);
 
         static void StopAll();
 
-        /// 编辑器 Inspector 预览（不占用场景主轨语义）。
+        static AudioVoiceStatistics GetVoiceStatistics();
+
+        /// 总线设置在 Init 前后都可调用，重新初始化引擎时保留。
+        static void SetMixerSettings(const AudioMixerSettings& mixerSettings);
+        static AudioMixerSettings GetMixerSettings();
+        static AudioBusStatistics GetBusStatistics(AudioBus bus);
+
+        /// 编辑器 Inspector 预览（不占用场景主轨语义），直接进入 Master 总线。
         static void Preview(const Ref<SoundAsset>& soundAsset, float volume = 1.0f);
         static void SetPreviewVolume(float volume);
         static void StopPreview();
 
+        /// 不经过引擎状态，在按资产自身格式临时创建的无设备引擎上单独播放，
+        /// 从 startFrame 起渲染 frameCount 帧混音输出。
+        static bool RenderSoundOffline(const Ref<SoundAsset>& soundAsset, bool loop, uint64_t startFrame,
+                                       uint64_t frameCount, std::vector<float>& outSamples);
+
     private:
         AudioEngine() = default;
     };
@@ -20,5 +20,10 @@ namespace Himii
         {
             AudioEngine::Shutdown();
         }
+
+        void OnUpdate(Timestep timestep) override
+        {
+            AudioEngine::Update(timestep);
+        }
     };
 }
@@ -0,0 +1,105 @@
+#include "Hepch.h"
+#include "Module/Audio/AudioSpatialAttenuation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HIMII_AUDIO_SPATIAL_SSE2 1
+#else
+    #define HIMII_AUDIO_SPATIAL_SSE2 0
+#endif
+
+namespace Himii
+{
+    void EvaluateSpatialAttenuationScalar(SpatialEmitterArrays& emitters, const ListenerFrame& listener,
+                                          size_t beginIndex, size_t endIndex)
+    {
+        for (size_t index = beginIndex; index < endIndex; ++index)
+        {
+            const float deltaX = emitters.PositionX[index] - listener.Position.x;
+            const float deltaY = emitters.PositionY[index] - listener.Position.y;
+            const float deltaZ = (emitters.PositionZ[index] - listener.Position.z) * listener.DepthWeight;
+            const float distance = std::sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+
+            const float minimumDistance = emitters.MinDistance[index];
+            const float maximumDistance = emitters.MaxDistance[index];
+            const float excess = std::min(std::max(distance, minimumDistance), maximumDistance) - minimumDistance;
+            const float inverseGain = minimumDistance / (minimumDistance + emitters.Rolloff[index] * excess);
+            const float linearGain = std::max(
+                1.0f - emitters.Rolloff[index] * excess / (maximumDistance - minimumDistance), 0.0f);
+            const float gain = inverseGain + emitters.LinearBlend[index] * (linearGain - inverseGain);
+            emitters.Gain[index] = distance <= maximumDistance ? gain : 0.0f;
+
+            // 除以 max(距离, MinDistance)：贴近听者时声像平滑回到中间。
+            const float along = deltaX * listener.Right.x + deltaY * listener.Right.y + deltaZ * listener.Right.z;
+            emitters.Pan[index] = std::min(std::max(along / std::max(distance, minimumDistance), -1.0f), 1.0f);
+        }
+    }
+
+    void EvaluateSpatialAttenuation(SpatialEmitterArrays& emitters, const ListenerFrame& listener, size_t count)
+    {
+        size_t index = 0;
+#if HIMII_AUDIO_SPATIAL_SSE2
+        const __m128 listenerX = _mm_set1_ps(listener.Position.x);
+        const __m128 listenerY = _mm_set1_ps(listener.Position.y);
+        const __m128 listenerZ = _mm_set1_ps(listener.Position.z);
+        const __m128 rightX = _mm_set1_ps(listener.Right.x);
+        const __m128 rightY = _mm_set1_ps(listener.Right.y);
+        const __m128 rightZ = _mm_set1_ps(listener.Right.z);
+        const __m128 depthWeight = _mm_set1_ps(listener.DepthWeight);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m128 deltaX = _mm_sub_ps(_mm_loadu_ps(emitters.PositionX.data() + index), listenerX);
+            const __m128 deltaY = _mm_sub_ps(_mm_loadu_ps(emitters.PositionY.data() + index), listenerY);
+            const __m128 deltaZ =
+                _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(emitters.PositionZ.data() + index), listenerZ), depthWeight);
+            const __m128 distance = _mm_sqrt_ps(_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ)));
+
+            const __m128 minimumDistance = _mm_loadu_ps(emitters.MinDistance.data() + index);
+            const __m128 maximumDistance = _mm_loadu_ps(emitters.MaxDistance.data() + index);
+            const __m128 rolloff = _mm_loadu_ps(emitters.Rolloff.data() + index);
+            const __m128 excess = _mm_sub_ps(
+                _mm_min_ps(_mm_max_ps(distance, minimumDistance), maximumDistance), minimumDistance);
+            const __m128 inverseGain =
+                _mm_div_ps(minimumDistance, _mm_add_ps(minimumDistance, _mm_mul_ps(rolloff, excess)));
+            const __m128 linearGain = _mm_max_ps(
+                _mm_sub_ps(one, _mm_div_ps(_mm_mul_ps(rolloff, excess),
+                                           _mm_sub_ps(maximumDistance, minimumDistance))),
+                zero);
+            const __m128 gain = _mm_add_ps(
+                inverseGain,
+                _mm_mul_ps(_mm_loadu_ps(emitters.LinearBlend.data() + index), _mm_sub_ps(linearGain, inverseGain)));
+            _mm_storeu_ps(emitters.Gain.data() + index, _mm_and_ps(gain, _mm_cmple_ps(distance, maximumDistance)));
+
+            const __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(deltaX, rightX), _mm_mul_ps(deltaY, rightY)),
+                                            _mm_mul_ps(deltaZ, rightZ));
+            const __m128 pan = _mm_div_ps(along, _mm_max_ps(distance, minimumDistance));
+            _mm_storeu_ps(emitters.Pan.data() + index, _mm_min_ps(_mm_max_ps(pan, minusOne), one));
+        }
+#endif
+        EvaluateSpatialAttenuationScalar(emitters, listener, index, count);
+    }
+
+    ListenerFrame BuildListenerFrame(const AudioListener& listener)
+    {
+        ListenerFrame frame;
+        frame.Position = listener.Position;
+        const glm::vec3 right = glm::cross(listener.Forward, listener.Up);
+        const float rightLength = glm::length(right);
+        if (rightLength > 1.0e-6f)
+            frame.Right = right / rightLength;
+        frame.DepthWeight = listener.Planar ? 0.0f : 1.0f;
+        return frame;
+    }
+
+    bool IsSpatialAttenuationSse2Enabled()
+    {
+        return HIMII_AUDIO_SPATIAL_SSE2 != 0;
+    }
+}
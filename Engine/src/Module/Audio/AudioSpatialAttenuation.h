@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Module/Audio/AudioEngine.h"
+
+#include "glm/glm.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Himii
+{
+    /// 空间化参数按虚拟 voice 下标以 SoA 排列，Update 中对全部槽位整批计算衰减与声像。
+    struct SpatialEmitterArrays
+    {
+        std::vector<float> PositionX;
+        std::vector<float> PositionY;
+        std::vector<float> PositionZ;
+        std::vector<float> MinDistance;
+        std::vector<float> MaxDistance;
+        std::vector<float> Rolloff;
+        /// 1 为线性衰减、0 为反比衰减；两种结果按它混合，省去逐声源分支。
+        std::vector<float> LinearBlend;
+        std::vector<float> Gain;
+        std::vector<float> Pan;
+
+        void Resize(size_t count)
+        {
+            PositionX.assign(count, 0.0f);
+            PositionY.assign(count, 0.0f);
+            PositionZ.assign(count, 0.0f);
+            MinDistance.assign(count, 1.0f);
+            MaxDistance.assign(count, 2.0f);
+            Rolloff.assign(count, 1.0f);
+            LinearBlend.assign(count, 0.0f);
+            Gain.assign(count, 1.0f);
+            Pan.assign(count, 0.0f);
+        }
+    };
+
+    struct ListenerFrame
+    {
+        glm::vec3 Position{0.0f};
+        glm::vec3 Right{1.0f, 0.0f, 0.0f};
+        /// 平面模式为 0，声源与听者的 Z 差不参与距离。
+        float DepthWeight = 1.0f;
+    };
+
+    /// 计算 [beginIndex, endIndex) 内声源的距离衰减与声像，写入 Gain / Pan。
+    void EvaluateSpatialAttenuationScalar(SpatialEmitterArrays& emitters, const ListenerFrame& listener,
+                                          size_t beginIndex, size_t endIndex);
+    /// 与标量版本公式一致，SSE2 下每次处理 4 个声源，余数走标量。
+    void EvaluateSpatialAttenuation(SpatialEmitterArrays& emitters, const ListenerFrame& listener, size_t count);
+    ListenerFrame BuildListenerFrame(const AudioListener& listener);
+
+    /// 批量衰减是否走 SSE2 路径（编译期决定）。
+    bool IsSpatialAttenuationSse2Enabled();
+}
@@ -1,115 +1,370 @@
 #include "Hepch.h"
 #include "Module/Audio/SoundAsset.h"
+#include "Module/Audio/SoundStreamDecoder.h"
+#include "EngineCore/Core/JobSystem.h"
 #include "EngineCore/Core/Log.h"
 
 #include "miniaudio.h"
 
 #include <fstream>
+#include <mutex>
+
+#include <yaml-cpp/yaml.h>
 
 namespace Himii
 {
-    SoundAsset::SoundAsset(const std::filesystem::path& filePath)
+    /// 流式资产的空闲解码器：主线程取用与归还，工作线程只往里放新打开的。
+    struct SoundStreamDecoderPool
     {
-        DecodeFile(filePath);
-    }
+        std::filesystem::path FilePath;
+        std::mutex Mutex;
+        std::vector<Scope<SoundStreamDecoder>> IdleDecoders;
+        uint32_t PendingOpenCount = 0;
+        /// 打开失败过一次后不再重试，避免每帧都去碰同一个坏文件。
+        bool OpenFailed = false;
+    };
 
-    bool SoundAsset::DecodeFile(const std::filesystem::path& filePath)
+    namespace
     {
-        m_FilePath = filePath;
-        m_PulseCodeModulationSamples.clear();
-        m_FrameCount = 0;
-        m_ChannelCount = 0;
-        m_SampleRate = 0;
+        /// 同时播放同一流式资产的实例很少超过这个数，多出来的解码器归还时直接关闭。
+        constexpr uint32_t MaximumIdleStreamDecoderCount = 4;
 
-        // Read via filesystem::path so Unicode paths work on Windows (miniaudio's narrow fopen does not).
-        std::ifstream inputStream(filePath, std::ios::binary | std::ios::ate);
-        if (!inputStream)
+        Scope<SoundStreamDecoder> OpenStreamDecoderFile(const std::filesystem::path &filePath)
         {
-            HIMII_CORE_ERROR("SoundAsset: failed to open '{0}'", filePath.string());
-            return false;
+            Scope<SoundStreamDecoder> decoder = CreateScope<SoundStreamDecoder>();
+            if (!decoder->Open(filePath, ma_format_f32))
+            {
+                HIMII_CORE_ERROR("SoundAsset: failed to open stream for '{0}'", filePath.string());
+                return nullptr;
+            }
+            return decoder;
         }
 
-        const std::streamsize fileSize = inputStream.tellg();
-        if (fileSize <= 0)
+        SoundLoadMode LoadModeFromString(const std::string &value)
         {
-            HIMII_CORE_ERROR("SoundAsset: empty or unreadable file '{0}'", filePath.string());
-            return false;
+            if (value == "Decompressed")
+                return SoundLoadMode::Decompressed;
+            if (value == "Streaming")
+                return SoundLoadMode::Streaming;
+            return SoundLoadMode::Auto;
         }
 
-        inputStream.seekg(0, std::ios::beg);
-        std::vector<uint8_t> fileBytes(static_cast<size_t>(fileSize));
-        if (!inputStream.read(reinterpret_cast<char*>(fileBytes.data()), fileSize))
+        const char *LoadModeToString(SoundLoadMode loadMode)
         {
-            HIMII_CORE_ERROR("SoundAsset: failed reading bytes from '{0}'", filePath.string());
-            return false;
+            switch (loadMode)
+            {
+                case SoundLoadMode::Decompressed: return "Decompressed";
+                case SoundLoadMode::Streaming: return "Streaming";
+                default: return "Auto";
+            }
         }
 
-        ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
-        ma_decoder decoder;
-        ma_result result = ma_decoder_init_memory(fileBytes.data(), fileBytes.size(), &decoderConfig, &decoder);
-        if (result != MA_SUCCESS)
+        SoundSampleFormat SampleFormatFromString(const std::string &value)
         {
-            HIMII_CORE_ERROR("SoundAsset: failed to decode '{0}' (miniaudio result {1}: {2})", filePath.string(),
-                             static_cast<int>(result), ma_result_description(result));
-            return false;
+            if (value == "Int16")
+                return SoundSampleFormat::Int16;
+            return SoundSampleFormat::Float32;
         }
 
-        ma_uint64 frameCount = 0;
-        result = ma_decoder_get_length_in_pcm_frames(&decoder, &frameCount);
-        if (result != MA_SUCCESS || frameCount == 0)
+        const char *SampleFormatToString(SoundSampleFormat sampleFormat)
         {
-            // 部分格式无法预知长度：读到 EOF
-            std::vector<float> growableBuffer;
-            growableBuffer.reserve(48000 * 2);
-            float readBuffer[4096];
+            return sampleFormat == SoundSampleFormat::Int16 ? "Int16" : "Float32";
+        }
+
+        ma_format ToMiniaudioFormat(SoundSampleFormat sampleFormat)
+        {
+            return sampleFormat == SoundSampleFormat::Int16 ? ma_format_s16 : ma_format_f32;
+        }
+
+        /// 按解码器输出格式读完整段 PCM；长度未知的格式一直读到 EOF。
+        template<typename SampleType>
+        uint64_t ReadAllFrames(ma_decoder &decoder, uint64_t knownFrameCount, std::vector<SampleType> &outSamples)
+        {
+            const uint32_t channelCount = decoder.outputChannels;
+            if (knownFrameCount > 0)
+            {
+                outSamples.resize(static_cast<size_t>(knownFrameCount) * channelCount);
+                ma_uint64 framesRead = 0;
+                ma_decoder_read_pcm_frames(&decoder, outSamples.data(), knownFrameCount, &framesRead);
+                outSamples.resize(static_cast<size_t>(framesRead) * channelCount);
+                return framesRead;
+            }
+
+            constexpr ma_uint64 ChunkFrameCount = 4096;
+            uint64_t frameCount = 0;
             for (;;)
             {
+                outSamples.resize(static_cast<size_t>(frameCount + ChunkFrameCount) * channelCount);
                 ma_uint64 framesRead = 0;
-                result = ma_decoder_read_pcm_frames(&decoder, readBuffer,
-                                                   (sizeof(readBuffer) / sizeof(float)) / decoder.outputChannels,
-                                                   &framesRead);
-                if (framesRead == 0)
-                    break;
-                const size_t sampleCount = static_cast<size_t>(framesRead) * decoder.outputChannels;
-                growableBuffer.insert(growableBuffer.end(), readBuffer, readBuffer + sampleCount);
+                const ma_result result = ma_decoder_read_pcm_frames(
+                        &decoder, outSamples.data() + static_cast<size_t>(frameCount) * channelCount,
+                        ChunkFrameCount, &framesRead);
                 frameCount += framesRead;
-                if (result != MA_SUCCESS)
+                if (framesRead == 0 || result != MA_SUCCESS)
                     break;
             }
+            outSamples.resize(static_cast<size_t>(frameCount) * channelCount);
+            outSamples.shrink_to_fit();
+            return frameCount;
+        }
+    }
 
-            m_ChannelCount = decoder.outputChannels;
-            m_SampleRate = decoder.outputSampleRate;
-            m_FrameCount = frameCount;
-            m_PulseCodeModulationSamples = std::move(growableBuffer);
-            ma_decoder_uninit(&decoder);
+    std::filesystem::path SoundImportSerializer::GetMetaPath(const std::filesystem::path &soundFilesystemPath)
+    {
+        return soundFilesystemPath.string() + ".meta";
+    }
 
-            if (!IsValid())
-            {
-                HIMII_CORE_ERROR("SoundAsset: decoded zero frames from '{0}'", filePath.string());
+    bool SoundImportSerializer::Deserialize(const std::filesystem::path &soundFilesystemPath,
+                                            SoundImportSettings &outSettings)
+    {
+        const std::filesystem::path metaPath = GetMetaPath(soundFilesystemPath);
+        if (!std::filesystem::exists(metaPath))
+            return false;
+
+        try
+        {
+            YAML::Node data = YAML::LoadFile(metaPath.string());
+            if (!data["AssetType"] || data["AssetType"].as<std::string>() != "SoundImport")
                 return false;
-            }
+
+            if (data["LoadMode"])
+                outSettings.LoadMode = LoadModeFromString(data["LoadMode"].as<std::string>());
+            if (data["SampleFormat"])
+                outSettings.SampleFormat = SampleFormatFromString(data["SampleFormat"].as<std::string>());
+            if (data["StreamingThresholdSeconds"])
+                outSettings.StreamingThresholdSeconds = data["StreamingThresholdSeconds"].as<float>();
+            return true;
+        }
+        catch (const std::exception &exception)
+        {
+            HIMII_CORE_ERROR("Failed to read sound meta {0}: {1}", metaPath.string(), exception.what());
+            return false;
+        }
+    }
+
+    bool SoundImportSerializer::Serialize(const std::filesystem::path &soundFilesystemPath,
+                                          const SoundImportSettings &settings)
+    {
+        const std::filesystem::path metaPath = GetMetaPath(soundFilesystemPath);
+        try
+        {
+            YAML::Emitter out;
+            out << YAML::BeginMap;
+            out << YAML::Key << "AssetType" << YAML::Value << "SoundImport";
+            out << YAML::Key << "Version" << YAML::Value << 1;
+            out << YAML::Key << "LoadMode" << YAML::Value << LoadModeToString(settings.LoadMode);
+            out << YAML::Key << "SampleFormat" << YAML::Value << SampleFormatToString(settings.SampleFormat);
+            out << YAML::Key << "StreamingThresholdSeconds" << YAML::Value << settings.StreamingThresholdSeconds;
+            out << YAML::EndMap;
+
+            std::ofstream file(metaPath);
+            if (!file.is_open())
+                return false;
+            file << out.c_str();
             return true;
         }
+        catch (const std::exception &exception)
+        {
+            HIMII_CORE_ERROR("Failed to write sound meta {0}: {1}", metaPath.string(), exception.what());
+            return false;
+        }
+    }
 
-        m_ChannelCount = decoder.outputChannels;
-        m_SampleRate = decoder.outputSampleRate;
-        m_FrameCount = frameCount;
-        m_PulseCodeModulationSamples.resize(static_cast<size_t>(frameCount) * m_ChannelCount);
+    SoundAsset::SoundAsset(const std::filesystem::path &filePath)
+    {
+        SoundImportSerializer::Deserialize(filePath, m_ImportSettings);
+        Load(filePath);
+    }
 
-        ma_uint64 framesRead = 0;
-        result = ma_decoder_read_pcm_frames(&decoder, m_PulseCodeModulationSamples.data(), frameCount, &framesRead);
-        ma_decoder_uninit(&decoder);
+    SoundAsset::SoundAsset(const std::filesystem::path &filePath, const SoundImportSettings &importSettings)
+        : m_ImportSettings(importSettings)
+    {
+        Load(filePath);
+    }
 
-        if (result != MA_SUCCESS && framesRead == 0)
+    SoundAsset::SoundAsset(std::vector<float> pulseCodeModulationSamples, uint32_t channelCount, uint32_t sampleRate)
+        : m_PulseCodeModulationSamples(std::move(pulseCodeModulationSamples)), m_ChannelCount(channelCount),
+          m_SampleRate(sampleRate)
+    {
+        m_FrameCount = channelCount > 0 ? m_PulseCodeModulationSamples.size() / channelCount : 0;
+    }
+
+    const void *SoundAsset::GetResidentSampleData() const
+    {
+        if (m_IsStreaming)
+            return nullptr;
+        if (m_SampleFormat == SoundSampleFormat::Int16)
+            return m_Int16PulseCodeModulationSamples.data();
+        return m_PulseCodeModulationSamples.data();
+    }
+
+    uint64_t SoundAsset::GetResidentMemoryBytes() const
+    {
+        return m_PulseCodeModulationSamples.capacity() * sizeof(float)
+               + m_Int16PulseCodeModulationSamples.capacity() * sizeof(int16_t);
+    }
+
+    Scope<SoundStreamDecoder> SoundAsset::OpenStreamDecoder() const
+    {
+        return OpenStreamDecoderFile(m_FilePath);
+    }
+
+    uint32_t SoundAsset::GetIdleStreamDecoderCount() const
+    {
+        if (!m_StreamDecoderPool)
+            return 0;
+        std::lock_guard<std::mutex> lock(m_StreamDecoderPool->Mutex);
+        return static_cast<uint32_t>(m_StreamDecoderPool->IdleDecoders.size());
+    }
+
+    bool SoundAsset::PrewarmStreamDecoders(uint32_t count)
+    {
+        if (!m_StreamDecoderPool)
+            return false;
+
+        const bool openInBackground = JobSystem::IsInitialized();
+        uint32_t openCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_StreamDecoderPool->Mutex);
+            if (m_StreamDecoderPool->OpenFailed)
+                return false;
+            const uint32_t availableCount =
+                    static_cast<uint32_t>(m_StreamDecoderPool->IdleDecoders.size()) + m_StreamDecoderPool->PendingOpenCount;
+            if (availableCount >= count)
+                return true;
+            openCount = count - availableCount;
+            if (openInBackground)
+                m_StreamDecoderPool->PendingOpenCount += openCount;
+        }
+
+        for (uint32_t openIndex = 0; openIndex < openCount; ++openIndex)
+        {
+            const auto openDecoder = [pool = m_StreamDecoderPool](bool pending)
+            {
+                Scope<SoundStreamDecoder> decoder = OpenStreamDecoderFile(pool->FilePath);
+                std::lock_guard<std::mutex> lock(pool->Mutex);
+                if (pending)
+                    --pool->PendingOpenCount;
+                if (decoder)
+                    pool->IdleDecoders.push_back(std::move(decoder));
+                else
+                    pool->OpenFailed = true;
+            };
+            if (openInBackground)
+                JobSystem::Submit([openDecoder]() { openDecoder(true); });
+            else
+                openDecoder(false);
+        }
+        return true;
+    }
+
+    Scope<SoundStreamDecoder> SoundAsset::AcquireStreamDecoder()
+    {
+        if (!m_StreamDecoderPool)
+            return nullptr;
+
+        Scope<SoundStreamDecoder> decoder;
+        {
+            std::lock_guard<std::mutex> lock(m_StreamDecoderPool->Mutex);
+            if (!m_StreamDecoderPool->IdleDecoders.empty())
+            {
+                decoder = std::move(m_StreamDecoderPool->IdleDecoders.back());
+                m_StreamDecoderPool->IdleDecoders.pop_back();
+            }
+        }
+        if (!decoder)
+            decoder = OpenStreamDecoder();
+        PrewarmStreamDecoders(1);
+        return decoder;
+    }
+
+    void SoundAsset::ReleaseStreamDecoder(Scope<SoundStreamDecoder> decoder)
+    {
+        if (!decoder || !m_StreamDecoderPool)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_StreamDecoderPool->Mutex);
+        if (m_StreamDecoderPool->IdleDecoders.size() < MaximumIdleStreamDecoderCount)
+            m_StreamDecoderPool->IdleDecoders.push_back(std::move(decoder));
+    }
+
+    bool SoundAsset::Load(const std::filesystem::path &filePath)
+    {
+        m_FilePath = filePath;
+        m_IsStreaming = false;
+        m_SampleFormat = m_ImportSettings.SampleFormat;
+        m_PulseCodeModulationSamples.clear();
+        m_Int16PulseCodeModulationSamples.clear();
+        m_FrameCount = 0;
+        m_ChannelCount = 0;
+        m_SampleRate = 0;
+        m_StreamDecoderPool.reset();
+
+        // 只打开文件头探测格式与长度；整段解码也直接从文件流读，不再先把整个文件读进内存。
+        SoundStreamDecoder decoder;
+        if (!decoder.Open(filePath, ToMiniaudioFormat(m_SampleFormat)))
+        {
+            HIMII_CORE_ERROR("SoundAsset: failed to open or decode '{0}'", filePath.string());
+            return false;
+        }
+
+        m_ChannelCount = decoder.GetDecoder().outputChannels;
+        m_SampleRate = decoder.GetDecoder().outputSampleRate;
+
+        ma_uint64 knownFrameCount = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&decoder.GetDecoder(), &knownFrameCount) != MA_SUCCESS)
+            knownFrameCount = 0;
+
+        // 长度未知的格式无法按时长判断，Auto 时退回整段解码。
+        const double durationSeconds =
+                m_SampleRate > 0 ? static_cast<double>(knownFrameCount) / m_SampleRate : 0.0;
+        const bool stream = knownFrameCount > 0
+                            && (m_ImportSettings.LoadMode == SoundLoadMode::Streaming
+                                || (m_ImportSettings.LoadMode == SoundLoadMode::Auto
+                                    && durationSeconds > m_ImportSettings.StreamingThresholdSeconds));
+
+        if (stream)
+        {
+            // 流式播放统一输出 float，常驻格式设置只影响整段解码。
+            m_IsStreaming = true;
+            m_SampleFormat = SoundSampleFormat::Float32;
+            m_FrameCount = knownFrameCount;
+            // 加载时就备好第一个解码器，第一次播放不必在主线程上打开文件。
+            m_StreamDecoderPool = CreateRef<SoundStreamDecoderPool>();
+            m_StreamDecoderPool->FilePath = filePath;
+            PrewarmStreamDecoders(1);
+        }
+        else if (!DecodeFile(decoder))
         {
-            HIMII_CORE_ERROR("SoundAsset: failed reading PCM from '{0}'", filePath.string());
+            return false;
+        }
+
+        HIMII_CORE_TRACE("SoundAsset: '{0}' {1} {2:.1f} s, resident {3:.1f} KB (fully decoded float {4:.1f} KB)",
+                         filePath.filename().string(), m_IsStreaming ? "streaming" : SampleFormatToString(m_SampleFormat),
+                         GetDurationSeconds(), GetResidentMemoryBytes() / 1024.0,
+                         GetFullyDecodedMemoryBytes() / 1024.0);
+        return true;
+    }
+
+    bool SoundAsset::DecodeFile(SoundStreamDecoder &decoder)
+    {
+        ma_uint64 knownFrameCount = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&decoder.GetDecoder(), &knownFrameCount) != MA_SUCCESS)
+            knownFrameCount = 0;
+
+        if (m_SampleFormat == SoundSampleFormat::Int16)
+            m_FrameCount = ReadAllFrames(decoder.GetDecoder(), knownFrameCount, m_Int16PulseCodeModulationSamples);
+        else
+            m_FrameCount = ReadAllFrames(decoder.GetDecoder(), knownFrameCount, m_PulseCodeModulationSamples);
+
+        if (!IsValid())
+        {
+            HIMII_CORE_ERROR("SoundAsset: decoded zero frames from '{0}'", m_FilePath.string());
             m_PulseCodeModulationSamples.clear();
+            m_Int16PulseCodeModulationSamples.clear();
             m_FrameCount = 0;
             return false;
         }
-
-        m_FrameCount = framesRead;
-        m_PulseCodeModulationSamples.resize(static_cast<size_t>(framesRead) * m_ChannelCount);
-        return IsValid();
+        return true;
     }
 }
@@ -9,30 +9,113 @@
 
 namespace Himii
 {
+    class SoundStreamDecoder;
+    struct SoundStreamDecoderPool;
+
+    enum class SoundLoadMode : uint8_t
+    {
+        /// 时长超过 StreamingThresholdSeconds 时流式播放，否则整段解码。
+        Auto = 0,
+        Decompressed = 1,
+        Streaming = 2
+    };
+
+    enum class SoundSampleFormat : uint8_t
+    {
+        Float32 = 0,
+        /// 整段解码的音效以 16 位整数常驻，内存减半。
+        Int16 = 1
+    };
+
+    struct SoundImportSettings
+    {
+        SoundLoadMode LoadMode = SoundLoadMode::Auto;
+        SoundSampleFormat SampleFormat = SoundSampleFormat::Float32;
+        float StreamingThresholdSeconds = 10.0f;
+    };
+
+    /// 声音导入设置存放在源文件旁的 .meta 中；没有 meta 时使用默认设置。
+    class SoundImportSerializer
+    {
+    public:
+        static std::filesystem::path GetMetaPath(const std::filesystem::path &soundFilesystemPath);
+        static bool Deserialize(const std::filesystem::path &soundFilesystemPath, SoundImportSettings &outSettings);
+        static bool Serialize(const std::filesystem::path &soundFilesystemPath, const SoundImportSettings &settings);
+    };
+
     class SoundAsset : public Asset
     {
     public:
         SoundAsset() = default;
-        explicit SoundAsset(const std::filesystem::path& filePath);
+        explicit SoundAsset(const std::filesystem::path &filePath);
+        SoundAsset(const std::filesystem::path &filePath, const SoundImportSettings &importSettings);
+        /// 直接持有交错排列的 float PCM（程序生成的音效与自检用）。
+        SoundAsset(std::vector<float> pulseCodeModulationSamples, uint32_t channelCount, uint32_t sampleRate);
         ~SoundAsset() override = default;
 
         AssetType GetType() const override { return AssetType::SoundAsset; }
 
-        bool IsValid() const { return !m_PulseCodeModulationSamples.empty() && m_FrameCount > 0; }
+        bool IsValid() const
+        {
+            return m_FrameCount > 0 && (m_IsStreaming || !m_PulseCodeModulationSamples.empty()
+                                        || !m_Int16PulseCodeModulationSamples.empty());
+        }
+        /// 流式资产不常驻 PCM，每个播放实例各自打开文件解码。
+        bool IsStreaming() const { return m_IsStreaming; }
+        SoundSampleFormat GetSampleFormat() const { return m_SampleFormat; }
 
-        const std::filesystem::path& GetFilePath() const { return m_FilePath; }
-        const std::vector<float>& GetPulseCodeModulationSamples() const { return m_PulseCodeModulationSamples; }
+        const std::filesystem::path &GetFilePath() const { return m_FilePath; }
+        const SoundImportSettings &GetImportSettings() const { return m_ImportSettings; }
+        const std::vector<float> &GetPulseCodeModulationSamples() const { return m_PulseCodeModulationSamples; }
+        const std::vector<int16_t> &GetInt16PulseCodeModulationSamples() const
+        {
+            return m_Int16PulseCodeModulationSamples;
+        }
+        /// 常驻 PCM 的首地址，格式见 GetSampleFormat；流式资产返回 nullptr。
+        const void *GetResidentSampleData() const;
         uint64_t GetFrameCount() const { return m_FrameCount; }
         uint32_t GetChannelCount() const { return m_ChannelCount; }
         uint32_t GetSampleRate() const { return m_SampleRate; }
+        double GetDurationSeconds() const
+        {
+            return m_SampleRate > 0 ? static_cast<double>(m_FrameCount) / m_SampleRate : 0.0;
+        }
+
+        /// 资产自身常驻的 PCM 字节数；流式资产为 0（解码缓冲由各播放实例持有）。
+        uint64_t GetResidentMemoryBytes() const;
+        /// 整段解码为 float 时需要的字节数，用于和常驻内存对比。
+        uint64_t GetFullyDecodedMemoryBytes() const
+        {
+            return m_FrameCount * m_ChannelCount * sizeof(float);
+        }
+
+        /// 为一个播放实例打开独立的流式解码器；失败返回空。
+        Scope<SoundStreamDecoder> OpenStreamDecoder() const;
+
+        /// 流式资产预先打开、可直接交给播放实例的解码器数，不含正在后台打开的。
+        uint32_t GetIdleStreamDecoderCount() const;
+        /// 保证空闲加后台打开中的解码器不少于 count 个；JobSystem 未初始化时当场打开。
+        /// 之前打开失败过（或不是流式资产）时返回 false。
+        bool PrewarmStreamDecoders(uint32_t count);
+        /// 取一个空闲解码器并在后台补开下一个；没有空闲的才当场打开（预览与离线渲染）。
+        Scope<SoundStreamDecoder> AcquireStreamDecoder();
+        /// 播放实例用完的解码器归还复用，空闲数超过上限时直接关闭。
+        void ReleaseStreamDecoder(Scope<SoundStreamDecoder> decoder);
 
     private:
-        bool DecodeFile(const std::filesystem::path& filePath);
+        bool Load(const std::filesystem::path &filePath);
+        bool DecodeFile(SoundStreamDecoder &decoder);
 
         std::filesystem::path m_FilePath;
+        SoundImportSettings m_ImportSettings;
+        bool m_IsStreaming = false;
+        SoundSampleFormat m_SampleFormat = SoundSampleFormat::Float32;
         std::vector<float> m_PulseCodeModulationSamples;
+        std::vector<int16_t> m_Int16PulseCodeModulationSamples;
         uint64_t m_FrameCount = 0;
         uint32_t m_ChannelCount = 0;
         uint32_t m_SampleRate = 0;
+        /// 工作线程打开解码器时持有它而不是资产本身，资产先释放也安全。
+        Ref<SoundStreamDecoderPool> m_StreamDecoderPool;
     };
 }
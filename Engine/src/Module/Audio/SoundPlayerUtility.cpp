@@ -25,7 +25,7 @@ namespace Himii::SoundPlayerUtility
         component.Sound = std::dynamic_pointer_cast<SoundAsset>(assetManager->GetAsset(component.SoundHandle));
     }
 
-    void Play(SoundPlayerComponent& component)
+    void Play(SoundPlayerComponent& component, const glm::vec3& position)
     {
         ResolveSoundAsset(component);
         Stop(component);
@@ -34,7 +34,8 @@ namespace Himii::SoundPlayerUtility
             return;
 
         component.RuntimeVoiceHandle =
-                AudioEngine::Play(component.Sound, component.EvaluateEffectiveVolume(), component.Loop, true);
+                AudioEngine::Play(component.Sound, component.EvaluateEffectiveVolume(), component.Loop, true,
+                                  component.Priority, component.Spatial, position, component.Bus);
         component.RuntimePaused = false;
         // 再写一次音量，避免个别后端在 start 时忽略初始 gain。
         if (component.RuntimeVoiceHandle != AudioEngine::InvalidVoiceHandle)
@@ -67,7 +68,7 @@ namespace Himii::SoundPlayerUtility
         component.RuntimePaused = false;
     }
 
-    void PlayOneShot(SoundPlayerComponent& component, AssetHandle oneShotSoundHandle)
+    void PlayOneShot(SoundPlayerComponent& component, AssetHandle oneShotSoundHandle, const glm::vec3& position)
     {
         Ref<SoundAsset> oneShotSound = component.Sound;
         if (oneShotSoundHandle && Project::GetActive())
@@ -80,7 +81,8 @@ namespace Himii::SoundPlayerUtility
         if (!oneShotSound || !oneShotSound->IsValid())
             return;
 
-        AudioEngine::PlayOneShot(oneShotSound, component.EvaluateEffectiveVolume());
+        AudioEngine::PlayOneShot(oneShotSound, component.EvaluateEffectiveVolume(), component.Priority,
+                                 component.Spatial, position, component.Bus);
     }
 
     void ApplyVolume(SoundPlayerComponent& component)
@@ -92,6 +94,12 @@ namespace Himii::SoundPlayerUtility
         AudioEngine::SetPreviewVolume(effectiveVolume);
     }
 
+    void ApplySpatialSettings(SoundPlayerComponent& component)
+    {
+        if (component.RuntimeVoiceHandle != AudioEngine::InvalidVoiceHandle)
+            AudioEngine::SetSpatialSettings(component.RuntimeVoiceHandle, component.Spatial);
+    }
+
     void StopAllPlayersInScene(Scene* scene)
     {
         if (!scene)
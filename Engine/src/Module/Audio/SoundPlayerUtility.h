@@ -6,11 +6,14 @@
 namespace Himii::SoundPlayerUtility
 {
     void ResolveSoundAsset(SoundPlayerComponent& component);
-    void Play(SoundPlayerComponent& component);
+    /// position 为发声实体的世界位置，仅在组件启用 Spatial 时生效。
+    void Play(SoundPlayerComponent& component, const glm::vec3& position = glm::vec3(0.0f));
     void Stop(SoundPlayerComponent& component);
     void Pause(SoundPlayerComponent& component);
     void Resume(SoundPlayerComponent& component);
-    void PlayOneShot(SoundPlayerComponent& component, AssetHandle oneShotSoundHandle);
+    void PlayOneShot(SoundPlayerComponent& component, AssetHandle oneShotSoundHandle,
+                     const glm::vec3& position = glm::vec3(0.0f));
     void ApplyVolume(SoundPlayerComponent& component);
+    void ApplySpatialSettings(SoundPlayerComponent& component);
     void StopAllPlayersInScene(class Scene* scene);
 }
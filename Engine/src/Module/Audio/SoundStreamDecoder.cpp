@@ -0,0 +1,71 @@
+#include "Hepch.h"
+#include "Module/Audio/SoundStreamDecoder.h"
+
+namespace Himii
+{
+    SoundStreamDecoder::~SoundStreamDecoder()
+    {
+        Close();
+    }
+
+    bool SoundStreamDecoder::Open(const std::filesystem::path &filePath, ma_format outputFormat)
+    {
+        Close();
+
+        m_Stream.open(filePath, std::ios::binary);
+        if (!m_Stream)
+            return false;
+
+        const ma_decoder_config decoderConfig = ma_decoder_config_init(outputFormat, 0, 0);
+        if (ma_decoder_init(&SoundStreamDecoder::OnRead, &SoundStreamDecoder::OnSeek, this, &decoderConfig, &m_Decoder)
+            != MA_SUCCESS)
+        {
+            m_Stream.close();
+            return false;
+        }
+
+        m_IsOpen = true;
+        return true;
+    }
+
+    void SoundStreamDecoder::Close()
+    {
+        if (m_IsOpen)
+        {
+            ma_decoder_uninit(&m_Decoder);
+            m_IsOpen = false;
+        }
+        if (m_Stream.is_open())
+            m_Stream.close();
+    }
+
+    ma_result SoundStreamDecoder::OnRead(ma_decoder *decoder, void *bufferOut, size_t bytesToRead, size_t *bytesRead)
+    {
+        SoundStreamDecoder &streamDecoder = *static_cast<SoundStreamDecoder *>(decoder->pUserData);
+        streamDecoder.m_Stream.read(static_cast<char *>(bufferOut), static_cast<std::streamsize>(bytesToRead));
+        const size_t readCount = static_cast<size_t>(streamDecoder.m_Stream.gcount());
+        if (bytesRead)
+            *bytesRead = readCount;
+
+        // 读到文件尾会置 eof/fail，清掉以便后续 seek（循环播放）继续可用。
+        if (!streamDecoder.m_Stream)
+            streamDecoder.m_Stream.clear();
+
+        return readCount == 0 && bytesToRead > 0 ? MA_AT_END : MA_SUCCESS;
+    }
+
+    ma_result SoundStreamDecoder::OnSeek(ma_decoder *decoder, ma_int64 byteOffset, ma_seek_origin origin)
+    {
+        SoundStreamDecoder &streamDecoder = *static_cast<SoundStreamDecoder *>(decoder->pUserData);
+
+        std::ios::seekdir direction = std::ios::beg;
+        if (origin == ma_seek_origin_current)
+            direction = std::ios::cur;
+        else if (origin == ma_seek_origin_end)
+            direction = std::ios::end;
+
+        streamDecoder.m_Stream.clear();
+        streamDecoder.m_Stream.seekg(static_cast<std::streamoff>(byteOffset), direction);
+        return streamDecoder.m_Stream ? MA_SUCCESS : MA_BAD_SEEK;
+    }
+}
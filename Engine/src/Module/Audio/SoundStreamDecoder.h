@@ -0,0 +1,47 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Himii
+{
+    /// 从文件流按需解码的 miniaudio 数据源：读文件与解码都发生在拉取数据的线程上（播放时即音频线程）。
+    /// 解码器回调持有 this，打开后不能移动，由 Scope 持有；每个播放实例独占一个。
+    class SoundStreamDecoder
+    {
+    public:
+        SoundStreamDecoder() = default;
+        ~SoundStreamDecoder();
+
+        SoundStreamDecoder(const SoundStreamDecoder &) = delete;
+        SoundStreamDecoder &operator=(const SoundStreamDecoder &) = delete;
+
+        /// outputFormat 为 ma_format_unknown 时保留文件的原生样本格式。
+        bool Open(const std::filesystem::path &filePath, ma_format outputFormat);
+        void Close();
+
+        bool IsOpen() const
+        {
+            return m_IsOpen;
+        }
+        ma_decoder &GetDecoder()
+        {
+            return m_Decoder;
+        }
+        ma_data_source *GetDataSource()
+        {
+            return &m_Decoder;
+        }
+
+    private:
+        static ma_result OnRead(ma_decoder *decoder, void *bufferOut, size_t bytesToRead, size_t *bytesRead);
+        static ma_result OnSeek(ma_decoder *decoder, ma_int64 byteOffset, ma_seek_origin origin);
+
+        // 经 filesystem::path 打开，Windows 下的 Unicode 路径同样可用（miniaudio 的窄字符 fopen 不行）。
+        std::ifstream m_Stream;
+        ma_decoder m_Decoder{};
+        bool m_IsOpen = false;
+    };
+}
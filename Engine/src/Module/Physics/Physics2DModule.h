@@ -7,7 +7,7 @@ namespace Himii
 {
     class Scene;
 
-    /// World 级 2D 物理模块；注册时挂到 WorldUpdatePhase::Physics。
+    /// World 级 2D 物理模块；注册时挂到 WorldUpdatePhase::Physics，由 World 的固定步长累加器按固定步调用。
     class Physics2DModule : public IWorldModule
     {
     public:
@@ -0,0 +1,261 @@
+#include "Hepch.h"
+#include "Module/Physics/Physics2DWorld.h"
+#include "Project/Physics2DLayerSettings.h"
+
+#include "World/Scene/Components.h"
+#include "EngineCore/Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 单条命令的命中收集器，写入调用方缓冲区中属于该命令的一段槽位。
+        struct QueryHitCollector
+        {
+            const entt::registry *Registry = nullptr;
+            Physics2DQueryHit *Hits = nullptr;
+            uint32_t Capacity = 0;
+            uint32_t Count = 0;
+            bool ClosestOnly = true;
+            float Length = 0.0f;
+        };
+
+        /// 只读访问注册表：查询可能在工作线程上并发执行，不能触发组件池的惰性创建。
+        uint64_t ResolveEntityID(const entt::registry &registry, b2ShapeId shapeId)
+        {
+            void *userData = b2Shape_GetUserData(shapeId);
+            if (!userData)
+                userData = b2Body_GetUserData(b2Shape_GetBody(shapeId));
+            if (!userData)
+                return 0;
+
+            const entt::entity handle =
+                    static_cast<entt::entity>(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData)));
+            if (!registry.valid(handle))
+                return 0;
+
+            const IDComponent *idComponent = registry.try_get<IDComponent>(handle);
+            return idComponent ? static_cast<uint64_t>(idComponent->ID) : 0;
+        }
+
+        /// 查询以专用类别位出现：形状的 maskBits 都含这一位（碰撞矩阵整行为空的层也一样），
+        /// 因此只由查询的 LayerMask 与形状所在层决定筛选结果。
+        b2QueryFilter BuildLayerQueryFilter(uint32_t layerMask)
+        {
+            b2QueryFilter filter = b2DefaultQueryFilter();
+            filter.categoryBits = Physics2DQueryCategoryBit;
+            filter.maskBits = layerMask;
+            return filter;
+        }
+
+        b2ShapeProxy BuildShapeProxy(Physics2DQueryShape shape, glm::vec2 center, glm::vec2 size, float angle)
+        {
+            if (shape == Physics2DQueryShape::Circle)
+            {
+                const b2Vec2 point = {center.x, center.y};
+                return b2MakeProxy(&point, 1, std::max(size.x, 0.0f));
+            }
+
+            const float halfWidth = std::max(size.x, 0.0f);
+            const float halfHeight = std::max(size.y, 0.0f);
+            const b2Vec2 corners[4] = {
+                    {-halfWidth, -halfHeight}, {halfWidth, -halfHeight}, {halfWidth, halfHeight}, {-halfWidth, halfHeight}};
+            const float rotation = shape == Physics2DQueryShape::Box ? angle : 0.0f;
+            return b2MakeOffsetProxy(corners, 4, 0.0f, {center.x, center.y}, b2MakeRot(rotation));
+        }
+
+        /// 按 Fraction 有序插入；缓冲区已满时挤掉最远的命中。
+        float CollectCastHit(b2ShapeId shapeId, b2Vec2 point, b2Vec2 normal, float fraction, void *context)
+        {
+            QueryHitCollector &collector = *static_cast<QueryHitCollector *>(context);
+            if (collector.Count == collector.Capacity && fraction >= collector.Hits[collector.Count - 1].Fraction)
+                return collector.ClosestOnly ? collector.Hits[0].Fraction : 1.0f;
+
+            const uint64_t entityID = ResolveEntityID(*collector.Registry, shapeId);
+            if (entityID == 0)
+                return -1.0f;
+
+            if (collector.Count < collector.Capacity)
+                ++collector.Count;
+
+            uint32_t index = collector.Count - 1;
+            while (index > 0 && collector.Hits[index - 1].Fraction > fraction)
+            {
+                collector.Hits[index] = collector.Hits[index - 1];
+                --index;
+            }
+
+            Physics2DQueryHit &hit = collector.Hits[index];
+            hit.Point = {point.x, point.y};
+            hit.Normal = {normal.x, normal.y};
+            hit.Fraction = fraction;
+            hit.Distance = fraction * collector.Length;
+            hit.EntityID = entityID;
+
+            // 最近命中模式下返回 fraction 裁剪射线，后续只会报告更近的形状。
+            return collector.ClosestOnly ? fraction : 1.0f;
+        }
+
+        bool CollectOverlapHit(b2ShapeId shapeId, void *context)
+        {
+            QueryHitCollector &collector = *static_cast<QueryHitCollector *>(context);
+            const uint64_t entityID = ResolveEntityID(*collector.Registry, shapeId);
+            if (entityID == 0)
+                return true;
+
+            for (uint32_t index = 0; index < collector.Count; ++index)
+            {
+                if (collector.Hits[index].EntityID == entityID)
+                    return true;
+            }
+
+            Physics2DQueryHit &hit = collector.Hits[collector.Count++];
+            hit = Physics2DQueryHit{};
+            hit.EntityID = entityID;
+            return !collector.ClosestOnly && collector.Count < collector.Capacity;
+        }
+
+        template<typename Function>
+        void RunQueryBatch(uint32_t commandCount, const Physics2DQueryOptions &options, const Function &queryCommand)
+        {
+            if (options.Parallel)
+            {
+                JobSystem::ParallelFor(commandCount, options.BatchSize,
+                                       [&queryCommand](uint32_t beginIndex, uint32_t endIndex)
+                                       {
+                                           for (uint32_t index = beginIndex; index < endIndex; ++index)
+                                               queryCommand(index);
+                                       });
+                return;
+            }
+
+            for (uint32_t index = 0; index < commandCount; ++index)
+                queryCommand(index);
+        }
+    }
+
+    bool Physics2DWorld::PrepareQueryBatch(uint32_t commandCount, const Physics2DQueryOptions &options,
+                                           Physics2DQueryHit *hits, uint32_t *hitCounts) const
+    {
+        if (commandCount == 0 || !hitCounts)
+            return false;
+
+        std::fill_n(hitCounts, commandCount, 0u);
+        if (!hits || options.MaxHitsPerQuery == 0)
+        {
+            HIMII_CORE_WARNING("Physics2D batch query skipped: result buffer is empty");
+            return false;
+        }
+
+        return m_Scene && b2World_IsValid(m_Box2DWorld);
+    }
+
+    void Physics2DWorld::RaycastBatch(const Physics2DRaycastCommand *commands, uint32_t commandCount,
+                                      const Physics2DQueryOptions &options, Physics2DQueryHit *hits,
+                                      uint32_t *hitCounts) const
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!commands || !PrepareQueryBatch(commandCount, options, hits, hitCounts))
+            return;
+
+        const entt::registry &registry = m_Scene->Registry();
+        const bool closestOnly = options.Mode == Physics2DQueryMode::Closest;
+        RunQueryBatch(commandCount, options,
+                      [&](uint32_t index)
+                      {
+                          const Physics2DRaycastCommand &command = commands[index];
+                          const glm::vec2 translation = command.End - command.Start;
+
+                          QueryHitCollector collector;
+                          collector.Registry = &registry;
+                          collector.Hits = hits + static_cast<size_t>(index) * options.MaxHitsPerQuery;
+                          collector.Capacity = closestOnly ? 1u : options.MaxHitsPerQuery;
+                          collector.ClosestOnly = closestOnly;
+                          collector.Length = glm::length(translation);
+                          if (collector.Length <= 0.0f)
+                              return;
+
+                          b2World_CastRay(m_Box2DWorld, {command.Start.x, command.Start.y},
+                                          {translation.x, translation.y}, BuildLayerQueryFilter(command.LayerMask),
+                                          CollectCastHit, &collector);
+                          hitCounts[index] = collector.Count;
+                      });
+    }
+
+    void Physics2DWorld::ShapeCastBatch(const Physics2DShapeCastCommand *commands, uint32_t commandCount,
+                                        const Physics2DQueryOptions &options, Physics2DQueryHit *hits,
+                                        uint32_t *hitCounts) const
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!commands || !PrepareQueryBatch(commandCount, options, hits, hitCounts))
+            return;
+
+        const entt::registry &registry = m_Scene->Registry();
+        const bool closestOnly = options.Mode == Physics2DQueryMode::Closest;
+        RunQueryBatch(commandCount, options,
+                      [&](uint32_t index)
+                      {
+                          const Physics2DShapeCastCommand &command = commands[index];
+                          const glm::vec2 translation = command.End - command.Start;
+
+                          QueryHitCollector collector;
+                          collector.Registry = &registry;
+                          collector.Hits = hits + static_cast<size_t>(index) * options.MaxHitsPerQuery;
+                          collector.Capacity = closestOnly ? 1u : options.MaxHitsPerQuery;
+                          collector.ClosestOnly = closestOnly;
+                          collector.Length = glm::length(translation);
+                          if (collector.Length <= 0.0f)
+                              return;
+
+                          const b2ShapeProxy proxy =
+                                  BuildShapeProxy(command.Shape, command.Start, command.Size, command.Angle);
+                          b2World_CastShape(m_Box2DWorld, &proxy, {translation.x, translation.y},
+                                            BuildLayerQueryFilter(command.LayerMask), CollectCastHit, &collector);
+                          hitCounts[index] = collector.Count;
+                      });
+    }
+
+    void Physics2DWorld::OverlapBatch(const Physics2DOverlapCommand *commands, uint32_t commandCount,
+                                      const Physics2DQueryOptions &options, Physics2DQueryHit *hits,
+                                      uint32_t *hitCounts) const
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!commands || !PrepareQueryBatch(commandCount, options, hits, hitCounts))
+            return;
+
+        const entt::registry &registry = m_Scene->Registry();
+        const bool closestOnly = options.Mode == Physics2DQueryMode::Closest;
+        RunQueryBatch(commandCount, options,
+                      [&](uint32_t index)
+                      {
+                          const Physics2DOverlapCommand &command = commands[index];
+
+                          QueryHitCollector collector;
+                          collector.Registry = &registry;
+                          collector.Hits = hits + static_cast<size_t>(index) * options.MaxHitsPerQuery;
+                          collector.Capacity = closestOnly ? 1u : options.MaxHitsPerQuery;
+                          collector.ClosestOnly = closestOnly;
+
+                          const b2QueryFilter filter = BuildLayerQueryFilter(command.LayerMask);
+                          if (command.Shape == Physics2DQueryShape::AABB)
+                          {
+                              const glm::vec2 halfExtents = glm::max(command.Size, glm::vec2(0.0f));
+                              const b2AABB bounds = {{command.Center.x - halfExtents.x, command.Center.y - halfExtents.y},
+                                                     {command.Center.x + halfExtents.x, command.Center.y + halfExtents.y}};
+                              b2World_OverlapAABB(m_Box2DWorld, bounds, filter, CollectOverlapHit, &collector);
+                          }
+                          else
+                          {
+                              const b2ShapeProxy proxy =
+                                      BuildShapeProxy(command.Shape, command.Center, command.Size, command.Angle);
+                              b2World_OverlapShape(m_Box2DWorld, &proxy, filter, CollectOverlapHit, &collector);
+                          }
+                          hitCounts[index] = collector.Count;
+                      });
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+#include <cstdint>
+
+namespace Himii
+{
+    /// 以下结构体按值跨托管边界传递，字段顺序与 ScriptCore 中同名结构保持一致。
+
+    enum class Physics2DQueryMode : int32_t
+    {
+        /// 每条命令只保留最近的命中；重叠查询命中任意一个即停止。
+        Closest = 0,
+        /// 每条命令最多保留 MaxHitsPerQuery 个命中，投射结果按距离由近到远排列。
+        All = 1,
+    };
+
+    enum class Physics2DQueryShape : int32_t
+    {
+        /// 轴对齐包围盒；重叠查询只与形状包围盒做粗测，投射时按无旋转的矩形处理。
+        AABB = 0,
+        Circle = 1,
+        Box = 2,
+    };
+
+    /// LayerMask 的第 n 位对应 Physics2DLayerSettings 的第 n 层。
+    struct Physics2DRaycastCommand
+    {
+        glm::vec2 Start{0.0f};
+        glm::vec2 End{0.0f};
+        uint32_t LayerMask = 0xFFFFFFFFu;
+    };
+
+    /// 把形状从 Start 平移到 End；Size 对矩形为半宽高，对圆为 (半径, 忽略)。
+    struct Physics2DShapeCastCommand
+    {
+        Physics2DQueryShape Shape = Physics2DQueryShape::Circle;
+        glm::vec2 Start{0.0f};
+        glm::vec2 End{0.0f};
+        glm::vec2 Size{0.5f};
+        float Angle = 0.0f;
+        uint32_t LayerMask = 0xFFFFFFFFu;
+    };
+
+    /// Size 含义同 Physics2DShapeCastCommand。
+    struct Physics2DOverlapCommand
+    {
+        Physics2DQueryShape Shape = Physics2DQueryShape::AABB;
+        glm::vec2 Center{0.0f};
+        glm::vec2 Size{0.5f};
+        float Angle = 0.0f;
+        uint32_t LayerMask = 0xFFFFFFFFu;
+    };
+
+    /// 重叠查询只填写 EntityID，同一实体的多个形状只记一次。
+    struct Physics2DQueryHit
+    {
+        glm::vec2 Point{0.0f};
+        glm::vec2 Normal{0.0f};
+        /// 命中位置占平移量的比例。
+        float Fraction = 0.0f;
+        float Distance = 0.0f;
+        uint64_t EntityID = 0;
+    };
+
+    struct Physics2DQueryOptions
+    {
+        Physics2DQueryMode Mode = Physics2DQueryMode::Closest;
+        /// 结果缓冲区中每条命令占用的槽数，第 i 条命令写入 hits[i * MaxHitsPerQuery]。
+        uint32_t MaxHitsPerQuery = 1;
+        /// 按 BatchSize 条一批分发到 JobSystem 工作线程；JobSystem 未初始化时在调用线程执行。
+        bool Parallel = false;
+        uint32_t BatchSize = 64;
+    };
+}
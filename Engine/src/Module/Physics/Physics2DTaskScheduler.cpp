@@ -0,0 +1,151 @@
+#include "Hepch.h"
+#include "Module/Physics/Physics2DTaskScheduler.h"
+
+#include "EngineCore/Core/JobSystem.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 空闲 workerIndex 用一个 32 位掩码记录。
+        constexpr uint32_t MaxPhysicsWorkerCount = 32;
+    }
+
+    struct Physics2DTaskScheduler::Task
+    {
+        Physics2DTaskScheduler *Scheduler = nullptr;
+        b2TaskCallback *Callback = nullptr;
+        void *Context = nullptr;
+        int32_t ItemCount = 0;
+        int32_t ChunkSize = 0;
+        uint32_t ChunkCount = 0;
+        std::atomic<uint32_t> NextChunk{0};
+        std::atomic<uint32_t> CompletedChunks{0};
+    };
+
+    uint32_t Physics2DTaskScheduler::ResolveWorkerCount(uint32_t requestedWorkerCount)
+    {
+        const uint32_t availableWorkerCount = JobSystem::IsInitialized() ? JobSystem::GetWorkerCount() + 1 : 1;
+        const uint32_t workerCount =
+                requestedWorkerCount == 0 ? availableWorkerCount : std::min(requestedWorkerCount, availableWorkerCount);
+        return std::clamp(workerCount, 1u, MaxPhysicsWorkerCount);
+    }
+
+    void Physics2DTaskScheduler::ConfigureWorldDef(b2WorldDef &worldDef, uint32_t workerCount)
+    {
+        m_WorkerCount = std::clamp(workerCount, 1u, MaxPhysicsWorkerCount);
+        m_BusyWorkerMask.store(0);
+        m_ActiveTasks.clear();
+        if (m_WorkerCount <= 1)
+            return;
+
+        worldDef.workerCount = static_cast<int32_t>(m_WorkerCount);
+        worldDef.enqueueTask = &Physics2DTaskScheduler::EnqueueTask;
+        worldDef.finishTask = &Physics2DTaskScheduler::FinishTask;
+        worldDef.userTaskContext = this;
+    }
+
+    void *Physics2DTaskScheduler::EnqueueTask(b2TaskCallback *taskCallback, int32_t itemCount, int32_t minRange,
+                                              void *taskContext, void *userContext)
+    {
+        auto *scheduler = static_cast<Physics2DTaskScheduler *>(userContext);
+        if (itemCount <= 0)
+            return nullptr;
+
+        // 求解器按 worker 各投递一个 itemCount 为 1 的常驻任务，这类任务也必须交给工作线程才能并行，
+        // 所以这里不做“小任务就地执行”的优化。
+        minRange = std::max(minRange, 1);
+        const uint32_t maxChunkCount = static_cast<uint32_t>((itemCount + minRange - 1) / minRange);
+
+        Ref<Task> task = CreateRef<Task>();
+        task->Scheduler = scheduler;
+        task->Callback = taskCallback;
+        task->Context = taskContext;
+        task->ItemCount = itemCount;
+        task->ChunkCount = std::min(scheduler->m_WorkerCount, maxChunkCount);
+        task->ChunkSize = (itemCount + static_cast<int32_t>(task->ChunkCount) - 1) / static_cast<int32_t>(task->ChunkCount);
+        scheduler->m_ActiveTasks.push_back(task);
+
+        // 迟到的工作线程领不到块时直接退出，不再访问调度器。
+        for (uint32_t helperIndex = 0; helperIndex < task->ChunkCount; ++helperIndex)
+        {
+            JobSystem::Submit([task]()
+            {
+                for (;;)
+                {
+                    const uint32_t chunkIndex = task->NextChunk.fetch_add(1);
+                    if (chunkIndex >= task->ChunkCount)
+                        return;
+                    task->Scheduler->ExecuteChunk(*task, chunkIndex);
+                }
+            });
+        }
+
+        return task.get();
+    }
+
+    void Physics2DTaskScheduler::FinishTask(void *userTask, void *userContext)
+    {
+        if (!userTask)
+            return;
+
+        auto *scheduler = static_cast<Physics2DTaskScheduler *>(userContext);
+        Task &task = *static_cast<Task *>(userTask);
+
+        // 步进线程不空等：先把还没被工作线程领走的块做掉。
+        for (;;)
+        {
+            const uint32_t chunkIndex = task.NextChunk.fetch_add(1);
+            if (chunkIndex >= task.ChunkCount)
+                break;
+            scheduler->ExecuteChunk(task, chunkIndex);
+        }
+
+        while (task.CompletedChunks.load(std::memory_order_acquire) < task.ChunkCount)
+            std::this_thread::yield();
+
+        auto &activeTasks = scheduler->m_ActiveTasks;
+        activeTasks.erase(std::find_if(activeTasks.begin(), activeTasks.end(),
+                                       [&task](const Ref<Task> &activeTask) { return activeTask.get() == &task; }));
+    }
+
+    void Physics2DTaskScheduler::ExecuteChunk(Task &task, uint32_t chunkIndex)
+    {
+        const int32_t beginIndex = static_cast<int32_t>(chunkIndex) * task.ChunkSize;
+        const int32_t endIndex = std::min(task.ItemCount, beginIndex + task.ChunkSize);
+        if (beginIndex < endIndex)
+        {
+            const uint32_t workerIndex = AcquireWorkerIndex();
+            task.Callback(beginIndex, endIndex, workerIndex, task.Context);
+            ReleaseWorkerIndex(workerIndex);
+        }
+        task.CompletedChunks.fetch_add(1, std::memory_order_release);
+    }
+
+    uint32_t Physics2DTaskScheduler::AcquireWorkerIndex()
+    {
+        // 同时执行块的线程数不超过 m_WorkerCount（工作线程 + 步进线程），总能拿到空位。
+        for (;;)
+        {
+            uint32_t busyMask = m_BusyWorkerMask.load(std::memory_order_relaxed);
+            for (uint32_t workerIndex = 0; workerIndex < m_WorkerCount; ++workerIndex)
+            {
+                const uint32_t workerBit = 1u << workerIndex;
+                if ((busyMask & workerBit) != 0)
+                    continue;
+                if (m_BusyWorkerMask.compare_exchange_weak(busyMask, busyMask | workerBit, std::memory_order_acquire))
+                    return workerIndex;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void Physics2DTaskScheduler::ReleaseWorkerIndex(uint32_t workerIndex)
+    {
+        m_BusyWorkerMask.fetch_and(~(1u << workerIndex), std::memory_order_release);
+    }
+}
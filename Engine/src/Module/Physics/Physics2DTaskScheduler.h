@@ -0,0 +1,49 @@
+#pragma once
+
+#include "EngineCore/Core/Core.h"
+
+#include "box2d/box2d.h"
+
+#include <atomic>
+#include <vector>
+
+namespace Himii
+{
+    /// 把 Box2D 的 enqueueTask / finishTask 接到 JobSystem：任务区间切块后投递给工作线程，
+    /// 步进线程在 finishTask 中也领取剩余块，因此即使工作线程繁忙也不会卡住求解器。
+    class Physics2DTaskScheduler
+    {
+    public:
+        Physics2DTaskScheduler() = default;
+
+        Physics2DTaskScheduler(const Physics2DTaskScheduler &) = delete;
+        Physics2DTaskScheduler &operator=(const Physics2DTaskScheduler &) = delete;
+
+        /// requestedWorkerCount 为 0 时取 JobSystem 工作线程数 + 步进线程；
+        /// 结果不超过实际可并发的线程数，保证每个并发任务都能拿到唯一的 Box2D workerIndex。
+        static uint32_t ResolveWorkerCount(uint32_t requestedWorkerCount);
+
+        /// 按 workerCount 填写 worldDef 的多线程字段；workerCount 为 1 时保持 Box2D 单线程默认行为。
+        void ConfigureWorldDef(b2WorldDef &worldDef, uint32_t workerCount);
+
+        uint32_t GetWorkerCount() const
+        {
+            return m_WorkerCount;
+        }
+
+    private:
+        struct Task;
+
+        static void *EnqueueTask(b2TaskCallback *taskCallback, int32_t itemCount, int32_t minRange,
+                                 void *taskContext, void *userContext);
+        static void FinishTask(void *userTask, void *userContext);
+
+        void ExecuteChunk(Task &task, uint32_t chunkIndex);
+        uint32_t AcquireWorkerIndex();
+        void ReleaseWorkerIndex(uint32_t workerIndex);
+
+        uint32_t m_WorkerCount = 1;
+        std::atomic<uint32_t> m_BusyWorkerMask{0};
+        std::vector<Ref<Task>> m_ActiveTasks;
+    };
+}
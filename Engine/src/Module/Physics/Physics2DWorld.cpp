@@ -12,6 +12,8 @@
 #include "Module/Script/ScriptEngine.h"
 #include "EngineCore/Core/Log.h"
 
+#include <glm/gtc/constants.hpp>
+
 #include <algorithm>
 #include <cmath>
 #include <utility>
@@ -27,7 +29,7 @@ namespace Himii
 
             b2Filter filter = b2DefaultFilter();
             filter.categoryBits = 1u;
-            filter.maskBits = 0xFFFFFFFFu;
+            filter.maskBits = 0xFFFFFFFFu | Physics2DQueryCategoryBit;
             return filter;
         }
 
@@ -39,6 +41,7 @@ namespace Himii
                 return;
 
             b2ShapeDef shapeDef = b2DefaultShapeDef();
+            shapeDef.userData = b2Body_GetUserData(bodyId);
             shapeDef.enableContactEvents = true;
             shapeDef.isSensor = boxCollider.IsTrigger;
             shapeDef.filter = BuildColliderShapeFilter(boxCollider.Layer);
@@ -67,6 +70,7 @@ namespace Himii
                 return;
 
             b2ShapeDef shapeDef = b2DefaultShapeDef();
+            shapeDef.userData = b2Body_GetUserData(bodyId);
             shapeDef.enableContactEvents = true;
             shapeDef.isSensor = circleCollider.IsTrigger;
             shapeDef.filter = BuildColliderShapeFilter(circleCollider.Layer);
@@ -141,8 +145,13 @@ namespace Himii
 
         Stop();
 
+        uint32_t requestedWorkerCount = m_WorkerCountOverride;
+        if (requestedWorkerCount == 0 && Project::GetActive())
+            requestedWorkerCount = Project::GetConfig().Physics2DSimulation.WorkerCount;
+
         b2WorldDef worldDef = b2DefaultWorldDef();
         worldDef.gravity = b2Vec2{0.0f, -9.8f};
+        m_TaskScheduler.ConfigureWorldDef(worldDef, Physics2DTaskScheduler::ResolveWorkerCount(requestedWorkerCount));
         m_Box2DWorld = b2CreateWorld(&worldDef);
 
         auto &registry = m_Scene->Registry();
@@ -178,6 +187,16 @@ namespace Himii
             b2BodyId bodyId = b2CreateBody(m_Box2DWorld, &bodyDef);
             rigidbody2D.RuntimeBody = SceneInternal::BodyIdToPointer(bodyId);
 
+            if (bodyDef.type != b2BodyType::b2_staticBody)
+            {
+                InterpolatedBody &interpolatedBody = m_InterpolatedBodies.emplace_back();
+                interpolatedBody.EntityHandle = entityHandle;
+                interpolatedBody.BodyId = bodyId;
+                interpolatedBody.Current = {{worldTranslation.x, worldTranslation.y}, worldRotation.z};
+                interpolatedBody.Previous = interpolatedBody.Current;
+                m_InterpolatedBodyIndices[entityHandle] = m_InterpolatedBodies.size() - 1;
+            }
+
             if (entity.HasComponent<BoxCollider2DComponent>())
                 AttachBoxColliderToBody(bodyId, entity.GetComponent<BoxCollider2DComponent>(), worldScale);
 
@@ -250,11 +269,12 @@ namespace Himii
             }
 
             void *bodyUserData = (void *)(uintptr_t)(uint32_t)entity;
-            const TilemapColliderBuildReport report = TilemapColliderBuilder::CreateColliderShapes(
+            TilemapColliderBody &colliderBody = m_TilemapColliders.emplace_back();
+            const TilemapColliderBuildReport report = colliderBody.Create(
                     m_Box2DWorld,
                     transform,
-                    *mapData,
-                    *tileSet,
+                    mapData,
+                    tileSet,
                     bodyUserData,
                     tilemapCollider.MergeAdjacentCells);
 
@@ -269,6 +289,12 @@ namespace Himii
             b2DestroyWorld(m_Box2DWorld);
             m_Box2DWorld = {};
         }
+
+        m_InterpolatedBodies.clear();
+        m_InterpolatedBodyIndices.clear();
+        m_MovedBodyIndices.clear();
+        m_TransformUpdates.clear();
+        m_TilemapColliders.clear();
     }
 
     void Physics2DWorld::Step(Timestep timestep)
@@ -276,28 +302,65 @@ namespace Himii
         if (!m_Scene || !b2World_IsValid(m_Box2DWorld))
             return;
 
+        // 上一步移动过的刚体这一步可能已静止，先对齐历史，否则插值会停在两步之间。
+        for (const size_t bodyIndex : m_MovedBodyIndices)
+            m_InterpolatedBodies[bodyIndex].Previous = m_InterpolatedBodies[bodyIndex].Current;
+        m_MovedBodyIndices.clear();
+
         const int32_t subStepCount = 2;
         b2World_Step(m_Box2DWorld, timestep, subStepCount);
         ProcessContacts();
 
-        auto view = m_Scene->Registry().view<Rigidbody2DComponent>();
-        for (auto entityHandle : view)
+        HIMII_PROFILE_SCOPE("Physics2DWorld::Step WriteBack");
+
+        // 只有本步真正移动过的刚体会产生移动事件，写回耗时随活跃刚体数而非刚体总数增长。
+        const b2BodyEvents bodyEvents = b2World_GetBodyEvents(m_Box2DWorld);
+        m_TransformUpdates.clear();
+        m_TransformUpdates.reserve(static_cast<size_t>(bodyEvents.moveCount));
+        for (int eventIndex = 0; eventIndex < bodyEvents.moveCount; ++eventIndex)
         {
-            Entity entity = {entityHandle, m_Scene};
-            auto &rigidbody2D = entity.GetComponent<Rigidbody2DComponent>();
+            const b2BodyMoveEvent &moveEvent = bodyEvents.moveEvents[eventIndex];
+            const entt::entity entityHandle =
+                    static_cast<entt::entity>(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(moveEvent.userData)));
+            auto interpolatedBodyIterator = m_InterpolatedBodyIndices.find(entityHandle);
+            if (interpolatedBodyIterator == m_InterpolatedBodyIndices.end())
+                continue;
 
-            if (rigidbody2D.RuntimeBody)
-            {
-                b2BodyId bodyId = SceneInternal::PointerToBodyId(rigidbody2D.RuntimeBody);
-                if (b2Body_IsValid(bodyId))
-                {
-                    b2Vec2 position = b2Body_GetPosition(bodyId);
-                    b2Rot rotation = b2Body_GetRotation(bodyId);
-                    m_Scene->ApplyPhysicsWorldTransform(
-                            entity, {position.x, position.y}, b2Rot_GetAngle(rotation));
-                }
-            }
+            InterpolatedBody &interpolatedBody = m_InterpolatedBodies[interpolatedBodyIterator->second];
+            interpolatedBody.Current = {{moveEvent.transform.p.x, moveEvent.transform.p.y},
+                                        b2Rot_GetAngle(moveEvent.transform.q)};
+            m_MovedBodyIndices.push_back(interpolatedBodyIterator->second);
+            m_TransformUpdates.push_back({entityHandle, interpolatedBody.Current.Position, interpolatedBody.Current.Angle});
         }
+
+        m_Scene->ApplyPhysicsWorldTransforms(m_TransformUpdates);
+    }
+
+    void Physics2DWorld::ApplyInterpolatedTransforms(float alpha)
+    {
+        if (!m_Scene || !b2World_IsValid(m_Box2DWorld))
+            return;
+
+        HIMII_PROFILE_FUNCTION();
+
+        alpha = std::clamp(alpha, 0.0f, 1.0f);
+        m_TransformUpdates.clear();
+        for (const size_t bodyIndex : m_MovedBodyIndices)
+        {
+            const InterpolatedBody &interpolatedBody = m_InterpolatedBodies[bodyIndex];
+            const BodyPose &previous = interpolatedBody.Previous;
+            const BodyPose &current = interpolatedBody.Current;
+            if (previous.Position == current.Position && previous.Angle == current.Angle)
+                continue;
+
+            // 角度取最短弧插值，避免跨越 ±π 时反向转一整圈。
+            const float angleDelta = std::remainder(current.Angle - previous.Angle, glm::two_pi<float>());
+            m_TransformUpdates.push_back({interpolatedBody.EntityHandle,
+                                          previous.Position + (current.Position - previous.Position) * alpha,
+                                          previous.Angle + angleDelta * alpha});
+        }
+
+        m_Scene->ApplyPhysicsWorldTransforms(m_TransformUpdates);
     }
 
     Scene::RaycastHit2D Physics2DWorld::Raycast2D(glm::vec2 start, glm::vec2 end)
@@ -346,6 +409,39 @@ namespace Himii
                 bodyId,
                 {worldTranslation.x, worldTranslation.y},
                 b2MakeRot(worldRotation.z));
+
+        // 传送后不再从旧位姿插值过来。
+        auto interpolatedBodyIterator = m_InterpolatedBodyIndices.find(static_cast<entt::entity>(entity));
+        if (interpolatedBodyIterator != m_InterpolatedBodyIndices.end())
+        {
+            InterpolatedBody &interpolatedBody = m_InterpolatedBodies[interpolatedBodyIterator->second];
+            interpolatedBody.Current = {{worldTranslation.x, worldTranslation.y}, worldRotation.z};
+            interpolatedBody.Previous = interpolatedBody.Current;
+        }
+    }
+
+    void Physics2DWorld::MarkTilemapTileDirty(const TileMapData *mapData, int32_t tileX, int32_t tileY)
+    {
+        if (!mapData || !b2World_IsValid(m_Box2DWorld))
+            return;
+
+        for (TilemapColliderBody &colliderBody : m_TilemapColliders)
+        {
+            if (colliderBody.GetMapData().get() == mapData)
+                colliderBody.MarkTileDirty(tileX, tileY);
+        }
+    }
+
+    void Physics2DWorld::RebuildDirtyTilemapColliders()
+    {
+        if (!b2World_IsValid(m_Box2DWorld))
+            return;
+
+        for (TilemapColliderBody &colliderBody : m_TilemapColliders)
+        {
+            if (colliderBody.HasDirtyChunks())
+                colliderBody.RebuildDirtyChunks();
+        }
     }
 
     Entity Physics2DWorld::GetEntityFromShape(b2ShapeId shapeId)
@@ -353,11 +449,16 @@ namespace Himii
         if (!m_Scene || !b2Shape_IsValid(shapeId))
             return {};
 
-        b2BodyId bodyId = b2Shape_GetBody(shapeId);
-        if (!b2Body_IsValid(bodyId))
-            return {};
-
-        void *userData = b2Body_GetUserData(bodyId);
+        // 碰撞体创建时把实体句柄缓存进形状 userData，省去先查刚体再取 userData；
+        // 未写入的形状（如瓦片碰撞体）再回退到刚体。
+        void *userData = b2Shape_GetUserData(shapeId);
+        if (!userData)
+        {
+            b2BodyId bodyId = b2Shape_GetBody(shapeId);
+            if (!b2Body_IsValid(bodyId))
+                return {};
+            userData = b2Body_GetUserData(bodyId);
+        }
         if (!userData)
             return {};
 
@@ -374,51 +475,51 @@ namespace Himii
         if (!m_Scene || !b2World_IsValid(m_Box2DWorld))
             return;
 
-        b2ContactEvents events = b2World_GetContactEvents(m_Box2DWorld);
+        m_ContactEvents.clear();
+
+        // 只为挂了脚本实例的一方生成记录，托管侧无需再过滤。
+        const auto appendContactEvent = [this](Entity self, Entity other, Contact2DEventKind kind,
+                                               const glm::vec2 &normal, const glm::vec2 &point)
+        {
+            if (!self.HasComponent<ScriptComponent>())
+                return;
+
+            void *selfInstance = ScriptEngine::GetEntityScriptInstance(self.GetUUID());
+            if (!selfInstance)
+                return;
+
+            Contact2DEventInterop &contactEvent = m_ContactEvents.emplace_back();
+            contactEvent.SelfInstance = selfInstance;
+            contactEvent.SelfEntityID = self.GetUUID();
+            contactEvent.OtherEntityID = other.GetUUID();
+            contactEvent.Normal = normal;
+            contactEvent.Point = point;
+            contactEvent.Kind = kind;
+        };
+
+        const b2ContactEvents events = b2World_GetContactEvents(m_Box2DWorld);
+        m_ContactEvents.reserve(static_cast<size_t>(events.beginCount + events.endCount) * 2);
 
         for (int index = 0; index < events.beginCount; ++index)
         {
             const b2ContactBeginTouchEvent &event = events.beginEvents[index];
             Entity entityA = GetEntityFromShape(event.shapeIdA);
             Entity entityB = GetEntityFromShape(event.shapeIdB);
-            if (entityA && entityB)
-            {
-                const bool isTriggerContact =
-                        b2Shape_IsSensor(event.shapeIdA) || b2Shape_IsSensor(event.shapeIdB);
-
-                auto buildCollisionInterop = [&](Entity self, Entity other) -> Collision2DInterop
-                {
-                    Collision2DInterop collisionInterop;
-                    collisionInterop.OtherEntityID = other.GetUUID();
-
-                    const Entity shapeOwnerA = GetEntityFromShape(event.shapeIdA);
-                    const b2Vec2 &manifoldNormal = event.manifold.normal;
-                    if (shapeOwnerA == self)
-                        collisionInterop.Normal = glm::vec2{-manifoldNormal.x, -manifoldNormal.y};
-                    else
-                        collisionInterop.Normal = glm::vec2{manifoldNormal.x, manifoldNormal.y};
-
-                    collisionInterop.Point = glm::vec2{0.0f, 0.0f};
-                    if (event.manifold.pointCount > 0)
-                    {
-                        const b2Vec2 &contactPoint = event.manifold.points[0].point;
-                        collisionInterop.Point = glm::vec2{contactPoint.x, contactPoint.y};
-                    }
-
-                    return collisionInterop;
-                };
-
-                if (isTriggerContact)
-                {
-                    ScriptEngine::OnTriggerEnter2D(entityA, entityB, buildCollisionInterop(entityA, entityB));
-                    ScriptEngine::OnTriggerEnter2D(entityB, entityA, buildCollisionInterop(entityB, entityA));
-                }
-                else
-                {
-                    ScriptEngine::OnCollisionEnter2D(entityA, entityB, buildCollisionInterop(entityA, entityB));
-                    ScriptEngine::OnCollisionEnter2D(entityB, entityA, buildCollisionInterop(entityB, entityA));
-                }
-            }
+            if (!entityA || !entityB)
+                continue;
+
+            const bool isTriggerContact = b2Shape_IsSensor(event.shapeIdA) || b2Shape_IsSensor(event.shapeIdB);
+            const Contact2DEventKind kind =
+                    isTriggerContact ? Contact2DEventKind::TriggerEnter : Contact2DEventKind::CollisionEnter;
+
+            // 流形法线由 A 指向 B；对 A 而言碰撞法线取反。
+            const glm::vec2 normal{event.manifold.normal.x, event.manifold.normal.y};
+            glm::vec2 point{0.0f, 0.0f};
+            if (event.manifold.pointCount > 0)
+                point = {event.manifold.points[0].point.x, event.manifold.points[0].point.y};
+
+            appendContactEvent(entityA, entityB, kind, -normal, point);
+            appendContactEvent(entityB, entityA, kind, normal, point);
         }
 
         for (int index = 0; index < events.endCount; ++index)
@@ -429,22 +530,16 @@ namespace Himii
 
             Entity entityA = GetEntityFromShape(event.shapeIdA);
             Entity entityB = GetEntityFromShape(event.shapeIdB);
-            if (entityA && entityB)
-            {
-                const bool isTriggerContact =
-                        b2Shape_IsSensor(event.shapeIdA) || b2Shape_IsSensor(event.shapeIdB);
-
-                if (isTriggerContact)
-                {
-                    ScriptEngine::OnTriggerExit2D(entityA, entityB);
-                    ScriptEngine::OnTriggerExit2D(entityB, entityA);
-                }
-                else
-                {
-                    ScriptEngine::OnCollisionExit2D(entityA, entityB);
-                    ScriptEngine::OnCollisionExit2D(entityB, entityA);
-                }
-            }
+            if (!entityA || !entityB)
+                continue;
+
+            const bool isTriggerContact = b2Shape_IsSensor(event.shapeIdA) || b2Shape_IsSensor(event.shapeIdB);
+            const Contact2DEventKind kind =
+                    isTriggerContact ? Contact2DEventKind::TriggerExit : Contact2DEventKind::CollisionExit;
+            appendContactEvent(entityA, entityB, kind, {0.0f, 0.0f}, {0.0f, 0.0f});
+            appendContactEvent(entityB, entityA, kind, {0.0f, 0.0f}, {0.0f, 0.0f});
         }
+
+        ScriptEngine::DispatchContact2DEvents(m_ContactEvents);
     }
 }
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "EngineCore/Core/Timestep.h"
+#include "Module/Physics/Physics2DQuery.h"
+#include "Module/Physics/Physics2DTaskScheduler.h"
+#include "Module/Script/ScriptEngine.h"
+#include "Module/Tilemap/TilemapColliderBuilder.h"
 #include "World/Scene/Scene.h"
 #include "World/Scene/Entity.h"
 
 #include "box2d/box2d.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace Himii
 {
     /// Box2D 2D 物理世界实现；由 Physics2DModule 持有，绑定到一个 Scene。
@@ -20,18 +27,73 @@ namespace Himii
 
         void Start();
         void Stop();
+        /// 推进一个固定步，按 Box2D 移动事件只把本步移动过的刚体写回 Transform，FixedUpdate 读到的是未插值的状态。
         void Step(Timestep timestep);
+        /// 对上一步移动过的刚体，在上一步与当前步的位姿之间插值写回 Transform；alpha 为累加器余量占步长的比例。
+        void ApplyInterpolatedTransforms(float alpha);
 
         Scene::RaycastHit2D Raycast2D(glm::vec2 start, glm::vec2 end);
+
+        /// 批量查询：第 i 条命令的命中写入 hits[i * options.MaxHitsPerQuery] 起的槽位，数量写入 hitCounts[i]。
+        /// 只读访问物理世界，必须在两次 Step 之间调用；options.Parallel 时各批命令在工作线程上并发执行。
+        void RaycastBatch(const Physics2DRaycastCommand *commands, uint32_t commandCount,
+                          const Physics2DQueryOptions &options, Physics2DQueryHit *hits, uint32_t *hitCounts) const;
+        void ShapeCastBatch(const Physics2DShapeCastCommand *commands, uint32_t commandCount,
+                            const Physics2DQueryOptions &options, Physics2DQueryHit *hits, uint32_t *hitCounts) const;
+        void OverlapBatch(const Physics2DOverlapCommand *commands, uint32_t commandCount,
+                          const Physics2DQueryOptions &options, Physics2DQueryHit *hits, uint32_t *hitCounts) const;
+
         void SyncEntityTransform(Entity entity);
 
+        /// 记录运行时瓦片修改；引用同一 TileMapData 的所有瓦片碰撞体都会在帧末重建该格所在区块。
+        void MarkTilemapTileDirty(const TileMapData *mapData, int32_t tileX, int32_t tileY);
+        /// 帧末统一重建被标记的瓦片区块，一帧内对同一区块的多次修改只重建一次。
+        void RebuildDirtyTilemapColliders();
+
         bool IsRunning() const { return b2World_IsValid(m_Box2DWorld); }
 
+        /// 下次 Start 使用的求解线程数；0 表示按工程设置。
+        void SetWorkerCountOverride(uint32_t workerCount) { m_WorkerCountOverride = workerCount; }
+        /// 当前世界实际使用的求解线程数。
+        uint32_t GetWorkerCount() const { return m_TaskScheduler.GetWorkerCount(); }
+
+        /// 最近一步产生移动事件、被写回 Transform 的刚体数。
+        size_t GetMovedBodyCount() const { return m_MovedBodyIndices.size(); }
+
     private:
+        struct BodyPose
+        {
+            glm::vec2 Position{0.0f};
+            float Angle = 0.0f;
+        };
+
+        /// 非静态刚体最近两个固定步的位姿，供渲染插值。
+        struct InterpolatedBody
+        {
+            entt::entity EntityHandle = entt::null;
+            b2BodyId BodyId{};
+            BodyPose Previous;
+            BodyPose Current;
+        };
+
         Entity GetEntityFromShape(b2ShapeId shapeId);
+        /// 清零命中计数并检查缓冲区与世界状态，返回是否需要执行查询。
+        bool PrepareQueryBatch(uint32_t commandCount, const Physics2DQueryOptions &options, Physics2DQueryHit *hits,
+                               uint32_t *hitCounts) const;
+        /// 把本步的开始 / 结束接触整理成连续的事件数组，一次交给脚本引擎分发。
         void ProcessContacts();
 
         Scene *m_Scene = nullptr;
+        Physics2DTaskScheduler m_TaskScheduler;
+        uint32_t m_WorkerCountOverride = 0;
         b2WorldId m_Box2DWorld{};
+
+        std::vector<InterpolatedBody> m_InterpolatedBodies;
+        std::unordered_map<entt::entity, size_t> m_InterpolatedBodyIndices;
+        /// 最近一步产生移动事件的刚体；下一步开始时把它们的历史对齐，睡眠刚体不再被遍历。
+        std::vector<size_t> m_MovedBodyIndices;
+        std::vector<Scene::PhysicsWorldTransformUpdate> m_TransformUpdates;
+        std::vector<Contact2DEventInterop> m_ContactEvents;
+        std::vector<TilemapColliderBody> m_TilemapColliders;
     };
 }
@@ -0,0 +1,551 @@
+#include "Hepch.h"
+#include "Module/Render/Environment/EnvironmentBake.h"
+#include "Module/Render/RenderCore/CubemapCoordinates.h"
+
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "stb_image.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HIMII_IBL_BAKE_SSE2 1
+#else
+    #define HIMII_IBL_BAKE_SSE2 0
+#endif
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr float Pi = 3.14159265358979323846f;
+
+        glm::vec3 SampleEquirectangular(const EquirectangularImage &image, const glm::vec3 &direction)
+        {
+            const glm::vec3 normalized = glm::normalize(direction);
+            const float longitude = std::atan2(normalized.z, normalized.x);
+            const float latitude = std::asin(glm::clamp(normalized.y, -1.0f, 1.0f));
+            float uniqueCoordinateX = (longitude + Pi) / (2.0f * Pi);
+            float uniqueCoordinateY = 0.5f - latitude / Pi;
+            uniqueCoordinateX = glm::clamp(uniqueCoordinateX, 0.0f, 1.0f);
+            uniqueCoordinateY = glm::clamp(uniqueCoordinateY, 0.0f, 1.0f);
+
+            const float sampleX = uniqueCoordinateX * static_cast<float>(image.Width - 1);
+            const float sampleY = uniqueCoordinateY * static_cast<float>(image.Height - 1);
+            const int x0 = static_cast<int>(sampleX);
+            const int y0 = static_cast<int>(sampleY);
+            const int x1 = std::min(x0 + 1, image.Width - 1);
+            const int y1 = std::min(y0 + 1, image.Height - 1);
+            const float fractionX = sampleX - static_cast<float>(x0);
+            const float fractionY = sampleY - static_cast<float>(y0);
+
+            auto fetch = [&](int x, int y) {
+                const size_t index = (static_cast<size_t>(y) * static_cast<size_t>(image.Width)
+                                     + static_cast<size_t>(x))
+                                    * 3u;
+                return glm::vec3(image.Rgb[index], image.Rgb[index + 1], image.Rgb[index + 2]);
+            };
+
+            const glm::vec3 color00 = fetch(x0, y0);
+            const glm::vec3 color10 = fetch(x1, y0);
+            const glm::vec3 color01 = fetch(x0, y1);
+            const glm::vec3 color11 = fetch(x1, y1);
+            const glm::vec3 color0 = glm::mix(color00, color10, fractionX);
+            const glm::vec3 color1 = glm::mix(color01, color11, fractionX);
+            return glm::mix(color0, color1, fractionY);
+        }
+
+        /// 按（面, 行）分发到 JobSystem；同一阶段每行代价相近，批次取 1 行，小尺寸 mip 也能铺满工作线程。
+        template <typename RowFunction>
+        void ForEachFaceRow(uint32_t resolution, const RowFunction &rowFunction)
+        {
+            JobSystem::ParallelFor(CubemapFaceCount * resolution, 1,
+                                   [&](uint32_t beginRow, uint32_t endRow)
+                                   {
+                                       for (uint32_t row = beginRow; row < endRow; ++row)
+                                           rowFunction(row / resolution, row % resolution);
+                                   });
+        }
+
+        size_t GetFacePixelIndex(uint32_t faceIndex, uint32_t x, uint32_t y, uint32_t resolution)
+        {
+            return static_cast<size_t>(faceIndex) * resolution * resolution + static_cast<size_t>(y) * resolution + x;
+        }
+
+        /// accumulator += weight × 双线性采样；面映射取自 CubemapCoordinates，与生成阶段成对。
+        inline void AccumulateCubemapSample(const CubemapSamplingSource &source, const glm::vec3 &direction,
+                                            float weight, float *accumulator)
+        {
+            const CubemapFaceSample faceSample = FaceSampleFromDirection(direction);
+            const uint32_t resolution = source.Resolution;
+            const int lastTexel = static_cast<int>(resolution - 1);
+            const float sampleX = faceSample.ImageU * static_cast<float>(lastTexel);
+            const float sampleY = faceSample.ImageV * static_cast<float>(lastTexel);
+            const int x0 = static_cast<int>(sampleX);
+            const int y0 = static_cast<int>(sampleY);
+            const int x1 = std::min(x0 + 1, lastTexel);
+            const int y1 = std::min(y0 + 1, lastTexel);
+            const float fractionX = sampleX - static_cast<float>(x0);
+            const float fractionY = sampleY - static_cast<float>(y0);
+
+            const float *faceTexels = source.Rgba.data()
+                                      + GetFacePixelIndex(CubemapFaceToIndex(faceSample.Face), 0, 0, resolution) * 4u;
+            const float *texel00 = faceTexels + (static_cast<size_t>(y0) * resolution + x0) * 4u;
+            const float *texel10 = faceTexels + (static_cast<size_t>(y0) * resolution + x1) * 4u;
+            const float *texel01 = faceTexels + (static_cast<size_t>(y1) * resolution + x0) * 4u;
+            const float *texel11 = faceTexels + (static_cast<size_t>(y1) * resolution + x1) * 4u;
+            const float weight00 = (1.0f - fractionX) * (1.0f - fractionY) * weight;
+            const float weight10 = fractionX * (1.0f - fractionY) * weight;
+            const float weight01 = (1.0f - fractionX) * fractionY * weight;
+            const float weight11 = fractionX * fractionY * weight;
+
+#if HIMII_IBL_BAKE_SSE2
+            __m128 sum = _mm_loadu_ps(accumulator);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel00), _mm_set1_ps(weight00)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel10), _mm_set1_ps(weight10)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel01), _mm_set1_ps(weight01)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel11), _mm_set1_ps(weight11)));
+            _mm_storeu_ps(accumulator, sum);
+#else
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                accumulator[channel] += texel00[channel] * weight00 + texel10[channel] * weight10
+                                        + texel01[channel] * weight01 + texel11[channel] * weight11;
+            }
+#endif
+        }
+
+        /// 切线空间采样方向与归一化权重；与法线无关，每次卷积只生成一次。
+        struct TangentSpaceSample
+        {
+            glm::vec3 Direction{0.0f};
+            float Weight = 0.0f;
+        };
+
+        std::vector<TangentSpaceSample> BuildIrradianceSamples()
+        {
+            constexpr uint32_t sampleCountPhi = 32;
+            constexpr uint32_t sampleCountTheta = 16;
+
+            std::vector<TangentSpaceSample> samples;
+            samples.reserve(sampleCountPhi * sampleCountTheta);
+            float sampleWeight = 0.0f;
+            for (uint32_t phiIndex = 0; phiIndex < sampleCountPhi; ++phiIndex)
+            {
+                const float phi =
+                        2.0f * Pi * (static_cast<float>(phiIndex) + 0.5f) / static_cast<float>(sampleCountPhi);
+                for (uint32_t thetaIndex = 0; thetaIndex < sampleCountTheta; ++thetaIndex)
+                {
+                    const float theta =
+                            0.5f * Pi * (static_cast<float>(thetaIndex) + 0.5f) / static_cast<float>(sampleCountTheta);
+                    TangentSpaceSample sample;
+                    sample.Direction = glm::vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                                                 std::cos(theta));
+                    sample.Weight = std::cos(theta) * std::sin(theta);
+                    samples.push_back(sample);
+                    sampleWeight += std::sin(theta);
+                }
+            }
+
+            const float normalization = Pi / std::max(sampleWeight, 0.0001f);
+            for (TangentSpaceSample &sample : samples)
+                sample.Weight *= normalization;
+            return samples;
+        }
+
+        void ConvolveIrradiance(const CubemapSamplingSource &environment, uint32_t irradianceResolution,
+                                std::vector<float> &outIrradianceFaces)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            outIrradianceFaces.assign(static_cast<size_t>(CubemapFaceCount) * irradianceResolution
+                                              * irradianceResolution * 3u,
+                                      0.0f);
+            const std::vector<TangentSpaceSample> samples = BuildIrradianceSamples();
+
+            ForEachFaceRow(irradianceResolution,
+                           [&](uint32_t faceIndex, uint32_t y)
+                           {
+                               const CubemapFace face = CubemapFaceFromIndex(faceIndex);
+                               for (uint32_t x = 0; x < irradianceResolution; ++x)
+                               {
+                                   const glm::vec3 normal = DirectionFromFaceTexel(face, x, y, irradianceResolution);
+                                   glm::vec3 up = std::abs(normal.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f)
+                                                                              : glm::vec3(0.0f, 0.0f, 1.0f);
+                                   const glm::vec3 right = glm::normalize(glm::cross(up, normal));
+                                   up = glm::normalize(glm::cross(normal, right));
+
+                                   float irradiance[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                                   for (const TangentSpaceSample &sample : samples)
+                                   {
+                                       const glm::vec3 sampleDirection = sample.Direction.x * right
+                                                                         + sample.Direction.y * up
+                                                                         + sample.Direction.z * normal;
+                                       AccumulateCubemapSample(environment, sampleDirection, sample.Weight,
+                                                               irradiance);
+                                   }
+
+                                   float *destination = outIrradianceFaces.data()
+                                                        + GetFacePixelIndex(faceIndex, x, y, irradianceResolution) * 3u;
+                                   destination[0] = irradiance[0];
+                                   destination[1] = irradiance[1];
+                                   destination[2] = irradiance[2];
+                               }
+                           });
+        }
+
+        using SphericalHarmonics9 = std::array<glm::vec3, 9>;
+
+        void EvaluateSphericalHarmonicsBasis(const glm::vec3 &direction, float outBasis[9])
+        {
+            outBasis[0] = 0.282095f;
+            outBasis[1] = 0.488603f * direction.y;
+            outBasis[2] = 0.488603f * direction.z;
+            outBasis[3] = 0.488603f * direction.x;
+            outBasis[4] = 1.092548f * direction.x * direction.y;
+            outBasis[5] = 1.092548f * direction.y * direction.z;
+            outBasis[6] = 0.315392f * (3.0f * direction.z * direction.z - 1.0f);
+            outBasis[7] = 1.092548f * direction.x * direction.z;
+            outBasis[8] = 0.546274f * (direction.x * direction.x - direction.y * direction.y);
+        }
+
+        float CubemapAreaElement(float x, float y)
+        {
+            return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0f));
+        }
+
+        /// 立方体面像素所张立体角；只与面内位置有关，六个面相同。
+        float CubemapTexelSolidAngle(uint32_t x, uint32_t y, uint32_t resolution)
+        {
+            const float inverseResolution = 1.0f / static_cast<float>(resolution);
+            const float signedU = 2.0f * (static_cast<float>(x) + 0.5f) * inverseResolution - 1.0f;
+            const float signedV = 2.0f * (static_cast<float>(y) + 0.5f) * inverseResolution - 1.0f;
+            const float x0 = signedU - inverseResolution;
+            const float x1 = signedU + inverseResolution;
+            const float y0 = signedV - inverseResolution;
+            const float y1 = signedV + inverseResolution;
+            return CubemapAreaElement(x0, y0) - CubemapAreaElement(x0, y1) - CubemapAreaElement(x1, y0)
+                   + CubemapAreaElement(x1, y1);
+        }
+
+        /// 对源立方体做一遍投影。每行独立累加后按行序合并，结果与线程数无关。
+        SphericalHarmonics9 ProjectCubemapToSphericalHarmonics(const std::vector<float> &facesRgb,
+                                                               uint32_t resolution)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            std::vector<float> solidAngles(static_cast<size_t>(resolution) * resolution);
+            for (uint32_t y = 0; y < resolution; ++y)
+                for (uint32_t x = 0; x < resolution; ++x)
+                    solidAngles[static_cast<size_t>(y) * resolution + x] = CubemapTexelSolidAngle(x, y, resolution);
+
+            std::vector<SphericalHarmonics9> rowSums(static_cast<size_t>(CubemapFaceCount) * resolution);
+            ForEachFaceRow(resolution,
+                           [&](uint32_t faceIndex, uint32_t y)
+                           {
+                               const CubemapFace face = CubemapFaceFromIndex(faceIndex);
+                               SphericalHarmonics9 &rowSum = rowSums[static_cast<size_t>(faceIndex) * resolution + y];
+                               rowSum.fill(glm::vec3(0.0f));
+                               const float *rgb = facesRgb.data() + GetFacePixelIndex(faceIndex, 0, y, resolution) * 3u;
+                               for (uint32_t x = 0; x < resolution; ++x, rgb += 3)
+                               {
+                                   float basis[9];
+                                   EvaluateSphericalHarmonicsBasis(DirectionFromFaceTexel(face, x, y, resolution),
+                                                                   basis);
+                                   const glm::vec3 radiance = glm::vec3(rgb[0], rgb[1], rgb[2])
+                                                              * solidAngles[static_cast<size_t>(y) * resolution + x];
+                                   for (uint32_t coefficient = 0; coefficient < 9; ++coefficient)
+                                       rowSum[coefficient] += radiance * basis[coefficient];
+                               }
+                           });
+
+            SphericalHarmonics9 coefficients;
+            coefficients.fill(glm::vec3(0.0f));
+            for (const SphericalHarmonics9 &rowSum : rowSums)
+                for (uint32_t coefficient = 0; coefficient < 9; ++coefficient)
+                    coefficients[coefficient] += rowSum[coefficient];
+            return coefficients;
+        }
+
+        /// 按 Ramamoorthi-Hanrahan 的余弦卷积求值。半球卷积路径输出 E/2，此处同一标定，切换方式亮度不变。
+        void EvaluateIrradianceFromSphericalHarmonics(const SphericalHarmonics9 &coefficients,
+                                                      uint32_t irradianceResolution,
+                                                      std::vector<float> &outIrradianceFaces)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr float bandScale[9] = {Pi,
+                                            2.0f * Pi / 3.0f, 2.0f * Pi / 3.0f, 2.0f * Pi / 3.0f,
+                                            Pi / 4.0f, Pi / 4.0f, Pi / 4.0f, Pi / 4.0f, Pi / 4.0f};
+            SphericalHarmonics9 scaledCoefficients;
+            for (uint32_t coefficient = 0; coefficient < 9; ++coefficient)
+                scaledCoefficients[coefficient] = coefficients[coefficient] * (0.5f * bandScale[coefficient]);
+
+            outIrradianceFaces.assign(static_cast<size_t>(CubemapFaceCount) * irradianceResolution
+                                              * irradianceResolution * 3u,
+                                      0.0f);
+            ForEachFaceRow(irradianceResolution,
+                           [&](uint32_t faceIndex, uint32_t y)
+                           {
+                               const CubemapFace face = CubemapFaceFromIndex(faceIndex);
+                               float *destination = outIrradianceFaces.data()
+                                                    + GetFacePixelIndex(faceIndex, 0, y, irradianceResolution) * 3u;
+                               for (uint32_t x = 0; x < irradianceResolution; ++x, destination += 3)
+                               {
+                                   float basis[9];
+                                   EvaluateSphericalHarmonicsBasis(
+                                           DirectionFromFaceTexel(face, x, y, irradianceResolution), basis);
+                                   glm::vec3 irradiance(0.0f);
+                                   for (uint32_t coefficient = 0; coefficient < 9; ++coefficient)
+                                       irradiance += scaledCoefficients[coefficient] * basis[coefficient];
+                                   // 9 系数截断在强光源背面会振铃为负值。
+                                   irradiance = glm::max(irradiance, glm::vec3(0.0f));
+                                   destination[0] = irradiance.r;
+                                   destination[1] = irradiance.g;
+                                   destination[2] = irradiance.b;
+                               }
+                           });
+        }
+
+        float RadicalInverseVanDerCorput(uint32_t bits)
+        {
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return static_cast<float>(bits) * 2.3283064365386963e-10f;
+        }
+
+        glm::vec2 Hammersley(uint32_t index, uint32_t total)
+        {
+            return {static_cast<float>(index) / static_cast<float>(total), RadicalInverseVanDerCorput(index)};
+        }
+
+        /// 切线空间（法线为 +Z）下的 GGX 重要性采样半程向量。
+        glm::vec3 ImportanceSampleGGXTangent(glm::vec2 xi, float roughness)
+        {
+            const float alpha = roughness * roughness;
+            const float phi = 2.0f * Pi * xi.x;
+            const float cosineTheta =
+                    std::sqrt((1.0f - xi.y) / (1.0f + (alpha * alpha - 1.0f) * xi.y));
+            const float sineTheta = std::sqrt(std::max(0.0f, 1.0f - cosineTheta * cosineTheta));
+            return {std::cos(phi) * sineTheta, std::sin(phi) * sineTheta, cosineTheta};
+        }
+
+        glm::vec3 ImportanceSampleGGX(glm::vec2 xi, glm::vec3 normal, float roughness)
+        {
+            const glm::vec3 halfway = ImportanceSampleGGXTangent(xi, roughness);
+            const glm::vec3 up = std::abs(normal.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f)
+                                                            : glm::vec3(1.0f, 0.0f, 0.0f);
+            const glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
+            const glm::vec3 bitangent = glm::cross(normal, tangent);
+            return glm::normalize(tangent * halfway.x + bitangent * halfway.y + normal * halfway.z);
+        }
+
+        /// Split-Sum 取 V = N，反射方向 L = 2(N·H)H − N 在切线空间与法线无关，可按 mip 预先生成。
+        /// 粗糙度为 0 时所有半程向量都等于 N，只需一个样本。
+        std::vector<TangentSpaceSample> BuildPrefilterSamples(float roughness)
+        {
+            std::vector<TangentSpaceSample> samples;
+            if (roughness <= 0.0f)
+            {
+                samples.push_back({glm::vec3(0.0f, 0.0f, 1.0f), 1.0f});
+                return samples;
+            }
+
+            constexpr uint32_t sampleCount = EnvironmentPrefilterSampleCount;
+            float totalWeight = 0.0f;
+            for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+            {
+                const glm::vec3 halfway = ImportanceSampleGGXTangent(Hammersley(sampleIndex, sampleCount), roughness);
+                const glm::vec3 lightDirection =
+                        glm::normalize(2.0f * halfway.z * halfway - glm::vec3(0.0f, 0.0f, 1.0f));
+                if (lightDirection.z <= 0.0f)
+                    continue;
+                samples.push_back({lightDirection, lightDirection.z});
+                totalWeight += lightDirection.z;
+            }
+
+            const float normalization = 1.0f / std::max(totalWeight, 0.0001f);
+            for (TangentSpaceSample &sample : samples)
+                sample.Weight *= normalization;
+            return samples;
+        }
+    }
+
+    bool DecodeEquirectangularHdr(const std::filesystem::path &path, const std::vector<uint8_t> &fileBytes,
+                                  EquirectangularImage &outImage)
+    {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        // 烘焙在工作线程执行，不能改动其它加载共用的全局翻转开关。
+        stbi_set_flip_vertically_on_load_thread(0);
+        float *data = stbi_loadf_from_memory(fileBytes.data(), static_cast<int>(fileBytes.size()), &width,
+                                             &height, &channels, 3);
+        if (!data)
+        {
+            HIMII_CORE_ERROR("stbi_loadf failed for HDR: {0}", path.string());
+            return false;
+        }
+
+        outImage.Width = width;
+        outImage.Height = height;
+        outImage.Rgb.assign(data, data + static_cast<size_t>(width) * static_cast<size_t>(height) * 3u);
+        stbi_image_free(data);
+        return true;
+    }
+
+    void ConvertEquirectangularToCubemap(const EquirectangularImage &image, uint32_t resolution,
+                                         std::vector<float> &outFacesRgb)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        outFacesRgb.assign(static_cast<size_t>(CubemapFaceCount) * resolution * resolution * 3u, 0.0f);
+        ForEachFaceRow(resolution,
+                       [&](uint32_t faceIndex, uint32_t y)
+                       {
+                           const CubemapFace face = CubemapFaceFromIndex(faceIndex);
+                           float *destination = outFacesRgb.data() + GetFacePixelIndex(faceIndex, 0, y, resolution) * 3u;
+                           for (uint32_t x = 0; x < resolution; ++x, destination += 3)
+                           {
+                               const glm::vec3 color =
+                                       SampleEquirectangular(image, DirectionFromFaceTexel(face, x, y, resolution));
+                               destination[0] = color.r;
+                               destination[1] = color.g;
+                               destination[2] = color.b;
+                           }
+                       });
+    }
+
+    CubemapSamplingSource BuildSamplingSource(const std::vector<float> &facesRgb, uint32_t resolution)
+    {
+        CubemapSamplingSource source;
+        source.Resolution = resolution;
+        source.Rgba.resize(static_cast<size_t>(CubemapFaceCount) * resolution * resolution * 4u);
+        ForEachFaceRow(resolution,
+                       [&](uint32_t faceIndex, uint32_t y)
+                       {
+                           const size_t firstPixel = GetFacePixelIndex(faceIndex, 0, y, resolution);
+                           const float *rgb = facesRgb.data() + firstPixel * 3u;
+                           float *rgba = source.Rgba.data() + firstPixel * 4u;
+                           for (uint32_t x = 0; x < resolution; ++x, rgb += 3, rgba += 4)
+                           {
+                               rgba[0] = rgb[0];
+                               rgba[1] = rgb[1];
+                               rgba[2] = rgb[2];
+                               rgba[3] = 0.0f;
+                           }
+                       });
+        return source;
+    }
+
+    void ConvolvePrefilter(const CubemapSamplingSource &environment, uint32_t prefilterResolution,
+                           uint32_t mipCount, std::vector<std::vector<float>> &outMipFaces)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        outMipFaces.resize(mipCount);
+        for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            const uint32_t mipSize = std::max(1u, prefilterResolution >> mipLevel);
+            const float roughness =
+                    mipCount <= 1 ? 0.0f
+                                  : static_cast<float>(mipLevel) / static_cast<float>(mipCount - 1);
+            const std::vector<TangentSpaceSample> samples = BuildPrefilterSamples(roughness);
+            std::vector<float> &mipFaces = outMipFaces[mipLevel];
+            mipFaces.assign(static_cast<size_t>(CubemapFaceCount) * mipSize * mipSize * 3u, 0.0f);
+
+            ForEachFaceRow(mipSize,
+                           [&](uint32_t faceIndex, uint32_t y)
+                           {
+                               const CubemapFace face = CubemapFaceFromIndex(faceIndex);
+                               float *destination = mipFaces.data() + GetFacePixelIndex(faceIndex, 0, y, mipSize) * 3u;
+                               for (uint32_t x = 0; x < mipSize; ++x, destination += 3)
+                               {
+                                   const glm::vec3 normal = DirectionFromFaceTexel(face, x, y, mipSize);
+                                   const glm::vec3 up = std::abs(normal.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f)
+                                                                                   : glm::vec3(1.0f, 0.0f, 0.0f);
+                                   const glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
+                                   const glm::vec3 bitangent = glm::cross(normal, tangent);
+
+                                   float prefilteredColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                                   for (const TangentSpaceSample &sample : samples)
+                                   {
+                                       const glm::vec3 lightDirection = sample.Direction.x * tangent
+                                                                        + sample.Direction.y * bitangent
+                                                                        + sample.Direction.z * normal;
+                                       AccumulateCubemapSample(environment, lightDirection, sample.Weight,
+                                                               prefilteredColor);
+                                   }
+                                   destination[0] = prefilteredColor[0];
+                                   destination[1] = prefilteredColor[1];
+                                   destination[2] = prefilteredColor[2];
+                               }
+                           });
+        }
+    }
+
+    void ComputeIrradiance(EnvironmentIrradianceMethod method, const std::vector<float> &environmentFaces,
+                           const CubemapSamplingSource &environment, uint32_t irradianceResolution,
+                           std::vector<float> &outIrradianceFaces)
+    {
+        if (method == EnvironmentIrradianceMethod::Convolution)
+        {
+            ConvolveIrradiance(environment, irradianceResolution, outIrradianceFaces);
+            return;
+        }
+        EvaluateIrradianceFromSphericalHarmonics(
+                ProjectCubemapToSphericalHarmonics(environmentFaces, environment.Resolution), irradianceResolution,
+                outIrradianceFaces);
+    }
+
+    glm::vec2 IntegrateBrdf(float normalDotView, float roughness)
+    {
+        glm::vec3 viewDirection(std::sqrt(std::max(0.0f, 1.0f - normalDotView * normalDotView)), 0.0f,
+                               normalDotView);
+        float scale = 0.0f;
+        float bias = 0.0f;
+        constexpr uint32_t sampleCount = 128;
+        const glm::vec3 normal(0.0f, 0.0f, 1.0f);
+
+        for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+        {
+            const glm::vec2 xi = Hammersley(sampleIndex, sampleCount);
+            const glm::vec3 halfway = ImportanceSampleGGX(xi, normal, roughness);
+            const glm::vec3 lightDirection =
+                    glm::normalize(2.0f * glm::dot(viewDirection, halfway) * halfway - viewDirection);
+
+            const float normalDotLight = std::max(lightDirection.z, 0.0f);
+            const float normalDotHalfway = std::max(halfway.z, 0.0f);
+            const float viewDotHalfway = std::max(glm::dot(viewDirection, halfway), 0.0f);
+
+            if (normalDotLight > 0.0f)
+            {
+                const float geometrySmith =
+                        (normalDotView / (normalDotView * (1.0f - roughness / 2.0f) + roughness / 2.0f))
+                        * (normalDotLight
+                           / (normalDotLight * (1.0f - roughness / 2.0f) + roughness / 2.0f));
+                const float geometryVisibility =
+                        (geometrySmith * viewDotHalfway) / std::max(normalDotHalfway * normalDotView, 0.0001f);
+                const float fresnelFactor = std::pow(1.0f - viewDotHalfway, 5.0f);
+                scale += (1.0f - fresnelFactor) * geometryVisibility;
+                bias += fresnelFactor * geometryVisibility;
+            }
+        }
+
+        scale /= static_cast<float>(sampleCount);
+        bias /= static_cast<float>(sampleCount);
+        return {scale, bias};
+    }
+
+    bool IsEnvironmentBakeSse2Enabled()
+    {
+        return HIMII_IBL_BAKE_SSE2 != 0;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Module/Render/Environment/EnvironmentMapAsset.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "glm/vec2.hpp"
+
+namespace Himii
+{
+    /// 每个预滤波 mip 的 GGX 重要性采样数。
+    constexpr uint32_t EnvironmentPrefilterSampleCount = 256;
+
+    struct EquirectangularImage
+    {
+        int Width = 0;
+        int Height = 0;
+        std::vector<float> Rgb;
+    };
+
+    /// 卷积阶段的采样源：RGB 扩成 RGBA（A 不用），双线性的 4 个像素各占一个 SSE 寄存器。
+    struct CubemapSamplingSource
+    {
+        uint32_t Resolution = 0;
+        std::vector<float> Rgba;
+    };
+
+    // 以下为环境光烘焙的 CPU 阶段：不访问 GL，逐（面, 行）分发到 JobSystem。
+    // 立方体数据按面连续存放、每像素 RGB 三个 float。
+
+    bool DecodeEquirectangularHdr(const std::filesystem::path &path, const std::vector<uint8_t> &fileBytes,
+                                  EquirectangularImage &outImage);
+    void ConvertEquirectangularToCubemap(const EquirectangularImage &image, uint32_t resolution,
+                                         std::vector<float> &outFacesRgb);
+    CubemapSamplingSource BuildSamplingSource(const std::vector<float> &facesRgb, uint32_t resolution);
+    void ComputeIrradiance(EnvironmentIrradianceMethod method, const std::vector<float> &environmentFaces,
+                           const CubemapSamplingSource &environment, uint32_t irradianceResolution,
+                           std::vector<float> &outIrradianceFaces);
+    /// outMipFaces[i] 为第 i 层，粗糙度从 0 线性增至 1。
+    void ConvolvePrefilter(const CubemapSamplingSource &environment, uint32_t prefilterResolution,
+                           uint32_t mipCount, std::vector<std::vector<float>> &outMipFaces);
+    /// Split-Sum BRDF 积分项（scale, bias）。
+    glm::vec2 IntegrateBrdf(float normalDotView, float roughness);
+
+    /// 卷积的采样累加是否走 SSE2 路径（编译期决定）。
+    bool IsEnvironmentBakeSse2Enabled();
+}
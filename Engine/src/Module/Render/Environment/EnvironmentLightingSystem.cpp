@@ -1,354 +1,76 @@
 #include "Hepch.h"
 #include "Module/Render/Environment/EnvironmentLightingSystem.h"
+#include "Module/Render/Environment/EnvironmentBake.h"
 #include "Module/Render/Environment/EnvironmentMapAsset.h"
-#include "Module/Render/RenderCore/CubemapCoordinates.h"
 
 #include "EngineCore/Core/FileSystem.h"
+#include "EngineCore/Core/Hash.h"
+#include "EngineCore/Core/JobSystem.h"
 #include "EngineCore/Core/Log.h"
+#include "EngineCore/Core/Timer.h"
+#include "EngineCore/Utils/PlatformUtils.h"
 #include "Project/Project.h"
 #include "Resource/ResourceSystem.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <mutex>
 #include <unordered_map>
 
-#include "stb_image.h"
-
 namespace Himii
 {
     namespace
     {
-        constexpr float Pi = 3.14159265358979323846f;
         constexpr char BakeCacheMagic[8] = {'H', 'I', 'M', 'I', 'I', 'E', 'N', 'V'};
-        constexpr uint32_t BakeCacheVersion = 3;
-        constexpr uint32_t PrefilterConvolutionSampleCount = 256;
+        /// v4：头部记录辐照度求解方式。
+        constexpr uint32_t BakeCacheVersion = 4;
+        /// 源文件变更检测的节流间隔，与编辑器 FileWatcher 的扫描间隔一致。
+        constexpr std::chrono::milliseconds SourcePollInterval{250};
 
-        struct EquirectangularImage
+        struct RuntimeBakeCacheEntry
         {
-            int Width = 0;
-            int Height = 0;
-            std::vector<float> Rgb;
+            /// 最近一次成功的结果；过期或重新烘焙期间仍保留，供渲染继续使用。
+            BakedEnvironmentLighting Lighting;
+            std::filesystem::path SourceFilesystemPath;
+            /// 结果对应的源 HDR / .meta 指纹；轮询只做 stat 比较，不读文件内容。
+            EnvironmentSourceFingerprint Fingerprint;
+            /// 烘焙完成（无论成败）后清除；失败时不会每帧重试，直到源或 .meta 变化。
+            bool Stale = false;
+            bool BakeInFlight = false;
+            bool InvalidatedWhileBaking = false;
         };
 
-        struct RuntimeBakeCacheEntry
+        struct EnvironmentBakeRequest
         {
-            BakedEnvironmentLighting Lighting;
-            std::string SourceContentHash;
+            uint64_t HandleValue = 0;
             std::filesystem::path SourceFilesystemPath;
-            uint64_t MetaWriteTimeCount = 0;
+            std::filesystem::path CacheDirectory;
+            EnvironmentImportSettings Settings;
+            EnvironmentSourceFingerprint Fingerprint;
+            uint64_t Generation = 0;
+        };
+
+        struct EnvironmentBakeData
+        {
+            std::vector<float> EnvironmentFaces;
+            std::vector<float> IrradianceFaces;
+            std::vector<std::vector<float>> PrefilterMips;
+            bool Succeeded = false;
         };
 
         std::mutex s_SystemMutex;
         bool s_Initialized = false;
         Ref<Texture2D> s_SharedBrdfLookup;
         std::unordered_map<uint64_t, RuntimeBakeCacheEntry> s_RuntimeCache;
-
-        glm::vec3 SampleEquirectangular(const EquirectangularImage &image, const glm::vec3 &direction)
-        {
-            const glm::vec3 normalized = glm::normalize(direction);
-            const float longitude = std::atan2(normalized.z, normalized.x);
-            const float latitude = std::asin(glm::clamp(normalized.y, -1.0f, 1.0f));
-            float uniqueCoordinateX = (longitude + Pi) / (2.0f * Pi);
-            float uniqueCoordinateY = 0.5f - latitude / Pi;
-            uniqueCoordinateX = glm::clamp(uniqueCoordinateX, 0.0f, 1.0f);
-            uniqueCoordinateY = glm::clamp(uniqueCoordinateY, 0.0f, 1.0f);
-
-            const float sampleX = uniqueCoordinateX * static_cast<float>(image.Width - 1);
-            const float sampleY = uniqueCoordinateY * static_cast<float>(image.Height - 1);
-            const int x0 = static_cast<int>(sampleX);
-            const int y0 = static_cast<int>(sampleY);
-            const int x1 = std::min(x0 + 1, image.Width - 1);
-            const int y1 = std::min(y0 + 1, image.Height - 1);
-            const float fractionX = sampleX - static_cast<float>(x0);
-            const float fractionY = sampleY - static_cast<float>(y0);
-
-            auto fetch = [&](int x, int y) {
-                const size_t index = (static_cast<size_t>(y) * static_cast<size_t>(image.Width)
-                                     + static_cast<size_t>(x))
-                                    * 3u;
-                return glm::vec3(image.Rgb[index], image.Rgb[index + 1], image.Rgb[index + 2]);
-            };
-
-            const glm::vec3 color00 = fetch(x0, y0);
-            const glm::vec3 color10 = fetch(x1, y0);
-            const glm::vec3 color01 = fetch(x0, y1);
-            const glm::vec3 color11 = fetch(x1, y1);
-            const glm::vec3 color0 = glm::mix(color00, color10, fractionX);
-            const glm::vec3 color1 = glm::mix(color01, color11, fractionX);
-            return glm::mix(color0, color1, fractionY);
-        }
-
-        bool LoadEquirectangularHdr(const std::filesystem::path &path, EquirectangularImage &outImage)
-        {
-            const auto fileBytes = FileSystem::ReadBytes(path.string());
-            if (!fileBytes || fileBytes->empty())
-            {
-                HIMII_CORE_ERROR("Failed to read HDR environment: {0}", path.string());
-                return false;
-            }
-
-            int width = 0;
-            int height = 0;
-            int channels = 0;
-            stbi_set_flip_vertically_on_load(false);
-            float *data = stbi_loadf_from_memory(fileBytes->data(), static_cast<int>(fileBytes->size()), &width,
-                                                 &height, &channels, 3);
-            if (!data)
-            {
-                HIMII_CORE_ERROR("stbi_loadf failed for HDR: {0}", path.string());
-                return false;
-            }
-
-            outImage.Width = width;
-            outImage.Height = height;
-            outImage.Rgb.assign(data, data + static_cast<size_t>(width) * static_cast<size_t>(height) * 3u);
-            stbi_image_free(data);
-            return true;
-        }
-
-        void ConvertEquirectangularToCubemap(const EquirectangularImage &image, uint32_t resolution,
-                                             std::vector<float> &outFacesRgb)
-        {
-            outFacesRgb.assign(static_cast<size_t>(CubemapFaceCount) * resolution * resolution * 3u, 0.0f);
-            for (uint32_t faceIndex = 0; faceIndex < CubemapFaceCount; ++faceIndex)
-            {
-                for (uint32_t y = 0; y < resolution; ++y)
-                {
-                    for (uint32_t x = 0; x < resolution; ++x)
-                    {
-                        const glm::vec3 direction = DirectionFromFaceTexel(
-                                CubemapFaceFromIndex(faceIndex), x, y, resolution);
-                        const glm::vec3 color = SampleEquirectangular(image, direction);
-                        const size_t pixelIndex =
-                                (static_cast<size_t>(faceIndex) * resolution * resolution
-                                 + static_cast<size_t>(y) * resolution + x)
-                                * 3u;
-                        outFacesRgb[pixelIndex] = color.r;
-                        outFacesRgb[pixelIndex + 1] = color.g;
-                        outFacesRgb[pixelIndex + 2] = color.b;
-                    }
-                }
-            }
-        }
-
-        glm::vec3 SampleCubemapCpu(const std::vector<float> &facesRgb, uint32_t resolution,
-                                   const glm::vec3 &direction)
-        {
-            const CubemapFaceSample faceSample = FaceSampleFromDirection(direction);
-            const uint32_t faceIndex = CubemapFaceToIndex(faceSample.Face);
-            const int lastTexel = static_cast<int>(resolution - 1);
-            const float sampleX = faceSample.ImageU * static_cast<float>(lastTexel);
-            const float sampleY = faceSample.ImageV * static_cast<float>(lastTexel);
-            const int x0 = static_cast<int>(sampleX);
-            const int y0 = static_cast<int>(sampleY);
-            const int x1 = std::min(x0 + 1, lastTexel);
-            const int y1 = std::min(y0 + 1, lastTexel);
-            const float fractionX = sampleX - static_cast<float>(x0);
-            const float fractionY = sampleY - static_cast<float>(y0);
-
-            auto fetchTexel = [&](int texelX, int texelY) {
-                const size_t pixelIndex =
-                        (static_cast<size_t>(faceIndex) * resolution * resolution
-                         + static_cast<size_t>(texelY) * resolution + static_cast<size_t>(texelX))
-                        * 3u;
-                return glm::vec3(facesRgb[pixelIndex], facesRgb[pixelIndex + 1], facesRgb[pixelIndex + 2]);
-            };
-
-            const glm::vec3 color00 = fetchTexel(x0, y0);
-            const glm::vec3 color10 = fetchTexel(x1, y0);
-            const glm::vec3 color01 = fetchTexel(x0, y1);
-            const glm::vec3 color11 = fetchTexel(x1, y1);
-            const glm::vec3 color0 = glm::mix(color00, color10, fractionX);
-            const glm::vec3 color1 = glm::mix(color01, color11, fractionX);
-            return glm::mix(color0, color1, fractionY);
-        }
-
-        void ConvolveIrradiance(const std::vector<float> &environmentFaces, uint32_t environmentResolution,
-                                uint32_t irradianceResolution, std::vector<float> &outIrradianceFaces)
-        {
-            outIrradianceFaces.assign(static_cast<size_t>(CubemapFaceCount) * irradianceResolution
-                                              * irradianceResolution * 3u,
-                                      0.0f);
-            constexpr uint32_t sampleCountPhi = 32;
-            constexpr uint32_t sampleCountTheta = 16;
-
-            for (uint32_t faceIndex = 0; faceIndex < CubemapFaceCount; ++faceIndex)
-            {
-                for (uint32_t y = 0; y < irradianceResolution; ++y)
-                {
-                    for (uint32_t x = 0; x < irradianceResolution; ++x)
-                    {
-                        const glm::vec3 normal = DirectionFromFaceTexel(
-                                CubemapFaceFromIndex(faceIndex), x, y, irradianceResolution);
-                        glm::vec3 up = std::abs(normal.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f)
-                                                                   : glm::vec3(0.0f, 0.0f, 1.0f);
-                        const glm::vec3 right = glm::normalize(glm::cross(up, normal));
-                        up = glm::normalize(glm::cross(normal, right));
-
-                        glm::vec3 irradiance{0.0f};
-                        float sampleWeight = 0.0f;
-                        for (uint32_t phiIndex = 0; phiIndex < sampleCountPhi; ++phiIndex)
-                        {
-                            const float phi = 2.0f * Pi * (static_cast<float>(phiIndex) + 0.5f)
-                                              / static_cast<float>(sampleCountPhi);
-                            for (uint32_t thetaIndex = 0; thetaIndex < sampleCountTheta; ++thetaIndex)
-                            {
-                                const float theta = 0.5f * Pi * (static_cast<float>(thetaIndex) + 0.5f)
-                                                    / static_cast<float>(sampleCountTheta);
-                                const glm::vec3 tangentSample(std::sin(theta) * std::cos(phi),
-                                                              std::sin(theta) * std::sin(phi), std::cos(theta));
-                                const glm::vec3 sampleDirection =
-                                        tangentSample.x * right + tangentSample.y * up + tangentSample.z * normal;
-                                const glm::vec3 color =
-                                        SampleCubemapCpu(environmentFaces, environmentResolution, sampleDirection);
-                                irradiance += color * std::cos(theta) * std::sin(theta);
-                                sampleWeight += std::sin(theta);
-                            }
-                        }
-
-                        irradiance = Pi * irradiance / std::max(sampleWeight, 0.0001f);
-                        const size_t pixelIndex =
-                                (static_cast<size_t>(faceIndex) * irradianceResolution * irradianceResolution
-                                 + static_cast<size_t>(y) * irradianceResolution + x)
-                                * 3u;
-                        outIrradianceFaces[pixelIndex] = irradiance.r;
-                        outIrradianceFaces[pixelIndex + 1] = irradiance.g;
-                        outIrradianceFaces[pixelIndex + 2] = irradiance.b;
-                    }
-                }
-            }
-        }
-
-        float RadicalInverseVanDerCorput(uint32_t bits)
-        {
-            bits = (bits << 16u) | (bits >> 16u);
-            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
-            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
-            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
-            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
-            return static_cast<float>(bits) * 2.3283064365386963e-10f;
-        }
-
-        glm::vec2 Hammersley(uint32_t index, uint32_t total)
-        {
-            return {static_cast<float>(index) / static_cast<float>(total), RadicalInverseVanDerCorput(index)};
-        }
-
-        glm::vec3 ImportanceSampleGGX(glm::vec2 xi, glm::vec3 normal, float roughness)
-        {
-            const float alpha = roughness * roughness;
-            const float phi = 2.0f * Pi * xi.x;
-            const float cosineTheta =
-                    std::sqrt((1.0f - xi.y) / (1.0f + (alpha * alpha - 1.0f) * xi.y));
-            const float sineTheta = std::sqrt(std::max(0.0f, 1.0f - cosineTheta * cosineTheta));
-
-            glm::vec3 halfway(std::cos(phi) * sineTheta, std::sin(phi) * sineTheta, cosineTheta);
-            const glm::vec3 up = std::abs(normal.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f)
-                                                            : glm::vec3(1.0f, 0.0f, 0.0f);
-            const glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
-            const glm::vec3 bitangent = glm::cross(normal, tangent);
-            return glm::normalize(tangent * halfway.x + bitangent * halfway.y + normal * halfway.z);
-        }
-
-        void ConvolvePrefilter(const std::vector<float> &environmentFaces, uint32_t environmentResolution,
-                               uint32_t prefilterResolution, uint32_t mipCount,
-                               std::vector<std::vector<float>> &outMipFaces)
-        {
-            outMipFaces.resize(mipCount);
-            constexpr uint32_t sampleCount = PrefilterConvolutionSampleCount;
-
-            for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
-            {
-                const uint32_t mipSize = std::max(1u, prefilterResolution >> mipLevel);
-                const float roughness =
-                        mipCount <= 1 ? 0.0f
-                                      : static_cast<float>(mipLevel) / static_cast<float>(mipCount - 1);
-                outMipFaces[mipLevel].assign(static_cast<size_t>(CubemapFaceCount) * mipSize * mipSize * 3u, 0.0f);
-
-                for (uint32_t faceIndex = 0; faceIndex < CubemapFaceCount; ++faceIndex)
-                {
-                    for (uint32_t y = 0; y < mipSize; ++y)
-                    {
-                        for (uint32_t x = 0; x < mipSize; ++x)
-                        {
-                            const glm::vec3 normal =
-                                    DirectionFromFaceTexel(CubemapFaceFromIndex(faceIndex), x, y, mipSize);
-                            const glm::vec3 viewDirection = normal;
-
-                            glm::vec3 prefilteredColor{0.0f};
-                            float totalWeight = 0.0f;
-                            for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
-                            {
-                                const glm::vec2 xi = Hammersley(sampleIndex, sampleCount);
-                                const glm::vec3 halfway = ImportanceSampleGGX(xi, normal, roughness);
-                                const glm::vec3 lightDirection =
-                                        glm::normalize(2.0f * glm::dot(viewDirection, halfway) * halfway
-                                                       - viewDirection);
-                                const float normalDotLight = glm::max(glm::dot(normal, lightDirection), 0.0f);
-                                if (normalDotLight > 0.0f)
-                                {
-                                    prefilteredColor += SampleCubemapCpu(environmentFaces, environmentResolution,
-                                                                         lightDirection)
-                                                        * normalDotLight;
-                                    totalWeight += normalDotLight;
-                                }
-                            }
-
-                            prefilteredColor /= std::max(totalWeight, 0.0001f);
-                            const size_t pixelIndex =
-                                    (static_cast<size_t>(faceIndex) * mipSize * mipSize
-                                     + static_cast<size_t>(y) * mipSize + x)
-                                    * 3u;
-                            outMipFaces[mipLevel][pixelIndex] = prefilteredColor.r;
-                            outMipFaces[mipLevel][pixelIndex + 1] = prefilteredColor.g;
-                            outMipFaces[mipLevel][pixelIndex + 2] = prefilteredColor.b;
-                        }
-                    }
-                }
-            }
-        }
-
-        glm::vec2 IntegrateBrdf(float normalDotView, float roughness)
-        {
-            glm::vec3 viewDirection(std::sqrt(std::max(0.0f, 1.0f - normalDotView * normalDotView)), 0.0f,
-                                   normalDotView);
-            float scale = 0.0f;
-            float bias = 0.0f;
-            constexpr uint32_t sampleCount = 128;
-            const glm::vec3 normal(0.0f, 0.0f, 1.0f);
-
-            for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
-            {
-                const glm::vec2 xi = Hammersley(sampleIndex, sampleCount);
-                const glm::vec3 halfway = ImportanceSampleGGX(xi, normal, roughness);
-                const glm::vec3 lightDirection =
-                        glm::normalize(2.0f * glm::dot(viewDirection, halfway) * halfway - viewDirection);
-
-                const float normalDotLight = std::max(lightDirection.z, 0.0f);
-                const float normalDotHalfway = std::max(halfway.z, 0.0f);
-                const float viewDotHalfway = std::max(glm::dot(viewDirection, halfway), 0.0f);
-
-                if (normalDotLight > 0.0f)
-                {
-                    const float geometrySmith =
-                            (normalDotView / (normalDotView * (1.0f - roughness / 2.0f) + roughness / 2.0f))
-                            * (normalDotLight
-                               / (normalDotLight * (1.0f - roughness / 2.0f) + roughness / 2.0f));
-                    const float geometryVisibility =
-                            (geometrySmith * viewDotHalfway) / std::max(normalDotHalfway * normalDotView, 0.0001f);
-                    const float fresnelFactor = std::pow(1.0f - viewDotHalfway, 5.0f);
-                    scale += (1.0f - fresnelFactor) * geometryVisibility;
-                    bias += fresnelFactor * geometryVisibility;
-                }
-            }
-
-            scale /= static_cast<float>(sampleCount);
-            bias /= static_cast<float>(sampleCount);
-            return {scale, bias};
-        }
+        /// 最近一次交给渲染的有效结果；切换到尚未烘焙完成的环境时继续使用。
+        BakedEnvironmentLighting s_LastPresentedLighting;
+        /// Shutdown 时递增，丢弃之前投递、之后才完成的烘焙。
+        uint64_t s_BakeGeneration = 0;
+        std::chrono::steady_clock::time_point s_LastSourcePoll;
 
         Ref<Texture2D> GenerateBrdfLookupTexture(uint32_t size)
         {
@@ -427,47 +149,94 @@ namespace Himii
             return cubemap;
         }
 
-        std::filesystem::path MakeBakeCacheFilePath(AssetHandle handle, const std::string &sourceHash)
+        /// 源文件内容哈希（FNV-1a，按 8 字节字处理）。仅在工作线程、且 stat 指纹变化后才计算，
+        /// 只改了时间戳的源（touch / 版本库检出）仍能命中磁盘缓存。
+        std::string MakeBakeCacheFilePrefix(uint64_t handleValue)
+        {
+            std::ostringstream nameStream;
+            nameStream << std::hex << handleValue << "_";
+            return nameStream.str();
+        }
+
+        std::filesystem::path MakeBakeCacheFilePath(const std::filesystem::path &cacheDirectory, uint64_t handleValue,
+                                                    uint64_t contentHash)
         {
             std::ostringstream nameStream;
-            nameStream << std::hex << static_cast<uint64_t>(handle) << "_" << sourceHash << ".ienv";
-            return Project::GetEnvironmentBakeCacheDirectory() / nameStream.str();
+            nameStream << MakeBakeCacheFilePrefix(handleValue) << std::hex << std::setw(16) << std::setfill('0')
+                       << contentHash << ".ienv";
+            return cacheDirectory / nameStream.str();
+        }
+
+        /// 同一环境只保留当前内容对应的缓存文件。
+        void RemoveSupersededBakeCacheFiles(const std::filesystem::path &currentCacheFile, uint64_t handleValue)
+        {
+            const std::string prefix = MakeBakeCacheFilePrefix(handleValue);
+            std::error_code iterateError;
+            for (const auto &entry : std::filesystem::directory_iterator(currentCacheFile.parent_path(), iterateError))
+            {
+                const std::string fileName = entry.path().filename().string();
+                if (entry.path() == currentCacheFile || entry.path().extension() != ".ienv"
+                    || fileName.compare(0, prefix.size(), prefix) != 0)
+                    continue;
+                std::error_code removeError;
+                std::filesystem::remove(entry.path(), removeError);
+            }
         }
 
-        bool WriteBakeCacheFile(const std::filesystem::path &path, uint32_t cubemapResolution,
-                                const std::vector<float> &environmentFaces, uint32_t irradianceResolution,
-                                const std::vector<float> &irradianceFaces, uint32_t prefilterResolution,
-                                uint32_t prefilterMipCount, const std::vector<std::vector<float>> &prefilterMips)
+        bool WriteBakeCacheFile(const std::filesystem::path &path, const EnvironmentImportSettings &settings,
+                                const EnvironmentBakeData &bakeData)
         {
             std::error_code createError;
             std::filesystem::create_directories(path.parent_path(), createError);
-            std::ofstream file(path, std::ios::binary);
-            if (!file.is_open())
-                return false;
 
-            file.write(BakeCacheMagic, sizeof(BakeCacheMagic));
-            file.write(reinterpret_cast<const char *>(&BakeCacheVersion), sizeof(BakeCacheVersion));
-            file.write(reinterpret_cast<const char *>(&cubemapResolution), sizeof(cubemapResolution));
-            file.write(reinterpret_cast<const char *>(environmentFaces.data()),
-                       static_cast<std::streamsize>(environmentFaces.size() * sizeof(float)));
-            file.write(reinterpret_cast<const char *>(&irradianceResolution), sizeof(irradianceResolution));
-            file.write(reinterpret_cast<const char *>(irradianceFaces.data()),
-                       static_cast<std::streamsize>(irradianceFaces.size() * sizeof(float)));
-            file.write(reinterpret_cast<const char *>(&prefilterResolution), sizeof(prefilterResolution));
-            file.write(reinterpret_cast<const char *>(&prefilterMipCount), sizeof(prefilterMipCount));
-            for (uint32_t mipLevel = 0; mipLevel < prefilterMipCount; ++mipLevel)
+            // 写临时文件后整体替换：中途失败或进程退出不会留下截断的缓存，读取方也不会读到半个文件。
+            std::filesystem::path temporaryPath = path;
+            temporaryPath += ".tmp";
+
+            bool written = false;
             {
-                file.write(reinterpret_cast<const char *>(prefilterMips[mipLevel].data()),
-                           static_cast<std::streamsize>(prefilterMips[mipLevel].size() * sizeof(float)));
+                std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                    return false;
+
+                const uint32_t irradianceMethod = static_cast<uint32_t>(settings.IrradianceMethod);
+                file.write(BakeCacheMagic, sizeof(BakeCacheMagic));
+                file.write(reinterpret_cast<const char *>(&BakeCacheVersion), sizeof(BakeCacheVersion));
+                file.write(reinterpret_cast<const char *>(&irradianceMethod), sizeof(irradianceMethod));
+                file.write(reinterpret_cast<const char *>(&settings.CubemapResolution),
+                           sizeof(settings.CubemapResolution));
+                file.write(reinterpret_cast<const char *>(bakeData.EnvironmentFaces.data()),
+                           static_cast<std::streamsize>(bakeData.EnvironmentFaces.size() * sizeof(float)));
+                file.write(reinterpret_cast<const char *>(&settings.IrradianceResolution),
+                           sizeof(settings.IrradianceResolution));
+                file.write(reinterpret_cast<const char *>(bakeData.IrradianceFaces.data()),
+                           static_cast<std::streamsize>(bakeData.IrradianceFaces.size() * sizeof(float)));
+                file.write(reinterpret_cast<const char *>(&settings.PrefilterResolution),
+                           sizeof(settings.PrefilterResolution));
+                file.write(reinterpret_cast<const char *>(&settings.PrefilterMipCount),
+                           sizeof(settings.PrefilterMipCount));
+                for (const std::vector<float> &mipFaces : bakeData.PrefilterMips)
+                {
+                    file.write(reinterpret_cast<const char *>(mipFaces.data()),
+                               static_cast<std::streamsize>(mipFaces.size() * sizeof(float)));
+                }
+                file.close();
+                written = !file.fail();
             }
-            return static_cast<bool>(file);
+
+            std::error_code errorCode;
+            if (written)
+                std::filesystem::rename(temporaryPath, path, errorCode);
+            if (!written || errorCode)
+            {
+                std::filesystem::remove(temporaryPath, errorCode);
+                return false;
+            }
+            return true;
         }
 
-        bool ReadBakeCacheFile(const std::filesystem::path &path, uint32_t expectedCubemapResolution,
-                               uint32_t expectedIrradianceResolution, uint32_t expectedPrefilterResolution,
-                               uint32_t expectedPrefilterMipCount, std::vector<float> &environmentFaces,
-                               std::vector<float> &irradianceFaces,
-                               std::vector<std::vector<float>> &prefilterMips)
+        bool ReadBakeCacheFile(const std::filesystem::path &path, const EnvironmentImportSettings &settings,
+                               EnvironmentBakeData &outBakeData)
         {
             std::ifstream file(path, std::ios::binary);
             if (!file.is_open())
@@ -483,53 +252,161 @@ namespace Himii
             if (version != BakeCacheVersion)
                 return false;
 
+            uint32_t irradianceMethod = 0;
+            file.read(reinterpret_cast<char *>(&irradianceMethod), sizeof(irradianceMethod));
+            if (irradianceMethod != static_cast<uint32_t>(settings.IrradianceMethod))
+                return false;
+
             uint32_t cubemapResolution = 0;
             file.read(reinterpret_cast<char *>(&cubemapResolution), sizeof(cubemapResolution));
-            if (cubemapResolution != expectedCubemapResolution)
+            if (cubemapResolution != settings.CubemapResolution)
                 return false;
 
-            environmentFaces.resize(static_cast<size_t>(6) * cubemapResolution * cubemapResolution * 3u);
-            file.read(reinterpret_cast<char *>(environmentFaces.data()),
-                      static_cast<std::streamsize>(environmentFaces.size() * sizeof(float)));
+            outBakeData.EnvironmentFaces.resize(static_cast<size_t>(6) * cubemapResolution * cubemapResolution * 3u);
+            file.read(reinterpret_cast<char *>(outBakeData.EnvironmentFaces.data()),
+                      static_cast<std::streamsize>(outBakeData.EnvironmentFaces.size() * sizeof(float)));
 
             uint32_t irradianceResolution = 0;
             file.read(reinterpret_cast<char *>(&irradianceResolution), sizeof(irradianceResolution));
-            if (irradianceResolution != expectedIrradianceResolution)
+            if (irradianceResolution != settings.IrradianceResolution)
                 return false;
-            irradianceFaces.resize(static_cast<size_t>(6) * irradianceResolution * irradianceResolution * 3u);
-            file.read(reinterpret_cast<char *>(irradianceFaces.data()),
-                      static_cast<std::streamsize>(irradianceFaces.size() * sizeof(float)));
+            outBakeData.IrradianceFaces.resize(static_cast<size_t>(6) * irradianceResolution * irradianceResolution
+                                               * 3u);
+            file.read(reinterpret_cast<char *>(outBakeData.IrradianceFaces.data()),
+                      static_cast<std::streamsize>(outBakeData.IrradianceFaces.size() * sizeof(float)));
 
             uint32_t prefilterResolution = 0;
             uint32_t prefilterMipCount = 0;
             file.read(reinterpret_cast<char *>(&prefilterResolution), sizeof(prefilterResolution));
             file.read(reinterpret_cast<char *>(&prefilterMipCount), sizeof(prefilterMipCount));
-            if (prefilterResolution != expectedPrefilterResolution
-                || prefilterMipCount != expectedPrefilterMipCount)
+            if (prefilterResolution != settings.PrefilterResolution || prefilterMipCount != settings.PrefilterMipCount)
                 return false;
 
-            prefilterMips.resize(prefilterMipCount);
+            outBakeData.PrefilterMips.resize(prefilterMipCount);
             for (uint32_t mipLevel = 0; mipLevel < prefilterMipCount; ++mipLevel)
             {
                 const uint32_t mipSize = std::max(1u, prefilterResolution >> mipLevel);
-                prefilterMips[mipLevel].resize(static_cast<size_t>(6) * mipSize * mipSize * 3u);
-                file.read(reinterpret_cast<char *>(prefilterMips[mipLevel].data()),
-                          static_cast<std::streamsize>(prefilterMips[mipLevel].size() * sizeof(float)));
+                std::vector<float> &mipFaces = outBakeData.PrefilterMips[mipLevel];
+                mipFaces.resize(static_cast<size_t>(6) * mipSize * mipSize * 3u);
+                file.read(reinterpret_cast<char *>(mipFaces.data()),
+                          static_cast<std::streamsize>(mipFaces.size() * sizeof(float)));
             }
 
             return static_cast<bool>(file);
         }
 
-        uint64_t QueryMetaWriteTimeCount(const std::filesystem::path &metaPath)
+        void BakeFromEquirectangular(const EquirectangularImage &equirectangular,
+                                     const EnvironmentImportSettings &settings, EnvironmentBakeData &outBakeData)
         {
-            std::error_code errorCode;
-            const auto writeTime = std::filesystem::last_write_time(metaPath, errorCode);
-            if (errorCode)
-                return 0;
-            return static_cast<uint64_t>(writeTime.time_since_epoch().count());
+            ConvertEquirectangularToCubemap(equirectangular, settings.CubemapResolution, outBakeData.EnvironmentFaces);
+            const CubemapSamplingSource environment =
+                    BuildSamplingSource(outBakeData.EnvironmentFaces, settings.CubemapResolution);
+            ComputeIrradiance(settings.IrradianceMethod, outBakeData.EnvironmentFaces, environment,
+                              settings.IrradianceResolution, outBakeData.IrradianceFaces);
+            ConvolvePrefilter(environment, settings.PrefilterResolution, settings.PrefilterMipCount,
+                              outBakeData.PrefilterMips);
+        }
+
+        /// 工作线程执行：优先读盘缓存，未命中时完整烘焙并写回。不访问 GL 与共享状态。
+        void RunEnvironmentBake(const EnvironmentBakeRequest &request, EnvironmentBakeData &outBakeData)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            const auto fileBytes = FileSystem::ReadBytes(request.SourceFilesystemPath.string());
+            if (!fileBytes || fileBytes->empty())
+            {
+                HIMII_CORE_ERROR("Failed to read HDR environment: {0}", request.SourceFilesystemPath.string());
+                return;
+            }
+
+            const std::filesystem::path cacheFilePath =
+                    MakeBakeCacheFilePath(request.CacheDirectory, request.HandleValue, HashContent(fileBytes->data(), fileBytes->size()));
+            if (ReadBakeCacheFile(cacheFilePath, request.Settings, outBakeData))
+            {
+                outBakeData.Succeeded = true;
+                return;
+            }
+
+            const EnvironmentImportSettings &settings = request.Settings;
+            HIMII_CORE_INFO("Baking environment IBL for {0} ({1} cubemap, {2} prefilter, {3} samples, {4} workers)...",
+                            request.SourceFilesystemPath.string(), settings.CubemapResolution,
+                            settings.PrefilterResolution, EnvironmentPrefilterSampleCount,
+                            JobSystem::GetWorkerCount());
+            Timer bakeTimer;
+            EquirectangularImage equirectangular;
+            if (!DecodeEquirectangularHdr(request.SourceFilesystemPath, *fileBytes, equirectangular))
+                return;
+
+            BakeFromEquirectangular(equirectangular, settings, outBakeData);
+            outBakeData.Succeeded = true;
+            if (!WriteBakeCacheFile(cacheFilePath, settings, outBakeData))
+            {
+                HIMII_CORE_WARNING("Failed to persist environment bake cache: {0}", cacheFilePath.string());
+                return;
+            }
+
+            HIMII_CORE_INFO("Environment bake cache written in {0:.1f} ms: {1}", bakeTimer.ElapsedMillis(),
+                            cacheFilePath.string());
+            RemoveSupersededBakeCacheFiles(cacheFilePath, request.HandleValue);
+        }
+
+        /// 主线程执行：上传 GPU 资源并替换缓存条目；在此之前旧结果一直保持绑定。
+        void CompleteEnvironmentBake(const EnvironmentBakeRequest &request, EnvironmentBakeData &bakeData)
+        {
+            {
+                std::scoped_lock lock(s_SystemMutex);
+                if (request.Generation != s_BakeGeneration)
+                    return;
+            }
+
+            BakedEnvironmentLighting lighting;
+            if (bakeData.Succeeded)
+            {
+                const EnvironmentImportSettings &settings = request.Settings;
+                lighting.EnvironmentCubemap = UploadCubemapFaces(bakeData.EnvironmentFaces, settings.CubemapResolution,
+                                                                 false);
+                lighting.IrradianceCubemap = UploadCubemapFaces(bakeData.IrradianceFaces,
+                                                                settings.IrradianceResolution, false);
+                lighting.PrefilteredCubemap = UploadPrefilteredCubemap(bakeData.PrefilterMips,
+                                                                       settings.PrefilterResolution);
+                lighting.BrdfLookupTexture = EnvironmentLightingSystem::GetSharedBrdfLookupTexture();
+                lighting.Valid = lighting.EnvironmentCubemap && lighting.IrradianceCubemap
+                                 && lighting.PrefilteredCubemap && lighting.BrdfLookupTexture;
+            }
+
+            std::scoped_lock lock(s_SystemMutex);
+            if (request.Generation != s_BakeGeneration)
+                return;
+
+            RuntimeBakeCacheEntry &entry = s_RuntimeCache[request.HandleValue];
+            entry.SourceFilesystemPath = request.SourceFilesystemPath;
+            entry.Fingerprint = request.Fingerprint;
+            entry.Stale = entry.InvalidatedWhileBaking;
+            entry.InvalidatedWhileBaking = false;
+            entry.BakeInFlight = false;
+            if (lighting.Valid)
+                entry.Lighting = std::move(lighting);
+        }
+
+        /// 调用方需持有 s_SystemMutex。
+        BakedEnvironmentLighting GetPendingFallbackLighting(const RuntimeBakeCacheEntry *entry)
+        {
+            BakedEnvironmentLighting fallback =
+                    entry && entry->Lighting.Valid ? entry->Lighting : s_LastPresentedLighting;
+            fallback.Pending = true;
+            return fallback;
         }
     }
 
+    EnvironmentSourceFingerprint EnvironmentSourceFingerprint::Query(const std::filesystem::path &sourcePath)
+    {
+        EnvironmentSourceFingerprint fingerprint;
+        fingerprint.Source = PlatformFileSystem::QueryFileFingerprint(sourcePath);
+        fingerprint.Meta =
+                PlatformFileSystem::QueryFileFingerprint(EnvironmentMapImportSerializer::GetMetaPath(sourcePath));
+        return fingerprint;
+    }
+
     void EnvironmentLightingSystem::Init()
     {
         std::scoped_lock lock(s_SystemMutex);
@@ -542,7 +419,9 @@ namespace Himii
     void EnvironmentLightingSystem::Shutdown()
     {
         std::scoped_lock lock(s_SystemMutex);
+        ++s_BakeGeneration;
         s_RuntimeCache.clear();
+        s_LastPresentedLighting = {};
         s_SharedBrdfLookup.reset();
         s_Initialized = false;
     }
@@ -555,27 +434,40 @@ namespace Himii
         return s_SharedBrdfLookup;
     }
 
+    bool EnvironmentLightingSystem::IsBakePending(AssetHandle environmentMapHandle)
+    {
+        std::scoped_lock lock(s_SystemMutex);
+        const auto cacheIterator = s_RuntimeCache.find(static_cast<uint64_t>(environmentMapHandle));
+        return cacheIterator != s_RuntimeCache.end() && cacheIterator->second.BakeInFlight;
+    }
+
     void EnvironmentLightingSystem::Invalidate(AssetHandle environmentMapHandle)
     {
         std::scoped_lock lock(s_SystemMutex);
-        s_RuntimeCache.erase(static_cast<uint64_t>(environmentMapHandle));
+        const auto cacheIterator = s_RuntimeCache.find(static_cast<uint64_t>(environmentMapHandle));
+        if (cacheIterator == s_RuntimeCache.end())
+            return;
+        cacheIterator->second.Stale = true;
+        if (cacheIterator->second.BakeInFlight)
+            cacheIterator->second.InvalidatedWhileBaking = true;
     }
 
     void EnvironmentLightingSystem::PollSourceChanges()
     {
         std::scoped_lock lock(s_SystemMutex);
-        std::vector<uint64_t> staleHandles;
-        for (const auto &[handleValue, entry] : s_RuntimeCache)
+        const auto now = std::chrono::steady_clock::now();
+        if (now - s_LastSourcePoll < SourcePollInterval)
+            return;
+        s_LastSourcePoll = now;
+
+        // 每个环境两次 stat，代价与 HDR 大小无关；内容哈希留给工作线程上的烘焙任务。
+        for (auto &[handleValue, entry] : s_RuntimeCache)
         {
-            const std::string currentHash =
-                    EnvironmentMapImportSerializer::ComputeSourceContentHash(entry.SourceFilesystemPath);
-            const uint64_t metaWriteTime = QueryMetaWriteTimeCount(
-                    EnvironmentMapImportSerializer::GetMetaPath(entry.SourceFilesystemPath));
-            if (currentHash != entry.SourceContentHash || metaWriteTime != entry.MetaWriteTimeCount)
-                staleHandles.push_back(handleValue);
+            if (entry.Stale || entry.BakeInFlight)
+                continue;
+            if (EnvironmentSourceFingerprint::Query(entry.SourceFilesystemPath) != entry.Fingerprint)
+                entry.Stale = true;
         }
-        for (uint64_t handleValue : staleHandles)
-            s_RuntimeCache.erase(handleValue);
     }
 
     BakedEnvironmentLighting EnvironmentLightingSystem::EnsureBaked(AssetHandle environmentMapHandle)
@@ -594,6 +486,25 @@ namespace Himii
         if (!assetBase || assetBase->GetType() != AssetType::EnvironmentMap)
             return result;
 
+        // 缓存仍有效时不碰 .meta：源变更由 PollSourceChanges / Invalidate 标记为过期。
+        const uint64_t handleValue = static_cast<uint64_t>(environmentMapHandle);
+        {
+            std::scoped_lock lock(s_SystemMutex);
+            const auto cacheIterator = s_RuntimeCache.find(handleValue);
+            if (cacheIterator != s_RuntimeCache.end())
+            {
+                const RuntimeBakeCacheEntry &entry = cacheIterator->second;
+                if (entry.BakeInFlight)
+                    return GetPendingFallbackLighting(&entry);
+                if (!entry.Stale)
+                {
+                    if (entry.Lighting.Valid)
+                        s_LastPresentedLighting = entry.Lighting;
+                    return entry.Lighting;
+                }
+            }
+        }
+
         Ref<EnvironmentMapAsset> environmentAsset = std::static_pointer_cast<EnvironmentMapAsset>(assetBase);
         std::filesystem::path sourcePath = environmentAsset->SourceFilePath;
         if (!sourcePath.is_absolute())
@@ -604,82 +515,33 @@ namespace Himii
         EnvironmentMapImportSerializer::Deserialize(sourcePath, settings);
         environmentAsset->ImportSettings = settings;
 
-        const uint64_t handleValue = static_cast<uint64_t>(environmentMapHandle);
-        const uint64_t metaWriteTime =
-                QueryMetaWriteTimeCount(EnvironmentMapImportSerializer::GetMetaPath(sourcePath));
-
+        // 指纹在 EnsureDefaultMeta 可能重写 .meta 之后再取，避免自身写入触发下一次重烘焙。
+        auto request = CreateRef<EnvironmentBakeRequest>();
+        request->HandleValue = handleValue;
+        request->SourceFilesystemPath = sourcePath;
+        request->CacheDirectory = Project::GetEnvironmentBakeCacheDirectory();
+        request->Settings = settings;
+        request->Fingerprint = EnvironmentSourceFingerprint::Query(sourcePath);
         {
             std::scoped_lock lock(s_SystemMutex);
-            const auto cacheIterator = s_RuntimeCache.find(handleValue);
-            if (cacheIterator != s_RuntimeCache.end()
-                && cacheIterator->second.SourceContentHash == settings.SourceContentHash
-                && cacheIterator->second.MetaWriteTimeCount == metaWriteTime
-                && cacheIterator->second.Lighting.Valid)
-            {
-                return cacheIterator->second.Lighting;
-            }
-        }
-
-        std::vector<float> environmentFaces;
-        std::vector<float> irradianceFaces;
-        std::vector<std::vector<float>> prefilterMips;
-        const std::filesystem::path cachePath =
-                MakeBakeCacheFilePath(environmentMapHandle, settings.SourceContentHash);
-
-        const bool loadedFromDisk = ReadBakeCacheFile(cachePath, settings.CubemapResolution,
-                                                      settings.IrradianceResolution, settings.PrefilterResolution,
-                                                      settings.PrefilterMipCount, environmentFaces, irradianceFaces,
-                                                      prefilterMips);
-        if (!loadedFromDisk)
-        {
-            HIMII_CORE_INFO("Baking environment IBL for {0} ({1} cubemap, {2} prefilter, {3} samples)...",
-                            sourcePath.string(), settings.CubemapResolution, settings.PrefilterResolution,
-                            PrefilterConvolutionSampleCount);
-            const auto bakeStart = std::chrono::steady_clock::now();
-            EquirectangularImage equirectangular;
-            if (!LoadEquirectangularHdr(sourcePath, equirectangular))
-                return result;
-
-            ConvertEquirectangularToCubemap(equirectangular, settings.CubemapResolution, environmentFaces);
-            ConvolveIrradiance(environmentFaces, settings.CubemapResolution, settings.IrradianceResolution,
-                               irradianceFaces);
-            ConvolvePrefilter(environmentFaces, settings.CubemapResolution, settings.PrefilterResolution,
-                              settings.PrefilterMipCount, prefilterMips);
-            const auto bakeElapsedMilliseconds =
-                    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()
-                                                                          - bakeStart)
-                            .count();
-            if (!WriteBakeCacheFile(cachePath, settings.CubemapResolution, environmentFaces,
-                                    settings.IrradianceResolution, irradianceFaces, settings.PrefilterResolution,
-                                    settings.PrefilterMipCount, prefilterMips))
-            {
-                HIMII_CORE_WARNING("Failed to persist environment bake cache: {0}", cachePath.string());
-            }
-            else
-            {
-                HIMII_CORE_INFO("Environment bake cache written in {0} ms: {1}", bakeElapsedMilliseconds,
-                                cachePath.string());
-            }
+            s_RuntimeCache[handleValue].BakeInFlight = true;
+            request->Generation = s_BakeGeneration;
         }
 
-        result.EnvironmentCubemap = UploadCubemapFaces(environmentFaces, settings.CubemapResolution, false);
-        result.IrradianceCubemap = UploadCubemapFaces(irradianceFaces, settings.IrradianceResolution, false);
-        result.PrefilteredCubemap = UploadPrefilteredCubemap(prefilterMips, settings.PrefilterResolution);
-        result.BrdfLookupTexture = GetSharedBrdfLookupTexture();
-        result.Valid = result.EnvironmentCubemap && result.IrradianceCubemap && result.PrefilteredCubemap
-                       && result.BrdfLookupTexture;
-
-        if (result.Valid)
-        {
-            std::scoped_lock lock(s_SystemMutex);
-            RuntimeBakeCacheEntry entry;
-            entry.Lighting = result;
-            entry.SourceContentHash = settings.SourceContentHash;
-            entry.SourceFilesystemPath = sourcePath;
-            entry.MetaWriteTimeCount = metaWriteTime;
-            s_RuntimeCache[handleValue] = std::move(entry);
-        }
+        // JobSystem 未启动时 Submit 同步执行两段回调，下面的查询即可拿到新结果。
+        auto bakeData = CreateRef<EnvironmentBakeData>();
+        JobSystem::Submit([request, bakeData]() { RunEnvironmentBake(*request, *bakeData); },
+                          [request, bakeData]() { CompleteEnvironmentBake(*request, *bakeData); });
 
-        return result;
+        std::scoped_lock lock(s_SystemMutex);
+        const auto cacheIterator = s_RuntimeCache.find(handleValue);
+        if (cacheIterator == s_RuntimeCache.end())
+            return result;
+        const RuntimeBakeCacheEntry &entry = cacheIterator->second;
+        if (entry.BakeInFlight)
+            return GetPendingFallbackLighting(&entry);
+        if (entry.Lighting.Valid)
+            s_LastPresentedLighting = entry.Lighting;
+        return entry.Lighting;
     }
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "EngineCore/Core/Core.h"
+#include "EngineCore/Utils/PlatformUtils.h"
 #include "Module/Render/RenderCore/Texture.h"
 #include "Resource/Asset.h"
 
+#include <filesystem>
+
 namespace Himii
 {
     struct BakedEnvironmentLighting
@@ -13,6 +16,23 @@ namespace Himii
         Ref<TextureCube> PrefilteredCubemap;
         Ref<Texture2D> BrdfLookupTexture;
         bool Valid = false;
+        /// 请求的结果仍在后台烘焙，当前返回的是旧结果（可能无效）。
+        bool Pending = false;
+    };
+
+    /// 源 HDR 与其 .meta 的 stat 指纹；只比较元数据，代价与 HDR 大小无关。
+    struct EnvironmentSourceFingerprint
+    {
+        PlatformFileFingerprint Source;
+        PlatformFileFingerprint Meta;
+
+        static EnvironmentSourceFingerprint Query(const std::filesystem::path &sourcePath);
+
+        bool operator==(const EnvironmentSourceFingerprint &other) const
+        {
+            return Source == other.Source && Meta == other.Meta;
+        }
+        bool operator!=(const EnvironmentSourceFingerprint &other) const { return !(*this == other); }
     };
 
     /// Split-Sum IBL：源 HDR → 缓存卷积 → GPU 立方体 / LUT。
@@ -23,9 +43,13 @@ namespace Himii
         static void Shutdown();
 
         static Ref<Texture2D> GetSharedBrdfLookupTexture();
+        /// 缓存未命中时把读盘 / 烘焙投递到 JobSystem 并立即返回（Pending）：
+        /// 该句柄变更前的结果或最近一次使用的结果保持绑定，直到新结果在主线程上传完成。
         static BakedEnvironmentLighting EnsureBaked(AssetHandle environmentMapHandle);
+        static bool IsBakePending(AssetHandle environmentMapHandle);
         static void Invalidate(AssetHandle environmentMapHandle);
-        /// 检测源 HDR / .meta 变更并丢弃过期缓存（可每帧轻量调用）。
+        /// 比较源 HDR / .meta 的 stat 指纹并标记过期缓存；内部按 250 ms 节流，可每帧调用。
+        /// EnsureBaked 命中缓存时不再读取 .meta，源变更只经此处或 Invalidate 感知。
         static void PollSourceChanges();
     };
 }
@@ -11,6 +11,28 @@
 
 namespace Himii
 {
+    namespace
+    {
+        const char *IrradianceMethodToString(EnvironmentIrradianceMethod method)
+        {
+            switch (method)
+            {
+                case EnvironmentIrradianceMethod::SphericalHarmonics:
+                    return "SphericalHarmonics";
+                case EnvironmentIrradianceMethod::Convolution:
+                    return "Convolution";
+            }
+            return "SphericalHarmonics";
+        }
+
+        EnvironmentIrradianceMethod IrradianceMethodFromString(const std::string &value)
+        {
+            if (value == "Convolution")
+                return EnvironmentIrradianceMethod::Convolution;
+            return EnvironmentIrradianceMethod::SphericalHarmonics;
+        }
+    }
+
     std::filesystem::path EnvironmentMapImportSerializer::GetMetaPath(
             const std::filesystem::path &environmentFilesystemPath)
     {
@@ -63,6 +85,8 @@ namespace Himii
                 outSettings.PrefilterMipCount = data["PrefilterMipCount"].as<uint32_t>();
             if (data["BrdfLookupSize"])
                 outSettings.BrdfLookupSize = data["BrdfLookupSize"].as<uint32_t>();
+            if (data["IrradianceMethod"])
+                outSettings.IrradianceMethod = IrradianceMethodFromString(data["IrradianceMethod"].as<std::string>());
             if (data["SourceContentHash"])
                 outSettings.SourceContentHash = data["SourceContentHash"].as<std::string>();
             return true;
@@ -89,6 +113,7 @@ namespace Himii
             out << YAML::Key << "PrefilterResolution" << YAML::Value << settings.PrefilterResolution;
             out << YAML::Key << "PrefilterMipCount" << YAML::Value << settings.PrefilterMipCount;
             out << YAML::Key << "BrdfLookupSize" << YAML::Value << settings.BrdfLookupSize;
+            out << YAML::Key << "IrradianceMethod" << YAML::Value << IrradianceMethodToString(settings.IrradianceMethod);
             out << YAML::Key << "SourceContentHash" << YAML::Value << settings.SourceContentHash;
             out << YAML::EndMap;
 
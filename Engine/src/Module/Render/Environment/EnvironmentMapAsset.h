@@ -8,6 +8,14 @@
 
 namespace Himii
 {
+    enum class EnvironmentIrradianceMethod : uint8_t
+    {
+        /// 对源立方体一次投影到 9 系数球谐，再逐像素求值；远快于卷积，低频漫反射误差可忽略。
+        SphericalHarmonics = 0,
+        /// 逐像素半球积分（32×16 采样），保留更多高频细节。
+        Convolution = 1
+    };
+
     struct EnvironmentImportSettings
     {
         uint32_t CubemapResolution = 512;
@@ -15,6 +23,7 @@ namespace Himii
         uint32_t PrefilterResolution = 256;
         uint32_t PrefilterMipCount = 5;
         uint32_t BrdfLookupSize = 256;
+        EnvironmentIrradianceMethod IrradianceMethod = EnvironmentIrradianceMethod::SphericalHarmonics;
         std::string SourceContentHash;
     };
 
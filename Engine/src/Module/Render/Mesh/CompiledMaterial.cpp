@@ -0,0 +1,274 @@
+#include "Hepch.h"
+#include "Module/Render/Mesh/CompiledMaterial.h"
+#include "Module/Render/Mesh/MaterialAsset.h"
+#include "Module/Render/Shader/ShaderAsset.h"
+#include "Module/Render/Shader/ShaderCompilationService.h"
+#include "Module/Render/RenderCore/Texture.h"
+#include "Module/Render/RenderCore/UniformBuffer.h"
+#include "Resource/AssetManager.h"
+
+#include <cstring>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr uint32_t Std140VectorAlignment = 16;
+
+        struct Std140FieldLayout
+        {
+            uint32_t Size = 0;
+            uint32_t Alignment = 0;
+        };
+
+        Std140FieldLayout GetStd140FieldLayout(ShaderPropertyType type)
+        {
+            switch (type)
+            {
+                case ShaderPropertyType::Float:
+                case ShaderPropertyType::Int:
+                case ShaderPropertyType::Bool:
+                    return {4, 4};
+                case ShaderPropertyType::Vector2:
+                    return {8, 8};
+                case ShaderPropertyType::Vector3:
+                    return {12, 16};
+                case ShaderPropertyType::Color:
+                case ShaderPropertyType::Vector4:
+                    return {16, 16};
+                case ShaderPropertyType::Texture2D:
+                    break;
+            }
+            return {};
+        }
+
+        void AppendParameterField(MaterialParameterBlock &block, const ShaderPropertyDefinition &definition,
+                                  const MaterialParameterValue &value)
+        {
+            const Std140FieldLayout layout = GetStd140FieldLayout(definition.Type);
+            if (layout.Size == 0)
+                return;
+
+            const uint32_t offset = (static_cast<uint32_t>(block.Data.size()) + layout.Alignment - 1)
+                                    & ~(layout.Alignment - 1);
+            block.Data.resize(offset + layout.Size, 0);
+            uint8_t *destination = block.Data.data() + offset;
+
+            switch (definition.Type)
+            {
+                case ShaderPropertyType::Float:
+                    std::memcpy(destination, &value.FloatValue, sizeof(float));
+                    break;
+                case ShaderPropertyType::Int:
+                    std::memcpy(destination, &value.IntValue, sizeof(int));
+                    break;
+                case ShaderPropertyType::Bool:
+                {
+                    const int boolValue = value.BoolValue ? 1 : 0;
+                    std::memcpy(destination, &boolValue, sizeof(int));
+                    break;
+                }
+                case ShaderPropertyType::Vector2:
+                    std::memcpy(destination, &value.Vector2Value, sizeof(glm::vec2));
+                    break;
+                case ShaderPropertyType::Vector3:
+                    std::memcpy(destination, &value.Vector3Value, sizeof(glm::vec3));
+                    break;
+                case ShaderPropertyType::Color:
+                    std::memcpy(destination, &value.ColorValue, sizeof(glm::vec4));
+                    break;
+                case ShaderPropertyType::Vector4:
+                    std::memcpy(destination, &value.Vector4Value, sizeof(glm::vec4));
+                    break;
+                case ShaderPropertyType::Texture2D:
+                    break;
+            }
+
+            MaterialParameterBlockField field;
+            field.Name = definition.Name;
+            field.Type = definition.Type;
+            field.Offset = offset;
+            block.Fields.push_back(std::move(field));
+        }
+
+        void FinalizeParameterBlock(MaterialParameterBlock &block)
+        {
+            // std140 uniform block 的总大小按 vec4 对齐。
+            const size_t alignedSize = (block.Data.size() + Std140VectorAlignment - 1) & ~size_t(Std140VectorAlignment - 1);
+            block.Data.resize(alignedSize, 0);
+        }
+
+        Ref<Texture2D> LoadTexture(AssetManager *assetManager, AssetHandle textureHandle)
+        {
+            if (textureHandle == 0 || !assetManager)
+                return nullptr;
+
+            Ref<Asset> textureBase = assetManager->GetAsset(textureHandle);
+            if (!textureBase || textureBase->GetType() != AssetType::Texture2D)
+                return nullptr;
+            return std::static_pointer_cast<Texture2D>(textureBase);
+        }
+
+        Ref<CompiledMaterial> CreateDefaultCompiledMaterial()
+        {
+            Ref<CompiledMaterial> compiledMaterial = CreateRef<CompiledMaterial>();
+            compiledMaterial->Surface = GetEngineDefaultLitSurface();
+            if (compiledMaterial->Surface.ShaderAssetReference)
+                compiledMaterial->ShaderProgramAtCompile =
+                        compiledMaterial->Surface.ShaderAssetReference->CompiledShader;
+            return compiledMaterial;
+        }
+    }
+
+    Ref<CompiledMaterial> CompileMaterial(AssetManager *assetManager, const MaterialAsset &materialAsset)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Ref<ShaderAsset> shaderAsset = ResolveShaderAsset(assetManager, materialAsset.ShaderHandle);
+        Ref<CompiledMaterial> compiledMaterial = shaderAsset ? CreateRef<CompiledMaterial>()
+                                                             : CreateDefaultCompiledMaterial();
+        compiledMaterial->ShaderHandle = materialAsset.ShaderHandle;
+        compiledMaterial->MaterialVersion = materialAsset.GetParameterVersion();
+        compiledMaterial->AssetGeneration = assetManager ? assetManager->GetAssetGeneration() : 0;
+        if (!shaderAsset)
+            return compiledMaterial;
+
+        ResolvedMaterialSurface &surface = compiledMaterial->Surface;
+        surface.ShaderAssetReference = shaderAsset;
+        surface.ShaderProgram = ShaderCompilationService::GetOrCompileShader(shaderAsset);
+        surface.UsesLitPipeline = shaderAsset->PipelineType == ShaderPipelineType::SpatialLit;
+        compiledMaterial->ShaderProgramAtCompile = shaderAsset->CompiledShader;
+
+        // 属性定义只遍历一次：同时产出参数块、纹理绑定表与内置管线使用的固定字段。
+        AssetHandle metallicTextureHandle = 0;
+        AssetHandle roughnessTextureHandle = 0;
+        MaterialParameterBlock &block = compiledMaterial->ParameterBlock;
+        for (const ShaderPropertyDefinition &definition : shaderAsset->PropertyDefinitions)
+        {
+            const MaterialParameterValue value = ResolveMaterialParameterValue(materialAsset, definition);
+            if (definition.Type != ShaderPropertyType::Texture2D)
+            {
+                AppendParameterField(block, definition, value);
+                if (definition.Name == "u_AlbedoColor")
+                    surface.AlbedoColor = value.ColorValue;
+                else if (definition.Name == "u_Metallic")
+                    surface.Metallic = value.FloatValue;
+                else if (definition.Name == "u_Roughness")
+                    surface.Roughness = value.FloatValue;
+                else if (definition.Name == "u_NormalFlipGreen")
+                    surface.NormalFlipGreen = value.BoolValue;
+                continue;
+            }
+
+            Ref<Texture2D> texture = LoadTexture(assetManager, value.TextureHandle);
+            if (definition.Name == "u_AlbedoTexture")
+                surface.AlbedoTexture = texture;
+            else if (definition.Name == "u_MetallicTexture")
+            {
+                surface.MetallicTexture = texture;
+                metallicTextureHandle = value.TextureHandle;
+            }
+            else if (definition.Name == "u_RoughnessTexture")
+            {
+                surface.RoughnessTexture = texture;
+                roughnessTextureHandle = value.TextureHandle;
+            }
+            else if (definition.Name == "u_NormalTexture")
+                surface.NormalTexture = texture;
+
+            if (texture && definition.TextureBinding >= 0)
+            {
+                MaterialTextureBinding binding;
+                binding.Slot = static_cast<uint32_t>(definition.TextureBinding);
+                binding.TextureHandle = value.TextureHandle;
+                binding.Texture = texture;
+                compiledMaterial->TextureBindings.push_back(std::move(binding));
+            }
+        }
+        FinalizeParameterBlock(block);
+        // 上面按需加载的纹理会递增代次，取加载之后的值，避免下一帧再编译一次。
+        compiledMaterial->AssetGeneration = assetManager ? assetManager->GetAssetGeneration() : 0;
+        surface.SharedMetallicRoughnessTexture =
+                metallicTextureHandle != 0 && metallicTextureHandle == roughnessTextureHandle;
+
+        if (!shaderAsset->IsBuiltin && !block.Data.empty())
+        {
+            const uint32_t blockSize = static_cast<uint32_t>(block.Data.size());
+            compiledMaterial->ParameterBuffer = UniformBuffer::Create(blockSize, MaterialParameterBlockBinding);
+            compiledMaterial->ParameterBuffer->SetData(block.Data.data(), blockSize);
+        }
+        return compiledMaterial;
+    }
+
+    bool IsCompiledMaterialCurrent(const CompiledMaterial &compiledMaterial, const MaterialAsset &materialAsset,
+                                   const AssetManager *assetManager)
+    {
+        if (compiledMaterial.MaterialVersion != materialAsset.GetParameterVersion()
+            || compiledMaterial.ShaderHandle != materialAsset.ShaderHandle)
+            return false;
+
+        const uint64_t assetGeneration = assetManager ? assetManager->GetAssetGeneration() : 0;
+        if (compiledMaterial.AssetGeneration != assetGeneration)
+            return false;
+
+        // 着色器源码在编辑器中修改后会替换 CompiledShader。
+        const Ref<ShaderAsset> &shaderAsset = compiledMaterial.Surface.ShaderAssetReference;
+        return !shaderAsset || shaderAsset->CompiledShader == compiledMaterial.ShaderProgramAtCompile;
+    }
+
+    const CompiledMaterial &GetOrCompileMaterial(AssetManager *assetManager, MaterialAsset &materialAsset,
+                                                 bool *outRecompiled)
+    {
+        const bool needsCompile =
+                !materialAsset.Compiled || !IsCompiledMaterialCurrent(*materialAsset.Compiled, materialAsset, assetManager);
+        if (needsCompile)
+            materialAsset.Compiled = CompileMaterial(assetManager, materialAsset);
+        if (outRecompiled)
+            *outRecompiled = needsCompile;
+        return *materialAsset.Compiled;
+    }
+
+    const CompiledMaterial *ResolveCompiledMaterial(AssetManager *assetManager, AssetHandle materialHandle,
+                                                    CompiledMaterialSlot &slot, bool *outRecompiled)
+    {
+        if (outRecompiled)
+            *outRecompiled = false;
+
+        if (materialHandle == 0 || !assetManager)
+        {
+            slot = {};
+            return nullptr;
+        }
+
+        // 缺失的材质不缓存：之后导入时无需等代次变化即可生效。
+        if (!slot.Material || slot.MaterialHandle != materialHandle
+            || slot.AssetGeneration != assetManager->GetAssetGeneration())
+        {
+            slot.MaterialHandle = materialHandle;
+            slot.Material = nullptr;
+            Ref<Asset> materialBase = assetManager->GetAsset(materialHandle);
+            if (!materialBase || materialBase->GetType() != AssetType::Material)
+                return nullptr;
+            slot.Material = std::static_pointer_cast<MaterialAsset>(materialBase);
+        }
+
+        const CompiledMaterial &compiledMaterial = GetOrCompileMaterial(assetManager, *slot.Material, outRecompiled);
+        slot.AssetGeneration = compiledMaterial.AssetGeneration;
+        return &compiledMaterial;
+    }
+
+    const CompiledMaterial &GetOrCompileDefaultMaterial(Ref<CompiledMaterial> &cachedDefaultMaterial,
+                                                        bool *outRecompiled)
+    {
+        const bool needsCompile =
+                !cachedDefaultMaterial
+                || (cachedDefaultMaterial->Surface.ShaderAssetReference
+                    && cachedDefaultMaterial->Surface.ShaderAssetReference->CompiledShader
+                               != cachedDefaultMaterial->ShaderProgramAtCompile);
+        if (needsCompile)
+            cachedDefaultMaterial = CreateDefaultCompiledMaterial();
+        if (outRecompiled)
+            *outRecompiled = needsCompile;
+        return *cachedDefaultMaterial;
+    }
+}
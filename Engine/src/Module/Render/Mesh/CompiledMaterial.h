@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Module/Render/Mesh/MaterialSurfaceUtility.h"
+#include "EngineCore/Core/Core.h"
+
+#include <string>
+#include <vector>
+
+namespace Himii
+{
+    class UniformBuffer;
+
+    /// 自定义着色器读取材质参数块的 UBO 绑定点；内置 MeshLit / MeshUnlit 只读 MeshLitUniforms。
+    constexpr uint32_t MaterialParameterBlockBinding = 6;
+
+    struct MaterialParameterBlockField
+    {
+        std::string Name;
+        ShaderPropertyType Type = ShaderPropertyType::Float;
+        uint32_t Offset = 0;
+    };
+
+    /// 非纹理参数按声明顺序以 std140 规则排布；着色器端声明同序的 uniform block 即可直接读取。
+    /// Bool 按 int 存放，Color 与 Vector4 均为 vec4。
+    struct MaterialParameterBlock
+    {
+        std::vector<MaterialParameterBlockField> Fields;
+        std::vector<uint8_t> Data;
+    };
+
+    struct MaterialTextureBinding
+    {
+        uint32_t Slot = 0;
+        AssetHandle TextureHandle = 0;
+        Ref<Texture2D> Texture;
+    };
+
+    /// 材质编译结果：加载或编辑后生成一次，绘制时直接使用，不再按参数名查表或查资产。
+    struct CompiledMaterial
+    {
+        ResolvedMaterialSurface Surface;
+        MaterialParameterBlock ParameterBlock;
+        std::vector<MaterialTextureBinding> TextureBindings;
+        /// 仅自定义着色器且参数块非空时创建，编译时上传一次，绘制时只绑定。
+        Ref<UniformBuffer> ParameterBuffer;
+
+        // 以下字段判断结果是否过期。
+        AssetHandle ShaderHandle = 0;
+        uint32_t MaterialVersion = 0;
+        uint64_t AssetGeneration = 0;
+        Ref<Shader> ShaderProgramAtCompile;
+    };
+
+    /// 绘制方按材质槽持有的解析缓存（如 MeshComponent 每个槽位一个）。
+    /// 句柄与 AssetManager 资产代次都未变时直接复用，不再经 GetAsset 查表。
+    struct CompiledMaterialSlot
+    {
+        AssetHandle MaterialHandle = 0;
+        uint64_t AssetGeneration = 0;
+        Ref<MaterialAsset> Material;
+    };
+
+    Ref<CompiledMaterial> CompileMaterial(AssetManager *assetManager, const MaterialAsset &materialAsset);
+    bool IsCompiledMaterialCurrent(const CompiledMaterial &compiledMaterial, const MaterialAsset &materialAsset,
+                                   const AssetManager *assetManager);
+
+    /// 缓存有效时直接返回；参数版本、着色器或已加载资产变化时重新编译。
+    /// outRecompiled 可用于统计编译次数。
+    const CompiledMaterial &GetOrCompileMaterial(AssetManager *assetManager, MaterialAsset &materialAsset,
+                                                 bool *outRecompiled = nullptr);
+    /// 经 slot 取材质编译结果；材质无效或缺失时返回 nullptr，由调用方回退到默认材质。
+    const CompiledMaterial *ResolveCompiledMaterial(AssetManager *assetManager, AssetHandle materialHandle,
+                                                    CompiledMaterialSlot &slot, bool *outRecompiled = nullptr);
+    /// 引擎默认 Lit 表面的编译结果；缓存由调用方持有（Renderer3D 在 Shutdown 时释放）。
+    const CompiledMaterial &GetOrCompileDefaultMaterial(Ref<CompiledMaterial> &cachedDefaultMaterial,
+                                                        bool *outRecompiled = nullptr);
+}
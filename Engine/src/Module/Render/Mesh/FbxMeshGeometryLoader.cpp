@@ -1,6 +1,5 @@
 #include "Hepch.h"
 #include "Module/Render/Mesh/FbxMeshGeometryLoader.h"
-#include "Module/Render/Mesh/MeshTangentUtility.h"
 #include "EngineCore/Core/Log.h"
 
 #include <unordered_map>
@@ -22,141 +21,145 @@ namespace Himii
             return {value.x, value.y};
         }
 
-        void AppendMeshInstance(const ufbx_node *node,
-                                const std::unordered_map<const ufbx_material *, uint32_t> &materialSlotMap,
-                                MeshAsset &outMeshAsset, std::vector<uint32_t> &triangleIndicesScratch)
+        struct FbxMeshPartInstance
         {
-            if (!node || !node->mesh)
+            const ufbx_node *Node = nullptr;
+            size_t PartIndex = 0;
+        };
+
+        void CollectMeshPartInstances(const ufbx_node *node, std::vector<FbxMeshPartInstance> &outInstances)
+        {
+            if (!node || !node->mesh || !node->mesh->vertex_position.exists)
                 return;
 
+            const size_t materialPartCount =
+                    node->mesh->material_parts.count > 0 ? node->mesh->material_parts.count : 1;
+            for (size_t partIndex = 0; partIndex < materialPartCount; ++partIndex)
+                outInstances.push_back({node, partIndex});
+        }
+
+        /// 只读访问 ufbx_scene，可在多个工作线程上同时调用。
+        void DecodeMeshPart(const FbxMeshPartInstance &instance,
+                            const std::unordered_map<const ufbx_material *, uint32_t> &materialSlotMap,
+                            DecodedMeshPrimitive &outPrimitive)
+        {
+            const ufbx_node *node = instance.Node;
             const ufbx_mesh *mesh = node->mesh;
-            if (!mesh->vertex_position.exists)
-                return;
+            const size_t partIndex = instance.PartIndex;
 
             const ufbx_matrix &geometryToWorld = node->geometry_to_world;
             const ufbx_matrix normalMatrix = ufbx_matrix_for_normals(&geometryToWorld);
 
-            const size_t materialPartCount =
-                    mesh->material_parts.count > 0 ? mesh->material_parts.count : 1;
+            const bool hasMaterialParts = mesh->material_parts.count > 0;
+            size_t faceCount = mesh->faces.count;
+            const uint32_t *faceIndexList = nullptr;
+            if (hasMaterialParts)
+            {
+                const ufbx_mesh_part &part = mesh->material_parts.data[partIndex];
+                faceCount = part.num_faces;
+                faceIndexList = part.face_indices.data;
+                outPrimitive.Vertices.reserve(part.num_triangles * 3u);
+                outPrimitive.Indices.reserve(part.num_triangles * 3u);
+            }
 
-            for (size_t partIndex = 0; partIndex < materialPartCount; ++partIndex)
+            const ufbx_material *material = nullptr;
+            if (partIndex < node->materials.count)
+                material = node->materials.data[partIndex];
+            else if (partIndex < mesh->materials.count)
+                material = mesh->materials.data[partIndex];
+            if (material)
             {
-                const uint32_t indexStart = static_cast<uint32_t>(outMeshAsset.Indices.size());
-                uint32_t addedIndexCount = 0;
+                const auto materialIterator = materialSlotMap.find(material);
+                if (materialIterator != materialSlotMap.end())
+                    outPrimitive.MaterialSlotIndex = materialIterator->second;
+            }
 
-                const bool hasMaterialParts = mesh->material_parts.count > 0;
-                size_t faceCount = mesh->faces.count;
-                const uint32_t *faceIndexList = nullptr;
-                if (hasMaterialParts)
-                {
-                    const ufbx_mesh_part &part = mesh->material_parts.data[partIndex];
-                    faceCount = part.num_faces;
-                    faceIndexList = part.face_indices.data;
-                }
+            // 每个工作线程复用自己的三角化缓冲。
+            thread_local std::vector<uint32_t> triangleIndicesScratch;
+            const size_t requiredCapacity = static_cast<size_t>(mesh->max_face_triangles) * 3u;
+            if (triangleIndicesScratch.size() < requiredCapacity)
+                triangleIndicesScratch.resize(requiredCapacity);
 
-                uint32_t materialSlotIndex = 0;
-                const ufbx_material *material = nullptr;
-                if (partIndex < node->materials.count)
-                    material = node->materials.data[partIndex];
-                else if (partIndex < mesh->materials.count)
-                    material = mesh->materials.data[partIndex];
-                if (material)
-                {
-                    const auto materialIterator = materialSlotMap.find(material);
-                    if (materialIterator != materialSlotMap.end())
-                        materialSlotIndex = materialIterator->second;
-                }
+            for (size_t faceListIndex = 0; faceListIndex < faceCount; ++faceListIndex)
+            {
+                const uint32_t faceIndex = faceIndexList
+                        ? faceIndexList[faceListIndex]
+                        : static_cast<uint32_t>(faceListIndex);
+                if (faceIndex >= mesh->faces.count)
+                    continue;
 
-                for (size_t faceListIndex = 0; faceListIndex < faceCount; ++faceListIndex)
+                const ufbx_face face = mesh->faces.data[faceIndex];
+                if (face.num_indices < 3)
+                    continue;
+
+                const uint32_t triangleCount = ufbx_triangulate_face(
+                        triangleIndicesScratch.data(), triangleIndicesScratch.size(), mesh, face);
+                for (uint32_t triangleCorner = 0; triangleCorner < triangleCount * 3u; ++triangleCorner)
                 {
-                    const uint32_t faceIndex = faceIndexList
-                            ? faceIndexList[faceListIndex]
-                            : static_cast<uint32_t>(faceListIndex);
-                    if (faceIndex >= mesh->faces.count)
-                        continue;
-
-                    const ufbx_face face = mesh->faces.data[faceIndex];
-                    if (face.num_indices < 3)
-                        continue;
-
-                    const size_t requiredCapacity = static_cast<size_t>(mesh->max_face_triangles) * 3u;
-                    if (triangleIndicesScratch.size() < requiredCapacity)
-                        triangleIndicesScratch.resize(requiredCapacity);
-
-                    const uint32_t triangleCount = ufbx_triangulate_face(
-                            triangleIndicesScratch.data(), triangleIndicesScratch.size(), mesh, face);
-                    for (uint32_t triangleCorner = 0; triangleCorner < triangleCount * 3u; ++triangleCorner)
-                    {
-                        const uint32_t vertexIndex = triangleIndicesScratch[triangleCorner];
-                        MeshVertex vertex;
-                        const ufbx_vec3 localPosition =
-                                ufbx_get_vertex_vec3(&mesh->vertex_position, vertexIndex);
-                        vertex.Position = ToVec3(ufbx_transform_position(&geometryToWorld, localPosition));
+                    const uint32_t vertexIndex = triangleIndicesScratch[triangleCorner];
+                    MeshVertex vertex;
+                    const ufbx_vec3 localPosition =
+                            ufbx_get_vertex_vec3(&mesh->vertex_position, vertexIndex);
+                    vertex.Position = ToVec3(ufbx_transform_position(&geometryToWorld, localPosition));
 
-                        if (mesh->vertex_normal.exists)
-                        {
-                            const ufbx_vec3 localNormal =
-                                    ufbx_get_vertex_vec3(&mesh->vertex_normal, vertexIndex);
-                            vertex.Normal = glm::normalize(
-                                    ToVec3(ufbx_transform_direction(&normalMatrix, localNormal)));
-                        }
+                    if (mesh->vertex_normal.exists)
+                    {
+                        const ufbx_vec3 localNormal =
+                                ufbx_get_vertex_vec3(&mesh->vertex_normal, vertexIndex);
+                        vertex.Normal = glm::normalize(
+                                ToVec3(ufbx_transform_direction(&normalMatrix, localNormal)));
+                    }
 
-                        if (mesh->vertex_uv.exists)
-                        {
-                            const ufbx_vec2 localUv = ufbx_get_vertex_vec2(&mesh->vertex_uv, vertexIndex);
-                            vertex.TextureCoordinate = ToVec2(localUv);
-                        }
+                    if (mesh->vertex_uv.exists)
+                    {
+                        const ufbx_vec2 localUv = ufbx_get_vertex_vec2(&mesh->vertex_uv, vertexIndex);
+                        vertex.TextureCoordinate = ToVec2(localUv);
+                    }
 
-                        if (mesh->vertex_tangent.exists)
-                        {
-                            const ufbx_vec3 localTangent =
-                                    ufbx_get_vertex_vec3(&mesh->vertex_tangent, vertexIndex);
-                            const glm::vec3 worldTangent = glm::normalize(
-                                    ToVec3(ufbx_transform_direction(&normalMatrix, localTangent)));
-                            float handedness = 1.0f;
-                            if (mesh->vertex_bitangent.exists)
-                            {
-                                const ufbx_vec3 localBitangent =
-                                        ufbx_get_vertex_vec3(&mesh->vertex_bitangent, vertexIndex);
-                                const glm::vec3 worldBitangent = glm::normalize(
-                                        ToVec3(ufbx_transform_direction(&normalMatrix, localBitangent)));
-                                handedness = glm::dot(glm::cross(vertex.Normal, worldTangent), worldBitangent)
-                                                             < 0.0f
-                                                     ? -1.0f
-                                                     : 1.0f;
-                            }
-                            vertex.Tangent = glm::vec4(worldTangent, handedness);
-                        }
-                        else
+                    if (mesh->vertex_tangent.exists)
+                    {
+                        const ufbx_vec3 localTangent =
+                                ufbx_get_vertex_vec3(&mesh->vertex_tangent, vertexIndex);
+                        const glm::vec3 worldTangent = glm::normalize(
+                                ToVec3(ufbx_transform_direction(&normalMatrix, localTangent)));
+                        float handedness = 1.0f;
+                        if (mesh->vertex_bitangent.exists)
                         {
-                            vertex.Tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+                            const ufbx_vec3 localBitangent =
+                                    ufbx_get_vertex_vec3(&mesh->vertex_bitangent, vertexIndex);
+                            const glm::vec3 worldBitangent = glm::normalize(
+                                    ToVec3(ufbx_transform_direction(&normalMatrix, localBitangent)));
+                            handedness = glm::dot(glm::cross(vertex.Normal, worldTangent), worldBitangent)
+                                                         < 0.0f
+                                                 ? -1.0f
+                                                 : 1.0f;
                         }
-
-                        const uint32_t outputIndex = static_cast<uint32_t>(outMeshAsset.Vertices.size());
-                        outMeshAsset.Vertices.push_back(vertex);
-                        outMeshAsset.Indices.push_back(outputIndex);
-                        ++addedIndexCount;
+                        vertex.Tangent = glm::vec4(worldTangent, handedness);
+                    }
+                    else
+                    {
+                        vertex.Tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
                     }
-                }
-
-                if (addedIndexCount == 0)
-                    continue;
 
-                MeshSubmesh submesh;
-                submesh.IndexStart = indexStart;
-                submesh.IndexCount = addedIndexCount;
-                submesh.MaterialSlotIndex = materialSlotIndex;
-                outMeshAsset.Submeshes.push_back(submesh);
+                    const uint32_t outputIndex = static_cast<uint32_t>(outPrimitive.Vertices.size());
+                    outPrimitive.Vertices.push_back(vertex);
+                    outPrimitive.Indices.push_back(outputIndex);
+                }
             }
         }
     }
 
-    bool LoadFbxMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset)
+    bool LoadFbxMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset,
+                             MeshImportProgress *progress)
     {
+        HIMII_PROFILE_FUNCTION();
+
         outMeshAsset.Vertices.clear();
         outMeshAsset.Indices.clear();
         outMeshAsset.Submeshes.clear();
 
+        SetMeshImportStage(progress, MeshImportStage::Parsing);
+
         ufbx_load_opts loadOptions = {};
         loadOptions.generate_missing_normals = true;
 
@@ -175,10 +178,17 @@ namespace Himii
         for (size_t materialIndex = 0; materialIndex < scene->materials.count; ++materialIndex)
             materialSlotMap[scene->materials.data[materialIndex]] = static_cast<uint32_t>(materialIndex);
 
-        std::vector<uint32_t> triangleIndicesScratch;
+        std::vector<FbxMeshPartInstance> partInstances;
         for (size_t nodeIndex = 0; nodeIndex < scene->nodes.count; ++nodeIndex)
-            AppendMeshInstance(scene->nodes.data[nodeIndex], materialSlotMap, outMeshAsset,
-                               triangleIndicesScratch);
+            CollectMeshPartInstances(scene->nodes.data[nodeIndex], partInstances);
+
+        std::vector<DecodedMeshPrimitive> decodedPrimitives;
+        DecodeMeshPrimitivesParallel(
+                static_cast<uint32_t>(partInstances.size()),
+                [&](uint32_t instanceIndex, DecodedMeshPrimitive &outPrimitive)
+                { DecodeMeshPart(partInstances[instanceIndex], materialSlotMap, outPrimitive); },
+                decodedPrimitives, progress);
+        MergeDecodedMeshPrimitives(decodedPrimitives, outMeshAsset);
 
         ufbx_free_scene(scene);
 
@@ -197,9 +207,6 @@ namespace Himii
             outMeshAsset.Submeshes.push_back(submesh);
         }
 
-        if (MeshNeedsGeneratedTangents(outMeshAsset))
-            GenerateMeshTangents(outMeshAsset);
-
         return true;
     }
 }
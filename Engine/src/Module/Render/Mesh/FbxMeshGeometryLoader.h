@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Module/Render/Mesh/MeshAsset.h"
+#include "Module/Render/Mesh/MeshImportJobs.h"
 #include <filesystem>
 
 namespace Himii
 {
     /// 从 FBX 填充静态网格几何（不做材质旁路写出）。
-    bool LoadFbxMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset);
+    /// 各节点的材质分段在 JobSystem 工作线程上并行三角化与解码；progress 可为空。
+    bool LoadFbxMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset,
+                             MeshImportProgress *progress = nullptr);
 }
@@ -1,6 +1,5 @@
 #include "Hepch.h"
 #include "Module/Render/Mesh/GltfMeshGeometryLoader.h"
-#include "Module/Render/Mesh/MeshTangentUtility.h"
 #include "EngineCore/Core/Log.h"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -19,6 +18,14 @@ namespace Himii
             if (!accessor)
                 return false;
 
+            // 整块解包（含 sparse）；访问器分量数与期望不一致时退回逐元素读取。
+            if (cgltf_num_components(accessor->type) == componentCount)
+            {
+                const cgltf_size floatCount = static_cast<cgltf_size>(accessor->count) * componentCount;
+                outValues.resize(floatCount);
+                return cgltf_accessor_unpack_floats(accessor, outValues.data(), floatCount) == floatCount;
+            }
+
             outValues.resize(static_cast<size_t>(accessor->count) * componentCount);
             for (cgltf_size elementIndex = 0; elementIndex < accessor->count; ++elementIndex)
             {
@@ -38,6 +45,12 @@ namespace Himii
                 return false;
 
             outIndices.resize(static_cast<size_t>(accessor->count));
+            // unpack_indices 不处理 sparse 访问器，此时返回 0。
+            if (!accessor->is_sparse
+                && cgltf_accessor_unpack_indices(accessor, outIndices.data(), sizeof(uint32_t), accessor->count)
+                           == accessor->count)
+                return true;
+
             for (cgltf_size elementIndex = 0; elementIndex < accessor->count; ++elementIndex)
             {
                 outIndices[elementIndex] =
@@ -56,10 +69,17 @@ namespace Himii
             return nullptr;
         }
 
-        void AppendPrimitive(const cgltf_primitive *primitive, const glm::mat4 &worldTransform,
+        struct GltfPrimitiveInstance
+        {
+            const cgltf_primitive *Primitive = nullptr;
+            glm::mat4 WorldTransform{1.0f};
+        };
+
+        void DecodePrimitive(const GltfPrimitiveInstance &instance,
                              const std::unordered_map<const cgltf_material *, uint32_t> &materialSlotMap,
-                             MeshAsset &outMeshAsset)
+                             DecodedMeshPrimitive &outPrimitive)
         {
+            const cgltf_primitive *primitive = instance.Primitive;
             if (!primitive || primitive->type != cgltf_primitive_type_triangles)
                 return;
 
@@ -87,33 +107,38 @@ namespace Himii
             if (tangentAttribute && tangentAttribute->data)
                 ReadAccessorFloats(tangentAttribute->data, tangents, 4);
 
-            std::vector<uint32_t> localIndices;
+            const uint32_t vertexCount = static_cast<uint32_t>(positionAttribute->data->count);
+            std::vector<uint32_t> &localIndices = outPrimitive.Indices;
             if (primitive->indices)
             {
                 if (!ReadAccessorIndices(primitive->indices, localIndices))
+                {
+                    localIndices.clear();
                     return;
+                }
             }
             else
             {
-                const uint32_t vertexCount = static_cast<uint32_t>(positionAttribute->data->count);
                 localIndices.resize(vertexCount);
                 for (uint32_t index = 0; index < vertexCount; ++index)
                     localIndices[index] = index;
             }
 
+            const glm::mat4 &worldTransform = instance.WorldTransform;
             const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(worldTransform)));
-            const uint32_t vertexBase = static_cast<uint32_t>(outMeshAsset.Vertices.size());
-            const uint32_t vertexCount = static_cast<uint32_t>(positionAttribute->data->count);
+            const bool hasNormals = normals.size() >= static_cast<size_t>(vertexCount) * 3;
+            const bool hasTextureCoordinates = textureCoordinates.size() >= static_cast<size_t>(vertexCount) * 2;
+            const bool hasTangents = tangents.size() >= static_cast<size_t>(vertexCount) * 4;
 
-            outMeshAsset.Vertices.reserve(outMeshAsset.Vertices.size() + vertexCount);
+            outPrimitive.Vertices.resize(vertexCount);
             for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
             {
-                MeshVertex vertex;
+                MeshVertex &vertex = outPrimitive.Vertices[vertexIndex];
                 const glm::vec3 localPosition(positions[vertexIndex * 3 + 0], positions[vertexIndex * 3 + 1],
                                               positions[vertexIndex * 3 + 2]);
                 vertex.Position = glm::vec3(worldTransform * glm::vec4(localPosition, 1.0f));
 
-                if (normals.size() >= static_cast<size_t>(vertexCount) * 3)
+                if (hasNormals)
                 {
                     const glm::vec3 localNormal(normals[vertexIndex * 3 + 0], normals[vertexIndex * 3 + 1],
                                                 normals[vertexIndex * 3 + 2]);
@@ -124,13 +149,13 @@ namespace Himii
                     vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
                 }
 
-                if (textureCoordinates.size() >= static_cast<size_t>(vertexCount) * 2)
+                if (hasTextureCoordinates)
                 {
                     vertex.TextureCoordinate = {textureCoordinates[vertexIndex * 2 + 0],
                                                 textureCoordinates[vertexIndex * 2 + 1]};
                 }
 
-                if (tangents.size() >= static_cast<size_t>(vertexCount) * 4)
+                if (hasTangents)
                 {
                     const glm::vec3 localTangent(tangents[vertexIndex * 4 + 0], tangents[vertexIndex * 4 + 1],
                                                  tangents[vertexIndex * 4 + 2]);
@@ -141,55 +166,48 @@ namespace Himii
                 {
                     vertex.Tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
                 }
-
-                outMeshAsset.Vertices.push_back(vertex);
             }
 
-            MeshSubmesh submesh;
-            submesh.IndexStart = static_cast<uint32_t>(outMeshAsset.Indices.size());
-            submesh.IndexCount = static_cast<uint32_t>(localIndices.size());
-            submesh.MaterialSlotIndex = 0;
+            outPrimitive.MaterialSlotIndex = 0;
             if (primitive->material)
             {
                 auto materialIterator = materialSlotMap.find(primitive->material);
                 if (materialIterator != materialSlotMap.end())
-                    submesh.MaterialSlotIndex = materialIterator->second;
+                    outPrimitive.MaterialSlotIndex = materialIterator->second;
             }
-
-            outMeshAsset.Indices.reserve(outMeshAsset.Indices.size() + localIndices.size());
-            for (uint32_t localIndex : localIndices)
-                outMeshAsset.Indices.push_back(vertexBase + localIndex);
-            outMeshAsset.Submeshes.push_back(submesh);
         }
 
-        void ProcessNode(const cgltf_node *node, const std::unordered_map<const cgltf_material *, uint32_t> &materialSlotMap,
-                         MeshAsset &outMeshAsset)
+        void CollectNodePrimitives(const cgltf_node *node, std::vector<GltfPrimitiveInstance> &outInstances)
         {
             if (!node)
                 return;
 
-            cgltf_float worldMatrix[16];
-            cgltf_node_transform_world(node, worldMatrix);
-            const glm::mat4 worldTransform = glm::make_mat4(worldMatrix);
-
             if (node->mesh)
             {
+                cgltf_float worldMatrix[16];
+                cgltf_node_transform_world(node, worldMatrix);
+                const glm::mat4 worldTransform = glm::make_mat4(worldMatrix);
+
                 for (cgltf_size primitiveIndex = 0; primitiveIndex < node->mesh->primitives_count; ++primitiveIndex)
-                    AppendPrimitive(&node->mesh->primitives[primitiveIndex], worldTransform, materialSlotMap,
-                                    outMeshAsset);
+                    outInstances.push_back({&node->mesh->primitives[primitiveIndex], worldTransform});
             }
 
             for (cgltf_size childIndex = 0; childIndex < node->children_count; ++childIndex)
-                ProcessNode(node->children[childIndex], materialSlotMap, outMeshAsset);
+                CollectNodePrimitives(node->children[childIndex], outInstances);
         }
     }
 
-    bool LoadGltfMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset)
+    bool LoadGltfMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset,
+                              MeshImportProgress *progress)
     {
+        HIMII_PROFILE_FUNCTION();
+
         outMeshAsset.Vertices.clear();
         outMeshAsset.Indices.clear();
         outMeshAsset.Submeshes.clear();
 
+        SetMeshImportStage(progress, MeshImportStage::Parsing);
+
         cgltf_options options = {};
         cgltf_data *data = nullptr;
         cgltf_result result = cgltf_parse_file(&options, filesystemPath.string().c_str(), &data);
@@ -211,17 +229,19 @@ namespace Himii
         for (cgltf_size materialIndex = 0; materialIndex < data->materials_count; ++materialIndex)
             materialSlotMap[&data->materials[materialIndex]] = static_cast<uint32_t>(materialIndex);
 
+        // 先串行遍历节点收集（原始体, 世界变换），再把解码分发到工作线程。
+        std::vector<GltfPrimitiveInstance> primitiveInstances;
         if (data->scenes_count > 0 && data->scene)
         {
             for (cgltf_size nodeIndex = 0; nodeIndex < data->scene->nodes_count; ++nodeIndex)
-                ProcessNode(data->scene->nodes[nodeIndex], materialSlotMap, outMeshAsset);
+                CollectNodePrimitives(data->scene->nodes[nodeIndex], primitiveInstances);
         }
         else if (data->nodes_count > 0)
         {
             for (cgltf_size nodeIndex = 0; nodeIndex < data->nodes_count; ++nodeIndex)
             {
                 if (data->nodes[nodeIndex].parent == nullptr)
-                    ProcessNode(&data->nodes[nodeIndex], materialSlotMap, outMeshAsset);
+                    CollectNodePrimitives(&data->nodes[nodeIndex], primitiveInstances);
             }
         }
         else
@@ -233,12 +253,19 @@ namespace Himii
                 for (cgltf_size primitiveIndex = 0; primitiveIndex < data->meshes[meshIndex].primitives_count;
                      ++primitiveIndex)
                 {
-                    AppendPrimitive(&data->meshes[meshIndex].primitives[primitiveIndex], identity, materialSlotMap,
-                                    outMeshAsset);
+                    primitiveInstances.push_back({&data->meshes[meshIndex].primitives[primitiveIndex], identity});
                 }
             }
         }
 
+        std::vector<DecodedMeshPrimitive> decodedPrimitives;
+        DecodeMeshPrimitivesParallel(
+                static_cast<uint32_t>(primitiveInstances.size()),
+                [&](uint32_t instanceIndex, DecodedMeshPrimitive &outPrimitive)
+                { DecodePrimitive(primitiveInstances[instanceIndex], materialSlotMap, outPrimitive); },
+                decodedPrimitives, progress);
+        MergeDecodedMeshPrimitives(decodedPrimitives, outMeshAsset);
+
         cgltf_free(data);
 
         if (outMeshAsset.Vertices.empty() || outMeshAsset.Indices.empty())
@@ -257,9 +284,6 @@ namespace Himii
             outMeshAsset.Submeshes.push_back(submesh);
         }
 
-        if (MeshNeedsGeneratedTangents(outMeshAsset))
-            GenerateMeshTangents(outMeshAsset);
-
         return true;
     }
 }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Module/Render/Mesh/MeshAsset.h"
+#include "Module/Render/Mesh/MeshImportJobs.h"
 #include <filesystem>
 
 namespace Himii
 {
     /// 从 glTF/GLB 填充静态网格几何（不做材质旁路写出）。
-    bool LoadGltfMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset);
+    /// 原始体解码与切线生成在 JobSystem 工作线程上并行；progress 可为空。
+    bool LoadGltfMeshGeometry(const std::filesystem::path &filesystemPath, MeshAsset &outMeshAsset,
+                              MeshImportProgress *progress = nullptr);
 }
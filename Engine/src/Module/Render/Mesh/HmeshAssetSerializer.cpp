@@ -1,13 +1,17 @@
 #include "Hepch.h"
 #include "Module/Render/Mesh/HmeshAssetSerializer.h"
 #include "EngineCore/Core/Log.h"
+#include "EngineCore/Utils/PlatformUtils.h"
 
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 
 namespace Himii
 {
-    constexpr uint32_t HmeshFormatVersion = 2u;
+    constexpr uint32_t HmeshFormatVersion = 3u;
+    /// v2 无 meshlet 区段，仍可读取（按整段子网格绘制）。
+    constexpr uint32_t HmeshMinimumReadableFormatVersion = 2u;
 
     namespace
     {
@@ -21,13 +25,16 @@ namespace Himii
             uint32_t VertexCount = 0;
             uint32_t IndexCount = 0;
             uint32_t SubmeshCount = 0;
+            /// v3 起存在；v2 头部到 SubmeshCount 为止。
+            uint32_t MeshletCount = 0;
         };
 #pragma pack(pop)
 
-        static bool ReadExact(std::ifstream &inputStream, void *buffer, std::size_t byteCount)
+        constexpr size_t HmeshVersion2HeaderSize = offsetof(HmeshFileHeader, MeshletCount);
+
+        static size_t GetHeaderSizeForVersion(uint32_t version)
         {
-            inputStream.read(static_cast<char *>(buffer), static_cast<std::streamsize>(byteCount));
-            return inputStream.good();
+            return version >= 3u ? sizeof(HmeshFileHeader) : HmeshVersion2HeaderSize;
         }
 
         static bool WriteExact(std::ofstream &outputStream, const void *buffer, std::size_t byteCount)
@@ -50,94 +57,132 @@ namespace Himii
         header.VertexCount = static_cast<uint32_t>(meshAsset.Vertices.size());
         header.IndexCount = static_cast<uint32_t>(meshAsset.Indices.size());
         header.SubmeshCount = static_cast<uint32_t>(meshAsset.Submeshes.size());
+        header.MeshletCount = static_cast<uint32_t>(meshAsset.Meshlets.size());
+
+        // 已加载的网格可能仍映射着旧文件（导入可在工作线程进行）：先写临时文件再重命名替换，
+        // 避免原地截断导致映射读到越界页。
+        std::filesystem::path temporaryPath = filepath;
+        temporaryPath += ".tmp";
 
-        std::ofstream outputStream(filepath, std::ios::binary | std::ios::trunc);
-        if (!outputStream.is_open())
+        bool written = false;
         {
-            HIMII_CORE_ERROR("Failed to write .hmesh file: {0}", filepath.string());
-            return false;
+            std::ofstream outputStream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!outputStream.is_open())
+            {
+                HIMII_CORE_ERROR("Failed to write .hmesh file: {0}", filepath.string());
+                return false;
+            }
+
+            written = WriteExact(outputStream, &header, sizeof(HmeshFileHeader))
+                      && (header.VertexCount == 0
+                          || WriteExact(outputStream, meshAsset.Vertices.data(),
+                                        header.VertexCount * sizeof(MeshVertex)))
+                      && (header.IndexCount == 0
+                          || WriteExact(outputStream, meshAsset.Indices.data(),
+                                        header.IndexCount * sizeof(uint32_t)))
+                      && (header.SubmeshCount == 0
+                          || WriteExact(outputStream, meshAsset.Submeshes.data(),
+                                        header.SubmeshCount * sizeof(MeshSubmesh)))
+                      && (header.MeshletCount == 0
+                          || WriteExact(outputStream, meshAsset.Meshlets.data(),
+                                        header.MeshletCount * sizeof(MeshMeshlet)));
+            outputStream.close();
+            written = written && !outputStream.fail();
         }
 
-        if (!WriteExact(outputStream, &header, sizeof(HmeshFileHeader)))
-            return false;
-
-        if (header.VertexCount > 0
-            && !WriteExact(outputStream, meshAsset.Vertices.data(),
-                           header.VertexCount * sizeof(MeshVertex)))
-            return false;
+        std::error_code errorCode;
+        if (written)
+        {
+            std::filesystem::rename(temporaryPath, filepath, errorCode);
+            if (!errorCode)
+                return true;
+            HIMII_CORE_ERROR("Failed to replace .hmesh file {0}: {1}", filepath.string(), errorCode.message());
+        }
 
-        if (header.IndexCount > 0
-            && !WriteExact(outputStream, meshAsset.Indices.data(),
-                           header.IndexCount * sizeof(uint32_t)))
-            return false;
+        std::filesystem::remove(temporaryPath, errorCode);
+        return false;
+    }
 
-        if (header.SubmeshCount > 0
-            && !WriteExact(outputStream, meshAsset.Submeshes.data(),
-                           header.SubmeshCount * sizeof(MeshSubmesh)))
-            return false;
+    Ref<MeshAsset> HmeshAssetSerializer::Deserialize(const std::filesystem::path &filepath)
+    {
+        Ref<MeshAsset> meshAsset = CreateRef<MeshAsset>();
+        if (!MapGeometry(filepath, *meshAsset))
+            return nullptr;
 
-        return true;
+        meshAsset->SetSourceFilePath(filepath);
+        return meshAsset;
     }
 
-    Ref<MeshAsset> HmeshAssetSerializer::Deserialize(const std::filesystem::path &filepath)
+    bool HmeshAssetSerializer::MapGeometry(const std::filesystem::path &filepath, MeshAsset &meshAsset)
     {
-        std::ifstream inputStream(filepath, std::ios::binary);
-        if (!inputStream.is_open())
+        HIMII_PROFILE_FUNCTION();
+
+        Ref<PlatformMappedFile> mappedFile = CreateRef<PlatformMappedFile>();
+        if (!mappedFile->Open(filepath))
         {
             HIMII_CORE_ERROR("Failed to open .hmesh file: {0}", filepath.string());
-            return nullptr;
+            return false;
         }
 
         HmeshFileHeader header = {};
-        if (!ReadExact(inputStream, &header, sizeof(HmeshFileHeader)))
+        if (mappedFile->GetSize() < HmeshVersion2HeaderSize)
         {
             HIMII_CORE_ERROR("Failed to read .hmesh header: {0}", filepath.string());
-            return nullptr;
+            return false;
         }
+        std::memcpy(&header, mappedFile->GetData(), HmeshVersion2HeaderSize);
 
         if (std::memcmp(header.Magic, HmeshMagic, sizeof(HmeshMagic)) != 0)
         {
             HIMII_CORE_ERROR("Invalid .hmesh magic: {0}", filepath.string());
-            return nullptr;
+            return false;
         }
 
-        if (header.Version != HmeshFormatVersion)
+        if (header.Version < HmeshMinimumReadableFormatVersion || header.Version > HmeshFormatVersion)
         {
             HIMII_CORE_ERROR(
                     "Unsupported .hmesh version {0} in {1}. Reimport the source mesh to upgrade to version {2}.",
                     header.Version, filepath.string(), HmeshFormatVersion);
-            return nullptr;
-        }
-
-        Ref<MeshAsset> meshAsset = CreateRef<MeshAsset>();
-        meshAsset->Vertices.resize(header.VertexCount);
-        meshAsset->Indices.resize(header.IndexCount);
-        meshAsset->Submeshes.resize(header.SubmeshCount);
-
-        if (header.VertexCount > 0
-            && !ReadExact(inputStream, meshAsset->Vertices.data(),
-                          header.VertexCount * sizeof(MeshVertex)))
-        {
-            HIMII_CORE_ERROR("Failed to read .hmesh vertices: {0}", filepath.string());
-            return nullptr;
+            return false;
         }
 
-        if (header.IndexCount > 0
-            && !ReadExact(inputStream, meshAsset->Indices.data(),
-                          header.IndexCount * sizeof(uint32_t)))
+        const size_t headerSize = GetHeaderSizeForVersion(header.Version);
+        if (mappedFile->GetSize() < headerSize)
         {
-            HIMII_CORE_ERROR("Failed to read .hmesh indices: {0}", filepath.string());
-            return nullptr;
+            HIMII_CORE_ERROR("Failed to read .hmesh header: {0}", filepath.string());
+            return false;
         }
-
-        if (header.SubmeshCount > 0
-            && !ReadExact(inputStream, meshAsset->Submeshes.data(),
-                          header.SubmeshCount * sizeof(MeshSubmesh)))
+        std::memcpy(&header, mappedFile->GetData(), headerSize);
+
+        const uint64_t vertexOffset = headerSize;
+        const uint64_t indexOffset = vertexOffset + static_cast<uint64_t>(header.VertexCount) * sizeof(MeshVertex);
+        const uint64_t submeshOffset = indexOffset + static_cast<uint64_t>(header.IndexCount) * sizeof(uint32_t);
+        const uint64_t meshletOffset = submeshOffset + static_cast<uint64_t>(header.SubmeshCount) * sizeof(MeshSubmesh);
+        const uint64_t payloadEnd = meshletOffset + static_cast<uint64_t>(header.MeshletCount) * sizeof(MeshMeshlet);
+        if (payloadEnd > mappedFile->GetSize())
         {
-            HIMII_CORE_ERROR("Failed to read .hmesh submeshes: {0}", filepath.string());
-            return nullptr;
+            HIMII_CORE_ERROR("Truncated .hmesh payload ({0} bytes, expected {1}): {2}", mappedFile->GetSize(),
+                             payloadEnd, filepath.string());
+            return false;
         }
 
-        return meshAsset;
+        const uint8_t *fileBytes = mappedFile->GetData();
+        meshAsset.Submeshes.resize(header.SubmeshCount);
+        if (header.SubmeshCount > 0)
+            std::memcpy(meshAsset.Submeshes.data(), fileBytes + submeshOffset,
+                        header.SubmeshCount * sizeof(MeshSubmesh));
+        meshAsset.Meshlets.resize(header.MeshletCount);
+        if (header.MeshletCount > 0)
+            std::memcpy(meshAsset.Meshlets.data(), fileBytes + meshletOffset,
+                        header.MeshletCount * sizeof(MeshMeshlet));
+
+        // 头部 20/24 字节，顶点/索引区均保持 4 字节对齐，可直接按类型访问映射页。
+        const MeshVertex *mappedVertices = reinterpret_cast<const MeshVertex *>(fileBytes + vertexOffset);
+        const uint32_t *mappedIndices = reinterpret_cast<const uint32_t *>(fileBytes + indexOffset);
+        meshAsset.Vertices.clear();
+        meshAsset.Indices.clear();
+        meshAsset.SetMappedGeometry(std::move(mappedFile), mappedVertices, header.VertexCount, mappedIndices,
+                                    header.IndexCount);
+        return true;
     }
 }
@@ -12,5 +12,7 @@ namespace Himii
         static uint32_t GetCurrentFormatVersion();
         static bool Serialize(const std::filesystem::path &filepath, const MeshAsset &meshAsset);
         static Ref<MeshAsset> Deserialize(const std::filesystem::path &filepath);
+        /// 以只读映射打开 .hmesh，顶点/索引直接指向映射页（不拷贝），子网格表拷贝到 meshAsset。
+        static bool MapGeometry(const std::filesystem::path &filepath, MeshAsset &meshAsset);
     };
 }
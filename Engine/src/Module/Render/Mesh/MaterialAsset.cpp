@@ -6,6 +6,7 @@ namespace Himii
     void MaterialAsset::ClearParameterOverrides()
     {
         ParameterOverrides.clear();
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetFloatParameter(const std::string &name, float value)
@@ -14,6 +15,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Float;
         parameterValue.FloatValue = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetIntParameter(const std::string &name, int value)
@@ -22,6 +24,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Int;
         parameterValue.IntValue = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetBoolParameter(const std::string &name, bool value)
@@ -30,6 +33,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Bool;
         parameterValue.BoolValue = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetColorParameter(const std::string &name, const glm::vec4 &value)
@@ -38,6 +42,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Color;
         parameterValue.ColorValue = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetVector2Parameter(const std::string &name, const glm::vec2 &value)
@@ -46,6 +51,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Vector2;
         parameterValue.Vector2Value = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetVector3Parameter(const std::string &name, const glm::vec3 &value)
@@ -54,6 +60,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Vector3;
         parameterValue.Vector3Value = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetVector4Parameter(const std::string &name, const glm::vec4 &value)
@@ -62,6 +69,7 @@ namespace Himii
         parameterValue.Type = ShaderPropertyType::Vector4;
         parameterValue.Vector4Value = value;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     void MaterialAsset::SetTextureParameter(const std::string &name, AssetHandle textureHandle,
@@ -72,6 +80,7 @@ namespace Himii
         parameterValue.TextureHandle = textureHandle;
         parameterValue.TextureRelativePath = textureRelativePath;
         ParameterOverrides[name] = parameterValue;
+        MarkParametersChanged();
     }
 
     bool MaterialAsset::TryGetFloatParameter(const std::string &name, float &outValue) const
@@ -6,6 +6,8 @@
 
 namespace Himii
 {
+    struct CompiledMaterial;
+
     /// Material 实例：引用 Shader 模板并覆盖其声明参数。
     class MaterialAsset : public Asset
     {
@@ -14,6 +16,12 @@ namespace Himii
 
         AssetHandle ShaderHandle = 0;
         std::unordered_map<std::string, MaterialParameterValue> ParameterOverrides;
+        /// 编译后的参数块与纹理绑定表（见 CompiledMaterial.h），版本过期时由渲染器重建。
+        Ref<CompiledMaterial> Compiled;
+
+        /// Set*Parameter / ClearParameterOverrides 会自动递增；直接改写 ParameterOverrides 后需手动调用。
+        void MarkParametersChanged() { ++m_ParameterVersion; }
+        uint32_t GetParameterVersion() const { return m_ParameterVersion; }
 
         void ClearParameterOverrides();
         void SetFloatParameter(const std::string &name, float value);
@@ -35,5 +43,8 @@ namespace Himii
         bool TryGetVector4Parameter(const std::string &name, glm::vec4 &outValue) const;
         bool TryGetTextureParameter(const std::string &name, AssetHandle &outTextureHandle,
                                     std::string &outTextureRelativePath) const;
+
+    private:
+        uint32_t m_ParameterVersion = 1;
     };
 }
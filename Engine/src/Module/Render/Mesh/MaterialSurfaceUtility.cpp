@@ -1,5 +1,6 @@
 #include "Hepch.h"
 #include "Module/Render/Mesh/MaterialSurfaceUtility.h"
+#include "Module/Render/Mesh/CompiledMaterial.h"
 #include "Module/Render/Mesh/MaterialAsset.h"
 #include "Module/Render/Shader/BuiltinShaderRegistry.h"
 #include "Module/Render/Shader/ShaderAsset.h"
@@ -9,40 +10,6 @@
 
 namespace Himii
 {
-    namespace
-    {
-        Ref<Texture2D> ResolveTextureParameter(AssetManager *assetManager, const MaterialAsset &materialAsset,
-                                               const ShaderAsset &shaderAsset, const char *parameterName)
-        {
-            const ShaderPropertyDefinition *textureDefinition =
-                    shaderAsset.FindPropertyDefinition(parameterName);
-            if (!textureDefinition || !assetManager)
-                return nullptr;
-
-            const MaterialParameterValue textureValue =
-                    ResolveMaterialParameterValue(materialAsset, *textureDefinition);
-            if (textureValue.TextureHandle == 0)
-                return nullptr;
-
-            Ref<Asset> textureBase = assetManager->GetAsset(textureValue.TextureHandle);
-            if (!textureBase || textureBase->GetType() != AssetType::Texture2D)
-                return nullptr;
-
-            return std::static_pointer_cast<Texture2D>(textureBase);
-        }
-
-        AssetHandle ResolveTextureHandleParameter(const MaterialAsset &materialAsset,
-                                                  const ShaderAsset &shaderAsset, const char *parameterName)
-        {
-            const ShaderPropertyDefinition *textureDefinition =
-                    shaderAsset.FindPropertyDefinition(parameterName);
-            if (!textureDefinition)
-                return 0;
-
-            return ResolveMaterialParameterValue(materialAsset, *textureDefinition).TextureHandle;
-        }
-    }
-
     ResolvedMaterialSurface GetEngineDefaultLitSurface()
     {
         ResolvedMaterialSurface surface;
@@ -174,69 +141,8 @@ namespace Himii
 
     ResolvedMaterialSurface ResolveMaterialSurface(AssetManager *assetManager, AssetHandle materialHandle)
     {
-        if (materialHandle == 0 || !assetManager)
-            return GetEngineDefaultLitSurface();
-
-        Ref<Asset> materialBase = assetManager->GetAsset(materialHandle);
-        if (!materialBase || materialBase->GetType() != AssetType::Material)
-            return GetEngineDefaultLitSurface();
-
-        Ref<MaterialAsset> materialAsset = std::static_pointer_cast<MaterialAsset>(materialBase);
-        Ref<ShaderAsset> shaderAsset = ResolveShaderAsset(assetManager, materialAsset->ShaderHandle);
-        if (!shaderAsset)
-            return GetEngineDefaultLitSurface();
-
-        ResolvedMaterialSurface surface;
-        surface.ShaderAssetReference = shaderAsset;
-        surface.ShaderProgram = ShaderCompilationService::GetOrCompileShader(shaderAsset);
-        surface.UsesLitPipeline = shaderAsset->PipelineType == ShaderPipelineType::SpatialLit;
-
-        if (const ShaderPropertyDefinition *albedoColorDefinition =
-                    shaderAsset->FindPropertyDefinition("u_AlbedoColor"))
-        {
-            surface.AlbedoColor =
-                    ResolveMaterialParameterValue(*materialAsset, *albedoColorDefinition).ColorValue;
-        }
-
-        float metallicValue = 0.0f;
-        if (const ShaderPropertyDefinition *metallicDefinition =
-                    shaderAsset->FindPropertyDefinition("u_Metallic"))
-        {
-            metallicValue = ResolveMaterialParameterValue(*materialAsset, *metallicDefinition).FloatValue;
-        }
-        surface.Metallic = metallicValue;
-
-        float roughnessValue = 0.5f;
-        if (const ShaderPropertyDefinition *roughnessDefinition =
-                    shaderAsset->FindPropertyDefinition("u_Roughness"))
-        {
-            roughnessValue = ResolveMaterialParameterValue(*materialAsset, *roughnessDefinition).FloatValue;
-        }
-        surface.Roughness = roughnessValue;
-
-        surface.AlbedoTexture =
-                ResolveTextureParameter(assetManager, *materialAsset, *shaderAsset, "u_AlbedoTexture");
-        surface.MetallicTexture =
-                ResolveTextureParameter(assetManager, *materialAsset, *shaderAsset, "u_MetallicTexture");
-        surface.RoughnessTexture =
-                ResolveTextureParameter(assetManager, *materialAsset, *shaderAsset, "u_RoughnessTexture");
-        surface.NormalTexture =
-                ResolveTextureParameter(assetManager, *materialAsset, *shaderAsset, "u_NormalTexture");
-
-        if (const ShaderPropertyDefinition *normalFlipDefinition =
-                    shaderAsset->FindPropertyDefinition("u_NormalFlipGreen"))
-        {
-            surface.NormalFlipGreen =
-                    ResolveMaterialParameterValue(*materialAsset, *normalFlipDefinition).BoolValue;
-        }
-
-        const AssetHandle metallicHandle =
-                ResolveTextureHandleParameter(*materialAsset, *shaderAsset, "u_MetallicTexture");
-        const AssetHandle roughnessHandle =
-                ResolveTextureHandleParameter(*materialAsset, *shaderAsset, "u_RoughnessTexture");
-        surface.SharedMetallicRoughnessTexture =
-                metallicHandle != 0 && metallicHandle == roughnessHandle;
-
-        return surface;
+        CompiledMaterialSlot slot;
+        const CompiledMaterial *compiledMaterial = ResolveCompiledMaterial(assetManager, materialHandle, slot);
+        return compiledMaterial ? compiledMaterial->Surface : GetEngineDefaultLitSurface();
     }
 }
@@ -1,6 +1,8 @@
 #include "Hepch.h"
 #include "Module/Render/Mesh/MeshAsset.h"
+#include "Module/Render/Mesh/HmeshAssetSerializer.h"
 #include "Module/Render/RHI/RHI.h"
+#include "EngineCore/Utils/PlatformUtils.h"
 #include "EngineCore/Core/Log.h"
 
 namespace Himii
@@ -10,48 +12,135 @@ namespace Himii
         if (m_GpuReady)
             return;
 
+        // CPU 几何已在上次上传后释放（或从未载入）时，从源 .hmesh 重新建立映射。
+        if (!HasMappedGeometry() && Vertices.empty() && !m_SourceFilePath.empty())
+            HmeshAssetSerializer::MapGeometry(m_SourceFilePath, *this);
+
+        const MeshVertex *sourceVertices = HasMappedGeometry() ? m_MappedVertices : Vertices.data();
+        const uint32_t *sourceIndices = HasMappedGeometry() ? m_MappedIndices : Indices.data();
+        const uint32_t vertexCount = GetVertexCount();
+        const uint32_t indexCount = GetIndexCount();
+
         m_GpuSubmeshes.clear();
-        if (Vertices.empty() || Indices.empty() || Submeshes.empty())
+        m_GpuResidentBytes = 0;
+        if (vertexCount == 0 || indexCount == 0 || Submeshes.empty())
         {
             HIMII_CORE_WARNING("MeshAsset has empty geometry; skipping GPU upload.");
             m_GpuReady = true;
             return;
         }
 
-        Ref<VertexBuffer> sharedVertexBuffer =
-                RHI::CreateVertexBuffer(static_cast<uint32_t>(Vertices.size() * sizeof(MeshVertex)));
-        sharedVertexBuffer->SetData(Vertices.data(), static_cast<uint32_t>(Vertices.size() * sizeof(MeshVertex)));
+        // 直接从映射页（或 CPU 向量）上传，不经过中间拷贝。
+        const uint32_t vertexByteCount = static_cast<uint32_t>(vertexCount * sizeof(MeshVertex));
+        Ref<VertexBuffer> sharedVertexBuffer = RHI::CreateVertexBuffer(
+                reinterpret_cast<float *>(const_cast<MeshVertex *>(sourceVertices)), vertexByteCount);
         sharedVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
                                        {ShaderDataType::Float3, "a_Normal"},
                                        {ShaderDataType::Float2, "a_TextureCoordinate"},
                                        {ShaderDataType::Float4, "a_Tangent"}});
+        m_GpuResidentBytes += vertexByteCount;
 
-        for (const MeshSubmesh &submesh : Submeshes)
+        uint32_t meshletCursor = 0;
+        for (uint32_t submeshIndex = 0; submeshIndex < static_cast<uint32_t>(Submeshes.size()); ++submeshIndex)
         {
+            const MeshSubmesh &submesh = Submeshes[submeshIndex];
+            const uint32_t meshletStart = meshletCursor;
+            while (meshletCursor < Meshlets.size() && Meshlets[meshletCursor].SubmeshIndex == submeshIndex)
+                ++meshletCursor;
+
             if (submesh.IndexCount == 0)
                 continue;
-            if (submesh.IndexStart + submesh.IndexCount > Indices.size())
+            if (static_cast<uint64_t>(submesh.IndexStart) + submesh.IndexCount > indexCount)
             {
                 HIMII_CORE_ERROR("MeshAsset submesh index range out of bounds.");
                 continue;
             }
 
-            std::vector<uint32_t> submeshIndices(Indices.begin() + static_cast<std::ptrdiff_t>(submesh.IndexStart),
-                                                 Indices.begin()
-                                                         + static_cast<std::ptrdiff_t>(submesh.IndexStart
-                                                                                       + submesh.IndexCount));
-
             MeshSubmeshGpu gpuSubmesh;
             gpuSubmesh.VertexArray = RHI::CreateVertexArray();
             gpuSubmesh.VertexArray->AddVertexBuffer(sharedVertexBuffer);
-            Ref<IndexBuffer> indexBuffer =
-                    RHI::CreateIndexBuffer(submeshIndices.data(), static_cast<uint32_t>(submeshIndices.size()));
+            Ref<IndexBuffer> indexBuffer = RHI::CreateIndexBuffer(
+                    const_cast<uint32_t *>(sourceIndices + submesh.IndexStart), submesh.IndexCount);
             gpuSubmesh.VertexArray->SetIndexBuffer(indexBuffer);
-            gpuSubmesh.IndexCount = static_cast<uint32_t>(submeshIndices.size());
+            gpuSubmesh.IndexCount = submesh.IndexCount;
             gpuSubmesh.MaterialSlotIndex = submesh.MaterialSlotIndex;
+            gpuSubmesh.IndexStart = submesh.IndexStart;
+            gpuSubmesh.MeshletStart = meshletStart;
+            gpuSubmesh.MeshletCount = meshletCursor - meshletStart;
             m_GpuSubmeshes.push_back(std::move(gpuSubmesh));
+            m_GpuResidentBytes += static_cast<uint64_t>(submesh.IndexCount) * sizeof(uint32_t);
         }
 
         m_GpuReady = true;
+
+        if (m_RetainCpuGeometry)
+            AcquireCpuGeometry();
+        else
+            ReleaseCpuGeometry();
+    }
+
+    void MeshAsset::SetMappedGeometry(Ref<PlatformMappedFile> mappedFile, const MeshVertex *vertices,
+                                      uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount)
+    {
+        m_MappedFile = std::move(mappedFile);
+        m_MappedVertices = m_MappedFile ? vertices : nullptr;
+        m_MappedIndices = m_MappedFile ? indices : nullptr;
+        m_MappedVertexCount = m_MappedFile ? vertexCount : 0;
+        m_MappedIndexCount = m_MappedFile ? indexCount : 0;
+    }
+
+    void MeshAsset::SetRetainCpuGeometry(bool retainCpuGeometry)
+    {
+        m_RetainCpuGeometry = retainCpuGeometry;
+        if (retainCpuGeometry)
+            AcquireCpuGeometry();
+    }
+
+    bool MeshAsset::AcquireCpuGeometry()
+    {
+        m_RetainCpuGeometry = true;
+        if (!Vertices.empty() && !Indices.empty())
+            return true;
+
+        if (!HasMappedGeometry() && !m_SourceFilePath.empty())
+            HmeshAssetSerializer::MapGeometry(m_SourceFilePath, *this);
+        if (!HasMappedGeometry())
+            return false;
+
+        Vertices.assign(m_MappedVertices, m_MappedVertices + m_MappedVertexCount);
+        Indices.assign(m_MappedIndices, m_MappedIndices + m_MappedIndexCount);
+        SetMappedGeometry(nullptr, nullptr, 0, nullptr, 0);
+        return true;
+    }
+
+    void MeshAsset::ReleaseCpuGeometry()
+    {
+        m_RetainCpuGeometry = false;
+        if (!CanReloadCpuGeometry())
+            return;
+        SetMappedGeometry(nullptr, nullptr, 0, nullptr, 0);
+        std::vector<MeshVertex>().swap(Vertices);
+        std::vector<uint32_t>().swap(Indices);
+    }
+
+    uint32_t MeshAsset::GetVertexCount() const
+    {
+        return HasMappedGeometry() ? m_MappedVertexCount : static_cast<uint32_t>(Vertices.size());
+    }
+
+    uint32_t MeshAsset::GetIndexCount() const
+    {
+        return HasMappedGeometry() ? m_MappedIndexCount : static_cast<uint32_t>(Indices.size());
+    }
+
+    MeshMemoryStatistics MeshAsset::GetMemoryStatistics() const
+    {
+        MeshMemoryStatistics statistics;
+        statistics.ResidentCpuBytes = Vertices.capacity() * sizeof(MeshVertex) + Indices.capacity() * sizeof(uint32_t)
+                                      + Submeshes.capacity() * sizeof(MeshSubmesh)
+                                      + Meshlets.capacity() * sizeof(MeshMeshlet);
+        statistics.MappedFileBytes = m_MappedFile ? m_MappedFile->GetSize() : 0;
+        statistics.ResidentGpuBytes = m_GpuResidentBytes;
+        return statistics;
     }
 }
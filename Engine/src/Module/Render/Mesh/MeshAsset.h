@@ -4,10 +4,13 @@
 #include "Module/Render/RenderCore/VertexArray.h"
 #include "EngineCore/Core/Core.h"
 #include <glm/glm.hpp>
+#include <filesystem>
 #include <vector>
 
 namespace Himii
 {
+    class PlatformMappedFile;
+
     struct MeshVertex
     {
         glm::vec3 Position{0.0f};
@@ -24,14 +27,46 @@ namespace Himii
         uint32_t MaterialSlotIndex = 0;
     };
 
+    /// 子网格内的三角形簇（meshlet）。三角形在索引缓冲中保持连续：
+    /// [IndexStart, IndexStart + IndexCount) 为绝对索引区间，可直接作为多重绘制的一段。
+    struct MeshMeshlet
+    {
+        glm::vec3 BoundsCenter{0.0f};
+        float BoundsRadius = 0.0f;
+        /// 法线锥：dot(normalize(ConeApex - cameraPosition), ConeAxis) >= ConeCutoff 时整簇背向相机。
+        glm::vec3 ConeApex{0.0f};
+        float ConeCutoff = 1.0f;
+        glm::vec3 ConeAxis{0.0f, 0.0f, 1.0f};
+        uint32_t IndexStart = 0;
+        uint32_t IndexCount = 0;
+        uint32_t SubmeshIndex = 0;
+        uint32_t VertexCount = 0;
+        uint32_t Reserved = 0;
+    };
+
     struct MeshSubmeshGpu
     {
         Ref<VertexArray> VertexArray;
         uint32_t IndexCount = 0;
         uint32_t MaterialSlotIndex = 0;
+        /// 子网格在源索引缓冲中的起点；子网格自己的 IBO 从 0 开始，meshlet 区间需减去此值。
+        uint32_t IndexStart = 0;
+        uint32_t MeshletStart = 0;
+        uint32_t MeshletCount = 0;
+    };
+
+    /// 网格常驻内存统计（字节）。Mapped 为仍保留的文件映射大小，不计入 Cpu。
+    struct MeshMemoryStatistics
+    {
+        uint64_t ResidentCpuBytes = 0;
+        uint64_t MappedFileBytes = 0;
+        uint64_t ResidentGpuBytes = 0;
     };
 
     /// 静态网格资产：CPU 几何 + 按需上传的 GPU 子网格。
+    /// 从 .hmesh 加载时几何直接引用文件映射，GPU 上传后映射与 CPU 几何默认一并释放；
+    /// 没有源文件的程序化 / 内存网格无法重新读取，CPU 几何始终保留；
+    /// 碰撞、拾取等需要 CPU 几何的系统须调用 SetRetainCpuGeometry(true) 或 AcquireCpuGeometry()。
     class MeshAsset : public Asset
     {
     public:
@@ -40,6 +75,8 @@ namespace Himii
         std::vector<MeshVertex> Vertices;
         std::vector<uint32_t> Indices;
         std::vector<MeshSubmesh> Submeshes;
+        /// 按 SubmeshIndex 升序排列；CPU 常驻，供 Renderer3D 簇剔除使用。
+        std::vector<MeshMeshlet> Meshlets;
         std::vector<AssetHandle> DefaultMaterialHandles;
         std::vector<std::string> MaterialSlotNames;
 
@@ -47,8 +84,38 @@ namespace Himii
         const std::vector<MeshSubmeshGpu> &GetGpuSubmeshes() const { return m_GpuSubmeshes; }
         bool HasGpuResources() const { return m_GpuReady; }
 
+        /// 由 HmeshAssetSerializer 调用：几何指针指向 mappedFile 内部，生命周期随 mappedFile。
+        void SetMappedGeometry(Ref<PlatformMappedFile> mappedFile, const MeshVertex *vertices, uint32_t vertexCount,
+                               const uint32_t *indices, uint32_t indexCount);
+        void SetSourceFilePath(const std::filesystem::path &sourceFilePath) { m_SourceFilePath = sourceFilePath; }
+        const std::filesystem::path &GetSourceFilePath() const { return m_SourceFilePath; }
+
+        /// 为 true 时上传后保留 Vertices/Indices；已释放时会立即重新载入。
+        void SetRetainCpuGeometry(bool retainCpuGeometry);
+        bool IsRetainingCpuGeometry() const { return m_RetainCpuGeometry; }
+        /// 确保 Vertices/Indices 可用（从映射拷贝或重新读取 .hmesh），并在之后保持常驻。
+        bool AcquireCpuGeometry();
+        /// 只有能从源 .hmesh 重新读取的网格才真正释放；其余仅取消保留标记。
+        void ReleaseCpuGeometry();
+        bool CanReloadCpuGeometry() const { return !m_SourceFilePath.empty(); }
+
+        uint32_t GetVertexCount() const;
+        uint32_t GetIndexCount() const;
+        MeshMemoryStatistics GetMemoryStatistics() const;
+
     private:
+        bool HasMappedGeometry() const { return m_MappedVertices != nullptr; }
+
         std::vector<MeshSubmeshGpu> m_GpuSubmeshes;
         bool m_GpuReady = false;
+        bool m_RetainCpuGeometry = false;
+        uint64_t m_GpuResidentBytes = 0;
+
+        Ref<PlatformMappedFile> m_MappedFile;
+        const MeshVertex *m_MappedVertices = nullptr;
+        const uint32_t *m_MappedIndices = nullptr;
+        uint32_t m_MappedVertexCount = 0;
+        uint32_t m_MappedIndexCount = 0;
+        std::filesystem::path m_SourceFilePath;
     };
 }
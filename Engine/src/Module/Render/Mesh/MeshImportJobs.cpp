@@ -0,0 +1,124 @@
+#include "Hepch.h"
+#include "Module/Render/Mesh/MeshImportJobs.h"
+#include "Module/Render/Mesh/MeshTangentUtility.h"
+#include "EngineCore/Core/JobSystem.h"
+
+namespace Himii
+{
+    float MeshImportProgress::GetFraction() const
+    {
+        switch (Stage.load())
+        {
+            case MeshImportStage::Pending:
+            case MeshImportStage::Parsing:
+                return 0.0f;
+            case MeshImportStage::Decoding:
+            {
+                // 解码占整体进度的 80%，其余阶段各占少量。
+                const uint32_t totalPrimitives = TotalPrimitives.load();
+                if (totalPrimitives == 0)
+                    return 0.05f;
+                const float decodedFraction =
+                        static_cast<float>(DecodedPrimitives.load()) / static_cast<float>(totalPrimitives);
+                return 0.05f + 0.8f * decodedFraction;
+            }
+            case MeshImportStage::Building:
+                return 0.85f;
+            case MeshImportStage::Writing:
+                return 0.9f;
+            case MeshImportStage::Finalizing:
+                return 0.95f;
+            case MeshImportStage::Completed:
+            case MeshImportStage::Failed:
+                return 1.0f;
+        }
+        return 0.0f;
+    }
+
+    const char *MeshImportProgress::GetStageName() const
+    {
+        switch (Stage.load())
+        {
+            case MeshImportStage::Pending: return "Pending";
+            case MeshImportStage::Parsing: return "Parsing";
+            case MeshImportStage::Decoding: return "Decoding Primitives";
+            case MeshImportStage::Building: return "Building Meshlets";
+            case MeshImportStage::Writing: return "Writing .hmesh";
+            case MeshImportStage::Finalizing: return "Finalizing";
+            case MeshImportStage::Completed: return "Completed";
+            case MeshImportStage::Failed: return "Failed";
+        }
+        return "";
+    }
+
+    void DecodeMeshPrimitivesParallel(uint32_t primitiveCount,
+                                      const std::function<void(uint32_t, DecodedMeshPrimitive &)> &decodePrimitive,
+                                      std::vector<DecodedMeshPrimitive> &outPrimitives,
+                                      MeshImportProgress *progress)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        outPrimitives.clear();
+        outPrimitives.resize(primitiveCount);
+        if (progress)
+        {
+            progress->TotalPrimitives.store(primitiveCount);
+            progress->DecodedPrimitives.store(0);
+            progress->Stage.store(MeshImportStage::Decoding);
+        }
+
+        // 每个原始体一个批次：大小差异悬殊时由空闲工作线程继续领取，负载更均衡。
+        JobSystem::ParallelFor(primitiveCount, 1,
+                               [&](uint32_t beginIndex, uint32_t endIndex)
+                               {
+                                   for (uint32_t primitiveIndex = beginIndex; primitiveIndex < endIndex;
+                                        ++primitiveIndex)
+                                   {
+                                       DecodedMeshPrimitive &primitive = outPrimitives[primitiveIndex];
+                                       decodePrimitive(primitiveIndex, primitive);
+                                       if (MeshNeedsGeneratedTangents(primitive.Vertices))
+                                           GenerateMeshTangents(primitive.Vertices, primitive.Indices);
+                                       if (progress)
+                                           progress->DecodedPrimitives.fetch_add(1);
+                                   }
+                               });
+    }
+
+    void MergeDecodedMeshPrimitives(std::vector<DecodedMeshPrimitive> &primitives, MeshAsset &outMeshAsset)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        size_t totalVertexCount = outMeshAsset.Vertices.size();
+        size_t totalIndexCount = outMeshAsset.Indices.size();
+        for (const DecodedMeshPrimitive &primitive : primitives)
+        {
+            totalVertexCount += primitive.Vertices.size();
+            totalIndexCount += primitive.Indices.size();
+        }
+        outMeshAsset.Vertices.reserve(totalVertexCount);
+        outMeshAsset.Indices.reserve(totalIndexCount);
+
+        for (DecodedMeshPrimitive &primitive : primitives)
+        {
+            if (primitive.Vertices.empty() || primitive.Indices.empty())
+                continue;
+
+            const uint32_t vertexBase = static_cast<uint32_t>(outMeshAsset.Vertices.size());
+
+            MeshSubmesh submesh;
+            submesh.IndexStart = static_cast<uint32_t>(outMeshAsset.Indices.size());
+            submesh.IndexCount = static_cast<uint32_t>(primitive.Indices.size());
+            submesh.MaterialSlotIndex = primitive.MaterialSlotIndex;
+
+            outMeshAsset.Vertices.insert(outMeshAsset.Vertices.end(), primitive.Vertices.begin(),
+                                         primitive.Vertices.end());
+            for (uint32_t localIndex : primitive.Indices)
+                outMeshAsset.Indices.push_back(vertexBase + localIndex);
+            outMeshAsset.Submeshes.push_back(submesh);
+
+            // 合并后立即释放，降低大场景的峰值内存。
+            std::vector<MeshVertex>().swap(primitive.Vertices);
+            std::vector<uint32_t>().swap(primitive.Indices);
+        }
+    }
+}
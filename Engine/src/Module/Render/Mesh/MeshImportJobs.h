@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Module/Render/Mesh/MeshAsset.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Himii
+{
+    enum class MeshImportStage : uint32_t
+    {
+        Pending = 0,
+        Parsing,
+        Decoding,
+        Building,
+        Writing,
+        Finalizing,
+        Completed,
+        Failed
+    };
+
+    /// 导入进度：工作线程写入，编辑器 UI 每帧读取。
+    struct MeshImportProgress
+    {
+        std::atomic<MeshImportStage> Stage{MeshImportStage::Pending};
+        std::atomic<uint32_t> TotalPrimitives{0};
+        std::atomic<uint32_t> DecodedPrimitives{0};
+
+        float GetFraction() const;
+        const char *GetStageName() const;
+    };
+
+    /// 单个原始体解码结果：顶点已变换到世界空间，索引相对本原始体。
+    struct DecodedMeshPrimitive
+    {
+        std::vector<MeshVertex> Vertices;
+        std::vector<uint32_t> Indices;
+        uint32_t MaterialSlotIndex = 0;
+    };
+
+    /// 在 JobSystem 上并行调用 decodePrimitive(i, out)，并对缺失切线的原始体单独生成切线。
+    /// 原始体之间不共享顶点，逐原始体生成与整网格生成结果一致。
+    void DecodeMeshPrimitivesParallel(uint32_t primitiveCount,
+                                      const std::function<void(uint32_t, DecodedMeshPrimitive &)> &decodePrimitive,
+                                      std::vector<DecodedMeshPrimitive> &outPrimitives,
+                                      MeshImportProgress *progress = nullptr);
+
+    /// 按原始体顺序合并到 outMeshAsset，索引加上顶点基址；空原始体不产生子网格。
+    void MergeDecodedMeshPrimitives(std::vector<DecodedMeshPrimitive> &primitives, MeshAsset &outMeshAsset);
+
+    inline void SetMeshImportStage(MeshImportProgress *progress, MeshImportStage stage)
+    {
+        if (progress)
+            progress->Stage.store(stage);
+    }
+}
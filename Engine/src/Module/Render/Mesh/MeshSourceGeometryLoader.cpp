@@ -3,6 +3,7 @@
 #include "Module/Render/Mesh/StaticMeshImportSettings.h"
 #include "Module/Render/Mesh/GltfMeshGeometryLoader.h"
 #include "Module/Render/Mesh/FbxMeshGeometryLoader.h"
+#include "Module/Render/Mesh/MeshletBuilder.h"
 #include "EngineCore/Core/Log.h"
 
 #include <algorithm>
@@ -32,8 +33,10 @@ namespace Himii
 
     bool LoadMeshGeometryFromSource(const std::filesystem::path &absoluteSourcePath,
                                     const StaticMeshImportSettings &importSettings,
-                                    MeshAsset &outMeshAsset)
+                                    MeshAsset &outMeshAsset, MeshImportProgress *progress)
     {
+        HIMII_PROFILE_FUNCTION();
+
         (void)importSettings.CombineMeshes;
 
         outMeshAsset.Vertices.clear();
@@ -44,9 +47,9 @@ namespace Himii
         bool geometryLoaded = false;
 
         if (extension == ".glb" || extension == ".gltf")
-            geometryLoaded = LoadGltfMeshGeometry(absoluteSourcePath, outMeshAsset);
+            geometryLoaded = LoadGltfMeshGeometry(absoluteSourcePath, outMeshAsset, progress);
         else if (extension == ".fbx" || extension == ".obj")
-            geometryLoaded = LoadFbxMeshGeometry(absoluteSourcePath, outMeshAsset);
+            geometryLoaded = LoadFbxMeshGeometry(absoluteSourcePath, outMeshAsset, progress);
         else
         {
             HIMII_CORE_ERROR("Unsupported static mesh source extension '{0}': {1}", extension,
@@ -57,7 +60,9 @@ namespace Himii
         if (!geometryLoaded)
             return false;
 
+        SetMeshImportStage(progress, MeshImportStage::Building);
         ApplyUniformScale(outMeshAsset, importSettings.UniformScale);
+        BuildMeshMeshlets(outMeshAsset);
         return true;
     }
 }
@@ -6,10 +6,20 @@ namespace Himii
 {
     bool MeshNeedsGeneratedTangents(const MeshAsset &meshAsset)
     {
-        if (meshAsset.Vertices.empty())
+        return MeshNeedsGeneratedTangents(meshAsset.Vertices);
+    }
+
+    void GenerateMeshTangents(MeshAsset &meshAsset)
+    {
+        GenerateMeshTangents(meshAsset.Vertices, meshAsset.Indices);
+    }
+
+    bool MeshNeedsGeneratedTangents(const std::vector<MeshVertex> &vertices)
+    {
+        if (vertices.empty())
             return false;
 
-        for (const MeshVertex &vertex : meshAsset.Vertices)
+        for (const MeshVertex &vertex : vertices)
         {
             const float tangentLengthSquared =
                     vertex.Tangent.x * vertex.Tangent.x + vertex.Tangent.y * vertex.Tangent.y
@@ -20,26 +30,26 @@ namespace Himii
         return false;
     }
 
-    void GenerateMeshTangents(MeshAsset &meshAsset)
+    void GenerateMeshTangents(std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices)
     {
-        if (meshAsset.Vertices.empty() || meshAsset.Indices.size() < 3)
+        if (vertices.empty() || indices.size() < 3)
             return;
 
-        std::vector<glm::vec3> accumulatedTangents(meshAsset.Vertices.size(), glm::vec3(0.0f));
-        std::vector<glm::vec3> accumulatedBitangents(meshAsset.Vertices.size(), glm::vec3(0.0f));
+        std::vector<glm::vec3> accumulatedTangents(vertices.size(), glm::vec3(0.0f));
+        std::vector<glm::vec3> accumulatedBitangents(vertices.size(), glm::vec3(0.0f));
 
-        for (size_t indexOffset = 0; indexOffset + 2 < meshAsset.Indices.size(); indexOffset += 3)
+        for (size_t indexOffset = 0; indexOffset + 2 < indices.size(); indexOffset += 3)
         {
-            const uint32_t index0 = meshAsset.Indices[indexOffset + 0];
-            const uint32_t index1 = meshAsset.Indices[indexOffset + 1];
-            const uint32_t index2 = meshAsset.Indices[indexOffset + 2];
-            if (index0 >= meshAsset.Vertices.size() || index1 >= meshAsset.Vertices.size()
-                || index2 >= meshAsset.Vertices.size())
+            const uint32_t index0 = indices[indexOffset + 0];
+            const uint32_t index1 = indices[indexOffset + 1];
+            const uint32_t index2 = indices[indexOffset + 2];
+            if (index0 >= vertices.size() || index1 >= vertices.size()
+                || index2 >= vertices.size())
                 continue;
 
-            const MeshVertex &vertex0 = meshAsset.Vertices[index0];
-            const MeshVertex &vertex1 = meshAsset.Vertices[index1];
-            const MeshVertex &vertex2 = meshAsset.Vertices[index2];
+            const MeshVertex &vertex0 = vertices[index0];
+            const MeshVertex &vertex1 = vertices[index1];
+            const MeshVertex &vertex2 = vertices[index2];
 
             const glm::vec3 edge1 = vertex1.Position - vertex0.Position;
             const glm::vec3 edge2 = vertex2.Position - vertex0.Position;
@@ -64,9 +74,9 @@ namespace Himii
             accumulatedBitangents[index2] += bitangent;
         }
 
-        for (size_t vertexIndex = 0; vertexIndex < meshAsset.Vertices.size(); ++vertexIndex)
+        for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex)
         {
-            MeshVertex &vertex = meshAsset.Vertices[vertexIndex];
+            MeshVertex &vertex = vertices[vertexIndex];
             const glm::vec3 normal = glm::normalize(vertex.Normal);
             glm::vec3 tangent = accumulatedTangents[vertexIndex];
             if (glm::dot(tangent, tangent) < 1.0e-8f)
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 namespace Himii
 {
     class MeshAsset;
+    struct MeshVertex;
 
     /// 按 Position / Normal / UV 生成切线（Lengyel 累积 + Gram-Schmidt）。
     /// 若网格已带有效源切线可跳过；导入路径在缺失时调用。
@@ -10,4 +14,8 @@ namespace Himii
 
     /// 任一顶点切线长度接近 0 则视为需要生成。
     bool MeshNeedsGeneratedTangents(const MeshAsset &meshAsset);
+
+    /// 同上，直接作用于顶点/索引数组；导入时按原始体在工作线程上单独调用。
+    void GenerateMeshTangents(std::vector<MeshVertex> &vertices, const std::vector<uint32_t> &indices);
+    bool MeshNeedsGeneratedTangents(const std::vector<MeshVertex> &vertices);
 }
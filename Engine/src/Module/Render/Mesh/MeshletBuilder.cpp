@@ -0,0 +1,171 @@
+#include "Hepch.h"
+#include "Module/Render/Mesh/MeshletBuilder.h"
+#include "Module/Render/Mesh/MeshAsset.h"
+
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace Himii
+{
+    namespace
+    {
+        void ComputeMeshletBounds(const MeshAsset &meshAsset, MeshMeshlet &meshlet)
+        {
+            const uint32_t *indices = meshAsset.Indices.data() + meshlet.IndexStart;
+            const uint32_t triangleCount = meshlet.IndexCount / 3;
+
+            glm::vec3 boundsMinimum(std::numeric_limits<float>::max());
+            glm::vec3 boundsMaximum(std::numeric_limits<float>::lowest());
+            for (uint32_t localIndex = 0; localIndex < meshlet.IndexCount; ++localIndex)
+            {
+                const glm::vec3 &position = meshAsset.Vertices[indices[localIndex]].Position;
+                boundsMinimum = glm::min(boundsMinimum, position);
+                boundsMaximum = glm::max(boundsMaximum, position);
+            }
+
+            meshlet.BoundsCenter = (boundsMinimum + boundsMaximum) * 0.5f;
+            float radiusSquared = 0.0f;
+            for (uint32_t localIndex = 0; localIndex < meshlet.IndexCount; ++localIndex)
+            {
+                const glm::vec3 offset = meshAsset.Vertices[indices[localIndex]].Position - meshlet.BoundsCenter;
+                radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+            }
+            meshlet.BoundsRadius = std::sqrt(radiusSquared);
+
+            // 法线锥：面法线均值为轴，最小夹角余弦决定张角；张角过大（≥ ~84°）时不做背面剔除。
+            std::vector<glm::vec3> faceNormals;
+            faceNormals.reserve(triangleCount);
+            glm::vec3 normalSum(0.0f);
+            for (uint32_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+            {
+                const glm::vec3 &position0 = meshAsset.Vertices[indices[triangleIndex * 3 + 0]].Position;
+                const glm::vec3 &position1 = meshAsset.Vertices[indices[triangleIndex * 3 + 1]].Position;
+                const glm::vec3 &position2 = meshAsset.Vertices[indices[triangleIndex * 3 + 2]].Position;
+                const glm::vec3 faceNormal = glm::cross(position1 - position0, position2 - position0);
+                const float faceNormalLength = glm::length(faceNormal);
+                if (faceNormalLength < 1.0e-12f)
+                    continue;
+                faceNormals.push_back(faceNormal / faceNormalLength);
+                normalSum += faceNormals.back();
+            }
+
+            meshlet.ConeApex = meshlet.BoundsCenter;
+            meshlet.ConeAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+            meshlet.ConeCutoff = 1.0f;
+
+            const float normalSumLength = glm::length(normalSum);
+            if (faceNormals.empty() || normalSumLength < 1.0e-6f)
+                return;
+
+            const glm::vec3 coneAxis = normalSum / normalSumLength;
+            float minimumDot = 1.0f;
+            for (const glm::vec3 &faceNormal : faceNormals)
+                minimumDot = std::min(minimumDot, glm::dot(faceNormal, coneAxis));
+            meshlet.ConeAxis = coneAxis;
+            if (minimumDot <= 0.1f)
+                return;
+
+            // 锥顶沿轴后移，使所有三角形平面都位于锥顶之前。
+            float maximumAxisDistance = 0.0f;
+            uint32_t faceNormalIndex = 0;
+            for (uint32_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+            {
+                const glm::vec3 &position0 = meshAsset.Vertices[indices[triangleIndex * 3 + 0]].Position;
+                const glm::vec3 &position1 = meshAsset.Vertices[indices[triangleIndex * 3 + 1]].Position;
+                const glm::vec3 &position2 = meshAsset.Vertices[indices[triangleIndex * 3 + 2]].Position;
+                if (glm::length(glm::cross(position1 - position0, position2 - position0)) < 1.0e-12f)
+                    continue;
+                const glm::vec3 &faceNormal = faceNormals[faceNormalIndex++];
+                const float centerDistance = glm::dot(position0 - meshlet.BoundsCenter, faceNormal);
+                const float axisDot = glm::dot(coneAxis, faceNormal);
+                maximumAxisDistance = std::max(maximumAxisDistance, -centerDistance / axisDot);
+            }
+
+            meshlet.ConeApex = meshlet.BoundsCenter - coneAxis * maximumAxisDistance;
+            meshlet.ConeCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+        }
+    }
+
+    void BuildMeshMeshlets(MeshAsset &meshAsset)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        meshAsset.Meshlets.clear();
+        if (meshAsset.Vertices.empty() || meshAsset.Indices.size() < 3)
+            return;
+
+        const uint32_t vertexCount = static_cast<uint32_t>(meshAsset.Vertices.size());
+        const uint32_t indexCount = static_cast<uint32_t>(meshAsset.Indices.size());
+        // 记录顶点最后一次被哪个 meshlet 引用，避免每个 meshlet 清空集合。
+        std::vector<uint32_t> vertexMeshletStamp(vertexCount, std::numeric_limits<uint32_t>::max());
+
+        for (uint32_t submeshIndex = 0; submeshIndex < static_cast<uint32_t>(meshAsset.Submeshes.size());
+             ++submeshIndex)
+        {
+            const MeshSubmesh &submesh = meshAsset.Submeshes[submeshIndex];
+            if (static_cast<uint64_t>(submesh.IndexStart) + submesh.IndexCount > indexCount)
+                continue;
+
+            const uint32_t submeshIndexEnd = submesh.IndexStart + submesh.IndexCount - submesh.IndexCount % 3;
+            MeshMeshlet currentMeshlet;
+            currentMeshlet.IndexStart = submesh.IndexStart;
+            currentMeshlet.SubmeshIndex = submeshIndex;
+            uint32_t currentStamp = static_cast<uint32_t>(meshAsset.Meshlets.size());
+
+            auto finalizeMeshlet = [&]()
+            {
+                if (currentMeshlet.IndexCount == 0)
+                    return;
+                ComputeMeshletBounds(meshAsset, currentMeshlet);
+                meshAsset.Meshlets.push_back(currentMeshlet);
+
+                MeshMeshlet nextMeshlet;
+                nextMeshlet.IndexStart = currentMeshlet.IndexStart + currentMeshlet.IndexCount;
+                nextMeshlet.SubmeshIndex = submeshIndex;
+                currentMeshlet = nextMeshlet;
+                currentStamp = static_cast<uint32_t>(meshAsset.Meshlets.size());
+            };
+
+            for (uint32_t indexOffset = submesh.IndexStart; indexOffset < submeshIndexEnd; indexOffset += 3)
+            {
+                const uint32_t *triangle = meshAsset.Indices.data() + indexOffset;
+                if (triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount)
+                {
+                    HIMII_CORE_WARNING("BuildMeshMeshlets: index out of range, mesh will draw without clusters.");
+                    meshAsset.Meshlets.clear();
+                    return;
+                }
+
+                uint32_t newVertexCount = 0;
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    const bool repeatedInTriangle = (corner > 0 && triangle[corner] == triangle[0])
+                                                    || (corner > 1 && triangle[corner] == triangle[1]);
+                    if (vertexMeshletStamp[triangle[corner]] != currentStamp && !repeatedInTriangle)
+                        ++newVertexCount;
+                }
+
+                if (currentMeshlet.VertexCount + newVertexCount > MeshletMaximumVertexCount
+                    || currentMeshlet.IndexCount / 3 >= MeshletMaximumTriangleCount)
+                {
+                    finalizeMeshlet();
+                    newVertexCount = 0;
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        const bool repeatedInTriangle = (corner > 0 && triangle[corner] == triangle[0])
+                                                        || (corner > 1 && triangle[corner] == triangle[1]);
+                        if (!repeatedInTriangle)
+                            ++newVertexCount;
+                    }
+                }
+
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                    vertexMeshletStamp[triangle[corner]] = currentStamp;
+                currentMeshlet.VertexCount += newVertexCount;
+                currentMeshlet.IndexCount += 3;
+            }
+
+            finalizeMeshlet();
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Himii
+{
+    class MeshAsset;
+
+    inline constexpr uint32_t MeshletMaximumVertexCount = 64u;
+    inline constexpr uint32_t MeshletMaximumTriangleCount = 124u;
+
+    /// 将每个子网格按索引顺序贪心切分为 meshlet（≤64 顶点 / ≤124 三角形），
+    /// 计算包围球与法线锥，结果写入 meshAsset.Meshlets。不重排索引，三角形区间保持连续。
+    void BuildMeshMeshlets(MeshAsset &meshAsset);
+}
@@ -0,0 +1,147 @@
+#include "Hepch.h"
+#include "Module/Render/Mesh/MeshletCulling.h"
+#include "EngineCore/Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr uint32_t MeshletCullingBatchSize = 256u;
+        /// 三轴缩放的相对差与轴间夹角余弦超过该值时视为非均匀缩放 / 剪切。
+        constexpr float MeshletConeUniformScaleTolerance = 1.0e-3f;
+
+        glm::vec4 NormalizePlane(const glm::vec4 &plane)
+        {
+            const float normalLength = glm::length(glm::vec3(plane));
+            return normalLength > 0.0f ? plane / normalLength : plane;
+        }
+
+        /// 法线锥在物体空间求得；只有旋转 + 均匀缩放（且不镜像）能保持夹角，锥测试才仍然成立。
+        bool PreservesConeAngles(const glm::mat4 &objectTransform)
+        {
+            const glm::mat3 linear(objectTransform);
+            if (glm::determinant(linear) <= 0.0f)
+                return false;
+
+            const float scaleX = glm::length(linear[0]);
+            const float scaleY = glm::length(linear[1]);
+            const float scaleZ = glm::length(linear[2]);
+            const float maximumScale = std::max({scaleX, scaleY, scaleZ});
+            const float minimumScale = std::min({scaleX, scaleY, scaleZ});
+            if (maximumScale - minimumScale > MeshletConeUniformScaleTolerance * maximumScale)
+                return false;
+
+            const glm::vec3 axisX = linear[0] / scaleX;
+            const glm::vec3 axisY = linear[1] / scaleY;
+            const glm::vec3 axisZ = linear[2] / scaleZ;
+            return std::abs(glm::dot(axisX, axisY)) <= MeshletConeUniformScaleTolerance
+                   && std::abs(glm::dot(axisY, axisZ)) <= MeshletConeUniformScaleTolerance
+                   && std::abs(glm::dot(axisZ, axisX)) <= MeshletConeUniformScaleTolerance;
+        }
+    }
+
+    MeshletCullingView BuildMeshletCullingView(const glm::mat4 &viewProjection, const glm::mat4 &objectTransform,
+                                               const glm::vec3 &worldCameraPosition, bool enableConeCulling)
+    {
+        MeshletCullingView view;
+
+        // Gribb-Hartmann：从 VP * Model 的行向量直接得到物体空间平面（OpenGL 裁剪深度 [-1, 1]）。
+        const glm::mat4 clipFromObject = viewProjection * objectTransform;
+        const glm::vec4 row0(clipFromObject[0][0], clipFromObject[1][0], clipFromObject[2][0], clipFromObject[3][0]);
+        const glm::vec4 row1(clipFromObject[0][1], clipFromObject[1][1], clipFromObject[2][1], clipFromObject[3][1]);
+        const glm::vec4 row2(clipFromObject[0][2], clipFromObject[1][2], clipFromObject[2][2], clipFromObject[3][2]);
+        const glm::vec4 row3(clipFromObject[0][3], clipFromObject[1][3], clipFromObject[2][3], clipFromObject[3][3]);
+        view.FrustumPlanes[0] = NormalizePlane(row3 + row0);
+        view.FrustumPlanes[1] = NormalizePlane(row3 - row0);
+        view.FrustumPlanes[2] = NormalizePlane(row3 + row1);
+        view.FrustumPlanes[3] = NormalizePlane(row3 - row1);
+        view.FrustumPlanes[4] = NormalizePlane(row3 + row2);
+        view.FrustumPlanes[5] = NormalizePlane(row3 - row2);
+
+        view.CameraPosition = glm::vec3(glm::inverse(objectTransform) * glm::vec4(worldCameraPosition, 1.0f));
+        view.Orthographic = glm::length(glm::vec3(row3)) <= 1.0e-6f * std::abs(row3.w);
+        if (view.Orthographic)
+        {
+            // 近平面与远平面中心反投影回物体空间，连线即视线方向。
+            const glm::mat4 objectFromClip = glm::inverse(clipFromObject);
+            const glm::vec4 nearCenter = objectFromClip * glm::vec4(0.0f, 0.0f, -1.0f, 1.0f);
+            const glm::vec4 farCenter = objectFromClip * glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+            const glm::vec3 viewOffset = glm::vec3(farCenter) / farCenter.w - glm::vec3(nearCenter) / nearCenter.w;
+            const float viewOffsetLength = glm::length(viewOffset);
+            if (viewOffsetLength > 0.0f)
+                view.ViewDirection = viewOffset / viewOffsetLength;
+            else
+                enableConeCulling = false;
+        }
+        view.EnableConeCulling = enableConeCulling && PreservesConeAngles(objectTransform);
+        return view;
+    }
+
+    bool IsMeshletVisible(const MeshMeshlet &meshlet, const MeshletCullingView &view)
+    {
+        for (const glm::vec4 &plane : view.FrustumPlanes)
+        {
+            if (glm::dot(glm::vec3(plane), meshlet.BoundsCenter) + plane.w < -meshlet.BoundsRadius)
+                return false;
+        }
+
+        if (view.EnableConeCulling && meshlet.ConeCutoff < 1.0f)
+        {
+            if (view.Orthographic)
+                return glm::dot(view.ViewDirection, meshlet.ConeAxis) < meshlet.ConeCutoff;
+
+            const glm::vec3 apexOffset = meshlet.ConeApex - view.CameraPosition;
+            const float apexDistance = glm::length(apexOffset);
+            if (apexDistance > 0.0f && glm::dot(apexOffset, meshlet.ConeAxis) >= meshlet.ConeCutoff * apexDistance)
+                return false;
+        }
+        return true;
+    }
+
+    void CullMeshlets(const MeshMeshlet *meshlets, uint32_t meshletCount, uint32_t submeshIndexStart,
+                      const MeshletCullingView &view, MeshletDrawRanges &outDrawRanges, uint32_t parallelThreshold)
+    {
+        outDrawRanges.Clear();
+        if (!meshlets || meshletCount == 0)
+            return;
+
+        thread_local std::vector<uint8_t> visibility;
+        visibility.resize(meshletCount);
+        uint8_t *visibilityData = visibility.data();
+
+        auto cullBatch = [meshlets, &view, visibilityData](uint32_t beginIndex, uint32_t endIndex)
+        {
+            for (uint32_t meshletIndex = beginIndex; meshletIndex < endIndex; ++meshletIndex)
+                visibilityData[meshletIndex] = IsMeshletVisible(meshlets[meshletIndex], view) ? 1 : 0;
+        };
+
+        if (meshletCount >= parallelThreshold)
+            JobSystem::ParallelFor(meshletCount, MeshletCullingBatchSize, cullBatch);
+        else
+            cullBatch(0, meshletCount);
+
+        // 压缩：按原顺序合并相邻可见区间，减少多重绘制段数。
+        for (uint32_t meshletIndex = 0; meshletIndex < meshletCount; ++meshletIndex)
+        {
+            if (!visibilityData[meshletIndex])
+                continue;
+
+            const MeshMeshlet &meshlet = meshlets[meshletIndex];
+            const uint32_t firstIndex = meshlet.IndexStart - submeshIndexStart;
+            if (!outDrawRanges.FirstIndices.empty()
+                && outDrawRanges.FirstIndices.back() + outDrawRanges.IndexCounts.back() == firstIndex)
+            {
+                outDrawRanges.IndexCounts.back() += meshlet.IndexCount;
+            }
+            else
+            {
+                outDrawRanges.FirstIndices.push_back(firstIndex);
+                outDrawRanges.IndexCounts.push_back(meshlet.IndexCount);
+            }
+            outDrawRanges.VisibleMeshletCount++;
+            outDrawRanges.VisibleIndexCount += meshlet.IndexCount;
+        }
+    }
+}
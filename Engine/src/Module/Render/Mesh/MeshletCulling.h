@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Module/Render/Mesh/MeshAsset.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Himii
+{
+    /// 物体空间剔除参数：平面已归一化，内侧满足 dot(xyz, p) + w >= 0。
+    struct MeshletCullingView
+    {
+        glm::vec4 FrustumPlanes[6]{};
+        glm::vec3 CameraPosition{0.0f};
+        /// 正交投影的视线彼此平行，锥测试改用物体空间的视线方向，不再以相机位置为视点。
+        bool Orthographic = false;
+        glm::vec3 ViewDirection{0.0f, 0.0f, -1.0f};
+        bool EnableConeCulling = true;
+    };
+
+    /// 合并后的绘制区间（相对子网格 IBO 起点的索引偏移与数量）。
+    struct MeshletDrawRanges
+    {
+        std::vector<uint32_t> IndexCounts;
+        std::vector<uint32_t> FirstIndices;
+        uint32_t VisibleMeshletCount = 0;
+        uint32_t VisibleIndexCount = 0;
+
+        void Clear()
+        {
+            IndexCounts.clear();
+            FirstIndices.clear();
+            VisibleMeshletCount = 0;
+            VisibleIndexCount = 0;
+        }
+    };
+
+    /// 由相机 VP 与物体变换构造物体空间视锥；镜像、非均匀缩放或剪切变换会关闭法线锥剔除。
+    /// 投影类型由 VP 判断（齐次 w 与位置无关即为正交），正交时 worldCameraPosition 不参与锥测试。
+    MeshletCullingView BuildMeshletCullingView(const glm::mat4 &viewProjection, const glm::mat4 &objectTransform,
+                                               const glm::vec3 &worldCameraPosition, bool enableConeCulling);
+
+    bool IsMeshletVisible(const MeshMeshlet &meshlet, const MeshletCullingView &view);
+
+    /// 纯 CPU、无图形依赖，可在无窗口环境下基准测试。meshletCount 达到 parallelThreshold 时
+    /// 经 JobSystem::ParallelFor 分批剔除。相邻可见 meshlet 的索引区间会合并为一段。
+    void CullMeshlets(const MeshMeshlet *meshlets, uint32_t meshletCount, uint32_t submeshIndexStart,
+                      const MeshletCullingView &view, MeshletDrawRanges &outDrawRanges,
+                      uint32_t parallelThreshold = 1024u);
+}
@@ -6,7 +6,9 @@
 #include "Module/Render/Mesh/MeshCompanionImport.h"
 #include "Module/Render/Mesh/StaticMeshImportSettings.h"
 #include "Project/Project.h"
+#include "EngineCore/Core/JobSystem.h"
 #include "EngineCore/Core/Log.h"
+#include "EngineCore/Core/Timer.h"
 
 #include <algorithm>
 #include <cctype>
@@ -22,177 +24,343 @@ namespace Himii
                            [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
             return extension;
         }
-    }
 
-    std::filesystem::path StaticMeshImporter::GetProductPathForSource(
-            const std::filesystem::path &relativeSourcePath)
-    {
-        return relativeSourcePath.parent_path()
-               / (relativeSourcePath.stem().string() + ".hmesh");
-    }
+        struct SourceImportContext
+        {
+            std::filesystem::path RelativeSourcePath;
+            std::filesystem::path AbsoluteSourcePath;
+            std::filesystem::path RelativeHmeshPath;
+            std::filesystem::path AbsoluteHmeshPath;
+            StaticMeshImportSettings Settings{};
 
-    AssetHandle StaticMeshImporter::ImportFromSource(AssetManager &assetManager,
-                                                     const std::filesystem::path &relativeSourcePath,
-                                                     const StaticMeshImportSettings &importSettings)
-    {
-        const std::filesystem::path absoluteSourcePath =
-                Project::GetAssetFileSystemPath(relativeSourcePath);
-        if (!std::filesystem::exists(absoluteSourcePath))
+            // 仅重导使用。
+            std::vector<AssetHandle> ExistingMaterialHandles;
+            std::vector<std::string> ExistingSlotNames;
+            bool PreserveExistingCompanionMaterials = false;
+        };
+
+        /// 异步导入提交时的工程快照；完成回调据此判断结果是否仍属于当前工程。
+        struct ImportProjectToken
         {
-            HIMII_CORE_ERROR("Static mesh import failed, source missing: {0}",
-                             absoluteSourcePath.string());
-            return 0;
-        }
+            std::weak_ptr<Project> ProjectInstance;
+            std::filesystem::path ProjectDirectory;
+            std::weak_ptr<AssetManager> Manager;
+        };
 
-        const std::string sourceExtension = NormalizePathExtension(relativeSourcePath);
-        if (!IsStaticMeshSourceExtension(sourceExtension))
+        ImportProjectToken CaptureImportProjectToken(const Ref<AssetManager> &assetManager)
         {
-            HIMII_CORE_ERROR("Not a static mesh source file: {0}", relativeSourcePath.generic_string());
-            return 0;
+            ImportProjectToken token;
+            token.ProjectInstance = Project::GetActive();
+            if (Project::GetActive())
+                token.ProjectDirectory = Project::GetProjectDirectory();
+            token.Manager = assetManager;
+            return token;
         }
 
-        const std::filesystem::path relativeHmeshPath = GetProductPathForSource(relativeSourcePath);
-        const std::filesystem::path absoluteHmeshPath =
-                Project::GetAssetFileSystemPath(relativeHmeshPath);
-
-        MeshAsset meshGeometry;
-        if (!LoadMeshGeometryFromSource(absoluteSourcePath, importSettings, meshGeometry))
+        bool IsImportProjectTokenCurrent(const ImportProjectToken &token)
         {
-            HIMII_CORE_ERROR("Failed to load mesh geometry from source: {0}",
-                             absoluteSourcePath.string());
-            return 0;
+            const Ref<Project> activeProject = Project::GetActive();
+            if (!activeProject || token.ProjectInstance.lock() != activeProject)
+                return false;
+
+            if (Project::GetProjectDirectory() != token.ProjectDirectory)
+                return false;
+
+            const Ref<AssetManager> manager = token.Manager.lock();
+            return manager && manager == Project::TryGetAssetManager();
         }
 
-        if (meshGeometry.Vertices.empty() || meshGeometry.Indices.empty())
+        bool PrepareSourceImport(const std::filesystem::path &relativeSourcePath,
+                                 const StaticMeshImportSettings &importSettings, SourceImportContext &outContext)
         {
-            HIMII_CORE_ERROR("Static mesh import produced empty geometry: {0}",
-                             absoluteSourcePath.string());
-            return 0;
-        }
+            outContext.RelativeSourcePath = relativeSourcePath;
+            outContext.AbsoluteSourcePath = Project::GetAssetFileSystemPath(relativeSourcePath);
+            outContext.Settings = importSettings;
+            if (!std::filesystem::exists(outContext.AbsoluteSourcePath))
+            {
+                HIMII_CORE_ERROR("Static mesh import failed, source missing: {0}",
+                                 outContext.AbsoluteSourcePath.string());
+                return false;
+            }
 
-        if (!HmeshAssetSerializer::Serialize(absoluteHmeshPath, meshGeometry))
-            return 0;
+            const std::string sourceExtension = NormalizePathExtension(relativeSourcePath);
+            if (!IsStaticMeshSourceExtension(sourceExtension))
+            {
+                HIMII_CORE_ERROR("Not a static mesh source file: {0}", relativeSourcePath.generic_string());
+                return false;
+            }
+
+            outContext.RelativeHmeshPath = StaticMeshImporter::GetProductPathForSource(relativeSourcePath);
+            outContext.AbsoluteHmeshPath = Project::GetAssetFileSystemPath(outContext.RelativeHmeshPath);
+            return true;
+        }
 
-        std::vector<AssetHandle> materialHandles;
-        std::vector<std::string> materialSlotNames;
-        if (importSettings.ImportMaterialsAndTextures)
+        bool PrepareReimport(const std::filesystem::path &relativeHmeshPath,
+                             const StaticMeshImportSettings *overrideSettings,
+                             bool preserveExistingCompanionMaterials, SourceImportContext &outContext)
         {
-            MeshCompanionImportResult companionResult;
-            if (!ImportMeshCompanionAssets(assetManager, relativeSourcePath, &companionResult))
+            outContext.RelativeHmeshPath = relativeHmeshPath;
+            outContext.AbsoluteHmeshPath = Project::GetAssetFileSystemPath(relativeHmeshPath);
+            outContext.PreserveExistingCompanionMaterials = preserveExistingCompanionMaterials;
+
+            if (!MeshAssetSerializer::ReadStaticMeshMeta(outContext.AbsoluteHmeshPath, outContext.Settings,
+                                                         outContext.RelativeSourcePath,
+                                                         outContext.ExistingMaterialHandles,
+                                                         outContext.ExistingSlotNames))
             {
-                HIMII_CORE_WARNING("Static mesh geometry imported but companion materials failed: {0}",
-                                   relativeSourcePath.generic_string());
+                HIMII_CORE_ERROR("Cannot reimport static mesh without meta: {0}",
+                                 relativeHmeshPath.generic_string());
+                return false;
             }
-            else
+
+            if (outContext.RelativeSourcePath.empty())
+            {
+                HIMII_CORE_ERROR("Static mesh meta missing SourceFile: {0}",
+                                 relativeHmeshPath.generic_string());
+                return false;
+            }
+
+            if (overrideSettings)
+                outContext.Settings = *overrideSettings;
+
+            outContext.AbsoluteSourcePath = Project::GetAssetFileSystemPath(outContext.RelativeSourcePath);
+            if (!std::filesystem::exists(outContext.AbsoluteSourcePath))
             {
-                materialHandles = std::move(companionResult.MaterialHandles);
-                materialSlotNames = std::move(companionResult.MaterialSlotNames);
+                HIMII_CORE_ERROR("Static mesh reimport failed, source missing: {0}",
+                                 outContext.AbsoluteSourcePath.string());
+                return false;
             }
+            return true;
         }
 
-        if (!MeshAssetSerializer::WriteStaticMeshMeta(absoluteHmeshPath, importSettings,
-                                                      relativeSourcePath, materialHandles,
-                                                      materialSlotNames))
-            return 0;
+        /// 解码源文件并写出 `.hmesh`；不访问 AssetManager，可在工作线程执行。
+        bool BakeHmeshFromSource(const SourceImportContext &context, MeshImportProgress *progress)
+        {
+            HIMII_PROFILE_FUNCTION();
 
-        const AssetHandle hmeshHandle = assetManager.ImportAsset(relativeHmeshPath);
-        assetManager.ClearCachedAssetLoadFailure(hmeshHandle);
-        assetManager.UnloadAsset(hmeshHandle);
-        assetManager.SerializeAssetRegistry();
+            Timer decodeTimer;
+            MeshAsset meshGeometry;
+            if (!LoadMeshGeometryFromSource(context.AbsoluteSourcePath, context.Settings, meshGeometry, progress))
+            {
+                HIMII_CORE_ERROR("Failed to load mesh geometry from source: {0}",
+                                 context.AbsoluteSourcePath.string());
+                return false;
+            }
+            const float decodeMilliseconds = decodeTimer.ElapsedMillis();
 
-        HIMII_CORE_INFO("Static mesh import done: {0} -> {1}", relativeSourcePath.generic_string(),
-                        relativeHmeshPath.generic_string());
-        return hmeshHandle;
-    }
+            if (meshGeometry.Vertices.empty() || meshGeometry.Indices.empty())
+            {
+                HIMII_CORE_ERROR("Static mesh import produced empty geometry: {0}",
+                                 context.AbsoluteSourcePath.string());
+                return false;
+            }
 
-    AssetHandle StaticMeshImporter::ReimportProduct(AssetManager &assetManager,
-                                                    const std::filesystem::path &relativeHmeshPath,
-                                                    const StaticMeshImportSettings *overrideSettings,
-                                                    bool preserveExistingCompanionMaterials)
-    {
-        const std::filesystem::path absoluteHmeshPath =
-                Project::GetAssetFileSystemPath(relativeHmeshPath);
+            SetMeshImportStage(progress, MeshImportStage::Writing);
+            Timer writeTimer;
+            if (!HmeshAssetSerializer::Serialize(context.AbsoluteHmeshPath, meshGeometry))
+                return false;
 
-        StaticMeshImportSettings importSettings;
-        std::filesystem::path relativeSourcePath;
-        std::vector<AssetHandle> existingMaterialHandles;
-        std::vector<std::string> existingSlotNames;
+            HIMII_CORE_INFO("Static mesh bake {0}: {1} submeshes, {2} vertices, {3} indices; "
+                            "decode {4:.1f} ms, write {5:.1f} ms ({6} workers)",
+                            context.RelativeSourcePath.generic_string(), meshGeometry.Submeshes.size(),
+                            meshGeometry.Vertices.size(), meshGeometry.Indices.size(), decodeMilliseconds,
+                            writeTimer.ElapsedMillis(), JobSystem::GetWorkerCount());
+            return true;
+        }
 
-        if (!MeshAssetSerializer::ReadStaticMeshMeta(absoluteHmeshPath, importSettings,
-                                                     relativeSourcePath, existingMaterialHandles,
-                                                     existingSlotNames))
+        AssetHandle FinalizeSourceImport(AssetManager &assetManager, const SourceImportContext &context)
         {
-            HIMII_CORE_ERROR("Cannot reimport static mesh without meta: {0}",
-                             relativeHmeshPath.generic_string());
-            return 0;
+            std::vector<AssetHandle> materialHandles;
+            std::vector<std::string> materialSlotNames;
+            if (context.Settings.ImportMaterialsAndTextures)
+            {
+                MeshCompanionImportResult companionResult;
+                if (!ImportMeshCompanionAssets(assetManager, context.RelativeSourcePath, &companionResult))
+                {
+                    HIMII_CORE_WARNING("Static mesh geometry imported but companion materials failed: {0}",
+                                       context.RelativeSourcePath.generic_string());
+                }
+                else
+                {
+                    materialHandles = std::move(companionResult.MaterialHandles);
+                    materialSlotNames = std::move(companionResult.MaterialSlotNames);
+                }
+            }
+
+            if (!MeshAssetSerializer::WriteStaticMeshMeta(context.AbsoluteHmeshPath, context.Settings,
+                                                          context.RelativeSourcePath, materialHandles,
+                                                          materialSlotNames))
+                return 0;
+
+            const AssetHandle hmeshHandle = assetManager.ImportAsset(context.RelativeHmeshPath);
+            assetManager.ClearCachedAssetLoadFailure(hmeshHandle);
+            assetManager.UnloadAsset(hmeshHandle);
+            assetManager.SerializeAssetRegistry();
+
+            HIMII_CORE_INFO("Static mesh import done: {0} -> {1}", context.RelativeSourcePath.generic_string(),
+                            context.RelativeHmeshPath.generic_string());
+            return hmeshHandle;
         }
 
-        if (relativeSourcePath.empty())
+        AssetHandle FinalizeReimport(AssetManager &assetManager, const SourceImportContext &context)
         {
-            HIMII_CORE_ERROR("Static mesh meta missing SourceFile: {0}",
-                             relativeHmeshPath.generic_string());
-            return 0;
+            std::vector<AssetHandle> materialHandles;
+            std::vector<std::string> materialSlotNames;
+            if (context.Settings.ImportMaterialsAndTextures)
+            {
+                if (context.PreserveExistingCompanionMaterials)
+                {
+                    materialHandles = context.ExistingMaterialHandles;
+                    materialSlotNames = context.ExistingSlotNames;
+                }
+                else
+                {
+                    MeshCompanionImportResult companionResult;
+                    ImportMeshCompanionAssets(assetManager, context.RelativeSourcePath, &companionResult);
+                    materialHandles = std::move(companionResult.MaterialHandles);
+                    materialSlotNames = std::move(companionResult.MaterialSlotNames);
+                }
+            }
+
+            MeshAssetSerializer::WriteStaticMeshMeta(context.AbsoluteHmeshPath, context.Settings,
+                                                     context.RelativeSourcePath, materialHandles,
+                                                     materialSlotNames);
+
+            AssetHandle hmeshHandle = 0;
+            for (const auto &[handle, metadata] : assetManager.GetAssetRegistry())
+            {
+                if (metadata.FilePath.generic_string() == context.RelativeHmeshPath.generic_string())
+                {
+                    hmeshHandle = handle;
+                    break;
+                }
+            }
+
+            if (hmeshHandle == 0)
+                hmeshHandle = assetManager.ImportAsset(context.RelativeHmeshPath);
+            else
+                assetManager.UnloadAsset(hmeshHandle);
+
+            assetManager.ClearCachedAssetLoadFailure(hmeshHandle);
+
+            assetManager.SerializeAssetRegistry();
+            HIMII_CORE_INFO("Static mesh reimport done: {0}", context.RelativeHmeshPath.generic_string());
+            return hmeshHandle;
         }
 
-        if (overrideSettings)
-            importSettings = *overrideSettings;
+        void RunImportAsync(const Ref<AssetManager> &assetManager, const Ref<SourceImportContext> &context,
+                            const Ref<MeshImportProgress> &progress, bool isReimport,
+                            StaticMeshImporter::ImportCompletedCallback onCompleted)
+        {
+            auto baked = CreateRef<bool>(false);
+            auto totalTimer = CreateRef<Timer>();
+            // 只持有弱引用：任务期间关闭 / 切换工程时旧的 AssetManager 不会因导入而被延长生命周期。
+            ImportProjectToken projectToken = CaptureImportProjectToken(assetManager);
+            JobSystem::Submit(
+                    [context, progress, baked]() { *baked = BakeHmeshFromSource(*context, progress.get()); },
+                    [projectToken = std::move(projectToken), context, progress, baked, totalTimer, isReimport,
+                     onCompleted = std::move(onCompleted)]()
+                    {
+                        AssetHandle hmeshHandle = 0;
+                        if (*baked && !IsImportProjectTokenCurrent(projectToken))
+                        {
+                            HIMII_CORE_WARNING("Static mesh async import dropped, project changed during import: {0}",
+                                               context->RelativeSourcePath.generic_string());
+                        }
+                        else if (*baked)
+                        {
+                            SetMeshImportStage(progress.get(), MeshImportStage::Finalizing);
+                            const Ref<AssetManager> assetManager = projectToken.Manager.lock();
+                            hmeshHandle = isReimport ? FinalizeReimport(*assetManager, *context)
+                                                     : FinalizeSourceImport(*assetManager, *context);
+                        }
+
+                        SetMeshImportStage(progress.get(),
+                                           hmeshHandle != 0 ? MeshImportStage::Completed : MeshImportStage::Failed);
+                        HIMII_CORE_INFO("Static mesh async import {0} in {1:.1f} ms: {2}",
+                                        hmeshHandle != 0 ? "finished" : "failed", totalTimer->ElapsedMillis(),
+                                        context->RelativeSourcePath.generic_string());
+                        if (onCompleted)
+                            onCompleted(hmeshHandle);
+                    });
+        }
 
-        const std::filesystem::path absoluteSourcePath =
-                Project::GetAssetFileSystemPath(relativeSourcePath);
-        if (!std::filesystem::exists(absoluteSourcePath))
+        void FailAsyncImport(const Ref<MeshImportProgress> &progress,
+                             const StaticMeshImporter::ImportCompletedCallback &onCompleted)
         {
-            HIMII_CORE_ERROR("Static mesh reimport failed, source missing: {0}",
-                             absoluteSourcePath.string());
-            return 0;
+            SetMeshImportStage(progress.get(), MeshImportStage::Failed);
+            if (onCompleted)
+                onCompleted(0);
         }
+    }
+
+    std::filesystem::path StaticMeshImporter::GetProductPathForSource(
+            const std::filesystem::path &relativeSourcePath)
+    {
+        return relativeSourcePath.parent_path()
+               / (relativeSourcePath.stem().string() + ".hmesh");
+    }
 
-        MeshAsset meshGeometry;
-        if (!LoadMeshGeometryFromSource(absoluteSourcePath, importSettings, meshGeometry))
+    AssetHandle StaticMeshImporter::ImportFromSource(AssetManager &assetManager,
+                                                     const std::filesystem::path &relativeSourcePath,
+                                                     const StaticMeshImportSettings &importSettings)
+    {
+        SourceImportContext context;
+        if (!PrepareSourceImport(relativeSourcePath, importSettings, context))
             return 0;
 
-        if (!HmeshAssetSerializer::Serialize(absoluteHmeshPath, meshGeometry))
+        if (!BakeHmeshFromSource(context, nullptr))
             return 0;
 
-        std::vector<AssetHandle> materialHandles;
-        std::vector<std::string> materialSlotNames;
-        if (importSettings.ImportMaterialsAndTextures)
-        {
-            if (preserveExistingCompanionMaterials)
-            {
-                materialHandles = existingMaterialHandles;
-                materialSlotNames = existingSlotNames;
-            }
-            else
-            {
-                MeshCompanionImportResult companionResult;
-                ImportMeshCompanionAssets(assetManager, relativeSourcePath, &companionResult);
-                materialHandles = std::move(companionResult.MaterialHandles);
-                materialSlotNames = std::move(companionResult.MaterialSlotNames);
-            }
-        }
+        return FinalizeSourceImport(assetManager, context);
+    }
 
-        MeshAssetSerializer::WriteStaticMeshMeta(absoluteHmeshPath, importSettings, relativeSourcePath,
-                                                 materialHandles, materialSlotNames);
+    AssetHandle StaticMeshImporter::ReimportProduct(AssetManager &assetManager,
+                                                    const std::filesystem::path &relativeHmeshPath,
+                                                    const StaticMeshImportSettings *overrideSettings,
+                                                    bool preserveExistingCompanionMaterials)
+    {
+        SourceImportContext context;
+        if (!PrepareReimport(relativeHmeshPath, overrideSettings, preserveExistingCompanionMaterials, context))
+            return 0;
+
+        if (!BakeHmeshFromSource(context, nullptr))
+            return 0;
 
-        AssetHandle hmeshHandle = 0;
-        for (const auto &[handle, metadata] : assetManager.GetAssetRegistry())
+        return FinalizeReimport(assetManager, context);
+    }
+
+    void StaticMeshImporter::ImportFromSourceAsync(const Ref<AssetManager> &assetManager,
+                                                   const std::filesystem::path &relativeSourcePath,
+                                                   const StaticMeshImportSettings &importSettings,
+                                                   const Ref<MeshImportProgress> &progress,
+                                                   ImportCompletedCallback onCompleted)
+    {
+        auto context = CreateRef<SourceImportContext>();
+        if (!assetManager || !PrepareSourceImport(relativeSourcePath, importSettings, *context))
         {
-            if (metadata.FilePath.generic_string() == relativeHmeshPath.generic_string())
-            {
-                hmeshHandle = handle;
-                break;
-            }
+            FailAsyncImport(progress, onCompleted);
+            return;
         }
 
-        if (hmeshHandle == 0)
-            hmeshHandle = assetManager.ImportAsset(relativeHmeshPath);
-        else
-            assetManager.UnloadAsset(hmeshHandle);
+        RunImportAsync(assetManager, context, progress, false, std::move(onCompleted));
+    }
 
-        assetManager.ClearCachedAssetLoadFailure(hmeshHandle);
+    void StaticMeshImporter::ReimportProductAsync(const Ref<AssetManager> &assetManager,
+                                                  const std::filesystem::path &relativeHmeshPath,
+                                                  const StaticMeshImportSettings *overrideSettings,
+                                                  bool preserveExistingCompanionMaterials,
+                                                  const Ref<MeshImportProgress> &progress,
+                                                  ImportCompletedCallback onCompleted)
+    {
+        auto context = CreateRef<SourceImportContext>();
+        if (!assetManager
+            || !PrepareReimport(relativeHmeshPath, overrideSettings, preserveExistingCompanionMaterials, *context))
+        {
+            FailAsyncImport(progress, onCompleted);
+            return;
+        }
 
-        assetManager.SerializeAssetRegistry();
-        HIMII_CORE_INFO("Static mesh reimport done: {0}", relativeHmeshPath.generic_string());
-        return hmeshHandle;
+        RunImportAsync(assetManager, context, progress, true, std::move(onCompleted));
     }
 }
@@ -1,14 +1,18 @@
 #pragma once
 
+#include "Module/Render/Mesh/MeshImportJobs.h"
 #include "Module/Render/Mesh/StaticMeshImportSettings.h"
 #include "Resource/AssetManager.h"
 #include <filesystem>
+#include <functional>
 
 namespace Himii
 {
     class StaticMeshImporter
     {
     public:
+        using ImportCompletedCallback = std::function<void(AssetHandle)>;
+
         /// 从源文件导入：烘焙 `.hmesh`、可选 companion、写入 meta；返回 `.hmesh` 的 Handle。
         static AssetHandle ImportFromSource(AssetManager &assetManager,
                                             const std::filesystem::path &relativeSourcePath,
@@ -20,6 +24,21 @@ namespace Himii
                                            const StaticMeshImportSettings *overrideSettings = nullptr,
                                            bool preserveExistingCompanionMaterials = false);
 
+        /// 异步版本：几何解码与 `.hmesh` 写出在工作线程，companion / meta / 注册表在主线程完成回调中处理。
+        /// onCompleted 在主线程调用，失败时 Handle 为 0；progress 可为空。
+        static void ImportFromSourceAsync(const Ref<AssetManager> &assetManager,
+                                          const std::filesystem::path &relativeSourcePath,
+                                          const StaticMeshImportSettings &importSettings,
+                                          const Ref<MeshImportProgress> &progress,
+                                          ImportCompletedCallback onCompleted = nullptr);
+
+        static void ReimportProductAsync(const Ref<AssetManager> &assetManager,
+                                         const std::filesystem::path &relativeHmeshPath,
+                                         const StaticMeshImportSettings *overrideSettings,
+                                         bool preserveExistingCompanionMaterials,
+                                         const Ref<MeshImportProgress> &progress,
+                                         ImportCompletedCallback onCompleted = nullptr);
+
         static std::filesystem::path GetProductPathForSource(
                 const std::filesystem::path &relativeSourcePath);
     };
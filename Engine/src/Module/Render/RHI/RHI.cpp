@@ -6,6 +6,7 @@
 #include "Platform/OpenGL/OpenGLTexture.h"
 #include "Platform/OpenGL/OpenGLTextureCube.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/OpenGL/OpenGLShaderCache.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
 #include "Platform/OpenGL/OpenGLContext.h"
@@ -108,6 +109,31 @@ namespace Himii
         }
     }
 
+    Ref<Texture2D> RHI::CreateTexture2D(const std::string &path, const TextureLoadSettings &loadSettings)
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                return CreateRef<OpenGLTexture>(path, loadSettings);
+            default:
+                HIMII_CORE_ASSERT(false, "Selected RHI backend is currently not supported!");
+                return nullptr;
+        }
+    }
+
+    Ref<Texture2D> RHI::CreateTexture2D(const std::string &path, const TextureSpecification &specification,
+                                        const std::vector<CompressedTextureMip> &mips)
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                return CreateRef<OpenGLTexture>(path, specification, mips);
+            default:
+                HIMII_CORE_ASSERT(false, "Selected RHI backend is currently not supported!");
+                return nullptr;
+        }
+    }
+
     Ref<TextureCube> RHI::CreateTextureCube(const std::vector<std::string> &paths)
     {
         switch (s_API)
@@ -157,6 +183,78 @@ namespace Himii
         }
     }
 
+    ShaderPrecompileResult RHI::PrecompileShader(const std::string &filepath, bool keepForLink)
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                return OpenGLShader::PrecompileFile(filepath, keepForLink);
+            default:
+                HIMII_CORE_ASSERT(false, "Selected RHI backend is currently not supported!");
+                return {};
+        }
+    }
+
+    ShaderPrecompileResult RHI::PrecompileShader(const std::string &name, const std::string &vertexSource,
+                                                 const std::string &fragmentSource, bool keepForLink)
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                return OpenGLShader::Precompile(name, vertexSource, fragmentSource, keepForLink);
+            default:
+                HIMII_CORE_ASSERT(false, "Selected RHI backend is currently not supported!");
+                return {};
+        }
+    }
+
+    void RHI::ReleasePrecompiledShaders()
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                OpenGLShader::ClearPrecompiledStages();
+                break;
+            default:
+                break;
+        }
+    }
+
+    void RHI::FlushShaderCache()
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                OpenGLShaderCache::Flush();
+                break;
+            default:
+                break;
+        }
+    }
+
+    void RHI::ShutdownShaderCache()
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                OpenGLShaderCache::Shutdown();
+                break;
+            default:
+                break;
+        }
+    }
+
+    ShaderCacheStatistics RHI::GetShaderCacheStatistics()
+    {
+        switch (s_API)
+        {
+            case API::OpenGL:
+                return OpenGLShaderCache::GetStatistics();
+            default:
+                return {};
+        }
+    }
+
     Ref<Framebuffer> RHI::CreateFramebuffer(const FramebufferSpecification &specification)
     {
         switch (s_API)
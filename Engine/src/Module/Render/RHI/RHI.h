@@ -58,6 +58,9 @@ namespace Himii
         virtual void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount = 0) = 0;
         virtual void DrawIndexedInstanced(
                 const Ref<VertexArray> &vertexArray, uint32_t indexCount, uint32_t instanceCount) = 0;
+        /// 单次提交多段索引区间（firstIndices 以索引个数计）；用于 meshlet 剔除后的压缩绘制。
+        virtual void DrawIndexedMultiRange(const Ref<VertexArray> &vertexArray, const uint32_t *indexCounts,
+                                           const uint32_t *firstIndices, uint32_t rangeCount) = 0;
         virtual void DrawArrays(const Ref<VertexArray> &vertexArray, uint32_t vertexCount = 0) = 0;
         virtual void DrawLines(const Ref<VertexArray> &vertexArray, uint32_t indexCount = 0) = 0;
         virtual void SetLineWidth(float width) = 0;
@@ -75,11 +78,21 @@ namespace Himii
         static Ref<VertexArray> CreateVertexArray();
         static Ref<Texture2D> CreateTexture2D(const TextureSpecification &specification);
         static Ref<Texture2D> CreateTexture2D(const std::string &path);
+        static Ref<Texture2D> CreateTexture2D(const std::string &path, const TextureLoadSettings &loadSettings);
+        static Ref<Texture2D> CreateTexture2D(const std::string &path, const TextureSpecification &specification,
+                                              const std::vector<CompressedTextureMip> &mips);
         static Ref<TextureCube> CreateTextureCube(const std::vector<std::string> &paths);
         static Ref<TextureCube> CreateTextureCube(const TextureSpecification &specification);
         static Ref<Shader> CreateShader(const std::string &filepath);
         static Ref<Shader> CreateShader(
                 const std::string &name, const std::string &vertexSource, const std::string &fragmentSource);
+        static ShaderPrecompileResult PrecompileShader(const std::string &filepath, bool keepForLink);
+        static ShaderPrecompileResult PrecompileShader(const std::string &name, const std::string &vertexSource,
+                                                       const std::string &fragmentSource, bool keepForLink);
+        static void ReleasePrecompiledShaders();
+        static void FlushShaderCache();
+        static void ShutdownShaderCache();
+        static ShaderCacheStatistics GetShaderCacheStatistics();
         static Ref<Framebuffer> CreateFramebuffer(const FramebufferSpecification &specification);
         static Ref<UniformBuffer> CreateUniformBuffer(uint32_t size, uint32_t binding);
         /// nativeWindowHandle：当前 OpenGL 后端为 GLFWwindow*。
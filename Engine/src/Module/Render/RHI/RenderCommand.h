@@ -30,6 +30,12 @@ namespace Himii
             s_RHI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount);
         }
 
+        inline static void DrawIndexedMultiRange(const Ref<VertexArray> &vertexArray, const uint32_t *indexCounts,
+                                                 const uint32_t *firstIndices, uint32_t rangeCount)
+        {
+            s_RHI->DrawIndexedMultiRange(vertexArray, indexCounts, firstIndices, rangeCount);
+        }
+
         inline static void DrawArrays(const Ref<VertexArray> &vertexArray, uint32_t vertexCount = 0)
         {
             s_RHI->DrawArrays(vertexArray, vertexCount);
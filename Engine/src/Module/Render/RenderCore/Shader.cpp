@@ -15,6 +15,37 @@ namespace Himii
         return RHI::CreateShader(name, vertexSource, fragmentSource);
     }
 
+    ShaderPrecompileResult Shader::Precompile(const std::string &filepath, bool keepForLink)
+    {
+        return RHI::PrecompileShader(filepath, keepForLink);
+    }
+
+    ShaderPrecompileResult Shader::Precompile(const std::string &name, const std::string &vertexSource,
+                                              const std::string &fragmentSource, bool keepForLink)
+    {
+        return RHI::PrecompileShader(name, vertexSource, fragmentSource, keepForLink);
+    }
+
+    void Shader::ReleasePrecompiled()
+    {
+        RHI::ReleasePrecompiledShaders();
+    }
+
+    void Shader::FlushCache()
+    {
+        RHI::FlushShaderCache();
+    }
+
+    void Shader::ShutdownCache()
+    {
+        RHI::ShutdownShaderCache();
+    }
+
+    ShaderCacheStatistics Shader::GetCacheStatistics()
+    {
+        return RHI::GetShaderCacheStatistics();
+    }
+
     void ShaderLibrary::Add(Ref<Shader> &shader)
     {
         auto name = shader->GetName();
@@ -5,6 +5,30 @@
 
 namespace Himii
 {
+    /// 着色器 CPU 编译阶段（预处理 + 字节码生成）的结果，不含 GPU 链接。
+    struct ShaderPrecompileResult {
+        std::string Name;
+        bool Succeeded = false;
+        // 全部阶段均命中磁盘缓存。
+        bool CacheHit = false;
+        float CompileMilliseconds = 0.0f;
+    };
+
+    /// 着色器缓存统计：条目与容量为当前状态，命中 / 未命中为本进程累计。
+    struct ShaderCacheStatistics {
+        uint32_t EntryCount = 0;
+        uint64_t SizeBytes = 0;
+        uint64_t CapacityBytes = 0;
+        // SPIR-V（Vulkan / OpenGL 两级）查找。
+        uint32_t BytecodeHits = 0;
+        uint32_t BytecodeMisses = 0;
+        uint32_t ProgramBinaryHits = 0;
+        uint32_t ProgramBinaryMisses = 0;
+        // 驱动拒绝加载的程序二进制。
+        uint32_t ProgramBinaryRejected = 0;
+        uint32_t Evictions = 0;
+    };
+
     class Shader {
     public:
         virtual ~Shader() = default;
@@ -25,6 +49,18 @@ namespace Himii
 
         static Ref<Shader> Create(const std::string &filepath);
         static Ref<Shader> Create(const std::string& name, const std::string &vertexSrc, const std::string &fragmentSrc);
+
+        /// 线程安全，可在 JobSystem 工作线程调用；keepForLink 时随后同源的 Create 只做链接。
+        static ShaderPrecompileResult Precompile(const std::string &filepath, bool keepForLink);
+        static ShaderPrecompileResult Precompile(const std::string &name, const std::string &vertexSrc,
+                                                 const std::string &fragmentSrc, bool keepForLink);
+        static void ReleasePrecompiled();
+
+        /// 把新编译的条目写入磁盘缓存；无新增时不做任何事。
+        static void FlushCache();
+        /// 写回缓存（含 LRU 使用记录）并释放映射，渲染器关闭时调用。
+        static void ShutdownCache();
+        static ShaderCacheStatistics GetCacheStatistics();
     };
 
     class ShaderLibrary {
@@ -23,6 +23,17 @@ namespace Himii
         return RHI::CreateTexture2D(path);
     }
 
+    Ref<Texture2D> Texture2D::Create(const std::string &path, const TextureLoadSettings &loadSettings)
+    {
+        return RHI::CreateTexture2D(path, loadSettings);
+    }
+
+    Ref<Texture2D> Texture2D::Create(const std::string &path, const TextureSpecification &specification,
+                                     const std::vector<CompressedTextureMip> &mips)
+    {
+        return RHI::CreateTexture2D(path, specification, mips);
+    }
+
     Ref<TextureCube> TextureCube::Create(const std::vector<std::string> &paths)
     {
         return RHI::CreateTextureCube(paths);
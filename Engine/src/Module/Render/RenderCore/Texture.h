@@ -15,7 +15,13 @@ namespace Himii
         RGBA8,
         RGBA32F,
         RGB16F,
-        RG16F
+        RG16F,
+        // 4x4 块压缩格式，仅用于烘焙纹理（.htex）上传。
+        BC1_RGBA,
+        BC3_RGBA,
+        BC4_R,
+        BC5_RG,
+        BC7_RGBA
     };
 
     struct TextureSpecification {
@@ -27,6 +33,48 @@ namespace Himii
         bool UseLinearFiltering = true;
     };
 
+    enum class TextureMipFilter : uint8_t {
+        Box = 0,
+        Kaiser = 1
+    };
+
+    /// 从图片路径加载 Texture2D 时的 CPU 预处理选项（来自纹理 .meta 的 TextureImportData）。
+    struct TextureLoadSettings {
+        bool GenerateMips = false;
+        TextureMipFilter MipFilter = TextureMipFilter::Box;
+        // 颜色按 sRGB 解码到线性空间后滤波；法线 / 数据贴图应关闭。
+        bool SRGB = true;
+        // 生成 mip 时颜色按 alpha 加权平均，避免透明像素的颜色渗入边缘；只影响滤波，
+        // 各级存储的仍是非预乘（直通）alpha 的像素。
+        bool AlphaWeightedMipFiltering = true;
+    };
+
+    /// 纹理用途，决定 Auto 压缩时选用的块格式。
+    enum class TextureUsage : uint8_t {
+        Color = 0,
+        NormalMap = 1,
+        Mask = 2
+    };
+
+    /// 烘焙压缩格式；None 表示不烘焙，运行时直接解码源图片。
+    enum class TextureCompression : uint8_t {
+        None = 0,
+        Auto,
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC7
+    };
+
+    /// 预压缩的一层数据，Data 指向调用方持有的内存（通常是映射的 .htex 文件）。
+    struct CompressedTextureMip {
+        const void *Data = nullptr;
+        uint32_t ByteSize = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+    };
+
     class Texture : public Asset {
     public:
         virtual ~Texture() = default;
@@ -61,6 +109,12 @@ namespace Himii
         static Ref<Texture2D> Create(uint32_t width, uint32_t height);
         static Ref<Texture2D> Create(const TextureSpecification &specification);
         static Ref<Texture2D> Create(const std::string &path);
+        static Ref<Texture2D> Create(const std::string &path, const TextureLoadSettings &loadSettings);
+        /// specification.Format 为 BC 格式；mips 按层级顺序给出完整链（或仅基础层），直接上传不做解码。
+        static Ref<Texture2D> Create(const std::string &path, const TextureSpecification &specification,
+                                     const std::vector<CompressedTextureMip> &mips);
+
+        virtual uint32_t GetMipLevelCount() const = 0;
     };
 
     class TextureCube : public Texture {
@@ -0,0 +1,834 @@
+#include "Hepch.h"
+#include "Module/Render/RenderCore/TextureBlockCompression.h"
+#include "EngineCore/Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr uint32_t ParallelBlockRowThreshold = 16u;
+
+        // BC7 4 位索引插值权重（规范表）。
+        constexpr uint32_t Bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        struct BlockPixels
+        {
+            uint8_t Rgba[16][4];
+        };
+
+        void FetchBlock(const uint8_t *rgbaPixels, uint32_t width, uint32_t height, uint32_t blockX,
+                        uint32_t blockY, BlockPixels &outBlock)
+        {
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                const uint32_t sourceY = std::min(blockY * 4u + y, height - 1u);
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const uint32_t sourceX = std::min(blockX * 4u + x, width - 1u);
+                    std::memcpy(outBlock.Rgba[y * 4 + x],
+                                rgbaPixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4u, 4);
+                }
+            }
+        }
+
+        // ---------------------------------------------------------------- BC1
+
+        uint16_t PackRgb565(const float color[3])
+        {
+            const uint32_t red = static_cast<uint32_t>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+            const uint32_t green = static_cast<uint32_t>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+            const uint32_t blue = static_cast<uint32_t>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+            return static_cast<uint16_t>((red << 11) | (green << 5) | blue);
+        }
+
+        void UnpackRgb565(uint16_t packed, int outColor[3])
+        {
+            const int red = (packed >> 11) & 31;
+            const int green = (packed >> 5) & 63;
+            const int blue = packed & 31;
+            outColor[0] = (red << 3) | (red >> 2);
+            outColor[1] = (green << 2) | (green >> 4);
+            outColor[2] = (blue << 3) | (blue >> 2);
+        }
+
+        void BuildBc1Palette(uint16_t color0, uint16_t color1, bool threeColorMode, int outPalette[4][4])
+        {
+            UnpackRgb565(color0, outPalette[0]);
+            UnpackRgb565(color1, outPalette[1]);
+            outPalette[0][3] = 255;
+            outPalette[1][3] = 255;
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                if (threeColorMode)
+                {
+                    outPalette[2][channel] = (outPalette[0][channel] + outPalette[1][channel]) / 2;
+                    outPalette[3][channel] = 0;
+                }
+                else
+                {
+                    outPalette[2][channel] = (2 * outPalette[0][channel] + outPalette[1][channel]) / 3;
+                    outPalette[3][channel] = (outPalette[0][channel] + 2 * outPalette[1][channel]) / 3;
+                }
+            }
+            outPalette[2][3] = 255;
+            outPalette[3][3] = threeColorMode ? 0 : 255;
+        }
+
+        /// 主成分轴上的两个极值作为端点初值（幂迭代求协方差主轴）。
+        template <uint32_t ChannelCount>
+        void ComputePrincipalEndpoints(const float values[16][4], const bool *includeMask, float outMinimum[4],
+                                       float outMaximum[4])
+        {
+            float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            uint32_t includedCount = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                if (includeMask && !includeMask[texel])
+                    continue;
+                for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                    mean[channel] += values[texel][channel];
+                ++includedCount;
+            }
+            if (includedCount == 0)
+            {
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                    outMinimum[channel] = outMaximum[channel] = 0.0f;
+                return;
+            }
+            for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                mean[channel] /= static_cast<float>(includedCount);
+
+            float covariance[4][4] = {};
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                if (includeMask && !includeMask[texel])
+                    continue;
+                for (uint32_t row = 0; row < ChannelCount; ++row)
+                    for (uint32_t column = 0; column < ChannelCount; ++column)
+                        covariance[row][column] +=
+                                (values[texel][row] - mean[row]) * (values[texel][column] - mean[column]);
+            }
+
+            float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+            for (uint32_t iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (uint32_t row = 0; row < ChannelCount; ++row)
+                    for (uint32_t column = 0; column < ChannelCount; ++column)
+                        next[row] += covariance[row][column] * axis[column];
+                float largest = 0.0f;
+                for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                    largest = std::max(largest, std::abs(next[channel]));
+                if (largest < 1.0e-6f)
+                    break;
+                for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                    axis[channel] = next[channel] / largest;
+            }
+
+            float axisLengthSquared = 0.0f;
+            for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                axisLengthSquared += axis[channel] * axis[channel];
+
+            float minimumProjection = 0.0f;
+            float maximumProjection = 0.0f;
+            bool first = true;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                if (includeMask && !includeMask[texel])
+                    continue;
+                float projection = 0.0f;
+                for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                    projection += (values[texel][channel] - mean[channel]) * axis[channel];
+                if (first || projection < minimumProjection)
+                    minimumProjection = projection;
+                if (first || projection > maximumProjection)
+                    maximumProjection = projection;
+                first = false;
+            }
+
+            const float scale = axisLengthSquared > 0.0f ? 1.0f / axisLengthSquared : 0.0f;
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                if (channel >= ChannelCount)
+                {
+                    outMinimum[channel] = outMaximum[channel] = 0.0f;
+                    continue;
+                }
+                outMinimum[channel] = mean[channel] + axis[channel] * minimumProjection * scale;
+                outMaximum[channel] = mean[channel] + axis[channel] * maximumProjection * scale;
+            }
+        }
+
+        uint32_t SquaredDistance3(const float color[4], const int palette[4])
+        {
+            const float red = color[0] - static_cast<float>(palette[0]);
+            const float green = color[1] - static_cast<float>(palette[1]);
+            const float blue = color[2] - static_cast<float>(palette[2]);
+            return static_cast<uint32_t>(red * red + green * green + blue * blue);
+        }
+
+        /// 以当前索引做最小二乘求端点（4 色模式权重 1, 0, 2/3, 1/3）。
+        bool RefineBc1Endpoints(const float colors[16][4], const uint8_t indices[16], float outEndpoint0[3],
+                                float outEndpoint1[3])
+        {
+            constexpr float Weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+            float alphaAlpha = 0.0f, betaBeta = 0.0f, alphaBeta = 0.0f;
+            float alphaColor[3] = {0.0f, 0.0f, 0.0f};
+            float betaColor[3] = {0.0f, 0.0f, 0.0f};
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                const float alpha = Weights[indices[texel]];
+                const float beta = 1.0f - alpha;
+                alphaAlpha += alpha * alpha;
+                betaBeta += beta * beta;
+                alphaBeta += alpha * beta;
+                for (uint32_t channel = 0; channel < 3; ++channel)
+                {
+                    alphaColor[channel] += alpha * colors[texel][channel];
+                    betaColor[channel] += beta * colors[texel][channel];
+                }
+            }
+
+            const float determinant = alphaAlpha * betaBeta - alphaBeta * alphaBeta;
+            if (std::abs(determinant) < 1.0e-6f)
+                return false;
+
+            const float inverseDeterminant = 1.0f / determinant;
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                outEndpoint0[channel] =
+                        (alphaColor[channel] * betaBeta - betaColor[channel] * alphaBeta) * inverseDeterminant;
+                outEndpoint1[channel] =
+                        (betaColor[channel] * alphaAlpha - alphaColor[channel] * alphaBeta) * inverseDeterminant;
+            }
+            return true;
+        }
+
+        uint32_t AssignBc1Indices(const float colors[16][4], const bool transparent[16], uint16_t color0,
+                                  uint16_t color1, bool threeColorMode, uint8_t outIndices[16])
+        {
+            int palette[4][4];
+            BuildBc1Palette(color0, color1, threeColorMode, palette);
+            const uint32_t paletteSize = threeColorMode ? 3u : 4u;
+            uint32_t totalError = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                if (threeColorMode && transparent[texel])
+                {
+                    outIndices[texel] = 3;
+                    continue;
+                }
+                uint32_t bestError = UINT32_MAX;
+                for (uint32_t paletteIndex = 0; paletteIndex < paletteSize; ++paletteIndex)
+                {
+                    const uint32_t error = SquaredDistance3(colors[texel], palette[paletteIndex]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        outIndices[texel] = static_cast<uint8_t>(paletteIndex);
+                    }
+                }
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        void WriteBc1Block(uint16_t color0, uint16_t color1, const uint8_t indices[16], uint8_t *outBlock)
+        {
+            uint32_t indexBits = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+                indexBits |= static_cast<uint32_t>(indices[texel] & 3u) << (texel * 2u);
+            outBlock[0] = static_cast<uint8_t>(color0 & 0xFF);
+            outBlock[1] = static_cast<uint8_t>(color0 >> 8);
+            outBlock[2] = static_cast<uint8_t>(color1 & 0xFF);
+            outBlock[3] = static_cast<uint8_t>(color1 >> 8);
+            std::memcpy(outBlock + 4, &indexBits, 4);
+        }
+
+        /// allowPunchThrough：BC1 独立使用时，含 alpha < 128 的块走 3 色 + 透明模式。
+        void EncodeBc1Block(const BlockPixels &block, bool allowPunchThrough, uint8_t *outBlock)
+        {
+            float colors[16][4];
+            bool transparent[16];
+            bool anyTransparent = false;
+            bool anyOpaque = false;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                    colors[texel][channel] = static_cast<float>(block.Rgba[texel][channel]);
+                transparent[texel] = allowPunchThrough && block.Rgba[texel][3] < 128;
+                anyTransparent |= transparent[texel];
+                anyOpaque |= !transparent[texel];
+            }
+
+            if (!anyOpaque)
+            {
+                uint8_t indices[16];
+                std::fill(std::begin(indices), std::end(indices), static_cast<uint8_t>(3));
+                WriteBc1Block(0, 0xFFFF, indices, outBlock);
+                return;
+            }
+
+            bool opaqueMask[16];
+            for (uint32_t texel = 0; texel < 16; ++texel)
+                opaqueMask[texel] = !transparent[texel];
+
+            float minimum[4];
+            float maximum[4];
+            ComputePrincipalEndpoints<3>(colors, opaqueMask, minimum, maximum);
+            uint16_t color0 = PackRgb565(maximum);
+            uint16_t color1 = PackRgb565(minimum);
+
+            uint8_t indices[16];
+            if (anyTransparent)
+            {
+                // 3 色模式要求 color0 <= color1。
+                if (color0 > color1)
+                    std::swap(color0, color1);
+                AssignBc1Indices(colors, transparent, color0, color1, true, indices);
+                WriteBc1Block(color0, color1, indices, outBlock);
+                return;
+            }
+
+            if (color0 < color1)
+                std::swap(color0, color1);
+            uint32_t bestError = AssignBc1Indices(colors, transparent, color0, color1, false, indices);
+
+            for (uint32_t iteration = 0; iteration < 2 && color0 != color1; ++iteration)
+            {
+                float refined0[3];
+                float refined1[3];
+                if (!RefineBc1Endpoints(colors, indices, refined0, refined1))
+                    break;
+                uint16_t candidate0 = PackRgb565(refined0);
+                uint16_t candidate1 = PackRgb565(refined1);
+                if (candidate0 < candidate1)
+                    std::swap(candidate0, candidate1);
+                if (candidate0 == candidate1)
+                    break;
+
+                uint8_t candidateIndices[16];
+                const uint32_t candidateError =
+                        AssignBc1Indices(colors, transparent, candidate0, candidate1, false, candidateIndices);
+                if (candidateError >= bestError)
+                    break;
+                bestError = candidateError;
+                color0 = candidate0;
+                color1 = candidate1;
+                std::memcpy(indices, candidateIndices, sizeof(indices));
+            }
+
+            if (color0 == color1)
+                std::fill(std::begin(indices), std::end(indices), static_cast<uint8_t>(0));
+            WriteBc1Block(color0, color1, indices, outBlock);
+        }
+
+        // ---------------------------------------------------------------- BC4
+
+        void BuildBc4Palette(uint8_t endpoint0, uint8_t endpoint1, int outPalette[8])
+        {
+            outPalette[0] = endpoint0;
+            outPalette[1] = endpoint1;
+            if (endpoint0 > endpoint1)
+            {
+                for (int index = 1; index < 7; ++index)
+                    outPalette[index + 1] = ((7 - index) * endpoint0 + index * endpoint1) / 7;
+            }
+            else
+            {
+                for (int index = 1; index < 5; ++index)
+                    outPalette[index + 1] = ((5 - index) * endpoint0 + index * endpoint1) / 5;
+                outPalette[6] = 0;
+                outPalette[7] = 255;
+            }
+        }
+
+        void EncodeBc4Block(const BlockPixels &block, uint32_t channel, uint8_t *outBlock)
+        {
+            uint8_t minimum = 255;
+            uint8_t maximum = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                minimum = std::min(minimum, block.Rgba[texel][channel]);
+                maximum = std::max(maximum, block.Rgba[texel][channel]);
+            }
+
+            // 8 值模式：endpoint0 > endpoint1；整块同值时退化为 endpoint0 == endpoint1（6 值模式，索引全 0）。
+            const uint8_t endpoint0 = maximum;
+            const uint8_t endpoint1 = minimum;
+            int palette[8];
+            BuildBc4Palette(endpoint0, endpoint1, palette);
+
+            uint64_t indexBits = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                const int value = block.Rgba[texel][channel];
+                uint32_t bestIndex = 0;
+                int bestError = INT32_MAX;
+                const uint32_t paletteSize = endpoint0 > endpoint1 ? 8u : 1u;
+                for (uint32_t paletteIndex = 0; paletteIndex < paletteSize; ++paletteIndex)
+                {
+                    const int error = std::abs(value - palette[paletteIndex]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = paletteIndex;
+                    }
+                }
+                indexBits |= static_cast<uint64_t>(bestIndex) << (texel * 3u);
+            }
+
+            outBlock[0] = endpoint0;
+            outBlock[1] = endpoint1;
+            for (uint32_t byteIndex = 0; byteIndex < 6; ++byteIndex)
+                outBlock[2 + byteIndex] = static_cast<uint8_t>((indexBits >> (byteIndex * 8u)) & 0xFF);
+        }
+
+        void DecodeBc4Block(const uint8_t *block, uint8_t outValues[16])
+        {
+            int palette[8];
+            BuildBc4Palette(block[0], block[1], palette);
+            uint64_t indexBits = 0;
+            for (uint32_t byteIndex = 0; byteIndex < 6; ++byteIndex)
+                indexBits |= static_cast<uint64_t>(block[2 + byteIndex]) << (byteIndex * 8u);
+            for (uint32_t texel = 0; texel < 16; ++texel)
+                outValues[texel] = static_cast<uint8_t>(palette[(indexBits >> (texel * 3u)) & 7u]);
+        }
+
+        // ---------------------------------------------------------------- BC7 (mode 6)
+
+        struct BitWriter
+        {
+            uint8_t *Bytes;
+            uint32_t Position = 0;
+
+            void Write(uint32_t value, uint32_t bitCount)
+            {
+                for (uint32_t bit = 0; bit < bitCount; ++bit, ++Position)
+                {
+                    if ((value >> bit) & 1u)
+                        Bytes[Position >> 3] |= static_cast<uint8_t>(1u << (Position & 7u));
+                }
+            }
+        };
+
+        struct BitReader
+        {
+            const uint8_t *Bytes;
+            uint32_t Position = 0;
+
+            uint32_t Read(uint32_t bitCount)
+            {
+                uint32_t value = 0;
+                for (uint32_t bit = 0; bit < bitCount; ++bit, ++Position)
+                    value |= static_cast<uint32_t>((Bytes[Position >> 3] >> (Position & 7u)) & 1u) << bit;
+                return value;
+            }
+        };
+
+        uint32_t Bc7InterpolateChannel(uint32_t endpoint0, uint32_t endpoint1, uint32_t index)
+        {
+            return ((64u - Bc7Weights4[index]) * endpoint0 + Bc7Weights4[index] * endpoint1 + 32u) >> 6;
+        }
+
+        /// 端点 7 位 + P 位 → 8 位。
+        void QuantizeBc7Endpoint(const float value[4], uint32_t pBit, uint32_t outQuantized[4],
+                                 uint32_t outExpanded[4])
+        {
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                const float clamped = std::clamp(value[channel], 0.0f, 255.0f);
+                int quantized = static_cast<int>(std::lround((clamped - static_cast<float>(pBit)) / 2.0f));
+                quantized = std::clamp(quantized, 0, 127);
+                outQuantized[channel] = static_cast<uint32_t>(quantized);
+                outExpanded[channel] = (static_cast<uint32_t>(quantized) << 1) | pBit;
+            }
+        }
+
+        uint32_t AssignBc7Indices(const float colors[16][4], const uint32_t endpoint0[4],
+                                  const uint32_t endpoint1[4], uint8_t outIndices[16])
+        {
+            int palette[16][4];
+            for (uint32_t index = 0; index < 16; ++index)
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                    palette[index][channel] =
+                            static_cast<int>(Bc7InterpolateChannel(endpoint0[channel], endpoint1[channel], index));
+
+            uint32_t totalError = 0;
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                uint32_t bestError = UINT32_MAX;
+                for (uint32_t index = 0; index < 16; ++index)
+                {
+                    uint32_t error = 0;
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        const float difference = colors[texel][channel] - static_cast<float>(palette[index][channel]);
+                        error += static_cast<uint32_t>(difference * difference);
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        outIndices[texel] = static_cast<uint8_t>(index);
+                    }
+                }
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        struct Bc7Mode6Candidate
+        {
+            uint32_t Quantized0[4];
+            uint32_t Quantized1[4];
+            uint32_t PBit0 = 0;
+            uint32_t PBit1 = 0;
+            uint8_t Indices[16];
+            uint32_t Error = UINT32_MAX;
+        };
+
+        void EvaluateBc7Endpoints(const float colors[16][4], const float endpoint0[4], const float endpoint1[4],
+                                  Bc7Mode6Candidate &bestCandidate)
+        {
+            for (uint32_t pBitCombination = 0; pBitCombination < 4; ++pBitCombination)
+            {
+                Bc7Mode6Candidate candidate;
+                candidate.PBit0 = pBitCombination & 1u;
+                candidate.PBit1 = (pBitCombination >> 1) & 1u;
+                uint32_t expanded0[4];
+                uint32_t expanded1[4];
+                QuantizeBc7Endpoint(endpoint0, candidate.PBit0, candidate.Quantized0, expanded0);
+                QuantizeBc7Endpoint(endpoint1, candidate.PBit1, candidate.Quantized1, expanded1);
+                candidate.Error = AssignBc7Indices(colors, expanded0, expanded1, candidate.Indices);
+                if (candidate.Error < bestCandidate.Error)
+                    bestCandidate = candidate;
+            }
+        }
+
+        void EncodeBc7Mode6Block(const BlockPixels &block, uint8_t *outBlock)
+        {
+            float colors[16][4];
+            for (uint32_t texel = 0; texel < 16; ++texel)
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                    colors[texel][channel] = static_cast<float>(block.Rgba[texel][channel]);
+
+            float minimum[4];
+            float maximum[4];
+            ComputePrincipalEndpoints<4>(colors, nullptr, minimum, maximum);
+
+            Bc7Mode6Candidate best;
+            EvaluateBc7Endpoints(colors, minimum, maximum, best);
+
+            // 一轮最小二乘细化：按当前索引权重重新拟合端点。
+            {
+                float alphaAlpha = 0.0f, betaBeta = 0.0f, alphaBeta = 0.0f;
+                float alphaColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                float betaColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (uint32_t texel = 0; texel < 16; ++texel)
+                {
+                    const float beta = static_cast<float>(Bc7Weights4[best.Indices[texel]]) / 64.0f;
+                    const float alpha = 1.0f - beta;
+                    alphaAlpha += alpha * alpha;
+                    betaBeta += beta * beta;
+                    alphaBeta += alpha * beta;
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        alphaColor[channel] += alpha * colors[texel][channel];
+                        betaColor[channel] += beta * colors[texel][channel];
+                    }
+                }
+                const float determinant = alphaAlpha * betaBeta - alphaBeta * alphaBeta;
+                if (std::abs(determinant) > 1.0e-6f)
+                {
+                    float refined0[4];
+                    float refined1[4];
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        refined0[channel] =
+                                (alphaColor[channel] * betaBeta - betaColor[channel] * alphaBeta) / determinant;
+                        refined1[channel] =
+                                (betaColor[channel] * alphaAlpha - alphaColor[channel] * alphaBeta) / determinant;
+                    }
+                    EvaluateBc7Endpoints(colors, refined0, refined1, best);
+                }
+            }
+
+            // 锚点（texel 0）索引最高位隐式为 0：必要时交换端点并反转索引。
+            if (best.Indices[0] >= 8)
+            {
+                std::swap(best.Quantized0, best.Quantized1);
+                std::swap(best.PBit0, best.PBit1);
+                for (uint32_t texel = 0; texel < 16; ++texel)
+                    best.Indices[texel] = static_cast<uint8_t>(15u - best.Indices[texel]);
+            }
+
+            std::memset(outBlock, 0, 16);
+            BitWriter writer{outBlock};
+            writer.Write(1u << 6, 7); // mode 6
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                writer.Write(best.Quantized0[channel], 7);
+                writer.Write(best.Quantized1[channel], 7);
+            }
+            writer.Write(best.PBit0, 1);
+            writer.Write(best.PBit1, 1);
+            writer.Write(best.Indices[0], 3);
+            for (uint32_t texel = 1; texel < 16; ++texel)
+                writer.Write(best.Indices[texel], 4);
+        }
+
+        bool DecodeBc7Mode6Block(const uint8_t *block, uint8_t outRgba[16][4])
+        {
+            BitReader reader{block};
+            if (reader.Read(7) != (1u << 6))
+                return false;
+
+            uint32_t endpoint0[4];
+            uint32_t endpoint1[4];
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                endpoint0[channel] = reader.Read(7) << 1;
+                endpoint1[channel] = reader.Read(7) << 1;
+            }
+            const uint32_t pBit0 = reader.Read(1);
+            const uint32_t pBit1 = reader.Read(1);
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                endpoint0[channel] |= pBit0;
+                endpoint1[channel] |= pBit1;
+            }
+
+            for (uint32_t texel = 0; texel < 16; ++texel)
+            {
+                const uint32_t index = reader.Read(texel == 0 ? 3 : 4);
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                    outRgba[texel][channel] =
+                            static_cast<uint8_t>(Bc7InterpolateChannel(endpoint0[channel], endpoint1[channel], index));
+            }
+            return true;
+        }
+
+        void EncodeBlock(const BlockPixels &block, ImageFormat format, uint8_t *outBlock)
+        {
+            switch (format)
+            {
+                case ImageFormat::BC1_RGBA:
+                    EncodeBc1Block(block, true, outBlock);
+                    break;
+                case ImageFormat::BC3_RGBA:
+                    EncodeBc4Block(block, 3, outBlock);
+                    EncodeBc1Block(block, false, outBlock + 8);
+                    break;
+                case ImageFormat::BC4_R:
+                    EncodeBc4Block(block, 0, outBlock);
+                    break;
+                case ImageFormat::BC5_RG:
+                    EncodeBc4Block(block, 0, outBlock);
+                    EncodeBc4Block(block, 1, outBlock + 8);
+                    break;
+                case ImageFormat::BC7_RGBA:
+                    EncodeBc7Mode6Block(block, outBlock);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        bool DecodeBlock(const uint8_t *block, ImageFormat format, uint8_t outRgba[16][4])
+        {
+            switch (format)
+            {
+                case ImageFormat::BC1_RGBA:
+                case ImageFormat::BC3_RGBA:
+                {
+                    const uint8_t *colorBlock = format == ImageFormat::BC3_RGBA ? block + 8 : block;
+                    const uint16_t color0 = static_cast<uint16_t>(colorBlock[0] | (colorBlock[1] << 8));
+                    const uint16_t color1 = static_cast<uint16_t>(colorBlock[2] | (colorBlock[3] << 8));
+                    int palette[4][4];
+                    BuildBc1Palette(color0, color1, format == ImageFormat::BC1_RGBA && color0 <= color1, palette);
+                    uint32_t indexBits = 0;
+                    std::memcpy(&indexBits, colorBlock + 4, 4);
+                    for (uint32_t texel = 0; texel < 16; ++texel)
+                    {
+                        const int *entry = palette[(indexBits >> (texel * 2u)) & 3u];
+                        for (uint32_t channel = 0; channel < 4; ++channel)
+                            outRgba[texel][channel] = static_cast<uint8_t>(entry[channel]);
+                    }
+                    if (format == ImageFormat::BC3_RGBA)
+                    {
+                        uint8_t alpha[16];
+                        DecodeBc4Block(block, alpha);
+                        for (uint32_t texel = 0; texel < 16; ++texel)
+                            outRgba[texel][3] = alpha[texel];
+                    }
+                    return true;
+                }
+                case ImageFormat::BC4_R:
+                case ImageFormat::BC5_RG:
+                {
+                    uint8_t red[16];
+                    uint8_t green[16] = {};
+                    DecodeBc4Block(block, red);
+                    if (format == ImageFormat::BC5_RG)
+                        DecodeBc4Block(block + 8, green);
+                    for (uint32_t texel = 0; texel < 16; ++texel)
+                    {
+                        outRgba[texel][0] = red[texel];
+                        outRgba[texel][1] = green[texel];
+                        outRgba[texel][2] = 0;
+                        outRgba[texel][3] = 255;
+                    }
+                    return true;
+                }
+                case ImageFormat::BC7_RGBA:
+                    return DecodeBc7Mode6Block(block, outRgba);
+                default:
+                    return false;
+            }
+        }
+
+        template <typename BlockRowFunction>
+        void ForEachBlockRow(uint32_t blockRowCount, const BlockRowFunction &blockRowFunction)
+        {
+            if (blockRowCount < ParallelBlockRowThreshold)
+            {
+                for (uint32_t blockRow = 0; blockRow < blockRowCount; ++blockRow)
+                    blockRowFunction(blockRow);
+                return;
+            }
+
+            JobSystem::ParallelFor(blockRowCount, 4,
+                                   [&](uint32_t beginRow, uint32_t endRow)
+                                   {
+                                       for (uint32_t blockRow = beginRow; blockRow < endRow; ++blockRow)
+                                           blockRowFunction(blockRow);
+                                   });
+        }
+    }
+
+    uint32_t GetBlockCompressedBytesPerBlock(ImageFormat format)
+    {
+        switch (format)
+        {
+            case ImageFormat::BC1_RGBA:
+            case ImageFormat::BC4_R:
+                return 8;
+            case ImageFormat::BC3_RGBA:
+            case ImageFormat::BC5_RG:
+            case ImageFormat::BC7_RGBA:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    bool IsBlockCompressedFormat(ImageFormat format)
+    {
+        return GetBlockCompressedBytesPerBlock(format) != 0;
+    }
+
+    uint32_t GetCompressedImageByteSize(ImageFormat format, uint32_t width, uint32_t height)
+    {
+        const uint32_t bytesPerBlock = GetBlockCompressedBytesPerBlock(format);
+        if (bytesPerBlock == 0)
+            return width * height * 4u;
+        return ((width + 3u) / 4u) * ((height + 3u) / 4u) * bytesPerBlock;
+    }
+
+    bool CompressRgba8Image(const uint8_t *rgbaPixels, uint32_t width, uint32_t height, ImageFormat format,
+                            uint8_t *outBlocks)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        const uint32_t bytesPerBlock = GetBlockCompressedBytesPerBlock(format);
+        if (!rgbaPixels || !outBlocks || bytesPerBlock == 0 || width == 0 || height == 0)
+            return false;
+
+        const uint32_t blockColumns = (width + 3u) / 4u;
+        const uint32_t blockRows = (height + 3u) / 4u;
+        ForEachBlockRow(blockRows,
+                        [&](uint32_t blockRow)
+                        {
+                            BlockPixels block;
+                            uint8_t *rowOutput = outBlocks + static_cast<size_t>(blockRow) * blockColumns * bytesPerBlock;
+                            for (uint32_t blockColumn = 0; blockColumn < blockColumns; ++blockColumn)
+                            {
+                                FetchBlock(rgbaPixels, width, height, blockColumn, blockRow, block);
+                                EncodeBlock(block, format, rowOutput + blockColumn * bytesPerBlock);
+                            }
+                        });
+        return true;
+    }
+
+    bool DecompressToRgba8Image(const uint8_t *blocks, uint32_t width, uint32_t height, ImageFormat format,
+                                uint8_t *outRgbaPixels)
+    {
+        const uint32_t bytesPerBlock = GetBlockCompressedBytesPerBlock(format);
+        if (!blocks || !outRgbaPixels || bytesPerBlock == 0)
+            return false;
+
+        const uint32_t blockColumns = (width + 3u) / 4u;
+        const uint32_t blockRows = (height + 3u) / 4u;
+        bool decodedAll = true;
+        for (uint32_t blockRow = 0; blockRow < blockRows; ++blockRow)
+        {
+            for (uint32_t blockColumn = 0; blockColumn < blockColumns; ++blockColumn)
+            {
+                uint8_t decoded[16][4];
+                const uint8_t *block = blocks + (static_cast<size_t>(blockRow) * blockColumns + blockColumn) * bytesPerBlock;
+                if (!DecodeBlock(block, format, decoded))
+                {
+                    decodedAll = false;
+                    std::memset(decoded, 0, sizeof(decoded));
+                }
+
+                for (uint32_t y = 0; y < 4; ++y)
+                {
+                    const uint32_t pixelY = blockRow * 4u + y;
+                    if (pixelY >= height)
+                        break;
+                    for (uint32_t x = 0; x < 4; ++x)
+                    {
+                        const uint32_t pixelX = blockColumn * 4u + x;
+                        if (pixelX >= width)
+                            break;
+                        std::memcpy(outRgbaPixels + (static_cast<size_t>(pixelY) * width + pixelX) * 4u,
+                                    decoded[y * 4 + x], 4);
+                    }
+                }
+            }
+        }
+        return decodedAll;
+    }
+
+    double ComputeBlockCompressionPsnr(const uint8_t *referenceRgba, const uint8_t *decodedRgba, uint32_t width,
+                                       uint32_t height, ImageFormat format)
+    {
+        uint32_t channelCount = 4;
+        if (format == ImageFormat::BC4_R)
+            channelCount = 1;
+        else if (format == ImageFormat::BC5_RG)
+            channelCount = 2;
+
+        double squaredErrorSum = 0.0;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+        {
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                const double difference = static_cast<double>(referenceRgba[pixelIndex * 4 + channel])
+                                          - static_cast<double>(decodedRgba[pixelIndex * 4 + channel]);
+                squaredErrorSum += difference * difference;
+            }
+        }
+
+        const double meanSquaredError = squaredErrorSum / static_cast<double>(pixelCount * channelCount);
+        if (meanSquaredError <= 0.0)
+            return 99.0;
+        return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Module/Render/RenderCore/Texture.h"
+
+#include <cstdint>
+
+namespace Himii
+{
+    /// 每 4x4 块的字节数：BC1 / BC4 为 8，BC3 / BC5 / BC7 为 16；非压缩格式返回 0。
+    uint32_t GetBlockCompressedBytesPerBlock(ImageFormat format);
+    bool IsBlockCompressedFormat(ImageFormat format);
+
+    /// 一层图像的压缩后字节数（宽高按 4 向上取整）；RGBA8 返回 width * height * 4。
+    uint32_t GetCompressedImageByteSize(ImageFormat format, uint32_t width, uint32_t height);
+
+    /// 将紧密打包的 RGBA8 图像编码为 BC1 / BC3 / BC4(R) / BC5(RG) / BC7，块行分发到 JobSystem。
+    /// 边缘不足 4 像素的块按钳制复制填满。BC7 只使用 mode 6（单子集 RGBA 7777+P，4 位索引）。
+    bool CompressRgba8Image(const uint8_t *rgbaPixels, uint32_t width, uint32_t height, ImageFormat format,
+                            uint8_t *outBlocks);
+
+    /// 解码 CompressRgba8Image 的输出（BC7 仅支持 mode 6），用于质量评估；BC4 / BC5 缺失通道填 0 / 255。
+    bool DecompressToRgba8Image(const uint8_t *blocks, uint32_t width, uint32_t height, ImageFormat format,
+                                uint8_t *outRgbaPixels);
+
+    /// 按格式实际承载的通道计算 PSNR（dB）；完全一致时返回 99。
+    double ComputeBlockCompressionPsnr(const uint8_t *referenceRgba, const uint8_t *decodedRgba, uint32_t width,
+                                       uint32_t height, ImageFormat format);
+}
@@ -0,0 +1,387 @@
+#include "Hepch.h"
+#include "Module/Render/RenderCore/TextureMipGenerator.h"
+#include "EngineCore/Core/JobSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HIMII_MIP_GENERATOR_SSE2 1
+#else
+    #define HIMII_MIP_GENERATOR_SSE2 0
+#endif
+
+namespace Himii
+{
+    namespace
+    {
+        // 像素数超过该值时按行并行。
+        constexpr uint32_t ParallelPixelThreshold = 256u * 256u;
+        constexpr uint32_t ParallelRowBatch = 16u;
+
+        // Kaiser 窗 sinc：半宽以目标像素为单位，alpha 控制旁瓣。
+        constexpr float KaiserHalfWidth = 2.0f;
+        constexpr float KaiserAlpha = 4.0f;
+
+        constexpr uint32_t LinearToSrgbTableSize = 65536u;
+
+        const std::array<float, 256> &GetSrgbToLinearTable()
+        {
+            static const std::array<float, 256> table = []()
+            {
+                std::array<float, 256> values{};
+                for (uint32_t index = 0; index < 256; ++index)
+                {
+                    const float encoded = static_cast<float>(index) / 255.0f;
+                    values[index] = encoded <= 0.04045f ? encoded / 12.92f
+                                                        : std::pow((encoded + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        // 16 位线性量化的编码表：暗部步长约 0.05 LSB，与逐像素 pow 的结果一致。
+        const std::vector<uint8_t> &GetLinearToSrgbTable()
+        {
+            static const std::vector<uint8_t> table = []()
+            {
+                std::vector<uint8_t> values(LinearToSrgbTableSize);
+                for (uint32_t index = 0; index < LinearToSrgbTableSize; ++index)
+                {
+                    const float linear = static_cast<float>(index) / static_cast<float>(LinearToSrgbTableSize - 1);
+                    const float encoded = linear <= 0.0031308f ? linear * 12.92f
+                                                               : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+                    values[index] = static_cast<uint8_t>(std::clamp(encoded * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        struct FilterTap
+        {
+            uint32_t SourceIndex;
+            float Weight;
+        };
+
+        /// 一维权重表：每个目标像素对应 TapOffsets[i]..TapOffsets[i+1] 的抽头。
+        struct FilterTaps
+        {
+            std::vector<FilterTap> Taps;
+            std::vector<uint32_t> TapOffsets;
+        };
+
+        float BesselI0(float value)
+        {
+            float sum = 1.0f;
+            float term = 1.0f;
+            const float halfValueSquared = 0.25f * value * value;
+            for (uint32_t iteration = 1; iteration < 32; ++iteration)
+            {
+                term *= halfValueSquared / static_cast<float>(iteration * iteration);
+                sum += term;
+                if (term < sum * 1.0e-8f)
+                    break;
+            }
+            return sum;
+        }
+
+        float KaiserSincWeight(float distance)
+        {
+            const float ratio = distance / KaiserHalfWidth;
+            if (ratio >= 1.0f)
+                return 0.0f;
+
+            constexpr float Pi = 3.14159265358979f;
+            const float sinc = distance < 1.0e-5f ? 1.0f : std::sin(Pi * distance) / (Pi * distance);
+            return sinc * BesselI0(KaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / BesselI0(KaiserAlpha);
+        }
+
+        FilterTaps BuildFilterTaps(uint32_t sourceSize, uint32_t destinationSize, TextureMipFilter filter)
+        {
+            FilterTaps result;
+            result.TapOffsets.reserve(destinationSize + 1);
+            const float scale = static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+
+            for (uint32_t destinationIndex = 0; destinationIndex < destinationSize; ++destinationIndex)
+            {
+                result.TapOffsets.push_back(static_cast<uint32_t>(result.Taps.size()));
+                const size_t firstTap = result.Taps.size();
+                float weightSum = 0.0f;
+
+                if (filter == TextureMipFilter::Box)
+                {
+                    // 按覆盖面积加权；奇数尺寸时边界像素按比例分摊，而不是直接丢弃。
+                    const float begin = static_cast<float>(destinationIndex) * scale;
+                    const float end = begin + scale;
+                    const uint32_t firstSource = static_cast<uint32_t>(std::floor(begin));
+                    const uint32_t lastSource =
+                            std::min(sourceSize - 1, static_cast<uint32_t>(std::ceil(end)) - 1u);
+                    for (uint32_t sourceIndex = firstSource; sourceIndex <= lastSource; ++sourceIndex)
+                    {
+                        const float overlap = std::min(end, static_cast<float>(sourceIndex + 1))
+                                              - std::max(begin, static_cast<float>(sourceIndex));
+                        if (overlap <= 0.0f)
+                            continue;
+                        result.Taps.push_back({sourceIndex, overlap});
+                        weightSum += overlap;
+                    }
+                }
+                else
+                {
+                    const float center = (static_cast<float>(destinationIndex) + 0.5f) * scale;
+                    const float radius = KaiserHalfWidth * scale;
+                    const int firstSource = static_cast<int>(std::floor(center - radius));
+                    const int lastSource = static_cast<int>(std::ceil(center + radius));
+                    for (int sourceIndex = firstSource; sourceIndex <= lastSource; ++sourceIndex)
+                    {
+                        const float distance =
+                                std::abs((static_cast<float>(sourceIndex) + 0.5f - center) / scale);
+                        const float weight = KaiserSincWeight(distance);
+                        if (weight == 0.0f)
+                            continue;
+                        // 边缘钳制到最近像素。
+                        const uint32_t clampedIndex = static_cast<uint32_t>(
+                                std::clamp(sourceIndex, 0, static_cast<int>(sourceSize) - 1));
+                        result.Taps.push_back({clampedIndex, weight});
+                        weightSum += weight;
+                    }
+                }
+
+                if (weightSum > 0.0f)
+                {
+                    for (size_t tapIndex = firstTap; tapIndex < result.Taps.size(); ++tapIndex)
+                        result.Taps[tapIndex].Weight /= weightSum;
+                }
+            }
+            result.TapOffsets.push_back(static_cast<uint32_t>(result.Taps.size()));
+            return result;
+        }
+
+        /// 加权累加 RGBA 浮点像素（4 个分量恰好一个 SSE 寄存器）。
+        inline void AccumulateWeightedPixels(const float *const *pixelPointers, const FilterTap *taps,
+                                             uint32_t tapCount, float *destination)
+        {
+#if HIMII_MIP_GENERATOR_SSE2
+            __m128 accumulator = _mm_setzero_ps();
+            for (uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex)
+                accumulator = _mm_add_ps(accumulator,
+                                         _mm_mul_ps(_mm_loadu_ps(pixelPointers[tapIndex]),
+                                                    _mm_set1_ps(taps[tapIndex].Weight)));
+            _mm_storeu_ps(destination, accumulator);
+#else
+            float accumulator[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex)
+            {
+                const float weight = taps[tapIndex].Weight;
+                const float *pixel = pixelPointers[tapIndex];
+                accumulator[0] += pixel[0] * weight;
+                accumulator[1] += pixel[1] * weight;
+                accumulator[2] += pixel[2] * weight;
+                accumulator[3] += pixel[3] * weight;
+            }
+            destination[0] = accumulator[0];
+            destination[1] = accumulator[1];
+            destination[2] = accumulator[2];
+            destination[3] = accumulator[3];
+#endif
+        }
+
+        template <typename RowFunction>
+        void ForEachRow(uint32_t rowCount, uint32_t pixelCount, const RowFunction &rowFunction)
+        {
+            if (pixelCount < ParallelPixelThreshold)
+            {
+                for (uint32_t row = 0; row < rowCount; ++row)
+                    rowFunction(row);
+                return;
+            }
+
+            JobSystem::ParallelFor(rowCount, ParallelRowBatch,
+                                   [&](uint32_t beginRow, uint32_t endRow)
+                                   {
+                                       for (uint32_t row = beginRow; row < endRow; ++row)
+                                           rowFunction(row);
+                                   });
+        }
+
+        void DecodeToLinear(const uint8_t *pixels, uint32_t width, uint32_t height,
+                            const TextureLoadSettings &settings, std::vector<float> &outLinear)
+        {
+            const std::array<float, 256> &srgbToLinear = GetSrgbToLinearTable();
+            outLinear.resize(static_cast<size_t>(width) * height * 4u);
+            ForEachRow(height, width * height,
+                       [&](uint32_t row)
+                       {
+                           const uint8_t *source = pixels + static_cast<size_t>(row) * width * 4u;
+                           float *destination = outLinear.data() + static_cast<size_t>(row) * width * 4u;
+                           for (uint32_t column = 0; column < width; ++column, source += 4, destination += 4)
+                           {
+                               const float alpha = static_cast<float>(source[3]) / 255.0f;
+                               const float colorScale = settings.AlphaWeightedMipFiltering ? alpha : 1.0f;
+                               for (uint32_t channel = 0; channel < 3; ++channel)
+                               {
+                                   const float value = settings.SRGB
+                                                               ? srgbToLinear[source[channel]]
+                                                               : static_cast<float>(source[channel]) / 255.0f;
+                                   destination[channel] = value * colorScale;
+                               }
+                               destination[3] = alpha;
+                           }
+                       });
+        }
+
+        void EncodeFromLinear(const std::vector<float> &linear, uint32_t width, uint32_t height,
+                              const TextureLoadSettings &settings, uint8_t *outPixels)
+        {
+            const std::vector<uint8_t> &linearToSrgb = GetLinearToSrgbTable();
+            ForEachRow(height, width * height,
+                       [&](uint32_t row)
+                       {
+                           const float *source = linear.data() + static_cast<size_t>(row) * width * 4u;
+                           uint8_t *destination = outPixels + static_cast<size_t>(row) * width * 4u;
+                           for (uint32_t column = 0; column < width; ++column, source += 4, destination += 4)
+                           {
+                               const float alpha = std::clamp(source[3], 0.0f, 1.0f);
+                               float colorScale = 1.0f;
+                               if (settings.AlphaWeightedMipFiltering)
+                                   colorScale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+
+                               for (uint32_t channel = 0; channel < 3; ++channel)
+                               {
+                                   const float value = std::clamp(source[channel] * colorScale, 0.0f, 1.0f);
+                                   destination[channel] =
+                                           settings.SRGB
+                                                   ? linearToSrgb[static_cast<uint32_t>(
+                                                             value * static_cast<float>(LinearToSrgbTableSize - 1)
+                                                             + 0.5f)]
+                                                   : static_cast<uint8_t>(value * 255.0f + 0.5f);
+                               }
+                               destination[3] = static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+                           }
+                       });
+        }
+
+        /// 线性浮点层的可分离下采样：先水平到临时缓冲，再垂直到目标。
+        void DownsampleLinear(const std::vector<float> &source, uint32_t sourceWidth, uint32_t sourceHeight,
+                              TextureMipFilter filter, std::vector<float> &scratch, std::vector<float> &destination,
+                              uint32_t &outWidth, uint32_t &outHeight)
+        {
+            outWidth = std::max(1u, sourceWidth / 2u);
+            outHeight = std::max(1u, sourceHeight / 2u);
+
+            const FilterTaps horizontalTaps = BuildFilterTaps(sourceWidth, outWidth, filter);
+            const FilterTaps verticalTaps = BuildFilterTaps(sourceHeight, outHeight, filter);
+
+            scratch.resize(static_cast<size_t>(outWidth) * sourceHeight * 4u);
+            ForEachRow(sourceHeight, outWidth * sourceHeight,
+                       [&](uint32_t row)
+                       {
+                           const float *sourceRow = source.data() + static_cast<size_t>(row) * sourceWidth * 4u;
+                           float *scratchRow = scratch.data() + static_cast<size_t>(row) * outWidth * 4u;
+                           const float *pixelPointers[64];
+                           for (uint32_t column = 0; column < outWidth; ++column)
+                           {
+                               const uint32_t tapBegin = horizontalTaps.TapOffsets[column];
+                               const uint32_t tapCount =
+                                       std::min(64u, horizontalTaps.TapOffsets[column + 1] - tapBegin);
+                               const FilterTap *taps = horizontalTaps.Taps.data() + tapBegin;
+                               for (uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex)
+                                   pixelPointers[tapIndex] = sourceRow + taps[tapIndex].SourceIndex * 4u;
+                               AccumulateWeightedPixels(pixelPointers, taps, tapCount, scratchRow + column * 4u);
+                           }
+                       });
+
+            destination.resize(static_cast<size_t>(outWidth) * outHeight * 4u);
+            ForEachRow(outHeight, outWidth * outHeight,
+                       [&](uint32_t row)
+                       {
+                           const uint32_t tapBegin = verticalTaps.TapOffsets[row];
+                           const uint32_t tapCount = std::min(64u, verticalTaps.TapOffsets[row + 1] - tapBegin);
+                           const FilterTap *taps = verticalTaps.Taps.data() + tapBegin;
+                           float *destinationRow = destination.data() + static_cast<size_t>(row) * outWidth * 4u;
+                           const float *pixelPointers[64];
+                           for (uint32_t column = 0; column < outWidth; ++column)
+                           {
+                               for (uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex)
+                                   pixelPointers[tapIndex] =
+                                           scratch.data()
+                                           + (static_cast<size_t>(taps[tapIndex].SourceIndex) * outWidth + column) * 4u;
+                               AccumulateWeightedPixels(pixelPointers, taps, tapCount, destinationRow + column * 4u);
+                           }
+                       });
+        }
+    }
+
+    uint32_t CalculateTextureMipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t largestDimension = std::max(width, height);
+        uint32_t levelCount = 1;
+        while (largestDimension > 1)
+        {
+            largestDimension /= 2u;
+            ++levelCount;
+        }
+        return levelCount;
+    }
+
+    void DownsampleRgba8MipLevel(const uint8_t *sourcePixels, uint32_t sourceWidth, uint32_t sourceHeight,
+                                 const TextureLoadSettings &settings, uint8_t *destinationPixels)
+    {
+        if (!sourcePixels || !destinationPixels || sourceWidth == 0 || sourceHeight == 0)
+            return;
+
+        std::vector<float> linearSource;
+        std::vector<float> scratch;
+        std::vector<float> linearDestination;
+        uint32_t destinationWidth = 0;
+        uint32_t destinationHeight = 0;
+        DecodeToLinear(sourcePixels, sourceWidth, sourceHeight, settings, linearSource);
+        DownsampleLinear(linearSource, sourceWidth, sourceHeight, settings.MipFilter, scratch, linearDestination,
+                         destinationWidth, destinationHeight);
+        EncodeFromLinear(linearDestination, destinationWidth, destinationHeight, settings, destinationPixels);
+    }
+
+    void GenerateRgba8MipChain(const uint8_t *basePixels, uint32_t width, uint32_t height,
+                               const TextureLoadSettings &settings, std::vector<TextureMipLevel> &outLevels)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        outLevels.clear();
+        if (!basePixels || width == 0 || height == 0)
+            return;
+
+        const uint32_t levelCount = CalculateTextureMipLevelCount(width, height);
+        if (levelCount <= 1)
+            return;
+        outLevels.reserve(levelCount - 1);
+
+        std::vector<float> currentLevel;
+        std::vector<float> nextLevel;
+        std::vector<float> scratch;
+        DecodeToLinear(basePixels, width, height, settings, currentLevel);
+
+        uint32_t currentWidth = width;
+        uint32_t currentHeight = height;
+        for (uint32_t levelIndex = 1; levelIndex < levelCount; ++levelIndex)
+        {
+            uint32_t nextWidth = 0;
+            uint32_t nextHeight = 0;
+            DownsampleLinear(currentLevel, currentWidth, currentHeight, settings.MipFilter, scratch, nextLevel,
+                             nextWidth, nextHeight);
+
+            TextureMipLevel &level = outLevels.emplace_back();
+            level.Width = nextWidth;
+            level.Height = nextHeight;
+            level.Pixels.resize(static_cast<size_t>(nextWidth) * nextHeight * 4u);
+            EncodeFromLinear(nextLevel, nextWidth, nextHeight, settings, level.Pixels.data());
+
+            currentLevel.swap(nextLevel);
+            currentWidth = nextWidth;
+            currentHeight = nextHeight;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Module/Render/RenderCore/Texture.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Himii
+{
+    struct TextureMipLevel
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        std::vector<uint8_t> Pixels; // RGBA8，紧密打包
+    };
+
+    /// 完整 mip 链层数（含第 0 层），按较大边计算。
+    uint32_t CalculateTextureMipLevelCount(uint32_t width, uint32_t height);
+
+    /// 由上一层 RGBA8 生成下一层，目标尺寸为 max(1, n / 2)。
+    /// 单层接口，便于与参考实现逐像素对比；整链请用 GenerateRgba8MipChain。
+    void DownsampleRgba8MipLevel(const uint8_t *sourcePixels, uint32_t sourceWidth, uint32_t sourceHeight,
+                                 const TextureLoadSettings &settings, uint8_t *destinationPixels);
+
+    /// 生成第 1 层起的整条 mip 链，outLevels[i] 对应 mip i + 1。
+    /// 中间结果保持线性浮点精度，逐层下采样时不重复量化；大图按行分发到 JobSystem。
+    void GenerateRgba8MipChain(const uint8_t *basePixels, uint32_t width, uint32_t height,
+                               const TextureLoadSettings &settings, std::vector<TextureMipLevel> &outLevels);
+}
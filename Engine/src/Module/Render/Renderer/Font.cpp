@@ -2,6 +2,8 @@
 #include "Module/Render/Renderer/Font.h"
 #include "EngineCore/Core/FileSystem.h"
 #include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/Renderer/FontGlyphCache.h"
 #include "Module/Render/Renderer/TextLayout.h"
 
 #include "freetype/freetype.h"
@@ -11,6 +13,7 @@
 #include "msdfgen/msdfgen-ext.h"
 #include "msdfgen/core/pixel-conversion.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <unordered_map>
 
@@ -24,96 +27,111 @@ namespace Himii
         constexpr unsigned long long LinearCongruentialMultiplier = 6364136223846793005ull;
         constexpr int AtlasPaddingPixels = 1;
 
-        msdfgen::FontHandle *CreateFontHandleWithFaceIndex(
-                msdfgen::FreetypeHandle *freeTypeHandle, const std::filesystem::path &path,
-                int faceIndex)
+        /// 全进程递增，字体对象地址被复用时代数也不会重复。
+        std::atomic<uint64_t> s_GlyphGenerationCounter{0};
+    }
+
+    /// FT_Face 不能跨线程并发使用：每个正在生成字形的线程借出一份独立的 FreeType 实例，用完归还。
+    /// 空闲实例数不超过曾经同时生成的线程数，随 Font 析构一并释放，不依赖工作线程之后是否再取字体面。
+    class FontFacePool
+    {
+    public:
+        FontFacePool(std::filesystem::path path, int faceIndex) : m_Path(std::move(path)), m_FaceIndex(faceIndex)
         {
-            if (!freeTypeHandle)
-                return nullptr;
+        }
 
-            // msdfgen::loadFont 固定 face 0；TTC 通过 FreeType + adopt 支持 FaceIndex。
-            FT_Library library = nullptr;
+        ~FontFacePool()
+        {
+            for (PooledFace &face : m_IdleFaces)
             {
-                // 通过临时加载获取底层 FT_Library 不可行（封装私有），直接使用本进程 FreeType。
+                FT_Done_Face(face.Face);
+                FT_Done_FreeType(face.Library);
             }
-            (void)freeTypeHandle;
-
-            FT_Library ownedLibrary = nullptr;
-            if (FT_Init_FreeType(&ownedLibrary) != 0)
-                return nullptr;
+        }
 
-            FT_Face face = nullptr;
-            const std::string pathString = path.string();
-            if (FT_New_Face(ownedLibrary, pathString.c_str(), faceIndex, &face) != 0)
-            {
-                FT_Done_FreeType(ownedLibrary);
-                return nullptr;
-            }
+        FontFacePool(const FontFacePool &) = delete;
+        FontFacePool &operator=(const FontFacePool &) = delete;
 
-            // adopt 后 ownership=false，需自行销毁 Face/Library。
-            // 为简化生命周期，改用 msdfgen loadFont 路径：faceIndex==0 时；
-            // faceIndex!=0 时仍 adopt，并在调用方负责 Done。
-            // 这里将 library 挂到 thread_local 缓存，避免过早释放。
-            struct AdoptedFaceOwner
+        bool Checkout(FT_Library &outLibrary, FT_Face &outFace)
+        {
             {
-                FT_Library Library = nullptr;
-                FT_Face Face = nullptr;
-                ~AdoptedFaceOwner()
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if (!m_IdleFaces.empty())
                 {
-                    if (Face)
-                        FT_Done_Face(Face);
-                    if (Library)
-                        FT_Done_FreeType(Library);
+                    outLibrary = m_IdleFaces.back().Library;
+                    outFace = m_IdleFaces.back().Face;
+                    m_IdleFaces.pop_back();
+                    return true;
                 }
-            };
+            }
 
-            // 不能把局部 owner 交给外部。改为：faceIndex==0 用 loadFont；
-            // 非 0 则复制为临时策略——使用 FT_New_Face + adopt，并把 library/face
-            // 存入静态 map（按 path+face）在进程内常驻。
-            struct FaceCacheKey
+            // 打开字体文件不持锁，其它线程仍可归还或借出已有实例。
+            if (FT_Init_FreeType(&outLibrary) != 0)
+                return false;
+            if (FT_New_Face(outLibrary, m_Path.string().c_str(), m_FaceIndex, &outFace) != 0)
             {
-                std::string Path;
-                int FaceIndex = 0;
-                bool operator==(const FaceCacheKey &other) const
-                {
-                    return Path == other.Path && FaceIndex == other.FaceIndex;
-                }
-            };
-            struct FaceCacheKeyHash
+                FT_Done_FreeType(outLibrary);
+                outLibrary = nullptr;
+                outFace = nullptr;
+                return false;
+            }
+            return true;
+        }
+
+        void Return(FT_Library library, FT_Face face)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IdleFaces.push_back({library, face});
+        }
+
+    private:
+        struct PooledFace
+        {
+            FT_Library Library = nullptr;
+            FT_Face Face = nullptr;
+        };
+
+        std::filesystem::path m_Path;
+        int m_FaceIndex = 0;
+        std::mutex m_Mutex;
+        std::vector<PooledFace> m_IdleFaces;
+    };
+
+    namespace
+    {
+        /// msdfgen::loadFont 固定 face 0；TTC 通过 FreeType + adopt 支持 FaceIndex。
+        /// 从池中借出一份字体面并包成 msdfgen 句柄；析构时销毁句柄（句柄不拥有 Face）并归还字体面。
+        class ScopedFontHandle
+        {
+        public:
+            explicit ScopedFontHandle(FontFacePool &pool) : m_Pool(pool)
             {
-                size_t operator()(const FaceCacheKey &key) const
-                {
-                    return std::hash<std::string>()(key.Path)
-                           ^ (static_cast<size_t>(key.FaceIndex) << 1);
-                }
-            };
-            struct CachedFace
+                if (m_Pool.Checkout(m_Library, m_Face))
+                    m_Handle = msdfgen::adoptFreetypeFont(m_Face);
+            }
+
+            ~ScopedFontHandle()
             {
-                FT_Library Library = nullptr;
-                FT_Face Face = nullptr;
-            };
+                if (m_Handle)
+                    msdfgen::destroyFont(m_Handle);
+                if (m_Face)
+                    m_Pool.Return(m_Library, m_Face);
+            }
 
-            static std::mutex cacheMutex;
-            static std::unordered_map<FaceCacheKey, CachedFace, FaceCacheKeyHash> faceCache;
+            ScopedFontHandle(const ScopedFontHandle &) = delete;
+            ScopedFontHandle &operator=(const ScopedFontHandle &) = delete;
 
-            FaceCacheKey key{pathString, faceIndex};
+            msdfgen::FontHandle *Get() const
             {
-                std::lock_guard<std::mutex> lock(cacheMutex);
-                auto found = faceCache.find(key);
-                if (found != faceCache.end())
-                {
-                    FT_Done_Face(face);
-                    FT_Done_FreeType(ownedLibrary);
-                    return msdfgen::adoptFreetypeFont(found->second.Face);
-                }
-
-                CachedFace cached;
-                cached.Library = ownedLibrary;
-                cached.Face = face;
-                faceCache.emplace(key, cached);
-                return msdfgen::adoptFreetypeFont(face);
+                return m_Handle;
             }
-        }
+
+        private:
+            FontFacePool &m_Pool;
+            FT_Library m_Library = nullptr;
+            FT_Face m_Face = nullptr;
+            msdfgen::FontHandle *m_Handle = nullptr;
+        };
     }
 
     void Font::InitDefault(const std::filesystem::path &path, int faceIndex)
@@ -154,8 +172,13 @@ namespace Himii
     Font::Font(const std::filesystem::path &filepath)
     {
         m_Specification.FilePath = filepath;
+        m_ResolvedFilePath = FileSystem::MaterializeLooseFile(m_Specification.FilePath.string());
+        m_FacePool = CreateScope<FontFacePool>(m_ResolvedFilePath, m_Specification.FaceIndex);
+        AdvanceGlyphGeneration();
         InitializeMetrics();
-        CreateNewAtlasPage();
+        LoadPersistentGlyphCache();
+        if (m_AtlasPages.empty())
+            CreateNewAtlasPage();
         EnsureInitialAsciiGlyphs();
     }
 
@@ -165,13 +188,55 @@ namespace Himii
             m_Specification.AtlasPageSize = 64;
         if (m_Specification.MaximumAtlasPageCount == 0)
             m_Specification.MaximumAtlasPageCount = 1;
+        m_ResolvedFilePath = FileSystem::MaterializeLooseFile(m_Specification.FilePath.string());
+        m_FacePool = CreateScope<FontFacePool>(m_ResolvedFilePath, m_Specification.FaceIndex);
+        AdvanceGlyphGeneration();
         InitializeMetrics();
-        CreateNewAtlasPage();
+        LoadPersistentGlyphCache();
+        if (m_AtlasPages.empty())
+            CreateNewAtlasPage();
         EnsureInitialAsciiGlyphs();
     }
 
+    Font::Font(const FontSpecification &specification, HeadlessConstruction) : m_Specification(specification)
+    {
+        // 命令行给出的通常是磁盘绝对路径，不经引擎内容根目录解析。
+        m_ResolvedFilePath = m_Specification.FilePath.is_absolute()
+                                     ? m_Specification.FilePath
+                                     : FileSystem::MaterializeLooseFile(m_Specification.FilePath.string());
+        m_FacePool = CreateScope<FontFacePool>(m_ResolvedFilePath, m_Specification.FaceIndex);
+        InitializeMetrics();
+    }
+
     Font::~Font() = default;
 
+    Ref<Font> Font::CreateHeadless(const FontSpecification &specification)
+    {
+        Ref<Font> font(new Font(specification, HeadlessConstruction{}));
+        if (!font->m_LastError.empty())
+        {
+            HIMII_CORE_ERROR("Font {0}: {1}", specification.FilePath.string(), font->m_LastError);
+            return nullptr;
+        }
+        return font;
+    }
+
+    bool Font::GenerateGlyphRecord(char32_t codePoint, FontGlyphCacheRecord &outRecord,
+                                   std::vector<uint8_t> &outPixels) const
+    {
+        GeneratedGlyphPayload payload = GenerateGlyph(codePoint);
+        outPixels.swap(payload.BitmapPixels);
+        outRecord = MakeCacheRecord(payload);
+        outRecord.BitmapPixels = outPixels.empty() ? nullptr : outPixels.data();
+        return payload.Persistable;
+    }
+
+    void Font::AdvanceGlyphGeneration()
+    {
+        m_GlyphGeneration.store(s_GlyphGenerationCounter.fetch_add(1, std::memory_order_relaxed) + 1,
+                                std::memory_order_release);
+    }
+
     Ref<Texture2D> Font::GetAtlasTexture() const
     {
         return m_AtlasPageTextures.empty() ? nullptr : m_AtlasPageTextures.front();
@@ -179,21 +244,11 @@ namespace Himii
 
     void Font::InitializeMetrics()
     {
-        msdfgen::FreetypeHandle *freeTypeHandle = msdfgen::initializeFreetype();
-        if (!freeTypeHandle)
-        {
-            m_LastError = "Failed to initialize FreeType";
-            return;
-        }
-
-        const std::filesystem::path resolvedPath =
-                FileSystem::MaterializeLooseFile(m_Specification.FilePath.string());
-        msdfgen::FontHandle *fontHandle =
-                CreateFontHandleWithFaceIndex(freeTypeHandle, resolvedPath, m_Specification.FaceIndex);
+        ScopedFontHandle scopedFontHandle(*m_FacePool);
+        msdfgen::FontHandle *fontHandle = scopedFontHandle.Get();
         if (!fontHandle)
         {
             m_LastError = "Failed to load font face";
-            msdfgen::deinitializeFreetype(freeTypeHandle);
             return;
         }
 
@@ -201,8 +256,6 @@ namespace Himii
         if (!msdfgen::getFontMetrics(metrics, fontHandle, msdfgen::FONT_SCALING_NONE))
         {
             m_LastError = "Failed to read font metrics";
-            msdfgen::destroyFont(fontHandle);
-            msdfgen::deinitializeFreetype(freeTypeHandle);
             return;
         }
 
@@ -212,9 +265,6 @@ namespace Himii
         m_Metrics.AscenderY = static_cast<float>(metrics.ascenderY * m_GeometryScale);
         m_Metrics.DescenderY = static_cast<float>(metrics.descenderY * m_GeometryScale);
         m_Metrics.LineHeight = static_cast<float>(metrics.lineHeight * m_GeometryScale);
-
-        msdfgen::destroyFont(fontHandle);
-        msdfgen::deinitializeFreetype(freeTypeHandle);
     }
 
     void Font::CreateNewAtlasPage()
@@ -228,19 +278,152 @@ namespace Himii
 
         AtlasPage page;
         page.Texture = Texture2D::Create(textureSpecification);
-        // 清成中性距离 0.5（byte 128），避免未写入区域被当成字形内部。
-        const size_t pixelCount = static_cast<size_t>(m_Specification.AtlasPageSize)
-                                  * static_cast<size_t>(m_Specification.AtlasPageSize);
-        std::vector<uint8_t> clearPixels(pixelCount * 3u, 128);
-        page.Texture->SetData(clearPixels.data(), static_cast<uint32_t>(clearPixels.size()));
-        page.CursorX = AtlasPaddingPixels;
-        page.CursorY = AtlasPaddingPixels;
-        page.CurrentRowHeight = 0;
+        if (!m_LoadingPersistentCache)
+        {
+            // 清成中性距离 0.5（byte 128），避免未写入区域被当成字形内部。
+            const size_t pixelCount = static_cast<size_t>(m_Specification.AtlasPageSize)
+                                      * static_cast<size_t>(m_Specification.AtlasPageSize);
+            std::vector<uint8_t> clearPixels(pixelCount * 3u, 128);
+            page.Texture->SetData(clearPixels.data(), static_cast<uint32_t>(clearPixels.size()));
+        }
+        const int pageSize = static_cast<int>(m_Specification.AtlasPageSize);
+        page.Skyline.push_back({AtlasPaddingPixels, AtlasPaddingPixels, pageSize - AtlasPaddingPixels});
 
         m_AtlasPages.push_back(page);
         m_AtlasPageTextures.push_back(page.Texture);
     }
 
+    void Font::LoadPersistentGlyphCache()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        FontGlyphCacheKey key;
+        key.FontFilePath = m_ResolvedFilePath;
+        key.FaceIndex = m_Specification.FaceIndex;
+        key.GenerationScale = m_Specification.GenerationScale;
+        key.PixelRange = m_Specification.PixelRange;
+        key.MiterLimit = m_Specification.MiterLimit;
+        m_GlyphCache = FontGlyphCache::Acquire(key);
+        if (!m_GlyphCache)
+            return;
+
+        std::vector<uint8_t> fileData;
+        std::vector<FontGlyphCacheRecord> records;
+        if (!m_GlyphCache->Load(fileData, records) || records.empty())
+            return;
+
+        // 与运行时批量装箱一致，先高后矮地放入天际线。
+        std::stable_sort(records.begin(), records.end(),
+                         [](const FontGlyphCacheRecord &left, const FontGlyphCacheRecord &right)
+                         { return left.BitmapHeight > right.BitmapHeight; });
+
+        // 缓存字形先拼进 CPU 端整页，每页只上传一次，而不是逐字形 SetDataRegion。
+        const size_t pageSize = m_Specification.AtlasPageSize;
+        std::vector<std::vector<uint8_t>> stagedPages;
+        uint32_t loadedGlyphCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_GlyphMutex);
+            m_LoadingPersistentCache = true;
+            for (const FontGlyphCacheRecord &record : records)
+            {
+                if (m_CachedGlyphs.find(record.CodePoint) != m_CachedGlyphs.end())
+                    continue;
+
+                CachedGlyph glyph;
+                glyph.Advance = record.Advance;
+                if (record.IsMissing)
+                {
+                    m_UnavailableCodePoints.insert(record.CodePoint);
+                    glyph.IsMissing = true;
+                    glyph.Advance = m_Metrics.EmSize * 0.5f;
+                }
+                else if (record.IsWhitespace || !record.BitmapPixels)
+                {
+                    glyph.IsWhitespace = true;
+                    glyph.Advance = record.Advance > 0.0f ? record.Advance : m_Metrics.EmSize * 0.25f;
+                }
+                else
+                {
+                    uint32_t pageIndex = 0;
+                    int pixelX = 0;
+                    int pixelY = 0;
+                    if (!AllocateAtlasRectangle(record.BitmapWidth, record.BitmapHeight, pageIndex, pixelX, pixelY))
+                    {
+                        MarkCapacityExceeded(record.CodePoint);
+                        glyph.IsMissing = true;
+                        m_CachedGlyphs[record.CodePoint] = glyph;
+                        continue;
+                    }
+
+                    if (stagedPages.size() <= pageIndex)
+                        stagedPages.resize(pageIndex + 1);
+                    std::vector<uint8_t> &stagedPage = stagedPages[pageIndex];
+                    if (stagedPage.empty())
+                        stagedPage.assign(pageSize * pageSize * 3u, 128);
+
+                    const size_t rowBytes = static_cast<size_t>(record.BitmapWidth) * 3u;
+                    for (int row = 0; row < record.BitmapHeight; ++row)
+                    {
+                        const size_t destinationIndex =
+                                ((static_cast<size_t>(pixelY + row) * pageSize) + static_cast<size_t>(pixelX)) * 3u;
+                        std::memcpy(stagedPage.data() + destinationIndex,
+                                    record.BitmapPixels + static_cast<size_t>(row) * rowBytes, rowBytes);
+                    }
+
+                    glyph.PageIndex = pageIndex;
+                    glyph.PixelX = pixelX;
+                    glyph.PixelY = pixelY;
+                    glyph.PixelWidth = record.BitmapWidth;
+                    glyph.PixelHeight = record.BitmapHeight;
+                    glyph.PlaneMinimum = record.PlaneMinimum;
+                    glyph.PlaneMaximum = record.PlaneMaximum;
+                }
+                m_CachedGlyphs[record.CodePoint] = glyph;
+                ++loadedGlyphCount;
+            }
+            m_LoadingPersistentCache = false;
+            AdvanceGlyphGeneration();
+        }
+
+        // 载入期间新建的页都至少放了一个字形，因此每页都有暂存数据。
+        for (size_t pageIndex = 0; pageIndex < stagedPages.size(); ++pageIndex)
+        {
+            const std::vector<uint8_t> &stagedPage = stagedPages[pageIndex];
+            if (!stagedPage.empty())
+                m_AtlasPages[pageIndex].Texture->SetData(const_cast<uint8_t *>(stagedPage.data()),
+                                                         static_cast<uint32_t>(stagedPage.size()));
+        }
+
+        m_PersistentCacheLoadedGlyphCount = loadedGlyphCount;
+        m_PersistentCacheLoadMilliseconds = timer.ElapsedMillis();
+        HIMII_CORE_INFO("Loaded {0} cached glyph(s) for font '{1}' in {2:.2f} ms", loadedGlyphCount,
+                        m_Specification.FilePath.string(), m_PersistentCacheLoadMilliseconds);
+    }
+
+    void Font::PersistGeneratedGlyph(const GeneratedGlyphPayload &payload)
+    {
+        if (!m_GlyphCache || !payload.Persistable)
+            return;
+
+        m_GlyphCache->Append(MakeCacheRecord(payload));
+    }
+
+    FontGlyphCacheRecord Font::MakeCacheRecord(const GeneratedGlyphPayload &payload)
+    {
+        FontGlyphCacheRecord record;
+        record.CodePoint = payload.CodePoint;
+        record.IsWhitespace = payload.IsWhitespace;
+        record.IsMissing = payload.IsMissing;
+        record.Advance = payload.Advance;
+        record.PlaneMinimum = payload.PlaneMinimum;
+        record.PlaneMaximum = payload.PlaneMaximum;
+        record.BitmapWidth = payload.BitmapWidth;
+        record.BitmapHeight = payload.BitmapHeight;
+        record.BitmapPixels = payload.BitmapPixels.empty() ? nullptr : payload.BitmapPixels.data();
+        return record;
+    }
+
     void Font::EnsureInitialAsciiGlyphs()
     {
         std::string asciiText;
@@ -290,13 +473,12 @@ namespace Himii
     {
         auto sharedPromise = CreateRef<std::promise<void>>();
         std::future<void> future = sharedPromise->get_future();
-        // 调用方须保证 Font 在 future 完成前仍然存活。
-        Font *fontPointer = this;
-        const std::string textCopy = text;
 
+        // 只为尚未缓存、也不在生成中的码点派发任务，重复字符只生成一次。
+        auto codePoints = CreateRef<std::vector<char32_t>>();
         {
             std::lock_guard<std::mutex> lock(m_GlyphMutex);
-            for (char32_t codePoint : TextShaper::DecodeUtf8(textCopy))
+            for (char32_t codePoint : TextShaper::DecodeUtf8(text))
             {
                 if (codePoint == U'\n' || codePoint == U'\r')
                     continue;
@@ -305,28 +487,55 @@ namespace Himii
                     || m_PendingCodePoints.find(codePoint) != m_PendingCodePoints.end())
                     continue;
                 m_PendingCodePoints.insert(codePoint);
+                codePoints->push_back(codePoint);
             }
         }
 
-        JobSystem::Submit(
-                [fontPointer, textCopy]()
-                {
-                    for (char32_t codePoint : TextShaper::DecodeUtf8(textCopy))
+        if (codePoints->empty())
+        {
+            sharedPromise->set_value();
+            return future;
+        }
+
+        // 调用方须保证 Font 在 future 完成前仍然存活。
+        Font *fontPointer = this;
+        const uint32_t codePointCount = static_cast<uint32_t>(codePoints->size());
+        const uint32_t batchCount = (codePointCount + GlyphGenerationBatchSize - 1) / GlyphGenerationBatchSize;
+        auto remainingBatches = CreateRef<std::atomic<uint32_t>>(batchCount);
+        auto preloadTimer = CreateRef<Timer>();
+
+        // 光栅化按小批次分散到各 worker；装箱与上传留在主线程，由完成回调批量处理。
+        for (uint32_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+        {
+            const uint32_t beginIndex = batchIndex * GlyphGenerationBatchSize;
+            const uint32_t endIndex = std::min(beginIndex + GlyphGenerationBatchSize, codePointCount);
+            JobSystem::Submit(
+                    [fontPointer, codePoints, beginIndex, endIndex]()
                     {
-                        if (codePoint == U'\n' || codePoint == U'\r')
-                            continue;
-                        GeneratedGlyphPayload payload = fontPointer->GenerateGlyphOnWorker(codePoint);
-                        {
-                            std::lock_guard<std::mutex> lock(fontPointer->m_CompletionMutex);
+                        std::vector<GeneratedGlyphPayload> payloads;
+                        payloads.reserve(endIndex - beginIndex);
+                        for (uint32_t index = beginIndex; index < endIndex; ++index)
+                            payloads.push_back(fontPointer->GenerateGlyphOnWorker((*codePoints)[index]));
+
+                        std::lock_guard<std::mutex> lock(fontPointer->m_CompletionMutex);
+                        for (GeneratedGlyphPayload &payload : payloads)
                             fontPointer->m_CompletedGenerations.push_back(std::move(payload));
+                    },
+                    [fontPointer, sharedPromise, remainingBatches, preloadTimer, codePointCount]()
+                    {
+                        // 同一帧内完成的批次由第一个回调一起装箱，后续回调取到空列表。
+                        fontPointer->ProcessCompletedGenerations();
+                        if (remainingBatches->fetch_sub(1) != 1)
+                            return;
+
+                        {
+                            std::lock_guard<std::mutex> lock(fontPointer->m_GlyphMutex);
+                            fontPointer->m_LastPreloadGlyphCount = codePointCount;
+                            fontPointer->m_LastPreloadMilliseconds = preloadTimer->ElapsedMillis();
                         }
-                    }
-                },
-                [fontPointer, sharedPromise]()
-                {
-                    fontPointer->ProcessCompletedGenerations();
-                    sharedPromise->set_value();
-                });
+                        sharedPromise->set_value();
+                    });
+        }
 
         return future;
     }
@@ -346,10 +555,22 @@ namespace Himii
 
         // 同步生成并上传，保证本帧 EnsureGlyphsForText 后立即可绘。
         GeneratedGlyphPayload payload = GenerateGlyphOnWorker(codePoint);
-        return UploadGeneratedGlyph(payload);
+        const bool uploaded = UploadGeneratedGlyph(payload);
+        PersistGeneratedGlyph(payload);
+        return uploaded;
     }
 
     Font::GeneratedGlyphPayload Font::GenerateGlyphOnWorker(char32_t codePoint) const
+    {
+        Timer timer;
+        GeneratedGlyphPayload payload = GenerateGlyph(codePoint);
+        m_GenerationMicroseconds.fetch_add(static_cast<uint64_t>(timer.Elapsed() * 1000000.0f),
+                                           std::memory_order_relaxed);
+        m_GeneratedGlyphCount.fetch_add(1, std::memory_order_relaxed);
+        return payload;
+    }
+
+    Font::GeneratedGlyphPayload Font::GenerateGlyph(char32_t codePoint) const
     {
         GeneratedGlyphPayload payload;
         payload.CodePoint = codePoint;
@@ -361,23 +582,12 @@ namespace Himii
             // 用空格真实 advance 覆盖。
         }
 
-        msdfgen::FreetypeHandle *freeTypeHandle = msdfgen::initializeFreetype();
-        if (!freeTypeHandle)
-        {
-            payload.IsMissing = true;
-            payload.ErrorMessage = "FreeType init failed";
-            return payload;
-        }
-
-        const std::filesystem::path resolvedPath =
-                FileSystem::MaterializeLooseFile(m_Specification.FilePath.string());
-        msdfgen::FontHandle *fontHandle = CreateFontHandleWithFaceIndex(
-                freeTypeHandle, resolvedPath, m_Specification.FaceIndex);
+        ScopedFontHandle scopedFontHandle(*m_FacePool);
+        msdfgen::FontHandle *fontHandle = scopedFontHandle.Get();
         if (!fontHandle)
         {
             payload.IsMissing = true;
             payload.ErrorMessage = "Font face load failed";
-            msdfgen::deinitializeFreetype(freeTypeHandle);
             return payload;
         }
 
@@ -386,17 +596,15 @@ namespace Himii
         {
             payload.IsMissing = true;
             payload.ErrorMessage = "Glyph missing in font";
-            msdfgen::destroyFont(fontHandle);
-            msdfgen::deinitializeFreetype(freeTypeHandle);
+            payload.Persistable = true;
             return payload;
         }
 
         payload.Advance = static_cast<float>(glyph.getAdvance());
+        payload.Persistable = true;
         if (glyph.isWhitespace())
         {
             payload.IsWhitespace = true;
-            msdfgen::destroyFont(fontHandle);
-            msdfgen::deinitializeFreetype(freeTypeHandle);
             return payload;
         }
 
@@ -415,8 +623,6 @@ namespace Himii
         if (boxWidth <= 0 || boxHeight <= 0)
         {
             payload.IsWhitespace = true;
-            msdfgen::destroyFont(fontHandle);
-            msdfgen::deinitializeFreetype(freeTypeHandle);
             return payload;
         }
 
@@ -449,13 +655,94 @@ namespace Himii
             }
         }
 
-        msdfgen::destroyFont(fontHandle);
-        msdfgen::deinitializeFreetype(freeTypeHandle);
         return payload;
     }
 
-    bool Font::AllocateShelfRectangle(
-            int width, int height, uint32_t &pageIndex, int &pixelX, int &pixelY)
+    bool Font::TryAllocateOnPage(AtlasPage &page, int width, int height, int &pixelX, int &pixelY)
+    {
+        // 天际线按 X 升序覆盖 [AtlasPaddingPixels, pageSize)，每个矩形右侧与下侧各留一像素间隔。
+        const int pageSize = static_cast<int>(m_Specification.AtlasPageSize);
+        const int paddedWidth = width + AtlasPaddingPixels;
+        const int paddedHeight = height + AtlasPaddingPixels;
+        std::vector<SkylineSegment> &skyline = page.Skyline;
+
+        // 取落点最低者（bottom-left），同高时取矩形下方浪费面积更小者。
+        size_t bestIndex = skyline.size();
+        int bestY = pageSize;
+        int64_t bestWaste = 0;
+        for (size_t index = 0; index < skyline.size(); ++index)
+        {
+            const int x = skyline[index].X;
+            if (x + paddedWidth > pageSize)
+                break;
+
+            int y = 0;
+            int remainingWidth = paddedWidth;
+            for (size_t cover = index; cover < skyline.size() && remainingWidth > 0; ++cover)
+            {
+                y = std::max(y, skyline[cover].Y);
+                remainingWidth -= skyline[cover].Width;
+            }
+            if (y + paddedHeight > pageSize || y > bestY)
+                continue;
+
+            int64_t waste = 0;
+            remainingWidth = paddedWidth;
+            for (size_t cover = index; cover < skyline.size() && remainingWidth > 0; ++cover)
+            {
+                const int coveredWidth = std::min(skyline[cover].Width, remainingWidth);
+                waste += static_cast<int64_t>(y - skyline[cover].Y) * coveredWidth;
+                remainingWidth -= coveredWidth;
+            }
+            if (bestIndex == skyline.size() || y < bestY || waste < bestWaste)
+            {
+                bestIndex = index;
+                bestY = y;
+                bestWaste = waste;
+            }
+        }
+        if (bestIndex == skyline.size())
+            return false;
+
+        pixelX = skyline[bestIndex].X;
+        pixelY = bestY;
+        const SkylineSegment placed{pixelX, bestY + paddedHeight, paddedWidth};
+        skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), placed);
+
+        // 裁掉被新段遮住的后续段。
+        const int placedRight = placed.X + placed.Width;
+        const size_t nextIndex = bestIndex + 1;
+        while (nextIndex < skyline.size() && skyline[nextIndex].X < placedRight)
+        {
+            SkylineSegment &segment = skyline[nextIndex];
+            const int segmentRight = segment.X + segment.Width;
+            if (segmentRight <= placedRight)
+            {
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(nextIndex));
+                continue;
+            }
+            segment.Width = segmentRight - placedRight;
+            segment.X = placedRight;
+            break;
+        }
+
+        // 合并等高的相邻段，控制段数。
+        for (size_t index = 0; index + 1 < skyline.size();)
+        {
+            if (skyline[index].Y == skyline[index + 1].Y)
+            {
+                skyline[index].Width += skyline[index + 1].Width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(index + 1));
+            }
+            else
+                ++index;
+        }
+
+        page.UsedPixelArea += static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+        return true;
+    }
+
+    bool Font::AllocateAtlasRectangle(int width, int height, uint32_t &pageIndex, int &pixelX, int &pixelY)
     {
         const int pageSize = static_cast<int>(m_Specification.AtlasPageSize);
         if (width + AtlasPaddingPixels * 2 > pageSize || height + AtlasPaddingPixels * 2 > pageSize)
@@ -463,35 +750,19 @@ namespace Himii
 
         for (uint32_t index = 0; index < m_AtlasPages.size(); ++index)
         {
-            AtlasPage &page = m_AtlasPages[index];
-            if (page.CursorX + width + AtlasPaddingPixels > pageSize)
+            if (TryAllocateOnPage(m_AtlasPages[index], width, height, pixelX, pixelY))
             {
-                page.CursorX = AtlasPaddingPixels;
-                page.CursorY += page.CurrentRowHeight + AtlasPaddingPixels;
-                page.CurrentRowHeight = 0;
+                pageIndex = index;
+                return true;
             }
-            if (page.CursorY + height + AtlasPaddingPixels > pageSize)
-                continue;
-
-            pageIndex = index;
-            pixelX = page.CursorX;
-            pixelY = page.CursorY;
-            page.CursorX += width + AtlasPaddingPixels;
-            page.CurrentRowHeight = std::max(page.CurrentRowHeight, height);
-            return true;
         }
 
         if (m_AtlasPages.size() >= m_Specification.MaximumAtlasPageCount)
             return false;
 
         CreateNewAtlasPage();
-        AtlasPage &page = m_AtlasPages.back();
         pageIndex = static_cast<uint32_t>(m_AtlasPages.size() - 1);
-        pixelX = page.CursorX;
-        pixelY = page.CursorY;
-        page.CursorX += width + AtlasPaddingPixels;
-        page.CurrentRowHeight = std::max(page.CurrentRowHeight, height);
-        return true;
+        return TryAllocateOnPage(m_AtlasPages.back(), width, height, pixelX, pixelY);
     }
 
     void Font::MarkCapacityExceeded(char32_t codePoint)
@@ -510,7 +781,13 @@ namespace Himii
     bool Font::UploadGeneratedGlyph(const GeneratedGlyphPayload &payload)
     {
         std::lock_guard<std::mutex> lock(m_GlyphMutex);
+        return StoreGeneratedGlyph(payload);
+    }
+
+    bool Font::StoreGeneratedGlyph(const GeneratedGlyphPayload &payload)
+    {
         m_PendingCodePoints.erase(payload.CodePoint);
+        AdvanceGlyphGeneration();
 
         if (!payload.ErrorMessage.empty())
             m_LastError = payload.ErrorMessage;
@@ -537,7 +814,7 @@ namespace Himii
         uint32_t pageIndex = 0;
         int pixelX = 0;
         int pixelY = 0;
-        if (!AllocateShelfRectangle(payload.BitmapWidth, payload.BitmapHeight, pageIndex, pixelX, pixelY))
+        if (!AllocateAtlasRectangle(payload.BitmapWidth, payload.BitmapHeight, pageIndex, pixelX, pixelY))
         {
             MarkCapacityExceeded(payload.CodePoint);
             CachedGlyph missing;
@@ -574,8 +851,24 @@ namespace Himii
             std::lock_guard<std::mutex> lock(m_CompletionMutex);
             completed.swap(m_CompletedGenerations);
         }
+        if (completed.empty())
+            return;
+
+        // 整批先高后矮地装箱，天际线更平整；一次加锁完成全部分配与上传。
+        std::sort(completed.begin(), completed.end(),
+                  [](const GeneratedGlyphPayload &left, const GeneratedGlyphPayload &right)
+                  {
+                      if (left.BitmapHeight != right.BitmapHeight)
+                          return left.BitmapHeight > right.BitmapHeight;
+                      return left.BitmapWidth > right.BitmapWidth;
+                  });
+        {
+            std::lock_guard<std::mutex> lock(m_GlyphMutex);
+            for (const GeneratedGlyphPayload &payload : completed)
+                StoreGeneratedGlyph(payload);
+        }
         for (const GeneratedGlyphPayload &payload : completed)
-            UploadGeneratedGlyph(payload);
+            PersistGeneratedGlyph(payload);
     }
 
     bool Font::TryGetGlyph(char32_t codePoint, FontGlyphQuad &output) const
@@ -645,6 +938,25 @@ namespace Himii
                 m_UnavailableCodePoints.begin(), m_UnavailableCodePoints.end());
         snapshot.LastError = m_LastError;
         snapshot.AtlasPages = m_AtlasPageTextures;
+        if (m_GlyphCache)
+        {
+            snapshot.PersistentCachePath = m_GlyphCache->GetFilePath().string();
+            snapshot.PersistentCacheBytes = m_GlyphCache->GetFileSize();
+        }
+        snapshot.PersistentCacheLoadedGlyphCount = m_PersistentCacheLoadedGlyphCount;
+        snapshot.PersistentCacheLoadMilliseconds = m_PersistentCacheLoadMilliseconds;
+        snapshot.GeneratedGlyphCount = m_GeneratedGlyphCount.load(std::memory_order_relaxed);
+        snapshot.LastPreloadGlyphCount = m_LastPreloadGlyphCount;
+        snapshot.LastPreloadMilliseconds = m_LastPreloadMilliseconds;
+        uint64_t usedPixelArea = 0;
+        for (const AtlasPage &page : m_AtlasPages)
+            usedPixelArea += page.UsedPixelArea;
+        const uint64_t totalPixelArea = static_cast<uint64_t>(m_AtlasPages.size()) * m_Specification.AtlasPageSize
+                                        * m_Specification.AtlasPageSize;
+        snapshot.AtlasOccupancy =
+                totalPixelArea > 0 ? static_cast<float>(static_cast<double>(usedPixelArea) / totalPixelArea) : 0.0f;
+        snapshot.GenerationMilliseconds =
+                static_cast<float>(m_GenerationMicroseconds.load(std::memory_order_relaxed)) / 1000.0f;
         return snapshot;
     }
 }
@@ -83,10 +83,31 @@ namespace Himii
         std::vector<char32_t> MissingCodePoints;
         std::string LastError;
         std::vector<Ref<Texture2D>> AtlasPages;
+
+        // 持久化字形缓存：冷启动看实时生成耗时，热启动看缓存载入耗时。
+        std::string PersistentCachePath;
+        uint64_t PersistentCacheBytes = 0;
+        uint32_t PersistentCacheLoadedGlyphCount = 0;
+        float PersistentCacheLoadMilliseconds = 0.0f;
+        uint32_t GeneratedGlyphCount = 0;
+        float GenerationMilliseconds = 0.0f;
+
+        // 最近一次 PreloadTextAsync 从派发到全部上传的墙钟耗时。
+        uint32_t LastPreloadGlyphCount = 0;
+        float LastPreloadMilliseconds = 0.0f;
+        /// 字形像素面积 / 全部图集页面积。
+        float AtlasOccupancy = 0.0f;
     };
 
+    class FontGlyphCache;
+    class FontFacePool;
+    struct FontGlyphCacheRecord;
+
     class Font : public Asset {
     public:
+        /// 每个工作线程任务生成的字形数：足够小以便长段落铺满所有 worker，又不至于让投递开销占主导。
+        static constexpr uint32_t GlyphGenerationBatchSize = 8;
+
         Font(const FontSpecification &specification);
         explicit Font(const std::filesystem::path &filepath);
         ~Font() override;
@@ -128,13 +149,36 @@ namespace Himii
         bool TryGetGlyph(char32_t codePoint, FontGlyphQuad &output) const;
         float GetAdvance(char32_t codePoint, char32_t nextCodePoint) const;
         FontDiagnosticsSnapshot GetDiagnosticsSnapshot() const;
+        /// 字形集合或图集位置变化时递增（含回退查找可能命中的新字形），供排版缓存判断失效。
+        uint64_t GetGlyphGeneration() const
+        {
+            return m_GlyphGeneration.load(std::memory_order_acquire);
+        }
 
         static Ref<Font> GetDefault();
         static void InitDefault(const std::filesystem::path &path, int faceIndex = 0);
         static void SetDefault(const Ref<Font> &font);
         static Ref<Font> ResolveWithFallback(const Ref<Font> &preferredFont, char32_t codePoint);
 
+        /// 只读取字体度量，不创建图集页也不载入持久化缓存，可在没有 GL 上下文时生成字形；字体无法打开时返回 nullptr。
+        static Ref<Font> CreateHeadless(const FontSpecification &specification);
+        /// 在调用线程生成一个字形，不进图集也不写缓存，可从多个线程并发调用。
+        /// outRecord.BitmapPixels 指向 outPixels；返回结果能否写入持久化缓存。
+        bool GenerateGlyphRecord(char32_t codePoint, FontGlyphCacheRecord &outRecord,
+                                 std::vector<uint8_t> &outPixels) const;
+        /// 包内字体解包后的磁盘路径，即持久化字形缓存键使用的字体文件。
+        const std::filesystem::path &GetResolvedFilePath() const
+        {
+            return m_ResolvedFilePath;
+        }
+
     private:
+        /// 只读取字体度量的构造路径，见 CreateHeadless。
+        struct HeadlessConstruction
+        {
+        };
+        Font(const FontSpecification &specification, HeadlessConstruction);
+
         struct CachedGlyph
         {
             bool IsWhitespace = false;
@@ -149,12 +193,18 @@ namespace Himii
             float Advance = 0.0f;
         };
 
+        struct SkylineSegment
+        {
+            int X = 0;
+            int Y = 0;
+            int Width = 0;
+        };
+
         struct AtlasPage
         {
             Ref<Texture2D> Texture;
-            int CursorX = 1;
-            int CursorY = 1;
-            int CurrentRowHeight = 0;
+            std::vector<SkylineSegment> Skyline;
+            uint64_t UsedPixelArea = 0;
         };
 
         struct GeneratedGlyphPayload
@@ -169,6 +219,8 @@ namespace Himii
             int BitmapHeight = 0;
             std::vector<uint8_t> BitmapPixels;
             std::string ErrorMessage;
+            // 结果只取决于字体与生成参数（字形缺失也算），可写入持久化缓存。
+            bool Persistable = false;
         };
 
         void InitializeMetrics();
@@ -177,12 +229,24 @@ namespace Himii
         void EnsureInitialAsciiGlyphs();
         bool EnsureGlyph(char32_t codePoint);
         GeneratedGlyphPayload GenerateGlyphOnWorker(char32_t codePoint) const;
+        GeneratedGlyphPayload GenerateGlyph(char32_t codePoint) const;
         bool UploadGeneratedGlyph(const GeneratedGlyphPayload &payload);
-        bool AllocateShelfRectangle(int width, int height, uint32_t &pageIndex, int &pixelX, int &pixelY);
+        // 调用方须持有 m_GlyphMutex。
+        bool StoreGeneratedGlyph(const GeneratedGlyphPayload &payload);
+        void LoadPersistentGlyphCache();
+        void PersistGeneratedGlyph(const GeneratedGlyphPayload &payload);
+        static FontGlyphCacheRecord MakeCacheRecord(const GeneratedGlyphPayload &payload);
+        bool AllocateAtlasRectangle(int width, int height, uint32_t &pageIndex, int &pixelX, int &pixelY);
+        bool TryAllocateOnPage(AtlasPage &page, int width, int height, int &pixelX, int &pixelY);
         void CreateNewAtlasPage();
         void MarkCapacityExceeded(char32_t codePoint);
+        void AdvanceGlyphGeneration();
 
         FontSpecification m_Specification;
+        // 包内字体只解包一次；工作线程并发生成时共用这份磁盘路径。
+        std::filesystem::path m_ResolvedFilePath;
+        // 生成字形的线程从池中借出 FT_Face，析构时随池一起释放。
+        Scope<FontFacePool> m_FacePool;
         FontMetrics m_Metrics;
         float m_GeometryScale = 1.0f;
 
@@ -198,6 +262,17 @@ namespace Himii
         mutable std::mutex m_CompletionMutex;
         std::vector<GeneratedGlyphPayload> m_CompletedGenerations;
 
+        Ref<FontGlyphCache> m_GlyphCache;
+        // 载入缓存期间新建的图集页随整页暂存一起上传，跳过单独的清屏上传。
+        bool m_LoadingPersistentCache = false;
+        uint32_t m_PersistentCacheLoadedGlyphCount = 0;
+        float m_PersistentCacheLoadMilliseconds = 0.0f;
+        mutable std::atomic<uint32_t> m_GeneratedGlyphCount{0};
+        mutable std::atomic<uint64_t> m_GenerationMicroseconds{0};
+        uint32_t m_LastPreloadGlyphCount = 0;
+        float m_LastPreloadMilliseconds = 0.0f;
+        std::atomic<uint64_t> m_GlyphGeneration{0};
+
         static Ref<Font> s_DefaultFont;
     };
 } // namespace Himii
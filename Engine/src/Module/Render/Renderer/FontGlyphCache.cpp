@@ -0,0 +1,319 @@
+#include "Hepch.h"
+#include "Module/Render/Renderer/FontGlyphCache.h"
+#include "EngineCore/Core/FileSystem.h"
+#include "EngineCore/Core/Hash.h"
+#include "EngineCore/Core/Log.h"
+#include "EngineCore/Utils/PlatformUtils.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr char FontGlyphCacheMagic[4] = {'H', 'F', 'G', 'C'};
+        constexpr uint32_t FontGlyphCacheFormatVersion = 1u;
+        constexpr uint8_t GlyphRecordWhitespaceFlag = 1u << 0;
+        constexpr uint8_t GlyphRecordMissingFlag = 1u << 1;
+
+#pragma pack(push, 1)
+        struct FontGlyphCacheFileHeader
+        {
+            char Magic[4];
+            uint32_t Version = FontGlyphCacheFormatVersion;
+            uint64_t FontContentHash = 0;
+            int32_t FaceIndex = 0;
+            uint32_t Reserved = 0;
+            double GenerationScale = 0.0;
+            double PixelRange = 0.0;
+            double MiterLimit = 0.0;
+        };
+
+        struct FontGlyphCacheRecordHeader
+        {
+            uint32_t CodePoint = 0;
+            uint8_t Flags = 0;
+            uint8_t Reserved = 0;
+            uint16_t BitmapWidth = 0;
+            uint16_t BitmapHeight = 0;
+            uint16_t Padding = 0;
+            float Advance = 0.0f;
+            float PlaneMinimum[2] = {};
+            float PlaneMaximum[2] = {};
+        };
+#pragma pack(pop)
+
+        size_t GetRecordPixelBytes(const FontGlyphCacheRecordHeader &header)
+        {
+            return static_cast<size_t>(header.BitmapWidth) * static_cast<size_t>(header.BitmapHeight) * 3u;
+        }
+
+        /// 同一字体文件（路径 + 生成参数）最近一次的 stat 指纹与内容哈希；指纹不变时免去整文件哈希。
+        struct FontSourceRegistryEntry
+        {
+            PlatformFileFingerprint Fingerprint;
+            uint64_t FontContentHash = 0;
+            std::weak_ptr<FontGlyphCache> Cache;
+        };
+
+        std::mutex s_RegistryMutex;
+        std::unordered_map<std::string, std::weak_ptr<FontGlyphCache>> s_Registry;
+        std::unordered_map<std::string, FontSourceRegistryEntry> s_SourceRegistry;
+
+        uint64_t HashGenerationParameters(const FontGlyphCacheKey &key, uint64_t hash = FnvOffsetBasis)
+        {
+            hash = HashValue(key.FaceIndex, hash);
+            hash = HashValue(key.GenerationScale, hash);
+            hash = HashValue(key.PixelRange, hash);
+            return HashValue(key.MiterLimit, hash);
+        }
+
+        std::filesystem::path GetCacheFilePath(const FontGlyphCacheKey &key, uint64_t fontContentHash)
+        {
+            const uint64_t keyHash = HashGenerationParameters(key, HashValue(fontContentHash));
+            std::ostringstream fileName;
+            fileName << key.FontFilePath.stem().string() << '_' << std::hex << std::setw(16) << std::setfill('0')
+                     << keyHash << ".hglyph";
+            return FileSystem::GetWritableCacheRoot() / "font" / fileName.str();
+        }
+    }
+
+    Ref<FontGlyphCache> FontGlyphCache::Acquire(const FontGlyphCacheKey &key)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 先按路径 + stat 指纹查注册表：字体未变时不再映射并哈希整个文件（CJK 字体常有十几 MB）。
+        const PlatformFileFingerprint fingerprint = PlatformFileSystem::QueryFileFingerprint(key.FontFilePath);
+        if (!fingerprint.Exists)
+            return nullptr;
+        const std::string sourceKey =
+                key.FontFilePath.generic_string() + '#' + std::to_string(HashGenerationParameters(key));
+
+        uint64_t fontContentHash = 0;
+        bool hasContentHash = false;
+        {
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            const auto found = s_SourceRegistry.find(sourceKey);
+            if (found != s_SourceRegistry.end() && found->second.Fingerprint == fingerprint)
+            {
+                if (Ref<FontGlyphCache> existing = found->second.Cache.lock())
+                    return existing;
+                fontContentHash = found->second.FontContentHash;
+                hasContentHash = true;
+            }
+        }
+
+        if (!hasContentHash)
+        {
+            PlatformMappedFile fontFile;
+            if (!fontFile.Open(key.FontFilePath))
+                return nullptr;
+            fontContentHash = HashContent(fontFile.GetData(), fontFile.GetSize());
+        }
+
+        const std::filesystem::path filePath = GetCacheFilePath(key, fontContentHash);
+
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        std::weak_ptr<FontGlyphCache> &slot = s_Registry[filePath.string()];
+        Ref<FontGlyphCache> cache = slot.lock();
+        if (!cache)
+        {
+            cache = CreateRef<FontGlyphCache>(filePath, fontContentHash, key);
+            slot = cache;
+        }
+        s_SourceRegistry[sourceKey] = {fingerprint, fontContentHash, cache};
+        return cache;
+    }
+
+    FontGlyphCache::FontGlyphCache(const std::filesystem::path &filePath, uint64_t fontContentHash,
+                                   const FontGlyphCacheKey &key) :
+        m_FilePath(filePath), m_FontContentHash(fontContentHash), m_Key(key)
+    {
+    }
+
+    FontGlyphCache::~FontGlyphCache() = default;
+
+    uint64_t FontGlyphCache::GetFileSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_FileSize;
+    }
+
+    bool FontGlyphCache::WriteHeader()
+    {
+        FontGlyphCacheFileHeader header = {};
+        std::memcpy(header.Magic, FontGlyphCacheMagic, sizeof(FontGlyphCacheMagic));
+        header.FontContentHash = m_FontContentHash;
+        header.FaceIndex = m_Key.FaceIndex;
+        header.GenerationScale = m_Key.GenerationScale;
+        header.PixelRange = m_Key.PixelRange;
+        header.MiterLimit = m_Key.MiterLimit;
+
+        std::ofstream outputStream(m_FilePath, std::ios::binary | std::ios::trunc);
+        if (!outputStream.is_open())
+        {
+            HIMII_CORE_ERROR("Failed to create font glyph cache: {0}", m_FilePath.string());
+            return false;
+        }
+        outputStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        outputStream.close();
+        if (outputStream.fail())
+        {
+            HIMII_CORE_ERROR("Failed to write font glyph cache: {0}", m_FilePath.string());
+            return false;
+        }
+        m_FileSize = sizeof(header);
+        return true;
+    }
+
+    bool FontGlyphCache::Load(std::vector<uint8_t> &outFileData, std::vector<FontGlyphCacheRecord> &outRecords)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        outFileData.clear();
+        outRecords.clear();
+
+        // 共享同一文件的实例可能已有追加尚在流缓冲中。
+        if (m_AppendStream.is_open())
+            m_AppendStream.flush();
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(m_FilePath.parent_path(), errorCode);
+        {
+            std::ifstream inputStream(m_FilePath, std::ios::binary | std::ios::ate);
+            if (inputStream.is_open())
+            {
+                const std::streamoff fileSize = inputStream.tellg();
+                inputStream.seekg(0, std::ios::beg);
+                outFileData.resize(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+                if (!outFileData.empty()
+                    && !inputStream.read(reinterpret_cast<char *>(outFileData.data()),
+                                         static_cast<std::streamsize>(outFileData.size())))
+                    outFileData.clear();
+            }
+        }
+
+        size_t validSize = 0;
+        if (outFileData.size() >= sizeof(FontGlyphCacheFileHeader))
+        {
+            FontGlyphCacheFileHeader header = {};
+            std::memcpy(&header, outFileData.data(), sizeof(header));
+            if (std::memcmp(header.Magic, FontGlyphCacheMagic, sizeof(FontGlyphCacheMagic)) == 0
+                && header.Version == FontGlyphCacheFormatVersion && header.FontContentHash == m_FontContentHash
+                && header.FaceIndex == m_Key.FaceIndex && header.GenerationScale == m_Key.GenerationScale
+                && header.PixelRange == m_Key.PixelRange && header.MiterLimit == m_Key.MiterLimit)
+                validSize = sizeof(header);
+        }
+
+        if (validSize > 0)
+        {
+            size_t offset = validSize;
+            while (offset + sizeof(FontGlyphCacheRecordHeader) <= outFileData.size())
+            {
+                FontGlyphCacheRecordHeader recordHeader = {};
+                std::memcpy(&recordHeader, outFileData.data() + offset, sizeof(recordHeader));
+                const size_t pixelBytes = GetRecordPixelBytes(recordHeader);
+                const size_t recordEnd = offset + sizeof(recordHeader) + pixelBytes;
+                if (recordEnd > outFileData.size())
+                    break;
+
+                if (m_StoredCodePoints.insert(static_cast<char32_t>(recordHeader.CodePoint)).second || m_Loaded)
+                {
+                    FontGlyphCacheRecord record;
+                    record.CodePoint = static_cast<char32_t>(recordHeader.CodePoint);
+                    record.IsWhitespace = (recordHeader.Flags & GlyphRecordWhitespaceFlag) != 0;
+                    record.IsMissing = (recordHeader.Flags & GlyphRecordMissingFlag) != 0;
+                    record.Advance = recordHeader.Advance;
+                    record.PlaneMinimum = {recordHeader.PlaneMinimum[0], recordHeader.PlaneMinimum[1]};
+                    record.PlaneMaximum = {recordHeader.PlaneMaximum[0], recordHeader.PlaneMaximum[1]};
+                    record.BitmapWidth = recordHeader.BitmapWidth;
+                    record.BitmapHeight = recordHeader.BitmapHeight;
+                    record.BitmapPixels = pixelBytes > 0 ? outFileData.data() + offset + sizeof(recordHeader)
+                                                         : nullptr;
+                    outRecords.push_back(record);
+                }
+                offset = recordEnd;
+            }
+            validSize = offset;
+        }
+
+        // 其他实例已打开追加流时文件由它维护，这里只读取。
+        if (m_Loaded)
+            return validSize > 0;
+        m_Loaded = true;
+
+        if (validSize == 0)
+        {
+            if (!outFileData.empty())
+                HIMII_CORE_WARNING("Font glyph cache {0} is stale or unreadable; it will be rebuilt",
+                                   m_FilePath.string());
+            outFileData.clear();
+            outRecords.clear();
+            m_StoredCodePoints.clear();
+            if (!WriteHeader())
+                return false;
+        }
+        else
+        {
+            if (validSize < outFileData.size())
+            {
+                // 上次进程在追加中途退出，丢弃写了一半的尾部记录。
+                HIMII_CORE_WARNING("Font glyph cache {0} has a truncated tail; dropping {1} byte(s)",
+                                   m_FilePath.string(), outFileData.size() - validSize);
+                std::filesystem::resize_file(m_FilePath, validSize, errorCode);
+                if (errorCode)
+                    return false;
+            }
+            m_FileSize = validSize;
+        }
+
+        m_AppendStream.open(m_FilePath, std::ios::binary | std::ios::app);
+        if (!m_AppendStream.is_open())
+            HIMII_CORE_WARNING("Font glyph cache {0} is read-only; new glyphs will not be persisted",
+                               m_FilePath.string());
+        return true;
+    }
+
+    void FontGlyphCache::Append(const FontGlyphCacheRecord &record)
+    {
+        if (record.BitmapWidth < 0 || record.BitmapHeight < 0 || record.BitmapWidth > UINT16_MAX
+            || record.BitmapHeight > UINT16_MAX)
+            return;
+
+        FontGlyphCacheRecordHeader recordHeader = {};
+        recordHeader.CodePoint = static_cast<uint32_t>(record.CodePoint);
+        recordHeader.Flags = static_cast<uint8_t>((record.IsWhitespace ? GlyphRecordWhitespaceFlag : 0)
+                                                  | (record.IsMissing ? GlyphRecordMissingFlag : 0));
+        const bool hasBitmap = record.BitmapPixels && !record.IsWhitespace && !record.IsMissing;
+        recordHeader.BitmapWidth = hasBitmap ? static_cast<uint16_t>(record.BitmapWidth) : 0;
+        recordHeader.BitmapHeight = hasBitmap ? static_cast<uint16_t>(record.BitmapHeight) : 0;
+        recordHeader.Advance = record.Advance;
+        recordHeader.PlaneMinimum[0] = record.PlaneMinimum.x;
+        recordHeader.PlaneMinimum[1] = record.PlaneMinimum.y;
+        recordHeader.PlaneMaximum[0] = record.PlaneMaximum.x;
+        recordHeader.PlaneMaximum[1] = record.PlaneMaximum.y;
+        const size_t pixelBytes = GetRecordPixelBytes(recordHeader);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_AppendStream.is_open() || !m_StoredCodePoints.insert(record.CodePoint).second)
+            return;
+
+        m_AppendStream.write(reinterpret_cast<const char *>(&recordHeader), sizeof(recordHeader));
+        if (pixelBytes > 0)
+            m_AppendStream.write(reinterpret_cast<const char *>(record.BitmapPixels),
+                                 static_cast<std::streamsize>(pixelBytes));
+        m_AppendStream.flush();
+        if (m_AppendStream.fail())
+        {
+            HIMII_CORE_WARNING("Failed to append to font glyph cache {0}; persistence disabled for this session",
+                               m_FilePath.string());
+            m_AppendStream.close();
+            return;
+        }
+        m_FileSize += sizeof(recordHeader) + pixelBytes;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "EngineCore/Core/Core.h"
+#include "glm/glm.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace Himii
+{
+    /// 决定 MSDF 位图内容的全部输入；任一项变化都对应另一个缓存文件。
+    struct FontGlyphCacheKey
+    {
+        std::filesystem::path FontFilePath;
+        int FaceIndex = 0;
+        double GenerationScale = 40.0;
+        double PixelRange = 2.0;
+        double MiterLimit = 1.0;
+    };
+
+    /// BitmapPixels 指向 Load 读入的文件缓冲区，缓冲区释放后失效。
+    struct FontGlyphCacheRecord
+    {
+        char32_t CodePoint = 0;
+        bool IsWhitespace = false;
+        bool IsMissing = false;
+        float Advance = 0.0f;
+        glm::vec2 PlaneMinimum{0.0f};
+        glm::vec2 PlaneMaximum{0.0f};
+        int BitmapWidth = 0;
+        int BitmapHeight = 0;
+        const uint8_t *BitmapPixels = nullptr;
+    };
+
+    /// 每个字体一个只追加的字形缓存文件：启动时整体读入一次，新生成的字形逐条追加。
+    /// 同一字体的多个 Font 实例共享同一对象，避免重复追加或交错写入。
+    class FontGlyphCache {
+    public:
+        /// 字体文件无法读取时返回 nullptr，调用方照常实时生成。
+        static Ref<FontGlyphCache> Acquire(const FontGlyphCacheKey &key);
+
+        FontGlyphCache(const std::filesystem::path &filePath, uint64_t fontContentHash, const FontGlyphCacheKey &key);
+        ~FontGlyphCache();
+
+        /// 一次读取整个文件并解析全部记录；末尾写了一半的记录会被截掉，版本或键不符时重建文件。
+        bool Load(std::vector<uint8_t> &outFileData, std::vector<FontGlyphCacheRecord> &outRecords);
+        /// 已存在的码点直接忽略。
+        void Append(const FontGlyphCacheRecord &record);
+
+        const std::filesystem::path &GetFilePath() const
+        {
+            return m_FilePath;
+        }
+        uint64_t GetFileSize() const;
+
+    private:
+        bool WriteHeader();
+
+        std::filesystem::path m_FilePath;
+        uint64_t m_FontContentHash = 0;
+        FontGlyphCacheKey m_Key;
+
+        mutable std::mutex m_Mutex;
+        std::unordered_set<char32_t> m_StoredCodePoints;
+        std::ofstream m_AppendStream;
+        uint64_t m_FileSize = 0;
+        bool m_Loaded = false;
+    };
+}
@@ -20,8 +20,7 @@ namespace Himii
 
         void OnShutdown() override
         {
-            Renderer2D::Shutdown();
-            Renderer3D::Shutdown();
+            Renderer::Shutdown();
         }
 
         static void OnWindowResize(uint32_t width, uint32_t height)
@@ -3,6 +3,7 @@
 #include "Module/Render/Renderer/Renderer2D.h"
 #include "Module/Render/Renderer/Renderer3D.h"
 #include "Module/Render/Renderer/SceneColorResolvePass.h"
+#include "Module/Render/Shader/ShaderWarmup.h"
 
 namespace Himii
 {
@@ -13,9 +14,32 @@ namespace Himii
         HIMII_PROFILE_FUNCTION();
 
         RenderCommand::Init();
+        // 先在工作线程并行完成各渲染器着色器的 CPU 编译，随后的 Shader::Create 只做链接。
+        ShaderWarmup::WarmupEngineShaders(GetEngineShaderPaths());
         Renderer2D::Init();
         Renderer3D::Init();
         SceneColorResolvePass::Init();
+        Shader::FlushCache();
+    }
+
+    std::vector<std::string> Renderer::GetEngineShaderPaths()
+    {
+        std::vector<std::string> shaderPaths = Renderer2D::GetShaderPaths();
+        const std::vector<std::string> renderer3DShaderPaths = Renderer3D::GetShaderPaths();
+        const std::vector<std::string> resolveShaderPaths = SceneColorResolvePass::GetShaderPaths();
+        shaderPaths.insert(shaderPaths.end(), renderer3DShaderPaths.begin(), renderer3DShaderPaths.end());
+        shaderPaths.insert(shaderPaths.end(), resolveShaderPaths.begin(), resolveShaderPaths.end());
+        return shaderPaths;
+    }
+
+    void Renderer::Shutdown()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Renderer2D::Shutdown();
+        Renderer3D::Shutdown();
+        Shader::ReleasePrecompiled();
+        Shader::ShutdownCache();
     }
 
     void Renderer::OnWindowResize(uint32_t width, uint32_t height)
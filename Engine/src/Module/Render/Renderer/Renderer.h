@@ -9,6 +9,9 @@ namespace Himii
     {
     public:
         static void Init();
+        static void Shutdown();
+        /// 各渲染器 Init 中按文件创建的着色器，按初始化顺序汇总；预热与无窗口缓存预热都从这里取列表。
+        static std::vector<std::string> GetEngineShaderPaths();
         static void OnWindowResize(uint32_t width, uint32_t height);
 
         static void BeginScene(OrthographicCamera& camera);
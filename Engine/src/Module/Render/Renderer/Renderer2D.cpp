@@ -10,6 +10,7 @@
 #include "Module/Render/RenderCore/VertexArray.h"
 #include "Module/Render/Renderer/Font.h"
 #include "Module/Render/Renderer/TextLayout.h"
+#include "Module/Render/Renderer/UserInterfaceDrawList.h"
 #include "Module/Render/Renderer/FontRegressionTests.h"
 #include "Project/Project.h"
 #include "Resource/ResourceSystem.h"
@@ -79,6 +80,10 @@ namespace Himii
         Ref<VertexBuffer> TextVertexBuffer;
         Ref<Shader> TextShader;
 
+        Ref<VertexArray> UserInterfaceVertexArray;
+        Ref<VertexBuffer> UserInterfaceVertexBuffer;
+        Ref<Shader> UserInterfaceShader;
+
         uint32_t QuadIndexCount = 0;
         QuadVertex *QuadVertexBufferBase = nullptr;
         QuadVertex *QuadVertexBufferPtr = nullptr;
@@ -116,6 +121,17 @@ namespace Himii
 
     static Renderer2DData s_Data;
 
+    static constexpr const char *QuadShaderPath = "assets/shaders/Renderer2D_Quad.glsl";
+    static constexpr const char *CircleShaderPath = "assets/shaders/Renderer2D_Circle.glsl";
+    static constexpr const char *LineShaderPath = "assets/shaders/Renderer2D_Line.glsl";
+    static constexpr const char *TextShaderPath = "assets/shaders/Renderer2D_Text.glsl";
+    static constexpr const char *UserInterfaceShaderPath = "assets/shaders/Renderer2D_UserInterface.glsl";
+
+    std::vector<std::string> Renderer2D::GetShaderPaths()
+    {
+        return {QuadShaderPath, CircleShaderPath, LineShaderPath, TextShaderPath, UserInterfaceShaderPath};
+    }
+
     // 计算当前批次是否需要换批（由调用者在类方法内触发 NextBatch）
     static inline bool NeedsNewBatch(uint32_t verticesNeeded, uint32_t indicesNeeded)
     {
@@ -198,6 +214,18 @@ namespace Himii
         s_Data.TextVertexArray->SetIndexBuffer(quadIB);
         s_Data.TextVertexBufferBase = new TextVertex[s_Data.MaxVertices];
 
+        s_Data.UserInterfaceVertexArray = VertexArray::Create();
+        s_Data.UserInterfaceVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(UserInterfaceVertex));
+
+        s_Data.UserInterfaceVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                                                     {ShaderDataType::Float4, "a_Color"},
+                                                     {ShaderDataType::Float2, "a_TexCoord"},
+                                                     {ShaderDataType::Float, "a_TexIndex"},
+                                                     {ShaderDataType::Float2, "a_DistanceFieldRange"},
+                                                     {ShaderDataType::Int, "a_EntityID"}});
+        s_Data.UserInterfaceVertexArray->AddVertexBuffer(s_Data.UserInterfaceVertexBuffer);
+        s_Data.UserInterfaceVertexArray->SetIndexBuffer(quadIB);
+
         s_Data.WhiteTexture = Texture2D::Create(1, 1);
         uint32_t whiteTextureData = 0xffffffff;
         s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
@@ -206,14 +234,17 @@ namespace Himii
         for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
             samplers[i] = i;
 
-        s_Data.QuadShader = Shader::Create("assets/shaders/Renderer2D_Quad.glsl");
-        s_Data.CircleShader = Shader::Create("assets/shaders/Renderer2D_Circle.glsl");
-        s_Data.LineShader = Shader::Create("assets/shaders/Renderer2D_Line.glsl");
-        s_Data.TextShader = Shader::Create("assets/shaders/Renderer2D_Text.glsl");
+        s_Data.QuadShader = Shader::Create(QuadShaderPath);
+        s_Data.CircleShader = Shader::Create(CircleShaderPath);
+        s_Data.LineShader = Shader::Create(LineShaderPath);
+        s_Data.TextShader = Shader::Create(TextShaderPath);
         HIMII_CORE_ASSERT(s_Data.TextShader && s_Data.TextShader->IsValid(),
                           "Text shader failed to create!");
         s_Data.TextShader->Bind();
         s_Data.TextShader->SetIntArray("u_FontAtlases", samplers, s_Data.MaxTextureSlots);
+        s_Data.UserInterfaceShader = Shader::Create(UserInterfaceShaderPath);
+        s_Data.UserInterfaceShader->Bind();
+        s_Data.UserInterfaceShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
 
         FontRegression::RunTextLayoutSmokeTests();
         FontRegression::RunShaderValiditySmokeTest(s_Data.TextShader);
@@ -233,6 +264,7 @@ namespace Himii
 
         delete[] s_Data.QuadVertexBufferBase;
         delete[] s_Data.TextVertexBufferBase;
+        TextLayoutCache::Clear();
     }
     void Renderer2D::BeginScene(const OrthographicCamera &camera)
     {
@@ -932,12 +964,9 @@ namespace Himii
         ++s_Data.Stats.QuadCount;
     }
 
-    void Renderer2D::DrawString(const std::string &string, Ref<Font> font, const glm::mat4 &transform,
-                                const glm::vec4 &color, int entityID)
+    static std::vector<TextLayoutQuad> BuildStringLayout(const std::string &string, const Ref<Font> &font)
     {
-        if (!font || string.empty() || !s_Data.TextShader || !s_Data.TextShader->IsValid())
-            return;
-
+        std::vector<TextLayoutQuad> quads;
         font->EnsureGlyphsForText(string);
         const FontMetrics &metrics = font->GetMetrics();
         const float fontScale =
@@ -966,26 +995,19 @@ namespace Himii
             {
                 const glm::vec2 minimum = glyph.PlaneMinimum * fontScale + glm::vec2(cursorX, cursorY);
                 const glm::vec2 maximum = glyph.PlaneMaximum * fontScale + glm::vec2(cursorX, cursorY);
-                EmitTextGlyphQuad(
-                        transform, color, entityID, minimum, maximum, glyph.AtlasUVMinimum,
-                        glyph.AtlasUVMaximum, glyph.AtlasPageTexture);
+                quads.push_back({minimum, maximum, glyph.AtlasUVMinimum, glyph.AtlasUVMaximum,
+                                 glyph.AtlasPageTexture});
             }
 
             cursorX += font->GetAdvance(character, nextCharacter) * fontScale;
         }
+        return quads;
     }
 
-    void Renderer2D::DrawStringInRectangle(
-            const std::string &string, const Ref<Font> &font,
-            const glm::mat4 &transform, const TextLayoutSettings &layoutSettings,
-            const glm::vec4 &color, int entityIdentifier)
+    static std::vector<TextLayoutQuad> BuildRectangleLayout(
+            const std::string &string, const Ref<Font> &font, const TextLayoutSettings &layoutSettings)
     {
-        if (!font || string.empty() || layoutSettings.FontSize <= 0.0f
-            || layoutSettings.RectangleSize.x <= 0.0f
-            || layoutSettings.RectangleSize.y <= 0.0f
-            || !s_Data.TextShader || !s_Data.TextShader->IsValid())
-            return;
-
+        std::vector<TextLayoutQuad> quads;
         font->EnsureGlyphsForText(string);
         const FontMetrics &metrics = font->GetMetrics();
         // FontSize = em 字号（设计像素）
@@ -1151,16 +1173,148 @@ namespace Himii
                                 glm::mix(glyph.AtlasUVMinimum, glyph.AtlasUVMaximum, minimumRatio);
                         const glm::vec2 clippedTextureMaximum =
                                 glm::mix(glyph.AtlasUVMinimum, glyph.AtlasUVMaximum, maximumRatio);
-                        EmitTextGlyphQuad(
-                                transform, color, entityIdentifier, clippedMinimum,
-                                clippedMaximum, clippedTextureMinimum, clippedTextureMaximum,
-                                glyph.AtlasPageTexture);
+                        quads.push_back({clippedMinimum, clippedMaximum, clippedTextureMinimum,
+                                         clippedTextureMaximum, glyph.AtlasPageTexture});
                     }
                 }
 
                 cursorX += getAdvance(character, nextCharacter);
             }
         }
+        return quads;
+    }
+
+    static void EmitTextLayout(const std::vector<TextLayoutQuad> &quads, const glm::mat4 &transform,
+                               const glm::vec4 &color, int entityIdentifier)
+    {
+        for (const TextLayoutQuad &quad : quads)
+            EmitTextGlyphQuad(transform, color, entityIdentifier, quad.Minimum, quad.Maximum,
+                              quad.TextureMinimum, quad.TextureMaximum, quad.AtlasTexture);
+    }
+
+    void Renderer2D::DrawString(const std::string &string, Ref<Font> font, const glm::mat4 &transform,
+                                const glm::vec4 &color, int entityID)
+    {
+        if (!font || string.empty() || !s_Data.TextShader || !s_Data.TextShader->IsValid())
+            return;
+
+        // 命中时跳过 UTF-8 解码、字形查询与逐字 advance 累加。
+        bool cacheHit = false;
+        const std::vector<TextLayoutQuad> &quads = TextLayoutCache::GetOrBuild(
+                font, string, TextLayoutMode::Unbounded, TextLayoutSettings{},
+                [&]() { return BuildStringLayout(string, font); }, &cacheHit);
+        ++(cacheHit ? s_Data.Stats.TextLayoutCacheHits : s_Data.Stats.TextLayoutCacheMisses);
+        EmitTextLayout(quads, transform, color, entityID);
+    }
+
+    void Renderer2D::DrawStringInRectangle(
+            const std::string &string, const Ref<Font> &font,
+            const glm::mat4 &transform, const TextLayoutSettings &layoutSettings,
+            const glm::vec4 &color, int entityIdentifier)
+    {
+        if (!font || string.empty() || layoutSettings.FontSize <= 0.0f
+            || layoutSettings.RectangleSize.x <= 0.0f
+            || layoutSettings.RectangleSize.y <= 0.0f
+            || !s_Data.TextShader || !s_Data.TextShader->IsValid())
+            return;
+
+        // 命中时跳过换行、对齐与裁剪，静态 UI 文本每帧只剩一次查找。
+        bool cacheHit = false;
+        const std::vector<TextLayoutQuad> &quads = TextLayoutCache::GetOrBuild(
+                font, string, TextLayoutMode::Rectangle, layoutSettings,
+                [&]() { return BuildRectangleLayout(string, font, layoutSettings); }, &cacheHit);
+        ++(cacheHit ? s_Data.Stats.TextLayoutCacheHits : s_Data.Stats.TextLayoutCacheMisses);
+        EmitTextLayout(quads, transform, color, entityIdentifier);
+    }
+
+    void Renderer2D::AppendUserInterfaceImage(UserInterfaceDrawElement &element, const glm::mat4 &transform,
+                                              const Ref<Texture2D> &texture, const glm::vec4 &color, int entityID)
+    {
+        const glm::vec3 positions[4] = {
+                transform * s_Data.QuadVertexPositions[0], transform * s_Data.QuadVertexPositions[1],
+                transform * s_Data.QuadVertexPositions[2], transform * s_Data.QuadVertexPositions[3]};
+        const glm::vec2 textureCoordinates[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+        element.AddQuad(positions, textureCoordinates, texture, color, glm::vec2(0.0f), entityID);
+    }
+
+    void Renderer2D::AppendUserInterfaceText(UserInterfaceDrawElement &element, const std::string &string,
+                                             const Ref<Font> &font, const glm::mat4 &transform,
+                                             const TextLayoutSettings &layoutSettings, const glm::vec4 &color,
+                                             int entityID)
+    {
+        if (!font || string.empty() || layoutSettings.FontSize <= 0.0f || layoutSettings.RectangleSize.x <= 0.0f
+            || layoutSettings.RectangleSize.y <= 0.0f)
+            return;
+
+        bool cacheHit = false;
+        const std::vector<TextLayoutQuad> &quads = TextLayoutCache::GetOrBuild(
+                font, string, TextLayoutMode::Rectangle, layoutSettings,
+                [&]() { return BuildRectangleLayout(string, font, layoutSettings); }, &cacheHit);
+        ++(cacheHit ? s_Data.Stats.TextLayoutCacheHits : s_Data.Stats.TextLayoutCacheMisses);
+
+        const float pixelRange = static_cast<float>(font->GetSpecification().PixelRange);
+        for (const TextLayoutQuad &quad : quads)
+        {
+            if (!quad.AtlasTexture)
+                continue;
+
+            // 屏幕像素范围在片元着色器中由 fwidth 换算，这里只记录图集 UV 空间下的距离场范围。
+            const glm::vec2 distanceFieldRange =
+                    glm::vec2(pixelRange)
+                    / glm::max(glm::vec2(quad.AtlasTexture->GetWidth(), quad.AtlasTexture->GetHeight()), glm::vec2(1.0f));
+            const glm::vec3 positions[4] = {
+                    transform * glm::vec4(quad.Minimum.x, quad.Minimum.y, 0.0f, 1.0f),
+                    transform * glm::vec4(quad.Maximum.x, quad.Minimum.y, 0.0f, 1.0f),
+                    transform * glm::vec4(quad.Maximum.x, quad.Maximum.y, 0.0f, 1.0f),
+                    transform * glm::vec4(quad.Minimum.x, quad.Maximum.y, 0.0f, 1.0f)};
+            const glm::vec2 textureCoordinates[4] = {
+                    quad.TextureMinimum,
+                    {quad.TextureMaximum.x, quad.TextureMinimum.y},
+                    quad.TextureMaximum,
+                    {quad.TextureMinimum.x, quad.TextureMaximum.y}};
+            element.AddQuad(positions, textureCoordinates, quad.AtlasTexture, color, distanceFieldRange, entityID);
+        }
+    }
+
+    void Renderer2D::DrawUserInterfaceList(UserInterfaceDrawList &drawList, const glm::mat4 &designToTarget)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        drawList.Compile(Renderer2DData::MaxTextureSlots, Renderer2DData::MaxVertices);
+        s_Data.Stats.UserInterfaceRebuiltElements += drawList.GetRebuiltElementCount();
+        s_Data.Stats.UserInterfaceTypeSeparatedDrawCalls += drawList.GetTypeSeparatedBatchCount();
+        if (drawList.GetBatches().empty() || !s_Data.UserInterfaceShader || !s_Data.UserInterfaceShader->IsValid())
+            return;
+
+        // 先提交已排队的普通批次，保证 UI 仍按调用顺序叠在其上。
+        NextBatch();
+
+        // 顶点保存在设计空间，设计空间到目标的变换并入相机矩阵，视口或预览矩阵变化都无需重建顶点。
+        const glm::mat4 sceneViewProjection = s_Data.CameraBuffer.ViewProjection;
+        s_Data.CameraBuffer.ViewProjection = sceneViewProjection * designToTarget;
+        s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
+
+        s_Data.UserInterfaceShader->Bind();
+        const std::vector<UserInterfaceVertex> &vertices = drawList.GetVertices();
+        for (const UserInterfaceDrawList::Batch &batch : drawList.GetBatches())
+        {
+            s_Data.UserInterfaceVertexBuffer->SetData(vertices.data() + batch.FirstVertex,
+                                                      batch.VertexCount * sizeof(UserInterfaceVertex));
+            for (size_t slotIndex = 0; slotIndex < batch.TextureSlots.size(); ++slotIndex)
+            {
+                const Ref<Texture2D> &texture =
+                        batch.TextureSlots[slotIndex] ? batch.TextureSlots[slotIndex] : s_Data.WhiteTexture;
+                texture->Bind(static_cast<uint32_t>(slotIndex));
+            }
+
+            RenderCommand::DrawIndexed(s_Data.UserInterfaceVertexArray, batch.VertexCount / 4 * 6);
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.UserInterfaceDrawCalls++;
+            s_Data.Stats.QuadCount += batch.VertexCount / 4;
+        }
+
+        s_Data.CameraBuffer.ViewProjection = sceneViewProjection;
+        s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
     }
 
     void Renderer2D::DrawSprite(const glm::mat4 &transform,
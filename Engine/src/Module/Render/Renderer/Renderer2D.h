@@ -8,6 +8,7 @@
 #include "Module/Tilemap/TileMapData.h"
 #include "Module/Render/Renderer/EditorCamera.h"
 #include "Module/Render/Renderer/Font.h"
+#include "Module/Render/Renderer/UserInterfaceDrawList.h"
 
 namespace Himii
 {
@@ -16,6 +17,8 @@ namespace Himii
 
         static void Init();
         static void Shutdown();
+        /// Init 中按文件创建的着色器，供 Renderer 汇总给着色器预热。
+        static std::vector<std::string> GetShaderPaths();
 
         static void BeginScene(const OrthographicCamera &camera);
         static void BeginScene(const EditorCamera &camera);
@@ -57,6 +60,16 @@ namespace Himii
                 const glm::mat4& transform, const TextLayoutSettings& layoutSettings,
                 const glm::vec4& color, int entityIdentifier = -1);
 
+        /// 保留式 UI：元素几何按设计空间写入绘制列表，图片与文本共用一个着色器，交错元素可合批。
+        static void AppendUserInterfaceImage(UserInterfaceDrawElement &element, const glm::mat4 &transform,
+                                             const Ref<Texture2D> &texture, const glm::vec4 &color, int entityID = -1);
+        static void AppendUserInterfaceText(UserInterfaceDrawElement &element, const std::string &string,
+                                            const Ref<Font> &font, const glm::mat4 &transform,
+                                            const TextLayoutSettings &layoutSettings, const glm::vec4 &color,
+                                            int entityID = -1);
+        /// 按需重新拼接批次后提交；designToTarget 并入相机矩阵，不改写缓存的顶点。
+        static void DrawUserInterfaceList(UserInterfaceDrawList &drawList, const glm::mat4 &designToTarget);
+
         static float GetLineWidth();
         static void SetLineWidth(float width);
 
@@ -85,6 +98,12 @@ namespace Himii
             uint32_t QuadCount = 0;
             // Circle 也是用 Quad 批渲染，这里不单独计数
             uint32_t LineVertexCount = 0;
+            uint32_t TextLayoutCacheHits = 0;
+            uint32_t TextLayoutCacheMisses = 0;
+            uint32_t UserInterfaceDrawCalls = 0;
+            // 图片与文本按类型分批时（类型交替即换批）所需的绘制调用数，用于对比合批效果。
+            uint32_t UserInterfaceTypeSeparatedDrawCalls = 0;
+            uint32_t UserInterfaceRebuiltElements = 0;
 
             uint32_t GetTotalVertexCount() const
             {
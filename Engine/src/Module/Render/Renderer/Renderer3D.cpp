@@ -19,11 +19,15 @@
 #include "Module/Render/RenderCore/VertexArray.h"
 #include "Module/Render/Mesh/MeshAsset.h"
 #include "Module/Render/Mesh/MaterialAsset.h"
+#include "Module/Render/Mesh/CompiledMaterial.h"
 #include "Module/Render/Mesh/MaterialSurfaceUtility.h"
+#include "Module/Render/Mesh/MeshletCulling.h"
+#include "Module/Render/Shader/ShaderAsset.h"
 #include "Module/Render/Environment/EnvironmentLightingSystem.h"
 #include "Resource/ResourceSystem.h"
 
 #include <array>
+#include <chrono>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Himii
@@ -90,6 +94,8 @@ namespace Himii
         Ref<Shader> ShadowDepthShader;
         Ref<Shader> MeshShadowDepthShader;
         Ref<Texture2D> WhiteTexture;
+        /// 材质缺失时的回退；持有 GL 资源，随 Renderer3D 一起释放。
+        Ref<CompiledMaterial> DefaultCompiledMaterial;
         bool ApplyDisplayEncoding = false;
 
         Ref<Framebuffer> ShadowFramebuffer;
@@ -192,6 +198,23 @@ namespace Himii
 
     static Renderer3DData s_Data;
 
+    static constexpr const char *CubeShaderPath = "assets/shaders/Renderer3D_Cube.glsl";
+    static constexpr const char *MeshLitShaderPath = "assets/shaders/Renderer3D_MeshLit.glsl";
+    static constexpr const char *MeshUnlitShaderPath = "assets/shaders/Renderer3D_MeshUnlit.glsl";
+    static constexpr const char *ShadowDepthShaderPath = "assets/shaders/Renderer3D_ShadowDepth.glsl";
+    static constexpr const char *MeshShadowDepthShaderPath = "assets/shaders/Renderer3D_MeshShadowDepth.glsl";
+    static constexpr const char *SkyboxShaderPath = "assets/shaders/Skybox.glsl";
+    static constexpr const char *GridShaderPath = "assets/shaders/Grid.glsl";
+
+    std::vector<std::string> Renderer3D::GetShaderPaths()
+    {
+        return {CubeShaderPath, MeshLitShaderPath, MeshUnlitShaderPath, ShadowDepthShaderPath,
+                MeshShadowDepthShaderPath, SkyboxShaderPath, GridShaderPath};
+    }
+
+    /// meshlet 少于该值的子网格整体绘制：剔除收益抵不过额外的 CPU 开销与多段提交。
+    static constexpr uint32_t MeshletCullingMinimumCount = 8u;
+
     static void AddInstance(InstanceData *&ptr, const glm::vec4 &color, float textureIndex, int entityID,
                             float specular, float shininess, const glm::mat4 &transform)
     {
@@ -277,11 +300,11 @@ namespace Himii
         Ref<IndexBuffer> cubeIB = IndexBuffer::Create(cubeIndices, 36);
         s_Data.CubeVAO->SetIndexBuffer(cubeIB);
 
-        s_Data.CubeShader = Shader::Create("assets/shaders/Renderer3D_Cube.glsl");
-        s_Data.MeshLitShader = Shader::Create("assets/shaders/Renderer3D_MeshLit.glsl");
-        s_Data.MeshUnlitShader = Shader::Create("assets/shaders/Renderer3D_MeshUnlit.glsl");
-        s_Data.ShadowDepthShader = Shader::Create("assets/shaders/Renderer3D_ShadowDepth.glsl");
-        s_Data.MeshShadowDepthShader = Shader::Create("assets/shaders/Renderer3D_MeshShadowDepth.glsl");
+        s_Data.CubeShader = Shader::Create(CubeShaderPath);
+        s_Data.MeshLitShader = Shader::Create(MeshLitShaderPath);
+        s_Data.MeshUnlitShader = Shader::Create(MeshUnlitShaderPath);
+        s_Data.ShadowDepthShader = Shader::Create(ShadowDepthShaderPath);
+        s_Data.MeshShadowDepthShader = Shader::Create(MeshShadowDepthShaderPath);
         s_Data.CameraUniformBuffer = UniformBuffer::Create(sizeof(Renderer3DData::CameraData), 0);
         s_Data.MeshMaterialUniformBuffer =
                 UniformBuffer::Create(sizeof(Renderer3DData::MeshLitData), 3);
@@ -438,7 +461,7 @@ namespace Himii
         s_Data.SkyboxVBO->SetData(skyboxVertices, sizeof(skyboxVertices));
         s_Data.SkyboxVBO->SetLayout({{ShaderDataType::Float3, "a_Position"}});
         s_Data.SkyboxVAO->AddVertexBuffer(s_Data.SkyboxVBO);
-        s_Data.SkyboxShader = Shader::Create("assets/shaders/Skybox.glsl");
+        s_Data.SkyboxShader = Shader::Create(SkyboxShaderPath);
         s_Data.SkyboxUniformBuffer = UniformBuffer::Create(sizeof(Renderer3DData::SkyboxData), 1);
 
         s_Data.GridVAO = VertexArray::Create();
@@ -447,7 +470,7 @@ namespace Himii
         s_Data.GridVBO->SetData(gridVertices, sizeof(gridVertices));
         s_Data.GridVBO->SetLayout({{ShaderDataType::Float3, "a_Position"}});
         s_Data.GridVAO->AddVertexBuffer(s_Data.GridVBO);
-        s_Data.GridShader = Shader::Create("assets/shaders/Grid.glsl");
+        s_Data.GridShader = Shader::Create(GridShaderPath);
         s_Data.GridUniformBuffer = UniformBuffer::Create(sizeof(Renderer3DData::GridData), 2);
 
         EnvironmentLightingSystem::Init();
@@ -456,6 +479,7 @@ namespace Himii
     void Renderer3D::Shutdown()
     {
          EnvironmentLightingSystem::Shutdown();
+         s_Data.DefaultCompiledMaterial = nullptr;
          // s_Data.InstanceBufferBase is handled by Scope
     }
 
@@ -658,28 +682,56 @@ namespace Himii
         s_Data.ShadowFramebuffer->BindDepthAttachment(Renderer3DData::ShadowMapTextureSlot);
     }
 
+    void Renderer3D::IssueGeometryDraw(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
+                                       const MeshletDrawRanges *drawRanges)
+    {
+        vertexArray->Bind();
+        if (drawRanges)
+        {
+            RenderCommand::DrawIndexedMultiRange(vertexArray, drawRanges->IndexCounts.data(),
+                                                 drawRanges->FirstIndices.data(),
+                                                 static_cast<uint32_t>(drawRanges->IndexCounts.size()));
+            s_Data.Stats.TotalIndexCount += drawRanges->VisibleIndexCount;
+        }
+        else
+        {
+            RenderCommand::DrawIndexed(vertexArray, indexCount);
+            s_Data.Stats.TotalIndexCount += indexCount;
+        }
+        s_Data.Stats.DrawCalls++;
+    }
+
     void Renderer3D::SubmitMaterialGeometry(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
-                                            const glm::mat4 &transform, AssetHandle materialHandle, int entityID)
+                                            const glm::mat4 &transform, AssetHandle materialHandle,
+                                            CompiledMaterialSlot &materialSlot, int entityID,
+                                            const MeshletDrawRanges *drawRanges)
     {
         if (!vertexArray || indexCount == 0)
             return;
 
         auto assetManager = ResourceSystem::GetAssetManager();
-        const ResolvedMaterialSurface resolvedSurface =
-                ResolveMaterialSurface(assetManager.get(), materialHandle);
-
-        glm::vec4 albedoColor = resolvedSurface.AlbedoColor;
-        Ref<Texture2D> albedoTexture =
+        bool materialRecompiled = false;
+        const CompiledMaterial *resolvedMaterial =
+                ResolveCompiledMaterial(assetManager.get(), materialHandle, materialSlot, &materialRecompiled);
+        const CompiledMaterial &compiledMaterial =
+                resolvedMaterial ? *resolvedMaterial
+                                 : GetOrCompileDefaultMaterial(s_Data.DefaultCompiledMaterial, &materialRecompiled);
+        if (materialRecompiled)
+            s_Data.Stats.MaterialCompilations++;
+
+        const ResolvedMaterialSurface &resolvedSurface = compiledMaterial.Surface;
+        const glm::vec4 &albedoColor = resolvedSurface.AlbedoColor;
+        const Ref<Texture2D> &albedoTexture =
                 resolvedSurface.AlbedoTexture ? resolvedSurface.AlbedoTexture : s_Data.WhiteTexture;
         int useAlbedoTexture = resolvedSurface.AlbedoTexture ? 1 : 0;
         float metallic = resolvedSurface.Metallic;
         float roughness = resolvedSurface.Roughness;
-        Ref<Texture2D> metallicTexture = resolvedSurface.MetallicTexture;
-        Ref<Texture2D> roughnessTexture = resolvedSurface.RoughnessTexture;
+        const Ref<Texture2D> &metallicTexture = resolvedSurface.MetallicTexture;
+        const Ref<Texture2D> &roughnessTexture = resolvedSurface.RoughnessTexture;
         int useMetallicTexture = resolvedSurface.MetallicTexture ? 1 : 0;
         int useRoughnessTexture = resolvedSurface.RoughnessTexture ? 1 : 0;
         int sharedMetallicRoughnessTexture = resolvedSurface.SharedMetallicRoughnessTexture ? 1 : 0;
-        Ref<Texture2D> normalTexture = resolvedSurface.NormalTexture;
+        const Ref<Texture2D> &normalTexture = resolvedSurface.NormalTexture;
         int useNormalTexture = resolvedSurface.NormalTexture ? 1 : 0;
         int normalFlipGreen = resolvedSurface.NormalFlipGreen ? 1 : 0;
         const bool useUnlit = !resolvedSurface.UsesLitPipeline;
@@ -696,10 +748,7 @@ namespace Himii
             s_Data.MeshMaterialUniformBuffer->Bind();
             s_Data.CameraUniformBuffer->Bind();
 
-            vertexArray->Bind();
-            RenderCommand::DrawIndexed(vertexArray, indexCount);
-            s_Data.Stats.DrawCalls++;
-            s_Data.Stats.TotalIndexCount += indexCount;
+            IssueGeometryDraw(vertexArray, indexCount, drawRanges);
             return;
         }
 
@@ -754,16 +803,22 @@ namespace Himii
             normalTexture->Bind(3);
         else
             s_Data.WhiteTexture->Bind(3);
+
+        // 自定义着色器：编译好的参数块与纹理绑定表，直接绑定。
+        if (compiledMaterial.ParameterBuffer)
+            compiledMaterial.ParameterBuffer->Bind();
+        if (!resolvedSurface.ShaderAssetReference || !resolvedSurface.ShaderAssetReference->IsBuiltin)
+        {
+            for (const MaterialTextureBinding &textureBinding : compiledMaterial.TextureBindings)
+                textureBinding.Texture->Bind(textureBinding.Slot);
+        }
         if (!useUnlit)
         {
             BindShadowMapIfAvailable();
             BindImageBasedLightingTexturesIfAvailable();
         }
 
-        vertexArray->Bind();
-        RenderCommand::DrawIndexed(vertexArray, indexCount);
-        s_Data.Stats.DrawCalls++;
-        s_Data.Stats.TotalIndexCount += indexCount;
+        IssueGeometryDraw(vertexArray, indexCount, drawRanges);
     }
 
     void Renderer3D::UploadCameraAndLighting()
@@ -1051,7 +1106,8 @@ namespace Himii
     void Renderer3D::DrawMeshAsset(const Ref<MeshAsset> &meshAsset,
                                    const std::vector<AssetHandle> &materialAssetHandles,
                                    const glm::mat4 &transform,
-                                   int entityID)
+                                   int entityID,
+                                   std::vector<CompiledMaterialSlot> *materialSlots)
     {
         if (!meshAsset)
             return;
@@ -1073,6 +1129,13 @@ namespace Himii
         Flush();
         UploadCameraAndLighting();
 
+        // 阴影 pass 双面投射且相机位置无意义，仅做视锥剔除。
+        const MeshletCullingView cullingView =
+                BuildMeshletCullingView(s_Data.CameraBuffer.ViewProjection, transform,
+                                        glm::vec3(s_Data.CameraBuffer.CameraPosition), !s_Data.IsShadowPass);
+        static MeshletDrawRanges s_DrawRanges;
+        CompiledMaterialSlot transientMaterialSlot;
+
         for (const MeshSubmeshGpu &gpuSubmesh : gpuSubmeshes)
         {
             AssetHandle materialHandle = 0;
@@ -1081,15 +1144,43 @@ namespace Himii
             else if (gpuSubmesh.MaterialSlotIndex < meshAsset->DefaultMaterialHandles.size())
                 materialHandle = meshAsset->DefaultMaterialHandles[gpuSubmesh.MaterialSlotIndex];
 
+            CompiledMaterialSlot *materialSlot = &transientMaterialSlot;
+            if (materialSlots)
+            {
+                if (gpuSubmesh.MaterialSlotIndex >= materialSlots->size())
+                    materialSlots->resize(gpuSubmesh.MaterialSlotIndex + 1);
+                materialSlot = &(*materialSlots)[gpuSubmesh.MaterialSlotIndex];
+            }
+
+            const MeshletDrawRanges *drawRanges = nullptr;
+            if (gpuSubmesh.MeshletCount >= MeshletCullingMinimumCount
+                && gpuSubmesh.MeshletStart + gpuSubmesh.MeshletCount <= meshAsset->Meshlets.size())
+            {
+                const auto cullingStartTime = std::chrono::steady_clock::now();
+                CullMeshlets(meshAsset->Meshlets.data() + gpuSubmesh.MeshletStart, gpuSubmesh.MeshletCount,
+                             gpuSubmesh.IndexStart, cullingView, s_DrawRanges);
+                s_Data.Stats.MeshletCullingMilliseconds +=
+                        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - cullingStartTime)
+                                .count();
+                s_Data.Stats.MeshletsTested += gpuSubmesh.MeshletCount;
+                s_Data.Stats.MeshletsVisible += s_DrawRanges.VisibleMeshletCount;
+
+                if (s_DrawRanges.VisibleMeshletCount == 0)
+                    continue;
+                if (s_DrawRanges.VisibleMeshletCount < gpuSubmesh.MeshletCount)
+                    drawRanges = &s_DrawRanges;
+            }
+
             SubmitMaterialGeometry(gpuSubmesh.VertexArray, gpuSubmesh.IndexCount, transform, materialHandle,
-                                   entityID);
+                                   *materialSlot, entityID, drawRanges);
         }
 
         StartBatch();
     }
 
     void Renderer3D::DrawBuiltinLitMesh(BuiltinLitPrimitive primitive, const glm::mat4 &transform,
-                                        AssetHandle materialHandle, int entityID)
+                                        AssetHandle materialHandle, int entityID,
+                                        CompiledMaterialSlot *materialSlot)
     {
         if (s_Data.IsShadowPass)
         {
@@ -1132,7 +1223,9 @@ namespace Himii
 
         Flush();
         UploadCameraAndLighting();
-        SubmitMaterialGeometry(vertexArray, indexCount, transform, materialHandle, entityID);
+        CompiledMaterialSlot transientMaterialSlot;
+        SubmitMaterialGeometry(vertexArray, indexCount, transform, materialHandle,
+                               materialSlot ? *materialSlot : transientMaterialSlot, entityID);
         StartBatch();
     }
 
@@ -10,6 +10,8 @@ namespace Himii {
 
     class MeshAsset;
     class VertexArray;
+    struct MeshletDrawRanges;
+    struct CompiledMaterialSlot;
 
     inline constexpr uint32_t ScenePointLightCapacity = 8u;
     inline constexpr uint32_t DirectionalCascadedShadowCascadeCount = 4u;
@@ -61,6 +63,8 @@ namespace Himii {
     public:
         static void Init();
         static void Shutdown();
+        /// Init 中按文件创建的着色器，供 Renderer 汇总给着色器预热。
+        static std::vector<std::string> GetShaderPaths();
 
         static void SetSceneLighting(const SceneLightingParameters &parameters);
         static SceneLightingParameters GetSceneLighting();
@@ -101,8 +105,10 @@ namespace Himii {
             Capsule = 3
         };
 
+        /// materialSlot 为调用方持有的材质解析缓存；为空时每次绘制重新查找材质。
         static void DrawBuiltinLitMesh(BuiltinLitPrimitive primitive, const glm::mat4 &transform,
-                                       AssetHandle materialHandle, int entityID = -1);
+                                       AssetHandle materialHandle, int entityID = -1,
+                                       CompiledMaterialSlot *materialSlot = nullptr);
 
         /// 调试用实例化原语（Phong）。场景网格请用 DrawBuiltinLitMesh。
         static void DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec4& color, int entityID = -1);
@@ -125,10 +131,13 @@ namespace Himii {
                               const Ref<Texture2D> &albedoTexture = nullptr);
 
         /// 按 submesh 提交网格；默认 Lit，材质标记 Unlit 时走 Unlit 回退。
+        /// meshlet 足够多的子网格先做视锥 + 法线锥剔除，再以多段索引区间一次绘制。
+        /// materialSlots 按材质槽位缓存解析结果（通常是 MeshComponent::CompiledMaterialSlots），按需扩容。
         static void DrawMeshAsset(const Ref<MeshAsset> &meshAsset,
                                   const std::vector<AssetHandle> &materialAssetHandles,
                                   const glm::mat4 &transform,
-                                  int entityID = -1);
+                                  int entityID = -1,
+                                  std::vector<CompiledMaterialSlot> *materialSlots = nullptr);
 
         // Skybox
         static void DrawSkybox(const Ref<TextureCube> &cubemap, const Camera &camera, const glm::mat4 &cameraTransform);
@@ -150,6 +159,14 @@ namespace Himii {
             uint32_t TotalVertexCount = 0;
             uint32_t TotalIndexCount = 0;
 
+            /// 簇剔除：参与测试 / 通过测试的 meshlet 数与剔除耗时（主线程等待时间）。
+            uint32_t MeshletsTested = 0;
+            uint32_t MeshletsVisible = 0;
+            float MeshletCullingMilliseconds = 0.0f;
+
+            /// 本帧因参数 / 着色器 / 资产变化重编的材质数。
+            uint32_t MaterialCompilations = 0;
+
             uint32_t GetTotalVertexCount() const { return TotalVertexCount; }
             uint32_t GetTotalIndexCount() const { return TotalIndexCount; }
         };
@@ -164,7 +181,11 @@ namespace Himii {
         static void BindShadowMapIfAvailable();
         static float ResolveTextureIndex(const Ref<Texture2D> &albedoTexture);
         static void SubmitMaterialGeometry(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
-                                           const glm::mat4 &transform, AssetHandle materialHandle, int entityID);
+                                           const glm::mat4 &transform, AssetHandle materialHandle,
+                                           CompiledMaterialSlot &materialSlot, int entityID,
+                                           const MeshletDrawRanges *drawRanges = nullptr);
+        static void IssueGeometryDraw(const Ref<VertexArray> &vertexArray, uint32_t indexCount,
+                                      const MeshletDrawRanges *drawRanges);
     };
 
 }
@@ -14,6 +14,8 @@ namespace Himii
 {
     namespace
     {
+        constexpr const char *ResolveShaderPath = "assets/shaders/SceneColorResolve.glsl";
+
         struct SceneColorResolveUniformsData
         {
             glm::vec4 ExposureParameters{1.0f, 0.0f, 0.0f, 0.0f};
@@ -34,6 +36,11 @@ namespace Himii
         }
     }
 
+    std::vector<std::string> SceneColorResolvePass::GetShaderPaths()
+    {
+        return {ResolveShaderPath};
+    }
+
     float SceneColorResolvePass::ClampExposure(float exposure)
     {
         return std::max(exposure, 0.001f);
@@ -45,7 +52,7 @@ namespace Himii
         if (data.Initialized)
             return;
 
-        data.ResolveShader = Shader::Create("assets/shaders/SceneColorResolve.glsl");
+        data.ResolveShader = Shader::Create(ResolveShaderPath);
         data.FullscreenVertexArray = VertexArray::Create();
         data.ResolveUniformBuffer =
                 UniformBuffer::Create(sizeof(SceneColorResolveUniformsData), 5);
@@ -2,6 +2,9 @@
 
 #include "EngineCore/Core/Core.h"
 
+#include <string>
+#include <vector>
+
 namespace Himii
 {
     class Framebuffer;
@@ -12,6 +15,8 @@ namespace Himii
     public:
         static void Init();
         static void Shutdown();
+        /// Init 中按文件创建的着色器。
+        static std::vector<std::string> GetShaderPaths();
 
         /// 采样 sourceFramebuffer 的 color0（RGBA16F），写入当前已绑定的 LDR 目标。
         static void Resolve(const Ref<Framebuffer> &sourceFramebuffer, float exposure);
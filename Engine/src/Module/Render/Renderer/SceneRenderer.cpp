@@ -424,7 +424,7 @@ namespace Himii
             return parameters;
         }
 
-        void DrawBuiltinMesh(const MeshComponent &mesh, const glm::mat4 &worldTransform, int entityIdentifier)
+        void DrawBuiltinMesh(MeshComponent &mesh, const glm::mat4 &worldTransform, int entityIdentifier)
         {
             const AssetHandle materialHandle =
                     mesh.MaterialAssetHandles.empty() ? 0 : mesh.MaterialAssetHandles.front();
@@ -436,7 +436,10 @@ namespace Himii
             else if (mesh.Type == MeshComponent::MeshType::Capsule)
                 primitive = Renderer3D::BuiltinLitPrimitive::Capsule;
 
-            Renderer3D::DrawBuiltinLitMesh(primitive, worldTransform, materialHandle, entityIdentifier);
+            if (mesh.CompiledMaterialSlots.empty())
+                mesh.CompiledMaterialSlots.resize(1);
+            Renderer3D::DrawBuiltinLitMesh(primitive, worldTransform, materialHandle, entityIdentifier,
+                                           &mesh.CompiledMaterialSlots.front());
         }
 
         void DrawSpriteRenderersSorted(Scene *scene, entt::registry &registry, AssetManager *assetManager)
@@ -491,7 +494,7 @@ namespace Himii
                                 return;
                             Ref<MeshAsset> meshAsset = std::static_pointer_cast<MeshAsset>(meshBase);
                             Renderer3D::DrawMeshAsset(meshAsset, mesh.MaterialAssetHandles, worldTransform,
-                                                      (int)entityHandle);
+                                                      (int)entityHandle, &mesh.CompiledMaterialSlots);
                             return;
                         }
 
@@ -1,8 +1,73 @@
 #include "Hepch.h"
 #include "Module/Render/Renderer/TextLayout.h"
+#include "EngineCore/Core/Hash.h"
+
+#include <algorithm>
+#include <unordered_map>
 
 namespace Himii
 {
+    namespace
+    {
+        /// 超出后按最久未使用淘汰一半；常驻 UI 文本通常远少于此。
+        constexpr size_t TextLayoutCacheCapacity = 1024;
+
+        struct TextLayoutCacheEntry
+        {
+            const Font *FontPointer = nullptr;
+            uint64_t FontGlyphGeneration = 0;
+            // Rectangle 模式会回退到默认字体，默认字体新增字形同样使结果过期。
+            const Font *FallbackFontPointer = nullptr;
+            uint64_t FallbackFontGlyphGeneration = 0;
+            TextLayoutMode Mode = TextLayoutMode::Unbounded;
+            TextLayoutSettings Settings;
+            std::string Text;
+            uint64_t LastUse = 0;
+            std::vector<TextLayoutQuad> Quads;
+        };
+
+        struct TextLayoutCacheState
+        {
+            std::unordered_map<uint64_t, TextLayoutCacheEntry> Entries;
+            uint64_t UseCounter = 0;
+        };
+
+        TextLayoutCacheState s_LayoutCache;
+
+        uint64_t ComputeLayoutKey(const Font *font, const std::string &text, TextLayoutMode mode,
+                                  const TextLayoutSettings &settings)
+        {
+            uint64_t hash = HashString(text);
+            hash = HashValue(font, hash);
+            hash = HashValue(mode, hash);
+            if (mode == TextLayoutMode::Rectangle)
+            {
+                hash = HashValue(settings.RectangleSize.x, hash);
+                hash = HashValue(settings.RectangleSize.y, hash);
+                hash = HashValue(settings.FontSize, hash);
+                hash = HashValue(settings.Kerning, hash);
+                hash = HashValue(settings.LineSpacing, hash);
+                hash = HashValue(settings.HorizontalAlignment, hash);
+                hash = HashValue(settings.VerticalAlignment, hash);
+            }
+            return hash;
+        }
+
+        void EvictLeastRecentlyUsed(TextLayoutCacheState &cache)
+        {
+            std::vector<std::pair<uint64_t, uint64_t>> entriesByUse;
+            entriesByUse.reserve(cache.Entries.size());
+            for (const auto &[key, entry] : cache.Entries)
+                entriesByUse.emplace_back(entry.LastUse, key);
+
+            const size_t evictionCount = entriesByUse.size() / 2;
+            std::nth_element(entriesByUse.begin(), entriesByUse.begin() + static_cast<std::ptrdiff_t>(evictionCount),
+                             entriesByUse.end());
+            for (size_t index = 0; index < evictionCount; ++index)
+                cache.Entries.erase(entriesByUse[index].second);
+        }
+    }
+
     bool TextShaper::IsChineseJapaneseKoreanCodePoint(char32_t codePoint)
     {
         return (codePoint >= 0x3400 && codePoint <= 0x4DBF)
@@ -109,4 +174,70 @@ namespace Himii
         glyphRun.Width = cursorX;
         return glyphRun;
     }
+
+    bool AreTextLayoutSettingsEqual(const TextLayoutSettings &left, const TextLayoutSettings &right)
+    {
+        return left.RectangleSize == right.RectangleSize && left.FontSize == right.FontSize
+               && left.Kerning == right.Kerning && left.LineSpacing == right.LineSpacing
+               && left.HorizontalAlignment == right.HorizontalAlignment
+               && left.VerticalAlignment == right.VerticalAlignment;
+    }
+
+    const std::vector<TextLayoutQuad> &TextLayoutCache::GetOrBuild(
+            const Ref<Font> &font, const std::string &text, TextLayoutMode mode,
+            const TextLayoutSettings &settings, const BuildFunction &build, bool *outCacheHit)
+    {
+        const Ref<Font> fallbackFont = mode == TextLayoutMode::Rectangle ? Font::GetDefault() : nullptr;
+        const uint64_t key = ComputeLayoutKey(font.get(), text, mode, settings);
+
+        auto found = s_LayoutCache.Entries.find(key);
+        if (found != s_LayoutCache.Entries.end())
+        {
+            TextLayoutCacheEntry &entry = found->second;
+            const bool isCurrent =
+                    entry.FontPointer == font.get() && entry.FontGlyphGeneration == font->GetGlyphGeneration()
+                    && entry.FallbackFontPointer == fallbackFont.get()
+                    && (!fallbackFont || entry.FallbackFontGlyphGeneration == fallbackFont->GetGlyphGeneration())
+                    && entry.Mode == mode
+                    && (mode != TextLayoutMode::Rectangle || AreTextLayoutSettingsEqual(entry.Settings, settings))
+                    && entry.Text == text;
+            if (isCurrent)
+            {
+                entry.LastUse = ++s_LayoutCache.UseCounter;
+                if (outCacheHit)
+                    *outCacheHit = true;
+                return entry.Quads;
+            }
+        }
+        if (outCacheHit)
+            *outCacheHit = false;
+
+        std::vector<TextLayoutQuad> quads = build();
+        if (found == s_LayoutCache.Entries.end() && s_LayoutCache.Entries.size() >= TextLayoutCacheCapacity)
+            EvictLeastRecentlyUsed(s_LayoutCache);
+
+        // 代数在构建之后读取：构建过程中新生成的字形已计入，下一帧即可命中。
+        TextLayoutCacheEntry &entry = s_LayoutCache.Entries[key];
+        entry.FontPointer = font.get();
+        entry.FontGlyphGeneration = font->GetGlyphGeneration();
+        entry.FallbackFontPointer = fallbackFont.get();
+        entry.FallbackFontGlyphGeneration = fallbackFont ? fallbackFont->GetGlyphGeneration() : 0;
+        entry.Mode = mode;
+        entry.Settings = settings;
+        entry.Text = text;
+        entry.LastUse = ++s_LayoutCache.UseCounter;
+        entry.Quads = std::move(quads);
+        return entry.Quads;
+    }
+
+    void TextLayoutCache::Clear()
+    {
+        s_LayoutCache.Entries.clear();
+        s_LayoutCache.UseCounter = 0;
+    }
+
+    uint32_t TextLayoutCache::GetEntryCount()
+    {
+        return static_cast<uint32_t>(s_LayoutCache.Entries.size());
+    }
 }
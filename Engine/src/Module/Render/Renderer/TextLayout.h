@@ -52,4 +52,40 @@ namespace Himii
         static TextGlyphRun Shape(
                 const Ref<Font> &font, const std::vector<char32_t> &codePoints, float kerning);
     };
+
+    /// 文本局部空间中的字形四边形，换行、对齐与矩形裁剪均已完成；绘制时只需乘变换写入顶点。
+    struct TextLayoutQuad
+    {
+        glm::vec2 Minimum{0.0f};
+        glm::vec2 Maximum{0.0f};
+        glm::vec2 TextureMinimum{0.0f};
+        glm::vec2 TextureMaximum{0.0f};
+        Ref<Texture2D> AtlasTexture;
+    };
+
+    enum class TextLayoutMode : uint8_t
+    {
+        // DrawString：按字体行高排版，不换行不裁剪。
+        Unbounded = 0,
+        // DrawStringInRectangle：按 TextLayoutSettings 自动换行、对齐并裁剪。
+        Rectangle
+    };
+
+    bool AreTextLayoutSettingsEqual(const TextLayoutSettings &left, const TextLayoutSettings &right);
+
+    /// 按 (字体, 字符串, 排版参数, 字形代数) 缓存排版结果；文本不变时每帧只需一次查找。
+    /// 仅在渲染线程使用。
+    class TextLayoutCache
+    {
+    public:
+        using BuildFunction = std::function<std::vector<TextLayoutQuad>()>;
+
+        /// 未命中时调用 build（其中可生成字形），结果按构建后的字形代数存入缓存。
+        /// settings 仅 Rectangle 模式使用。
+        static const std::vector<TextLayoutQuad> &GetOrBuild(
+                const Ref<Font> &font, const std::string &text, TextLayoutMode mode,
+                const TextLayoutSettings &settings, const BuildFunction &build, bool *outCacheHit = nullptr);
+        static void Clear();
+        static uint32_t GetEntryCount();
+    };
 }
@@ -0,0 +1,125 @@
+#include "Hepch.h"
+#include "Module/Render/Renderer/UserInterfaceDrawList.h"
+
+namespace Himii
+{
+    namespace
+    {
+        bool IsSameTexture(const Ref<Texture2D> &left, const Ref<Texture2D> &right)
+        {
+            if (!left || !right)
+                return !left && !right;
+            return left == right || *left == *right;
+        }
+    }
+
+    void UserInterfaceDrawElement::AddQuad(const glm::vec3 (&positions)[4], const glm::vec2 (&textureCoordinates)[4],
+                                           const Ref<Texture2D> &texture, const glm::vec4 &color,
+                                           const glm::vec2 &distanceFieldRange, int entityID)
+    {
+        size_t textureIndex = 0;
+        while (textureIndex < Textures.size() && !IsSameTexture(Textures[textureIndex], texture))
+            ++textureIndex;
+        if (textureIndex == Textures.size())
+            Textures.push_back(texture);
+
+        for (size_t vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+        {
+            UserInterfaceVertex &vertex = Vertices.emplace_back();
+            vertex.Position = positions[vertexIndex];
+            vertex.Color = color;
+            vertex.TexCoord = textureCoordinates[vertexIndex];
+            vertex.TexIndex = static_cast<float>(textureIndex);
+            vertex.DistanceFieldRange = distanceFieldRange;
+            vertex.EntityID = entityID;
+        }
+    }
+
+    void UserInterfaceDrawList::Resize(size_t elementCount)
+    {
+        if (m_Elements.size() == elementCount)
+            return;
+
+        m_Elements.clear();
+        m_Elements.resize(elementCount);
+        m_Dirty = true;
+    }
+
+    UserInterfaceDrawElement &UserInterfaceDrawList::RebuildElement(size_t elementIndex)
+    {
+        UserInterfaceDrawElement &element = m_Elements[elementIndex];
+        element.Vertices.clear();
+        element.Textures.clear();
+        element.Built = true;
+        ++m_PendingRebuiltElementCount;
+        m_Dirty = true;
+        return element;
+    }
+
+    bool UserInterfaceDrawList::Compile(uint32_t maxTextureSlots, uint32_t maxVertices)
+    {
+        m_RebuiltElementCount = m_PendingRebuiltElementCount;
+        m_PendingRebuiltElementCount = 0;
+        if (!m_Dirty)
+            return false;
+
+        HIMII_PROFILE_FUNCTION();
+
+        m_Vertices.clear();
+        m_Batches.clear();
+        m_TypeSeparatedBatchCount = 0;
+
+        // 槽 0 固定为白纹理，纯色图片无需占用额外槽位。
+        const auto startBatch = [&]()
+        {
+            Batch &batch = m_Batches.emplace_back();
+            batch.FirstVertex = static_cast<uint32_t>(m_Vertices.size());
+            batch.TextureSlots.push_back(nullptr);
+        };
+
+        bool hasPreviousQuad = false;
+        bool previousQuadIsText = false;
+        for (const UserInterfaceDrawElement &element : m_Elements)
+        {
+            for (size_t firstVertex = 0; firstVertex + 4 <= element.Vertices.size(); firstVertex += 4)
+            {
+                const UserInterfaceVertex *quadVertices = element.Vertices.data() + firstVertex;
+                const Ref<Texture2D> &texture = element.Textures[static_cast<size_t>(quadVertices[0].TexIndex)];
+
+                const bool isText = quadVertices[0].DistanceFieldRange.x > 0.0f;
+                if (!hasPreviousQuad || isText != previousQuadIsText)
+                    ++m_TypeSeparatedBatchCount;
+                hasPreviousQuad = true;
+                previousQuadIsText = isText;
+
+                if (m_Batches.empty() || m_Batches.back().VertexCount + 4 > maxVertices)
+                    startBatch();
+
+                Batch *batch = &m_Batches.back();
+                size_t slotIndex = 0;
+                while (slotIndex < batch->TextureSlots.size() && !IsSameTexture(batch->TextureSlots[slotIndex], texture))
+                    ++slotIndex;
+                if (slotIndex == batch->TextureSlots.size())
+                {
+                    if (batch->TextureSlots.size() >= maxTextureSlots)
+                    {
+                        startBatch();
+                        batch = &m_Batches.back();
+                    }
+                    slotIndex = batch->TextureSlots.size();
+                    batch->TextureSlots.push_back(texture);
+                }
+
+                for (size_t vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+                {
+                    UserInterfaceVertex &vertex = m_Vertices.emplace_back(quadVertices[vertexIndex]);
+                    vertex.TexIndex = static_cast<float>(slotIndex);
+                }
+                batch->VertexCount += 4;
+            }
+        }
+
+        m_Dirty = false;
+        return true;
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "EngineCore/Core/Core.h"
+#include "Module/Render/RenderCore/Texture.h"
+#include "Module/Render/Renderer/Font.h"
+#include "glm/glm.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Himii
+{
+    /// 图片与 MSDF 文本共用的 UI 顶点；DistanceFieldRange 为 0 时按普通纹理采样，否则按距离场求覆盖率。
+    struct UserInterfaceVertex
+    {
+        glm::vec3 Position;
+        glm::vec4 Color;
+        glm::vec2 TexCoord;
+        float TexIndex;
+        glm::vec2 DistanceFieldRange;
+        int EntityID;
+    };
+
+    /// 生成元素几何时读取的全部组件输入；与上次生成时一致即可直接复用顶点。
+    struct UserInterfaceElementInputs
+    {
+        bool Visible = false;
+        glm::mat4 WorldTransform{1.0f};
+        glm::vec2 Size{0.0f};
+
+        bool HasImage = false;
+        Ref<Texture2D> ImageTexture;
+        glm::vec4 ImageColor{1.0f};
+
+        bool HasText = false;
+        Ref<Font> TextFont;
+        uint64_t TextFontGlyphGeneration = 0;
+        uint64_t FallbackFontGlyphGeneration = 0;
+        std::string Text;
+        TextLayoutSettings TextSettings;
+        glm::vec4 TextColor{1.0f};
+    };
+
+    /// 一个布局节点生成的四边形，坐标在 Canvas 设计空间；顶点 TexIndex 为 Textures 下标，空纹理表示白纹理。
+    struct UserInterfaceDrawElement
+    {
+        UserInterfaceElementInputs Inputs;
+        std::vector<UserInterfaceVertex> Vertices;
+        std::vector<Ref<Texture2D>> Textures;
+        bool Built = false;
+
+        void AddQuad(const glm::vec3 (&positions)[4], const glm::vec2 (&textureCoordinates)[4],
+                     const Ref<Texture2D> &texture, const glm::vec4 &color,
+                     const glm::vec2 &distanceFieldRange, int entityID);
+    };
+
+    /// 每个 Canvas 目标一份的保留式绘制列表：元素只在输入变化时重新生成，
+    /// 有元素变化时才按兄弟顺序重新拼接批次；图片与文本共用纹理槽，交错排列也能合并到同一批。
+    class UserInterfaceDrawList
+    {
+    public:
+        struct Batch
+        {
+            uint32_t FirstVertex = 0;
+            uint32_t VertexCount = 0;
+            /// 下标即着色器纹理槽；空纹理表示白纹理。
+            std::vector<Ref<Texture2D>> TextureSlots;
+        };
+
+        /// 元素与布局节点一一对应；数量变化时全部元素失效。
+        void Resize(size_t elementCount);
+        size_t GetElementCount() const
+        {
+            return m_Elements.size();
+        }
+
+        const UserInterfaceDrawElement &GetElement(size_t elementIndex) const
+        {
+            return m_Elements[elementIndex];
+        }
+        /// 清空元素几何供重新生成，并让下一次 Compile 重新拼接批次。
+        UserInterfaceDrawElement &RebuildElement(size_t elementIndex);
+
+        /// 有元素变化时按顺序重新拼接顶点与批次，返回是否发生了拼接。
+        bool Compile(uint32_t maxTextureSlots, uint32_t maxVertices);
+
+        const std::vector<UserInterfaceVertex> &GetVertices() const
+        {
+            return m_Vertices;
+        }
+        const std::vector<Batch> &GetBatches() const
+        {
+            return m_Batches;
+        }
+        /// 上次 Compile 之后重新生成的元素数。
+        uint32_t GetRebuiltElementCount() const
+        {
+            return m_RebuiltElementCount;
+        }
+        /// 图片与文本分开成批、类型交替即换批时所需的绘制调用数，用于和合并后的批次数对比。
+        uint32_t GetTypeSeparatedBatchCount() const
+        {
+            return m_TypeSeparatedBatchCount;
+        }
+
+    private:
+        std::vector<UserInterfaceDrawElement> m_Elements;
+        std::vector<UserInterfaceVertex> m_Vertices;
+        std::vector<Batch> m_Batches;
+        uint32_t m_RebuiltElementCount = 0;
+        uint32_t m_PendingRebuiltElementCount = 0;
+        uint32_t m_TypeSeparatedBatchCount = 0;
+        bool m_Dirty = true;
+    };
+}
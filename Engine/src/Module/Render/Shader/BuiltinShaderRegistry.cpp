@@ -10,6 +10,9 @@ namespace Himii
 {
     namespace
     {
+        constexpr const char *MeshLitShaderPath = "assets/shaders/Renderer3D_MeshLit.glsl";
+        constexpr const char *MeshUnlitShaderPath = "assets/shaders/Renderer3D_MeshUnlit.glsl";
+
         std::string LoadEngineShaderSource(const char *relativeShaderPath)
         {
             return FileSystem::ReadText(relativeShaderPath);
@@ -143,7 +146,7 @@ namespace Himii
             {
                 meshLitShaderAsset = CreateBuiltinShaderAsset(
                         BuiltinShaderHandles::MeshLit, ShaderPipelineType::SpatialLit,
-                        "assets/shaders/Renderer3D_MeshLit.glsl", GetMeshLitPropertyDefinitions());
+                        MeshLitShaderPath, GetMeshLitPropertyDefinitions());
             }
             return meshLitShaderAsset;
         }
@@ -154,7 +157,7 @@ namespace Himii
             {
                 meshUnlitShaderAsset = CreateBuiltinShaderAsset(
                         BuiltinShaderHandles::MeshUnlit, ShaderPipelineType::SpatialUnlit,
-                        "assets/shaders/Renderer3D_MeshUnlit.glsl", GetMeshUnlitPropertyDefinitions());
+                        MeshUnlitShaderPath, GetMeshUnlitPropertyDefinitions());
             }
             return meshUnlitShaderAsset;
         }
@@ -162,6 +165,11 @@ namespace Himii
         return nullptr;
     }
 
+    std::vector<std::string> BuiltinShaderRegistry::GetBuiltinShaderSourcePaths()
+    {
+        return {MeshLitShaderPath, MeshUnlitShaderPath};
+    }
+
     AssetHandle BuiltinShaderRegistry::GetDefaultLitShaderHandle()
     {
         return BuiltinShaderHandles::MeshLit;
@@ -22,6 +22,8 @@ namespace Himii
         static Ref<ShaderAsset> GetBuiltinShaderAsset(AssetHandle handle);
         static AssetHandle GetDefaultLitShaderHandle();
         static AssetHandle GetDefaultUnlitShaderHandle();
+        /// 内置 Shader 资产的合并源文件（引擎内容相对路径），供预热使用。
+        static std::vector<std::string> GetBuiltinShaderSourcePaths();
         static std::vector<ShaderPropertyDefinition> GetMeshLitPropertyDefinitions();
         static std::vector<ShaderPropertyDefinition> GetMeshUnlitPropertyDefinitions();
         static void ApplyMeshLitDefaults(class MaterialAsset &materialAsset);
@@ -35,9 +35,7 @@ namespace Himii
             return false;
         }
 
-        const std::string shaderName = shaderAsset->SourceFilePath.empty()
-                                               ? "InlineShader"
-                                               : shaderAsset->SourceFilePath.stem().string();
+        const std::string shaderName = GetCompiledShaderName(*shaderAsset);
         Ref<Shader> compiledShader =
                 Shader::Create(shaderName, splitSources.VertexSource, splitSources.FragmentSource);
         if (!compiledShader || !compiledShader->IsValid())
@@ -54,6 +52,11 @@ namespace Himii
         return true;
     }
 
+    std::string ShaderCompilationService::GetCompiledShaderName(const ShaderAsset &shaderAsset)
+    {
+        return shaderAsset.SourceFilePath.empty() ? "InlineShader" : shaderAsset.SourceFilePath.stem().string();
+    }
+
     void ShaderCompilationService::InvalidateCompiledShader(const Ref<ShaderAsset> &shaderAsset)
     {
         if (!shaderAsset)
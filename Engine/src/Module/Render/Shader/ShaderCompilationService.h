@@ -11,5 +11,7 @@ namespace Himii
         static Ref<Shader> GetOrCompileShader(const Ref<ShaderAsset> &shaderAsset);
         static bool TryCompileShaderAsset(const Ref<ShaderAsset> &shaderAsset, Ref<Shader> &outCompiledShader);
         static void InvalidateCompiledShader(const Ref<ShaderAsset> &shaderAsset);
+        /// 编译缓存键使用的着色器名（源文件名主干），预热须与之一致才能命中。
+        static std::string GetCompiledShaderName(const ShaderAsset &shaderAsset);
     };
 }
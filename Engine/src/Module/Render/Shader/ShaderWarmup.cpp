@@ -0,0 +1,205 @@
+#include "Hepch.h"
+#include "Module/Render/Shader/ShaderWarmup.h"
+#include "Module/Render/Shader/BuiltinShaderRegistry.h"
+#include "Module/Render/Shader/ShaderAssetSerializer.h"
+#include "Module/Render/Shader/ShaderCompilationService.h"
+#include "Module/Render/Shader/ShaderSourceUtility.h"
+#include "EngineCore/Core/FileSystem.h"
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Log.h"
+#include "EngineCore/Core/Timer.h"
+#include "Project/Project.h"
+#include "Resource/AssetManager.h"
+
+#include <algorithm>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 一项待编译的着色器：文件型（按 #type 预处理）或合并源码型（Shader 资产）。
+        struct ShaderWarmupItem
+        {
+            std::string Name;
+            bool IsFile = false;
+            std::string VertexSource;
+            std::string FragmentSource;
+        };
+
+        bool AppendCombinedSourceItem(const std::string &name, const std::string &combinedSource,
+                                      std::vector<ShaderWarmupItem> &outItems)
+        {
+            const SplitShaderSources splitSources = SplitCombinedShaderSource(combinedSource);
+            if (!splitSources.IsValid)
+                return false;
+
+            ShaderWarmupItem item;
+            item.Name = name;
+            item.VertexSource = splitSources.VertexSource;
+            item.FragmentSource = splitSources.FragmentSource;
+            outItems.push_back(std::move(item));
+            return true;
+        }
+
+        void AppendEngineShaderItems(const std::vector<std::string> &engineShaderPaths,
+                                     std::vector<ShaderWarmupItem> &outItems)
+        {
+            for (const std::string &shaderPath : engineShaderPaths)
+            {
+                ShaderWarmupItem item;
+                item.Name = shaderPath;
+                item.IsFile = true;
+                outItems.push_back(std::move(item));
+            }
+
+            // 内置材质着色器按资产路径编译，缓存键为文件名主干（与 ShaderCompilationService 一致）。
+            for (const std::string &shaderPath : BuiltinShaderRegistry::GetBuiltinShaderSourcePaths())
+            {
+                const std::string source = FileSystem::ReadText(shaderPath);
+                if (!source.empty())
+                    AppendCombinedSourceItem(std::filesystem::path(shaderPath).stem().string(), source, outItems);
+            }
+        }
+
+        ShaderWarmupReport CompileItemsInParallel(const std::vector<ShaderWarmupItem> &items, bool keepForLink)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            ShaderWarmupReport report;
+            report.Shaders.resize(items.size());
+            report.WorkerCount = JobSystem::GetWorkerCount();
+
+            Timer wallTimer;
+            // 每个着色器一批：单个编译耗时差异大，细粒度领取负载更均衡。
+            JobSystem::ParallelFor(static_cast<uint32_t>(items.size()), 1,
+                                   [&](uint32_t beginIndex, uint32_t endIndex)
+                                   {
+                                       for (uint32_t itemIndex = beginIndex; itemIndex < endIndex; ++itemIndex)
+                                       {
+                                           const ShaderWarmupItem &item = items[itemIndex];
+                                           report.Shaders[itemIndex] =
+                                                   item.IsFile ? Shader::Precompile(item.Name, keepForLink)
+                                                               : Shader::Precompile(item.Name, item.VertexSource,
+                                                                                    item.FragmentSource, keepForLink);
+                                       }
+                                   });
+            report.WallMilliseconds = wallTimer.ElapsedMillis();
+
+            for (const ShaderPrecompileResult &result : report.Shaders)
+            {
+                if (!result.Succeeded)
+                    ++report.FailedCount;
+                else if (result.CacheHit)
+                    ++report.CacheHitCount;
+            }
+            return report;
+        }
+    }
+
+    ShaderWarmupReport ShaderWarmup::WarmupEngineShaders(const std::vector<std::string> &engineShaderPaths)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<ShaderWarmupItem> items;
+        AppendEngineShaderItems(engineShaderPaths, items);
+
+        ShaderWarmupReport report = CompileItemsInParallel(items, true);
+        LogReport("Engine shader warm-up", report);
+        return report;
+    }
+
+    ShaderWarmupReport ShaderWarmup::WarmupProjectShaders(AssetManager &assetManager)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<AssetHandle> shaderHandles;
+        std::vector<ShaderWarmupItem> items;
+        for (const auto &[handle, metadata] : assetManager.GetAssetRegistry())
+        {
+            if (metadata.Type != AssetType::Shader || assetManager.IsAssetLoaded(handle))
+                continue;
+
+            Ref<ShaderAsset> shaderAsset =
+                    ShaderAssetSerializer::Deserialize(Project::GetAssetFileSystemPath(metadata.FilePath));
+            if (!shaderAsset
+                || !AppendCombinedSourceItem(ShaderCompilationService::GetCompiledShaderName(*shaderAsset),
+                                             shaderAsset->SourceCode, items))
+                continue;
+            shaderHandles.push_back(handle);
+        }
+
+        if (items.empty())
+            return {};
+
+        ShaderWarmupReport report = CompileItemsInParallel(items, true);
+
+        // 加载资产会触发 ShaderCompilationService 编译，此时命中预编译结果，只剩链接。
+        Timer linkTimer;
+        for (AssetHandle handle : shaderHandles)
+            assetManager.GetAsset(handle);
+        HIMII_CORE_INFO("Project shader link: {0} shader(s) in {1:.1f} ms", shaderHandles.size(),
+                        linkTimer.ElapsedMillis());
+        Shader::FlushCache();
+
+        LogReport("Project shader warm-up", report);
+        return report;
+    }
+
+    ShaderWarmupReport ShaderWarmup::PrimeShaderCache(const std::vector<std::string> &engineShaderPaths,
+                                                      const std::vector<std::filesystem::path> &projectShaderFiles)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<ShaderWarmupItem> items;
+        AppendEngineShaderItems(engineShaderPaths, items);
+        for (const std::filesystem::path &shaderFile : projectShaderFiles)
+        {
+            Ref<ShaderAsset> shaderAsset = ShaderAssetSerializer::Deserialize(shaderFile);
+            if (shaderAsset)
+                AppendCombinedSourceItem(ShaderCompilationService::GetCompiledShaderName(*shaderAsset),
+                                         shaderAsset->SourceCode, items);
+        }
+
+        ShaderWarmupReport report = CompileItemsInParallel(items, false);
+        Shader::FlushCache();
+        LogReport("Shader cache priming", report);
+        return report;
+    }
+
+    void ShaderWarmup::LogReport(const char *label, const ShaderWarmupReport &report)
+    {
+        float serialMilliseconds = 0.0f;
+        for (const ShaderPrecompileResult &result : report.Shaders)
+            serialMilliseconds += result.CompileMilliseconds;
+
+        HIMII_CORE_INFO("{0}: {1} shader(s), {2} cached, {3} failed, {4:.1f} ms wall / {5:.1f} ms summed on {6} "
+                        "worker(s)",
+                        label, report.Shaders.size(), report.CacheHitCount, report.FailedCount,
+                        report.WallMilliseconds, serialMilliseconds, report.WorkerCount);
+
+        const ShaderCacheStatistics cacheStatistics = Shader::GetCacheStatistics();
+        HIMII_CORE_INFO("Shader cache: {0} entries, {1} KiB, SPIR-V {2} hit / {3} miss, program binary {4} hit / {5} "
+                        "miss / {6} rejected, {7} evicted",
+                        cacheStatistics.EntryCount, cacheStatistics.SizeBytes / 1024, cacheStatistics.BytecodeHits,
+                        cacheStatistics.BytecodeMisses, cacheStatistics.ProgramBinaryHits,
+                        cacheStatistics.ProgramBinaryMisses, cacheStatistics.ProgramBinaryRejected,
+                        cacheStatistics.Evictions);
+
+        std::vector<const ShaderPrecompileResult *> sortedResults;
+        sortedResults.reserve(report.Shaders.size());
+        for (const ShaderPrecompileResult &result : report.Shaders)
+            sortedResults.push_back(&result);
+        std::sort(sortedResults.begin(), sortedResults.end(),
+                  [](const ShaderPrecompileResult *left, const ShaderPrecompileResult *right)
+                  { return left->CompileMilliseconds > right->CompileMilliseconds; });
+
+        for (const ShaderPrecompileResult *result : sortedResults)
+        {
+            if (!result->Succeeded)
+                HIMII_CORE_ERROR("  {0}: FAILED ({1:.1f} ms)", result->Name, result->CompileMilliseconds);
+            else
+                HIMII_CORE_INFO("  {0}: {1:.1f} ms{2}", result->Name, result->CompileMilliseconds,
+                                result->CacheHit ? " (cache)" : "");
+        }
+    }
+}
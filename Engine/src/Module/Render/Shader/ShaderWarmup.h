@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Module/Render/RenderCore/Shader.h"
+#include "EngineCore/Core/Core.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Himii
+{
+    class AssetManager;
+
+    struct ShaderWarmupReport
+    {
+        std::vector<ShaderPrecompileResult> Shaders;
+        float WallMilliseconds = 0.0f;
+        uint32_t WorkerCount = 0;
+        uint32_t CacheHitCount = 0;
+        uint32_t FailedCount = 0;
+    };
+
+    /// 着色器预热：CPU 编译阶段（shaderc / spirv-cross）分发到 JobSystem 并行执行，
+    /// 主线程之后只做 GL 链接。也可在无窗口模式下单独运行，仅填充磁盘缓存。
+    class ShaderWarmup
+    {
+    public:
+        /// Renderer::Init 开头调用：engineShaderPaths（取自 Renderer::GetEngineShaderPaths）与内置材质着色器
+        /// 并行编译，结果留给随后的 Shader::Create。
+        static ShaderWarmupReport WarmupEngineShaders(const std::vector<std::string> &engineShaderPaths);
+
+        /// 项目加载后调用：未加载的 Shader 资产并行编译，再在主线程经 AssetManager 加载并链接。
+        static ShaderWarmupReport WarmupProjectShaders(AssetManager &assetManager);
+
+        /// 无 GL 上下文的缓存预热：引擎着色器 + projectShaderFiles（.hshader），不保留结果。
+        static ShaderWarmupReport PrimeShaderCache(const std::vector<std::string> &engineShaderPaths,
+                                                   const std::vector<std::filesystem::path> &projectShaderFiles);
+
+        static void LogReport(const char *label, const ShaderWarmupReport &report);
+    };
+}
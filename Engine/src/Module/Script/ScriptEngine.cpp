@@ -51,10 +51,7 @@ namespace Himii
     typedef void(CORECLR_DELEGATE_CALLTYPE *OnDestroyInstanceFn)(void *handle);
     typedef void(CORECLR_DELEGATE_CALLTYPE *OnUpdateInstanceFn)(void *handle, float ts);
     typedef void(CORECLR_DELEGATE_CALLTYPE *OnFixedUpdateInstanceFn)(void *handle, float ts);
-    typedef void(CORECLR_DELEGATE_CALLTYPE *OnCollisionEnter2DInstanceFn)(void *handle, Collision2DInterop collision);
-    typedef void(CORECLR_DELEGATE_CALLTYPE *OnCollisionExit2DInstanceFn)(void *handle, uint64_t otherEntityID);
-    typedef void(CORECLR_DELEGATE_CALLTYPE *OnTriggerEnter2DInstanceFn)(void *handle, Collision2DInterop collision);
-    typedef void(CORECLR_DELEGATE_CALLTYPE *OnTriggerExit2DInstanceFn)(void *handle, uint64_t otherEntityID);
+    typedef void(CORECLR_DELEGATE_CALLTYPE *DispatchContact2DEventsFn)(Contact2DEventInterop *events, int count);
     typedef void(CORECLR_DELEGATE_CALLTYPE *OnPointerEventInstanceFn)(void *handle, int eventType);
 
     typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetFieldsFn)(void *handle);
@@ -87,11 +84,10 @@ namespace Himii
     static OnDestroyInstanceFn s_OnDestroyInstance = nullptr;
     static OnUpdateInstanceFn s_OnUpdateInstance = nullptr;
     static OnFixedUpdateInstanceFn s_OnFixedUpdateInstance = nullptr;
-    static OnCollisionEnter2DInstanceFn s_OnCollisionEnter2D = nullptr;
-    static OnCollisionExit2DInstanceFn s_OnCollisionExit2D = nullptr;
-    static OnTriggerEnter2DInstanceFn s_OnTriggerEnter2D = nullptr;
-    static OnTriggerExit2DInstanceFn s_OnTriggerExit2D = nullptr;
+    static DispatchContact2DEventsFn s_DispatchContact2DEvents = nullptr;
     static OnPointerEventInstanceFn s_OnPointerEvent = nullptr;
+    /// 正在分发的碰撞事件数组，托管侧直接读这块内存。
+    static std::vector<Contact2DEventInterop> *s_DispatchingContactEvents = nullptr;
 
     // Reflection
     static GetFieldsFn s_GetFields = nullptr;
@@ -279,20 +275,8 @@ namespace Himii
                                                (void **)&s_OnFixedUpdateInstance);
 
         load_assembly_and_get_function_pointer(filepath.c_str(), STR("HimiiEngine.ScriptManager, ScriptCore"),
-                                               STR("OnCollisionEnter2DInstance"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
-                                               (void **)&s_OnCollisionEnter2D);
-
-        load_assembly_and_get_function_pointer(filepath.c_str(), STR("HimiiEngine.ScriptManager, ScriptCore"),
-                                               STR("OnCollisionExit2DInstance"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
-                                               (void **)&s_OnCollisionExit2D);
-
-        load_assembly_and_get_function_pointer(filepath.c_str(), STR("HimiiEngine.ScriptManager, ScriptCore"),
-                                               STR("OnTriggerEnter2DInstance"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
-                                               (void **)&s_OnTriggerEnter2D);
-
-        load_assembly_and_get_function_pointer(filepath.c_str(), STR("HimiiEngine.ScriptManager, ScriptCore"),
-                                               STR("OnTriggerExit2DInstance"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
-                                               (void **)&s_OnTriggerExit2D);
+                                               STR("DispatchContact2DEvents"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
+                                               (void **)&s_DispatchContact2DEvents);
 
         load_assembly_and_get_function_pointer(filepath.c_str(), STR("HimiiEngine.ScriptManager, ScriptCore"),
                                                STR("OnPointerEventInstance"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
@@ -856,44 +840,28 @@ namespace Himii
             s_SetEntityID(instanceHandle, fieldName.c_str(), entityID);
     }
 
-    void ScriptEngine::OnCollisionEnter2D(Entity entity, Entity other, const Collision2DInterop &collision)
-    {
-        if (!entity || !other || !entity.HasComponent<ScriptComponent>())
-            return;
-
-        void *handle = GetEntityScriptInstance(entity.GetUUID());
-        if (handle && s_OnCollisionEnter2D)
-            s_OnCollisionEnter2D(handle, collision);
-    }
-
-    void ScriptEngine::OnCollisionExit2D(Entity entity, Entity other)
+    void ScriptEngine::DispatchContact2DEvents(std::vector<Contact2DEventInterop> &events)
     {
-        if (!entity || !other || !entity.HasComponent<ScriptComponent>())
+        if (events.empty() || !s_DispatchContact2DEvents)
             return;
 
-        void *handle = GetEntityScriptInstance(entity.GetUUID());
-        if (handle && s_OnCollisionExit2D)
-            s_OnCollisionExit2D(handle, other.GetUUID());
+        HIMII_PROFILE_FUNCTION();
+        s_DispatchingContactEvents = &events;
+        s_DispatchContact2DEvents(events.data(), static_cast<int>(events.size()));
+        s_DispatchingContactEvents = nullptr;
     }
 
-    void ScriptEngine::OnTriggerEnter2D(Entity entity, Entity other, const Collision2DInterop &collision)
+    void ScriptEngine::OnEntityDestroyed(UUID entityID)
     {
-        if (!entity || !other || !entity.HasComponent<ScriptComponent>())
+        if (!s_DispatchingContactEvents)
             return;
 
-        void *handle = GetEntityScriptInstance(entity.GetUUID());
-        if (handle && s_OnTriggerEnter2D)
-            s_OnTriggerEnter2D(handle, collision);
-    }
-
-    void ScriptEngine::OnTriggerExit2D(Entity entity, Entity other)
-    {
-        if (!entity || !other || !entity.HasComponent<ScriptComponent>())
-            return;
-
-        void *handle = GetEntityScriptInstance(entity.GetUUID());
-        if (handle && s_OnTriggerExit2D)
-            s_OnTriggerExit2D(handle, other.GetUUID());
+        // 已分发的记录一并清空也无妨；托管侧每条都重新读 SelfInstance，不再跨边界复核。
+        for (Contact2DEventInterop &contactEvent : *s_DispatchingContactEvents)
+        {
+            if (contactEvent.SelfEntityID == entityID || contactEvent.OtherEntityID == entityID)
+                contactEvent.SelfInstance = nullptr;
+        }
     }
 
     void ScriptEngine::OnPointerEvent(Entity entity, ScriptPointerEventType eventType)
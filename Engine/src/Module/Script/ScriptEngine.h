@@ -5,6 +5,7 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <vector>
 #include "glm/glm.hpp"
 
 #include "EngineCore/Core/Timestep.h"
@@ -81,12 +82,26 @@ namespace Himii {
 
     using ScriptFieldMap = std::unordered_map<std::string, ScriptFieldInstance>;
 
-    /// 与 C# Collision2DInfo 布局一致，供脚本碰撞回调使用。
-    struct Collision2DInterop
+    enum class Contact2DEventKind : int32_t
     {
+        CollisionEnter = 0,
+        CollisionExit = 1,
+        TriggerEnter = 2,
+        TriggerExit = 3
+    };
+
+    /// 与 C# Contact2DEvent 布局一致；一步内的碰撞 / 触发事件连续存放，一次交给托管侧分发。
+    struct Contact2DEventInterop
+    {
+        /// 接收回调的脚本实例（GCHandle），由原生侧预先解析。
+        void *SelfInstance = nullptr;
+        /// 分发期间销毁实体时，原生侧据此和 OtherEntityID 找到引用它的剩余记录并清空 SelfInstance。
+        uint64_t SelfEntityID = 0;
         uint64_t OtherEntityID = 0;
         glm::vec2 Normal{0.0f, 0.0f};
         glm::vec2 Point{0.0f, 0.0f};
+        Contact2DEventKind Kind = Contact2DEventKind::CollisionEnter;
+        int32_t Reserved = 0;
     };
 
 	class ScriptEngine
@@ -138,10 +153,11 @@ namespace Himii {
         static bool GetEntityField(void *instanceHandle, const std::string &fieldName, UUID &outEntityID);
         static void SetEntityField(void *instanceHandle, const std::string &fieldName, UUID entityID);
 
-        static void OnCollisionEnter2D(Entity entity, Entity other, const Collision2DInterop &collision);
-        static void OnCollisionExit2D(Entity entity, Entity other);
-        static void OnTriggerEnter2D(Entity entity, Entity other, const Collision2DInterop &collision);
-        static void OnTriggerExit2D(Entity entity, Entity other);
+        /// 一次托管调用分发全部事件，由 C# 侧逐条转发到脚本的 OnCollision* / OnTrigger*。
+        /// 分发期间回调销毁的实体由 OnEntityDestroyed 在数组里作废，托管侧跳过 SelfInstance 为空的记录。
+        static void DispatchContact2DEvents(std::vector<Contact2DEventInterop> &events);
+        /// 由 Scene::DestroyEntity 调用；不在分发碰撞事件时什么也不做。
+        static void OnEntityDestroyed(UUID entityID);
 
         enum class ScriptPointerEventType
         {
@@ -7,6 +7,7 @@ namespace Himii
     class Scene;
 
     /// World 级脚本 FixedUpdate；注册时挂到 WorldUpdatePhase::ScriptFixedUpdate。
+    /// World 在每个固定步紧跟物理之后调用，timestep 恒为固定步长。
     class ScriptFixedUpdateModule : public IWorldModule
     {
     public:
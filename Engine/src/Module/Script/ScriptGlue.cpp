@@ -19,6 +19,8 @@
 #include "EngineCore/Math/Math.h"
 #include "Module/Render/Renderer/Font.h"
 #include "Module/Audio/SoundPlayerUtility.h"
+#include "Module/Physics/Physics2DWorld.h"
+#include "World/World.h"
 #include <box2d/box2d.h>
 #include <iostream>
 #include <thread>
@@ -501,7 +503,8 @@ namespace Himii {
         Entity entity = scene->GetEntityByUUID(entityID);
         if (!entity || !entity.HasComponent<SoundPlayerComponent>())
             return;
-        SoundPlayerUtility::Play(entity.GetComponent<SoundPlayerComponent>());
+        SoundPlayerUtility::Play(entity.GetComponent<SoundPlayerComponent>(),
+                                 glm::vec3(scene->GetEntityWorldTransformMatrix(entity)[3]));
     }
 
     static void SoundPlayer_Stop(uint64_t entityID)
@@ -545,7 +548,8 @@ namespace Himii {
         Entity entity = scene->GetEntityByUUID(entityID);
         if (!entity || !entity.HasComponent<SoundPlayerComponent>())
             return;
-        SoundPlayerUtility::PlayOneShot(entity.GetComponent<SoundPlayerComponent>(), soundHandle);
+        SoundPlayerUtility::PlayOneShot(entity.GetComponent<SoundPlayerComponent>(), soundHandle,
+                                        glm::vec3(scene->GetEntityWorldTransformMatrix(entity)[3]));
     }
 
     static float SoundPlayer_GetVolume(uint64_t entityID)
@@ -1379,7 +1383,11 @@ namespace Himii {
         auto mapData = GetTileMapDataFromEntity(entity);
         if (!mapData) return;
 
+        if (mapData->GetTile(x, y) == tileID)
+            return;
+
         mapData->SetTile(x, y, tileID);
+        scene->NotifyTilemapTileChanged(mapData.get(), x, y);
     }
 
     static void Tilemap_GetBounds(uint64_t entityID, int32_t* outMinX, int32_t* outMinY,
@@ -1409,6 +1417,63 @@ namespace Himii {
          *outHit = scene->Raycast2D(*start, *end);
     }
 
+    static int32_t Physics2D_GetLayerIndex(const char *layerName)
+    {
+        if (!layerName || !Project::GetActive())
+            return -1;
+        return Project::GetConfig().Physics2DLayers.FindLayer(layerName);
+    }
+
+    /// 批量查询的公共入口：托管侧传入 span 的固定指针，命中直接写进调用方缓冲区，不做额外拷贝。
+    template<typename Command, typename QueryFunction>
+    static void RunPhysics2DQueryBatch(const Command *commands, int32_t commandCount, int32_t mode,
+                                       int32_t maxHitsPerQuery, uint8_t parallel, Physics2DQueryHit *hits,
+                                       uint32_t *hitCounts, QueryFunction queryFunction)
+    {
+        if (!commands || commandCount <= 0 || !hitCounts)
+            return;
+
+        Scene *scene = ScriptEngine::GetSceneContext();
+        Physics2DWorld *physics2DWorld =
+                scene && scene->GetOwningWorld() ? scene->GetOwningWorld()->GetPhysics2DWorld() : nullptr;
+        if (!physics2DWorld)
+        {
+            std::fill_n(hitCounts, commandCount, 0u);
+            return;
+        }
+
+        Physics2DQueryOptions options;
+        options.Mode = mode == static_cast<int32_t>(Physics2DQueryMode::All) ? Physics2DQueryMode::All
+                                                                             : Physics2DQueryMode::Closest;
+        options.MaxHitsPerQuery = static_cast<uint32_t>(std::max(maxHitsPerQuery, 0));
+        options.Parallel = parallel != 0;
+        (physics2DWorld->*queryFunction)(commands, static_cast<uint32_t>(commandCount), options, hits, hitCounts);
+    }
+
+    static void Physics2D_RaycastBatch(const Physics2DRaycastCommand *commands, int32_t commandCount, int32_t mode,
+                                       int32_t maxHitsPerQuery, uint8_t parallel, Physics2DQueryHit *hits,
+                                       uint32_t *hitCounts)
+    {
+        RunPhysics2DQueryBatch(commands, commandCount, mode, maxHitsPerQuery, parallel, hits, hitCounts,
+                               &Physics2DWorld::RaycastBatch);
+    }
+
+    static void Physics2D_ShapeCastBatch(const Physics2DShapeCastCommand *commands, int32_t commandCount,
+                                         int32_t mode, int32_t maxHitsPerQuery, uint8_t parallel,
+                                         Physics2DQueryHit *hits, uint32_t *hitCounts)
+    {
+        RunPhysics2DQueryBatch(commands, commandCount, mode, maxHitsPerQuery, parallel, hits, hitCounts,
+                               &Physics2DWorld::ShapeCastBatch);
+    }
+
+    static void Physics2D_OverlapBatch(const Physics2DOverlapCommand *commands, int32_t commandCount, int32_t mode,
+                                       int32_t maxHitsPerQuery, uint8_t parallel, Physics2DQueryHit *hits,
+                                       uint32_t *hitCounts)
+    {
+        RunPhysics2DQueryBatch(commands, commandCount, mode, maxHitsPerQuery, parallel, hits, hitCounts,
+                               &Physics2DWorld::OverlapBatch);
+    }
+
     static float Time_GetDeltaTime()
     {
         return ScriptEngine::GetScriptDeltaTime();
@@ -2057,6 +2122,11 @@ namespace Himii {
         data.FontAsset_PreloadTextAsync = (void *)&FontAsset_PreloadTextAsync;
         data.FontAsset_WaitForPendingGenerations = (void *)&FontAsset_WaitForPendingGenerations;
 
+        data.Physics2D_GetLayerIndex = (void *)&Physics2D_GetLayerIndex;
+        data.Physics2D_RaycastBatch = (void *)&Physics2D_RaycastBatch;
+        data.Physics2D_ShapeCastBatch = (void *)&Physics2D_ShapeCastBatch;
+        data.Physics2D_OverlapBatch = (void *)&Physics2D_OverlapBatch;
+
         return data;
     }
 }
\ No newline at end of file
@@ -168,6 +168,11 @@ namespace Himii
         void *FontAsset_PreloadCharacters;
         void *FontAsset_PreloadTextAsync;
         void *FontAsset_WaitForPendingGenerations;
+
+        void *Physics2D_GetLayerIndex;
+        void *Physics2D_RaycastBatch;
+        void *Physics2D_ShapeCastBatch;
+        void *Physics2D_OverlapBatch;
     };
 
     class ScriptGlue {
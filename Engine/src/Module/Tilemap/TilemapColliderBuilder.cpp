@@ -5,36 +5,14 @@
 #include "Module/Tilemap/TileMapCoordinateUtility.h"
 
 #include <algorithm>
+#include <bitset>
 #include <sstream>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace Himii
 {
 
     namespace
     {
-        struct CollidableCellKey
-        {
-            int32_t tileX = 0;
-            int32_t tileY = 0;
-
-            bool operator==(const CollidableCellKey& other) const
-            {
-                return tileX == other.tileX && tileY == other.tileY;
-            }
-        };
-
-        struct CollidableCellKeyHash
-        {
-            size_t operator()(const CollidableCellKey& key) const
-            {
-                const uint64_t packedX = static_cast<uint32_t>(key.tileX);
-                const uint64_t packedY = static_cast<uint32_t>(key.tileY);
-                return static_cast<size_t>(packedX ^ (packedY << 16));
-            }
-        };
-
         struct CollidableRectangle
         {
             int32_t minTileX = 0;
@@ -57,13 +35,25 @@ namespace Himii
             }
         }
 
-        void CollectCollidableCells(const TileMapData& mapData,
-                                    const TileSet& tileSet,
-                                    TilemapColliderBuildReport& report,
-                                    std::vector<CollidableCellKey>& outCollidableCells)
+        /// 区块内可碰撞格子的位图，下标与 TileMapChunk::Tiles 一致。
+        using ChunkCellMask = std::bitset<TileMapChunkTileCount>;
+
+        size_t ChunkCellIndex(int32_t localX, int32_t localY)
+        {
+            return static_cast<size_t>(localX) + static_cast<size_t>(localY) * TileMapChunkSize;
+        }
+
+        ChunkCellMask CollectChunkCollidableCells(const TileMapChunk& chunk,
+                                                  const TileSet& tileSet,
+                                                  TilemapColliderBuildReport& report)
         {
-            mapData.ForEachTile([&](int32_t tileX, int32_t tileY, uint16_t tileIdentifier)
+            ChunkCellMask collidableCells;
+            for (size_t index = 0; index < TileMapChunkTileCount; ++index)
             {
+                const uint16_t tileIdentifier = chunk.Tiles[index];
+                if (tileIdentifier == 0)
+                    continue;
+
                 report.paintedCellCount++;
 
                 const RuleTileDefinition* ruleTileDefinition =
@@ -72,97 +62,93 @@ namespace Himii
                 {
                     report.tileDefinitionFoundCount++;
                     if (!ruleTileDefinition->Collidable)
-                        return;
+                        continue;
 
                     report.collidableCellCount++;
-                    outCollidableCells.push_back({tileX, tileY});
-                    return;
+                    collidableCells.set(index);
+                    continue;
                 }
 
                 const TileDef* tileDefinition = tileSet.GetTileDef(tileIdentifier);
                 if (!tileDefinition)
                 {
                     RecordOrphanTileIdentifier(report, tileIdentifier);
-                    return;
+                    continue;
                 }
 
                 report.tileDefinitionFoundCount++;
 
                 if (!tileDefinition->Collidable)
-                    return;
+                    continue;
 
                 report.collidableCellCount++;
-                outCollidableCells.push_back({tileX, tileY});
-            });
-        }
-
-        bool HasCollidableCell(const std::unordered_set<CollidableCellKey, CollidableCellKeyHash>& cells,
-                               int32_t tileX,
-                               int32_t tileY)
-        {
-            return cells.find({tileX, tileY}) != cells.end();
+                collidableCells.set(index);
+            }
+            return collidableCells;
         }
 
-        std::vector<CollidableRectangle> MergeCollidableCellsGreedy(
-                const std::vector<CollidableCellKey>& collidableCells)
+        /// 区块内按行扫描的贪心合并：先向右延伸，再整行向上延伸；结果只依赖格子内容，重建前后一致。
+        std::vector<CollidableRectangle> MergeChunkCellsGreedy(ChunkCellMask remainingCells,
+                                                               const TileMapChunkKey& chunkKey)
         {
-            std::unordered_set<CollidableCellKey, CollidableCellKeyHash> remainingCells(
-                    collidableCells.begin(), collidableCells.end());
-
             std::vector<CollidableRectangle> mergedRectangles;
+            const int32_t originTileX = chunkKey.ChunkX * TileMapChunkSize;
+            const int32_t originTileY = chunkKey.ChunkY * TileMapChunkSize;
 
-            while (!remainingCells.empty())
+            for (int32_t startY = 0; startY < TileMapChunkSize; ++startY)
             {
-                const CollidableCellKey startCell = *remainingCells.begin();
-                const int32_t startTileX = startCell.tileX;
-                const int32_t startTileY = startCell.tileY;
+                for (int32_t startX = 0; startX < TileMapChunkSize; ++startX)
+                {
+                    if (!remainingCells.test(ChunkCellIndex(startX, startY)))
+                        continue;
 
-                int32_t rectangleWidth = 1;
-                while (HasCollidableCell(remainingCells, startTileX + rectangleWidth, startTileY))
-                    rectangleWidth++;
+                    int32_t rectangleWidth = 1;
+                    while (startX + rectangleWidth < TileMapChunkSize
+                           && remainingCells.test(ChunkCellIndex(startX + rectangleWidth, startY)))
+                        rectangleWidth++;
 
-                int32_t rectangleHeight = 1;
-                bool canGrowHeight = true;
-                while (canGrowHeight)
-                {
-                    for (int32_t offsetX = 0; offsetX < rectangleWidth; ++offsetX)
+                    int32_t rectangleHeight = 1;
+                    bool canGrowHeight = true;
+                    while (canGrowHeight && startY + rectangleHeight < TileMapChunkSize)
                     {
-                        if (!HasCollidableCell(remainingCells, startTileX + offsetX,
-                                               startTileY + rectangleHeight))
+                        for (int32_t offsetX = 0; offsetX < rectangleWidth; ++offsetX)
                         {
-                            canGrowHeight = false;
-                            break;
+                            if (!remainingCells.test(ChunkCellIndex(startX + offsetX, startY + rectangleHeight)))
+                            {
+                                canGrowHeight = false;
+                                break;
+                            }
                         }
+                        if (canGrowHeight)
+                            rectangleHeight++;
                     }
-                    if (canGrowHeight)
-                        rectangleHeight++;
-                }
 
-                for (int32_t offsetY = 0; offsetY < rectangleHeight; ++offsetY)
-                {
-                    for (int32_t offsetX = 0; offsetX < rectangleWidth; ++offsetX)
-                        remainingCells.erase({startTileX + offsetX, startTileY + offsetY});
-                }
+                    for (int32_t offsetY = 0; offsetY < rectangleHeight; ++offsetY)
+                    {
+                        for (int32_t offsetX = 0; offsetX < rectangleWidth; ++offsetX)
+                            remainingCells.reset(ChunkCellIndex(startX + offsetX, startY + offsetY));
+                    }
 
-                CollidableRectangle rectangle;
-                rectangle.minTileX = startTileX;
-                rectangle.minTileY = startTileY;
-                rectangle.maxTileX = startTileX + rectangleWidth - 1;
-                rectangle.maxTileY = startTileY + rectangleHeight - 1;
-                mergedRectangles.push_back(rectangle);
+                    CollidableRectangle rectangle;
+                    rectangle.minTileX = originTileX + startX;
+                    rectangle.minTileY = originTileY + startY;
+                    rectangle.maxTileX = originTileX + startX + rectangleWidth - 1;
+                    rectangle.maxTileY = originTileY + startY + rectangleHeight - 1;
+                    mergedRectangles.push_back(rectangle);
+                }
             }
 
             return mergedRectangles;
         }
 
-        uint32_t CreateShapeForTileCell(b2BodyId bodyId,
-                                        const TransformComponent& transform,
-                                        float cellSize,
-                                        float halfWidth,
-                                        float halfHeight,
-                                        const b2Rot& shapeRotation,
-                                        int32_t tileX,
-                                        int32_t tileY)
+        b2ShapeId CreateShapeForTileCell(b2BodyId bodyId,
+                                         const TransformComponent& transform,
+                                         float cellSize,
+                                         float halfWidth,
+                                         float halfHeight,
+                                         const b2Rot& shapeRotation,
+                                         int32_t tileX,
+                                         int32_t tileY)
         {
             b2ShapeDef shapeDef = b2DefaultShapeDef();
             shapeDef.enableContactEvents = true;
@@ -174,15 +160,14 @@ namespace Himii
                     {tileCenter.x * transform.Scale.x, tileCenter.y * transform.Scale.y},
                     shapeRotation);
 
-            const b2ShapeId shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
-            return b2Shape_IsValid(shapeId) ? 1u : 0u;
+            return b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
         }
 
-        uint32_t CreateShapeForMergedRectangle(b2BodyId bodyId,
-                                               const TransformComponent& transform,
-                                               float cellSize,
-                                               const b2Rot& shapeRotation,
-                                               const CollidableRectangle& rectangle)
+        b2ShapeId CreateShapeForMergedRectangle(b2BodyId bodyId,
+                                                const TransformComponent& transform,
+                                                float cellSize,
+                                                const b2Rot& shapeRotation,
+                                                const CollidableRectangle& rectangle)
         {
             const float halfWidth =
                     static_cast<float>(rectangle.maxTileX - rectangle.minTileX + 1)
@@ -206,8 +191,7 @@ namespace Himii
                     {localCenter.x * transform.Scale.x, localCenter.y * transform.Scale.y},
                     shapeRotation);
 
-            const b2ShapeId shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
-            return b2Shape_IsValid(shapeId) ? 1u : 0u;
+            return b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
         }
     }
 
@@ -226,66 +210,12 @@ namespace Himii
             const TileSet& tileSet)
     {
         TilemapColliderBuildReport report;
-        std::vector<CollidableCellKey> collidableCells;
-        CollectCollidableCells(mapData, tileSet, report, collidableCells);
+        for (const auto& [chunkKey, chunk] : mapData.GetChunks())
+            CollectChunkCollidableCells(chunk, tileSet, report);
         report.shapeCreatedCount = report.collidableCellCount;
         return report;
     }
 
-    TilemapColliderBuildReport TilemapColliderBuilder::CreateColliderShapes(
-            b2WorldId world,
-            const TransformComponent& transform,
-            const TileMapData& mapData,
-            const TileSet& tileSet,
-            void* bodyUserData,
-            bool mergeAdjacentCells)
-    {
-        TilemapColliderBuildReport report;
-
-        const float cellSize = mapData.GetCellSize();
-        if (cellSize <= 0.0f)
-            return report;
-
-        b2BodyDef bodyDef = b2DefaultBodyDef();
-        bodyDef.type = b2_staticBody;
-        bodyDef.position = {transform.Position.x, transform.Position.y};
-        bodyDef.rotation = b2MakeRot(transform.Rotation.z);
-        bodyDef.userData = bodyUserData;
-
-        const b2BodyId bodyId = b2CreateBody(world, &bodyDef);
-        if (!b2Body_IsValid(bodyId))
-            return report;
-
-        const float halfWidth = cellSize * transform.Scale.x * 0.5f;
-        const float halfHeight = cellSize * transform.Scale.y * 0.5f;
-        const b2Rot shapeRotation = b2MakeRot(0.0f);
-
-        std::vector<CollidableCellKey> collidableCells;
-        CollectCollidableCells(mapData, tileSet, report, collidableCells);
-
-        if (mergeAdjacentCells)
-        {
-            const std::vector<CollidableRectangle> mergedRectangles =
-                    MergeCollidableCellsGreedy(collidableCells);
-            for (const CollidableRectangle& rectangle : mergedRectangles)
-            {
-                report.shapeCreatedCount += CreateShapeForMergedRectangle(
-                        bodyId, transform, cellSize, shapeRotation, rectangle);
-            }
-        }
-        else
-        {
-            for (const CollidableCellKey& cell : collidableCells)
-            {
-                report.shapeCreatedCount += CreateShapeForTileCell(
-                        bodyId, transform, cellSize, halfWidth, halfHeight, shapeRotation,
-                        cell.tileX, cell.tileY);
-            }
-        }
-
-        return report;
-    }
-
     void TilemapColliderBuilder::LogBuildReport(const std::string& entityName,
                                                 const TilemapColliderBuildReport& report)
     {
@@ -334,4 +264,147 @@ namespace Himii
         }
     }
 
+    TilemapColliderBuildReport TilemapColliderBody::Create(b2WorldId world,
+                                                           const TransformComponent& transform,
+                                                           const Ref<TileMapData>& mapData,
+                                                           const Ref<TileSet>& tileSet,
+                                                           void* bodyUserData,
+                                                           bool mergeAdjacentCells)
+    {
+        Destroy();
+
+        TilemapColliderBuildReport report;
+        if (!mapData || !tileSet || mapData->GetCellSize() <= 0.0f)
+            return report;
+
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_staticBody;
+        bodyDef.position = {transform.Position.x, transform.Position.y};
+        bodyDef.rotation = b2MakeRot(transform.Rotation.z);
+        bodyDef.userData = bodyUserData;
+
+        m_BodyId = b2CreateBody(world, &bodyDef);
+        if (!b2Body_IsValid(m_BodyId))
+            return report;
+
+        m_MapData = mapData;
+        m_TileSet = tileSet;
+        m_Transform = transform;
+        m_MergeAdjacentCells = mergeAdjacentCells;
+
+        for (const auto& [chunkKey, chunk] : m_MapData->GetChunks())
+            BuildChunkShapes(chunkKey, chunk, report);
+
+        return report;
+    }
+
+    void TilemapColliderBody::Destroy()
+    {
+        if (b2Body_IsValid(m_BodyId))
+            b2DestroyBody(m_BodyId);
+
+        m_BodyId = {};
+        m_MapData.reset();
+        m_TileSet.reset();
+        m_ChunkShapes.clear();
+        m_DirtyChunks.clear();
+    }
+
+    void TilemapColliderBody::MarkTileDirty(int32_t tileX, int32_t tileY)
+    {
+        const TileMapChunkKey chunkKey = TileMapChunkKeyFromTile(tileX, tileY);
+        if (std::find(m_DirtyChunks.begin(), m_DirtyChunks.end(), chunkKey) == m_DirtyChunks.end())
+            m_DirtyChunks.push_back(chunkKey);
+    }
+
+    uint32_t TilemapColliderBody::RebuildDirtyChunks()
+    {
+        if (m_DirtyChunks.empty())
+            return 0;
+
+        HIMII_PROFILE_FUNCTION();
+
+        const uint32_t rebuiltChunkCount = static_cast<uint32_t>(m_DirtyChunks.size());
+        if (!b2Body_IsValid(m_BodyId) || !m_MapData || !m_TileSet)
+        {
+            m_DirtyChunks.clear();
+            return 0;
+        }
+
+        const auto& chunks = m_MapData->GetChunks();
+        TilemapColliderBuildReport report;
+        for (const TileMapChunkKey& chunkKey : m_DirtyChunks)
+        {
+            // 静态刚体没有质量，销毁形状时无需重算质量。
+            auto shapesIterator = m_ChunkShapes.find(chunkKey);
+            if (shapesIterator != m_ChunkShapes.end())
+            {
+                for (b2ShapeId shapeId : shapesIterator->second)
+                {
+                    if (b2Shape_IsValid(shapeId))
+                        b2DestroyShape(shapeId, false);
+                }
+                m_ChunkShapes.erase(shapesIterator);
+            }
+
+            // 区块被清空后会从地图中移除，此时只需删除旧形状。
+            auto chunkIterator = chunks.find(chunkKey);
+            if (chunkIterator != chunks.end())
+                BuildChunkShapes(chunkKey, chunkIterator->second, report);
+        }
+
+        m_DirtyChunks.clear();
+        return rebuiltChunkCount;
+    }
+
+    uint32_t TilemapColliderBody::GetShapeCount() const
+    {
+        uint32_t shapeCount = 0;
+        for (const auto& [chunkKey, shapes] : m_ChunkShapes)
+            shapeCount += static_cast<uint32_t>(shapes.size());
+        return shapeCount;
+    }
+
+    void TilemapColliderBody::BuildChunkShapes(const TileMapChunkKey& chunkKey,
+                                               const TileMapChunk& chunk,
+                                               TilemapColliderBuildReport& report)
+    {
+        const ChunkCellMask collidableCells = CollectChunkCollidableCells(chunk, *m_TileSet, report);
+        if (collidableCells.none())
+            return;
+
+        const float cellSize = m_MapData->GetCellSize();
+        const b2Rot shapeRotation = b2MakeRot(0.0f);
+        std::vector<b2ShapeId>& shapes = m_ChunkShapes[chunkKey];
+
+        const auto appendShape = [&](b2ShapeId shapeId)
+        {
+            if (!b2Shape_IsValid(shapeId))
+                return;
+            shapes.push_back(shapeId);
+            report.shapeCreatedCount++;
+        };
+
+        if (m_MergeAdjacentCells)
+        {
+            for (const CollidableRectangle& rectangle : MergeChunkCellsGreedy(collidableCells, chunkKey))
+                appendShape(CreateShapeForMergedRectangle(m_BodyId, m_Transform, cellSize, shapeRotation, rectangle));
+            return;
+        }
+
+        const float halfWidth = cellSize * m_Transform.Scale.x * 0.5f;
+        const float halfHeight = cellSize * m_Transform.Scale.y * 0.5f;
+        for (int32_t localY = 0; localY < TileMapChunkSize; ++localY)
+        {
+            for (int32_t localX = 0; localX < TileMapChunkSize; ++localX)
+            {
+                if (!collidableCells.test(ChunkCellIndex(localX, localY)))
+                    continue;
+                appendShape(CreateShapeForTileCell(m_BodyId, m_Transform, cellSize, halfWidth, halfHeight,
+                                                   shapeRotation, chunkKey.ChunkX * TileMapChunkSize + localX,
+                                                   chunkKey.ChunkY * TileMapChunkSize + localY));
+            }
+        }
+    }
+
 } // namespace Himii
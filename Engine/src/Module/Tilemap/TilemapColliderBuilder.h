@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Himii
@@ -31,16 +32,51 @@ namespace Himii
         static TilemapColliderBuildReport AnalyzeCollidableCells(const TileMapData& mapData,
                                                                    const TileSet& tileSet);
 
-        static TilemapColliderBuildReport CreateColliderShapes(
-                b2WorldId world,
-                const TransformComponent& transform,
-                const TileMapData& mapData,
-                const TileSet& tileSet,
-                void* bodyUserData,
-                bool mergeAdjacentCells);
-
         static void LogBuildReport(const std::string& entityName,
                                    const TilemapColliderBuildReport& report);
     };
 
+    /// 一个瓦片地图实体的碰撞体：单个静态刚体，形状按 TileMapChunk 分组，合并矩形不跨区块。
+    /// 瓦片修改只标记所在区块，RebuildDirtyChunks 时仅销毁并重建这些区块的形状。
+    class TilemapColliderBody
+    {
+    public:
+        TilemapColliderBuildReport Create(b2WorldId world,
+                                          const TransformComponent& transform,
+                                          const Ref<TileMapData>& mapData,
+                                          const Ref<TileSet>& tileSet,
+                                          void* bodyUserData,
+                                          bool mergeAdjacentCells);
+        /// 销毁刚体；所属 Box2D 世界已销毁时只清空记录。
+        void Destroy();
+
+        const Ref<TileMapData>& GetMapData() const
+        {
+            return m_MapData;
+        }
+
+        void MarkTileDirty(int32_t tileX, int32_t tileY);
+        bool HasDirtyChunks() const
+        {
+            return !m_DirtyChunks.empty();
+        }
+        /// 重建所有被标记的区块，返回重建的区块数。
+        uint32_t RebuildDirtyChunks();
+
+        uint32_t GetShapeCount() const;
+
+    private:
+        void BuildChunkShapes(const TileMapChunkKey& chunkKey, const TileMapChunk& chunk,
+                              TilemapColliderBuildReport& report);
+
+        b2BodyId m_BodyId{};
+        Ref<TileMapData> m_MapData;
+        Ref<TileSet> m_TileSet;
+        TransformComponent m_Transform;
+        bool m_MergeAdjacentCells = false;
+
+        std::unordered_map<TileMapChunkKey, std::vector<b2ShapeId>, TileMapChunkKeyHash> m_ChunkShapes;
+        std::vector<TileMapChunkKey> m_DirtyChunks;
+    };
+
 } // namespace Himii
@@ -6,11 +6,12 @@
 #include "Module/Render/Renderer/Renderer2D.h"
 #include "Module/Render/RHI/RenderCommand.h"
 #include "Module/Render/Renderer/Font.h"
+#include "Module/Render/Renderer/TextLayout.h"
 #include "Module/Script/ScriptEngine.h"
 #include "EngineCore/Core/Log.h"
 
+#include <algorithm>
 #include <cmath>
-#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <glm/gtc/matrix_transform.hpp>
@@ -52,41 +53,23 @@ namespace Himii
     Entity Scene::HitTestUserInterfaceButton(
             float targetWidth, float targetHeight, const glm::vec2 &pointerInTargetPixels) const
     {
-        Entity canvasEntity = FindCanvasEntity();
-        if (!canvasEntity)
+        const UserInterfaceLayoutTarget *layoutTarget = UpdateUserInterfaceLayout(targetWidth, targetHeight);
+        if (!layoutTarget)
             return {};
 
         const glm::mat4 designToTargetMatrix = GetCanvasToScreenMatrix(targetWidth, targetHeight);
-        std::vector<Entity> buttonsInDrawOrder;
 
-        std::function<void(Entity)> collectSubtree;
-        collectSubtree = [&](Entity entity)
+        // 节点表即绘制顺序，逆序遍历使最上层的按钮优先命中；下标 0 为 Canvas 根节点。
+        for (size_t nodeIndex = m_UserInterfaceLayoutNodes.size(); nodeIndex-- > 1;)
         {
-            if (!entity || !entity.HasComponent<RectTransformComponent>())
-                return;
-
-            if (entity.HasComponent<UIButtonComponent>()
-                && entity.GetComponent<UIButtonComponent>().Interactable)
-            {
-                buttonsInDrawOrder.push_back(entity);
-            }
-
-            for (UUID childIdentifier : GetEntityChildren(entity))
-                collectSubtree(GetEntityByUUID(childIdentifier));
-        };
-
-        for (UUID childIdentifier : GetEntityChildren(canvasEntity))
-            collectSubtree(GetEntityByUUID(childIdentifier));
+            const entt::entity entityHandle = m_UserInterfaceLayoutNodes[nodeIndex].EntityHandle;
+            const auto *button = m_Registry.try_get<UIButtonComponent>(entityHandle);
+            if (!button || !button->Interactable)
+                continue;
 
-        for (auto iterator = buttonsInDrawOrder.rbegin(); iterator != buttonsInDrawOrder.rend();
-             ++iterator)
-        {
-            Entity entity = *iterator;
-            const ResolvedRectTransform resolvedRectTransform =
-                    ResolveRectTransform(entity, targetWidth, targetHeight);
             if (IsPointInsideResolvedRect(
-                        resolvedRectTransform, designToTargetMatrix, pointerInTargetPixels))
-                return entity;
+                        layoutTarget->ResolvedNodes[nodeIndex], designToTargetMatrix, pointerInTargetPixels))
+                return Entity{entityHandle, const_cast<Scene *>(this)};
         }
 
         return {};
@@ -228,14 +211,18 @@ namespace Himii
             std::string CombinedText;
         };
 
+        if (!RefreshUserInterfaceLayoutNodes())
+            return;
+
         std::unordered_map<Font*, FontTextCollection> textByFont;
-        auto textView = m_Registry.view<RectTransformComponent, UITextComponent>();
-        for (entt::entity entityHandle : textView)
+        for (const UserInterfaceLayoutNode &node : m_UserInterfaceLayoutNodes)
         {
-            Entity entity{entityHandle, this};
-            if (!IsEntityUnderCanvas(entity))
+            if (!m_Registry.valid(node.EntityHandle))
                 continue;
-            const auto& text = entity.GetComponent<UITextComponent>();
+            const auto *textComponent = m_Registry.try_get<UITextComponent>(node.EntityHandle);
+            if (!textComponent)
+                continue;
+            const auto& text = *textComponent;
             Ref<Font> fontAsset = text.FontAsset ? text.FontAsset : Font::GetDefault();
             if (!fontAsset)
                 continue;
@@ -255,91 +242,106 @@ namespace Himii
     void Scene::RenderUIElements(
             const glm::mat4& designToTargetMatrix, float targetWidth, float targetHeight)
     {
-        Entity canvasEntity = FindCanvasEntity();
-        if (!canvasEntity)
+        UserInterfaceLayoutTarget *layoutTarget = UpdateUserInterfaceLayout(targetWidth, targetHeight);
+        if (!layoutTarget)
             return;
 
-        enum class UserInterfacePrimitiveType
-        {
-            None = 0,
-            Image,
-            Text
-        };
-        UserInterfacePrimitiveType lastPrimitiveType = UserInterfacePrimitiveType::None;
-        const auto flushIfPrimitiveTypeChanged =
-                [&](UserInterfacePrimitiveType nextPrimitiveType)
-        {
-            if (lastPrimitiveType != UserInterfacePrimitiveType::None
-                && lastPrimitiveType != nextPrimitiveType)
-            {
-                // 有序命令流：相邻不同类型批次强制分隔，保持 SiblingIndex 顺序。
-                Renderer2D::FlushCurrentBatch();
-            }
-            lastPrimitiveType = nextPrimitiveType;
-        };
+        UserInterfaceDrawList &drawList = layoutTarget->DrawList;
+        const size_t nodeCount = m_UserInterfaceLayoutNodes.size();
+        drawList.Resize(nodeCount);
 
-        std::function<void(Entity)> drawUserInterfaceSubtree;
-        drawUserInterfaceSubtree = [&](Entity entity)
-        {
-            if (!entity || !entity.HasComponent<RectTransformComponent>())
-                return;
+        const Ref<Font> defaultFont = Font::GetDefault();
+        const uint64_t fallbackGlyphGeneration = defaultFont ? defaultFont->GetGlyphGeneration() : 0;
 
-            const ResolvedRectTransform resolvedRectTransform =
-                    ResolveRectTransform(entity, targetWidth, targetHeight);
-            if (!resolvedRectTransform.Valid)
-                return;
+        // 下标 0 为 Canvas 根节点，本身不绘制；元素输入与上次生成时一致就沿用缓存的顶点。
+        for (size_t nodeIndex = 1; nodeIndex < nodeCount; ++nodeIndex)
+        {
+            const ResolvedRectTransform &resolvedRectTransform = layoutTarget->ResolvedNodes[nodeIndex];
+            const entt::entity entityHandle = m_UserInterfaceLayoutNodes[nodeIndex].EntityHandle;
+            const bool visible = resolvedRectTransform.Valid;
 
-            if (entity.HasComponent<UIImageComponent>())
+            const auto *image = visible ? m_Registry.try_get<UIImageComponent>(entityHandle) : nullptr;
+            glm::vec4 imageColor{1.0f};
+            if (image)
             {
-                flushIfPrimitiveTypeChanged(UserInterfacePrimitiveType::Image);
-                auto& image = entity.GetComponent<UIImageComponent>();
-                const glm::mat4 drawTransform = designToTargetMatrix
-                        * resolvedRectTransform.WorldTransform
-                        * glm::scale(glm::mat4(1.0f),
-                                     glm::vec3(resolvedRectTransform.Size, 1.0f));
-
-                glm::vec4 drawColor = image.Color;
-                if (entity.HasComponent<UIButtonComponent>())
-                    drawColor = entity.GetComponent<UIButtonComponent>().EvaluateEffectiveColor(
-                            image.Color);
-
-                if (image.Texture)
-                    Renderer2D::DrawQuad(
-                            drawTransform, image.Texture, 1.0f, drawColor, (int)(entt::entity)entity);
-                else
-                    Renderer2D::DrawQuad(drawTransform, drawColor, (int)(entt::entity)entity);
+                const auto *button = m_Registry.try_get<UIButtonComponent>(entityHandle);
+                imageColor = button ? button->EvaluateEffectiveColor(image->Color) : image->Color;
             }
 
-            if (entity.HasComponent<UITextComponent>())
+            const auto *text = visible ? m_Registry.try_get<UITextComponent>(entityHandle) : nullptr;
+            Ref<Font> fontAsset;
+            TextLayoutSettings layoutSettings;
+            if (text)
             {
-                flushIfPrimitiveTypeChanged(UserInterfacePrimitiveType::Text);
-                auto& text = entity.GetComponent<UITextComponent>();
-                Ref<Font> fontAsset = text.FontAsset ? text.FontAsset : Font::GetDefault();
+                fontAsset = text->FontAsset ? text->FontAsset : defaultFont;
                 if (fontAsset)
-                {
                     fontAsset->ProcessCompletedGenerations();
-                    const glm::mat4 drawTransform = designToTargetMatrix
-                            * resolvedRectTransform.WorldTransform;
-                    TextLayoutSettings layoutSettings;
-                    layoutSettings.RectangleSize = resolvedRectTransform.Size;
-                    layoutSettings.FontSize = std::max(text.FontSize, 1.0f);
-                    layoutSettings.Kerning = text.Kerning;
-                    layoutSettings.LineSpacing = text.LineSpacing;
-                    layoutSettings.HorizontalAlignment = text.HorizontalAlignment;
-                    layoutSettings.VerticalAlignment = text.VerticalAlignment;
-                    Renderer2D::DrawStringInRectangle(
-                            text.TextString, fontAsset, drawTransform,
-                            layoutSettings, text.Color,
-                            (int)(entt::entity)entity);
-                }
+                layoutSettings.RectangleSize = resolvedRectTransform.Size;
+                layoutSettings.FontSize = std::max(text->FontSize, 1.0f);
+                layoutSettings.Kerning = text->Kerning;
+                layoutSettings.LineSpacing = text->LineSpacing;
+                layoutSettings.HorizontalAlignment = text->HorizontalAlignment;
+                layoutSettings.VerticalAlignment = text->VerticalAlignment;
             }
+            const bool hasText = text && fontAsset;
+
+            const UserInterfaceDrawElement &cachedElement = drawList.GetElement(nodeIndex);
+            const UserInterfaceElementInputs &cached = cachedElement.Inputs;
+            const bool elementIsCurrent =
+                    cachedElement.Built && cached.Visible == visible
+                    && (!visible
+                        || (cached.WorldTransform == resolvedRectTransform.WorldTransform
+                            && cached.Size == resolvedRectTransform.Size))
+                    && cached.HasImage == (image != nullptr)
+                    && (!image || (cached.ImageTexture == image->Texture && cached.ImageColor == imageColor))
+                    && cached.HasText == hasText
+                    && (!hasText
+                        || (cached.TextFont == fontAsset
+                            && cached.TextFontGlyphGeneration == fontAsset->GetGlyphGeneration()
+                            && cached.FallbackFontGlyphGeneration == fallbackGlyphGeneration
+                            && cached.TextColor == text->Color
+                            && AreTextLayoutSettingsEqual(cached.TextSettings, layoutSettings)
+                            && cached.Text == text->TextString));
+            if (elementIsCurrent)
+                continue;
 
-            for (UUID childIdentifier : GetEntityChildren(entity))
-                drawUserInterfaceSubtree(GetEntityByUUID(childIdentifier));
-        };
+            UserInterfaceDrawElement &element = drawList.RebuildElement(nodeIndex);
+            UserInterfaceElementInputs &inputs = element.Inputs;
+            inputs = {};
+            inputs.Visible = visible;
+            inputs.WorldTransform = resolvedRectTransform.WorldTransform;
+            inputs.Size = resolvedRectTransform.Size;
+            const int entityIdentifier = (int)entityHandle;
+
+            if (image)
+            {
+                inputs.HasImage = true;
+                inputs.ImageTexture = image->Texture;
+                inputs.ImageColor = imageColor;
+                Renderer2D::AppendUserInterfaceImage(
+                        element,
+                        resolvedRectTransform.WorldTransform
+                                * glm::scale(glm::mat4(1.0f), glm::vec3(resolvedRectTransform.Size, 1.0f)),
+                        image->Texture, imageColor, entityIdentifier);
+            }
+
+            if (hasText)
+            {
+                inputs.HasText = true;
+                inputs.TextFont = fontAsset;
+                inputs.TextColor = text->Color;
+                inputs.TextSettings = layoutSettings;
+                inputs.Text = text->TextString;
+                Renderer2D::AppendUserInterfaceText(
+                        element, text->TextString, fontAsset, resolvedRectTransform.WorldTransform,
+                        layoutSettings, text->Color, entityIdentifier);
+                // 排版过程中可能生成新字形，代数在生成之后读取，下一帧即可命中。
+                inputs.TextFontGlyphGeneration = fontAsset->GetGlyphGeneration();
+                inputs.FallbackFontGlyphGeneration = defaultFont ? defaultFont->GetGlyphGeneration() : 0;
+            }
+        }
 
-        for (UUID childIdentifier : GetEntityChildren(canvasEntity))
-            drawUserInterfaceSubtree(GetEntityByUUID(childIdentifier));
+        Renderer2D::DrawUserInterfaceList(drawList, designToTargetMatrix);
     }
 
     Scene::OrthographicViewBounds Scene::GetPrimaryOrthographicViewBounds() const
@@ -488,10 +490,31 @@ namespace Himii
 
     Entity Scene::FindCanvasEntity() const
     {
-        auto canvasView = m_Registry.view<CanvasComponent>();
-        for (auto entityHandle : canvasView)
-            return Entity{entityHandle, const_cast<Scene*>(this)};
-        return {};
+        // 缓存由 Canvas 组件的增删回调作废，每帧多次查询不再遍历视图。
+        if (!m_CanvasEntityCacheValid)
+        {
+            m_CanvasEntityCache = entt::null;
+            auto canvasView = m_Registry.view<CanvasComponent>();
+            for (auto entityHandle : canvasView)
+            {
+                m_CanvasEntityCache = entityHandle;
+                break;
+            }
+            m_CanvasEntityCacheValid = true;
+        }
+
+        if (m_CanvasEntityCache == entt::null)
+            return {};
+        return Entity{m_CanvasEntityCache, const_cast<Scene*>(this)};
+    }
+
+    void Scene::OnUserInterfaceComponentChanged(entt::registry &registry, entt::entity entityHandle)
+    {
+        (void)registry;
+        (void)entityHandle;
+        // 已挂在 Canvas 下的实体补上或移除 RectTransform 时层级不变，也要让节点表重建。
+        m_CanvasEntityCacheValid = false;
+        m_UserInterfaceLayoutStructureDirty = true;
     }
 
     bool Scene::IsEntityUnderCanvas(Entity entity) const
@@ -522,40 +545,183 @@ namespace Himii
         return context;
     }
 
-    Scene::ResolvedRectTransform Scene::ResolveRectTransform(
-            Entity entity, float targetWidth, float targetHeight) const
+    bool Scene::RefreshUserInterfaceLayoutNodes() const
     {
-        ResolvedRectTransform result;
-        if (!entity || !entity.HasComponent<RectTransformComponent>() || !IsEntityUnderCanvas(entity))
-            return result;
+        Entity canvasEntity = FindCanvasEntity();
+        if (!canvasEntity || !canvasEntity.HasComponent<RectTransformComponent>())
+        {
+            m_UserInterfaceLayoutNodes.clear();
+            m_UserInterfaceLayoutNodeIndices.clear();
+            m_UserInterfaceLayoutTargets.clear();
+            m_UserInterfaceLayoutCanvas = entt::null;
+            m_UserInterfaceLayoutStructureDirty = true;
+            return false;
+        }
 
-        const CanvasLayoutContext context = GetCanvasLayoutContext(targetWidth, targetHeight);
-        if (!context.Valid)
-            return result;
+        const entt::entity canvasHandle = (entt::entity)canvasEntity;
+        if (!m_UserInterfaceLayoutStructureDirty && canvasHandle == m_UserInterfaceLayoutCanvas)
+            return true;
 
-        Entity canvasEntity = FindCanvasEntity();
-        if (entity == canvasEntity)
+        HIMII_PROFILE_FUNCTION();
+
+        m_UserInterfaceLayoutNodes.clear();
+        m_UserInterfaceLayoutNodeIndices.clear();
+        m_UserInterfaceLayoutTargets.clear();
+
+        // 显式栈先序展开，深层级不占调用栈；子节点逆序入栈以保持 SiblingIndex 顺序。
+        // 缺少 RectTransform 的节点连同其子树都不参与 UI 布局。
+        std::vector<std::pair<entt::entity, int32_t>> pendingNodes;
+        pendingNodes.emplace_back(canvasHandle, -1);
+        while (!pendingNodes.empty())
         {
+            const auto [entityHandle, parentIndex] = pendingNodes.back();
+            pendingNodes.pop_back();
+
+            const size_t nodeIndex = m_UserInterfaceLayoutNodes.size();
+            m_UserInterfaceLayoutNodes.push_back({entityHandle, parentIndex});
+            m_UserInterfaceLayoutNodeIndices[entityHandle] = nodeIndex;
+
+            const std::vector<UUID> &children = GetEntityChildren(Entity{entityHandle, const_cast<Scene *>(this)});
+            for (auto iterator = children.rbegin(); iterator != children.rend(); ++iterator)
+            {
+                Entity childEntity = GetEntityByUUID(*iterator);
+                if (childEntity && childEntity.HasComponent<RectTransformComponent>())
+                    pendingNodes.emplace_back((entt::entity)childEntity, static_cast<int32_t>(nodeIndex));
+            }
+        }
+
+        m_UserInterfaceLayoutCanvas = canvasHandle;
+        m_UserInterfaceLayoutStructureDirty = false;
+        return true;
+    }
+
+    Scene::UserInterfaceLayoutTarget *Scene::UpdateUserInterfaceLayout(
+            float targetWidth, float targetHeight) const
+    {
+        if (!RefreshUserInterfaceLayoutNodes())
+            return nullptr;
+
+        const CanvasLayoutContext requestedContext = GetCanvasLayoutContext(targetWidth, targetHeight);
+        if (!requestedContext.Valid)
+            return nullptr;
+
+        // Canvas 参数（参考分辨率、匹配权重、缩放模式）变化会改变上下文，对应目标整表重算。
+        size_t requestedTargetIndex = m_UserInterfaceLayoutTargets.size();
+        for (size_t targetIndex = 0; targetIndex < m_UserInterfaceLayoutTargets.size(); ++targetIndex)
+        {
+            UserInterfaceLayoutTarget &target = m_UserInterfaceLayoutTargets[targetIndex];
+            const bool isRequestedTarget = target.TargetSize == requestedContext.TargetSize;
+            const CanvasLayoutContext context = isRequestedTarget
+                                                        ? requestedContext
+                                                        : GetCanvasLayoutContext(target.TargetSize.x, target.TargetSize.y);
+            if (context.LogicalSize != target.Context.LogicalSize || context.ScaleFactor != target.Context.ScaleFactor)
+            {
+                target.Context = context;
+                target.NeedsFullResolve = true;
+            }
+            if (isRequestedTarget)
+                requestedTargetIndex = targetIndex;
+        }
+
+        if (requestedTargetIndex == m_UserInterfaceLayoutTargets.size())
+        {
+            if (m_UserInterfaceLayoutTargets.size() >= MaxUserInterfaceLayoutTargets)
+                m_UserInterfaceLayoutTargets.erase(m_UserInterfaceLayoutTargets.begin());
+
+            UserInterfaceLayoutTarget target;
+            target.TargetSize = requestedContext.TargetSize;
+            target.Context = requestedContext;
+            m_UserInterfaceLayoutTargets.push_back(std::move(target));
+            requestedTargetIndex = m_UserInterfaceLayoutTargets.size() - 1;
+        }
+
+        UserInterfaceLayoutTarget &requestedTarget = m_UserInterfaceLayoutTargets[requestedTargetIndex];
+        const bool anyTargetNeedsFullResolve =
+                std::any_of(m_UserInterfaceLayoutTargets.begin(), m_UserInterfaceLayoutTargets.end(),
+                            [](const UserInterfaceLayoutTarget &target) { return target.NeedsFullResolve; });
+        if (!m_UserInterfaceLayoutDirty && !anyTargetNeedsFullResolve)
+            return &requestedTarget;
+
+        const size_t nodeCount = m_UserInterfaceLayoutNodes.size();
+        for (UserInterfaceLayoutTarget &target : m_UserInterfaceLayoutTargets)
+            target.ResolvedNodes.resize(nodeCount);
+        m_UserInterfaceLayoutNodeResolved.assign(nodeCount, 0);
+
+        for (size_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+        {
+            const UserInterfaceLayoutNode &node = m_UserInterfaceLayoutNodes[nodeIndex];
+            const RectTransformComponent *rectTransform =
+                    m_Registry.valid(node.EntityHandle) ? m_Registry.try_get<RectTransformComponent>(node.EntityHandle)
+                                                        : nullptr;
+            if (!rectTransform)
+            {
+                // RectTransform 被直接移除而层级未变，节点表已失效：重建后整表重算。
+                m_UserInterfaceLayoutStructureDirty = true;
+                return UpdateUserInterfaceLayout(targetWidth, targetHeight);
+            }
+
+            // 父节点重算过的子树必须跟着重算，即使脏标记没有逐层传播下来。
+            const bool nodeDirty = rectTransform->WorldTransformDirty
+                                   || (node.ParentIndex >= 0 && m_UserInterfaceLayoutNodeResolved[node.ParentIndex]);
+            m_UserInterfaceLayoutNodeResolved[nodeIndex] = nodeDirty ? 1 : 0;
+
+            for (UserInterfaceLayoutTarget &target : m_UserInterfaceLayoutTargets)
+            {
+                if (nodeDirty || target.NeedsFullResolve)
+                    ResolveUserInterfaceLayoutNode(target, nodeIndex);
+            }
+
+            // 组件上的缓存字段供检视面板显示，镜像本次请求尺寸的结果。
+            const ResolvedRectTransform &resolved = requestedTarget.ResolvedNodes[nodeIndex];
+            if ((nodeDirty || requestedTarget.NeedsFullResolve) && resolved.Valid)
+            {
+                rectTransform->ResolvedSize = resolved.Size;
+                rectTransform->CachedWorldTransform = resolved.WorldTransform;
+            }
+            rectTransform->WorldTransformDirty = false;
+        }
+
+        for (UserInterfaceLayoutTarget &target : m_UserInterfaceLayoutTargets)
+            target.NeedsFullResolve = false;
+        m_UserInterfaceLayoutDirty = false;
+        return &requestedTarget;
+    }
+
+    const Scene::UserInterfaceLayoutTarget *Scene::FindUserInterfaceLayoutTarget(
+            float targetWidth, float targetHeight) const
+    {
+        if (m_UserInterfaceLayoutStructureDirty || m_UserInterfaceLayoutDirty)
+            return nullptr;
+
+        const glm::vec2 targetSize{targetWidth, targetHeight};
+        for (const UserInterfaceLayoutTarget &target : m_UserInterfaceLayoutTargets)
+        {
+            if (target.TargetSize == targetSize && !target.NeedsFullResolve)
+                return &target;
+        }
+        return nullptr;
+    }
+
+    void Scene::ResolveUserInterfaceLayoutNode(UserInterfaceLayoutTarget &target, size_t nodeIndex) const
+    {
+        const UserInterfaceLayoutNode &node = m_UserInterfaceLayoutNodes[nodeIndex];
+        ResolvedRectTransform &result = target.ResolvedNodes[nodeIndex];
+        result = {};
+
+        if (node.ParentIndex < 0)
+        {
+            // Canvas 根节点：逻辑尺寸，钉在设计空间原点。
             result.Valid = true;
-            result.Size = context.LogicalSize;
+            result.Size = target.Context.LogicalSize;
             result.WorldTransform = glm::mat4(1.0f);
-            auto& rectTransform = entity.GetComponent<RectTransformComponent>();
-            rectTransform.ResolvedSize = result.Size;
-            rectTransform.CachedWorldTransform = result.WorldTransform;
-            rectTransform.WorldTransformDirty = false;
-            return result;
+            return;
         }
 
-        Entity parentEntity = GetParentEntity(entity);
-        if (!parentEntity || !parentEntity.HasComponent<RectTransformComponent>())
-            return result;
-
-        const ResolvedRectTransform parentResult =
-                ResolveRectTransform(parentEntity, targetWidth, targetHeight);
+        const ResolvedRectTransform &parentResult = target.ResolvedNodes[node.ParentIndex];
         if (!parentResult.Valid)
-            return result;
+            return;
 
-        auto& rectTransform = entity.GetComponent<RectTransformComponent>();
+        const auto& rectTransform = m_Registry.get<RectTransformComponent>(node.EntityHandle);
         const glm::vec2 anchorMinimum = glm::clamp(
                 rectTransform.AnchorMinimum, glm::vec2(0.0f), glm::vec2(1.0f));
         const glm::vec2 anchorMaximum = glm::clamp(
@@ -581,10 +747,25 @@ namespace Himii
         result.Valid = true;
         result.Size = resolvedSize;
         result.WorldTransform = parentResult.WorldTransform * localTransform;
-        rectTransform.ResolvedSize = resolvedSize;
-        rectTransform.CachedWorldTransform = result.WorldTransform;
-        rectTransform.WorldTransformDirty = false;
-        return result;
+    }
+
+    Scene::ResolvedRectTransform Scene::ResolveRectTransform(
+            Entity entity, float targetWidth, float targetHeight) const
+    {
+        if (!entity)
+            return {};
+
+        // 逐实体查询只读保留结果；结果缺失或已过期时补跑一次布局，之后的查询又回到查表。
+        const UserInterfaceLayoutTarget *layoutTarget = FindUserInterfaceLayoutTarget(targetWidth, targetHeight);
+        if (!layoutTarget)
+            layoutTarget = UpdateUserInterfaceLayout(targetWidth, targetHeight);
+        if (!layoutTarget)
+            return {};
+
+        const auto nodeIterator = m_UserInterfaceLayoutNodeIndices.find((entt::entity)entity);
+        if (nodeIterator == m_UserInterfaceLayoutNodeIndices.end())
+            return {};
+        return layoutTarget->ResolvedNodes[nodeIterator->second];
     }
 
     float Scene::ComputeCanvasScaleFactor(float viewportWidth, float viewportHeight) const
@@ -2,6 +2,9 @@
 #include "EngineCore/Utils/PlatformUtils.h"
 #include "EngineCore/Core/Application.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <cstdlib>
 
@@ -175,4 +178,61 @@ namespace Himii {
     {
         return setenv(name.c_str(), value.c_str(), 1) == 0;
     }
-}
\ No newline at end of file
+
+    PlatformFileFingerprint PlatformFileSystem::QueryFileFingerprint(const std::filesystem::path &filepath)
+    {
+        PlatformFileFingerprint fingerprint;
+        struct stat fileStatus{};
+        if (stat(filepath.c_str(), &fileStatus) != 0)
+            return fingerprint;
+
+        fingerprint.Exists = true;
+        fingerprint.Size = static_cast<uint64_t>(fileStatus.st_size);
+        fingerprint.ModifiedTime = static_cast<int64_t>(fileStatus.st_mtim.tv_sec) * 1000000000ll
+                                   + static_cast<int64_t>(fileStatus.st_mtim.tv_nsec);
+        fingerprint.FileId = static_cast<uint64_t>(fileStatus.st_ino);
+        return fingerprint;
+    }
+
+    PlatformMappedFile::~PlatformMappedFile()
+    {
+        Close();
+    }
+
+    bool PlatformMappedFile::Open(const std::filesystem::path &filepath)
+    {
+        Close();
+
+        const int fileDescriptor = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fileDescriptor < 0)
+            return false;
+
+        struct stat fileStatus{};
+        if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+        void *mappedAddress = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        // 映射建立后即可关闭描述符，映射页仍然有效。
+        close(fileDescriptor);
+        if (mappedAddress == MAP_FAILED)
+            return false;
+
+        madvise(mappedAddress, fileSize, MADV_SEQUENTIAL);
+        m_Data = static_cast<const uint8_t *>(mappedAddress);
+        m_Size = fileSize;
+        return true;
+    }
+
+    void PlatformMappedFile::Close()
+    {
+        if (m_Data)
+            munmap(const_cast<uint8_t *>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_NativeMappingHandle = nullptr;
+    }
+}
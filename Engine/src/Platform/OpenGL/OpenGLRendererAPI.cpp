@@ -1,5 +1,6 @@
 #include "Hepch.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/OpenGL/OpenGLShaderCache.h"
 
 #include "glad/glad.h"
 namespace Himii
@@ -34,6 +35,8 @@ namespace Himii
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glEnable(GL_DEPTH_TEST);
         glEnable(GL_LINE_SMOOTH);
+
+        OpenGLShaderCache::InitializeProgramBinarySupport();
     }
 
     void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -71,6 +74,27 @@ namespace Himii
         glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount);
     }
 
+    void OpenGLRendererAPI::DrawIndexedMultiRange(const Ref<VertexArray> &vertexArray, const uint32_t *indexCounts,
+                                                  const uint32_t *firstIndices, uint32_t rangeCount)
+    {
+        if (rangeCount == 0)
+            return;
+
+        vertexArray->Bind();
+        static std::vector<GLsizei> s_Counts;
+        static std::vector<const void *> s_Offsets;
+        s_Counts.resize(rangeCount);
+        s_Offsets.resize(rangeCount);
+        for (uint32_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex)
+        {
+            s_Counts[rangeIndex] = static_cast<GLsizei>(indexCounts[rangeIndex]);
+            s_Offsets[rangeIndex] =
+                    reinterpret_cast<const void *>(static_cast<uintptr_t>(firstIndices[rangeIndex]) * sizeof(uint32_t));
+        }
+        glMultiDrawElements(GL_TRIANGLES, s_Counts.data(), GL_UNSIGNED_INT, s_Offsets.data(),
+                            static_cast<GLsizei>(rangeCount));
+    }
+
     void OpenGLRendererAPI::DrawArrays(const Ref<VertexArray> &vertexArray, uint32_t vertexCount)
     {
         vertexArray->Bind();
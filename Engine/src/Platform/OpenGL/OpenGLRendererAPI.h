@@ -16,6 +16,8 @@ namespace Himii
         virtual void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount = 0) override;
         virtual void DrawIndexedInstanced(
                 const Ref<VertexArray> &vertexArray, uint32_t indexCount, uint32_t instanceCount) override;
+        virtual void DrawIndexedMultiRange(const Ref<VertexArray> &vertexArray, const uint32_t *indexCounts,
+                                           const uint32_t *firstIndices, uint32_t rangeCount) override;
         virtual void DrawArrays(const Ref<VertexArray> &vertexArray, uint32_t vertexCount) override;
         virtual void DrawLines(const Ref<VertexArray> &vertexArray, uint32_t vertexCount = 0) override;
 
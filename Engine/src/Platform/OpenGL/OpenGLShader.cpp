@@ -1,7 +1,9 @@
 #include "Hepch.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/OpenGL/OpenGLShaderCache.h"
 
 #include "EngineCore/Core/FileSystem.h"
+#include "EngineCore/Core/Hash.h"
 #include "fstream"
 #include "filesystem"
 #include "glad/glad.h"
@@ -16,6 +18,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 
 namespace Himii
 {
@@ -58,84 +61,193 @@ namespace Himii
             return nullptr;
         }
 
-        static std::filesystem::path GetCacheDirectory()
-        {
-            return FileSystem::GetWritableCacheRoot() / "shader" / "opengl";
-        }
-
-        static void CreateCacheDirectoryIfNeeded()
-        {
-            const std::filesystem::path cacheDirectory = GetCacheDirectory();
-            if (!std::filesystem::exists(cacheDirectory))
-                std::filesystem::create_directories(cacheDirectory);
-        }
-
-        static const char *GLShaderStageCachedOpenGLFileExtension(uint32_t stage)
+        static const char *GLShaderStageToExtension(GLenum stage)
         {
             switch (stage)
             {
                 case GL_VERTEX_SHADER:
-                    return ".cached_opengl.vert";
+                    return ".vert";
                 case GL_FRAGMENT_SHADER:
-                    return ".cached_opengl.frag";
+                    return ".frag";
             }
             HIMII_CORE_ASSERT(false);
             return "";
         }
 
-        static const char *GLShaderStageCachedVulkanFileExtension(uint32_t stage)
+        static std::string ToHex64(uint64_t value)
         {
-            switch (stage)
-            {
-                case GL_VERTEX_SHADER:
-                    return ".cached_vulkan.vert";
-                case GL_FRAGMENT_SHADER:
-                    return ".cached_vulkan.frag";
-            }
-            HIMII_CORE_ASSERT(false);
-            return "";
+            std::ostringstream stream;
+            stream << std::hex << std::setw(16) << std::setfill('0') << value;
+            return stream.str();
         }
+    }
+
+    namespace
+    {
+        /// 编译参数或 SPIRV-Cross 选项改动时递增；与 shaderc 的 SPIR-V 版本一起进入缓存键。
+        constexpr uint32_t ShaderCompilerRevision = 2u;
+        // 与 Create*CompileOptions 保持一致，作为缓存键的一部分。
+        constexpr const char *VulkanCompileOptionsTag = "vulkan_1_2|optimize_performance";
+        constexpr const char *OpenGLCompileOptionsTag = "opengl_4_5|glsl450|420pack|push_constant_ubo";
+        constexpr GLenum ShaderStageOrder[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+
+        struct PrecompiledShader
+        {
+            uint64_t ProgramKey = 0;
+            // 程序二进制已在缓存中时为空，构造时直接 glProgramBinary。
+            std::unordered_map<GLenum, std::vector<uint32_t>> OpenGLSPIRV;
+        };
+
+        // 预热阶段的结果，按原始源码哈希索引；构造时取走，主线程只剩链接。
+        std::mutex s_PrecompiledShadersMutex;
+        std::unordered_map<uint64_t, PrecompiledShader> s_PrecompiledShaders;
 
-        // FNV-1a 64-bit：用于源码与编译参数哈希，避免过期缓存。
-        static uint64_t HashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ull)
+        uint64_t GetCompilerVersionHash()
         {
-            const uint8_t *bytes = static_cast<const uint8_t *>(data);
-            for (size_t index = 0; index < size; ++index)
+            static const uint64_t compilerVersionHash = []
             {
-                hash ^= bytes[index];
-                hash *= 1099511628211ull;
-            }
-            return hash;
+                unsigned int spirvVersion = 0;
+                unsigned int spirvRevision = 0;
+                shaderc_get_spv_version(&spirvVersion, &spirvRevision);
+
+                uint64_t hash = HashBytes(&ShaderCompilerRevision, sizeof(ShaderCompilerRevision));
+                hash = HashBytes(&spirvVersion, sizeof(spirvVersion), hash);
+                return HashBytes(&spirvRevision, sizeof(spirvRevision), hash);
+            }();
+            return compilerVersionHash;
         }
 
-        static uint64_t HashString(const std::string &text, uint64_t hash = 14695981039346656037ull)
+        shaderc::CompileOptions CreateVulkanCompileOptions()
         {
-            return HashBytes(text.data(), text.size(), hash);
+            shaderc::CompileOptions options;
+            options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+            options.SetOptimizationLevel(shaderc_optimization_level_performance);
+            return options;
         }
 
-        static std::string ToHex64(uint64_t value)
+        shaderc::CompileOptions CreateOpenGLCompileOptions()
         {
-            std::ostringstream stream;
-            stream << std::hex << std::setw(16) << std::setfill('0') << value;
-            return stream.str();
+            shaderc::CompileOptions options;
+            options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
+            return options;
+        }
+
+        uint64_t HashCacheKeyPrefix(OpenGLShaderCacheEntryKind kind, const char *optionsTag, GLenum stage)
+        {
+            uint64_t hash = HashBytes(&kind, sizeof(kind));
+            hash = HashString(optionsTag, hash);
+            hash = HashBytes(&stage, sizeof(stage), hash);
+            const uint64_t compilerVersionHash = GetCompilerVersionHash();
+            return HashBytes(&compilerVersionHash, sizeof(compilerVersionHash), hash);
+        }
+
+        bool LoadCachedSPIRV(OpenGLShaderCacheEntryKind kind, uint64_t key, std::vector<uint32_t> &outData)
+        {
+            std::vector<uint8_t> bytes;
+            if (!OpenGLShaderCache::Load(kind, key, bytes) || bytes.size() % sizeof(uint32_t) != 0)
+                return false;
+
+            outData.resize(bytes.size() / sizeof(uint32_t));
+            std::memcpy(outData.data(), bytes.data(), bytes.size());
+            return true;
+        }
+
+        void StoreCachedSPIRV(OpenGLShaderCacheEntryKind kind, uint64_t key, const std::vector<uint32_t> &data)
+        {
+            OpenGLShaderCache::Store(kind, key, data.data(), data.size() * sizeof(uint32_t));
         }
     }
 
-    OpenGLShader::OpenGLShader(const std::string &filepath) : m_FilePath(filepath), m_RendererID(0)
+    ShaderPrecompileResult OpenGLShader::PrecompileFile(const std::string &filepath, bool keepForLink)
     {
         HIMII_PROFILE_FUNCTION();
 
-        Utils::CreateCacheDirectoryIfNeeded();
+        const std::string source = ReadFile(filepath);
+        if (source.empty())
+        {
+            ShaderPrecompileResult result;
+            result.Name = filepath;
+            HIMII_CORE_ERROR("Shader precompile: failed to read {0}", filepath);
+            return result;
+        }
+        return PrecompileStages(filepath, PreProcess(source), keepForLink);
+    }
+
+    ShaderPrecompileResult OpenGLShader::Precompile(const std::string &name, const std::string &vertexSource,
+                                                    const std::string &fragmentSource, bool keepForLink)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        StageSources sources;
+        sources[GL_VERTEX_SHADER] = vertexSource;
+        sources[GL_FRAGMENT_SHADER] = fragmentSource;
+        return PrecompileStages(name, sources, keepForLink);
+    }
+
+    void OpenGLShader::ClearPrecompiledStages()
+    {
+        std::lock_guard<std::mutex> lock(s_PrecompiledShadersMutex);
+        s_PrecompiledShaders.clear();
+    }
+
+    ShaderPrecompileResult OpenGLShader::PrecompileStages(const std::string &cacheName, const StageSources &sources,
+                                                          bool keepForLink)
+    {
+        Timer timer;
+        ShaderPrecompileResult result;
+        result.Name = cacheName;
+
+        StageKeys vulkanKeys;
+        StageKeys openGLKeys;
+        if (!ComputeStageKeys(cacheName, sources, vulkanKeys, openGLKeys))
+        {
+            result.CompileMilliseconds = timer.ElapsedMillis();
+            return result;
+        }
+
+        PrecompiledShader precompiled;
+        precompiled.ProgramKey = ComputeProgramKey(openGLKeys);
+        if (precompiled.ProgramKey != 0
+            && OpenGLShaderCache::Contains(OpenGLShaderCacheEntryKind::ProgramBinary, precompiled.ProgramKey))
+        {
+            // 驱动程序二进制已缓存：两级 SPIR-V 都用不到。
+            result.Succeeded = true;
+            result.CacheHit = true;
+        }
+        else
+        {
+            StageBinaries vulkanSPIRV;
+            bool vulkanCacheHit = false;
+            bool openGLCacheHit = false;
+            result.Succeeded =
+                    CompileOrGetVulkanBinaries(cacheName, sources, vulkanKeys, vulkanSPIRV, vulkanCacheHit)
+                    && CompileOrGetOpenGLBinaries(cacheName, vulkanSPIRV, openGLKeys, precompiled.OpenGLSPIRV,
+                                                  openGLCacheHit);
+            result.CacheHit = vulkanCacheHit && openGLCacheHit;
+        }
+
+        if (result.Succeeded && keepForLink)
+        {
+            const uint64_t sourceHash = ComputeSourceHash(cacheName, sources);
+            std::lock_guard<std::mutex> lock(s_PrecompiledShadersMutex);
+            s_PrecompiledShaders[sourceHash] = std::move(precompiled);
+        }
+
+        result.CompileMilliseconds = timer.ElapsedMillis();
+        return result;
+    }
+
+    OpenGLShader::OpenGLShader(const std::string &filepath) : m_FilePath(filepath), m_RendererID(0)
+    {
+        HIMII_PROFILE_FUNCTION();
 
         std::string source = ReadFile(filepath);
         auto shaderSources = PreProcess(source);
-        m_SourceHash = ComputeSourceHash(shaderSources);
+        m_SourceHash = ComputeSourceHash(m_FilePath, shaderSources);
 
         {
             Timer timer;
-            CompileOrGetVulkanBinaries(shaderSources);
-            CompileOrGetOpenGLBinaries();
-            CreateProgram();
+            BuildProgram(shaderSources);
             HIMII_CORE_WARNING("OpenGL shader creation took {0} ms", timer.ElapsedMillis());
         }
 
@@ -151,17 +263,13 @@ namespace Himii
     {
         HIMII_PROFILE_FUNCTION();
 
-        Utils::CreateCacheDirectoryIfNeeded();
-
-        std::unordered_map<GLenum, std::string> sources;
+        StageSources sources;
         sources[GL_VERTEX_SHADER] = vertexSource;
         sources[GL_FRAGMENT_SHADER] = fragmentSource;
         m_FilePath = name;
-        m_SourceHash = ComputeSourceHash(sources);
+        m_SourceHash = ComputeSourceHash(m_FilePath, sources);
 
-        CompileOrGetVulkanBinaries(sources);
-        CompileOrGetOpenGLBinaries();
-        CreateProgram();
+        BuildProgram(sources);
     }
 
     OpenGLShader::~OpenGLShader()
@@ -177,33 +285,132 @@ namespace Himii
         return m_RendererID != 0;
     }
 
-    uint64_t OpenGLShader::ComputeSourceHash(const std::unordered_map<GLenum, std::string> &shaderSources) const
+    void OpenGLShader::BuildProgram(const StageSources &shaderSources)
     {
-        uint64_t hash = Utils::HashString("himii-shader-cache-v2");
-        hash = Utils::HashString("vulkan-1.2", hash);
-        hash = Utils::HashString("opengl-4.5", hash);
-        hash = Utils::HashString(m_FilePath, hash);
+        PrecompiledShader precompiled;
+        bool hasPrecompiled = false;
+        {
+            std::lock_guard<std::mutex> lock(s_PrecompiledShadersMutex);
+            auto found = s_PrecompiledShaders.find(m_SourceHash);
+            if (found != s_PrecompiledShaders.end())
+            {
+                precompiled = std::move(found->second);
+                s_PrecompiledShaders.erase(found);
+                hasPrecompiled = true;
+            }
+        }
 
-        // 固定顺序，避免 unordered_map 遍历导致哈希不稳定。
-        const GLenum stages[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
-        for (GLenum stage : stages)
+        StageKeys vulkanKeys;
+        StageKeys openGLKeys;
+        if (!hasPrecompiled)
+        {
+            if (!ComputeStageKeys(m_FilePath, shaderSources, vulkanKeys, openGLKeys))
+            {
+                HIMII_CORE_ASSERT(false, "Shader preprocess failed!");
+                return;
+            }
+            precompiled.ProgramKey = ComputeProgramKey(openGLKeys);
+        }
+
+        m_ProgramKey = precompiled.ProgramKey;
+        if (m_ProgramKey != 0 && CreateProgramFromBinary())
+            return;
+
+        if (precompiled.OpenGLSPIRV.empty())
+        {
+            // 预热只确认了程序二进制存在，但驱动拒绝了它：回到 SPIR-V 路径。
+            if (vulkanKeys.empty() && !ComputeStageKeys(m_FilePath, shaderSources, vulkanKeys, openGLKeys))
+            {
+                HIMII_CORE_ASSERT(false, "Shader preprocess failed!");
+                return;
+            }
+
+            StageBinaries vulkanSPIRV;
+            bool cacheHit = false;
+            if (!CompileOrGetVulkanBinaries(m_FilePath, shaderSources, vulkanKeys, vulkanSPIRV, cacheHit))
+            {
+                HIMII_CORE_ASSERT(false, "Shader Vulkan compile failed!");
+                return;
+            }
+            if (!CompileOrGetOpenGLBinaries(m_FilePath, vulkanSPIRV, openGLKeys, precompiled.OpenGLSPIRV, cacheHit))
+            {
+                HIMII_CORE_ASSERT(false, "Shader OpenGL compile failed!");
+                return;
+            }
+        }
+
+        CreateProgram(precompiled.OpenGLSPIRV);
+        if (m_RendererID != 0 && m_ProgramKey != 0)
+            StoreProgramBinary();
+    }
+
+    uint64_t OpenGLShader::ComputeSourceHash(const std::string &cacheName, const StageSources &shaderSources)
+    {
+        uint64_t hash = HashString(cacheName);
+        for (GLenum stage : ShaderStageOrder)
         {
             auto found = shaderSources.find(stage);
             if (found == shaderSources.end())
                 continue;
-            hash = Utils::HashBytes(&stage, sizeof(stage), hash);
-            hash = Utils::HashString(found->second, hash);
+            hash = HashBytes(&stage, sizeof(stage), hash);
+            hash = HashString(found->second, hash);
         }
         return hash;
     }
 
-    std::filesystem::path OpenGLShader::BuildCachePath(GLenum stage, const char *extension) const
+    bool OpenGLShader::ComputeStageKeys(const std::string &cacheName, const StageSources &shaderSources,
+                                        StageKeys &outVulkanKeys, StageKeys &outOpenGLKeys)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 键取自 shaderc 预处理后的完整源码（宏、#include 均已展开），而非原始文本。
+        shaderc::Compiler compiler;
+        const shaderc::CompileOptions options = CreateVulkanCompileOptions();
+
+        outVulkanKeys.clear();
+        outOpenGLKeys.clear();
+        for (auto &&[stage, source] : shaderSources)
+        {
+            shaderc::PreprocessedSourceCompilationResult preprocessed =
+                    compiler.PreprocessGlsl(source, Utils::GLShaderStageToShaderC(stage), cacheName.c_str(), options);
+            if (preprocessed.GetCompilationStatus() != shaderc_compilation_status_success)
+            {
+                HIMII_CORE_ERROR("Shader preprocess failed ({0}):\n{1}", cacheName, preprocessed.GetErrorMessage());
+                return false;
+            }
+
+            uint64_t vulkanKey = HashCacheKeyPrefix(OpenGLShaderCacheEntryKind::VulkanSPIRV, VulkanCompileOptionsTag,
+                                                    stage);
+            vulkanKey = HashBytes(preprocessed.cbegin(),
+                                         static_cast<size_t>(preprocessed.cend() - preprocessed.cbegin()), vulkanKey);
+            outVulkanKeys[stage] = vulkanKey;
+
+            // OpenGL SPIR-V 由 Vulkan SPIR-V 派生，键只需串上其输入的键。
+            uint64_t openGLKey = HashCacheKeyPrefix(OpenGLShaderCacheEntryKind::OpenGLSPIRV, OpenGLCompileOptionsTag,
+                                                    stage);
+            outOpenGLKeys[stage] = HashBytes(&vulkanKey, sizeof(vulkanKey), openGLKey);
+        }
+        return true;
+    }
+
+    uint64_t OpenGLShader::ComputeProgramKey(const StageKeys &openGLKeys)
     {
-        const std::string fileName =
-                std::filesystem::path(m_FilePath).filename().string() + "."
-                + Utils::ToHex64(m_SourceHash)
-                + extension;
-        return Utils::GetCacheDirectory() / fileName;
+        const uint64_t driverSignature = OpenGLShaderCache::GetDriverSignature();
+        if (driverSignature == 0)
+            return 0;
+
+        const OpenGLShaderCacheEntryKind kind = OpenGLShaderCacheEntryKind::ProgramBinary;
+        uint64_t hash = HashBytes(&kind, sizeof(kind));
+        hash = HashBytes(&driverSignature, sizeof(driverSignature), hash);
+        for (GLenum stage : ShaderStageOrder)
+        {
+            auto found = openGLKeys.find(stage);
+            if (found == openGLKeys.end())
+                continue;
+            hash = HashBytes(&stage, sizeof(stage), hash);
+            hash = HashBytes(&found->second, sizeof(found->second), hash);
+        }
+        return hash;
     }
 
     std::string OpenGLShader::ReadFile(const std::string &filepath)
@@ -212,11 +419,11 @@ namespace Himii
         return FileSystem::ReadText(filepath);
     }
 
-    std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string &source)
+    OpenGLShader::StageSources OpenGLShader::PreProcess(const std::string &source)
     {
         HIMII_PROFILE_FUNCTION();
 
-        std::unordered_map<GLenum, std::string> shaderSources;
+        StageSources shaderSources;
 
         const char *typeToken = "#type";
         size_t typeTokenLength = strlen(typeToken);
@@ -241,136 +448,152 @@ namespace Himii
         return shaderSources;
     }
 
-    void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string> &shaderSources)
+    bool OpenGLShader::CompileOrGetVulkanBinaries(const std::string &cacheName, const StageSources &shaderSources,
+                                                  const StageKeys &vulkanKeys, StageBinaries &outVulkanSPIRV,
+                                                  bool &outCacheHit)
     {
         shaderc::Compiler compiler;
-        shaderc::CompileOptions options;
-        options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
-        options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        const shaderc::CompileOptions options = CreateVulkanCompileOptions();
 
-        auto &shaderData = m_VulkanSPIRV;
-        shaderData.clear();
+        outVulkanSPIRV.clear();
+        outCacheHit = true;
         for (auto &&[stage, source] : shaderSources)
         {
-            const std::filesystem::path cachedPath =
-                    BuildCachePath(stage, Utils::GLShaderStageCachedVulkanFileExtension(stage));
-
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
+            const uint64_t cacheKey = vulkanKeys.at(stage);
+            if (LoadCachedSPIRV(OpenGLShaderCacheEntryKind::VulkanSPIRV, cacheKey, outVulkanSPIRV[stage]))
+                continue;
 
-                auto &data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char *)data.data(), size);
-            }
-            else
+            outCacheHit = false;
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                    source, Utils::GLShaderStageToShaderC(stage), cacheName.c_str(), options);
+            if (module.GetCompilationStatus() != shaderc_compilation_status_success)
             {
-                shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                        source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str(), options);
-                if (module.GetCompilationStatus() != shaderc_compilation_status_success)
-                {
-                    HIMII_CORE_ERROR("Vulkan SPIR-V compile failed ({0}):\n{1}", m_FilePath,
-                                     module.GetErrorMessage());
-                    HIMII_CORE_ASSERT(false, "Shader Vulkan compile failed!");
-                }
-
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
-
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto &data = shaderData[stage];
-                    out.write((char *)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
+                HIMII_CORE_ERROR("Vulkan SPIR-V compile failed ({0}):\n{1}", cacheName, module.GetErrorMessage());
+                return false;
             }
+
+            outVulkanSPIRV[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+            StoreCachedSPIRV(OpenGLShaderCacheEntryKind::VulkanSPIRV, cacheKey, outVulkanSPIRV[stage]);
         }
 
-        for (auto &&[stage, data] : shaderData)
-            Reflect(stage, data);
+        for (auto &&[stage, data] : outVulkanSPIRV)
+            Reflect(cacheName, stage, data);
+        return true;
     }
 
-    void OpenGLShader::CompileOrGetOpenGLBinaries()
+    bool OpenGLShader::CompileOrGetOpenGLBinaries(const std::string &cacheName, const StageBinaries &vulkanSPIRV,
+                                                  const StageKeys &openGLKeys, StageBinaries &outOpenGLSPIRV,
+                                                  bool &outCacheHit)
     {
-        auto &shaderData = m_OpenGLSPIRV;
-
         shaderc::Compiler compiler;
-        shaderc::CompileOptions options;
-        options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
+        const shaderc::CompileOptions options = CreateOpenGLCompileOptions();
 
-        shaderData.clear();
-        m_OpenGLSourceCode.clear();
-        for (auto &&[stage, spirv] : m_VulkanSPIRV)
+        outOpenGLSPIRV.clear();
+        outCacheHit = true;
+        for (auto &&[stage, spirv] : vulkanSPIRV)
         {
-            const std::filesystem::path cachedPath =
-                    BuildCachePath(stage, Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+            const uint64_t cacheKey = openGLKeys.at(stage);
+            if (LoadCachedSPIRV(OpenGLShaderCacheEntryKind::OpenGLSPIRV, cacheKey, outOpenGLSPIRV[stage]))
+                continue;
 
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
+            outCacheHit = false;
+            spirv_cross::CompilerGLSL glslCompiler(spirv);
+            spirv_cross::CompilerGLSL::Options glslOptions;
+            glslOptions.version = 450;
+            glslOptions.es = false;
+            glslOptions.vulkan_semantics = false;
+            glslOptions.enable_420pack_extension = true;
+            glslOptions.emit_push_constant_as_uniform_buffer = true;
+            glslCompiler.set_common_options(glslOptions);
+            const std::string source = glslCompiler.compile();
+
+#if defined(HIMII_DEBUG)
+            // 调试用：保留 SPIRV-Cross 生成的 OpenGL GLSL，便于排查阶段接口失配。
             {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
-
-                auto &data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char *)data.data(), size);
+                const std::filesystem::path dumpPath =
+                        FileSystem::GetWritableCacheRoot() / "shader" / "opengl"
+                        / (std::filesystem::path(cacheName).filename().string() + "." + Utils::ToHex64(cacheKey)
+                           + Utils::GLShaderStageToExtension(stage) + ".cross.glsl");
+                std::ofstream dump(dumpPath, std::ios::out | std::ios::trunc);
+                if (dump.is_open())
+                    dump << source;
             }
-            else
+#endif
+
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                    source, Utils::GLShaderStageToShaderC(stage), cacheName.c_str(), options);
+            if (module.GetCompilationStatus() != shaderc_compilation_status_success)
             {
-                spirv_cross::CompilerGLSL glslCompiler(spirv);
-                spirv_cross::CompilerGLSL::Options glslOptions;
-                glslOptions.version = 450;
-                glslOptions.es = false;
-                glslOptions.vulkan_semantics = false;
-                glslOptions.enable_420pack_extension = true;
-                glslOptions.emit_push_constant_as_uniform_buffer = true;
-                glslCompiler.set_common_options(glslOptions);
-                m_OpenGLSourceCode[stage] = glslCompiler.compile();
-                auto &source = m_OpenGLSourceCode[stage];
-
-                // 调试用：保留 SPIRV-Cross 生成的 OpenGL GLSL，便于排查阶段接口失配。
-                {
-                    std::filesystem::path dumpPath = cachedPath;
-                    dumpPath += ".cross.glsl";
-                    std::ofstream dump(dumpPath, std::ios::out | std::ios::trunc);
-                    if (dump.is_open())
-                        dump << source;
-                }
-
-                shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                        source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str(), options);
-                if (module.GetCompilationStatus() != shaderc_compilation_status_success)
-                {
-                    HIMII_CORE_ERROR("OpenGL SPIR-V compile failed ({0}):\n{1}", m_FilePath,
-                                     module.GetErrorMessage());
-                    HIMII_CORE_ASSERT(false, "Shader OpenGL compile failed!");
-                }
-
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
-
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto &data = shaderData[stage];
-                    out.write((char *)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
+                HIMII_CORE_ERROR("OpenGL SPIR-V compile failed ({0}):\n{1}", cacheName, module.GetErrorMessage());
+                return false;
             }
+
+            outOpenGLSPIRV[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+            StoreCachedSPIRV(OpenGLShaderCacheEntryKind::OpenGLSPIRV, cacheKey, outOpenGLSPIRV[stage]);
         }
+        return true;
+    }
+
+    bool OpenGLShader::CreateProgramFromBinary()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<uint8_t> cachedBinary;
+        if (!OpenGLShaderCache::Load(OpenGLShaderCacheEntryKind::ProgramBinary, m_ProgramKey, cachedBinary)
+            || cachedBinary.size() <= sizeof(GLenum))
+            return false;
+
+        GLenum binaryFormat = 0;
+        std::memcpy(&binaryFormat, cachedBinary.data(), sizeof(binaryFormat));
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, binaryFormat, cachedBinary.data() + sizeof(GLenum),
+                        static_cast<GLsizei>(cachedBinary.size() - sizeof(GLenum)));
+
+        GLint isLinked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
+        {
+            HIMII_CORE_WARNING("Cached program binary rejected by driver ({0}); relinking from SPIR-V", m_FilePath);
+            glDeleteProgram(program);
+            OpenGLShaderCache::Reject(OpenGLShaderCacheEntryKind::ProgramBinary, m_ProgramKey);
+            return false;
+        }
+
+        m_RendererID = program;
+        return true;
+    }
+
+    void OpenGLShader::StoreProgramBinary() const
+    {
+        GLint binaryLength = 0;
+        glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength <= 0)
+            return;
+
+        // 负载布局：binaryFormat（GLenum）+ 驱动二进制。
+        std::vector<uint8_t> payload(sizeof(GLenum) + static_cast<size_t>(binaryLength));
+        GLenum binaryFormat = 0;
+        GLsizei writtenLength = 0;
+        glGetProgramBinary(m_RendererID, binaryLength, &writtenLength, &binaryFormat,
+                           payload.data() + sizeof(GLenum));
+        if (writtenLength <= 0)
+            return;
+
+        std::memcpy(payload.data(), &binaryFormat, sizeof(binaryFormat));
+        payload.resize(sizeof(GLenum) + static_cast<size_t>(writtenLength));
+        OpenGLShaderCache::Store(OpenGLShaderCacheEntryKind::ProgramBinary, m_ProgramKey, payload.data(),
+                                 payload.size());
     }
 
-    void OpenGLShader::CreateProgram()
+    void OpenGLShader::CreateProgram(const StageBinaries &openGLSPIRV)
     {
         GLuint program = glCreateProgram();
+        if (m_ProgramKey != 0)
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
         std::vector<GLuint> shaderIDs;
-        for (auto &&[stage, spirv] : m_OpenGLSPIRV)
+        for (auto &&[stage, spirv] : openGLSPIRV)
         {
             GLuint shaderID = shaderIDs.emplace_back(glCreateShader(stage));
             glShaderBinary(1, &shaderID, GL_SHADER_BINARY_FORMAT_SPIR_V, spirv.data(),
@@ -410,12 +633,12 @@ namespace Himii
         m_RendererID = program;
     }
 
-    void OpenGLShader::Reflect(GLenum stage, const std::vector<uint32_t> &shaderData)
+    void OpenGLShader::Reflect(const std::string &cacheName, GLenum stage, const std::vector<uint32_t> &shaderData)
     {
         spirv_cross::Compiler compiler(shaderData);
         spirv_cross::ShaderResources resources = compiler.get_shader_resources();
 
-        HIMII_CORE_TRACE("OpenGLShader::Reflect - {0} {1}", Utils::GLShaderStageToString(stage), m_FilePath);
+        HIMII_CORE_TRACE("OpenGLShader::Reflect - {0} {1}", Utils::GLShaderStageToString(stage), cacheName);
         HIMII_CORE_TRACE("    {0} uniform buffers", resources.uniform_buffers.size());
         HIMII_CORE_TRACE("    {0} resources", resources.sampled_images.size());
 
@@ -10,6 +10,14 @@ namespace Himii
     class OpenGLShader : public Shader
     {
     public:
+        /// CPU 编译阶段（shaderc / spirv-cross），不触碰 GL，可在工作线程调用。
+        /// keepForLink 为 true 时结果暂存于进程内，随后同源的构造只做链接。
+        static ShaderPrecompileResult PrecompileFile(const std::string &filepath, bool keepForLink);
+        static ShaderPrecompileResult Precompile(const std::string &name, const std::string &vertexSource,
+                                                 const std::string &fragmentSource, bool keepForLink);
+        /// 丢弃未被消费的预编译结果（预热后未创建的着色器）。
+        static void ClearPrecompiledStages();
+
         OpenGLShader(const std::string &filepath);
         OpenGLShader(const std::string &name, const std::string &vertexSource,
                      const std::string &fragmentSource);
@@ -44,23 +52,40 @@ namespace Himii
         void UploadUniformMat4(const std::string &name, const glm::mat4 &matrix);
 
     private:
-        std::string ReadFile(const std::string &filepath);
-        std::unordered_map<GLenum, std::string> PreProcess(const std::string &source);
-        uint64_t ComputeSourceHash(const std::unordered_map<GLenum, std::string> &shaderSources) const;
-        std::filesystem::path BuildCachePath(GLenum stage, const char *extension) const;
-        void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string> &shaderSources);
-        void CompileOrGetOpenGLBinaries();
-        void CreateProgram();
-        void Reflect(GLenum stage, const std::vector<uint32_t> &shaderData);
+        using StageSources = std::unordered_map<GLenum, std::string>;
+        using StageBinaries = std::unordered_map<GLenum, std::vector<uint32_t>>;
+
+        using StageKeys = std::unordered_map<GLenum, uint64_t>;
+
+        static std::string ReadFile(const std::string &filepath);
+        static StageSources PreProcess(const std::string &source);
+        /// 仅用于进程内交接预编译结果，取原始源码即可。
+        static uint64_t ComputeSourceHash(const std::string &cacheName, const StageSources &shaderSources);
+        /// 缓存键：预处理后源码 + 阶段 + 编译参数 + 编译器版本。
+        static bool ComputeStageKeys(const std::string &cacheName, const StageSources &shaderSources,
+                                     StageKeys &outVulkanKeys, StageKeys &outOpenGLKeys);
+        /// 驱动不支持程序二进制（或无 GL 上下文）时返回 0。
+        static uint64_t ComputeProgramKey(const StageKeys &openGLKeys);
+        static bool CompileOrGetVulkanBinaries(const std::string &cacheName, const StageSources &shaderSources,
+                                               const StageKeys &vulkanKeys, StageBinaries &outVulkanSPIRV,
+                                               bool &outCacheHit);
+        static bool CompileOrGetOpenGLBinaries(const std::string &cacheName, const StageBinaries &vulkanSPIRV,
+                                               const StageKeys &openGLKeys, StageBinaries &outOpenGLSPIRV,
+                                               bool &outCacheHit);
+        static ShaderPrecompileResult PrecompileStages(const std::string &cacheName, const StageSources &sources,
+                                                       bool keepForLink);
+        static void Reflect(const std::string &cacheName, GLenum stage, const std::vector<uint32_t> &shaderData);
+
+        void BuildProgram(const StageSources &shaderSources);
+        bool CreateProgramFromBinary();
+        void StoreProgramBinary() const;
+        void CreateProgram(const StageBinaries &openGLSPIRV);
 
     private:
         uint32_t m_RendererID = 0;
         uint64_t m_SourceHash = 0;
+        uint64_t m_ProgramKey = 0;
         std::string m_FilePath;
         std::string m_Name;
-
-        std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
-        std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
-        std::unordered_map<GLenum, std::string> m_OpenGLSourceCode;
     };
 } // namespace Himii
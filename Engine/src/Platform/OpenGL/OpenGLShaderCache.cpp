@@ -0,0 +1,473 @@
+#include "Hepch.h"
+#include "Platform/OpenGL/OpenGLShaderCache.h"
+#include "EngineCore/Core/FileSystem.h"
+#include "EngineCore/Core/Hash.h"
+#include "EngineCore/Core/Log.h"
+#include "EngineCore/Utils/PlatformUtils.h"
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr char ShaderCacheMagic[4] = {'H', 'S', 'C', 'C'};
+        constexpr uint32_t ShaderCacheFormatVersion = 1u;
+        /// 超出后 Flush 按最久未使用淘汰；一个工程的全部变体通常只占几 MB。
+        constexpr uint64_t ShaderCacheCapacityBytes = 64ull * 1024ull * 1024ull;
+        constexpr uint64_t ShaderCacheBlobAlignment = 4ull;
+
+#pragma pack(push, 1)
+        struct ShaderCacheFileHeader
+        {
+            char Magic[4];
+            uint32_t Version = ShaderCacheFormatVersion;
+            uint32_t EntryCount = 0;
+            uint32_t Reserved = 0;
+            uint64_t UseCounter = 0;
+        };
+
+        struct ShaderCacheIndexRecord
+        {
+            uint64_t Key = 0;
+            uint64_t Offset = 0;
+            uint64_t LastUse = 0;
+            uint64_t Checksum = 0;
+            uint32_t Size = 0;
+            uint8_t Kind = 0;
+            uint8_t Padding[3] = {};
+        };
+#pragma pack(pop)
+
+        struct ShaderCacheEntry
+        {
+            OpenGLShaderCacheEntryKind Kind = OpenGLShaderCacheEntryKind::VulkanSPIRV;
+            uint64_t Offset = 0;
+            uint32_t Size = 0;
+            uint64_t LastUse = 0;
+            uint64_t Checksum = 0;
+            // 尚未写入文件的新条目；Flush 后清空，改为引用映射中的数据。
+            std::vector<uint8_t> PendingData;
+        };
+
+        struct ShaderCacheState
+        {
+            std::mutex Mutex;
+            bool Opened = false;
+            bool StructureDirty = false;
+            bool UsageDirty = false;
+            uint64_t UseCounter = 0;
+            std::unordered_map<uint64_t, ShaderCacheEntry> Entries;
+            PlatformMappedFile MappedFile;
+            ShaderCacheStatistics Statistics;
+        };
+
+        ShaderCacheState s_Cache;
+        std::atomic<uint64_t> s_DriverSignature{0};
+
+        std::filesystem::path GetCacheDirectory()
+        {
+            return FileSystem::GetWritableCacheRoot() / "shader" / "opengl";
+        }
+
+        std::filesystem::path GetCacheFilePath()
+        {
+            return GetCacheDirectory() / "ShaderCache.bin";
+        }
+
+        bool IsBytecodeKind(OpenGLShaderCacheEntryKind kind)
+        {
+            return kind == OpenGLShaderCacheEntryKind::VulkanSPIRV || kind == OpenGLShaderCacheEntryKind::OpenGLSPIRV;
+        }
+
+        /// 旧版每阶段一个散文件的缓存，数据库建立后不再读取。
+        void RemoveLegacyCacheFiles(const std::filesystem::path &cacheDirectory)
+        {
+            std::error_code errorCode;
+            uint32_t removedCount = 0;
+            for (const auto &entry : std::filesystem::directory_iterator(cacheDirectory, errorCode))
+            {
+                const std::string fileName = entry.path().filename().string();
+                if (fileName.find(".cached_vulkan.") != std::string::npos
+                    || fileName.find(".cached_opengl.") != std::string::npos)
+                {
+                    std::error_code removeError;
+                    if (std::filesystem::remove(entry.path(), removeError))
+                        ++removedCount;
+                }
+            }
+            if (removedCount > 0)
+                HIMII_CORE_INFO("Removed {0} legacy shader cache file(s) from {1}", removedCount,
+                                cacheDirectory.string());
+        }
+
+        bool ReadIndex(ShaderCacheState &cache)
+        {
+            const uint8_t *fileBytes = cache.MappedFile.GetData();
+            const size_t fileSize = cache.MappedFile.GetSize();
+            if (fileSize < sizeof(ShaderCacheFileHeader))
+                return false;
+
+            ShaderCacheFileHeader header = {};
+            std::memcpy(&header, fileBytes, sizeof(header));
+            if (std::memcmp(header.Magic, ShaderCacheMagic, sizeof(ShaderCacheMagic)) != 0
+                || header.Version != ShaderCacheFormatVersion)
+                return false;
+
+            const uint64_t indexEnd =
+                    sizeof(ShaderCacheFileHeader) + static_cast<uint64_t>(header.EntryCount) * sizeof(ShaderCacheIndexRecord);
+            if (indexEnd > fileSize)
+                return false;
+
+            cache.Entries.reserve(header.EntryCount);
+            for (uint32_t recordIndex = 0; recordIndex < header.EntryCount; ++recordIndex)
+            {
+                ShaderCacheIndexRecord record = {};
+                std::memcpy(&record,
+                            fileBytes + sizeof(ShaderCacheFileHeader) + recordIndex * sizeof(ShaderCacheIndexRecord),
+                            sizeof(record));
+                if (record.Offset < indexEnd || record.Offset + record.Size > fileSize)
+                    return false;
+
+                ShaderCacheEntry &entry = cache.Entries[record.Key];
+                entry.Kind = static_cast<OpenGLShaderCacheEntryKind>(record.Kind);
+                entry.Offset = record.Offset;
+                entry.Size = record.Size;
+                entry.LastUse = record.LastUse;
+                entry.Checksum = record.Checksum;
+                entry.PendingData.clear();
+                cache.Statistics.SizeBytes += record.Size;
+            }
+            cache.UseCounter = header.UseCounter;
+            return true;
+        }
+
+        void EnsureOpened(ShaderCacheState &cache)
+        {
+            if (cache.Opened)
+                return;
+            cache.Opened = true;
+            cache.Statistics.CapacityBytes = ShaderCacheCapacityBytes;
+
+            const std::filesystem::path cacheDirectory = GetCacheDirectory();
+            std::error_code errorCode;
+            std::filesystem::create_directories(cacheDirectory, errorCode);
+
+            const std::filesystem::path cacheFilePath = GetCacheFilePath();
+            if (!std::filesystem::exists(cacheFilePath, errorCode))
+            {
+                RemoveLegacyCacheFiles(cacheDirectory);
+                return;
+            }
+
+            if (!cache.MappedFile.Open(cacheFilePath) || !ReadIndex(cache))
+            {
+                HIMII_CORE_WARNING("Shader cache {0} is unreadable; it will be rebuilt", cacheFilePath.string());
+                cache.Entries.clear();
+                cache.Statistics.SizeBytes = 0;
+                cache.UseCounter = 0;
+                cache.MappedFile.Close();
+                cache.StructureDirty = true;
+            }
+        }
+
+        const uint8_t *GetEntryData(const ShaderCacheState &cache, const ShaderCacheEntry &entry)
+        {
+            if (!entry.PendingData.empty())
+                return entry.PendingData.data();
+            return cache.MappedFile.GetData() + entry.Offset;
+        }
+
+        void RemoveEntry(ShaderCacheState &cache, std::unordered_map<uint64_t, ShaderCacheEntry>::iterator found)
+        {
+            cache.Statistics.SizeBytes -= found->second.Size;
+            cache.Entries.erase(found);
+            cache.StructureDirty = true;
+        }
+
+        void EvictLeastRecentlyUsed(ShaderCacheState &cache)
+        {
+            if (cache.Statistics.SizeBytes <= ShaderCacheCapacityBytes)
+                return;
+
+            std::vector<std::pair<uint64_t, uint64_t>> entriesByUse;
+            entriesByUse.reserve(cache.Entries.size());
+            for (const auto &[key, entry] : cache.Entries)
+                entriesByUse.emplace_back(entry.LastUse, key);
+            std::sort(entriesByUse.begin(), entriesByUse.end());
+
+            for (const auto &[lastUse, key] : entriesByUse)
+            {
+                if (cache.Statistics.SizeBytes <= ShaderCacheCapacityBytes)
+                    break;
+                RemoveEntry(cache, cache.Entries.find(key));
+                ++cache.Statistics.Evictions;
+            }
+        }
+
+        bool WriteCacheFile(ShaderCacheState &cache)
+        {
+            const std::filesystem::path cacheFilePath = GetCacheFilePath();
+            std::filesystem::path temporaryPath = cacheFilePath;
+            temporaryPath += ".tmp";
+
+            // 索引按键排序，文件内容与哈希表遍历顺序无关。
+            std::vector<uint64_t> keys;
+            keys.reserve(cache.Entries.size());
+            for (const auto &[key, entry] : cache.Entries)
+                keys.push_back(key);
+            std::sort(keys.begin(), keys.end());
+
+            ShaderCacheFileHeader header = {};
+            std::memcpy(header.Magic, ShaderCacheMagic, sizeof(ShaderCacheMagic));
+            header.EntryCount = static_cast<uint32_t>(keys.size());
+            header.UseCounter = cache.UseCounter;
+
+            std::vector<ShaderCacheIndexRecord> records(keys.size());
+            uint64_t blobOffset =
+                    sizeof(ShaderCacheFileHeader) + static_cast<uint64_t>(keys.size()) * sizeof(ShaderCacheIndexRecord);
+            for (size_t keyIndex = 0; keyIndex < keys.size(); ++keyIndex)
+            {
+                const ShaderCacheEntry &entry = cache.Entries.at(keys[keyIndex]);
+                blobOffset = (blobOffset + ShaderCacheBlobAlignment - 1) & ~(ShaderCacheBlobAlignment - 1);
+
+                ShaderCacheIndexRecord &record = records[keyIndex];
+                record.Key = keys[keyIndex];
+                record.Offset = blobOffset;
+                record.LastUse = entry.LastUse;
+                record.Checksum = entry.Checksum;
+                record.Size = entry.Size;
+                record.Kind = static_cast<uint8_t>(entry.Kind);
+                blobOffset += entry.Size;
+            }
+
+            bool written = false;
+            {
+                std::ofstream outputStream(temporaryPath, std::ios::binary | std::ios::trunc);
+                if (!outputStream.is_open())
+                {
+                    HIMII_CORE_ERROR("Failed to write shader cache: {0}", temporaryPath.string());
+                    return false;
+                }
+
+                outputStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                if (!records.empty())
+                    outputStream.write(reinterpret_cast<const char *>(records.data()),
+                                       static_cast<std::streamsize>(records.size() * sizeof(ShaderCacheIndexRecord)));
+
+                const char padding[ShaderCacheBlobAlignment] = {};
+                uint64_t writtenBytes =
+                        sizeof(ShaderCacheFileHeader) + records.size() * sizeof(ShaderCacheIndexRecord);
+                for (const ShaderCacheIndexRecord &record : records)
+                {
+                    outputStream.write(padding, static_cast<std::streamsize>(record.Offset - writtenBytes));
+                    outputStream.write(reinterpret_cast<const char *>(GetEntryData(cache, cache.Entries.at(record.Key))),
+                                       record.Size);
+                    writtenBytes = record.Offset + record.Size;
+                }
+                outputStream.close();
+                written = !outputStream.fail();
+            }
+
+            std::error_code errorCode;
+            if (!written)
+            {
+                std::filesystem::remove(temporaryPath, errorCode);
+                HIMII_CORE_ERROR("Failed to write shader cache: {0}", temporaryPath.string());
+                return false;
+            }
+
+            // 数据已全部写入临时文件，可以放开旧映射再替换（Windows 上映射中的文件无法被覆盖）。
+            cache.MappedFile.Close();
+            std::filesystem::rename(temporaryPath, cacheFilePath, errorCode);
+            if (errorCode)
+            {
+                HIMII_CORE_ERROR("Failed to replace shader cache {0}: {1}", cacheFilePath.string(),
+                                 errorCode.message());
+                std::filesystem::remove(temporaryPath, errorCode);
+                // 旧映射已关闭：仅保留仍在内存中的条目，其余待下次重建。
+                for (auto it = cache.Entries.begin(); it != cache.Entries.end();)
+                {
+                    if (it->second.PendingData.empty())
+                    {
+                        cache.Statistics.SizeBytes -= it->second.Size;
+                        it = cache.Entries.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+                return false;
+            }
+
+            if (!cache.MappedFile.Open(cacheFilePath))
+            {
+                HIMII_CORE_ERROR("Failed to map rewritten shader cache: {0}", cacheFilePath.string());
+                cache.Entries.clear();
+                cache.Statistics.SizeBytes = 0;
+                return false;
+            }
+
+            for (const ShaderCacheIndexRecord &record : records)
+            {
+                ShaderCacheEntry &entry = cache.Entries.at(record.Key);
+                entry.Offset = record.Offset;
+                entry.PendingData.clear();
+                entry.PendingData.shrink_to_fit();
+            }
+            return true;
+        }
+    }
+
+    void OpenGLShaderCache::InitializeProgramBinarySupport()
+    {
+        GLint binaryFormatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+        if (binaryFormatCount <= 0)
+        {
+            HIMII_CORE_INFO("OpenGL driver exposes no program binary formats; shader program cache disabled");
+            s_DriverSignature = 0;
+            return;
+        }
+
+        uint64_t signature = FnvOffsetBasis;
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+        {
+            const char *value = reinterpret_cast<const char *>(glGetString(name));
+            if (value)
+                signature = HashBytes(value, std::strlen(value), signature);
+            signature = HashBytes("\n", 1, signature);
+        }
+        s_DriverSignature = signature == 0 ? 1 : signature;
+    }
+
+    uint64_t OpenGLShaderCache::GetDriverSignature()
+    {
+        return s_DriverSignature;
+    }
+
+    bool OpenGLShaderCache::Contains(OpenGLShaderCacheEntryKind kind, uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        EnsureOpened(s_Cache);
+        auto found = s_Cache.Entries.find(key);
+        return found != s_Cache.Entries.end() && found->second.Kind == kind;
+    }
+
+    bool OpenGLShaderCache::Load(OpenGLShaderCacheEntryKind kind, uint64_t key, std::vector<uint8_t> &outData)
+    {
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        EnsureOpened(s_Cache);
+
+        const bool bytecode = IsBytecodeKind(kind);
+        auto found = s_Cache.Entries.find(key);
+        if (found == s_Cache.Entries.end() || found->second.Kind != kind)
+        {
+            ++(bytecode ? s_Cache.Statistics.BytecodeMisses : s_Cache.Statistics.ProgramBinaryMisses);
+            return false;
+        }
+
+        ShaderCacheEntry &entry = found->second;
+        const uint8_t *entryData = GetEntryData(s_Cache, entry);
+        if (HashBytes(entryData, entry.Size) != entry.Checksum)
+        {
+            HIMII_CORE_WARNING("Shader cache entry {0:016x} is corrupt; recompiling", key);
+            RemoveEntry(s_Cache, found);
+            ++(bytecode ? s_Cache.Statistics.BytecodeMisses : s_Cache.Statistics.ProgramBinaryMisses);
+            return false;
+        }
+
+        outData.assign(entryData, entryData + entry.Size);
+        entry.LastUse = ++s_Cache.UseCounter;
+        s_Cache.UsageDirty = true;
+        ++(bytecode ? s_Cache.Statistics.BytecodeHits : s_Cache.Statistics.ProgramBinaryHits);
+        return true;
+    }
+
+    void OpenGLShaderCache::Store(OpenGLShaderCacheEntryKind kind, uint64_t key, const void *data, size_t size)
+    {
+        if (!data || size == 0 || size > UINT32_MAX)
+            return;
+
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        EnsureOpened(s_Cache);
+
+        auto found = s_Cache.Entries.find(key);
+        if (found != s_Cache.Entries.end())
+            RemoveEntry(s_Cache, found);
+
+        ShaderCacheEntry &entry = s_Cache.Entries[key];
+        entry.Kind = kind;
+        entry.Size = static_cast<uint32_t>(size);
+        entry.LastUse = ++s_Cache.UseCounter;
+        entry.PendingData.assign(static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + size);
+        entry.Checksum = HashBytes(entry.PendingData.data(), size);
+        s_Cache.Statistics.SizeBytes += size;
+        s_Cache.StructureDirty = true;
+    }
+
+    void OpenGLShaderCache::Reject(OpenGLShaderCacheEntryKind kind, uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        auto found = s_Cache.Entries.find(key);
+        if (found == s_Cache.Entries.end() || found->second.Kind != kind)
+            return;
+
+        RemoveEntry(s_Cache, found);
+        if (kind == OpenGLShaderCacheEntryKind::ProgramBinary)
+            ++s_Cache.Statistics.ProgramBinaryRejected;
+    }
+
+    bool OpenGLShaderCache::Flush(bool persistUsage)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        if (!s_Cache.Opened)
+            return true;
+        // 仅 LRU 时间戳变化时默认不重写整个文件，留到关闭时一并写回。
+        if (!s_Cache.StructureDirty && !(persistUsage && s_Cache.UsageDirty))
+            return true;
+
+        EvictLeastRecentlyUsed(s_Cache);
+        if (!WriteCacheFile(s_Cache))
+            return false;
+
+        s_Cache.StructureDirty = false;
+        s_Cache.UsageDirty = false;
+        return true;
+    }
+
+    void OpenGLShaderCache::Shutdown()
+    {
+        Flush(true);
+
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        s_Cache.MappedFile.Close();
+        s_Cache.Entries.clear();
+        s_Cache.Statistics.SizeBytes = 0;
+        s_Cache.Opened = false;
+        s_Cache.StructureDirty = false;
+        s_Cache.UsageDirty = false;
+    }
+
+    ShaderCacheStatistics OpenGLShaderCache::GetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(s_Cache.Mutex);
+        EnsureOpened(s_Cache);
+
+        ShaderCacheStatistics statistics = s_Cache.Statistics;
+        statistics.EntryCount = static_cast<uint32_t>(s_Cache.Entries.size());
+        return statistics;
+    }
+}
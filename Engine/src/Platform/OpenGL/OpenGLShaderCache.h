@@ -0,0 +1,42 @@
+#pragma once
+#include "EngineCore/Core/Core.h"
+#include "Module/Render/RenderCore/Shader.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Himii
+{
+    enum class OpenGLShaderCacheEntryKind : uint8_t
+    {
+        VulkanSPIRV = 1,
+        OpenGLSPIRV = 2,
+        /// 驱动程序二进制（glGetProgramBinary），负载首 4 字节为 binaryFormat。
+        ProgramBinary = 3
+    };
+
+    /// 着色器缓存数据库：单个文件（头部 + 索引表 + 数据区），按内容哈希寻址。
+    /// 打开时映射整个文件并把索引读入哈希表，查找 O(1)；新条目先留在内存，Flush 时整体重写并按 LRU 淘汰。
+    /// 所有接口线程安全，可在 JobSystem 工作线程调用。
+    class OpenGLShaderCache
+    {
+    public:
+        /// 需在 GL 上下文当前时调用（OpenGLRendererAPI::Init）；驱动不支持程序二进制时保持关闭。
+        static void InitializeProgramBinarySupport();
+        /// 驱动标识（厂商 / 渲染器 / 版本）哈希，参与程序二进制的键；0 表示不可用（含无窗口模式）。
+        static uint64_t GetDriverSignature();
+
+        static bool Contains(OpenGLShaderCacheEntryKind kind, uint64_t key);
+        static bool Load(OpenGLShaderCacheEntryKind kind, uint64_t key, std::vector<uint8_t> &outData);
+        static void Store(OpenGLShaderCacheEntryKind kind, uint64_t key, const void *data, size_t size);
+        /// 驱动拒绝了缓存的程序二进制（驱动更新后常见），移除该条目。
+        static void Reject(OpenGLShaderCacheEntryKind kind, uint64_t key);
+
+        /// 有新增或删除条目时重写缓存文件；persistUsage 时即使只有 LRU 时间戳变化也写回。
+        static bool Flush(bool persistUsage = false);
+        /// 写回（含 LRU 时间戳）并解除映射；之后再次访问会重新打开。
+        static void Shutdown();
+
+        static ShaderCacheStatistics GetStatistics();
+    };
+}
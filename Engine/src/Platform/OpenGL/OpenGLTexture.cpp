@@ -2,9 +2,28 @@
 #include "EngineCore/Core/Log.h"
 #include "EngineCore/Core/FileSystem.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Module/Render/RenderCore/TextureMipGenerator.h"
+#include "Module/Render/RenderCore/TextureBlockCompression.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+// glad 只生成核心档时缺少 S3TC 扩展常量；RGTC / BPTC 已属核心，保留兜底。
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RED_RGTC1
+#define GL_COMPRESSED_RED_RGTC1 0x8DBB
+#endif
+#ifndef GL_COMPRESSED_RG_RGTC2
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
 namespace Himii
 {
     namespace Utils
@@ -25,6 +44,14 @@ namespace Himii
                     return GL_RGB;
                 case ImageFormat::RG16F:
                     return GL_RG;
+                case ImageFormat::BC1_RGBA:
+                case ImageFormat::BC3_RGBA:
+                case ImageFormat::BC7_RGBA:
+                    return GL_RGBA;
+                case ImageFormat::BC4_R:
+                    return GL_RED;
+                case ImageFormat::BC5_RG:
+                    return GL_RG;
                 default:
                     break;
             }
@@ -49,6 +76,16 @@ namespace Himii
                     return GL_RGB16F;
                 case ImageFormat::RG16F:
                     return GL_RG16F;
+                case ImageFormat::BC1_RGBA:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                case ImageFormat::BC3_RGBA:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case ImageFormat::BC4_R:
+                    return GL_COMPRESSED_RED_RGTC1;
+                case ImageFormat::BC5_RG:
+                    return GL_COMPRESSED_RG_RGTC2;
+                case ImageFormat::BC7_RGBA:
+                    return GL_COMPRESSED_RGBA_BPTC_UNORM;
                 default:
                     break;
             }
@@ -86,6 +123,13 @@ namespace Himii
                     return 12;
                 case ImageFormat::RG16F:
                     return 8;
+                case ImageFormat::BC1_RGBA:
+                case ImageFormat::BC3_RGBA:
+                case ImageFormat::BC4_R:
+                case ImageFormat::BC5_RG:
+                case ImageFormat::BC7_RGBA:
+                    // 块压缩格式没有逐像素大小，按块走 GetCompressedImageByteSize。
+                    return 0;
                 default:
                     break;
             }
@@ -103,12 +147,22 @@ namespace Himii
         m_DataFormat = Utils::ImageFormatToGLDataFormat(specification.Format);
         m_BytesPerPixel = Utils::ImageFormatBytesPerPixel(specification.Format);
 
+        m_MipLevelCount = specification.GenerateMips ? CalculateTextureMipLevelCount(m_Width, m_Height) : 1;
+
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+        glTextureStorage2D(m_RendererID, static_cast<GLsizei>(m_MipLevelCount), m_InternalFormat, m_Width,
+                           m_Height);
 
-        const GLint filter = specification.UseLinearFiltering ? GL_LINEAR : GL_NEAREST;
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, filter);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, filter);
+        const GLint magFilter = specification.UseLinearFiltering ? GL_LINEAR : GL_NEAREST;
+        // 点采样贴图在层间线性混合：放大保持像素锐利，缩小不再闪烁。
+        const GLint minFilter = m_MipLevelCount > 1
+                                        ? (specification.UseLinearFiltering ? GL_LINEAR_MIPMAP_LINEAR
+                                                                            : GL_NEAREST_MIPMAP_LINEAR)
+                                        : magFilter;
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, magFilter);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_BASE_LEVEL, 0);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_MipLevelCount - 1));
 
         const GLint wrap = specification.ClampToEdge ? GL_CLAMP_TO_EDGE : GL_REPEAT;
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, wrap);
@@ -136,7 +190,11 @@ namespace Himii
         CreateStorage(specification);
     }
 
-    OpenGLTexture::OpenGLTexture(const std::string &path) : m_Path(path)
+    OpenGLTexture::OpenGLTexture(const std::string &path) : OpenGLTexture(path, TextureLoadSettings{})
+    {
+    }
+
+    OpenGLTexture::OpenGLTexture(const std::string &path, const TextureLoadSettings &loadSettings) : m_Path(path)
     {
         HIMII_PROFILE_FUNCTION();
 
@@ -162,16 +220,54 @@ namespace Himii
         specification.Format = ImageFormat::RGBA8;
         specification.ClampToEdge = false;
         specification.UseLinearFiltering = false;
+        specification.GenerateMips = loadSettings.GenerateMips;
         CreateStorage(specification);
 
+        std::vector<TextureMipLevel> mipLevels;
+        if (m_MipLevelCount > 1)
+            GenerateRgba8MipChain(data, m_Width, m_Height, loadSettings, mipLevels);
+
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE,
                             data);
+        for (size_t levelIndex = 0; levelIndex < mipLevels.size(); ++levelIndex)
+        {
+            const TextureMipLevel &level = mipLevels[levelIndex];
+            glTextureSubImage2D(m_RendererID, static_cast<GLint>(levelIndex + 1), 0, 0,
+                                static_cast<GLsizei>(level.Width), static_cast<GLsizei>(level.Height),
+                                m_DataFormat, GL_UNSIGNED_BYTE, level.Pixels.data());
+        }
         glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
         stbi_image_free(data);
     }
 
+    OpenGLTexture::OpenGLTexture(const std::string &path, const TextureSpecification &specification,
+                                 const std::vector<CompressedTextureMip> &mips) : m_Path(path)
+    {
+        HIMII_PROFILE_FUNCTION();
+        HIMII_CORE_ASSERT(IsBlockCompressedFormat(specification.Format), "Compressed upload requires a BC format!");
+
+        TextureSpecification storageSpecification = specification;
+        storageSpecification.GenerateMips = mips.size() > 1;
+        CreateStorage(storageSpecification);
+
+        const size_t levelCount = std::min<size_t>(mips.size(), m_MipLevelCount);
+        for (size_t levelIndex = 0; levelIndex < levelCount; ++levelIndex)
+        {
+            const CompressedTextureMip &mip = mips[levelIndex];
+            HIMII_CORE_ASSERT(mip.ByteSize == GetCompressedImageByteSize(specification.Format, mip.Width, mip.Height),
+                              "Compressed mip size mismatch!");
+            glCompressedTextureSubImage2D(m_RendererID, static_cast<GLint>(levelIndex), 0, 0,
+                                          static_cast<GLsizei>(mip.Width), static_cast<GLsizei>(mip.Height),
+                                          m_InternalFormat, static_cast<GLsizei>(mip.ByteSize), mip.Data);
+        }
+
+        // 烘焙链比存储短时（不应发生）截断可采样层级，避免采到未定义层。
+        if (levelCount < m_MipLevelCount && levelCount > 0)
+            glTextureParameteri(m_RendererID, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount - 1));
+    }
+
     OpenGLTexture::~OpenGLTexture()
     {
         HIMII_PROFILE_FUNCTION();
@@ -192,6 +288,8 @@ namespace Himii
         HIMII_PROFILE_FUNCTION();
         HIMII_CORE_ASSERT(offsetX + width <= m_Width && offsetY + height <= m_Height,
                           "Texture region out of bounds!");
+        HIMII_CORE_ASSERT(!IsBlockCompressedFormat(m_Specification.Format),
+                          "Block-compressed textures are immutable after upload!");
         HIMII_CORE_ASSERT(size == width * height * m_BytesPerPixel, "Region data size mismatch!");
 
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -200,6 +298,10 @@ namespace Himii
                 static_cast<GLsizei>(width), static_cast<GLsizei>(height), m_DataFormat,
                 Utils::ImageFormatToGLDataType(m_Specification.Format), data);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        // 运行时更新的纹理没有 CPU 链可用，退回驱动生成。
+        if (m_MipLevelCount > 1)
+            glGenerateTextureMipmap(m_RendererID);
     }
 
     void OpenGLTexture::Bind(uint32_t slot) const
@@ -10,6 +10,9 @@ namespace Himii
         OpenGLTexture(uint32_t width, uint32_t height);
         explicit OpenGLTexture(const TextureSpecification &specification);
         OpenGLTexture(const std::string &path);
+        OpenGLTexture(const std::string &path, const TextureLoadSettings &loadSettings);
+        OpenGLTexture(const std::string &path, const TextureSpecification &specification,
+                      const std::vector<CompressedTextureMip> &mips);
         virtual ~OpenGLTexture();
 
         virtual const TextureSpecification &GetSpecification() const override
@@ -30,6 +33,11 @@ namespace Himii
             return m_RendererID;
         }
 
+        virtual uint32_t GetMipLevelCount() const override
+        {
+            return m_MipLevelCount;
+        }
+
         virtual const std::string &GetPath() const override
         {
             return m_Path;
@@ -58,6 +66,7 @@ namespace Himii
         uint32_t m_Width = 0;
         uint32_t m_Height = 0;
         uint32_t m_RendererID = 0;
+        uint32_t m_MipLevelCount = 1;
         GLenum m_InternalFormat = GL_RGBA8;
         GLenum m_DataFormat = GL_RGBA;
         uint32_t m_BytesPerPixel = 4;
@@ -123,4 +123,82 @@ namespace Himii
     {
         return _putenv_s(name.c_str(), value.c_str()) == 0;
     }
+
+    PlatformFileFingerprint PlatformFileSystem::QueryFileFingerprint(const std::filesystem::path &filepath)
+    {
+        PlatformFileFingerprint fingerprint;
+        // 只申请属性访问权限，不与正在写入的进程冲突。
+        HANDLE fileHandle = CreateFileW(filepath.wstring().c_str(), FILE_READ_ATTRIBUTES,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return fingerprint;
+
+        BY_HANDLE_FILE_INFORMATION information{};
+        const bool queried = GetFileInformationByHandle(fileHandle, &information) != 0;
+        CloseHandle(fileHandle);
+        if (!queried)
+            return fingerprint;
+
+        fingerprint.Exists = true;
+        fingerprint.Size = (static_cast<uint64_t>(information.nFileSizeHigh) << 32) | information.nFileSizeLow;
+        const FILETIME &writeTime = information.ftLastWriteTime;
+        fingerprint.ModifiedTime = static_cast<int64_t>(
+                (static_cast<uint64_t>(writeTime.dwHighDateTime) << 32) | writeTime.dwLowDateTime);
+        fingerprint.FileId = (static_cast<uint64_t>(information.nFileIndexHigh) << 32) | information.nFileIndexLow;
+        return fingerprint;
+    }
+
+    PlatformMappedFile::~PlatformMappedFile()
+    {
+        Close();
+    }
+
+    bool PlatformMappedFile::Open(const std::filesystem::path &filepath)
+    {
+        Close();
+
+        // FILE_SHARE_DELETE：允许导入在映射存活期间以临时文件 + 重命名的方式替换产物。
+        HANDLE fileHandle = CreateFileW(filepath.wstring().c_str(), GENERIC_READ,
+                                        FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        // 映射对象持有文件引用，文件句柄可立即关闭。
+        CloseHandle(fileHandle);
+        if (!mappingHandle)
+            return false;
+
+        const void *mappedAddress = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!mappedAddress)
+        {
+            CloseHandle(mappingHandle);
+            return false;
+        }
+
+        m_Data = static_cast<const uint8_t *>(mappedAddress);
+        m_Size = static_cast<size_t>(fileSize.QuadPart);
+        m_NativeMappingHandle = mappingHandle;
+        return true;
+    }
+
+    void PlatformMappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_NativeMappingHandle)
+            CloseHandle(static_cast<HANDLE>(m_NativeMappingHandle));
+        m_Data = nullptr;
+        m_Size = 0;
+        m_NativeMappingHandle = nullptr;
+    }
 } // namespace Himii
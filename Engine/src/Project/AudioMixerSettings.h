@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Himii
+{
+    /// 固定的两级总线：Music / SFX / UI / Voice 汇入 Master，Master 输出到设备。
+    enum class AudioBus : uint8_t
+    {
+        Master = 0,
+        Music = 1,
+        SFX = 2,
+        UI = 3,
+        Voice = 4
+    };
+
+    static constexpr int AudioBusCount = 5;
+
+    inline const char *GetAudioBusName(AudioBus bus)
+    {
+        static constexpr const char *BusNames[AudioBusCount] = {"Master", "Music", "SFX", "UI", "Voice"};
+        const int busIndex = static_cast<int>(bus);
+        return busIndex >= 0 && busIndex < AudioBusCount ? BusNames[busIndex] : "Unknown";
+    }
+
+    enum class AudioBusFilterType : uint8_t
+    {
+        None = 0,
+        LowPass = 1,
+        HighPass = 2
+    };
+
+    struct AudioBusSettings
+    {
+        /// 线性增益，作用在总线输出上。
+        float Gain = 1.0f;
+
+        /// 二阶 biquad（RBJ），截止频率超过 0.45 倍采样率时按 0.45 倍处理。
+        AudioBusFilterType FilterType = AudioBusFilterType::None;
+        float FilterCutoffHz = 1000.0f;
+        float FilterQ = 0.7071f;
+
+        /// 峰值限幅：逐帧立即压到阈值以下，按 LimiterReleaseSeconds 恢复。
+        bool LimiterEnabled = false;
+        float LimiterThreshold = 1.0f;
+        float LimiterReleaseSeconds = 0.1f;
+
+        /// 侧链闪避：DuckSource 总线的峰值超过 DuckThreshold 时把本总线压到 DuckGain。
+        bool DuckingEnabled = false;
+        AudioBus DuckSource = AudioBus::Voice;
+        float DuckThreshold = 0.02f;
+        float DuckGain = 0.3f;
+        float DuckAttackSeconds = 0.05f;
+        float DuckReleaseSeconds = 0.5f;
+    };
+
+    struct AudioMixerSettings
+    {
+        std::array<AudioBusSettings, AudioBusCount> Buses{};
+
+        AudioBusSettings &Get(AudioBus bus) { return Buses[static_cast<size_t>(bus)]; }
+        const AudioBusSettings &Get(AudioBus bus) const { return Buses[static_cast<size_t>(bus)]; }
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <algorithm>
+#include <cstdint>
 #include <string>
 
 #include <box2d/box2d.h>
@@ -9,6 +10,9 @@
 namespace Himii
 {
     static constexpr int Physics2DLayerCount = 8;
+    /// 只给场景查询用的类别位：没有形状属于它，但每个形状的 maskBits 都包含它，
+    /// 这样碰撞矩阵整行为空的层仍能被射线与重叠查询命中，且不影响形状间的碰撞。
+    static constexpr uint64_t Physics2DQueryCategoryBit = 1ull << 63;
 
     struct Physics2DLayerSettings
     {
@@ -26,6 +30,17 @@ namespace Himii
                     CollisionMatrix[row][column] = true;
         }
 
+        /// 按名称查找层下标，未找到返回 -1。
+        int FindLayer(const std::string &layerName) const
+        {
+            for (int layerIndex = 0; layerIndex < Physics2DLayerCount; ++layerIndex)
+            {
+                if (LayerNames[layerIndex] == layerName)
+                    return layerIndex;
+            }
+            return -1;
+        }
+
         b2Filter BuildShapeFilter(int layerIndex) const
         {
             b2Filter filter = b2DefaultFilter();
@@ -40,7 +55,7 @@ namespace Himii
                     maskBits |= (1u << static_cast<unsigned>(column));
             }
 
-            filter.maskBits = maskBits;
+            filter.maskBits = maskBits | Physics2DQueryCategoryBit;
             return filter;
         }
     };
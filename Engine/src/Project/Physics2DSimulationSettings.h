@@ -0,0 +1,24 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Himii
+{
+    struct Physics2DSimulationSettings
+    {
+        /// 每秒固定步数；物理与脚本 FixedUpdate 都按该频率推进，与渲染帧率无关。
+        uint32_t FixedUpdateRate = 60;
+        /// 单帧最多补跑的固定步数，超出部分的积压时间直接丢弃。
+        uint32_t MaxSubstepsPerFrame = 8;
+        /// 在最近两个物理状态之间插值写回 Transform，高刷新率下画面不随物理步长抖动。
+        bool InterpolateTransforms = true;
+        /// Box2D 求解线程数（含步进线程）；0 表示使用全部 JobSystem 工作线程，1 为单线程。
+        uint32_t WorkerCount = 0;
+
+        double GetFixedTimestep() const
+        {
+            return 1.0 / static_cast<double>(std::max<uint32_t>(FixedUpdateRate, 1));
+        }
+    };
+}
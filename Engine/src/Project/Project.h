@@ -6,7 +6,9 @@
 #include "Resource/ResourceSystem.h"
 #include "EngineCore/Core/Log.h"
 #include "Module/Script/ScriptIDE.h"
+#include "Project/AudioMixerSettings.h"
 #include "Project/Physics2DLayerSettings.h"
+#include "Project/Physics2DSimulationSettings.h"
 #include "Project/SortingLayerSettings.h"
 
 namespace Himii
@@ -24,7 +26,9 @@ namespace Himii
         std::string CustomScriptIDEArguments;
 
         Physics2DLayerSettings Physics2DLayers;
+        Physics2DSimulationSettings Physics2DSimulation;
         SortingLayerSettings SortingLayers;
+        AudioMixerSettings AudioMixer;
 	};
 
 	class Project {
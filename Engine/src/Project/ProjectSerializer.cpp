@@ -53,6 +53,16 @@ namespace Himii
                     out << YAML::EndMap;
                 }
 
+                out << YAML::Key << "Physics2DSimulation" << YAML::Value;
+                {
+                    out << YAML::BeginMap;
+                    out << YAML::Key << "FixedUpdateRate" << YAML::Value << config.Physics2DSimulation.FixedUpdateRate;
+                    out << YAML::Key << "MaxSubstepsPerFrame" << YAML::Value << config.Physics2DSimulation.MaxSubstepsPerFrame;
+                    out << YAML::Key << "InterpolateTransforms" << YAML::Value << config.Physics2DSimulation.InterpolateTransforms;
+                    out << YAML::Key << "WorkerCount" << YAML::Value << config.Physics2DSimulation.WorkerCount;
+                    out << YAML::EndMap;
+                }
+
                 out << YAML::Key << "SortingLayers" << YAML::Value;
                 {
                     out << YAML::BeginMap;
@@ -63,6 +73,32 @@ namespace Himii
                     out << YAML::EndMap;
                 }
 
+                out << YAML::Key << "AudioMixer" << YAML::Value;
+                {
+                    out << YAML::BeginMap;
+                    for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+                    {
+                        const AudioBusSettings &bus = config.AudioMixer.Buses[busIndex];
+                        out << YAML::Key << GetAudioBusName(static_cast<AudioBus>(busIndex)) << YAML::Value;
+                        out << YAML::BeginMap;
+                        out << YAML::Key << "Gain" << YAML::Value << bus.Gain;
+                        out << YAML::Key << "FilterType" << YAML::Value << (int)bus.FilterType;
+                        out << YAML::Key << "FilterCutoffHz" << YAML::Value << bus.FilterCutoffHz;
+                        out << YAML::Key << "FilterQ" << YAML::Value << bus.FilterQ;
+                        out << YAML::Key << "LimiterEnabled" << YAML::Value << bus.LimiterEnabled;
+                        out << YAML::Key << "LimiterThreshold" << YAML::Value << bus.LimiterThreshold;
+                        out << YAML::Key << "LimiterReleaseSeconds" << YAML::Value << bus.LimiterReleaseSeconds;
+                        out << YAML::Key << "DuckingEnabled" << YAML::Value << bus.DuckingEnabled;
+                        out << YAML::Key << "DuckSource" << YAML::Value << (int)bus.DuckSource;
+                        out << YAML::Key << "DuckThreshold" << YAML::Value << bus.DuckThreshold;
+                        out << YAML::Key << "DuckGain" << YAML::Value << bus.DuckGain;
+                        out << YAML::Key << "DuckAttackSeconds" << YAML::Value << bus.DuckAttackSeconds;
+                        out << YAML::Key << "DuckReleaseSeconds" << YAML::Value << bus.DuckReleaseSeconds;
+                        out << YAML::EndMap;
+                    }
+                    out << YAML::EndMap;
+                }
+
                 out << YAML::EndMap; // Project
             }
             out << YAML::EndMap; // Root
@@ -146,6 +182,21 @@ namespace Himii
             }
         }
 
+        if (auto physicsSimulationNode = projectNode["Physics2DSimulation"])
+        {
+            if (physicsSimulationNode["FixedUpdateRate"])
+                config.Physics2DSimulation.FixedUpdateRate =
+                        std::max(physicsSimulationNode["FixedUpdateRate"].as<uint32_t>(), 1u);
+            if (physicsSimulationNode["MaxSubstepsPerFrame"])
+                config.Physics2DSimulation.MaxSubstepsPerFrame =
+                        std::max(physicsSimulationNode["MaxSubstepsPerFrame"].as<uint32_t>(), 1u);
+            if (physicsSimulationNode["InterpolateTransforms"])
+                config.Physics2DSimulation.InterpolateTransforms =
+                        physicsSimulationNode["InterpolateTransforms"].as<bool>();
+            if (physicsSimulationNode["WorkerCount"])
+                config.Physics2DSimulation.WorkerCount = physicsSimulationNode["WorkerCount"].as<uint32_t>();
+        }
+
         if (auto sortingLayersNode = projectNode["SortingLayers"])
         {
             if (auto layerNamesNode = sortingLayersNode["LayerNames"])
@@ -159,6 +210,44 @@ namespace Himii
             }
         }
 
+        if (auto audioMixerNode = projectNode["AudioMixer"])
+        {
+            for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+            {
+                auto busNode = audioMixerNode[GetAudioBusName(static_cast<AudioBus>(busIndex))];
+                if (!busNode)
+                    continue;
+
+                AudioBusSettings &bus = config.AudioMixer.Buses[busIndex];
+                if (busNode["Gain"])
+                    bus.Gain = std::max(busNode["Gain"].as<float>(), 0.0f);
+                if (busNode["FilterType"])
+                    bus.FilterType = (AudioBusFilterType)std::clamp(busNode["FilterType"].as<int>(), 0, 2);
+                if (busNode["FilterCutoffHz"])
+                    bus.FilterCutoffHz = busNode["FilterCutoffHz"].as<float>();
+                if (busNode["FilterQ"])
+                    bus.FilterQ = busNode["FilterQ"].as<float>();
+                if (busNode["LimiterEnabled"])
+                    bus.LimiterEnabled = busNode["LimiterEnabled"].as<bool>();
+                if (busNode["LimiterThreshold"])
+                    bus.LimiterThreshold = busNode["LimiterThreshold"].as<float>();
+                if (busNode["LimiterReleaseSeconds"])
+                    bus.LimiterReleaseSeconds = busNode["LimiterReleaseSeconds"].as<float>();
+                if (busNode["DuckingEnabled"])
+                    bus.DuckingEnabled = busNode["DuckingEnabled"].as<bool>();
+                if (busNode["DuckSource"])
+                    bus.DuckSource = (AudioBus)std::clamp(busNode["DuckSource"].as<int>(), 0, AudioBusCount - 1);
+                if (busNode["DuckThreshold"])
+                    bus.DuckThreshold = busNode["DuckThreshold"].as<float>();
+                if (busNode["DuckGain"])
+                    bus.DuckGain = busNode["DuckGain"].as<float>();
+                if (busNode["DuckAttackSeconds"])
+                    bus.DuckAttackSeconds = busNode["DuckAttackSeconds"].as<float>();
+                if (busNode["DuckReleaseSeconds"])
+                    bus.DuckReleaseSeconds = busNode["DuckReleaseSeconds"].as<float>();
+            }
+        }
+
         return true;
     }
 }
@@ -7,6 +7,7 @@
 #include "Module/Render/Shader/ShaderAsset.h"
 #include "Module/Render/Shader/ShaderCompilationService.h"
 #include "Resource/AssetSerializerRegistry.h"
+#include "Resource/TextureCooker.h"
 #include "Resource/TextureImportSerializer.h"
 #include "Resource/SpriteSheetUtility.h"
 #include "yaml-cpp/yaml.h"
@@ -39,7 +40,8 @@ namespace Himii
 
     void AssetManager::ClearCachedAssetLoadFailure(AssetHandle handle)
     {
-        m_FailedAssetLoadHandles.erase(handle);
+        if (m_FailedAssetLoadHandles.erase(handle) > 0)
+            ++m_AssetGeneration;
     }
 
     Ref<Asset> AssetManager::GetAsset(AssetHandle handle)
@@ -96,6 +98,9 @@ namespace Himii
             }
             m_LoadedAssets[handle] = asset;
             m_AssetRegistry[handle].IsLoaded = true;
+            // 纹理重载（先卸载再加载）换了对象，已编译材质的纹理绑定表必须重建。
+            if (metadataForLoad.Type == AssetType::Texture2D)
+                ++m_AssetGeneration;
         }
         else if (metadataForLoad.Type == AssetType::Mesh)
         {
@@ -218,6 +223,7 @@ namespace Himii
     {
         m_LoadedAssets.erase(handle);
         m_FailedAssetLoadHandles.erase(handle);
+        ++m_AssetGeneration;
         auto iterator = m_AssetRegistry.find(handle);
         if (iterator != m_AssetRegistry.end())
             iterator->second.IsLoaded = false;
@@ -286,6 +292,7 @@ namespace Himii
 
         m_AssetRegistry.clear();
         m_LoadedAssets.clear();
+        ++m_AssetGeneration;
         m_TextureImportData.clear();
         m_SpriteRegistry.clear();
         m_FailedAssetLoadHandles.clear();
@@ -392,6 +399,46 @@ namespace Himii
         return TextureImportSerializer::Serialize(filesystemPath, iterator->second);
     }
 
+    bool AssetManager::CookTexture(AssetHandle textureHandle, TextureCookReport *outReport)
+    {
+        if (!IsAssetHandleValid(textureHandle))
+            return false;
+
+        const AssetMetadata& metadata = m_AssetRegistry.at(textureHandle);
+        if (metadata.Type != AssetType::Texture2D)
+            return false;
+
+        std::filesystem::path filesystemPath = Project::GetAssetFileSystemPath(metadata.FilePath);
+        TextureImportData importData;
+        if (const TextureImportData* loadedImportData = GetTextureImportData(textureHandle))
+            importData = *loadedImportData;
+        else if (!TextureImportSerializer::Deserialize(filesystemPath, importData))
+            return false;
+        return TextureCooker::Cook(filesystemPath, importData, outReport);
+    }
+
+    bool AssetManager::NeedsTextureCook(AssetHandle textureHandle)
+    {
+        if (!IsAssetHandleValid(textureHandle))
+            return false;
+
+        const AssetMetadata& metadata = m_AssetRegistry.at(textureHandle);
+        if (metadata.Type != AssetType::Texture2D)
+            return false;
+
+        // 构建流程会遍历全部纹理：只读已有 meta，不为未配置的纹理生成默认 meta。
+        std::filesystem::path filesystemPath = Project::GetAssetFileSystemPath(metadata.FilePath);
+        TextureImportData importData;
+        if (const TextureImportData* loadedImportData = GetTextureImportData(textureHandle))
+            importData = *loadedImportData;
+        else if (!TextureImportSerializer::Deserialize(filesystemPath, importData))
+            return false;
+        if (importData.Compression == TextureCompression::None)
+            return false;
+
+        return !TextureCooker::IsCookedTextureCurrent(filesystemPath, importData);
+    }
+
     void AssetManager::EnsureDefaultTextureMeta(AssetHandle textureHandle)
     {
         if (m_TextureImportData.find(textureHandle) != m_TextureImportData.end())
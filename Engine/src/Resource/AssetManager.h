@@ -11,6 +11,7 @@
 namespace Himii
 {
     class MaterialAsset;
+    struct TextureCookReport;
 
     using AssetRegistry = std::map<AssetHandle, AssetMetadata>;
 
@@ -53,6 +54,11 @@ namespace Himii
         bool SaveTextureImportData(AssetHandle textureHandle);
 
         void EnsureDefaultTextureMeta(AssetHandle textureHandle);
+
+        /// 按纹理 .meta 的 Compression 烘焙 .htex；None 或源图片无法解码时返回 false。
+        bool CookTexture(AssetHandle textureHandle, TextureCookReport *outReport = nullptr);
+        /// Compression 非 None 且 .htex 缺失或过期。
+        bool NeedsTextureCook(AssetHandle textureHandle);
         void ApplyGridSliceToTexture(AssetHandle textureHandle);
 
         const SpriteDefinition* GetSpriteDefinition(AssetHandle spriteHandle) const;
@@ -65,6 +71,9 @@ namespace Himii
         AssetHandle GetTextureHandleForSprite(AssetHandle spriteAssetHandle) const;
 
         void UnloadAsset(AssetHandle handle);
+        /// 资产卸载、纹理加载 / 重载、失败缓存清除时递增；持有已解析资产引用的缓存
+        /// （如 CompiledMaterial 与其绑定表）据此判断是否过期。
+        uint64_t GetAssetGeneration() const { return m_AssetGeneration; }
 
         /// 本会话内该 Handle 已加载失败；跳过后续反序列化以避免重复日志。
         bool HasCachedAssetLoadFailure(AssetHandle handle) const;
@@ -85,5 +94,6 @@ namespace Himii
         std::unordered_map<AssetHandle, TextureImportData> m_TextureImportData;
         std::unordered_map<AssetHandle, SpriteRegistryEntry> m_SpriteRegistry;
         std::unordered_set<AssetHandle> m_FailedAssetLoadHandles;
+        uint64_t m_AssetGeneration = 0;
     };
 } // namespace Himii
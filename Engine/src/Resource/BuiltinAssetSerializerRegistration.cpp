@@ -16,6 +16,8 @@
 #include "Module/Render/RenderCore/Texture.h"
 #include "Module/Tilemap/TileMapDataSerializer.h"
 #include "Module/Tilemap/TileSetSerializer.h"
+#include "Resource/TextureCooker.h"
+#include "Resource/TextureImportSerializer.h"
 
 namespace Himii
 {
@@ -50,7 +52,16 @@ namespace Himii
 
             Ref<Asset> Deserialize(const std::filesystem::path &filepath) override
             {
-                return Texture2D::Create(filepath.string());
+                // mip 选项存放在同目录的纹理 .meta 中；无 meta 时按默认单层加载。
+                TextureImportData importData;
+                TextureImportSerializer::Deserialize(filepath, importData);
+                // 有最新的 .htex 时直接上传压缩块；缺失或过期退回解码源图片。
+                if (importData.Compression != TextureCompression::None)
+                {
+                    if (Ref<Texture2D> cookedTexture = TextureCooker::LoadCooked(filepath, importData))
+                        return cookedTexture;
+                }
+                return Texture2D::Create(filepath.string(), importData.LoadSettings);
             }
         };
 
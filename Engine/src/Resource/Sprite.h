@@ -38,6 +38,11 @@ namespace Himii
         glm::ivec2 GridOffset{0, 0};
         glm::ivec2 GridPadding{0, 0};
         std::vector<SpriteDefinition> Sprites;
+        // 加载时的 mip 链生成选项；默认关闭，保持像素风精灵的旧行为。
+        TextureLoadSettings LoadSettings{};
+        // 烘焙为 .htex 时的用途与块压缩格式；None 时运行时仍解码源图片。
+        TextureUsage Usage = TextureUsage::Color;
+        TextureCompression Compression = TextureCompression::None;
     };
 
     struct SpriteResolved
@@ -0,0 +1,445 @@
+#include "Hepch.h"
+#include "Resource/TextureCooker.h"
+#include "EngineCore/Core/Hash.h"
+#include "EngineCore/Core/Log.h"
+#include "EngineCore/Core/Timer.h"
+#include "EngineCore/Utils/PlatformUtils.h"
+#include "Module/Render/RenderCore/TextureBlockCompression.h"
+#include "Module/Render/RenderCore/TextureMipGenerator.h"
+
+#include "stb_image.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Himii
+{
+    constexpr uint32_t HtexFormatVersion = 1u;
+
+    namespace
+    {
+        constexpr char HtexMagic[4] = {'H', 'T', 'E', 'X'};
+        constexpr uint64_t HtexDataAlignment = 16u;
+
+        /// 文件内格式码与 ImageFormat 枚举序号解耦，保证增删枚举不破坏已有 .htex。
+        enum class HtexBlockFormat : uint32_t
+        {
+            BC1 = 1,
+            BC3 = 3,
+            BC4 = 4,
+            BC5 = 5,
+            BC7 = 7
+        };
+
+#pragma pack(push, 1)
+        struct HtexFileHeader
+        {
+            char Magic[4];
+            uint32_t Version = HtexFormatVersion;
+            uint32_t Format = 0;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            uint32_t MipCount = 0;
+            uint64_t SourceFileSize = 0;
+            int64_t SourceWriteTime = 0;
+            uint64_t SettingsHash = 0;
+        };
+
+        struct HtexMipEntry
+        {
+            uint64_t Offset = 0;
+            uint32_t ByteSize = 0;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            uint32_t Reserved = 0;
+        };
+#pragma pack(pop)
+
+        struct SourceFingerprint
+        {
+            uint64_t FileSize = 0;
+            int64_t WriteTime = 0;
+        };
+
+        static bool ReadSourceFingerprint(const std::filesystem::path &textureFilesystemPath,
+                                          SourceFingerprint &outFingerprint)
+        {
+            std::error_code errorCode;
+            const uintmax_t fileSize = std::filesystem::file_size(textureFilesystemPath, errorCode);
+            if (errorCode)
+                return false;
+            const auto writeTime = std::filesystem::last_write_time(textureFilesystemPath, errorCode);
+            if (errorCode)
+                return false;
+
+            outFingerprint.FileSize = static_cast<uint64_t>(fileSize);
+            outFingerprint.WriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+            return true;
+        }
+
+        static void HashCombine(uint64_t &hash, uint64_t value)
+        {
+            hash = HashValue(value, hash);
+        }
+
+        /// 影响烘焙输出的全部设置；精灵切分等只影响 UV 的字段不参与。
+        static uint64_t ComputeSettingsHash(const TextureImportData &importData)
+        {
+            uint64_t hash = FnvOffsetBasis;
+            HashCombine(hash, HtexFormatVersion);
+            HashCombine(hash, static_cast<uint64_t>(importData.Usage));
+            HashCombine(hash, static_cast<uint64_t>(importData.Compression));
+            HashCombine(hash, importData.LoadSettings.GenerateMips ? 1u : 0u);
+            HashCombine(hash, static_cast<uint64_t>(importData.LoadSettings.MipFilter));
+            HashCombine(hash, importData.LoadSettings.SRGB ? 1u : 0u);
+            HashCombine(hash, importData.LoadSettings.AlphaWeightedMipFiltering ? 1u : 0u);
+            return hash;
+        }
+
+        static bool ToHtexBlockFormat(ImageFormat format, HtexBlockFormat &outFormat)
+        {
+            switch (format)
+            {
+                case ImageFormat::BC1_RGBA: outFormat = HtexBlockFormat::BC1; return true;
+                case ImageFormat::BC3_RGBA: outFormat = HtexBlockFormat::BC3; return true;
+                case ImageFormat::BC4_R: outFormat = HtexBlockFormat::BC4; return true;
+                case ImageFormat::BC5_RG: outFormat = HtexBlockFormat::BC5; return true;
+                case ImageFormat::BC7_RGBA: outFormat = HtexBlockFormat::BC7; return true;
+                default: return false;
+            }
+        }
+
+        static ImageFormat FromHtexBlockFormat(uint32_t value)
+        {
+            switch (static_cast<HtexBlockFormat>(value))
+            {
+                case HtexBlockFormat::BC1: return ImageFormat::BC1_RGBA;
+                case HtexBlockFormat::BC3: return ImageFormat::BC3_RGBA;
+                case HtexBlockFormat::BC4: return ImageFormat::BC4_R;
+                case HtexBlockFormat::BC5: return ImageFormat::BC5_RG;
+                case HtexBlockFormat::BC7: return ImageFormat::BC7_RGBA;
+                default: return ImageFormat::None;
+            }
+        }
+
+        /// 校验头部与 mip 表；成功时 outMipTable 指向映射内存。
+        static bool ValidateHtex(const PlatformMappedFile &mappedFile, HtexFileHeader &outHeader,
+                                 const HtexMipEntry *&outMipTable)
+        {
+            if (mappedFile.GetSize() < sizeof(HtexFileHeader))
+                return false;
+
+            std::memcpy(&outHeader, mappedFile.GetData(), sizeof(HtexFileHeader));
+            if (std::memcmp(outHeader.Magic, HtexMagic, sizeof(HtexMagic)) != 0
+                || outHeader.Version != HtexFormatVersion || outHeader.MipCount == 0
+                || outHeader.MipCount > 32u)
+                return false;
+
+            const uint64_t mipTableEnd = sizeof(HtexFileHeader) + uint64_t(outHeader.MipCount) * sizeof(HtexMipEntry);
+            if (mappedFile.GetSize() < mipTableEnd)
+                return false;
+
+            outMipTable = reinterpret_cast<const HtexMipEntry *>(mappedFile.GetData() + sizeof(HtexFileHeader));
+            for (uint32_t mipIndex = 0; mipIndex < outHeader.MipCount; ++mipIndex)
+            {
+                const HtexMipEntry &entry = outMipTable[mipIndex];
+                if (entry.Offset + entry.ByteSize > mappedFile.GetSize())
+                    return false;
+            }
+            return true;
+        }
+
+        static bool WriteExact(std::ofstream &outputStream, const void *buffer, std::size_t byteCount)
+        {
+            outputStream.write(static_cast<const char *>(buffer), static_cast<std::streamsize>(byteCount));
+            return outputStream.good();
+        }
+
+        static bool HasTranslucentPixels(const uint8_t *rgbaPixels, size_t pixelCount)
+        {
+            for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+            {
+                if (rgbaPixels[pixelIndex * 4 + 3] != 255)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    std::filesystem::path TextureCooker::GetCookedPath(const std::filesystem::path &textureFilesystemPath)
+    {
+        return textureFilesystemPath.string() + ".htex";
+    }
+
+    ImageFormat TextureCooker::ResolveCompressedFormat(const TextureImportData &importData, bool hasTranslucentPixels)
+    {
+        switch (importData.Compression)
+        {
+            case TextureCompression::BC1: return ImageFormat::BC1_RGBA;
+            case TextureCompression::BC3: return ImageFormat::BC3_RGBA;
+            case TextureCompression::BC4: return ImageFormat::BC4_R;
+            case TextureCompression::BC5: return ImageFormat::BC5_RG;
+            case TextureCompression::BC7: return ImageFormat::BC7_RGBA;
+            case TextureCompression::Auto:
+                switch (importData.Usage)
+                {
+                    case TextureUsage::NormalMap: return ImageFormat::BC5_RG;
+                    case TextureUsage::Mask: return ImageFormat::BC4_R;
+                    default: return hasTranslucentPixels ? ImageFormat::BC7_RGBA : ImageFormat::BC1_RGBA;
+                }
+            default:
+                return ImageFormat::None;
+        }
+    }
+
+    bool TextureCooker::IsCookedTextureCurrent(const std::filesystem::path &textureFilesystemPath,
+                                               const TextureImportData &importData)
+    {
+        if (importData.Compression == TextureCompression::None)
+            return false;
+
+        SourceFingerprint fingerprint;
+        if (!ReadSourceFingerprint(textureFilesystemPath, fingerprint))
+            return false;
+
+        std::ifstream inputStream(GetCookedPath(textureFilesystemPath), std::ios::binary);
+        if (!inputStream.is_open())
+            return false;
+
+        HtexFileHeader header = {};
+        inputStream.read(reinterpret_cast<char *>(&header), sizeof(HtexFileHeader));
+        if (!inputStream.good() || std::memcmp(header.Magic, HtexMagic, sizeof(HtexMagic)) != 0)
+            return false;
+
+        return header.Version == HtexFormatVersion && header.SourceFileSize == fingerprint.FileSize
+               && header.SourceWriteTime == fingerprint.WriteTime
+               && header.SettingsHash == ComputeSettingsHash(importData);
+    }
+
+    bool TextureCooker::Cook(const std::filesystem::path &textureFilesystemPath, const TextureImportData &importData,
+                             TextureCookReport *outReport)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (importData.Compression == TextureCompression::None)
+            return false;
+
+        Timer cookTimer;
+        SourceFingerprint fingerprint;
+        if (!ReadSourceFingerprint(textureFilesystemPath, fingerprint))
+        {
+            HIMII_CORE_ERROR("Failed to cook texture, source missing: {0}", textureFilesystemPath.string());
+            return false;
+        }
+
+        int width = 0;
+        int height = 0;
+        int sourceChannels = 0;
+        // 与 OpenGLTexture 的运行时加载保持同一朝向。
+        stbi_set_flip_vertically_on_load(1);
+        stbi_uc *pixels = nullptr;
+        {
+            std::ifstream inputStream(textureFilesystemPath, std::ios::binary);
+            std::vector<uint8_t> fileBytes((std::istreambuf_iterator<char>(inputStream)),
+                                           std::istreambuf_iterator<char>());
+            if (!fileBytes.empty())
+                pixels = stbi_load_from_memory(fileBytes.data(), static_cast<int>(fileBytes.size()), &width,
+                                               &height, &sourceChannels, 4);
+        }
+        if (!pixels)
+        {
+            HIMII_CORE_ERROR("Failed to cook texture, cannot decode: {0}", textureFilesystemPath.string());
+            return false;
+        }
+
+        const uint32_t baseWidth = static_cast<uint32_t>(width);
+        const uint32_t baseHeight = static_cast<uint32_t>(height);
+        const size_t basePixelCount = static_cast<size_t>(baseWidth) * baseHeight;
+        const ImageFormat format =
+                ResolveCompressedFormat(importData, HasTranslucentPixels(pixels, basePixelCount));
+
+        HtexBlockFormat blockFormat = HtexBlockFormat::BC1;
+        if (!ToHtexBlockFormat(format, blockFormat))
+        {
+            stbi_image_free(pixels);
+            return false;
+        }
+
+        // 法线 / 遮罩是数据贴图：不做 sRGB 解码与 alpha 加权，否则 mip 层会偏移数值。
+        TextureLoadSettings mipSettings = importData.LoadSettings;
+        if (importData.Usage != TextureUsage::Color)
+        {
+            mipSettings.SRGB = false;
+            mipSettings.AlphaWeightedMipFiltering = false;
+        }
+
+        std::vector<TextureMipLevel> mipLevels;
+        if (importData.LoadSettings.GenerateMips)
+            GenerateRgba8MipChain(pixels, baseWidth, baseHeight, mipSettings, mipLevels);
+
+        const uint32_t mipCount = static_cast<uint32_t>(mipLevels.size()) + 1u;
+        std::vector<HtexMipEntry> mipTable(mipCount);
+        std::vector<std::vector<uint8_t>> compressedLevels(mipCount);
+
+        uint64_t dataOffset = sizeof(HtexFileHeader) + uint64_t(mipCount) * sizeof(HtexMipEntry);
+        uint64_t uncompressedBytes = 0;
+        double basePsnr = 0.0;
+        for (uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex)
+        {
+            const uint8_t *levelPixels = mipIndex == 0 ? pixels : mipLevels[mipIndex - 1].Pixels.data();
+            const uint32_t levelWidth = mipIndex == 0 ? baseWidth : mipLevels[mipIndex - 1].Width;
+            const uint32_t levelHeight = mipIndex == 0 ? baseHeight : mipLevels[mipIndex - 1].Height;
+
+            std::vector<uint8_t> &blocks = compressedLevels[mipIndex];
+            blocks.resize(GetCompressedImageByteSize(format, levelWidth, levelHeight));
+            CompressRgba8Image(levelPixels, levelWidth, levelHeight, format, blocks.data());
+
+            // PSNR 只评估基础层：它决定了近处观感，也是体积的主要来源。
+            if (mipIndex == 0)
+            {
+                std::vector<uint8_t> decoded(basePixelCount * 4u);
+                DecompressToRgba8Image(blocks.data(), levelWidth, levelHeight, format, decoded.data());
+                basePsnr = ComputeBlockCompressionPsnr(levelPixels, decoded.data(), levelWidth, levelHeight, format);
+            }
+
+            dataOffset = (dataOffset + HtexDataAlignment - 1u) & ~(HtexDataAlignment - 1u);
+            mipTable[mipIndex].Offset = dataOffset;
+            mipTable[mipIndex].ByteSize = static_cast<uint32_t>(blocks.size());
+            mipTable[mipIndex].Width = levelWidth;
+            mipTable[mipIndex].Height = levelHeight;
+            dataOffset += blocks.size();
+            uncompressedBytes += uint64_t(levelWidth) * levelHeight * 4u;
+        }
+        stbi_image_free(pixels);
+
+        HtexFileHeader header = {};
+        std::memcpy(header.Magic, HtexMagic, sizeof(HtexMagic));
+        header.Format = static_cast<uint32_t>(blockFormat);
+        header.Width = baseWidth;
+        header.Height = baseHeight;
+        header.MipCount = mipCount;
+        header.SourceFileSize = fingerprint.FileSize;
+        header.SourceWriteTime = fingerprint.WriteTime;
+        header.SettingsHash = ComputeSettingsHash(importData);
+
+        // 旧 .htex 可能正被映射上传：写临时文件后整体替换。
+        const std::filesystem::path cookedPath = GetCookedPath(textureFilesystemPath);
+        std::filesystem::path temporaryPath = cookedPath;
+        temporaryPath += ".tmp";
+
+        bool written = false;
+        {
+            std::ofstream outputStream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!outputStream.is_open())
+            {
+                HIMII_CORE_ERROR("Failed to write .htex file: {0}", cookedPath.string());
+                return false;
+            }
+
+            written = WriteExact(outputStream, &header, sizeof(HtexFileHeader))
+                      && WriteExact(outputStream, mipTable.data(), mipTable.size() * sizeof(HtexMipEntry));
+            const char padding[HtexDataAlignment] = {};
+            for (uint32_t mipIndex = 0; written && mipIndex < mipCount; ++mipIndex)
+            {
+                const uint64_t position = static_cast<uint64_t>(outputStream.tellp());
+                written = WriteExact(outputStream, padding, static_cast<size_t>(mipTable[mipIndex].Offset - position))
+                          && WriteExact(outputStream, compressedLevels[mipIndex].data(),
+                                        compressedLevels[mipIndex].size());
+            }
+            outputStream.close();
+            written = written && !outputStream.fail();
+        }
+
+        std::error_code errorCode;
+        if (written)
+            std::filesystem::rename(temporaryPath, cookedPath, errorCode);
+        if (!written || errorCode)
+        {
+            HIMII_CORE_ERROR("Failed to replace .htex file {0}", cookedPath.string());
+            std::filesystem::remove(temporaryPath, errorCode);
+            return false;
+        }
+
+        TextureCookReport report;
+        report.Format = format;
+        report.Width = baseWidth;
+        report.Height = baseHeight;
+        report.MipCount = mipCount;
+        report.UncompressedBytes = uncompressedBytes;
+        report.CookedBytes = dataOffset;
+        report.Psnr = basePsnr;
+        report.ElapsedMilliseconds = cookTimer.ElapsedMillis();
+
+        HIMII_CORE_INFO("Cooked texture {0}: {1} {2}x{3}, {4} mips, {5} KB -> {6} KB ({7:.1f}%), PSNR {8:.2f} dB, "
+                        "{9:.1f} ms",
+                        textureFilesystemPath.filename().string(), GetFormatName(format), baseWidth, baseHeight,
+                        mipCount, uncompressedBytes / 1024u, report.CookedBytes / 1024u,
+                        uncompressedBytes > 0 ? 100.0 * double(report.CookedBytes) / double(uncompressedBytes) : 0.0,
+                        report.Psnr, report.ElapsedMilliseconds);
+
+        if (outReport)
+            *outReport = report;
+        return true;
+    }
+
+    Ref<Texture2D> TextureCooker::LoadCooked(const std::filesystem::path &textureFilesystemPath,
+                                             const TextureImportData &importData)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!IsCookedTextureCurrent(textureFilesystemPath, importData))
+            return nullptr;
+
+        PlatformMappedFile mappedFile;
+        if (!mappedFile.Open(GetCookedPath(textureFilesystemPath)))
+            return nullptr;
+
+        HtexFileHeader header = {};
+        const HtexMipEntry *mipTable = nullptr;
+        if (!ValidateHtex(mappedFile, header, mipTable))
+        {
+            HIMII_CORE_WARNING("Ignoring corrupt .htex for {0}", textureFilesystemPath.string());
+            return nullptr;
+        }
+
+        const ImageFormat format = FromHtexBlockFormat(header.Format);
+        if (format == ImageFormat::None)
+            return nullptr;
+
+        std::vector<CompressedTextureMip> mips(header.MipCount);
+        for (uint32_t mipIndex = 0; mipIndex < header.MipCount; ++mipIndex)
+        {
+            HtexMipEntry entry;
+            std::memcpy(&entry, &mipTable[mipIndex], sizeof(HtexMipEntry));
+            mips[mipIndex].Data = mappedFile.GetData() + entry.Offset;
+            mips[mipIndex].ByteSize = entry.ByteSize;
+            mips[mipIndex].Width = entry.Width;
+            mips[mipIndex].Height = entry.Height;
+        }
+
+        TextureSpecification specification;
+        specification.Width = header.Width;
+        specification.Height = header.Height;
+        specification.Format = format;
+        specification.ClampToEdge = false;
+        specification.UseLinearFiltering = false;
+        specification.GenerateMips = header.MipCount > 1;
+
+        // 驱动在上传调用内拷贝数据，返回后即可解除映射。
+        return Texture2D::Create(textureFilesystemPath.string(), specification, mips);
+    }
+
+    const char *TextureCooker::GetFormatName(ImageFormat format)
+    {
+        switch (format)
+        {
+            case ImageFormat::BC1_RGBA: return "BC1";
+            case ImageFormat::BC3_RGBA: return "BC3";
+            case ImageFormat::BC4_R: return "BC4";
+            case ImageFormat::BC5_RG: return "BC5";
+            case ImageFormat::BC7_RGBA: return "BC7";
+            case ImageFormat::RGBA8: return "RGBA8";
+            default: return "None";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Resource/Sprite.h"
+#include <filesystem>
+
+namespace Himii
+{
+    /// 一次烘焙的结果，用于日志与检视面板显示。
+    struct TextureCookReport
+    {
+        ImageFormat Format = ImageFormat::None;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t MipCount = 0;
+        uint64_t UncompressedBytes = 0;
+        uint64_t CookedBytes = 0;
+        double Psnr = 0.0;
+        float ElapsedMilliseconds = 0.0f;
+    };
+
+    /// 将源图片烘焙为 .htex（块压缩 + 完整 mip 链），运行时映射文件后逐层直接上传，不再解码 PNG。
+    /// .htex 与源图片同目录：<texture>.htex，以源文件大小 / 修改时间与导入设置哈希判断是否过期。
+    class TextureCooker
+    {
+    public:
+        static std::filesystem::path GetCookedPath(const std::filesystem::path &textureFilesystemPath);
+
+        /// importData.Compression 为 None 时返回 ImageFormat::None；Auto 按用途与是否含透明像素选择。
+        static ImageFormat ResolveCompressedFormat(const TextureImportData &importData, bool hasTranslucentPixels);
+
+        static bool IsCookedTextureCurrent(const std::filesystem::path &textureFilesystemPath,
+                                           const TextureImportData &importData);
+
+        static bool Cook(const std::filesystem::path &textureFilesystemPath, const TextureImportData &importData,
+                         TextureCookReport *outReport = nullptr);
+
+        /// .htex 缺失、过期或损坏时返回 nullptr，调用方退回源图片加载。
+        static Ref<Texture2D> LoadCooked(const std::filesystem::path &textureFilesystemPath,
+                                         const TextureImportData &importData);
+
+        static const char *GetFormatName(ImageFormat format);
+    };
+}
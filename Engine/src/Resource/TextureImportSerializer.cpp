@@ -39,6 +39,72 @@ namespace Himii
         }
     }
 
+    static TextureMipFilter MipFilterFromString(const std::string& value)
+    {
+        if (value == "Kaiser")
+            return TextureMipFilter::Kaiser;
+        return TextureMipFilter::Box;
+    }
+
+    static std::string MipFilterToString(TextureMipFilter filter)
+    {
+        switch (filter)
+        {
+            case TextureMipFilter::Kaiser: return "Kaiser";
+            default: return "Box";
+        }
+    }
+
+    static TextureUsage UsageFromString(const std::string& value)
+    {
+        if (value == "NormalMap")
+            return TextureUsage::NormalMap;
+        if (value == "Mask")
+            return TextureUsage::Mask;
+        return TextureUsage::Color;
+    }
+
+    static std::string UsageToString(TextureUsage usage)
+    {
+        switch (usage)
+        {
+            case TextureUsage::NormalMap: return "NormalMap";
+            case TextureUsage::Mask: return "Mask";
+            default: return "Color";
+        }
+    }
+
+    static TextureCompression CompressionFromString(const std::string& value)
+    {
+        if (value == "Auto")
+            return TextureCompression::Auto;
+        if (value == "BC1")
+            return TextureCompression::BC1;
+        if (value == "BC3")
+            return TextureCompression::BC3;
+        if (value == "BC4")
+            return TextureCompression::BC4;
+        if (value == "BC5")
+            return TextureCompression::BC5;
+        if (value == "BC7")
+            return TextureCompression::BC7;
+        return TextureCompression::None;
+    }
+
+    static std::string CompressionToString(TextureCompression compression)
+    {
+        switch (compression)
+        {
+            case TextureCompression::Auto: return "Auto";
+            case TextureCompression::BC1: return "BC1";
+            case TextureCompression::BC3: return "BC3";
+            case TextureCompression::BC4: return "BC4";
+            case TextureCompression::BC5: return "BC5";
+            case TextureCompression::BC7: return "BC7";
+            default: return "None";
+        }
+    }
+
     static glm::ivec4 ReadPixelRect(const YAML::Node& node)
     {
         glm::ivec4 rect{0, 0, 0, 0};
@@ -91,6 +157,22 @@ namespace Himii
             outImportData.GridOffset = ReadIVec2(data["GridOffset"]);
             outImportData.GridPadding = ReadIVec2(data["GridPadding"]);
 
+            if (data["GenerateMips"])
+                outImportData.LoadSettings.GenerateMips = data["GenerateMips"].as<bool>();
+            if (data["MipFilter"])
+                outImportData.LoadSettings.MipFilter = MipFilterFromString(data["MipFilter"].as<std::string>());
+            if (data["SRGB"])
+                outImportData.LoadSettings.SRGB = data["SRGB"].as<bool>();
+            // 旧 .meta 用的键名是 PremultipliedAlpha，含义相同。
+            if (data["AlphaWeightedMipFiltering"])
+                outImportData.LoadSettings.AlphaWeightedMipFiltering = data["AlphaWeightedMipFiltering"].as<bool>();
+            else if (data["PremultipliedAlpha"])
+                outImportData.LoadSettings.AlphaWeightedMipFiltering = data["PremultipliedAlpha"].as<bool>();
+            if (data["Usage"])
+                outImportData.Usage = UsageFromString(data["Usage"].as<std::string>());
+            if (data["Compression"])
+                outImportData.Compression = CompressionFromString(data["Compression"].as<std::string>());
+
             outImportData.Sprites.clear();
             if (data["Sprites"])
             {
@@ -152,6 +234,14 @@ namespace Himii
             << YAML::Flow << YAML::BeginSeq
             << importData.GridPadding.x << importData.GridPadding.y << YAML::EndSeq;
 
+        out << YAML::Key << "GenerateMips" << YAML::Value << importData.LoadSettings.GenerateMips;
+        out << YAML::Key << "MipFilter" << YAML::Value << MipFilterToString(importData.LoadSettings.MipFilter);
+        out << YAML::Key << "SRGB" << YAML::Value << importData.LoadSettings.SRGB;
+        out << YAML::Key << "AlphaWeightedMipFiltering" << YAML::Value
+            << importData.LoadSettings.AlphaWeightedMipFiltering;
+        out << YAML::Key << "Usage" << YAML::Value << UsageToString(importData.Usage);
+        out << YAML::Key << "Compression" << YAML::Value << CompressionToString(importData.Compression);
+
         out << YAML::Key << "Sprites" << YAML::Value << YAML::BeginSeq;
         for (const SpriteDefinition& sprite : importData.Sprites)
         {
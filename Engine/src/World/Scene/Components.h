@@ -6,6 +6,7 @@
 #include "Module/Render/Renderer/Font.h"
 #include "Module/Audio/SoundAsset.h"
 #include "Module/Audio/AudioEngine.h"
+#include "Module/Render/Mesh/CompiledMaterial.h"
 #include "Resource/Sprite.h"
 #include "Module/Animation/SpriteAnimation.h"
 
@@ -134,6 +135,8 @@ namespace Himii
         MeshType Type = MeshType::Cube;
         AssetHandle MeshAssetHandle = 0;
         std::vector<AssetHandle> MaterialAssetHandles;
+        /// 运行时缓存（不序列化）：按槽位保存材质解析结果，渲染时免去逐次 GetAsset。
+        std::vector<CompiledMaterialSlot> CompiledMaterialSlots;
 
         MeshComponent() = default;
         MeshComponent(const MeshComponent&) = default;
@@ -471,6 +474,12 @@ namespace Himii
         bool Mute = false;
         bool Loop = false;
         bool PlayOnStart = false;
+        /// 真实 voice 不够用时优先级高的先播放。
+        int Priority = AudioEngine::DefaultVoicePriority;
+        /// 启用后按 Transform 位置与主相机的距离衰减和声像。
+        AudioSpatialSettings Spatial;
+        /// 输出到的混音总线。
+        AudioBus Bus = AudioBus::SFX;
 
         // 运行时主轨，不序列化
         AudioVoiceHandle RuntimeVoiceHandle = AudioEngine::InvalidVoiceHandle;
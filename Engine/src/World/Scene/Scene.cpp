@@ -28,11 +28,21 @@
 
 namespace Himii
 {
-    Scene::Scene() = default;
+    Scene::Scene()
+    {
+        m_Registry.on_construct<CanvasComponent>().connect<&Scene::OnUserInterfaceComponentChanged>(*this);
+        m_Registry.on_destroy<CanvasComponent>().connect<&Scene::OnUserInterfaceComponentChanged>(*this);
+        m_Registry.on_construct<RectTransformComponent>().connect<&Scene::OnUserInterfaceComponentChanged>(*this);
+        m_Registry.on_destroy<RectTransformComponent>().connect<&Scene::OnUserInterfaceComponentChanged>(*this);
+    }
 
     Scene::~Scene()
     {
         m_OwningWorld = nullptr;
+        m_Registry.on_construct<CanvasComponent>().disconnect(*this);
+        m_Registry.on_destroy<CanvasComponent>().disconnect(*this);
+        m_Registry.on_construct<RectTransformComponent>().disconnect(*this);
+        m_Registry.on_destroy<RectTransformComponent>().disconnect(*this);
     }
 
     WorldModuleRegistry &Scene::GetWorldModuleRegistry()
@@ -61,6 +71,15 @@ namespace Himii
                 physics2DWorld->SyncEntityTransform(entity);
         }
     }
+
+    void Scene::NotifyTilemapTileChanged(const TileMapData *mapData, int32_t tileX, int32_t tileY)
+    {
+        if (m_OwningWorld)
+        {
+            if (Physics2DWorld *physics2DWorld = m_OwningWorld->GetPhysics2DWorld())
+                physics2DWorld->MarkTilemapTileDirty(mapData, tileX, tileY);
+        }
+    }
     Entity Scene::CreateEntityWithUUID(UUID uuid, const std::string &name)
     {
         Entity entity(m_Registry.create(), this);
@@ -143,6 +162,7 @@ namespace Himii
 
         if (auto *identifierComponent = m_Registry.try_get<IDComponent>(entityHandle))
         {
+            ScriptEngine::OnEntityDestroyed(identifierComponent->ID);
             auto identifierIterator = m_EntityMap.find(identifierComponent->ID);
             if (identifierIterator != m_EntityMap.end())
                 m_EntityMap.erase(identifierIterator);
@@ -199,6 +219,9 @@ namespace Himii
         }
 
         {
+            if (Project::GetActive())
+                AudioEngine::SetMixerSettings(Project::GetConfig().AudioMixer);
+
             auto soundView = m_Registry.view<SoundPlayerComponent>();
             for (auto entityHandle : soundView)
             {
@@ -206,7 +229,8 @@ namespace Himii
                 soundPlayer.RuntimeVoiceHandle = AudioEngine::InvalidVoiceHandle;
                 soundPlayer.RuntimePaused = false;
                 if (soundPlayer.PlayOnStart)
-                    SoundPlayerUtility::Play(soundPlayer);
+                    SoundPlayerUtility::Play(
+                            soundPlayer, glm::vec3(GetEntityWorldTransformMatrix(Entity{entityHandle, this})[3]));
             }
         }
     }
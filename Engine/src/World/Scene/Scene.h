@@ -9,6 +9,7 @@
 #include "Module/Render/Renderer/EditorCamera.h"
 #include "World/Scene/SceneCamera.h"
 #include "Module/Render/RenderCore/Texture.h"
+#include "Module/Render/Renderer/UserInterfaceDrawList.h"
 #include "World/WorldModuleRegistry.h"
 
 #include "Module/Particle/ParticleSystem.h"
@@ -17,6 +18,7 @@ namespace Himii
 {
     class Entity;
     class World;
+    class TileMapData;
 
     class Scene {
     public:
@@ -183,11 +185,23 @@ namespace Himii
 
         /// 将 Transform 写入物理刚体（Play/Simulate 期间脚本改 Position/Rotation 时调用）。
         void SyncEntityTransformToPhysics(Entity entity);
+        /// 运行时修改瓦片后调用，让对应区块的瓦片碰撞体在帧末重建。
+        void NotifyTilemapTileChanged(const TileMapData *mapData, int32_t tileX, int32_t tileY);
 
         /// 物理步进后写回实体世界变换（由 Physics2DWorld 调用）。
         void ApplyPhysicsWorldTransform(
                 Entity entity, const glm::vec2 &worldPosition, float worldRotationZ);
 
+        struct PhysicsWorldTransformUpdate
+        {
+            entt::entity EntityHandle = entt::null;
+            glm::vec2 WorldPosition{0.0f};
+            float WorldRotationZ = 0.0f;
+        };
+        /// 批量写回一步内移动过的刚体：无父无子的实体直接写 Position/Rotation 并只置自身脏标记，
+        /// 处于层级中的实体再走 ApplyPhysicsWorldTransform。
+        void ApplyPhysicsWorldTransforms(const std::vector<PhysicsWorldTransformUpdate> &updates);
+
         /// World 脚本模块调度入口（由 ScriptUpdateModule / ScriptFixedUpdateModule 调用）。
         void UpdateManagedAndNativeScripts(Timestep timestep);
         void RunScriptFixedUpdate(Timestep timestep);
@@ -234,7 +248,38 @@ namespace Himii
                 const glm::vec2 &pointerInTargetPixels) const;
         void ClearUserInterfacePointerTransientState();
 
+        /// 保留式 UI 布局：Canvas 子树按绘制顺序（先序）展开，每个节点记录父节点下标。
+        struct UserInterfaceLayoutNode
+        {
+            entt::entity EntityHandle = entt::null;
+            int32_t ParentIndex = -1;
+        };
+
+        /// 同一帧可能按多个目标尺寸解析（编辑器视口与 Game 视图），每个尺寸一份结果。
+        struct UserInterfaceLayoutTarget
+        {
+            glm::vec2 TargetSize{0.0f};
+            CanvasLayoutContext Context;
+            std::vector<ResolvedRectTransform> ResolvedNodes;
+            UserInterfaceDrawList DrawList;
+            bool NeedsFullResolve = true;
+        };
+
+        static constexpr size_t MaxUserInterfaceLayoutTargets = 4;
+
+        /// 层级或 Canvas 变化后重建节点表；无 Canvas 时返回 false。
+        bool RefreshUserInterfaceLayoutNodes() const;
+        /// 只重算 WorldTransformDirty 的节点及其后代；Canvas 缩放上下文变化时整表重算。
+        /// 自上次布局以来没有节点改动时直接返回保留结果，同一帧内多次调用只有第一次逐节点扫描。
+        UserInterfaceLayoutTarget *UpdateUserInterfaceLayout(float targetWidth, float targetHeight) const;
+        /// 该尺寸的保留结果仍然有效时返回它，否则返回空；不触发布局。
+        const UserInterfaceLayoutTarget *FindUserInterfaceLayoutTarget(float targetWidth, float targetHeight) const;
+        void ResolveUserInterfaceLayoutNode(UserInterfaceLayoutTarget &target, size_t nodeIndex) const;
+
     private:
+        /// Canvas / RectTransform 组件增删的注册表回调：作废 Canvas 缓存并让 UI 节点表重建。
+        void OnUserInterfaceComponentChanged(entt::registry &registry, entt::entity entityHandle);
+
         entt::registry m_Registry;
         uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
         std::unordered_map<UUID, entt::entity> m_EntityMap;
@@ -246,6 +291,17 @@ namespace Himii
         UUID m_UserInterfaceHoverEntityIdentifier = 0;
         UUID m_UserInterfacePressedEntityIdentifier = 0;
 
+        mutable std::vector<UserInterfaceLayoutNode> m_UserInterfaceLayoutNodes;
+        mutable std::unordered_map<entt::entity, size_t> m_UserInterfaceLayoutNodeIndices;
+        mutable std::vector<UserInterfaceLayoutTarget> m_UserInterfaceLayoutTargets;
+        mutable std::vector<uint8_t> m_UserInterfaceLayoutNodeResolved;
+        mutable entt::entity m_UserInterfaceLayoutCanvas = entt::null;
+        mutable bool m_UserInterfaceLayoutStructureDirty = true;
+        /// MarkEntityTransformDirty 标记过 RectTransform 后置位，布局扫描完成后清除。
+        mutable bool m_UserInterfaceLayoutDirty = true;
+        mutable entt::entity m_CanvasEntityCache = entt::null;
+        mutable bool m_CanvasEntityCacheValid = false;
+
         friend class Entity;
         friend class SceneSerializer;
         friend class SceneHierarchyPanel;
@@ -24,6 +24,7 @@ namespace Himii
     void Scene::RebuildHierarchyCache()
     {
         m_ChildrenCache.clear();
+        m_UserInterfaceLayoutStructureDirty = true;
 
         auto relationshipView = m_Registry.view<RelationshipComponent>();
         for (auto entityHandle : relationshipView)
@@ -239,7 +240,10 @@ namespace Himii
         if (entity.HasComponent<TransformComponent>())
             entity.GetComponent<TransformComponent>().WorldTransformDirty = true;
         if (entity.HasComponent<RectTransformComponent>())
+        {
             entity.GetComponent<RectTransformComponent>().WorldTransformDirty = true;
+            m_UserInterfaceLayoutDirty = true;
+        }
 
         for (UUID childIdentifier : GetEntityChildren(entity))
         {
@@ -293,6 +297,41 @@ namespace Himii
         MarkEntityTransformDirty(entity);
     }
 
+    void Scene::ApplyPhysicsWorldTransforms(const std::vector<PhysicsWorldTransformUpdate>& updates)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<const PhysicsWorldTransformUpdate*> hierarchyUpdates;
+        for (const PhysicsWorldTransformUpdate& update : updates)
+        {
+            if (!m_Registry.valid(update.EntityHandle))
+                continue;
+
+            auto* transform = m_Registry.try_get<TransformComponent>(update.EntityHandle);
+            if (!transform)
+                continue;
+
+            const auto* relationship = m_Registry.try_get<RelationshipComponent>(update.EntityHandle);
+            const bool hasParent = relationship && relationship->Parent != 0;
+            const bool hasChildren = !m_ChildrenCache.empty()
+                                     && m_ChildrenCache.find(m_Registry.get<IDComponent>(update.EntityHandle).ID)
+                                                != m_ChildrenCache.end();
+            if (hasParent || hasChildren)
+            {
+                hierarchyUpdates.push_back(&update);
+                continue;
+            }
+
+            transform->Position.x = update.WorldPosition.x;
+            transform->Position.y = update.WorldPosition.y;
+            transform->Rotation.z = update.WorldRotationZ;
+            transform->WorldTransformDirty = true;
+        }
+
+        for (const PhysicsWorldTransformUpdate* update : hierarchyUpdates)
+            ApplyPhysicsWorldTransform({update->EntityHandle, this}, update->WorldPosition, update->WorldRotationZ);
+    }
+
     bool Scene::SetEntityParent(Entity child, Entity parent, bool keepWorldPosition)
     {
         if (!child)
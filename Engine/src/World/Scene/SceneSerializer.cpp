@@ -558,6 +558,13 @@ namespace Himii
             out << YAML::Key << "Mute" << YAML::Value << soundPlayer.Mute;
             out << YAML::Key << "Loop" << YAML::Value << soundPlayer.Loop;
             out << YAML::Key << "PlayOnStart" << YAML::Value << soundPlayer.PlayOnStart;
+            out << YAML::Key << "Priority" << YAML::Value << soundPlayer.Priority;
+            out << YAML::Key << "Spatial" << YAML::Value << soundPlayer.Spatial.Enabled;
+            out << YAML::Key << "AttenuationModel" << YAML::Value << (int)soundPlayer.Spatial.AttenuationModel;
+            out << YAML::Key << "MinDistance" << YAML::Value << soundPlayer.Spatial.MinDistance;
+            out << YAML::Key << "MaxDistance" << YAML::Value << soundPlayer.Spatial.MaxDistance;
+            out << YAML::Key << "Rolloff" << YAML::Value << soundPlayer.Spatial.Rolloff;
+            out << YAML::Key << "Bus" << YAML::Value << (int)soundPlayer.Bus;
             out << YAML::EndMap;
         }
 
@@ -1082,6 +1089,21 @@ namespace Himii
                 soundPlayer.Loop = soundPlayerComponent["Loop"].as<bool>();
             if (soundPlayerComponent["PlayOnStart"])
                 soundPlayer.PlayOnStart = soundPlayerComponent["PlayOnStart"].as<bool>();
+            if (soundPlayerComponent["Priority"])
+                soundPlayer.Priority = soundPlayerComponent["Priority"].as<int>();
+            if (soundPlayerComponent["Spatial"])
+                soundPlayer.Spatial.Enabled = soundPlayerComponent["Spatial"].as<bool>();
+            if (soundPlayerComponent["AttenuationModel"])
+                soundPlayer.Spatial.AttenuationModel =
+                        (AudioAttenuationModel)soundPlayerComponent["AttenuationModel"].as<int>();
+            if (soundPlayerComponent["MinDistance"])
+                soundPlayer.Spatial.MinDistance = soundPlayerComponent["MinDistance"].as<float>();
+            if (soundPlayerComponent["MaxDistance"])
+                soundPlayer.Spatial.MaxDistance = soundPlayerComponent["MaxDistance"].as<float>();
+            if (soundPlayerComponent["Rolloff"])
+                soundPlayer.Spatial.Rolloff = soundPlayerComponent["Rolloff"].as<float>();
+            if (soundPlayerComponent["Bus"])
+                soundPlayer.Bus = (AudioBus)std::clamp(soundPlayerComponent["Bus"].as<int>(), 0, AudioBusCount - 1);
 
             if (soundPlayer.SoundHandle && Project::GetActive())
             {
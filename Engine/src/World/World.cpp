@@ -1,8 +1,10 @@
 #include "Hepch.h"
 #include "World/World.h"
 #include "World/Scene/Scene.h"
+#include "Project/Project.h"
 
 #include "Module/Animation/SpriteAnimationModule.h"
+#include "Module/Audio/AudioEmitterModule.h"
 #include "Module/Physics/Physics2DModule.h"
 #include "Module/Particle/ParticleModule.h"
 #include "Module/Render/Renderer/SceneRenderModule.h"
@@ -32,6 +34,7 @@ namespace Himii
             m_ActiveScene->SetOwningWorld(nullptr);
 
         m_Physics2DWorld = nullptr;
+        m_FixedTimestep.Reset();
         m_ActiveScene = scene;
         ClearPendingSceneRender();
 
@@ -44,6 +47,7 @@ namespace Himii
 
     void World::OnRuntimeStart()
     {
+        m_FixedTimestep.Reset();
         if (m_ActiveScene)
             m_ActiveScene->OnRuntimeStart();
     }
@@ -56,6 +60,7 @@ namespace Himii
 
     void World::OnSimulationStart()
     {
+        m_FixedTimestep.Reset();
         if (m_ActiveScene)
             m_ActiveScene->OnSimulationStart();
     }
@@ -74,13 +79,14 @@ namespace Himii
         m_Modules.Update(WorldUpdatePhase::UserInterface, timestep);
         m_Modules.Update(WorldUpdatePhase::ScriptUpdate, timestep);
         m_Modules.Update(WorldUpdatePhase::Animation, timestep);
-        m_Modules.Update(WorldUpdatePhase::Physics, timestep);
-        m_Modules.Update(WorldUpdatePhase::ScriptFixedUpdate, timestep);
+        RunFixedUpdates(timestep);
         m_Modules.Update(WorldUpdatePhase::Presentation, timestep);
 
         PrepareRuntimeSceneRender(drawUserInterfaceContent);
         m_Modules.Update(WorldUpdatePhase::Render, timestep);
         ClearPendingSceneRender();
+
+        RebuildDirtyTilemapColliders();
     }
 
     void World::OnUpdateSimulation(Timestep timestep, EditorCamera &camera)
@@ -88,14 +94,15 @@ namespace Himii
         if (!m_ActiveScene)
             return;
 
-        // Simulate 保持原次序：Physics → Animation → ScriptFixedUpdate → Render
-        m_Modules.Update(WorldUpdatePhase::Physics, timestep);
+        // Simulate：固定步（Physics ↔ ScriptFixedUpdate）→ Animation → Render
+        RunFixedUpdates(timestep);
         m_Modules.Update(WorldUpdatePhase::Animation, timestep);
-        m_Modules.Update(WorldUpdatePhase::ScriptFixedUpdate, timestep);
 
         PrepareSimulationSceneRender(camera);
         m_Modules.Update(WorldUpdatePhase::Render, timestep);
         ClearPendingSceneRender();
+
+        RebuildDirtyTilemapColliders();
     }
 
     void World::Update(WorldUpdatePhase phase, Timestep timestep)
@@ -103,6 +110,34 @@ namespace Himii
         m_Modules.Update(phase, timestep);
     }
 
+    void World::RunFixedUpdates(Timestep timestep)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Physics2DSimulationSettings settings;
+        if (Project::GetActive())
+            settings = Project::GetConfig().Physics2DSimulation;
+        m_FixedTimestep.Configure(settings.GetFixedTimestep(), settings.MaxSubstepsPerFrame);
+
+        const uint32_t stepCount = m_FixedTimestep.Advance(timestep);
+        const Timestep fixedTimestep = m_FixedTimestep.GetStepSeconds();
+        for (uint32_t stepIndex = 0; stepIndex < stepCount; ++stepIndex)
+        {
+            m_Modules.Update(WorldUpdatePhase::Physics, fixedTimestep);
+            m_Modules.Update(WorldUpdatePhase::ScriptFixedUpdate, fixedTimestep);
+        }
+
+        // 无插值时 Transform 保持最后一步的物理位姿，即 Step 已写回的状态。
+        if (m_Physics2DWorld && settings.InterpolateTransforms)
+            m_Physics2DWorld->ApplyInterpolatedTransforms(m_FixedTimestep.GetInterpolationAlpha());
+    }
+
+    void World::RebuildDirtyTilemapColliders()
+    {
+        if (m_Physics2DWorld)
+            m_Physics2DWorld->RebuildDirtyTilemapColliders();
+    }
+
     void World::PrepareRuntimeSceneRender(bool drawUserInterfaceContent)
     {
         m_PendingSceneRenderKind = PendingSceneRenderKind::RuntimeGameView;
@@ -170,6 +205,8 @@ namespace Himii
                 WorldUpdatePhase::ScriptFixedUpdate, CreateScope<ScriptFixedUpdateModule>(scene));
         m_Modules.RegisterModule(
                 WorldUpdatePhase::Presentation, CreateScope<ParticleModule>(scene));
+        m_Modules.RegisterModule(
+                WorldUpdatePhase::Presentation, CreateScope<AudioEmitterModule>(scene));
         m_Modules.RegisterModule(
                 WorldUpdatePhase::Render, CreateScope<SceneRenderModule>(scene));
         m_Modules.InitializeAll();
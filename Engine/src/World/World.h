@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineCore/Core/Core.h"
+#include "EngineCore/Core/FixedTimestep.h"
 #include "EngineCore/Core/Timestep.h"
 #include "World/WorldModuleRegistry.h"
 #include "World/WorldUpdatePhase.h"
@@ -40,6 +41,7 @@ namespace Himii
         /// Play：按阶段驱动世界模块（含 Render）。
         void OnUpdateRuntime(Timestep timestep, bool drawUserInterfaceContent = true);
         /// Simulate：物理 / FixedUpdate + Render 阶段（编辑相机）。
+        /// 两者的 Physics 与 ScriptFixedUpdate 阶段都由固定步长累加器驱动，每帧执行 0~MaxSubstepsPerFrame 次。
         void OnUpdateSimulation(Timestep timestep, EditorCamera &camera);
 
         void Update(WorldUpdatePhase phase, Timestep timestep);
@@ -60,10 +62,15 @@ namespace Himii
         void PrepareRuntimeSceneRender(bool drawUserInterfaceContent);
         void PrepareSimulationSceneRender(EditorCamera &camera);
         void ClearPendingSceneRender();
+        /// 按工程的固定步频率交替推进 Physics 与 ScriptFixedUpdate，最后按累加器余量插值写回刚体 Transform。
+        void RunFixedUpdates(Timestep timestep);
+        /// 帧末把本帧脚本对瓦片的修改批量同步到瓦片碰撞体。
+        void RebuildDirtyTilemapColliders();
 
         Ref<Scene> m_ActiveScene;
         WorldModuleRegistry m_Modules;
         Physics2DWorld *m_Physics2DWorld = nullptr;
+        FixedTimestepAccumulator m_FixedTimestep;
 
         PendingSceneRenderKind m_PendingSceneRenderKind = PendingSceneRenderKind::None;
         bool m_PendingDrawUserInterfaceContent = true;
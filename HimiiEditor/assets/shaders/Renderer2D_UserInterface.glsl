@@ -0,0 +1,123 @@
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in vec2 a_DistanceFieldRange;
+layout(location = 5) in int a_EntityID;
+
+layout(std140, binding = 0) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+
+// 图片与 MSDF 文本共用：DistanceFieldRange 为 0 的顶点按普通纹理着色，否则按距离场求覆盖率。
+// 与 Renderer2D_Quad / Renderer2D_Text 保持相同的 location 占用与结构体用法。
+struct VertexOutput
+{
+    vec4 Color;
+    vec2 TexCoord;
+    vec2 DistanceFieldRange;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 3) out flat float v_TexIndex;
+layout(location = 4) out flat int v_EntityID;
+
+void main()
+{
+    Output.Color = a_Color;
+    Output.TexCoord = a_TexCoord;
+    Output.DistanceFieldRange = a_DistanceFieldRange;
+    v_TexIndex = a_TexIndex;
+    v_EntityID = a_EntityID;
+    gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int o_EntityID;
+
+struct VertexOutput
+{
+    vec4 Color;
+    vec2 TexCoord;
+    vec2 DistanceFieldRange;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 3) in flat float v_TexIndex;
+layout(location = 4) in flat int v_EntityID;
+
+layout(binding = 0) uniform sampler2D u_Textures[32];
+
+void main()
+{
+    vec4 textureSample = vec4(1.0);
+    switch (int(v_TexIndex))
+    {
+        case  0: textureSample = texture(u_Textures[ 0], Input.TexCoord); break;
+        case  1: textureSample = texture(u_Textures[ 1], Input.TexCoord); break;
+        case  2: textureSample = texture(u_Textures[ 2], Input.TexCoord); break;
+        case  3: textureSample = texture(u_Textures[ 3], Input.TexCoord); break;
+        case  4: textureSample = texture(u_Textures[ 4], Input.TexCoord); break;
+        case  5: textureSample = texture(u_Textures[ 5], Input.TexCoord); break;
+        case  6: textureSample = texture(u_Textures[ 6], Input.TexCoord); break;
+        case  7: textureSample = texture(u_Textures[ 7], Input.TexCoord); break;
+        case  8: textureSample = texture(u_Textures[ 8], Input.TexCoord); break;
+        case  9: textureSample = texture(u_Textures[ 9], Input.TexCoord); break;
+        case 10: textureSample = texture(u_Textures[10], Input.TexCoord); break;
+        case 11: textureSample = texture(u_Textures[11], Input.TexCoord); break;
+        case 12: textureSample = texture(u_Textures[12], Input.TexCoord); break;
+        case 13: textureSample = texture(u_Textures[13], Input.TexCoord); break;
+        case 14: textureSample = texture(u_Textures[14], Input.TexCoord); break;
+        case 15: textureSample = texture(u_Textures[15], Input.TexCoord); break;
+        case 16: textureSample = texture(u_Textures[16], Input.TexCoord); break;
+        case 17: textureSample = texture(u_Textures[17], Input.TexCoord); break;
+        case 18: textureSample = texture(u_Textures[18], Input.TexCoord); break;
+        case 19: textureSample = texture(u_Textures[19], Input.TexCoord); break;
+        case 20: textureSample = texture(u_Textures[20], Input.TexCoord); break;
+        case 21: textureSample = texture(u_Textures[21], Input.TexCoord); break;
+        case 22: textureSample = texture(u_Textures[22], Input.TexCoord); break;
+        case 23: textureSample = texture(u_Textures[23], Input.TexCoord); break;
+        case 24: textureSample = texture(u_Textures[24], Input.TexCoord); break;
+        case 25: textureSample = texture(u_Textures[25], Input.TexCoord); break;
+        case 26: textureSample = texture(u_Textures[26], Input.TexCoord); break;
+        case 27: textureSample = texture(u_Textures[27], Input.TexCoord); break;
+        case 28: textureSample = texture(u_Textures[28], Input.TexCoord); break;
+        case 29: textureSample = texture(u_Textures[29], Input.TexCoord); break;
+        case 30: textureSample = texture(u_Textures[30], Input.TexCoord); break;
+        case 31: textureSample = texture(u_Textures[31], Input.TexCoord); break;
+    }
+
+    // 导数须在分支外求得，同一批次里图片与文本片元交错时结果才有定义。
+    vec2 screenTexSize = vec2(1.0) / fwidth(Input.TexCoord);
+
+    if (Input.DistanceFieldRange.x > 0.0)
+    {
+        float signedDistance = max(
+                min(textureSample.r, textureSample.g),
+                min(max(textureSample.r, textureSample.g), textureSample.b));
+        float screenPixelRange = max(0.5 * dot(Input.DistanceFieldRange, screenTexSize), 1.0);
+        float coverage = clamp(screenPixelRange * (signedDistance - 0.5) + 0.5, 0.0, 1.0);
+        if (coverage < 0.01)
+            discard;
+
+        // Straight Alpha：RGB 保持字体颜色，仅 Alpha 乘覆盖率。
+        color = vec4(Input.Color.rgb, Input.Color.a * coverage);
+        if (color.a < 0.01)
+            discard;
+    }
+    else
+    {
+        color = Input.Color * textureSample;
+        if (color.a == 0.0)
+            discard;
+    }
+
+    o_EntityID = v_EntityID;
+}
@@ -296,7 +296,10 @@ vec3 ResolveWorldNormal(vec2 textureCoordinate)
 	if (u_UseNormalTexture == 0)
 		return geometricNormal;
 
-	vec3 tangentNormal = texture(u_NormalTexture, textureCoordinate).xyz * 2.0 - 1.0;
+	// 只取 XY 并重建 Z：兼容 RGB 法线贴图与 BC5 双通道烘焙（B 通道为 0）。
+	vec3 tangentNormal;
+	tangentNormal.xy = texture(u_NormalTexture, textureCoordinate).xy * 2.0 - 1.0;
+	tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 	if (u_NormalFlipGreen != 0)
 		tangentNormal.y = -tangentNormal.y;
 
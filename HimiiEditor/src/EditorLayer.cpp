@@ -14,9 +14,11 @@
 #include "ProjectBuildPipeline.h"
 
 #include "Module/Render/Renderer/Renderer3D.h"
+#include "Module/Render/Renderer/TextLayout.h"
 #include "Module/Render/Mesh/MeshAsset.h"
 #include "Module/Render/Shader/ShaderAsset.h"
 #include "Module/Render/Shader/ShaderCompilationService.h"
+#include "Module/Render/Shader/ShaderWarmup.h"
 #include "panel/MaterialThumbnailUtility.h"
 #include "World/Scene/Components.h"
 
@@ -686,6 +688,14 @@ namespace Himii
             ImGui::Text("Quad Count: %d", stats.QuadCount);
             ImGui::Text("Vertex Count: %d", stats.GetTotalVertexCount());
             ImGui::Text("Index Count: %d", stats.GetTotalIndexCount());
+            const uint32_t textLayoutLookups = stats.TextLayoutCacheHits + stats.TextLayoutCacheMisses;
+            ImGui::Text("Text Layouts: %u hits / %u lookups (%.1f%%), %u cached", stats.TextLayoutCacheHits,
+                        textLayoutLookups,
+                        textLayoutLookups > 0 ? stats.TextLayoutCacheHits * 100.0 / textLayoutLookups : 0.0,
+                        Himii::TextLayoutCache::GetEntryCount());
+            ImGui::Text("UI Draw Calls: %u (%u if split by image/text), %u elements rebuilt",
+                        stats.UserInterfaceDrawCalls, stats.UserInterfaceTypeSeparatedDrawCalls,
+                        stats.UserInterfaceRebuiltElements);
 
             ImGui::Separator();
             auto stats3D = Himii::Renderer3D::GetStatistics();
@@ -694,6 +704,9 @@ namespace Himii
             ImGui::Text("Vertex Count: %d", stats3D.GetTotalVertexCount());
             ImGui::Text("Index Count: %d", stats3D.GetTotalIndexCount());
             ImGui::Text("Face Count: %d", stats3D.GetTotalIndexCount() / 3);
+            ImGui::Text("Meshlets: %u / %u visible (%.3f ms)", stats3D.MeshletsVisible,
+                        stats3D.MeshletsTested, stats3D.MeshletCullingMilliseconds);
+            ImGui::Text("Materials: %u compiled", stats3D.MaterialCompilations);
             ImGui::End();
 
             ImGui::Begin("Settings");
@@ -1884,6 +1897,7 @@ namespace Himii
             Project::EnsureGameAssemblyProjectIncludesAllAssetScripts();
             Project::EnsureSeededDefaultAssets();
             Project::InitializeGameplayDefaultFont();
+            ShaderWarmup::WarmupProjectShaders(*Project::GetAssetManager());
             RefreshEditorSkyboxForActiveProject();
             m_ProjectSettingsPanel.Reset();
 
@@ -5,6 +5,9 @@
 #include "Project/Project.h"
 #include "Project/ProjectSerializer.h"
 #include "Module/Script/ScriptCompiler.h"
+#include "Resource/AssetManager.h"
+#include "Resource/ResourceSystem.h"
+#include "Resource/TextureCooker.h"
 
 #include <cctype>
 #include <vector>
@@ -18,6 +21,7 @@ namespace Himii
             Idle = 0,
             CompilingGameAssembly,
             ResolvingExportTemplate,
+            CookingTextures,
             WritingTemporaryPackage,
             CommittingPackage,
             Finished
@@ -36,6 +40,8 @@ namespace Himii
             std::filesystem::path TemplateEngineContentDirectory;
             std::vector<std::filesystem::path> NativeDependencyDllPaths;
             std::filesystem::path TemporaryDirectory;
+            std::vector<AssetHandle> TexturesToCook;
+            size_t CookedTextureCount = 0;
             std::string StageLabel = "Starting...";
             float ProgressNormalized = 0.0f;
         };
@@ -481,6 +487,26 @@ namespace Himii
             return true;
         }
 
+        /// 只收集 Compression 非 None 且 .htex 缺失 / 过期的纹理；.htex 与源图片同目录，随 assets 一起拷贝。
+        void CollectTexturesToCook(BuildSessionState& session)
+        {
+            session.TexturesToCook.clear();
+            session.CookedTextureCount = 0;
+
+            auto assetManager = ResourceSystem::GetAssetManager();
+            if (!assetManager)
+                return;
+
+            for (const auto& [handle, metadata] : assetManager->GetAssetRegistry())
+            {
+                if (metadata.Type == AssetType::Texture2D && assetManager->NeedsTextureCook(handle))
+                    session.TexturesToCook.push_back(handle);
+            }
+
+            if (!session.TexturesToCook.empty())
+                HIMII_CORE_INFO("Build Pipeline: cooking {0} texture(s)", session.TexturesToCook.size());
+        }
+
         bool WriteTemporaryPackageContents(BuildSessionState& session, std::string& errorMessage)
         {
             const std::filesystem::path temporaryDirectory = session.TemporaryDirectory;
@@ -678,6 +704,34 @@ namespace Himii
                     }
                 }
 
+                CollectTexturesToCook(session);
+                session.Stage = BuildSessionStage::CookingTextures;
+                session.StageLabel = "Cooking textures...";
+                session.ProgressNormalized = 0.6f;
+                outProgress = {session.StageLabel, session.ProgressNormalized};
+                return true;
+            }
+
+            case BuildSessionStage::CookingTextures:
+            {
+                // 每帧烘焙一张，保持进度条刷新；失败只告警，运行时会退回源图片。
+                if (session.CookedTextureCount < session.TexturesToCook.size())
+                {
+                    const AssetHandle textureHandle = session.TexturesToCook[session.CookedTextureCount++];
+                    auto assetManager = ResourceSystem::GetAssetManager();
+                    if (assetManager && !assetManager->CookTexture(textureHandle))
+                        HIMII_CORE_WARNING("Build Pipeline: failed to cook texture {0}, shipping source image",
+                                           static_cast<uint64_t>(textureHandle));
+
+                    const float cookFraction = static_cast<float>(session.CookedTextureCount)
+                                               / static_cast<float>(session.TexturesToCook.size());
+                    session.StageLabel = "Cooking textures (" + std::to_string(session.CookedTextureCount) + "/"
+                                         + std::to_string(session.TexturesToCook.size()) + ")...";
+                    session.ProgressNormalized = 0.6f + 0.1f * cookFraction;
+                    outProgress = {session.StageLabel, session.ProgressNormalized};
+                    return true;
+                }
+
                 session.Stage = BuildSessionStage::WritingTemporaryPackage;
                 session.StageLabel = "Writing package files...";
                 session.ProgressNormalized = 0.7f;
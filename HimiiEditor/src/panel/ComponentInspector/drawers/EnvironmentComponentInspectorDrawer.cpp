@@ -98,6 +98,13 @@ namespace Himii
                                         payload, component.EnvironmentMap);
                             });
 
+                    if (component.EnvironmentMap != 0
+                        && EnvironmentLightingSystem::IsBakePending(component.EnvironmentMap))
+                    {
+                        DrawReadOnlyTextControl("Bake", "Baking...",
+                                                "IBL is baking in the background. The previous lighting stays active until it finishes.");
+                    }
+
                     DrawFloatControl("Intensity", component.Intensity, 0.01f, 0.0f, 0.0f, nullptr, nullptr, true,
                                      1.0f);
                     DrawColorControl("Ambient Color", component.AmbientColor, glm::vec4(1.0f));
@@ -9,6 +9,7 @@
 #include "World/Scene/Components.h"
 
 #include <imgui.h>
+#include <cstdio>
 #include <string>
 
 namespace Himii
@@ -174,6 +175,23 @@ namespace Himii
                                     "Mesh Status", "Needs Reimport",
                                     "The baked .hmesh failed to load. Right-click it in Content Browser and choose Reimport.");
                         }
+                        else if (hasMeshReference && assetManager)
+                        {
+                            Ref<Asset> meshBase = assetManager->GetAsset(component.MeshAssetHandle);
+                            if (meshBase && meshBase->GetType() == AssetType::Mesh)
+                            {
+                                const MeshMemoryStatistics memoryStatistics =
+                                        std::static_pointer_cast<MeshAsset>(meshBase)->GetMemoryStatistics();
+                                char memoryText[96];
+                                std::snprintf(memoryText, sizeof(memoryText), "CPU %.1f KB / GPU %.1f KB",
+                                              (memoryStatistics.ResidentCpuBytes + memoryStatistics.MappedFileBytes)
+                                                      / 1024.0,
+                                              memoryStatistics.ResidentGpuBytes / 1024.0);
+                                DrawReadOnlyTextControl(
+                                        "Resident Memory", memoryText,
+                                        "CPU geometry is released after GPU upload unless a system retains it.");
+                            }
+                        }
                     }
 
                     DrawMeshMaterialSlots(drawContext, component);
@@ -62,6 +62,19 @@ namespace Himii
                         return true;
                     });
 
+                if (component.Sound && component.Sound->IsValid())
+                {
+                    const SoundAsset& sound = *component.Sound;
+                    if (sound.IsStreaming())
+                        ImGui::TextDisabled("Streaming  %.1f s, resident 0 KB (decoded would be %.1f MB)",
+                                            sound.GetDurationSeconds(),
+                                            sound.GetFullyDecodedMemoryBytes() / (1024.0 * 1024.0));
+                    else
+                        ImGui::TextDisabled("Decoded %s  %.1f s, resident %.1f KB",
+                                            sound.GetSampleFormat() == SoundSampleFormat::Int16 ? "Int16" : "Float32",
+                                            sound.GetDurationSeconds(), sound.GetResidentMemoryBytes() / 1024.0);
+                }
+
                 float volume = component.Volume;
                 DrawFloatControl("Volume", volume, 0.01f, 0.0f, 1.0f, nullptr, nullptr, true, 1.0f);
                 if (volume != component.Volume)
@@ -77,6 +90,49 @@ namespace Himii
 
                 DrawCheckboxControl("Loop", component.Loop, false);
                 DrawCheckboxControl("Play On Start", component.PlayOnStart, false);
+                const int previousPriority = component.Priority;
+                DrawIntControl("Priority", component.Priority, 1.0f, 0, 255, true, AudioEngine::DefaultVoicePriority);
+                if (component.Priority != previousPriority)
+                    AudioEngine::SetPriority(component.RuntimeVoiceHandle, component.Priority);
+
+                const char* busLabels[AudioBusCount];
+                for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+                    busLabels[busIndex] = GetAudioBusName(static_cast<AudioBus>(busIndex));
+                int busIndex = static_cast<int>(component.Bus);
+                DrawEnumComboControl(
+                    "Bus", busIndex, busLabels, AudioBusCount,
+                    [&](int newIndex)
+                    {
+                        component.Bus = static_cast<AudioBus>(newIndex);
+                        AudioEngine::SetBus(component.RuntimeVoiceHandle, component.Bus);
+                    },
+                    true, static_cast<int>(AudioBus::SFX));
+
+                const AudioSpatialSettings previousSpatial = component.Spatial;
+                DrawCheckboxControl("Spatial", component.Spatial.Enabled, false);
+                if (component.Spatial.Enabled)
+                {
+                    const char* attenuationLabels[] = {"Inverse", "Linear"};
+                    int attenuationIndex = static_cast<int>(component.Spatial.AttenuationModel);
+                    DrawEnumComboControl(
+                        "Attenuation", attenuationIndex, attenuationLabels, 2,
+                        [&](int newIndex)
+                        {
+                            component.Spatial.AttenuationModel = static_cast<AudioAttenuationModel>(newIndex);
+                        });
+                    DrawFloatControl("Min Distance", component.Spatial.MinDistance, 0.1f, 0.001f, 10000.0f,
+                                     nullptr, nullptr, true, 1.0f);
+                    DrawFloatControl("Max Distance", component.Spatial.MaxDistance, 0.1f, 0.001f, 10000.0f,
+                                     nullptr, nullptr, true, 50.0f);
+                    DrawFloatControl("Rolloff", component.Spatial.Rolloff, 0.01f, 0.0f, 10.0f, nullptr, nullptr,
+                                     true, 1.0f);
+                }
+                if (previousSpatial.Enabled != component.Spatial.Enabled
+                    || previousSpatial.AttenuationModel != component.Spatial.AttenuationModel
+                    || previousSpatial.MinDistance != component.Spatial.MinDistance
+                    || previousSpatial.MaxDistance != component.Spatial.MaxDistance
+                    || previousSpatial.Rolloff != component.Spatial.Rolloff)
+                    SoundPlayerUtility::ApplySpatialSettings(component);
 
                 DrawActionButtonRow("Preview", [&]()
                 {
@@ -51,7 +51,7 @@ namespace Himii
         std::string extension = path.extension().string();
         std::transform(extension.begin(), extension.end(), extension.begin(),
                        [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
-        if (extension == ".meta" || extension == ".ienv")
+        if (extension == ".meta" || extension == ".ienv" || extension == ".htex")
             return true;
 
         for (const auto &pathPart : path)
@@ -219,6 +219,11 @@ namespace Himii
         m_SceneIcon = Texture2D::Create("resources/icons/Scene.png");
     }
 
+    ContentBrowserPanel::~ContentBrowserPanel()
+    {
+        m_AsyncCallbackToken.reset();
+    }
+
     void ContentBrowserPanel::OnImGuiRender()
     {
         ImGui::Begin("Content Browser");
@@ -1382,6 +1387,13 @@ namespace Himii
 
     void ContentBrowserPanel::BeginStaticMeshSourceImport(const std::filesystem::path &relativeSourcePath)
     {
+        if (m_StaticMeshImportProgress)
+        {
+            HIMII_CORE_WARNING("A static mesh import is already running: {0}",
+                               m_StaticMeshImportSourcePath.generic_string());
+            return;
+        }
+
         m_StaticMeshImportDialogState = {};
         m_StaticMeshImportDialogState.Open = true;
         m_StaticMeshImportDialogState.IsReimport = false;
@@ -1391,6 +1403,13 @@ namespace Himii
 
     void ContentBrowserPanel::BeginStaticMeshReimport(const std::filesystem::path &relativeHmeshPath)
     {
+        if (m_StaticMeshImportProgress)
+        {
+            HIMII_CORE_WARNING("A static mesh import is already running: {0}",
+                               m_StaticMeshImportSourcePath.generic_string());
+            return;
+        }
+
         m_StaticMeshImportDialogState = {};
         m_StaticMeshImportDialogState.Open = true;
         m_StaticMeshImportDialogState.IsReimport = true;
@@ -1417,6 +1436,9 @@ namespace Himii
 
     void ContentBrowserPanel::DrawStaticMeshImportDialogIfNeeded()
     {
+        if (m_StaticMeshImportProgress)
+            DrawStaticMeshImportProgress(m_StaticMeshImportSourcePath, *m_StaticMeshImportProgress);
+
         if (m_StaticMeshImportDialogState.Open && !ImGui::IsPopupOpen("Import Static Mesh"))
             ImGui::OpenPopup("Import Static Mesh");
 
@@ -1427,21 +1449,34 @@ namespace Himii
         if (!assetManager)
             return;
 
+        // 几何解码在工作线程进行，编辑器保持响应；完成回调在主线程刷新缩略图。
+        m_StaticMeshImportProgress = CreateRef<MeshImportProgress>();
+        m_StaticMeshImportSourcePath = m_StaticMeshImportDialogState.IsReimport
+                                               ? m_StaticMeshImportDialogState.RelativeHmeshPath
+                                               : m_StaticMeshImportDialogState.RelativeSourcePath;
+        // 完成回调在主线程执行，与析构同线程：令牌未过期即说明面板仍然存活。
+        auto onImportCompleted = [this, callbackToken = std::weak_ptr<bool>(m_AsyncCallbackToken)](AssetHandle)
+        {
+            if (callbackToken.expired())
+                return;
+            m_StaticMeshImportProgress.reset();
+            m_StaticMeshImportSourcePath.clear();
+            m_ImageThumbnailCache.clear();
+        };
+
         if (m_StaticMeshImportDialogState.IsReimport)
         {
-            StaticMeshImporter::ReimportProduct(
-                    *assetManager, m_StaticMeshImportDialogState.RelativeHmeshPath,
+            StaticMeshImporter::ReimportProductAsync(
+                    assetManager, m_StaticMeshImportDialogState.RelativeHmeshPath,
                     &m_StaticMeshImportDialogState.Settings,
-                    m_StaticMeshImportDialogState.PreserveCompanionMaterialsOnReimport);
+                    m_StaticMeshImportDialogState.PreserveCompanionMaterialsOnReimport,
+                    m_StaticMeshImportProgress, onImportCompleted);
         }
         else
         {
-            StaticMeshImporter::ImportFromSource(
-                    *assetManager, m_StaticMeshImportDialogState.RelativeSourcePath,
-                    m_StaticMeshImportDialogState.Settings);
+            StaticMeshImporter::ImportFromSourceAsync(
+                    assetManager, m_StaticMeshImportDialogState.RelativeSourcePath,
+                    m_StaticMeshImportDialogState.Settings, m_StaticMeshImportProgress, onImportCompleted);
         }
-
-        assetManager->SerializeAssetRegistry();
-        m_ImageThumbnailCache.clear();
     }
-} // namespace Himii
\ No newline at end of file
+} // namespace Himii
@@ -13,6 +13,7 @@ namespace Himii
     class ContentBrowserPanel {
     public:
         ContentBrowserPanel();
+        ~ContentBrowserPanel();
 
         void OnImGuiRender();
 
@@ -106,6 +107,10 @@ namespace Himii
 
         std::unordered_map<std::string, Ref<Texture2D>> m_ImageThumbnailCache;
         StaticMeshImportDialogState m_StaticMeshImportDialogState{};
+        Ref<MeshImportProgress> m_StaticMeshImportProgress;
+        std::filesystem::path m_StaticMeshImportSourcePath;
+        /// 异步导入完成回调只持有弱引用；面板析构时先撤销，之后到达的回调直接丢弃。
+        Ref<bool> m_AsyncCallbackToken = CreateRef<bool>(true);
 
         std::function<void()> m_OnScriptChanged;
         std::string m_SelectedItemDisplayName;
@@ -3,8 +3,10 @@
 #include "Project/Project.h"
 #include "EngineCore/Utils/PlatformUtils.h"
 #include "Module/Script/ScriptIDE.h"
+#include "Module/Audio/AudioEngine.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 
@@ -26,7 +28,9 @@ namespace Himii
         strncpy(m_TempCustomPath, config.CustomScriptIDEPath.c_str(), sizeof(m_TempCustomPath) - 1);
         strncpy(m_TempCustomArgs, config.CustomScriptIDEArguments.c_str(), sizeof(m_TempCustomArgs) - 1);
         m_TempPhysics2DLayers = config.Physics2DLayers;
+        m_TempPhysics2DSimulation = config.Physics2DSimulation;
         m_TempSortingLayers = config.SortingLayers;
+        m_TempAudioMixer = config.AudioMixer;
     }
 
     void ProjectSettingsPanel::ApplyToProject()
@@ -39,7 +43,74 @@ namespace Himii
         config.CustomScriptIDEPath = m_TempCustomPath;
         config.CustomScriptIDEArguments = m_TempCustomArgs;
         config.Physics2DLayers = m_TempPhysics2DLayers;
+        config.Physics2DSimulation = m_TempPhysics2DSimulation;
         config.SortingLayers = m_TempSortingLayers;
+        config.AudioMixer = m_TempAudioMixer;
+        // 总线设置立即作用于正在运行的音频引擎，Play 中也能试听。
+        AudioEngine::SetMixerSettings(config.AudioMixer);
+    }
+
+    void ProjectSettingsPanel::DrawAudioMixerSettings()
+    {
+        static const char* kFilterTypeLabels[] = { "None", "Low Pass", "High Pass" };
+        const char* busLabels[AudioBusCount];
+        for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+            busLabels[busIndex] = GetAudioBusName(static_cast<AudioBus>(busIndex));
+
+        for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+        {
+            const AudioBus bus = static_cast<AudioBus>(busIndex);
+            AudioBusSettings& busSettings = m_TempAudioMixer.Buses[busIndex];
+            ImGui::PushID(busIndex);
+            if (ImGui::TreeNode(busLabels[busIndex]))
+            {
+                ImGui::SliderFloat("Gain", &busSettings.Gain, 0.0f, 2.0f);
+
+                int filterType = static_cast<int>(busSettings.FilterType);
+                if (ImGui::Combo("Filter", &filterType, kFilterTypeLabels, 3))
+                    busSettings.FilterType = static_cast<AudioBusFilterType>(filterType);
+                if (busSettings.FilterType != AudioBusFilterType::None)
+                {
+                    ImGui::DragFloat("Cutoff (Hz)", &busSettings.FilterCutoffHz, 10.0f, 10.0f, 20000.0f);
+                    ImGui::DragFloat("Q", &busSettings.FilterQ, 0.01f, 0.1f, 10.0f);
+                }
+
+                ImGui::Checkbox("Limiter", &busSettings.LimiterEnabled);
+                if (busSettings.LimiterEnabled)
+                {
+                    ImGui::SliderFloat("Threshold", &busSettings.LimiterThreshold, 0.01f, 1.0f);
+                    ImGui::DragFloat("Release (s)##Limiter", &busSettings.LimiterReleaseSeconds, 0.01f, 0.0f, 5.0f);
+                }
+
+                if (bus != AudioBus::Master)
+                {
+                    ImGui::Checkbox("Ducking", &busSettings.DuckingEnabled);
+                    if (busSettings.DuckingEnabled)
+                    {
+                        int duckSource = static_cast<int>(busSettings.DuckSource);
+                        if (ImGui::Combo("Duck Source", &duckSource, busLabels, AudioBusCount))
+                            busSettings.DuckSource = static_cast<AudioBus>(duckSource);
+                        ImGui::SliderFloat("Duck Threshold", &busSettings.DuckThreshold, 0.0f, 1.0f);
+                        ImGui::SliderFloat("Duck Gain", &busSettings.DuckGain, 0.0f, 1.0f);
+                        ImGui::DragFloat("Attack (s)", &busSettings.DuckAttackSeconds, 0.005f, 0.0f, 5.0f);
+                        ImGui::DragFloat("Release (s)##Duck", &busSettings.DuckReleaseSeconds, 0.01f, 0.0f, 5.0f);
+                    }
+                }
+
+                if (AudioEngine::IsInitialized())
+                {
+                    const AudioBusStatistics statistics = AudioEngine::GetBusStatistics(bus);
+                    const double blockMicroseconds = statistics.ProcessedBlockCount > 0
+                        ? statistics.ProcessMicroseconds / static_cast<double>(statistics.ProcessedBlockCount)
+                        : 0.0;
+                    ImGui::TextDisabled("Peak %.2f  Duck %.2f  Limiter %.2f  DSP %.2f us/block",
+                                        statistics.PeakLevel, statistics.DuckGain, statistics.LimiterGain,
+                                        blockMicroseconds);
+                }
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
     }
 
     void ProjectSettingsPanel::OnImGuiRender(bool* pOpen)
@@ -92,6 +163,25 @@ namespace Himii
             ImGui::TextDisabled("Placeholders: {ProjectDir} {Solution} {File} {ProjectName}");
         }
 
+        ImGui::Separator();
+        ImGui::Text("Physics 2D Simulation");
+        ImGui::Separator();
+
+        int fixedUpdateRate = static_cast<int>(m_TempPhysics2DSimulation.FixedUpdateRate);
+        if (ImGui::InputInt("Fixed Update Rate (Hz)", &fixedUpdateRate))
+            m_TempPhysics2DSimulation.FixedUpdateRate = static_cast<uint32_t>(std::clamp(fixedUpdateRate, 1, 1000));
+
+        int maxSubstepsPerFrame = static_cast<int>(m_TempPhysics2DSimulation.MaxSubstepsPerFrame);
+        if (ImGui::InputInt("Max Substeps Per Frame", &maxSubstepsPerFrame))
+            m_TempPhysics2DSimulation.MaxSubstepsPerFrame = static_cast<uint32_t>(std::clamp(maxSubstepsPerFrame, 1, 64));
+
+        ImGui::Checkbox("Interpolate Transforms", &m_TempPhysics2DSimulation.InterpolateTransforms);
+
+        int physicsWorkerCount = static_cast<int>(m_TempPhysics2DSimulation.WorkerCount);
+        if (ImGui::InputInt("Physics Worker Count", &physicsWorkerCount))
+            m_TempPhysics2DSimulation.WorkerCount = static_cast<uint32_t>(std::clamp(physicsWorkerCount, 0, 32));
+        ImGui::TextDisabled("0 = all job system workers, 1 = single-threaded. Applies on next Play / Simulate.");
+
         ImGui::Separator();
         ImGui::Text("Physics 2D Layers");
         ImGui::Separator();
@@ -167,6 +257,11 @@ namespace Himii
             ImGui::PopID();
         }
 
+        ImGui::Separator();
+        ImGui::Text("Audio Mixer");
+        ImGui::Separator();
+        DrawAudioMixerSettings();
+
         ImGui::Separator();
         if (ImGui::Button("Apply"))
             ApplyToProject();
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Module/Script/ScriptIDE.h"
+#include "Project/AudioMixerSettings.h"
 #include "Project/Physics2DLayerSettings.h"
+#include "Project/Physics2DSimulationSettings.h"
 #include "Project/SortingLayerSettings.h"
 
 namespace Himii
@@ -17,10 +19,13 @@ namespace Himii
         char m_TempCustomPath[512] = "";
         char m_TempCustomArgs[512] = "";
         Physics2DLayerSettings m_TempPhysics2DLayers;
+        Physics2DSimulationSettings m_TempPhysics2DSimulation;
         SortingLayerSettings m_TempSortingLayers;
+        AudioMixerSettings m_TempAudioMixer;
         bool m_Initialized = false;
 
         void SyncFromProject();
         void ApplyToProject();
+        void DrawAudioMixerSettings();
     };
 }
@@ -3,6 +3,7 @@
 #include "InspectorControls.h"
 
 #include <imgui.h>
+#include <cstdio>
 
 namespace Himii
 {
@@ -108,4 +109,33 @@ namespace Himii
 
         return confirmed;
     }
+
+    void DrawStaticMeshImportProgress(const std::filesystem::path &relativeSourcePath,
+                                      const MeshImportProgress &progress)
+    {
+        const ImGuiViewport *viewport = ImGui::GetMainViewport();
+        ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 16.0f,
+                                       viewport->WorkPos.y + viewport->WorkSize.y - 16.0f),
+                                ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+        ImGui::SetNextWindowBgAlpha(0.9f);
+
+        const ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize
+                                             | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking
+                                             | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+        if (ImGui::Begin("##StaticMeshImportProgress", nullptr, windowFlags))
+        {
+            ImGui::Text("Importing %s", relativeSourcePath.filename().string().c_str());
+
+            char overlay[64];
+            const uint32_t totalPrimitives = progress.TotalPrimitives.load();
+            if (progress.Stage.load() == MeshImportStage::Decoding && totalPrimitives > 0)
+                std::snprintf(overlay, sizeof(overlay), "%s %u / %u", progress.GetStageName(),
+                              progress.DecodedPrimitives.load(), totalPrimitives);
+            else
+                std::snprintf(overlay, sizeof(overlay), "%s", progress.GetStageName());
+
+            ImGui::ProgressBar(progress.GetFraction(), ImVec2(260.0f, 0.0f), overlay);
+        }
+        ImGui::End();
+    }
 }
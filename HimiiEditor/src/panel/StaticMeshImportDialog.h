@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Module/Render/Mesh/MeshImportJobs.h"
 #include "Module/Render/Mesh/StaticMeshImportSettings.h"
 #include <filesystem>
 #include <functional>
@@ -22,4 +23,8 @@ namespace Himii
     /// 返回 true 表示用户确认并应执行导入。
     bool DrawStaticMeshImportDialog(StaticMeshImportDialogState &dialogState);
 
+    /// 异步导入进行中时绘制进度浮窗（阶段 + 已解码原始体数）。
+    void DrawStaticMeshImportProgress(const std::filesystem::path &relativeSourcePath,
+                                      const MeshImportProgress &progress);
+
 } // namespace Himii
@@ -24,6 +24,7 @@ namespace Himii
         m_TextureHandle = textureHandle;
         m_PreviewTexture = nullptr;
         m_SelectedSpriteIndex = -1;
+        m_HasCookReport = false;
         ReloadImportData();
     }
 
@@ -50,6 +51,9 @@ namespace Himii
         m_GridPadding = importData->GridPadding;
         m_PixelsPerUnit = importData->PixelsPerUnit;
         m_SpriteModeSelection = static_cast<int>(importData->SpriteMode);
+        m_LoadSettings = importData->LoadSettings;
+        m_UsageSelection = static_cast<int>(importData->Usage);
+        m_CompressionSelection = static_cast<int>(importData->Compression);
 
         if (!UsesSliceWorkflow() || importData->Sprites.empty())
         {
@@ -83,6 +87,36 @@ namespace Himii
         importData.GridPadding = m_GridPadding;
         importData.PixelsPerUnit = m_PixelsPerUnit > 0 ? m_PixelsPerUnit : 100;
         importData.SpriteMode = static_cast<TextureSpriteMode>(m_SpriteModeSelection);
+        importData.LoadSettings = m_LoadSettings;
+        importData.Usage = static_cast<TextureUsage>(m_UsageSelection);
+        importData.Compression = static_cast<TextureCompression>(m_CompressionSelection);
+    }
+
+    void TextureInspectorPanel::ApplyLoadSettingsAndReloadTexture()
+    {
+        auto assetManager = ResourceSystem::GetAssetManager();
+        if (!assetManager || m_TextureHandle == 0)
+            return;
+
+        // mip 链在加载时生成，改动后需写回 meta 并重新加载纹理。
+        SyncUIToImportData();
+        assetManager->SaveTextureImportData(m_TextureHandle);
+        assetManager->UnloadAsset(m_TextureHandle);
+        ReloadImportData();
+    }
+
+    void TextureInspectorPanel::CookActiveTexture()
+    {
+        auto assetManager = ResourceSystem::GetAssetManager();
+        if (!assetManager || m_TextureHandle == 0)
+            return;
+
+        SyncUIToImportData();
+        assetManager->SaveTextureImportData(m_TextureHandle);
+        m_HasCookReport = assetManager->CookTexture(m_TextureHandle, &m_LastCookReport);
+        // 重新加载以切换到刚写出的 .htex。
+        assetManager->UnloadAsset(m_TextureHandle);
+        ReloadImportData();
     }
 
     void TextureInspectorPanel::SyncPendingEditsToMemory()
@@ -273,6 +307,83 @@ namespace Himii
             if (ImGui::IsItemDeactivatedAfterEdit())
                 SyncUIToImportData();
         });
+
+        DrawInspectorSectionHeader("Mipmaps");
+
+        const TextureLoadSettings previousLoadSettings = m_LoadSettings;
+        DrawCheckboxControl("Generate Mipmaps", m_LoadSettings.GenerateMips);
+        if (m_LoadSettings.GenerateMips)
+        {
+            int mipFilterSelection = static_cast<int>(m_LoadSettings.MipFilter);
+            const char* mipFilterLabels[] = {"Box", "Kaiser"};
+            DrawEnumComboControl("Mip Filter", mipFilterSelection, mipFilterLabels, 2,
+                                 [&](int newIndex)
+                                 { m_LoadSettings.MipFilter = static_cast<TextureMipFilter>(newIndex); });
+            DrawCheckboxControl("sRGB Color", m_LoadSettings.SRGB, true);
+            DrawCheckboxControl("Alpha-Weighted Mips", m_LoadSettings.AlphaWeightedMipFiltering, true);
+        }
+
+        if (previousLoadSettings.GenerateMips != m_LoadSettings.GenerateMips
+            || previousLoadSettings.MipFilter != m_LoadSettings.MipFilter
+            || previousLoadSettings.SRGB != m_LoadSettings.SRGB
+            || previousLoadSettings.AlphaWeightedMipFiltering != m_LoadSettings.AlphaWeightedMipFiltering)
+        {
+            ApplyLoadSettingsAndReloadTexture();
+        }
+
+        if (m_PreviewTexture)
+        {
+            char mipLevelText[32];
+            std::snprintf(mipLevelText, sizeof(mipLevelText), "%u", m_PreviewTexture->GetMipLevelCount());
+            DrawReadOnlyTextControl("Mip Levels", mipLevelText);
+        }
+
+        DrawCompressionSettings();
+    }
+
+    void TextureInspectorPanel::DrawCompressionSettings()
+    {
+        DrawInspectorSectionHeader("Compression",
+                                   "Cooked textures load from <texture>.htex without decoding the source image.");
+
+        const int previousUsage = m_UsageSelection;
+        const int previousCompression = m_CompressionSelection;
+
+        const char* usageLabels[] = {"Color", "Normal Map", "Mask"};
+        DrawEnumComboControl("Usage", m_UsageSelection, usageLabels, 3, [](int) {});
+        const char* compressionLabels[] = {"None", "Auto", "BC1", "BC3", "BC4", "BC5", "BC7"};
+        DrawEnumComboControl("Compression", m_CompressionSelection, compressionLabels, 7, [](int) {});
+
+        if (previousUsage != m_UsageSelection || previousCompression != m_CompressionSelection)
+        {
+            // 设置变更后旧 .htex 的哈希失效，重新加载会退回源图片直到再次烘焙。
+            m_HasCookReport = false;
+            ApplyLoadSettingsAndReloadTexture();
+        }
+
+        if (m_CompressionSelection == static_cast<int>(TextureCompression::None))
+            return;
+
+        DrawActionButtonRow("Cook", [&]()
+        {
+            if (ImGui::Button("Cook Texture", ImVec2(-1.0f, 0.0f)))
+                CookActiveTexture();
+        });
+
+        if (!m_HasCookReport)
+            return;
+
+        char reportText[96];
+        std::snprintf(reportText, sizeof(reportText), "%s  %ux%u  %u mips",
+                      TextureCooker::GetFormatName(m_LastCookReport.Format), m_LastCookReport.Width, m_LastCookReport.Height, m_LastCookReport.MipCount);
+        DrawReadOnlyTextControl("Cooked Format", reportText);
+        std::snprintf(reportText, sizeof(reportText), "%.1f KB -> %.1f KB",
+                      static_cast<double>(m_LastCookReport.UncompressedBytes) / 1024.0,
+                      static_cast<double>(m_LastCookReport.CookedBytes) / 1024.0);
+        DrawReadOnlyTextControl("Size", reportText);
+        std::snprintf(reportText, sizeof(reportText), "%.2f dB  (%.1f ms)", m_LastCookReport.Psnr,
+                      static_cast<double>(m_LastCookReport.ElapsedMilliseconds));
+        DrawReadOnlyTextControl("PSNR", reportText);
     }
 
     void TextureInspectorPanel::DrawSliceSettings()
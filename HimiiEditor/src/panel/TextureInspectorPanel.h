@@ -3,6 +3,7 @@
 #include "EngineCore/Core/Core.h"
 #include "Resource/Asset.h"
 #include "Resource/Sprite.h"
+#include "Resource/TextureCooker.h"
 #include "Module/Render/RenderCore/Texture.h"
 
 #include <glm/glm.hpp>
@@ -30,6 +31,9 @@ namespace Himii
         void ReloadImportData();
         void SyncUIToImportData();
         void SyncPendingEditsToMemory();
+        void ApplyLoadSettingsAndReloadTexture();
+        void DrawCompressionSettings();
+        void CookActiveTexture();
         void AddNewSprite();
         void DeleteSelectedSprite();
 
@@ -52,6 +56,11 @@ namespace Himii
         glm::ivec2 m_GridPadding{0, 0};
         int m_SpriteModeSelection = 1;
         uint32_t m_PixelsPerUnit = 100;
+        TextureLoadSettings m_LoadSettings{};
+        int m_UsageSelection = 0;
+        int m_CompressionSelection = 0;
+        TextureCookReport m_LastCookReport{};
+        bool m_HasCookReport = false;
         char m_SpriteNameEditBuffer[128]{};
     };
 
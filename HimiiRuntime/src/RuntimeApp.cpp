@@ -5,6 +5,7 @@
 #include "Module/Script/ScriptEngine.h"
 #include "Module/Render/RenderCore/Framebuffer.h"
 #include "Module/Render/Renderer/SceneColorResolvePass.h"
+#include "Module/Render/Shader/ShaderWarmup.h"
 #include "Module/Render/RHI/RenderCommand.h"
 #include "World/World.h"
 #include "World/Scene/Components.h"
@@ -48,6 +49,7 @@ namespace Himii
 
             Project::EnsureSeededDefaultAssets();
             Project::InitializeGameplayDefaultFont();
+            ShaderWarmup::WarmupProjectShaders(*Project::GetAssetManager());
 
             if (ImGuiLayer *imguiLayer = Application::Get().GetImGuiLayer())
                 imguiLayer->LoadEditorFonts();
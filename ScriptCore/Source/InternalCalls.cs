@@ -51,6 +51,10 @@ namespace HimiiEngine
                                                         out int maxX, out int maxY);
 
         internal delegate void Physics2DRaycastDelegate(ref Vector2 start, ref Vector2 end, out RaycastHit2D hit);
+        internal delegate int Physics2DGetLayerIndexDelegate(IntPtr layerName);
+        internal delegate void Physics2DQueryBatchDelegate(IntPtr commands, int commandCount, int mode,
+                                                           int maxHitsPerQuery, byte parallel, IntPtr hits,
+                                                           IntPtr hitCounts);
 
         internal delegate float TimeGetDeltaTimeDelegate();
         internal delegate byte SceneManagerLoadSceneDelegate(IntPtr scenePath);
@@ -166,6 +170,10 @@ namespace HimiiEngine
         internal static TilemapGetBoundsDelegate Tilemap_GetBounds;
 
         internal static Physics2DRaycastDelegate Physics2D_Raycast;
+        internal static Physics2DGetLayerIndexDelegate Physics2D_GetLayerIndex;
+        internal static Physics2DQueryBatchDelegate Physics2D_RaycastBatch;
+        internal static Physics2DQueryBatchDelegate Physics2D_ShapeCastBatch;
+        internal static Physics2DQueryBatchDelegate Physics2D_OverlapBatch;
 
         internal static TimeGetDeltaTimeDelegate Time_GetDeltaTime;
         internal static SceneManagerLoadSceneDelegate SceneManager_LoadScene;
@@ -321,6 +329,14 @@ namespace HimiiEngine
                 Marshal.GetDelegateForFunctionPointer<TilemapGetBoundsDelegate>(funcs.Tilemap_GetBounds);
 
             Physics2D_Raycast = Marshal.GetDelegateForFunctionPointer<Physics2DRaycastDelegate>(funcs.Physics2D_Raycast);
+            Physics2D_GetLayerIndex =
+                Marshal.GetDelegateForFunctionPointer<Physics2DGetLayerIndexDelegate>(funcs.Physics2D_GetLayerIndex);
+            Physics2D_RaycastBatch =
+                Marshal.GetDelegateForFunctionPointer<Physics2DQueryBatchDelegate>(funcs.Physics2D_RaycastBatch);
+            Physics2D_ShapeCastBatch =
+                Marshal.GetDelegateForFunctionPointer<Physics2DQueryBatchDelegate>(funcs.Physics2D_ShapeCastBatch);
+            Physics2D_OverlapBatch =
+                Marshal.GetDelegateForFunctionPointer<Physics2DQueryBatchDelegate>(funcs.Physics2D_OverlapBatch);
 
             Time_GetDeltaTime = Marshal.GetDelegateForFunctionPointer<TimeGetDeltaTimeDelegate>(funcs.Time_GetDeltaTime);
             SceneManager_LoadScene =
@@ -167,6 +167,11 @@ namespace HimiiEngine
         public IntPtr FontAsset_PreloadCharacters;
         public IntPtr FontAsset_PreloadTextAsync;
         public IntPtr FontAsset_WaitForPendingGenerations;
+
+        public IntPtr Physics2D_GetLayerIndex;
+        public IntPtr Physics2D_RaycastBatch;
+        public IntPtr Physics2D_ShapeCastBatch;
+        public IntPtr Physics2D_OverlapBatch;
     }
 
     [StructLayout(LayoutKind.Sequential)]
@@ -179,4 +184,59 @@ namespace HimiiEngine
         [MarshalAs(UnmanagedType.I1)]
         public bool Hit;
     }
-}
\ No newline at end of file
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RaycastCommand2D
+    {
+        public Vector2 Start;
+        public Vector2 End;
+        public uint LayerMask;
+
+        public RaycastCommand2D(Vector2 start, Vector2 end, uint layerMask = Physics2D.AllLayers)
+        {
+            Start = start;
+            End = end;
+            LayerMask = layerMask;
+        }
+    }
+
+    /// <summary>
+    /// 把形状从 Start 平移到 End；Size 对矩形为半宽高，对圆为 (半径, 忽略)。
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ShapeCastCommand2D
+    {
+        public Physics2DQueryShape Shape;
+        public Vector2 Start;
+        public Vector2 End;
+        public Vector2 Size;
+        public float Angle;
+        public uint LayerMask;
+    }
+
+    /// <summary>
+    /// Size 含义同 ShapeCastCommand2D；AABB 只与形状包围盒做粗测。
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct OverlapCommand2D
+    {
+        public Physics2DQueryShape Shape;
+        public Vector2 Center;
+        public Vector2 Size;
+        public float Angle;
+        public uint LayerMask;
+    }
+
+    /// <summary>
+    /// 重叠查询只填写 EntityID。
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PhysicsQueryHit2D
+    {
+        public Vector2 Point;
+        public Vector2 Normal;
+        public float Fraction;
+        public float Distance;
+        public ulong EntityID;
+    }
+}
@@ -1,13 +1,106 @@
 using System;
+using System.Runtime.InteropServices;
 
 namespace HimiiEngine
 {
+    public enum Physics2DQueryMode : int
+    {
+        /// <summary>每条命令只保留最近的命中；重叠查询命中任意一个即停止。</summary>
+        Closest = 0,
+        /// <summary>每条命令最多填满自己的命中槽位，投射结果按距离由近到远排列。</summary>
+        All = 1
+    }
+
+    public enum Physics2DQueryShape : int
+    {
+        AABB = 0,
+        Circle = 1,
+        Box = 2
+    }
+
     public static class Physics2D
     {
+        public const uint AllLayers = 0xFFFFFFFFu;
+
         public static RaycastHit2D Raycast(Vector2 start, Vector2 end)
         {
             InternalCalls.Physics2D_Raycast(ref start, ref end, out RaycastHit2D hit);
             return hit;
         }
+
+        /// <summary>按工程 2D 物理层名称组合查询用的 LayerMask，未知名称被忽略。</summary>
+        public static uint GetLayerMask(params string[] layerNames)
+        {
+            uint mask = 0;
+            if (layerNames == null || InternalCalls.Physics2D_GetLayerIndex == null)
+                return mask;
+
+            foreach (string layerName in layerNames)
+            {
+                IntPtr namePointer = Marshal.StringToCoTaskMemUTF8(layerName ?? string.Empty);
+                int layerIndex = InternalCalls.Physics2D_GetLayerIndex(namePointer);
+                Marshal.FreeCoTaskMem(namePointer);
+                if (layerIndex >= 0)
+                    mask |= 1u << layerIndex;
+            }
+            return mask;
+        }
+
+        /// <summary>
+        /// 批量射线检测：hits 按命令数均分，第 i 条命令的命中写入 hits[i * (hits.Length / commands.Length)] 起，
+        /// 命中数写入 hitCounts[i]。parallel 为 true 时在引擎工作线程上并发执行。
+        /// </summary>
+        public static void RaycastBatch(ReadOnlySpan<RaycastCommand2D> commands, Span<PhysicsQueryHit2D> hits,
+                                        Span<int> hitCounts, Physics2DQueryMode mode = Physics2DQueryMode.Closest,
+                                        bool parallel = false)
+        {
+            RunQueryBatch(InternalCalls.Physics2D_RaycastBatch, commands, hits, hitCounts, mode, parallel);
+        }
+
+        /// <summary>批量圆形 / 矩形投射，缓冲区约定同 RaycastBatch。</summary>
+        public static void ShapeCastBatch(ReadOnlySpan<ShapeCastCommand2D> commands, Span<PhysicsQueryHit2D> hits,
+                                          Span<int> hitCounts, Physics2DQueryMode mode = Physics2DQueryMode.Closest,
+                                          bool parallel = false)
+        {
+            RunQueryBatch(InternalCalls.Physics2D_ShapeCastBatch, commands, hits, hitCounts, mode, parallel);
+        }
+
+        /// <summary>批量重叠检测，缓冲区约定同 RaycastBatch；同一实体只记一次。</summary>
+        public static void OverlapBatch(ReadOnlySpan<OverlapCommand2D> commands, Span<PhysicsQueryHit2D> hits,
+                                        Span<int> hitCounts, Physics2DQueryMode mode = Physics2DQueryMode.Closest,
+                                        bool parallel = false)
+        {
+            RunQueryBatch(InternalCalls.Physics2D_OverlapBatch, commands, hits, hitCounts, mode, parallel);
+        }
+
+        private static unsafe void RunQueryBatch<TCommand>(InternalCalls.Physics2DQueryBatchDelegate query,
+                                                           ReadOnlySpan<TCommand> commands,
+                                                           Span<PhysicsQueryHit2D> hits, Span<int> hitCounts,
+                                                           Physics2DQueryMode mode, bool parallel)
+            where TCommand : unmanaged
+        {
+            if (commands.IsEmpty)
+                return;
+            if (hitCounts.Length < commands.Length)
+                throw new ArgumentException("hitCounts must hold one entry per command", nameof(hitCounts));
+
+            int maxHitsPerQuery = hits.Length / commands.Length;
+            if (maxHitsPerQuery == 0)
+                throw new ArgumentException("hits must hold at least one entry per command", nameof(hits));
+
+            if (query == null)
+            {
+                hitCounts.Slice(0, commands.Length).Clear();
+                return;
+            }
+
+            fixed (TCommand* commandPointer = commands)
+            fixed (PhysicsQueryHit2D* hitPointer = hits)
+            fixed (int* hitCountPointer = hitCounts)
+            {
+                query((IntPtr)commandPointer, commands.Length, (int)mode, maxHitsPerQuery, parallel ? (byte)1 : (byte)0,
+                      (IntPtr)hitPointer, (IntPtr)hitCountPointer);
+            }
+        }
     }
 }
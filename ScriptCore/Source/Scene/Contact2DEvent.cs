@@ -0,0 +1,28 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace HimiiEngine
+{
+    internal enum Contact2DEventKind : int
+    {
+        CollisionEnter = 0,
+        CollisionExit = 1,
+        TriggerEnter = 2,
+        TriggerExit = 3
+    }
+
+    /// <summary>
+    /// 与原生 Contact2DEventInterop 布局一致；一步内的全部碰撞 / 触发事件以连续数组一次传入。
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct Contact2DEvent
+    {
+        public IntPtr SelfInstance;
+        public ulong SelfEntityID;
+        public ulong OtherEntityID;
+        public Vector2 Normal;
+        public Vector2 Point;
+        public Contact2DEventKind Kind;
+        private int _reserved;
+    }
+}
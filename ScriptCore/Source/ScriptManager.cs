@@ -259,71 +259,45 @@ namespace HimiiEngine
             }
         }
 
+        /// <summary>
+        /// 原生物理每步调用一次，把连续的事件数组逐条转发到脚本实例，避免每条事件各跨一次托管边界。
+        /// </summary>
         [UnmanagedCallersOnly]
-        public static void OnCollisionEnter2DInstance(IntPtr handlePtr, Collision2DInfo collision)
+        public static unsafe void DispatchContact2DEvents(IntPtr eventsPtr, int count)
         {
-            if (handlePtr == IntPtr.Zero) return;
+            if (eventsPtr == IntPtr.Zero || count <= 0) return;
 
-            try
-            {
-                GCHandle handle = GCHandle.FromIntPtr(handlePtr);
-                if (handle.IsAllocated && handle.Target is Entity entity)
-                    entity.OnCollisionEnter2D(collision);
-            }
-            catch (Exception e)
+            var events = new ReadOnlySpan<Contact2DEvent>((void*)eventsPtr, count);
+            foreach (ref readonly Contact2DEvent contactEvent in events)
             {
-                Console.WriteLine($"[C# Error] OnCollisionEnter2DInstance failed: {e.Message}");
-            }
-        }
-
-        [UnmanagedCallersOnly]
-        public static void OnCollisionExit2DInstance(IntPtr handlePtr, ulong otherEntityID)
-        {
-            if (handlePtr == IntPtr.Zero) return;
-
-            try
-            {
-                GCHandle handle = GCHandle.FromIntPtr(handlePtr);
-                if (handle.IsAllocated && handle.Target is Entity entity)
-                    entity.OnCollisionExit2D(new Collision2DInfo { OtherEntityID = otherEntityID });
-            }
-            catch (Exception exception)
-            {
-                Console.WriteLine($"[C# Error] OnCollisionExit2DInstance failed: {exception.Message}");
-            }
-        }
-
-        [UnmanagedCallersOnly]
-        public static void OnTriggerEnter2DInstance(IntPtr handlePtr, Collision2DInfo collision)
-        {
-            if (handlePtr == IntPtr.Zero) return;
+                // 前面的回调销毁本方或对方时，原生侧会就地清空这条记录的 SelfInstance。
+                if (contactEvent.SelfInstance == IntPtr.Zero) continue;
 
-            try
-            {
-                GCHandle handle = GCHandle.FromIntPtr(handlePtr);
-                if (handle.IsAllocated && handle.Target is Entity entity)
-                    entity.OnTriggerEnter2D(collision);
-            }
-            catch (Exception exception)
-            {
-                Console.WriteLine($"[C# Error] OnTriggerEnter2DInstance failed: {exception.Message}");
-            }
-        }
+                try
+                {
+                    GCHandle handle = GCHandle.FromIntPtr(contactEvent.SelfInstance);
+                    if (!handle.IsAllocated || handle.Target is not Entity entity)
+                        continue;
 
-        [UnmanagedCallersOnly]
-        public static void OnTriggerExit2DInstance(IntPtr handlePtr, ulong otherEntityID)
-        {
-            if (handlePtr == IntPtr.Zero) return;
+                    var collision = new Collision2DInfo
+                    {
+                        OtherEntityID = contactEvent.OtherEntityID,
+                        Normal = contactEvent.Normal,
+                        Point = contactEvent.Point
+                    };
 
-            try
-            {
-                GCHandle handle = GCHandle.FromIntPtr(handlePtr);
-                if (handle.IsAllocated && handle.Target is Entity entity)
-                    entity.OnTriggerExit2D(new Collision2DInfo { OtherEntityID = otherEntityID });
-            }
-            catch (Exception exception)
-            {
-                Console.WriteLine($"[C# Error] OnTriggerExit2DInstance failed: {exception.Message}");
+                    switch (contactEvent.Kind)
+                    {
+                        case Contact2DEventKind.CollisionEnter: entity.OnCollisionEnter2D(collision); break;
+                        case Contact2DEventKind.CollisionExit: entity.OnCollisionExit2D(collision); break;
+                        case Contact2DEventKind.TriggerEnter: entity.OnTriggerEnter2D(collision); break;
+                        case Contact2DEventKind.TriggerExit: entity.OnTriggerExit2D(collision); break;
+                    }
+                }
+                catch (Exception exception)
+                {
+                    Console.WriteLine($"[C# Error] DispatchContact2DEvents ({contactEvent.Kind}) failed: {exception.Message}");
+                }
             }
         }
 
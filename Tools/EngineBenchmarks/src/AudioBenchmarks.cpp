@@ -0,0 +1,635 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "Module/Audio/AudioEngine.h"
+#include "Module/Audio/AudioSpatialAttenuation.h"
+#include "Module/Audio/SoundStreamDecoder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+namespace Himii
+{
+    namespace
+    {
+        float MaximumSampleDifference(const std::vector<float>& left, const std::vector<float>& right)
+        {
+            float maximumDifference = left.size() == right.size() ? 0.0f : 1.0f;
+            for (size_t index = 0; index < std::min(left.size(), right.size()); ++index)
+                maximumDifference = std::max(maximumDifference, std::abs(left[index] - right[index]));
+            return maximumDifference;
+        }
+
+        /// 在不带设备的离线引擎上分别按整段 float、整段 int16 与流式解码播放同一文件，
+        /// 比较混音输出并报告各模式的常驻内存。
+        bool VerifyStreamingPlayback(const std::filesystem::path& soundPath)
+        {
+            SoundImportSettings decodedSettings;
+            decodedSettings.LoadMode = SoundLoadMode::Decompressed;
+            SoundImportSettings int16Settings = decodedSettings;
+            int16Settings.SampleFormat = SoundSampleFormat::Int16;
+            SoundImportSettings streamingSettings;
+            streamingSettings.LoadMode = SoundLoadMode::Streaming;
+
+            const Ref<SoundAsset> decodedSound = CreateRef<SoundAsset>(soundPath, decodedSettings);
+            const Ref<SoundAsset> int16Sound = CreateRef<SoundAsset>(soundPath, int16Settings);
+            const Ref<SoundAsset> streamingSound = CreateRef<SoundAsset>(soundPath, streamingSettings);
+            if (!decodedSound->IsValid() || !int16Sound->IsValid() || !streamingSound->IsValid()
+                || !streamingSound->IsStreaming())
+            {
+                HIMII_CORE_ERROR("Audio streaming check: '{0}' could not be loaded in every mode "
+                                 "(streaming needs a known length)",
+                                 soundPath.string());
+                return false;
+            }
+
+            HIMII_CORE_INFO("Audio streaming check: '{0}', {1:.1f} s, {2} channels, {3} Hz",
+                            soundPath.filename().string(), decodedSound->GetDurationSeconds(),
+                            decodedSound->GetChannelCount(), decodedSound->GetSampleRate());
+            HIMII_CORE_INFO("  resident memory: float {0:.1f} KB, int16 {1:.1f} KB, streaming {2:.1f} KB",
+                            decodedSound->GetResidentMemoryBytes() / 1024.0,
+                            int16Sound->GetResidentMemoryBytes() / 1024.0,
+                            streamingSound->GetResidentMemoryBytes() / 1024.0);
+
+            // 开头一段按原样比较；末尾一秒开循环播放两秒，检查流式解码回绕到开头的 seek。
+            const uint64_t frameCount = decodedSound->GetFrameCount();
+            const uint64_t sampleRate = decodedSound->GetSampleRate();
+            const uint64_t headFrameCount = std::min<uint64_t>(frameCount, sampleRate * 10);
+            const uint64_t loopStartFrame = frameCount > sampleRate ? frameCount - sampleRate : 0;
+
+            bool passed = true;
+            const auto compare = [&](const char* label, bool loop, uint64_t startFrame, uint64_t renderFrameCount)
+            {
+                std::vector<float> decodedOutput;
+                std::vector<float> int16Output;
+                std::vector<float> streamingOutput;
+                if (!AudioEngine::RenderSoundOffline(decodedSound, loop, startFrame, renderFrameCount, decodedOutput)
+                    || !AudioEngine::RenderSoundOffline(int16Sound, loop, startFrame, renderFrameCount, int16Output)
+                    || !AudioEngine::RenderSoundOffline(streamingSound, loop, startFrame, renderFrameCount,
+                                                        streamingOutput))
+                {
+                    HIMII_CORE_ERROR("  {0}: offline render failed", label);
+                    passed = false;
+                    return;
+                }
+
+                const float streamingDifference = MaximumSampleDifference(decodedOutput, streamingOutput);
+                const float int16Difference = MaximumSampleDifference(decodedOutput, int16Output);
+                // 流式与整段解码走同一个解码器，应逐样本一致；int16 只允许量化误差。
+                const bool streamingMatches = streamingDifference <= 1.0e-6f;
+                const bool int16Matches = int16Difference <= 2.0f / 32768.0f;
+                passed = passed && streamingMatches && int16Matches;
+                HIMII_CORE_INFO("  {0}: streaming max diff {1:.2e} ({2}), int16 max diff {3:.2e} ({4})", label,
+                                streamingDifference, streamingMatches ? "ok" : "MISMATCH", int16Difference,
+                                int16Matches ? "ok" : "MISMATCH");
+            };
+
+            compare("head", false, 0, headFrameCount);
+            compare("loop wrap", true, loopStartFrame, sampleRate * 2);
+
+            // 归还的解码器会被再次借出，不重新打开文件；借出只是从池中取走，开销应远小于打开。
+            const auto acquireStart = std::chrono::steady_clock::now();
+            Scope<SoundStreamDecoder> decoder = streamingSound->AcquireStreamDecoder();
+            const double acquireMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - acquireStart).count();
+            const SoundStreamDecoder* releasedDecoder = decoder.get();
+            streamingSound->ReleaseStreamDecoder(std::move(decoder));
+
+            std::vector<Scope<SoundStreamDecoder>> borrowedDecoders;
+            const uint32_t idleDecoderCount = streamingSound->GetIdleStreamDecoderCount();
+            for (uint32_t decoderIndex = 0; decoderIndex < idleDecoderCount; ++decoderIndex)
+                borrowedDecoders.push_back(streamingSound->AcquireStreamDecoder());
+            const bool decoderReused =
+                releasedDecoder && std::any_of(borrowedDecoders.begin(), borrowedDecoders.end(),
+                                               [&](const Scope<SoundStreamDecoder>& borrowedDecoder)
+                                               { return borrowedDecoder.get() == releasedDecoder; });
+            for (Scope<SoundStreamDecoder>& borrowedDecoder : borrowedDecoders)
+                streamingSound->ReleaseStreamDecoder(std::move(borrowedDecoder));
+
+            const auto openStart = std::chrono::steady_clock::now();
+            const Scope<SoundStreamDecoder> openedDecoder = streamingSound->OpenStreamDecoder();
+            const double openMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - openStart).count();
+            passed = passed && decoderReused;
+            HIMII_CORE_INFO("  decoder pool: released decoder reused ({0}), acquire {1:.1f} us, open {2:.1f} us",
+                            decoderReused ? "ok" : "FAILED", acquireMicroseconds, openMicroseconds);
+            return passed;
+        }
+
+        /// 以无设备模式初始化引擎，用合成音源检查虚拟 voice 的提升 / 降级、游标连续性、
+        /// 距离衰减与剔除以及播放开销。
+        bool VerifyVoiceVirtualization()
+        {
+            if (!AudioEngine::InitOffline())
+                return false;
+
+            constexpr uint32_t ChannelCount = AudioEngine::OfflineChannelCount;
+            constexpr uint32_t SampleRate = AudioEngine::OfflineSampleRate;
+            constexpr uint32_t MaximumRealVoiceCount = AudioEngine::MaximumRealVoiceCount;
+            constexpr int32_t DefaultVoicePriority = AudioEngine::DefaultVoicePriority;
+
+            // 一秒的循环正弦音，格式与引擎一致，提升时不应重建任何 ma_sound。
+            std::vector<float> toneSamples(static_cast<size_t>(SampleRate) * ChannelCount);
+            for (size_t frame = 0; frame < SampleRate; ++frame)
+            {
+                const float sample = 0.25f * std::sin(6.2831853f * 440.0f * static_cast<float>(frame) / SampleRate);
+                for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                    toneSamples[frame * ChannelCount + channel] = sample;
+            }
+            const Ref<SoundAsset> tone = CreateRef<SoundAsset>(std::move(toneSamples), ChannelCount, SampleRate);
+            const uint64_t toneFrameCount = tone->GetFrameCount();
+
+            // 与设备回调一样先混音再 Update；累计的帧数就是每个循环 voice 应处的位置。
+            std::vector<float> mixBuffer;
+            uint64_t renderedFrameCount = 0;
+            const auto advance = [&](uint32_t frameCount)
+            {
+                mixBuffer.resize(static_cast<size_t>(frameCount) * ChannelCount);
+                AudioEngine::ReadOfflineFrames(mixBuffer.data(), frameCount);
+                renderedFrameCount += frameCount;
+                AudioEngine::Update(static_cast<float>(frameCount) / SampleRate);
+            };
+            const auto isReal = [](AudioVoiceHandle handle)
+            {
+                AudioVoiceInfo info;
+                return AudioEngine::GetVoiceInfo(handle, info) && info.Real;
+            };
+
+            bool passed = true;
+            const auto report = [&passed](const char* label, bool condition)
+            {
+                passed = passed && condition;
+                HIMII_CORE_INFO("  {0}: {1}", label, condition ? "ok" : "FAILED");
+            };
+
+            HIMII_CORE_INFO("Audio voice virtualization check: {0} real / {1} virtual voices, {2} Hz",
+                            MaximumRealVoiceCount, AudioEngine::MaximumVirtualVoiceCount, SampleRate);
+
+            // 1. 256 个音量递增的循环 voice，Update 后只有最响的 32 个占用真实 voice。
+            constexpr uint32_t LoopingVoiceCount = 256;
+            std::vector<AudioVoiceHandle> loopingVoices;
+            const auto playStart = std::chrono::steady_clock::now();
+            for (uint32_t voiceIndex = 0; voiceIndex < LoopingVoiceCount; ++voiceIndex)
+                loopingVoices.push_back(
+                    AudioEngine::Play(tone, static_cast<float>(voiceIndex + 1) / LoopingVoiceCount, true, false));
+            const double playMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - playStart).count();
+
+            advance(SampleRate / 60);
+            bool loudestAreReal = true;
+            for (uint32_t voiceIndex = 0; voiceIndex < LoopingVoiceCount; ++voiceIndex)
+            {
+                const bool expectedReal = voiceIndex >= LoopingVoiceCount - MaximumRealVoiceCount;
+                loudestAreReal = loudestAreReal && isReal(loopingVoices[voiceIndex]) == expectedReal;
+            }
+            AudioVoiceStatistics statistics = AudioEngine::GetVoiceStatistics();
+            report("loudest voices own the real voices",
+                   loudestAreReal && statistics.ActiveVoiceCount == LoopingVoiceCount
+                       && statistics.RealVoiceCount == MaximumRealVoiceCount);
+
+            // 2. 高优先级的小音量 OneShot 在 Play 时立即挤掉最弱的真实 voice。
+            const AudioVoiceHandle urgentVoice = AudioEngine::PlayOneShot(tone, 0.05f, DefaultVoicePriority + 1);
+            const uint32_t weakestRealVoiceIndex = LoopingVoiceCount - MaximumRealVoiceCount;
+            report("higher priority steals a real voice on Play",
+                   isReal(urgentVoice) && !isReal(loopingVoices[weakestRealVoiceIndex]));
+
+            // 3. 虚拟期间游标随时间推进，提升后从同一位置继续播放（跨过一次循环回绕）。
+            for (int step = 0; step < 5; ++step)
+                advance(SampleRate / 4);
+            const AudioVoiceHandle resumedVoice = loopingVoices[10];
+            AudioEngine::SetVolume(resumedVoice, 1.0f);
+            advance(SampleRate / 60);
+            advance(SampleRate / 10);
+            AudioVoiceInfo resumedInfo;
+            const bool resumedReal = AudioEngine::GetVoiceInfo(resumedVoice, resumedInfo) && resumedInfo.Real;
+            const uint64_t cursorFrame = resumedReal ? resumedInfo.CursorFrame : 0;
+            const uint64_t expectedCursorFrame = renderedFrameCount % toneFrameCount;
+            const uint64_t cursorError = cursorFrame > expectedCursorFrame ? cursorFrame - expectedCursorFrame
+                                                                           : expectedCursorFrame - cursorFrame;
+            HIMII_CORE_INFO("  promoted cursor {0}, expected {1}", cursorFrame, expectedCursorFrame);
+            report("promoted voice continues from its virtual cursor", resumedReal && cursorError <= 2);
+
+            // 4. 听不到的 OneShot 在虚拟状态下也会播完并回收。
+            statistics = AudioEngine::GetVoiceStatistics();
+            const uint32_t activeBeforeOneShots = statistics.ActiveVoiceCount;
+            std::vector<AudioVoiceHandle> quietOneShots;
+            for (int voiceIndex = 0; voiceIndex < 64; ++voiceIndex)
+                quietOneShots.push_back(AudioEngine::PlayOneShot(tone, 0.001f));
+            const bool quietOneShotsVirtual = std::none_of(quietOneShots.begin(), quietOneShots.end(), isReal);
+            advance(SampleRate / 2);
+            advance(SampleRate / 2 + SampleRate / 10);
+            const bool quietOneShotsFinished =
+                std::none_of(quietOneShots.begin(), quietOneShots.end(),
+                             [](AudioVoiceHandle handle) { return AudioEngine::IsPlaying(handle); });
+            statistics = AudioEngine::GetVoiceStatistics();
+            report("virtual one-shots finish and are reclaimed",
+                   quietOneShotsVirtual && quietOneShotsFinished
+                       && statistics.ActiveVoiceCount == activeBeforeOneShots);
+
+            // 5. 旧句柄在槽位复用后失效。
+            AudioEngine::Stop(loopingVoices[0]);
+            const AudioVoiceHandle reusedVoice = AudioEngine::PlayOneShot(tone, 0.001f);
+            report("stale handles are rejected",
+                   !AudioEngine::IsPlaying(loopingVoices[0]) && AudioEngine::IsPlaying(reusedVoice));
+
+            // 6. 满载时 Play / Stop 与 Update 的开销。
+            constexpr int CostIterationCount = 1000;
+            const auto stopStart = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < CostIterationCount; ++iteration)
+                AudioEngine::Stop(AudioEngine::PlayOneShot(tone, 0.5f));
+            const double playStopMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - stopStart).count();
+            const auto updateStart = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < 100; ++iteration)
+                AudioEngine::Update(1.0f / 60.0f);
+            const double updateMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - updateStart).count();
+            statistics = AudioEngine::GetVoiceStatistics();
+            HIMII_CORE_INFO("  Play x{0}: {1:.2f} us each; Play+Stop under load: {2:.2f} us each; "
+                            "Update with {3} voices: {4:.1f} us",
+                            LoopingVoiceCount, playMicroseconds / LoopingVoiceCount,
+                            playStopMicroseconds / CostIterationCount, statistics.ActiveVoiceCount,
+                            updateMicroseconds / 100.0);
+
+            // 7. 单声道 24 kHz 的声音在 48 kHz 立体声引擎上经转换器播放：游标按源采样率推进，
+            //    输出不是静音，预留的转换器堆足够，不扩容。
+            AudioEngine::StopAll();
+            const uint32_t monoSampleRate = SampleRate / 2;
+            std::vector<float> monoToneSamples(monoSampleRate);
+            for (uint32_t frame = 0; frame < monoSampleRate; ++frame)
+                monoToneSamples[frame] =
+                    0.25f * std::sin(6.2831853f * 440.0f * static_cast<float>(frame) / monoSampleRate);
+            const Ref<SoundAsset> monoTone = CreateRef<SoundAsset>(std::move(monoToneSamples), 1, monoSampleRate);
+            const AudioVoiceHandle monoVoice = AudioEngine::Play(monoTone, 1.0f, true, false);
+            const uint64_t monoStartFrame = renderedFrameCount;
+            advance(SampleRate / 10);
+            float monoPeak = 0.0f;
+            for (float sample : mixBuffer)
+                monoPeak = std::max(monoPeak, std::abs(sample));
+            AudioVoiceInfo monoInfo;
+            const bool monoReal = AudioEngine::GetVoiceInfo(monoVoice, monoInfo) && monoInfo.Real;
+            const uint64_t monoCursorFrame = monoReal ? monoInfo.CursorFrame : 0;
+            const uint64_t expectedMonoCursorFrame = (renderedFrameCount - monoStartFrame) * monoSampleRate / SampleRate;
+            const uint64_t monoCursorError = monoCursorFrame > expectedMonoCursorFrame
+                                                 ? monoCursorFrame - expectedMonoCursorFrame
+                                                 : expectedMonoCursorFrame - monoCursorFrame;
+            statistics = AudioEngine::GetVoiceStatistics();
+            HIMII_CORE_INFO("  converted cursor {0}, expected {1}, peak {2:.3f}", monoCursorFrame,
+                            expectedMonoCursorFrame, monoPeak);
+            report("mono 24 kHz voice plays through the converter",
+                   monoReal && monoCursorError <= 8 && monoPeak > 0.1f);
+            report("converter heap reserved up front", statistics.ConverterHeapGrowthCount == 0);
+
+            // 8. 空间化：2D 听者在原点，512 个声源排成一列；超出 MaxDistance 的不占真实 voice，
+            //    其余按距离衰减竞争，最近的 32 个成为真实 voice。
+            AudioEngine::StopAll();
+            AudioListener listener;
+            listener.Planar = true;
+            AudioEngine::SetListener(listener);
+
+            constexpr uint32_t EmitterCount = 512;
+            AudioSpatialSettings spatialSettings;
+            spatialSettings.Enabled = true;
+            const auto emitterX = [](uint32_t emitterIndex) { return static_cast<float>(emitterIndex) * 0.5f - 100.1f; };
+            std::vector<AudioVoiceHandle> emitterVoices;
+            std::vector<glm::vec3> emitterPositions;
+            for (uint32_t emitterIndex = 0; emitterIndex < EmitterCount; ++emitterIndex)
+            {
+                emitterVoices.push_back(AudioEngine::Play(tone, 1.0f, true, false, DefaultVoicePriority,
+                                                          spatialSettings, glm::vec3(1000.0f, 0.0f, 0.0f)));
+                emitterPositions.emplace_back(emitterX(emitterIndex), 0.0f, 5.0f);
+            }
+            statistics = AudioEngine::GetVoiceStatistics();
+            report("emitters beyond MaxDistance are culled before taking a real voice",
+                   statistics.ActiveVoiceCount == EmitterCount && statistics.RealVoiceCount == 0);
+
+            AudioEngine::SetVoicePositions(emitterVoices.data(), emitterPositions.data(), EmitterCount);
+            advance(SampleRate / 60);
+
+            std::vector<float> sortedDistances;
+            for (uint32_t emitterIndex = 0; emitterIndex < EmitterCount; ++emitterIndex)
+                sortedDistances.push_back(std::abs(emitterX(emitterIndex)));
+            std::nth_element(sortedDistances.begin(), sortedDistances.begin() + MaximumRealVoiceCount - 1,
+                             sortedDistances.end());
+            const float farthestRealDistance = sortedDistances[MaximumRealVoiceCount - 1];
+
+            bool nearestAreReal = true;
+            bool attenuationMatches = true;
+            bool realVolumeMatches = true;
+            for (uint32_t emitterIndex = 0; emitterIndex < EmitterCount; ++emitterIndex)
+            {
+                AudioVoiceInfo info;
+                if (!AudioEngine::GetVoiceInfo(emitterVoices[emitterIndex], info))
+                {
+                    nearestAreReal = false;
+                    continue;
+                }
+                const float x = emitterX(emitterIndex);
+                const float distance = std::abs(x);
+                nearestAreReal = nearestAreReal && info.Real == (distance <= farthestRealDistance);
+
+                const float expectedGain =
+                    distance > spatialSettings.MaxDistance ? 0.0f : 1.0f / std::max(distance, 1.0f);
+                attenuationMatches = attenuationMatches && std::abs(info.SpatialGain - expectedGain) <= 1.0e-4f
+                                     && (x > 0.0f ? info.SpatialPan > 0.0f : info.SpatialPan < 0.0f);
+                if (info.Real)
+                    realVolumeMatches = realVolumeMatches && std::abs(info.RealVolume - info.SpatialGain) <= 1.0e-4f;
+            }
+            report("nearest emitters own the real voices", nearestAreReal);
+            report("inverse attenuation, MaxDistance cull and pan match", attenuationMatches);
+            report("real voice volume follows attenuation", realVolumeMatches);
+            AudioEngine::Shutdown();
+
+            // 与 Update 相同的整批计算，覆盖全部虚拟 voice 槽位。
+            SpatialEmitterArrays emitters;
+            emitters.Resize(AudioEngine::MaximumVirtualVoiceCount);
+            for (uint32_t emitterIndex = 0; emitterIndex < AudioEngine::MaximumVirtualVoiceCount; ++emitterIndex)
+            {
+                emitters.PositionX[emitterIndex] = emitterX(emitterIndex % EmitterCount);
+                emitters.PositionZ[emitterIndex] = 5.0f;
+                emitters.MaxDistance[emitterIndex] = spatialSettings.MaxDistance;
+            }
+            const ListenerFrame listenerFrame = BuildListenerFrame(listener);
+            constexpr int AttenuationIterationCount = 1000;
+            const auto attenuationStart = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < AttenuationIterationCount; ++iteration)
+                EvaluateSpatialAttenuation(emitters, listenerFrame, AudioEngine::MaximumVirtualVoiceCount);
+            const double attenuationMicroseconds =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - attenuationStart).count();
+            HIMII_CORE_INFO("  attenuation for {0} emitters ({1}): {2:.2f} us", AudioEngine::MaximumVirtualVoiceCount,
+                            IsSpatialAttenuationSse2Enabled() ? "SSE2" : "scalar",
+                            attenuationMicroseconds / AttenuationIterationCount);
+            return passed;
+        }
+
+        /// 以无设备模式用合成音源检查总线增益、滤波、限幅、侧链闪避与渲染结果的确定性，
+        /// 并报告各总线的处理开销。
+        bool VerifyMixerBuses()
+        {
+            if (AudioEngine::IsInitialized())
+            {
+                HIMII_CORE_ERROR("Audio mixer bus check must run before AudioEngine::Init");
+                return false;
+            }
+
+            static constexpr uint32_t ChannelCount = AudioEngine::OfflineChannelCount;
+            static constexpr uint32_t SampleRate = AudioEngine::OfflineSampleRate;
+            static constexpr uint32_t BlockFrameCount = 480;
+            constexpr int32_t DefaultVoicePriority = AudioEngine::DefaultVoicePriority;
+
+            // 一秒的循环音源；整数频率保证循环处相位连续。
+            const auto createSound = [](const std::function<float(uint32_t)>& generateSample)
+            {
+                std::vector<float> samples(static_cast<size_t>(SampleRate) * ChannelCount);
+                for (uint32_t frame = 0; frame < SampleRate; ++frame)
+                {
+                    const float sample = generateSample(frame);
+                    for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+                        samples[static_cast<size_t>(frame) * ChannelCount + channel] = sample;
+                }
+                return CreateRef<SoundAsset>(std::move(samples), ChannelCount, SampleRate);
+            };
+            const auto createTone = [&](float frequency, float amplitude)
+            {
+                return createSound([=](uint32_t frame)
+                                   { return amplitude * std::sin(6.2831853f * frequency * frame / SampleRate); });
+            };
+            uint32_t noiseState = 22222u;
+            const Ref<SoundAsset> noise = createSound(
+                [&noiseState](uint32_t)
+                {
+                    noiseState = noiseState * 1664525u + 1013904223u;
+                    return static_cast<float>(noiseState >> 8) / 16777216.0f - 0.5f;
+                });
+            const Ref<SoundAsset> lowTone = createTone(100.0f, 0.5f);
+            const Ref<SoundAsset> highTone = createTone(8000.0f, 0.5f);
+            const Ref<SoundAsset> musicTone = createTone(220.0f, 0.5f);
+            const Ref<SoundAsset> dialogueTone = createTone(330.0f, 0.5f);
+            const Ref<SoundAsset> loudTone = createTone(440.0f, 0.9f);
+
+            std::vector<float> output;
+            const auto render = [&](uint32_t blockCount)
+            {
+                const size_t offset = output.size();
+                output.resize(offset + static_cast<size_t>(blockCount) * BlockFrameCount * ChannelCount);
+                for (uint32_t block = 0; block < blockCount; ++block)
+                {
+                    AudioEngine::ReadOfflineFrames(
+                        output.data() + offset + static_cast<size_t>(block) * BlockFrameCount * ChannelCount,
+                        BlockFrameCount);
+                    AudioEngine::Update(static_cast<float>(BlockFrameCount) / SampleRate);
+                }
+            };
+            // 每个场景重新初始化引擎，输出只取决于设置与播放请求。
+            const auto runScenario = [&](const AudioMixerSettings& mixerSettings, const std::function<void()>& scenario)
+            {
+                output.clear();
+                AudioEngine::SetMixerSettings(mixerSettings);
+                if (!AudioEngine::InitOffline())
+                    return false;
+                scenario();
+                AudioEngine::Shutdown();
+                return true;
+            };
+            // 跳过前 0.1 秒，避开滤波器的起振过程。
+            const auto measureRootMeanSquare = [&]()
+            {
+                const size_t beginIndex = std::min(output.size(), static_cast<size_t>(SampleRate / 10) * ChannelCount);
+                double sum = 0.0;
+                for (size_t index = beginIndex; index < output.size(); ++index)
+                    sum += static_cast<double>(output[index]) * output[index];
+                return output.size() > beginIndex ? static_cast<float>(std::sqrt(sum / (output.size() - beginIndex)))
+                                                  : 0.0f;
+            };
+            const auto measureTone = [&](const AudioMixerSettings& mixerSettings, const Ref<SoundAsset>& tone)
+            {
+                float rootMeanSquare = -1.0f;
+                runScenario(mixerSettings,
+                            [&]()
+                            {
+                                AudioEngine::Play(tone, 1.0f, true);
+                                render(50);
+                                rootMeanSquare = measureRootMeanSquare();
+                            });
+                return rootMeanSquare;
+            };
+
+            bool passed = true;
+            const auto report = [&passed](const char* label, bool condition)
+            {
+                passed = passed && condition;
+                HIMII_CORE_INFO("  {0}: {1}", label, condition ? "ok" : "FAILED");
+            };
+
+            const AudioMixerSettings previousMixerSettings = AudioEngine::GetMixerSettings();
+            HIMII_CORE_INFO("Audio mixer bus check: {0} buses, {1} Hz, {2}-frame blocks", AudioBusCount, SampleRate,
+                            BlockFrameCount);
+
+            // 1. 总线增益线性作用在输出上。
+            const AudioMixerSettings neutralSettings;
+            AudioMixerSettings halfGainSettings;
+            halfGainSettings.Get(AudioBus::SFX).Gain = 0.5f;
+            const float unityLevel = measureTone(neutralSettings, lowTone);
+            const float halfGainLevel = measureTone(halfGainSettings, lowTone);
+            report("bus gain scales the mix",
+                   unityLevel > 0.0f && std::abs(halfGainLevel / unityLevel - 0.5f) < 1.0e-3f);
+
+            // 2. 低通放过 100 Hz、压掉 8 kHz；高通相反。
+            AudioMixerSettings lowPassSettings;
+            lowPassSettings.Get(AudioBus::SFX).FilterType = AudioBusFilterType::LowPass;
+            lowPassSettings.Get(AudioBus::SFX).FilterCutoffHz = 500.0f;
+            AudioMixerSettings highPassSettings;
+            highPassSettings.Get(AudioBus::SFX).FilterType = AudioBusFilterType::HighPass;
+            highPassSettings.Get(AudioBus::SFX).FilterCutoffHz = 2000.0f;
+            const float highToneLevel = measureTone(neutralSettings, highTone);
+            const float lowPassLowRatio = measureTone(lowPassSettings, lowTone) / unityLevel;
+            const float lowPassHighRatio = measureTone(lowPassSettings, highTone) / highToneLevel;
+            const float highPassLowRatio = measureTone(highPassSettings, lowTone) / unityLevel;
+            const float highPassHighRatio = measureTone(highPassSettings, highTone) / highToneLevel;
+            HIMII_CORE_INFO("  low-pass 500 Hz: 100 Hz x{0:.3f}, 8 kHz x{1:.4f}; high-pass 2 kHz: 100 Hz x{2:.4f}, "
+                            "8 kHz x{3:.3f}",
+                            lowPassLowRatio, lowPassHighRatio, highPassLowRatio, highPassHighRatio);
+            report("biquad low-pass / high-pass",
+                   lowPassLowRatio > 0.95f && lowPassHighRatio < 0.01f && highPassLowRatio < 0.01f
+                       && highPassHighRatio > 0.95f);
+
+            // 3. 两个同相的 0.9 振幅音源叠加到 1.8，Master 限幅后峰值不超过阈值。
+            AudioMixerSettings limiterSettings;
+            limiterSettings.Get(AudioBus::Master).LimiterEnabled = true;
+            limiterSettings.Get(AudioBus::Master).LimiterThreshold = 0.5f;
+            float limitedPeak = 0.0f;
+            float limiterGain = 1.0f;
+            runScenario(limiterSettings,
+                        [&]()
+                        {
+                            AudioEngine::Play(loudTone, 1.0f, true, true, DefaultVoicePriority, {}, glm::vec3(0.0f),
+                                              AudioBus::SFX);
+                            AudioEngine::Play(loudTone, 1.0f, true, true, DefaultVoicePriority, {}, glm::vec3(0.0f),
+                                              AudioBus::UI);
+                            render(50);
+                            for (float sample : output)
+                                limitedPeak = std::max(limitedPeak, std::abs(sample));
+                            limiterGain = AudioEngine::GetBusStatistics(AudioBus::Master).LimiterGain;
+                        });
+            HIMII_CORE_INFO("  limiter peak {0:.4f} (threshold 0.5), gain {1:.3f}", limitedPeak, limiterGain);
+            report("master limiter holds the threshold", limitedPeak <= 0.5f + 1.0e-5f && limitedPeak > 0.45f);
+
+            // 4. Voice 总线出声时 Music 被压到 DuckGain，停止后按释放时间恢复。
+            AudioMixerSettings duckingSettings;
+            AudioBusSettings& musicBusSettings = duckingSettings.Get(AudioBus::Music);
+            musicBusSettings.DuckingEnabled = true;
+            musicBusSettings.DuckSource = AudioBus::Voice;
+            musicBusSettings.DuckGain = 0.25f;
+            musicBusSettings.DuckAttackSeconds = 0.01f;
+            musicBusSettings.DuckReleaseSeconds = 0.1f;
+            AudioBusStatistics musicBefore, musicDucked, musicRecovered;
+            runScenario(duckingSettings,
+                        [&]()
+                        {
+                            AudioEngine::Play(musicTone, 1.0f, true, true, DefaultVoicePriority, {}, glm::vec3(0.0f),
+                                              AudioBus::Music);
+                            render(20);
+                            musicBefore = AudioEngine::GetBusStatistics(AudioBus::Music);
+                            const AudioVoiceHandle dialogue =
+                                AudioEngine::Play(dialogueTone, 1.0f, true, true, DefaultVoicePriority, {},
+                                                  glm::vec3(0.0f), AudioBus::Voice);
+                            render(20);
+                            musicDucked = AudioEngine::GetBusStatistics(AudioBus::Music);
+                            AudioEngine::Stop(dialogue);
+                            render(100);
+                            musicRecovered = AudioEngine::GetBusStatistics(AudioBus::Music);
+                        });
+            HIMII_CORE_INFO("  music peak {0:.3f} -> ducked {1:.3f} (gain {2:.3f}) -> released {3:.3f} (gain {4:.3f})",
+                            musicBefore.PeakLevel, musicDucked.PeakLevel, musicDucked.DuckGain,
+                            musicRecovered.PeakLevel, musicRecovered.DuckGain);
+            report("voice bus ducks music and releases",
+                   musicBefore.DuckGain > 0.999f && std::abs(musicDucked.DuckGain - 0.25f) < 0.01f
+                       && std::abs(musicDucked.PeakLevel - 0.125f) < 0.01f && musicRecovered.DuckGain > 0.99f);
+
+            // 5. 全部效果同时开启，两次独立渲染逐样本一致；顺带统计各总线开销。
+            AudioMixerSettings combinedSettings = duckingSettings;
+            combinedSettings.Get(AudioBus::SFX) = lowPassSettings.Get(AudioBus::SFX);
+            combinedSettings.Get(AudioBus::UI).Gain = 0.7f;
+            combinedSettings.Get(AudioBus::Master) = limiterSettings.Get(AudioBus::Master);
+            combinedSettings.Get(AudioBus::Master).LimiterThreshold = 0.8f;
+            std::array<AudioBusStatistics, AudioBusCount> busStatistics{};
+            const auto renderCombined = [&]()
+            {
+                runScenario(combinedSettings,
+                            [&]()
+                            {
+                                AudioEngine::Play(musicTone, 1.0f, true, true, DefaultVoicePriority, {},
+                                                  glm::vec3(0.0f), AudioBus::Music);
+                                AudioEngine::Play(noise, 0.8f, true);
+                                AudioEngine::PlayOneShot(highTone, 0.5f, DefaultVoicePriority, {}, glm::vec3(0.0f),
+                                                         AudioBus::UI);
+                                render(50);
+                                const AudioVoiceHandle dialogue =
+                                    AudioEngine::Play(dialogueTone, 1.0f, true, true, DefaultVoicePriority, {},
+                                                      glm::vec3(0.0f), AudioBus::Voice);
+                                render(50);
+                                AudioEngine::Stop(dialogue);
+                                render(100);
+                                for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+                                    busStatistics[static_cast<size_t>(busIndex)] =
+                                        AudioEngine::GetBusStatistics(static_cast<AudioBus>(busIndex));
+                            });
+                return output;
+            };
+            const std::vector<float> firstRender = renderCombined();
+            const std::vector<float> secondRender = renderCombined();
+            report("null-backend render is deterministic",
+                   !firstRender.empty() && firstRender.size() == secondRender.size()
+                       && std::memcmp(firstRender.data(), secondRender.data(), firstRender.size() * sizeof(float))
+                              == 0);
+
+            for (int busIndex = 0; busIndex < AudioBusCount; ++busIndex)
+            {
+                const AudioBusStatistics& statistics = busStatistics[static_cast<size_t>(busIndex)];
+                const double audioMicroseconds =
+                    static_cast<double>(statistics.ProcessedFrameCount) * 1.0e6 / SampleRate;
+                HIMII_CORE_INFO("  {0}: {1:.2f} us per block over {2} blocks ({3:.3f}% of real time)",
+                                GetAudioBusName(static_cast<AudioBus>(busIndex)),
+                                statistics.ProcessedBlockCount > 0
+                                    ? statistics.ProcessMicroseconds / statistics.ProcessedBlockCount
+                                    : 0.0,
+                                statistics.ProcessedBlockCount,
+                                audioMicroseconds > 0.0 ? statistics.ProcessMicroseconds / audioMicroseconds * 100.0
+                                                        : 0.0);
+            }
+
+            AudioEngine::SetMixerSettings(previousMixerSettings);
+            return passed;
+        }
+    }
+
+    bool RunAudioStreamingCheck(ApplicationCommandLineArgs args, const char* argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::filesystem::path soundPath;
+        if (!ReadPathArgument(args, argument, soundPath))
+        {
+            HIMII_CORE_ERROR("{0} requires a sound file path", argument);
+            return false;
+        }
+        return VerifyStreamingPlayback(soundPath);
+    }
+
+    bool RunVoiceVirtualizationCheck(ApplicationCommandLineArgs, const char*)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return VerifyVoiceVirtualization();
+    }
+
+    bool RunMixerBusCheck(ApplicationCommandLineArgs, const char*)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return VerifyMixerBuses();
+    }
+}
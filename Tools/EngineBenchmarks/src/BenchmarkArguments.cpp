@@ -0,0 +1,57 @@
+#include "Hepch.h"
+#include "BenchmarkArguments.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace Himii
+{
+    bool HasCommandLineArgument(ApplicationCommandLineArgs args, const char *argument)
+    {
+        for (int argumentIndex = 1; argumentIndex < args.Count; ++argumentIndex)
+        {
+            if (std::strcmp(args[argumentIndex], argument) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    uint32_t ReadCountArgument(ApplicationCommandLineArgs args, const char *argument, uint32_t defaultValue,
+                               int valueOffset)
+    {
+        for (int argumentIndex = 1; argumentIndex + valueOffset < args.Count; ++argumentIndex)
+        {
+            if (std::strcmp(args[argumentIndex], argument) != 0)
+                continue;
+            const long requestedValue = std::strtol(args[argumentIndex + valueOffset], nullptr, 10);
+            if (requestedValue > 0)
+                return static_cast<uint32_t>(requestedValue);
+        }
+        return defaultValue;
+    }
+
+    std::vector<uint32_t> ReadCountListArgument(ApplicationCommandLineArgs args, const char *argument)
+    {
+        std::vector<uint32_t> values;
+        for (int valueOffset = 1;; ++valueOffset)
+        {
+            const uint32_t value = ReadCountArgument(args, argument, 0, valueOffset);
+            if (value == 0)
+                break;
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    bool ReadPathArgument(ApplicationCommandLineArgs args, const char *argument, std::filesystem::path &outPath)
+    {
+        for (int argumentIndex = 1; argumentIndex + 1 < args.Count; ++argumentIndex)
+        {
+            if (std::strcmp(args[argumentIndex], argument) != 0)
+                continue;
+            outPath = std::filesystem::absolute(args[argumentIndex + 1]);
+            return true;
+        }
+        return false;
+    }
+}
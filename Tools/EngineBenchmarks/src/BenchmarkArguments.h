@@ -0,0 +1,19 @@
+#pragma once
+
+#include "EngineCore/Core/Application.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Himii
+{
+    bool HasCommandLineArgument(ApplicationCommandLineArgs args, const char *argument);
+    /// 读取 argument 之后第 valueOffset 个位置上的正整数，缺省或非法时返回 defaultValue。
+    uint32_t ReadCountArgument(ApplicationCommandLineArgs args, const char *argument, uint32_t defaultValue,
+                               int valueOffset = 1);
+    /// 读取紧跟在 argument 之后的连续正整数，遇到第一个缺省或非法值为止。
+    std::vector<uint32_t> ReadCountListArgument(ApplicationCommandLineArgs args, const char *argument);
+    /// 读取紧跟在 argument 之后的文件路径并转为绝对路径，缺省时返回 false。
+    bool ReadPathArgument(ApplicationCommandLineArgs args, const char *argument, std::filesystem::path &outPath);
+}
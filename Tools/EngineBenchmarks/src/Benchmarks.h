@@ -0,0 +1,24 @@
+#pragma once
+
+#include "EngineCore/Core/Application.h"
+
+namespace Himii
+{
+    /// 每个基准 / 校验模式的入口；argument 为触发它的命令行参数，供读取紧随其后的参数值。
+    using BenchmarkFunction = bool (*)(ApplicationCommandLineArgs args, const char *argument);
+
+    bool RunEnvironmentBakeBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunEnvironmentPollingCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunUserInterfaceLayoutBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunPhysicsDeterminismCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunPhysicsStepBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunTilemapColliderBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunAudioStreamingCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunVoiceVirtualizationCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunMixerBusCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunMeshletCullingBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunMeshImportBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunTextureMipCheck(ApplicationCommandLineArgs args, const char *argument);
+    bool RunMaterialResolveBenchmark(ApplicationCommandLineArgs args, const char *argument);
+    bool RunGlyphCacheBenchmark(ApplicationCommandLineArgs args, const char *argument);
+}
@@ -0,0 +1,227 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/Environment/EnvironmentBake.h"
+#include "Module/Render/Environment/EnvironmentLightingSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr float Pi = 3.14159265358979323846f;
+
+        /// 单个立方体分辨率下各 CPU 烘焙阶段耗时（毫秒）。
+        struct EnvironmentBakeTimings
+        {
+            uint32_t CubemapResolution = 0;
+            uint32_t PrefilterResolution = 0;
+            float EquirectangularToCubemapMilliseconds = 0.0f;
+            float IrradianceSphericalHarmonicsMilliseconds = 0.0f;
+            float IrradianceConvolutionMilliseconds = 0.0f;
+            float PrefilterMilliseconds = 0.0f;
+        };
+
+        /// 天空渐变 + 太阳高光，亮度跨度与真实 HDR 相近，供烘焙基准使用。
+        EquirectangularImage CreateBenchmarkEquirectangular(int width, int height)
+        {
+            EquirectangularImage image;
+            image.Width = width;
+            image.Height = height;
+            image.Rgb.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 3u);
+            const glm::vec3 sunDirection = glm::normalize(glm::vec3(0.3f, 0.6f, 0.4f));
+            for (int y = 0; y < height; ++y)
+            {
+                const float latitude = Pi * (0.5f - (static_cast<float>(y) + 0.5f) / static_cast<float>(height));
+                for (int x = 0; x < width; ++x)
+                {
+                    const float longitude = 2.0f * Pi * (static_cast<float>(x) + 0.5f) / static_cast<float>(width) - Pi;
+                    const glm::vec3 direction(std::cos(latitude) * std::cos(longitude), std::sin(latitude),
+                                              std::cos(latitude) * std::sin(longitude));
+                    const float skyBlend = glm::clamp(direction.y * 0.5f + 0.5f, 0.0f, 1.0f);
+                    glm::vec3 color = glm::mix(glm::vec3(0.25f, 0.22f, 0.2f), glm::vec3(0.3f, 0.5f, 1.0f), skyBlend);
+                    color += glm::vec3(2000.0f, 1800.0f, 1500.0f)
+                             * std::pow(std::max(glm::dot(direction, sunDirection), 0.0f), 2048.0f);
+                    const size_t index = (static_cast<size_t>(y) * static_cast<size_t>(width) + x) * 3u;
+                    image.Rgb[index] = color.r;
+                    image.Rgb[index + 1] = color.g;
+                    image.Rgb[index + 2] = color.b;
+                }
+            }
+            return image;
+        }
+
+        /// 用合成 HDR 测量各立方体分辨率下的 CPU 烘焙耗时（不上传 GPU），结果同时写日志。
+        std::vector<EnvironmentBakeTimings> BenchmarkBake(const std::vector<uint32_t> &cubemapResolutions)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            const EquirectangularImage equirectangular = CreateBenchmarkEquirectangular(2048, 1024);
+            const EnvironmentImportSettings defaultSettings;
+            std::vector<EnvironmentBakeTimings> results;
+            results.reserve(cubemapResolutions.size());
+            HIMII_CORE_INFO("Environment bake benchmark: {0} workers, SSE2 {1}", JobSystem::GetWorkerCount(),
+                            IsEnvironmentBakeSse2Enabled() ? "on" : "off");
+
+            for (uint32_t cubemapResolution : cubemapResolutions)
+            {
+                // 预滤波分辨率与默认导入设置保持同一比例（512 → 256）。
+                EnvironmentBakeTimings timings;
+                timings.CubemapResolution = cubemapResolution;
+                timings.PrefilterResolution = std::max(1u, cubemapResolution * defaultSettings.PrefilterResolution
+                                                                   / defaultSettings.CubemapResolution);
+
+                std::vector<float> environmentFaces;
+                std::vector<float> irradianceFaces;
+                std::vector<std::vector<float>> prefilterMips;
+                Timer stageTimer;
+                ConvertEquirectangularToCubemap(equirectangular, cubemapResolution, environmentFaces);
+                timings.EquirectangularToCubemapMilliseconds = stageTimer.ElapsedMillis();
+
+                const CubemapSamplingSource environment = BuildSamplingSource(environmentFaces, cubemapResolution);
+                stageTimer.Reset();
+                ComputeIrradiance(EnvironmentIrradianceMethod::SphericalHarmonics, environmentFaces, environment,
+                                  defaultSettings.IrradianceResolution, irradianceFaces);
+                timings.IrradianceSphericalHarmonicsMilliseconds = stageTimer.ElapsedMillis();
+
+                stageTimer.Reset();
+                ComputeIrradiance(EnvironmentIrradianceMethod::Convolution, environmentFaces, environment,
+                                  defaultSettings.IrradianceResolution, irradianceFaces);
+                timings.IrradianceConvolutionMilliseconds = stageTimer.ElapsedMillis();
+
+                stageTimer.Reset();
+                ConvolvePrefilter(environment, timings.PrefilterResolution, defaultSettings.PrefilterMipCount,
+                                  prefilterMips);
+                timings.PrefilterMilliseconds = stageTimer.ElapsedMillis();
+
+                HIMII_CORE_INFO("  cubemap {0} / prefilter {1}: equirect {2:.1f} ms, irradiance SH {3:.1f} ms, "
+                                "irradiance convolution {4:.1f} ms, prefilter {5:.1f} ms",
+                                timings.CubemapResolution, timings.PrefilterResolution,
+                                timings.EquirectangularToCubemapMilliseconds,
+                                timings.IrradianceSphericalHarmonicsMilliseconds,
+                                timings.IrradianceConvolutionMilliseconds, timings.PrefilterMilliseconds);
+                results.push_back(timings);
+            }
+            return results;
+        }
+
+        /// 在临时目录放一个极小和一个 512 MB 的源文件，比较 PollSourceChanges 使用的源指纹的单次查询耗时，
+        /// 并检查未改动时指纹相等、改动后指纹变化；查询耗时随文件大小增长时返回 false。
+        bool VerifySourcePolling()
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr uint64_t LargeSourceBytes = 512ull * 1024 * 1024;
+            constexpr uint32_t BatchCount = 16;
+            constexpr uint32_t QueriesPerBatch = 64;
+            constexpr std::string_view SourceHeader = "#?RADIANCE\n";
+
+            const std::filesystem::path directory =
+                    std::filesystem::temp_directory_path() / "HimiiEnvironmentPollingCheck";
+            const std::filesystem::path smallSourcePath = directory / "Small.hdr";
+            const std::filesystem::path largeSourcePath = directory / "Large.hdr";
+            std::error_code errorCode;
+            std::filesystem::create_directories(directory, errorCode);
+            {
+                std::ofstream smallFile(smallSourcePath, std::ios::binary | std::ios::trunc);
+                smallFile << SourceHeader;
+                std::ofstream largeFile(largeSourcePath, std::ios::binary | std::ios::trunc);
+                largeFile << SourceHeader;
+            }
+            // 大文件只扩展长度不写内容：查询若读取内容，耗时会随长度上升，只做 stat 时与小文件相同。
+            std::filesystem::resize_file(largeSourcePath, LargeSourceBytes, errorCode);
+            if (errorCode)
+            {
+                HIMII_CORE_ERROR("Environment polling check: cannot create {0}: {1}", largeSourcePath.string(),
+                                 errorCode.message());
+                std::filesystem::remove_all(directory, errorCode);
+                return false;
+            }
+
+            // 取各批平均的最小值，降低调度抖动的影响。
+            auto measureQueryMicroseconds = [](const std::filesystem::path &sourcePath)
+            {
+                float bestMicroseconds = std::numeric_limits<float>::max();
+                for (uint32_t batchIndex = 0; batchIndex < BatchCount; ++batchIndex)
+                {
+                    Timer timer;
+                    for (uint32_t queryIndex = 0; queryIndex < QueriesPerBatch; ++queryIndex)
+                        EnvironmentSourceFingerprint::Query(sourcePath);
+                    bestMicroseconds = std::min(bestMicroseconds, timer.ElapsedMillis() * 1000.0f / QueriesPerBatch);
+                }
+                return bestMicroseconds;
+            };
+
+            const EnvironmentSourceFingerprint smallFingerprint = EnvironmentSourceFingerprint::Query(smallSourcePath);
+            const float smallMicroseconds = measureQueryMicroseconds(smallSourcePath);
+            const bool smallChangedWithoutEdit =
+                    EnvironmentSourceFingerprint::Query(smallSourcePath) != smallFingerprint;
+
+            const EnvironmentSourceFingerprint largeFingerprint = EnvironmentSourceFingerprint::Query(largeSourcePath);
+            const float largeMicroseconds = measureQueryMicroseconds(largeSourcePath);
+            const bool largeChangedWithoutEdit =
+                    EnvironmentSourceFingerprint::Query(largeSourcePath) != largeFingerprint;
+
+            // 改写源文件后指纹必须变化，PollSourceChanges 才会把缓存标记为过期。
+            {
+                std::ofstream largeFile(largeSourcePath, std::ios::binary | std::ios::app);
+                largeFile << "changed";
+            }
+            const bool largeChangedAfterEdit =
+                    EnvironmentSourceFingerprint::Query(largeSourcePath) != largeFingerprint;
+            std::filesystem::remove_all(directory, errorCode);
+
+            HIMII_CORE_INFO("Environment polling check: {0} MB source vs {1} byte source", LargeSourceBytes >> 20,
+                            SourceHeader.size());
+            HIMII_CORE_INFO("  small source: {0:.2f} us/poll", smallMicroseconds);
+            HIMII_CORE_INFO("  large source: {0:.2f} us/poll", largeMicroseconds);
+
+            bool passed = true;
+            // stat 的耗时与文件大小无关；读一遍 512 MB 至少是几十毫秒，留出足够的抖动余量。
+            if (largeMicroseconds > smallMicroseconds * 4.0f + 50.0f)
+            {
+                HIMII_CORE_ERROR("  polling cost grows with source size");
+                passed = false;
+            }
+            if (smallChangedWithoutEdit || largeChangedWithoutEdit)
+            {
+                HIMII_CORE_ERROR("  unchanged source was reported as changed");
+                passed = false;
+            }
+            if (!largeChangedAfterEdit)
+            {
+                HIMII_CORE_ERROR("  modified source was not detected");
+                passed = false;
+            }
+            return passed;
+        }
+    }
+
+    bool RunEnvironmentBakeBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::vector<uint32_t> cubemapResolutions = ReadCountListArgument(args, argument);
+        if (cubemapResolutions.empty())
+            cubemapResolutions = {128, 256, 512, 1024};
+
+        JobSystem::Initialize();
+        const std::vector<EnvironmentBakeTimings> timings = BenchmarkBake(cubemapResolutions);
+        JobSystem::Shutdown();
+        return !timings.empty();
+    }
+
+    bool RunEnvironmentPollingCheck(ApplicationCommandLineArgs, const char *)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return VerifySourcePolling();
+    }
+}
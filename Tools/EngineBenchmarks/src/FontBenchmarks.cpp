@@ -0,0 +1,164 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/Renderer/Font.h"
+#include "Module/Render/Renderer/FontGlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 无 GL 的冷 / 热启动对比：从 U+4E00 起生成 glyphCount 个字形写入临时缓存文件，
+        /// 再整体读回并逐字形比较；同时对比 FontGlyphCache::Acquire 首次（整文件哈希）与再次（指纹命中）的耗时。
+        bool BenchmarkGlyphCache(const std::filesystem::path &fontPath, uint32_t glyphCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr char32_t FirstCodePoint = 0x4E00;
+            glyphCount = std::clamp<uint32_t>(glyphCount, 1u, 20000u);
+
+            FontSpecification specification;
+            specification.FilePath = fontPath;
+            Ref<Font> font = Font::CreateHeadless(specification);
+            if (!font)
+                return false;
+
+            FontGlyphCacheKey key;
+            key.FontFilePath = font->GetResolvedFilePath();
+            key.FaceIndex = specification.FaceIndex;
+            key.GenerationScale = specification.GenerationScale;
+            key.PixelRange = specification.PixelRange;
+            key.MiterLimit = specification.MiterLimit;
+
+            Timer acquireTimer;
+            Ref<FontGlyphCache> hashedCache = FontGlyphCache::Acquire(key);
+            const float hashedAcquireMilliseconds = acquireTimer.ElapsedMillis();
+            acquireTimer.Reset();
+            Ref<FontGlyphCache> registryCache = FontGlyphCache::Acquire(key);
+            const float registryAcquireMilliseconds = acquireTimer.ElapsedMillis();
+
+            HIMII_CORE_INFO("Glyph cache benchmark: {0}, {1} glyphs from U+{2:04X}, {3} workers", fontPath.string(),
+                            glyphCount, static_cast<uint32_t>(FirstCodePoint), JobSystem::GetWorkerCount());
+            HIMII_CORE_INFO("  {0:<24} {1:.3f} ms", "acquire (content hash):", hashedAcquireMilliseconds);
+            HIMII_CORE_INFO("  {0:<24} {1:.3f} ms", "acquire (fingerprint):", registryAcquireMilliseconds);
+
+            // 冷启动：与 PreloadTextAsync 相同的批大小分散到工作线程生成。
+            std::vector<FontGlyphCacheRecord> generatedRecords(glyphCount);
+            std::vector<std::vector<uint8_t>> generatedPixels(glyphCount);
+            std::vector<uint8_t> persistable(glyphCount, 0);
+            Timer generationTimer;
+            JobSystem::ParallelFor(glyphCount, Font::GlyphGenerationBatchSize,
+                                   [&](uint32_t beginIndex, uint32_t endIndex)
+                                   {
+                                       for (uint32_t glyphIndex = beginIndex; glyphIndex < endIndex; ++glyphIndex)
+                                           persistable[glyphIndex] = font->GenerateGlyphRecord(
+                                                   FirstCodePoint + glyphIndex, generatedRecords[glyphIndex],
+                                                   generatedPixels[glyphIndex]);
+                                   });
+            const float generationMilliseconds = generationTimer.ElapsedMillis();
+
+            // 写入临时文件而不是项目缓存，基准不影响编辑器下次的热启动。
+            const std::filesystem::path temporaryCachePath =
+                    std::filesystem::temp_directory_path() / "HimiiGlyphCacheBenchmark.hglyph";
+            std::error_code errorCode;
+            std::filesystem::remove(temporaryCachePath, errorCode);
+
+            std::unordered_map<char32_t, uint32_t> persistedGlyphIndices;
+            Timer appendTimer;
+            {
+                FontGlyphCache writer(temporaryCachePath, 0, key);
+                std::vector<uint8_t> fileData;
+                std::vector<FontGlyphCacheRecord> records;
+                writer.Load(fileData, records);
+                for (uint32_t glyphIndex = 0; glyphIndex < glyphCount; ++glyphIndex)
+                {
+                    if (!persistable[glyphIndex])
+                        continue;
+                    writer.Append(generatedRecords[glyphIndex]);
+                    persistedGlyphIndices[generatedRecords[glyphIndex].CodePoint] = glyphIndex;
+                }
+            }
+            const float appendMilliseconds = appendTimer.ElapsedMillis();
+
+            // 热启动：新对象整体读入一次并解析全部记录。
+            std::vector<uint8_t> fileData;
+            std::vector<FontGlyphCacheRecord> records;
+            Timer loadTimer;
+            {
+                FontGlyphCache reader(temporaryCachePath, 0, key);
+                reader.Load(fileData, records);
+            }
+            const float loadMilliseconds = loadTimer.ElapsedMillis();
+            const uint64_t cacheBytes = fileData.size();
+            std::filesystem::remove(temporaryCachePath, errorCode);
+
+            uint32_t mismatchCount = records.size() == persistedGlyphIndices.size() ? 0u : 1u;
+            for (const FontGlyphCacheRecord &record : records)
+            {
+                const auto found = persistedGlyphIndices.find(record.CodePoint);
+                if (found == persistedGlyphIndices.end())
+                {
+                    ++mismatchCount;
+                    continue;
+                }
+                const FontGlyphCacheRecord &generatedRecord = generatedRecords[found->second];
+                const std::vector<uint8_t> &pixels = generatedPixels[found->second];
+                const size_t pixelBytes = static_cast<size_t>(record.BitmapWidth) * record.BitmapHeight * 3u;
+                const bool bitmapMatches =
+                        pixelBytes == 0
+                                ? pixels.empty() || generatedRecord.IsWhitespace || generatedRecord.IsMissing
+                                : pixelBytes == pixels.size()
+                                          && std::memcmp(record.BitmapPixels, pixels.data(), pixelBytes) == 0;
+                if (!bitmapMatches || record.Advance != generatedRecord.Advance
+                    || record.IsMissing != generatedRecord.IsMissing)
+                    ++mismatchCount;
+            }
+
+            auto perGlyphMicroseconds = [glyphCount](float milliseconds)
+            { return static_cast<double>(milliseconds) * 1000.0 / glyphCount; };
+            HIMII_CORE_INFO("  {0:<24} {1:.1f} ms ({2:.1f} us/glyph)", "cold generate:", generationMilliseconds,
+                            perGlyphMicroseconds(generationMilliseconds));
+            HIMII_CORE_INFO("  {0:<24} {1:.1f} ms", "cold append:", appendMilliseconds);
+            HIMII_CORE_INFO("  {0:<24} {1:.1f} ms ({2:.2f} us/glyph), {3:.1f} MB, {4:.0f}x faster", "warm load:",
+                            loadMilliseconds, perGlyphMicroseconds(loadMilliseconds), cacheBytes / (1024.0 * 1024.0),
+                            generationMilliseconds / std::max(loadMilliseconds, 1.0e-3f));
+
+            bool passed = true;
+            if (!hashedCache || hashedCache != registryCache)
+            {
+                HIMII_CORE_ERROR("  repeated Acquire did not return the registered cache");
+                passed = false;
+            }
+            if (mismatchCount != 0)
+            {
+                HIMII_CORE_ERROR("  {0} cached glyph(s) differ from the generated ones", mismatchCount);
+                passed = false;
+            }
+            return passed;
+        }
+    }
+
+    bool RunGlyphCacheBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::filesystem::path fontPath;
+        if (!ReadPathArgument(args, argument, fontPath))
+        {
+            HIMII_CORE_ERROR("{0} requires a font file path", argument);
+            return false;
+        }
+
+        JobSystem::Initialize();
+        const bool succeeded = BenchmarkGlyphCache(fontPath, ReadCountArgument(args, argument, 3000, 2));
+        JobSystem::Shutdown();
+        return succeeded;
+    }
+}
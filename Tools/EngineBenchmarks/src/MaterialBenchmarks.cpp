@@ -0,0 +1,149 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/Mesh/CompiledMaterial.h"
+#include "Module/Render/Mesh/MaterialAsset.h"
+#include "Module/Render/Mesh/MaterialAssetSerializer.h"
+#include "Module/Render/Shader/BuiltinShaderRegistry.h"
+#include "Project/Project.h"
+#include "Project/ProjectSerializer.h"
+#include "Resource/AssetManager.h"
+#include "Resource/AssetSerializerRegistry.h"
+
+#include <algorithm>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 在临时目录建一个只含材质的工程：材质写成 .hmaterial 并经 ImportAsset 登记，由 GetAsset 正常反序列化。
+        Ref<AssetManager> CreateMaterialBenchmarkProject(const std::filesystem::path &projectDirectory,
+                                                         uint32_t materialCount,
+                                                         std::vector<AssetHandle> &outMaterialHandles)
+        {
+            std::error_code errorCode;
+            std::filesystem::remove_all(projectDirectory, errorCode);
+            std::filesystem::create_directories(projectDirectory / "assets" / "materials", errorCode);
+            if (errorCode)
+            {
+                HIMII_CORE_ERROR("Material resolve benchmark: cannot create {0}: {1}", projectDirectory.string(),
+                                 errorCode.message());
+                return nullptr;
+            }
+
+            const std::filesystem::path projectFilePath = projectDirectory / "MaterialResolveBenchmark.hproj";
+            if (!ProjectSerializer(CreateRef<Project>()).Serialize(projectFilePath) || !Project::Load(projectFilePath))
+            {
+                HIMII_CORE_ERROR("Material resolve benchmark: cannot load project {0}", projectFilePath.string());
+                return nullptr;
+            }
+
+            RegisterBuiltinAssetSerializers();
+            Ref<AssetManager> assetManager = Project::GetAssetManager();
+            outMaterialHandles.clear();
+            outMaterialHandles.reserve(materialCount);
+            for (uint32_t materialIndex = 0; materialIndex < materialCount; ++materialIndex)
+            {
+                const std::filesystem::path relativePath =
+                        std::filesystem::path("materials") / ("material_" + std::to_string(materialIndex) + ".hmaterial");
+                MaterialAssetSerializer::Serialize(
+                        Project::GetAssetFileSystemPath(relativePath),
+                        MaterialAssetSerializer::CreateDefaultMaterialInstance(BuiltinShaderHandles::MeshLit));
+                outMaterialHandles.push_back(assetManager->ImportAsset(relativePath));
+            }
+            return assetManager;
+        }
+
+        /// 无 GL：对比每次绘制经 GetAsset 取材质与经 CompiledMaterialSlot 复用的耗时，并检查卸载后旧 slot 失效。
+        bool BenchmarkMaterialResolve(uint32_t drawCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr uint32_t MaterialCount = 256;
+            drawCount = std::clamp<uint32_t>(drawCount, MaterialCount, 1u << 24);
+
+            const std::filesystem::path projectDirectory =
+                    std::filesystem::temp_directory_path() / "HimiiMaterialResolveBenchmark";
+            std::vector<AssetHandle> materialHandles;
+            Ref<AssetManager> assetManagerReference =
+                    CreateMaterialBenchmarkProject(projectDirectory, MaterialCount, materialHandles);
+            if (!assetManagerReference)
+                return false;
+            AssetManager &assetManager = *assetManagerReference;
+
+            // 预先填好与材质版本、代次一致的编译结果，两条路径都不会触发 GL 编译。
+            for (AssetHandle materialHandle : materialHandles)
+            {
+                Ref<Asset> materialBase = assetManager.GetAsset(materialHandle);
+                if (!materialBase || materialBase->GetType() != AssetType::Material)
+                {
+                    HIMII_CORE_ERROR("Material resolve benchmark: material {0} failed to load", materialHandle);
+                    return false;
+                }
+                auto &materialAsset = static_cast<MaterialAsset &>(*materialBase);
+                materialAsset.Compiled = CreateRef<CompiledMaterial>();
+                materialAsset.Compiled->MaterialVersion = materialAsset.GetParameterVersion();
+                materialAsset.Compiled->ShaderHandle = materialAsset.ShaderHandle;
+                materialAsset.Compiled->AssetGeneration = assetManager.GetAssetGeneration();
+            }
+
+            HIMII_CORE_INFO("Material resolve benchmark: {0} draws over {1} materials", drawCount, MaterialCount);
+
+            bool recompiled = false;
+            uint32_t recompileCount = 0;
+            std::vector<const CompiledMaterial *> lookupResults(drawCount);
+            Timer lookupTimer;
+            for (uint32_t drawIndex = 0; drawIndex < drawCount; ++drawIndex)
+            {
+                Ref<Asset> materialBase = assetManager.GetAsset(materialHandles[drawIndex % MaterialCount]);
+                lookupResults[drawIndex] =
+                        &GetOrCompileMaterial(&assetManager, static_cast<MaterialAsset &>(*materialBase), &recompiled);
+                recompileCount += recompiled ? 1 : 0;
+            }
+            const float lookupMilliseconds = lookupTimer.ElapsedMillis();
+
+            std::vector<CompiledMaterialSlot> slots(MaterialCount);
+            bool consistent = true;
+            Timer slotTimer;
+            for (uint32_t drawIndex = 0; drawIndex < drawCount; ++drawIndex)
+            {
+                const uint32_t materialIndex = drawIndex % MaterialCount;
+                const CompiledMaterial *compiledMaterial = ResolveCompiledMaterial(
+                        &assetManager, materialHandles[materialIndex], slots[materialIndex], &recompiled);
+                consistent = consistent && compiledMaterial == lookupResults[drawIndex];
+                recompileCount += recompiled ? 1 : 0;
+            }
+            const float slotMilliseconds = slotTimer.ElapsedMillis();
+
+            HIMII_CORE_INFO("  {0:<22} {1:.3f} ms, {2:.1f} ns/draw", "GetAsset per draw:", lookupMilliseconds,
+                            lookupMilliseconds * 1.0e6 / drawCount);
+            HIMII_CORE_INFO("  {0:<22} {1:.3f} ms, {2:.1f} ns/draw", "slot cached:", slotMilliseconds,
+                            slotMilliseconds * 1.0e6 / drawCount);
+
+            // 卸载后代次变化，旧 slot 必须重新查找，而不是继续返回已卸载材质的结果。
+            assetManager.UnloadAsset(materialHandles[0]);
+            const bool unloadInvalidated =
+                    ResolveCompiledMaterial(&assetManager, materialHandles[0], slots[0]) == nullptr;
+
+            if (!consistent || recompileCount != 0 || !unloadInvalidated)
+            {
+                HIMII_CORE_ERROR("Material resolve benchmark: {0}{1}{2}", consistent ? "" : "slot results differ; ",
+                                 recompileCount != 0 ? "unexpected recompiles; " : "",
+                                 unloadInvalidated ? "" : "slot survived unload");
+                return false;
+            }
+
+            std::error_code errorCode;
+            std::filesystem::remove_all(projectDirectory, errorCode);
+            return true;
+        }
+    }
+
+    bool RunMaterialResolveBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return BenchmarkMaterialResolve(ReadCountArgument(args, argument, 100000));
+    }
+}
@@ -0,0 +1,224 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/Mesh/MeshSourceGeometryLoader.h"
+#include "Module/Render/Mesh/MeshletCulling.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace Himii
+{
+    namespace
+    {
+        template<typename T>
+        bool HaveIdenticalBytes(const std::vector<T> &first, const std::vector<T> &second)
+        {
+            return first.size() == second.size()
+                   && (first.empty() || std::memcmp(first.data(), second.data(), first.size() * sizeof(T)) == 0);
+        }
+
+        /// 对合成的球面簇集合分别测串行 / 并行剔除的吞吐与剔除比例，并检查两者结果一致。
+        bool BenchmarkMeshletCulling(uint32_t meshletCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr uint32_t IterationCount = 64;
+            constexpr uint32_t TrianglesPerMeshlet = 124;
+            constexpr float SphereRadius = 50.0f;
+
+            meshletCount = std::clamp<uint32_t>(meshletCount, 1u, 1u << 22);
+
+            // 球面上均匀分布的簇，法线锥朝外：相机在球外看向球心时约一半背向、一部分出视锥，接近真实的大网格。
+            std::vector<MeshMeshlet> meshlets(meshletCount);
+            std::mt19937 random(1234u);
+            std::uniform_real_distribution<float> unitDistribution(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> cutoffDistribution(0.2f, 0.9f);
+            const float clusterRadius = SphereRadius * 2.0f / std::sqrt(static_cast<float>(meshletCount));
+            for (uint32_t meshletIndex = 0; meshletIndex < meshletCount; ++meshletIndex)
+            {
+                glm::vec3 direction(unitDistribution(random), unitDistribution(random), unitDistribution(random));
+                const float directionLength = glm::length(direction);
+                direction = directionLength > 1.0e-4f ? direction / directionLength : glm::vec3(0.0f, 0.0f, 1.0f);
+
+                MeshMeshlet &meshlet = meshlets[meshletIndex];
+                meshlet.BoundsCenter = direction * SphereRadius;
+                meshlet.BoundsRadius = clusterRadius;
+                meshlet.ConeAxis = -direction;
+                meshlet.ConeCutoff = cutoffDistribution(random);
+                meshlet.ConeApex = meshlet.BoundsCenter - direction * clusterRadius;
+                meshlet.IndexStart = meshletIndex * TrianglesPerMeshlet * 3u;
+                meshlet.IndexCount = TrianglesPerMeshlet * 3u;
+            }
+
+            const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+            const glm::vec3 cameraPosition(0.0f, 20.0f, 120.0f);
+            const glm::mat4 viewProjection =
+                    projection * glm::lookAt(cameraPosition, glm::vec3(30.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            const glm::mat4 objectTransform(1.0f);
+
+            HIMII_CORE_INFO("Meshlet culling benchmark: {0} clusters, {1} triangles, {2} iterations", meshletCount,
+                            static_cast<uint64_t>(meshletCount) * TrianglesPerMeshlet, IterationCount);
+
+            MeshletDrawRanges drawRanges;
+            uint32_t referenceVisibleCount = std::numeric_limits<uint32_t>::max();
+            bool consistent = true;
+            auto measure = [&](const char *label, bool enableConeCulling, uint32_t parallelThreshold)
+            {
+                const MeshletCullingView view =
+                        BuildMeshletCullingView(viewProjection, objectTransform, cameraPosition, enableConeCulling);
+                CullMeshlets(meshlets.data(), meshletCount, 0, view, drawRanges, parallelThreshold);
+
+                Timer timer;
+                for (uint32_t iteration = 0; iteration < IterationCount; ++iteration)
+                    CullMeshlets(meshlets.data(), meshletCount, 0, view, drawRanges, parallelThreshold);
+                const float milliseconds = timer.ElapsedMillis() / IterationCount;
+
+                const double culledFraction =
+                        1.0 - static_cast<double>(drawRanges.VisibleMeshletCount) / static_cast<double>(meshletCount);
+                HIMII_CORE_INFO("  {0:<22} {1:.4f} ms, {2:.0f} clusters/ms, {3:.1f}% culled, {4} draw ranges", label,
+                                milliseconds, meshletCount / std::max(milliseconds, 1.0e-6f), culledFraction * 100.0,
+                                drawRanges.FirstIndices.size());
+                return drawRanges.VisibleMeshletCount;
+            };
+
+            measure("frustum only:", false, std::numeric_limits<uint32_t>::max());
+            referenceVisibleCount = measure("frustum + cone:", true, std::numeric_limits<uint32_t>::max());
+            if (JobSystem::GetWorkerCount() > 0)
+            {
+                // 并行剔除的可见集合必须与串行一致，只有耗时不同。
+                const uint32_t parallelVisibleCount = measure("frustum + cone (jobs):", true, 0u);
+                consistent = parallelVisibleCount == referenceVisibleCount;
+            }
+
+            // 非均匀缩放下锥测试不再可靠，应自动退化为只做视锥剔除。
+            const MeshletCullingView stretchedView = BuildMeshletCullingView(
+                    viewProjection, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 3.0f, 1.0f)), cameraPosition, true);
+            if (stretchedView.EnableConeCulling)
+            {
+                HIMII_CORE_ERROR("  non-uniform scale kept cone culling enabled");
+                consistent = false;
+            }
+
+            // 正交相机沿 -Z 看，视野边缘一个法线锥略朝外、仍有面朝向相机的簇不能被剔除；
+            // 以相机位置为视点的测试会把它误剔。正背对相机的簇照常剔除。
+            const glm::vec3 orthographicCameraPosition(0.0f, 0.0f, 10.0f);
+            const glm::mat4 orthographicViewProjection =
+                    glm::ortho(-50.0f, 50.0f, -28.0f, 28.0f, 0.1f, 100.0f)
+                    * glm::lookAt(orthographicCameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            const MeshletCullingView orthographicView = BuildMeshletCullingView(
+                    orthographicViewProjection, objectTransform, orthographicCameraPosition, true);
+            MeshMeshlet edgeMeshlet;
+            edgeMeshlet.BoundsCenter = glm::vec3(45.0f, 0.0f, 0.0f);
+            edgeMeshlet.BoundsRadius = 1.0f;
+            edgeMeshlet.ConeApex = edgeMeshlet.BoundsCenter;
+            edgeMeshlet.ConeAxis = glm::normalize(glm::vec3(1.0f, 0.0f, -0.3f));
+            edgeMeshlet.ConeCutoff = 0.5f;
+            MeshMeshlet backFacingMeshlet = edgeMeshlet;
+            backFacingMeshlet.ConeAxis = glm::vec3(0.0f, 0.0f, -1.0f);
+            const bool orthographicCorrect = orthographicView.Orthographic && orthographicView.EnableConeCulling
+                                             && IsMeshletVisible(edgeMeshlet, orthographicView)
+                                             && !IsMeshletVisible(backFacingMeshlet, orthographicView);
+            HIMII_CORE_INFO("  orthographic cone test: {0}", orthographicCorrect ? "ok" : "FAILED");
+            consistent = consistent && orthographicCorrect;
+
+            if (!consistent)
+                HIMII_CORE_ERROR("Meshlet culling benchmark: results differ between configurations");
+            return consistent;
+        }
+
+        /// 同一源文件先在调用线程串行解码，再经 JobSystem 并行解码，比较耗时并检查两者几何逐字节一致。
+        /// 调用前 JobSystem 须未初始化；函数内部负责初始化与关闭。
+        bool BenchmarkMeshSourceDecode(const std::filesystem::path &absoluteSourcePath, uint32_t iterationCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            iterationCount = std::max(iterationCount, 1u);
+            const StaticMeshImportSettings importSettings;
+            if (JobSystem::IsInitialized())
+                JobSystem::Shutdown();
+
+            // 两轮都包含切线生成与 meshlet 构建，与编辑器导入的工作量一致；首轮额外做一次预热读盘。
+            auto measure = [&](MeshAsset &outMeshAsset, float &outMilliseconds)
+            {
+                if (!LoadMeshGeometryFromSource(absoluteSourcePath, importSettings, outMeshAsset))
+                    return false;
+                Timer timer;
+                for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    if (!LoadMeshGeometryFromSource(absoluteSourcePath, importSettings, outMeshAsset))
+                        return false;
+                }
+                outMilliseconds = timer.ElapsedMillis() / static_cast<float>(iterationCount);
+                return true;
+            };
+
+            MeshAsset serialMesh;
+            float serialMilliseconds = 0.0f;
+            if (!measure(serialMesh, serialMilliseconds))
+            {
+                HIMII_CORE_ERROR("Mesh decode benchmark: failed to load {0}", absoluteSourcePath.string());
+                return false;
+            }
+
+            JobSystem::Initialize();
+            const uint32_t workerCount = JobSystem::GetWorkerCount();
+            MeshAsset parallelMesh;
+            float parallelMilliseconds = 0.0f;
+            const bool parallelLoaded = measure(parallelMesh, parallelMilliseconds);
+            JobSystem::Shutdown();
+            if (!parallelLoaded)
+            {
+                HIMII_CORE_ERROR("Mesh decode benchmark: parallel load failed for {0}", absoluteSourcePath.string());
+                return false;
+            }
+
+            HIMII_CORE_INFO("Mesh decode benchmark: {0} ({1} vertices, {2} indices, {3} submeshes, {4} iterations)",
+                            absoluteSourcePath.filename().string(), serialMesh.Vertices.size(), serialMesh.Indices.size(),
+                            serialMesh.Submeshes.size(), iterationCount);
+            HIMII_CORE_INFO("  serial:              {0:.2f} ms", serialMilliseconds);
+            HIMII_CORE_INFO("  JobSystem ({0} workers): {1:.2f} ms ({2:.2f}x)", workerCount, parallelMilliseconds,
+                            serialMilliseconds / std::max(parallelMilliseconds, 1.0e-3f));
+
+            // 原始体按源顺序合并，并行解码不得改变输出。
+            const bool identical = HaveIdenticalBytes(serialMesh.Vertices, parallelMesh.Vertices)
+                                   && HaveIdenticalBytes(serialMesh.Indices, parallelMesh.Indices)
+                                   && HaveIdenticalBytes(serialMesh.Meshlets, parallelMesh.Meshlets)
+                                   && serialMesh.Submeshes.size() == parallelMesh.Submeshes.size();
+            if (!identical)
+                HIMII_CORE_ERROR("  serial and parallel decode produced different geometry");
+            return identical;
+        }
+    }
+
+    bool RunMeshletCullingBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        const uint32_t meshletCount = ReadCountArgument(args, argument, 65536);
+        JobSystem::Initialize();
+        const bool succeeded = BenchmarkMeshletCulling(meshletCount);
+        JobSystem::Shutdown();
+        return succeeded;
+    }
+
+    bool RunMeshImportBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        std::filesystem::path sourcePath;
+        if (!ReadPathArgument(args, argument, sourcePath))
+        {
+            HIMII_CORE_ERROR("{0} requires a glTF or FBX file path", argument);
+            return false;
+        }
+        return BenchmarkMeshSourceDecode(sourcePath, ReadCountArgument(args, argument, 5, 2));
+    }
+}
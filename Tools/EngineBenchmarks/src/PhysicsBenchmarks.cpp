@@ -0,0 +1,355 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/FixedTimestep.h"
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Physics/Physics2DWorld.h"
+#include "World/Scene/Components.h"
+#include "World/Scene/Entity.h"
+#include "World/Scene/SceneInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 地面加一摞略微错开的箱子与几个圆，碰撞与堆叠足以放大任何步长差异。
+        void BuildDeterminismTestScene(Scene &scene)
+        {
+            Entity groundEntity = scene.CreateEntity("Ground");
+            groundEntity.GetComponent<TransformComponent>().Scale = {40.0f, 1.0f, 1.0f};
+            groundEntity.AddComponent<Rigidbody2DComponent>();
+            groundEntity.AddComponent<BoxCollider2DComponent>();
+
+            for (int boxIndex = 0; boxIndex < 24; ++boxIndex)
+            {
+                Entity boxEntity = scene.CreateEntity("Box");
+                auto &transform = boxEntity.GetComponent<TransformComponent>();
+                transform.Position = {static_cast<float>(boxIndex % 3) * 0.11f - 0.1f,
+                                      1.0f + static_cast<float>(boxIndex) * 1.05f, 0.0f};
+                transform.Rotation.z = static_cast<float>(boxIndex % 5) * 0.02f;
+                boxEntity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                boxEntity.AddComponent<BoxCollider2DComponent>();
+            }
+
+            for (int circleIndex = 0; circleIndex < 8; ++circleIndex)
+            {
+                Entity circleEntity = scene.CreateEntity("Circle");
+                circleEntity.GetComponent<TransformComponent>().Position = {
+                        -6.0f + static_cast<float>(circleIndex) * 0.3f, 3.0f + static_cast<float>(circleIndex) * 1.5f,
+                        0.0f};
+                circleEntity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                circleEntity.AddComponent<CircleCollider2DComponent>().Restitution = 0.4f;
+            }
+        }
+
+        Entity CreateStaticBox(Scene &scene, const glm::vec2 &position, const glm::vec2 &scale)
+        {
+            Entity boxEntity = scene.CreateEntity("Static");
+            auto &transform = boxEntity.GetComponent<TransformComponent>();
+            transform.Position = {position.x, position.y, 0.0f};
+            transform.Scale = {scale.x, scale.y, 1.0f};
+            boxEntity.AddComponent<Rigidbody2DComponent>();
+            boxEntity.AddComponent<BoxCollider2DComponent>();
+            return boxEntity;
+        }
+
+        /// 金字塔堆叠：接触多、岛大，主要压求解器。
+        void BuildStackedBoxBenchmarkScene(Scene &scene, uint32_t bodyCount)
+        {
+            CreateStaticBox(scene, {0.0f, -0.5f}, {400.0f, 1.0f});
+
+            const uint32_t baseCount = std::max(
+                    1u, static_cast<uint32_t>((std::sqrt(8.0 * static_cast<double>(bodyCount) + 1.0) - 1.0) * 0.5));
+            for (uint32_t rowIndex = 0; rowIndex < baseCount; ++rowIndex)
+            {
+                const uint32_t rowCount = baseCount - rowIndex;
+                for (uint32_t columnIndex = 0; columnIndex < rowCount; ++columnIndex)
+                {
+                    Entity boxEntity = scene.CreateEntity("Box");
+                    boxEntity.GetComponent<TransformComponent>().Position = {
+                            (static_cast<float>(columnIndex) - static_cast<float>(rowCount) * 0.5f) * 1.0f + 0.5f,
+                            0.5f + static_cast<float>(rowIndex), 0.0f};
+                    boxEntity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                    boxEntity.AddComponent<BoxCollider2DComponent>();
+                }
+            }
+        }
+
+        /// 大量箱子与圆散落进一个容器：岛多而小，主要压宽相与碰撞阶段。
+        void BuildManyBodyBenchmarkScene(Scene &scene, uint32_t bodyCount)
+        {
+            const uint32_t columnCount = std::max(1u, static_cast<uint32_t>(std::sqrt(static_cast<double>(bodyCount))));
+            const float halfWidth = static_cast<float>(columnCount) * 0.9f;
+            CreateStaticBox(scene, {0.0f, -0.5f}, {halfWidth * 2.0f + 2.0f, 1.0f});
+            CreateStaticBox(scene, {-halfWidth - 0.5f, 50.0f}, {1.0f, 100.0f});
+            CreateStaticBox(scene, {halfWidth + 0.5f, 50.0f}, {1.0f, 100.0f});
+
+            for (uint32_t bodyIndex = 0; bodyIndex < bodyCount; ++bodyIndex)
+            {
+                const uint32_t columnIndex = bodyIndex % columnCount;
+                const uint32_t rowIndex = bodyIndex / columnCount;
+                Entity bodyEntity = scene.CreateEntity("Body");
+                auto &transform = bodyEntity.GetComponent<TransformComponent>();
+                transform.Position = {-halfWidth + 0.9f + static_cast<float>(columnIndex) * 1.8f +
+                                              static_cast<float>(rowIndex % 2) * 0.3f,
+                                      2.0f + static_cast<float>(rowIndex) * 1.6f, 0.0f};
+                transform.Scale = {0.6f, 0.6f, 1.0f};
+                bodyEntity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                if (bodyIndex % 2 == 0)
+                    bodyEntity.AddComponent<BoxCollider2DComponent>();
+                else
+                    bodyEntity.AddComponent<CircleCollider2DComponent>();
+            }
+        }
+
+        /// 一排互不接触、静置在地面上的箱子，预热后几乎全部睡眠，只有少数箱子持续被推动。
+        void BuildRestingBodyBenchmarkScene(Scene &scene, uint32_t bodyCount)
+        {
+            const float rowWidth = static_cast<float>(bodyCount) * 2.0f;
+            CreateStaticBox(scene, {rowWidth * 0.5f, -0.5f}, {rowWidth + 2.0f, 1.0f});
+
+            for (uint32_t bodyIndex = 0; bodyIndex < bodyCount; ++bodyIndex)
+            {
+                Entity bodyEntity = scene.CreateEntity("Body");
+                bodyEntity.GetComponent<TransformComponent>().Position = {
+                        static_cast<float>(bodyIndex) * 2.0f + 1.0f, 0.5f, 0.0f};
+                bodyEntity.AddComponent<Rigidbody2DComponent>().Type =
+                        bodyIndex % 100 == 0 ? Rigidbody2DComponent::BodyType::Kinematic
+                                             : Rigidbody2DComponent::BodyType::Dynamic;
+                bodyEntity.AddComponent<BoxCollider2DComponent>();
+            }
+        }
+
+        /// 静置场景里让每 100 个中的一个运动学刚体持续转动，保持少量活跃刚体。
+        void KeepRestingBenchmarkBodiesAwake(Scene &scene)
+        {
+            auto view = scene.Registry().view<Rigidbody2DComponent>();
+            for (auto entityHandle : view)
+            {
+                const auto &rigidbody2D = view.get<Rigidbody2DComponent>(entityHandle);
+                if (rigidbody2D.Type != Rigidbody2DComponent::BodyType::Kinematic)
+                    continue;
+                const b2BodyId bodyId = SceneInternal::PointerToBodyId(rigidbody2D.RuntimeBody);
+                if (b2Body_IsValid(bodyId))
+                    b2Body_SetAngularVelocity(bodyId, 1.0f);
+            }
+        }
+
+        std::vector<float> CaptureBodyStates(Scene &scene)
+        {
+            std::vector<float> states;
+            auto view = scene.Registry().view<Rigidbody2DComponent>();
+            for (auto entityHandle : view)
+            {
+                const b2BodyId bodyId = SceneInternal::PointerToBodyId(view.get<Rigidbody2DComponent>(entityHandle).RuntimeBody);
+                if (!b2Body_IsValid(bodyId))
+                    continue;
+
+                const b2Vec2 position = b2Body_GetPosition(bodyId);
+                const b2Rot rotation = b2Body_GetRotation(bodyId);
+                const b2Vec2 linearVelocity = b2Body_GetLinearVelocity(bodyId);
+                states.insert(states.end(), {position.x, position.y, rotation.c, rotation.s, linearVelocity.x,
+                                             linearVelocity.y, b2Body_GetAngularVelocity(bodyId)});
+            }
+            return states;
+        }
+
+        float MaxStateDeviation(const std::vector<float> &left, const std::vector<float> &right)
+        {
+            if (left.size() != right.size())
+                return std::numeric_limits<float>::infinity();
+
+            float deviation = 0.0f;
+            for (size_t index = 0; index < left.size(); ++index)
+                deviation = std::max(deviation, std::abs(left[index] - right[index]));
+            return deviation;
+        }
+
+        /// 用同一个合成场景按 30/60/144/240 Hz 与抖动帧时间各跑相同固定步数，比较最终刚体状态是否逐位一致。
+        bool VerifyFixedTimestepDeterminism()
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr double FixedTimestep = 1.0 / 60.0;
+            constexpr uint32_t MaxSubstepsPerFrame = 8;
+            constexpr uint32_t TargetStepCount = 600;
+
+            struct FrameRateCase
+            {
+                const char *Name;
+                std::vector<double> FrameSeconds;
+            };
+
+            // 抖动序列含一次 250ms 卡顿，用于验证单帧步数上限丢弃积压后步序列仍然一致。
+            std::vector<double> jitteredFrameSeconds;
+            uint32_t randomState = 0x2545F491u;
+            for (int frameIndex = 0; frameIndex < 64; ++frameIndex)
+            {
+                randomState = randomState * 1664525u + 1013904223u;
+                jitteredFrameSeconds.push_back(0.004 + static_cast<double>(randomState >> 8) / 16777216.0 * 0.046);
+            }
+            jitteredFrameSeconds[17] = 0.25;
+
+            const std::vector<FrameRateCase> frameRateCases = {
+                    {"60 Hz", {1.0 / 60.0}},
+                    {"30 Hz", {1.0 / 30.0}},
+                    {"144 Hz", {1.0 / 144.0}},
+                    {"240 Hz", {1.0 / 240.0}},
+                    {"jittered", jitteredFrameSeconds},
+            };
+
+            std::vector<float> referenceStates;
+            bool allIdentical = true;
+            for (const FrameRateCase &frameRateCase : frameRateCases)
+            {
+                for (const bool useFixedTimestep : {true, false})
+                {
+                    Scene scene;
+                    BuildDeterminismTestScene(scene);
+                    Physics2DWorld physics2DWorld(&scene);
+                    physics2DWorld.Start();
+
+                    FixedTimestepAccumulator accumulator(FixedTimestep, MaxSubstepsPerFrame);
+                    uint32_t frameCount = 0;
+                    uint32_t stepCount = 0;
+                    double simulatedSeconds = 0.0;
+                    const double targetSeconds = FixedTimestep * TargetStepCount;
+                    while (useFixedTimestep ? stepCount < TargetStepCount : simulatedSeconds < targetSeconds)
+                    {
+                        const double frameSeconds = frameRateCase.FrameSeconds[frameCount % frameRateCase.FrameSeconds.size()];
+                        ++frameCount;
+
+                        if (!useFixedTimestep)
+                        {
+                            // 旧行为：每个渲染帧用原始帧时间推进一次，作为对照。
+                            physics2DWorld.Step(static_cast<float>(frameSeconds));
+                            simulatedSeconds += frameSeconds;
+                            continue;
+                        }
+
+                        const uint32_t frameStepCount =
+                                std::min(accumulator.Advance(frameSeconds), TargetStepCount - stepCount);
+                        for (uint32_t stepIndex = 0; stepIndex < frameStepCount; ++stepIndex)
+                            physics2DWorld.Step(accumulator.GetStepSeconds());
+                        stepCount += frameStepCount;
+                        physics2DWorld.ApplyInterpolatedTransforms(accumulator.GetInterpolationAlpha());
+                    }
+
+                    const std::vector<float> states = CaptureBodyStates(scene);
+                    if (referenceStates.empty())
+                        referenceStates = states;
+
+                    const float deviation = MaxStateDeviation(states, referenceStates);
+                    if (!useFixedTimestep)
+                    {
+                        HIMII_CORE_INFO("Physics determinism: {0:<8} per-frame step, {1} frames, max deviation {2}",
+                                        frameRateCase.Name, frameCount, deviation);
+                        continue;
+                    }
+
+                    const bool identical = states.size() == referenceStates.size() &&
+                                           std::memcmp(states.data(), referenceStates.data(),
+                                                       states.size() * sizeof(float)) == 0;
+                    allIdentical = allIdentical && identical;
+                    if (identical)
+                        HIMII_CORE_INFO("Physics determinism: {0:<8} fixed step, {1} frames / {2} steps, identical",
+                                        frameRateCase.Name, frameCount, stepCount);
+                    else
+                        HIMII_CORE_ERROR("Physics determinism: {0:<8} fixed step, {1} frames / {2} steps, max deviation {3}",
+                                         frameRateCase.Name, frameCount, stepCount, deviation);
+                }
+            }
+
+            return allIdentical;
+        }
+
+        /// 堆叠箱子、大量散落刚体与大多睡眠的静置刚体三个场景，按不同求解线程数测量平均单步耗时。
+        bool BenchmarkStep(uint32_t bodyCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr uint32_t WarmupStepCount = 90;
+            constexpr uint32_t MeasuredStepCount = 240;
+            constexpr float FixedTimestep = 1.0f / 60.0f;
+            bodyCount = std::max(bodyCount, 1u);
+
+            std::vector<uint32_t> workerCounts;
+            const uint32_t maxWorkerCount = Physics2DTaskScheduler::ResolveWorkerCount(0);
+            for (uint32_t workerCount = 1; workerCount < maxWorkerCount; workerCount *= 2)
+                workerCounts.push_back(workerCount);
+            workerCounts.push_back(maxWorkerCount);
+
+            HIMII_CORE_INFO("Physics step benchmark: {0} bodies, {1} warm-up + {2} measured steps, up to {3} workers",
+                            bodyCount, WarmupStepCount, MeasuredStepCount, maxWorkerCount);
+
+            struct BenchmarkScene
+            {
+                const char *Name;
+                void (*Build)(Scene &, uint32_t);
+                void (*Prepare)(Scene &);
+            };
+            const BenchmarkScene benchmarkScenes[] = {
+                    {"stacked boxes", &BuildStackedBoxBenchmarkScene, nullptr},
+                    {"many bodies", &BuildManyBodyBenchmarkScene, nullptr},
+                    {"resting bodies", &BuildRestingBodyBenchmarkScene, &KeepRestingBenchmarkBodiesAwake},
+            };
+
+            for (const BenchmarkScene &benchmarkScene : benchmarkScenes)
+            {
+                float singleWorkerMilliseconds = 0.0f;
+                for (const uint32_t workerCount : workerCounts)
+                {
+                    Scene scene;
+                    benchmarkScene.Build(scene, bodyCount);
+                    Physics2DWorld physics2DWorld(&scene);
+                    physics2DWorld.SetWorkerCountOverride(workerCount);
+                    physics2DWorld.Start();
+                    if (benchmarkScene.Prepare)
+                        benchmarkScene.Prepare(scene);
+
+                    for (uint32_t stepIndex = 0; stepIndex < WarmupStepCount; ++stepIndex)
+                        physics2DWorld.Step(FixedTimestep);
+
+                    Timer timer;
+                    for (uint32_t stepIndex = 0; stepIndex < MeasuredStepCount; ++stepIndex)
+                        physics2DWorld.Step(FixedTimestep);
+                    const float stepMilliseconds = timer.ElapsedMillis() / MeasuredStepCount;
+
+                    if (workerCount == 1)
+                        singleWorkerMilliseconds = stepMilliseconds;
+                    HIMII_CORE_INFO("  {0:<14} {1:>2} workers: {2:.3f} ms/step ({3:.2f}x), {4} bodies written back",
+                                    benchmarkScene.Name, physics2DWorld.GetWorkerCount(), stepMilliseconds,
+                                    stepMilliseconds > 0.0f ? singleWorkerMilliseconds / stepMilliseconds : 0.0f,
+                                    physics2DWorld.GetMovedBodyCount());
+                }
+            }
+
+            return true;
+        }
+    }
+
+    bool RunPhysicsDeterminismCheck(ApplicationCommandLineArgs, const char *)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return VerifyFixedTimestepDeterminism();
+    }
+
+    bool RunPhysicsStepBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        const uint32_t bodyCount = ReadCountArgument(args, argument, 2000);
+        JobSystem::Initialize();
+        const bool succeeded = BenchmarkStep(bodyCount);
+        JobSystem::Shutdown();
+        return succeeded;
+    }
+}
@@ -0,0 +1,222 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+
+#include "EngineCore/Core/JobSystem.h"
+#include "EngineCore/Core/Timer.h"
+#include "Module/Render/RenderCore/TextureMipGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 参考实现：双精度、逐像素 pow、按覆盖面积的二维 box 滤波，不用查表、不分离、不并行。
+        std::vector<TextureMipLevel> GenerateReferenceBoxMipChain(const uint8_t *basePixels, uint32_t width,
+                                                                  uint32_t height, const TextureLoadSettings &settings)
+        {
+            std::vector<double> current(static_cast<size_t>(width) * height * 4u);
+            for (size_t pixelIndex = 0; pixelIndex < static_cast<size_t>(width) * height; ++pixelIndex)
+            {
+                const uint8_t *source = basePixels + pixelIndex * 4u;
+                const double alpha = source[3] / 255.0;
+                for (uint32_t channel = 0; channel < 3; ++channel)
+                {
+                    const double encoded = source[channel] / 255.0;
+                    double value = encoded;
+                    if (settings.SRGB)
+                        value = encoded <= 0.04045 ? encoded / 12.92 : std::pow((encoded + 0.055) / 1.055, 2.4);
+                    current[pixelIndex * 4u + channel] = settings.AlphaWeightedMipFiltering ? value * alpha : value;
+                }
+                current[pixelIndex * 4u + 3] = alpha;
+            }
+
+            std::vector<TextureMipLevel> levels;
+            uint32_t currentWidth = width;
+            uint32_t currentHeight = height;
+            while (currentWidth > 1 || currentHeight > 1)
+            {
+                const uint32_t nextWidth = std::max(1u, currentWidth / 2u);
+                const uint32_t nextHeight = std::max(1u, currentHeight / 2u);
+                const double scaleX = static_cast<double>(currentWidth) / nextWidth;
+                const double scaleY = static_cast<double>(currentHeight) / nextHeight;
+
+                std::vector<double> next(static_cast<size_t>(nextWidth) * nextHeight * 4u, 0.0);
+                for (uint32_t y = 0; y < nextHeight; ++y)
+                {
+                    for (uint32_t x = 0; x < nextWidth; ++x)
+                    {
+                        const double beginX = x * scaleX;
+                        const double beginY = y * scaleY;
+                        double weightSum = 0.0;
+                        double sum[4] = {0.0, 0.0, 0.0, 0.0};
+                        for (uint32_t sourceY = static_cast<uint32_t>(beginY); sourceY < currentHeight
+                                                                               && sourceY < beginY + scaleY;
+                             ++sourceY)
+                        {
+                            const double overlapY = std::min(beginY + scaleY, sourceY + 1.0)
+                                                    - std::max(beginY, static_cast<double>(sourceY));
+                            for (uint32_t sourceX = static_cast<uint32_t>(beginX); sourceX < currentWidth
+                                                                                   && sourceX < beginX + scaleX;
+                                 ++sourceX)
+                            {
+                                const double overlapX = std::min(beginX + scaleX, sourceX + 1.0)
+                                                        - std::max(beginX, static_cast<double>(sourceX));
+                                const double weight = overlapX * overlapY;
+                                if (weight <= 0.0)
+                                    continue;
+                                const double *pixel =
+                                        current.data() + (static_cast<size_t>(sourceY) * currentWidth + sourceX) * 4u;
+                                for (uint32_t channel = 0; channel < 4; ++channel)
+                                    sum[channel] += pixel[channel] * weight;
+                                weightSum += weight;
+                            }
+                        }
+                        double *destination = next.data() + (static_cast<size_t>(y) * nextWidth + x) * 4u;
+                        for (uint32_t channel = 0; channel < 4; ++channel)
+                            destination[channel] = sum[channel] / weightSum;
+                    }
+                }
+
+                TextureMipLevel &level = levels.emplace_back();
+                level.Width = nextWidth;
+                level.Height = nextHeight;
+                level.Pixels.resize(static_cast<size_t>(nextWidth) * nextHeight * 4u);
+                for (size_t pixelIndex = 0; pixelIndex < static_cast<size_t>(nextWidth) * nextHeight; ++pixelIndex)
+                {
+                    const double *source = next.data() + pixelIndex * 4u;
+                    uint8_t *destination = level.Pixels.data() + pixelIndex * 4u;
+                    const double alpha = std::clamp(source[3], 0.0, 1.0);
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                    {
+                        double value = source[channel];
+                        if (settings.AlphaWeightedMipFiltering)
+                            value = alpha > 0.0 ? value / alpha : 0.0;
+                        value = std::clamp(value, 0.0, 1.0);
+                        if (settings.SRGB)
+                            value = value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+                        destination[channel] = static_cast<uint8_t>(std::clamp(value * 255.0 + 0.5, 0.0, 255.0));
+                    }
+                    destination[3] = static_cast<uint8_t>(alpha * 255.0 + 0.5);
+                }
+
+                current.swap(next);
+                currentWidth = nextWidth;
+                currentHeight = nextHeight;
+            }
+            return levels;
+        }
+
+        /// 渐变叠加噪声，alpha 含完全透明与半透明区域，覆盖 alpha 加权后反除的边界情况。
+        std::vector<uint8_t> GenerateMipTestImage(uint32_t width, uint32_t height, uint32_t seed)
+        {
+            std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4u);
+            std::mt19937 random(seed);
+            std::uniform_int_distribution<int> noise(-24, 24);
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    uint8_t *pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 4u;
+                    const int gradientX = static_cast<int>(x * 255u / std::max(1u, width - 1));
+                    const int gradientY = static_cast<int>(y * 255u / std::max(1u, height - 1));
+                    pixel[0] = static_cast<uint8_t>(std::clamp(gradientX + noise(random), 0, 255));
+                    pixel[1] = static_cast<uint8_t>(std::clamp(gradientY + noise(random), 0, 255));
+                    pixel[2] = static_cast<uint8_t>(random() & 0xFFu);
+                    const uint32_t alphaBand = (x / 7u + y / 5u) % 4u;
+                    pixel[3] = alphaBand == 0 ? 0 : alphaBand == 1 ? 255 : static_cast<uint8_t>(random() & 0xFFu);
+                }
+            }
+            return pixels;
+        }
+
+        /// 用逐像素双精度的标量 box 滤波作参考，比较 GenerateRgba8MipChain 的每一层，
+        /// 覆盖 sRGB / 线性、alpha 加权 / 不加权、奇数尺寸与并行路径；任一通道误差超过 1 LSB 即失败。
+        bool VerifyTextureMipGeneration()
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            struct MipTestCase
+            {
+                uint32_t Width;
+                uint32_t Height;
+                bool SRGB;
+                bool AlphaWeightedMipFiltering;
+            };
+            // 1024×1024 超过并行阈值，其余走串行；奇数与 1 像素宽覆盖边界像素按面积分摊。
+            constexpr MipTestCase TestCases[] = {
+                    {256, 256, true, true},  {256, 256, false, false}, {257, 129, true, true},
+                    {97, 33, false, true},   {1, 64, true, false},     {1024, 1024, true, true},
+            };
+
+            const bool ownsJobSystem = !JobSystem::IsInitialized();
+            if (ownsJobSystem)
+                JobSystem::Initialize();
+
+            bool passed = true;
+            HIMII_CORE_INFO("Texture mip verification (box filter, tolerance 1 LSB):");
+            uint32_t testIndex = 0;
+            for (const MipTestCase &testCase : TestCases)
+            {
+                TextureLoadSettings settings;
+                settings.GenerateMips = true;
+                settings.MipFilter = TextureMipFilter::Box;
+                settings.SRGB = testCase.SRGB;
+                settings.AlphaWeightedMipFiltering = testCase.AlphaWeightedMipFiltering;
+
+                const std::vector<uint8_t> basePixels =
+                        GenerateMipTestImage(testCase.Width, testCase.Height, 1234u + testIndex++);
+                Timer timer;
+                std::vector<TextureMipLevel> levels;
+                GenerateRgba8MipChain(basePixels.data(), testCase.Width, testCase.Height, settings, levels);
+                const float milliseconds = timer.ElapsedMillis();
+                const std::vector<TextureMipLevel> referenceLevels =
+                        GenerateReferenceBoxMipChain(basePixels.data(), testCase.Width, testCase.Height, settings);
+
+                bool casePassed = levels.size() == referenceLevels.size();
+                int maximumError = 0;
+                uint64_t mismatchedChannelCount = 0;
+                for (size_t levelIndex = 0; casePassed && levelIndex < levels.size(); ++levelIndex)
+                {
+                    const TextureMipLevel &level = levels[levelIndex];
+                    const TextureMipLevel &referenceLevel = referenceLevels[levelIndex];
+                    if (level.Width != referenceLevel.Width || level.Height != referenceLevel.Height
+                        || level.Pixels.size() != referenceLevel.Pixels.size())
+                    {
+                        casePassed = false;
+                        break;
+                    }
+                    for (size_t byteIndex = 0; byteIndex < level.Pixels.size(); ++byteIndex)
+                    {
+                        const int error = std::abs(static_cast<int>(level.Pixels[byteIndex])
+                                                   - static_cast<int>(referenceLevel.Pixels[byteIndex]));
+                        maximumError = std::max(maximumError, error);
+                        if (error != 0)
+                            ++mismatchedChannelCount;
+                    }
+                }
+                casePassed = casePassed && maximumError <= 1;
+                passed = passed && casePassed;
+
+                HIMII_CORE_INFO("  {0}x{1} {2} {3}: {4} levels, max error {5} LSB, {6} channels off by one, "
+                                "{7:.2f} ms: {8}",
+                                testCase.Width, testCase.Height, testCase.SRGB ? "sRGB" : "linear",
+                                testCase.AlphaWeightedMipFiltering ? "alpha-weighted" : "unweighted", levels.size(), maximumError,
+                                mismatchedChannelCount, milliseconds, casePassed ? "ok" : "FAILED");
+            }
+
+            if (ownsJobSystem)
+                JobSystem::Shutdown();
+            return passed;
+        }
+    }
+
+    bool RunTextureMipCheck(ApplicationCommandLineArgs, const char *)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return VerifyTextureMipGeneration();
+    }
+}
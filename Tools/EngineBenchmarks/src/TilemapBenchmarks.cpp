@@ -0,0 +1,118 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/Timer.h"
+#include "Module/Tilemap/TileMapData.h"
+#include "Module/Tilemap/TileSet.h"
+#include "Module/Tilemap/TilemapColliderBuilder.h"
+#include "World/Scene/Components.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 在 mapSize × mapSize 的合成地形上比较整图重建与按区块增量重建的“改瓦片到碰撞体生效”延迟。
+        bool BenchmarkIncrementalRebuild(uint32_t mapSize)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr uint32_t EditCount = 256;
+            constexpr uint32_t FrameBatchEditCount = 32;
+            constexpr uint16_t SolidTileIdentifier = 1;
+
+            mapSize = std::clamp<uint32_t>(mapSize, TileMapChunkSize, 4096);
+            const int32_t mapExtent = static_cast<int32_t>(mapSize);
+
+            Ref<TileSet> tileSet = CreateRef<TileSet>();
+            TileDef solidTile;
+            solidTile.ID = SolidTileIdentifier;
+            solidTile.Collidable = true;
+            tileSet->AddTileDef(solidTile);
+
+            // 起伏地表加零散洞穴，让合并后的矩形数接近真实关卡而不是一整块。
+            Ref<TileMapData> mapData = CreateRef<TileMapData>();
+            std::mt19937 random(1234u);
+            for (int32_t tileX = 0; tileX < mapExtent; ++tileX)
+            {
+                const int32_t surfaceHeight =
+                        mapExtent / 2 + static_cast<int32_t>(std::sin(tileX * 0.05f) * mapExtent * 0.1f);
+                for (int32_t tileY = 0; tileY < surfaceHeight; ++tileY)
+                {
+                    if (random() % 16 != 0)
+                        mapData->SetTile(tileX, tileY, SolidTileIdentifier);
+                }
+            }
+
+            b2WorldDef worldDef = b2DefaultWorldDef();
+            const b2WorldId world = b2CreateWorld(&worldDef);
+            TransformComponent transform;
+
+            TilemapColliderBody colliderBody;
+            Timer fullBuildTimer;
+            const TilemapColliderBuildReport report =
+                    colliderBody.Create(world, transform, mapData, tileSet, nullptr, true);
+            const float fullBuildMilliseconds = fullBuildTimer.ElapsedMillis();
+
+            HIMII_CORE_INFO("Tilemap collider benchmark: {0}x{0} tiles, {1} chunks, {2} collidable cells, {3} merged shapes",
+                            mapSize, mapData->GetChunks().size(), report.collidableCellCount, colliderBody.GetShapeCount());
+            HIMII_CORE_INFO("  full rebuild:            {0:.3f} ms", fullBuildMilliseconds);
+
+            // 挖掘 / 填充交替的随机编辑，每次编辑后立即重建，测单次编辑到碰撞体生效的延迟。
+            std::uniform_int_distribution<int32_t> tileDistribution(0, mapExtent - 1);
+            float totalEditMilliseconds = 0.0f;
+            float maximumEditMilliseconds = 0.0f;
+            for (uint32_t editIndex = 0; editIndex < EditCount; ++editIndex)
+            {
+                const int32_t tileX = tileDistribution(random);
+                const int32_t tileY = tileDistribution(random);
+                Timer editTimer;
+                mapData->SetTile(tileX, tileY, mapData->GetTile(tileX, tileY) == 0 ? SolidTileIdentifier : 0);
+                colliderBody.MarkTileDirty(tileX, tileY);
+                colliderBody.RebuildDirtyChunks();
+                const float editMilliseconds = editTimer.ElapsedMillis();
+                totalEditMilliseconds += editMilliseconds;
+                maximumEditMilliseconds = std::max(maximumEditMilliseconds, editMilliseconds);
+            }
+            const float averageEditMilliseconds = totalEditMilliseconds / EditCount;
+            HIMII_CORE_INFO("  per-edit chunk rebuild:  {0:.4f} ms avg, {1:.4f} ms max ({2:.0f}x faster than full)",
+                            averageEditMilliseconds, maximumEditMilliseconds,
+                            fullBuildMilliseconds / std::max(averageEditMilliseconds, 1.0e-6f));
+
+            // 一帧内多次编辑只在帧末重建一次，同一区块的多次编辑合并为一次重建。
+            Timer frameTimer;
+            uint32_t rebuiltChunkCount = 0;
+            for (uint32_t frameIndex = 0; frameIndex < EditCount / FrameBatchEditCount; ++frameIndex)
+            {
+                const int32_t centerX = tileDistribution(random);
+                const int32_t centerY = tileDistribution(random);
+                for (uint32_t editIndex = 0; editIndex < FrameBatchEditCount; ++editIndex)
+                {
+                    const int32_t tileX = std::clamp(centerX + static_cast<int32_t>(editIndex % 8) - 4, 0, mapExtent - 1);
+                    const int32_t tileY = std::clamp(centerY + static_cast<int32_t>(editIndex / 8) - 2, 0, mapExtent - 1);
+                    mapData->SetTile(tileX, tileY, 0);
+                    colliderBody.MarkTileDirty(tileX, tileY);
+                }
+                rebuiltChunkCount += colliderBody.RebuildDirtyChunks();
+            }
+            const uint32_t frameCount = EditCount / FrameBatchEditCount;
+            HIMII_CORE_INFO("  {0}-edit explosion frame: {1:.4f} ms/frame, {2:.1f} chunks rebuilt/frame",
+                            FrameBatchEditCount, frameTimer.ElapsedMillis() / frameCount,
+                            static_cast<float>(rebuiltChunkCount) / frameCount);
+
+            colliderBody.Destroy();
+            b2DestroyWorld(world);
+            return true;
+        }
+    }
+
+    bool RunTilemapColliderBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return BenchmarkIncrementalRebuild(ReadCountArgument(args, argument, 1024));
+    }
+}
@@ -0,0 +1,115 @@
+#include "Hepch.h"
+#include "Benchmarks.h"
+#include "BenchmarkArguments.h"
+
+#include "EngineCore/Core/Timer.h"
+#include "World/Scene/Components.h"
+#include "World/Scene/Entity.h"
+#include "World/Scene/Scene.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Himii
+{
+    namespace
+    {
+        /// 在合成 Canvas（深链与宽树各 nodeCount 个节点）上测量全量布局、无改动帧与单叶子改动帧的耗时，结果写日志。
+        /// 经 ResolveRectTransform 驱动布局：保留结果过期时它补跑一次布局，与编辑器逐帧取矩形的路径相同。
+        bool BenchmarkUserInterfaceLayout(uint32_t nodeCount)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            constexpr float TargetWidth = 1920.0f;
+            constexpr float TargetHeight = 1080.0f;
+            constexpr int MeasuredFrameCount = 200;
+            nodeCount = std::max(nodeCount, 1u);
+
+            HIMII_CORE_INFO("UI layout benchmark: {0} nodes per tree, target {1}x{2}", nodeCount, TargetWidth,
+                            TargetHeight);
+
+            for (const bool deepChain : {true, false})
+            {
+                Scene scene;
+                Entity canvasEntity = scene.CreateCanvasEntity("Canvas");
+                std::vector<Entity> nodes;
+                nodes.reserve(nodeCount);
+
+                // 直接写父子关系后统一重建一次层级缓存，避免逐个 SetEntityParent 各重建一遍。
+                for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+                {
+                    Entity parentEntity = deepChain && !nodes.empty() ? nodes.back() : canvasEntity;
+                    Entity nodeEntity = scene.CreateUIEntity("Node");
+                    auto &relationship = nodeEntity.AddComponent<RelationshipComponent>();
+                    relationship.Parent = parentEntity.GetUUID();
+                    relationship.SiblingIndex = deepChain ? 0u : nodeIndex;
+
+                    auto &rectTransform = nodeEntity.GetComponent<RectTransformComponent>();
+                    rectTransform.SizeDelta = {40.0f, 20.0f};
+                    rectTransform.AnchoredPosition = deepChain
+                                                             ? glm::vec2(0.25f, 0.125f)
+                                                             : glm::vec2(static_cast<float>(nodeIndex % 64) * 30.0f - 960.0f,
+                                                                         static_cast<float>(nodeIndex / 64) * 10.0f - 540.0f);
+                    nodes.push_back(nodeEntity);
+                }
+                scene.RebuildHierarchyCache();
+
+                Timer timer;
+                scene.ResolveRectTransform(canvasEntity, TargetWidth, TargetHeight);
+                const float fullLayoutMilliseconds = timer.ElapsedMillis();
+
+                timer.Reset();
+                for (int frameIndex = 0; frameIndex < MeasuredFrameCount; ++frameIndex)
+                    scene.ResolveRectTransform(canvasEntity, TargetWidth, TargetHeight);
+                const float cleanFrameMilliseconds = timer.ElapsedMillis() / MeasuredFrameCount;
+
+                Entity leafEntity = nodes.back();
+                auto &leafTransform = leafEntity.GetComponent<RectTransformComponent>();
+                timer.Reset();
+                for (int frameIndex = 0; frameIndex < MeasuredFrameCount; ++frameIndex)
+                {
+                    leafTransform.AnchoredPosition.x += 1.0f;
+                    scene.MarkEntityTransformDirty(leafEntity);
+                    scene.ResolveRectTransform(canvasEntity, TargetWidth, TargetHeight);
+                }
+                const float leafEditMilliseconds = timer.ElapsedMillis() / MeasuredFrameCount;
+
+                const Scene::ResolvedRectTransform leafResult = scene.ResolveRectTransform(leafEntity, TargetWidth, TargetHeight);
+                const glm::vec2 expectedLeafSize = leafTransform.SizeDelta;
+                if (!leafResult.Valid || glm::length(leafResult.Size - expectedLeafSize) > 1.0e-3f)
+                {
+                    HIMII_CORE_ERROR("UI layout benchmark: {0} produced an invalid leaf layout",
+                                     deepChain ? "deep chain" : "wide tree");
+                    return false;
+                }
+
+                Entity firstEntity = nodes.front();
+                timer.Reset();
+                for (int frameIndex = 0; frameIndex < MeasuredFrameCount; ++frameIndex)
+                {
+                    scene.MarkEntityTransformDirty(firstEntity);
+                    scene.ResolveRectTransform(canvasEntity, TargetWidth, TargetHeight);
+                }
+                const float firstNodeEditMilliseconds = timer.ElapsedMillis() / MeasuredFrameCount;
+
+                // 编辑器逐实体取矩形的用法：布局已是最新，每次查询应只是查表。
+                timer.Reset();
+                for (Entity nodeEntity : nodes)
+                    scene.ResolveRectTransform(nodeEntity, TargetWidth, TargetHeight);
+                const float resolveAllMilliseconds = timer.ElapsedMillis();
+
+                HIMII_CORE_INFO("  {0}: full layout {1:.3f} ms, clean frame {2:.4f} ms, leaf edit {3:.4f} ms, "
+                                "first node edit {4:.3f} ms, resolve every node {5:.3f} ms",
+                                deepChain ? "deep chain" : "wide tree", fullLayoutMilliseconds, cleanFrameMilliseconds,
+                                leafEditMilliseconds, firstNodeEditMilliseconds, resolveAllMilliseconds);
+            }
+            return true;
+        }
+    }
+
+    bool RunUserInterfaceLayoutBenchmark(ApplicationCommandLineArgs args, const char *argument)
+    {
+        HIMII_PROFILE_FUNCTION();
+        return BenchmarkUserInterfaceLayout(ReadCountArgument(args, argument, 4096));
+    }
+}
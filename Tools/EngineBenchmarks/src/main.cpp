@@ -0,0 +1,70 @@
+#include "Hepch.h"
+#include "BenchmarkArguments.h"
+#include "Benchmarks.h"
+
+namespace
+{
+    struct BenchmarkEntry
+    {
+        const char *Argument;
+        const char *Usage;
+        Himii::BenchmarkFunction Run;
+    };
+
+    /// 命令行参数到基准 / 校验入口的唯一分派表；同一次调用可以请求多项，按表中顺序依次执行。
+    const BenchmarkEntry BenchmarkEntries[] = {
+            {"--benchmark-environment-bake", "[resolution...]  IBL CPU bake time (default 128 256 512 1024)",
+             &Himii::RunEnvironmentBakeBenchmark},
+            {"--verify-environment-polling", "  source fingerprint cost for a tiny vs a 512 MB HDR",
+             &Himii::RunEnvironmentPollingCheck},
+            {"--benchmark-ui-layout", "[node count]  retained UI layout time (default 4096)",
+             &Himii::RunUserInterfaceLayoutBenchmark},
+            {"--verify-physics-determinism", "  fixed-step physics is bit-identical across frame rates",
+             &Himii::RunPhysicsDeterminismCheck},
+            {"--benchmark-physics-step", "[body count]  Box2D step time per solver worker count (default 2000)",
+             &Himii::RunPhysicsStepBenchmark},
+            {"--benchmark-tilemap-colliders", "[map size]  tile edit to collider latency (default 1024)",
+             &Himii::RunTilemapColliderBenchmark},
+            {"--verify-audio-streaming", "<sound file>  streamed playback matches fully decoded playback",
+             &Himii::RunAudioStreamingCheck},
+            {"--verify-voice-virtualization", "  virtual voice scheduling on a device-less audio engine",
+             &Himii::RunVoiceVirtualizationCheck},
+            {"--verify-mixer-buses", "  mixer bus effects and render determinism on a device-less audio engine",
+             &Himii::RunMixerBusCheck},
+            {"--benchmark-meshlet-culling", "[meshlet count]  frustum / normal cone culling throughput (default 65536)",
+             &Himii::RunMeshletCullingBenchmark},
+            {"--benchmark-mesh-import", "<glTF/FBX file> [iterations]  serial vs parallel mesh decode (default 5)",
+             &Himii::RunMeshImportBenchmark},
+            {"--verify-texture-mips", "  mip chains match a scalar box-filter reference within 1 LSB",
+             &Himii::RunTextureMipCheck},
+            {"--benchmark-material-resolve", "[draw count]  GetAsset vs cached material slots (default 100000)",
+             &Himii::RunMaterialResolveBenchmark},
+            {"--benchmark-glyph-cache", "<font file> [glyph count]  cold glyph generation vs warm cache load (default 3000)",
+             &Himii::RunGlyphCacheBenchmark},
+    };
+}
+
+int main(int argc, char **argv)
+{
+    Himii::Log::Init();
+
+    const Himii::ApplicationCommandLineArgs args{argc, argv};
+    bool anyRequested = false;
+    bool allPassed = true;
+    for (const BenchmarkEntry &entry : BenchmarkEntries)
+    {
+        if (!Himii::HasCommandLineArgument(args, entry.Argument))
+            continue;
+        anyRequested = true;
+        allPassed = entry.Run(args, entry.Argument) && allPassed;
+    }
+
+    if (!anyRequested)
+    {
+        HIMII_CORE_INFO("Usage: HimiiBenchmarks <mode> [values] ...");
+        for (const BenchmarkEntry &entry : BenchmarkEntries)
+            HIMII_CORE_INFO("  {0} {1}", entry.Argument, entry.Usage);
+        return 1;
+    }
+    return allPassed ? 0 : 1;
+}